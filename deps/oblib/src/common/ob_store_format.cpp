@@ -21,6 +21,7 @@ const char* ObStoreFormat::row_store_name[MAX_ROW_STORE] = {
     "flat_row_store",
     "reserved_row_store",
     "sparse_row_store",
+    "encoding_row_store",
 };
 
 const ObStoreFormatItem ObStoreFormat::store_format_items[OB_STORE_FORMAT_MAX] = {
@@ -30,7 +31,7 @@ const ObStoreFormatItem ObStoreFormat::store_format_items[OB_STORE_FORMAT_MAX] =
     {"COMPACT", "ROW_FORMAT = COMPACT", "", FLAT_ROW_STORE},
     {"DYNAMIC", "ROW_FORMAT = DYNAMIC", "", RESERVED_ROW_STORE},
     {"COMPRESSED", "ROW_FORMAT = COMPRESSED", "", RESERVED_ROW_STORE},
-    {"", "", "", MAX_ROW_STORE},  // reserved for mysql furture
+    {"CONDENSED", "ROW_FORMAT = CONDENSED", "", ENCODING_ROW_STORE},
     {"", "", "", MAX_ROW_STORE},  // reserved for mysql furture
     {"", "", "", MAX_ROW_STORE},  // reserved for mysql furture
     {"", "", "", MAX_ROW_STORE},  // reserved for mysql furture
@@ -20,7 +20,14 @@
 namespace oceanbase {
 namespace common {
 
-enum ObRowStoreType { FLAT_ROW_STORE = 0, RESERVED_ROW_STORE = 1, SPARSE_ROW_STORE = 2, MAX_ROW_STORE };
+enum ObRowStoreType {
+  FLAT_ROW_STORE = 0,
+  RESERVED_ROW_STORE = 1,
+  SPARSE_ROW_STORE = 2,
+  // column-encoded micro blocks of major sstable, opted in by ROW_FORMAT = CONDENSED
+  ENCODING_ROW_STORE = 3,
+  MAX_ROW_STORE
+};
 
 enum ObStoreFormatType {
   OB_STORE_FORMAT_INVALID = 0,
@@ -28,8 +35,9 @@ enum ObStoreFormatType {
   OB_STORE_FORMAT_COMPACT_MYSQL = 2,
   OB_STORE_FORMAT_RESERVED1_MYSQL = 3,
   OB_STORE_FORMAT_RESERVED2_MYSQL = 4,
+  OB_STORE_FORMAT_CONDENSED_MYSQL = 5,
   OB_STORE_FORMAT_MAX_MYSQL,
-  // 5- 10 reserved for mysql store mode furture
+  // 6- 10 reserved for mysql store mode furture
   OB_STORE_FORMAT_NOCOMPRESS_ORACLE = 11,
   OB_STORE_FORMAT_BASIC_ORACLE = 12,
   OB_STORE_FORMAT_OLTP_ORACLE = 13,
@@ -59,7 +67,7 @@ private:
 public:
   static inline bool is_row_store_type_valid(const ObRowStoreType type)
   {
-    return type == FLAT_ROW_STORE || type == SPARSE_ROW_STORE;
+    return type == FLAT_ROW_STORE || type == ENCODING_ROW_STORE || type == SPARSE_ROW_STORE;
   }
   static inline const char* get_row_store_name(const ObRowStoreType type)
   {
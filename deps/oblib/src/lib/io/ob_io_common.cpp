@@ -163,6 +163,7 @@ void ObIOConfig::set_default_value()
   callback_thread_count_ = DEFAULT_IO_CALLBACK_THREAD_COUNT;
   large_query_io_percent_ = DEFAULT_LARGE_QUERY_IO_PERCENT;
   data_storage_io_timeout_ms_ = DEFAULT_DATA_STORAGE_IO_TIMEOUT_MS;
+  enable_io_uring_ = false;
 }
 
 bool ObIOConfig::is_valid() const
@@ -191,6 +192,7 @@ void ObIOConfig::reset()
   callback_thread_count_ = 0;
   large_query_io_percent_ = 0;
   data_storage_io_timeout_ms_ = 0;
+  enable_io_uring_ = false;
 }
 
 /**
@@ -385,7 +387,14 @@ bool ObIOQueue::ObIORequestCmp::operator()(const ObIORequest* a, const ObIOReque
 /**
  * ------------------------------------- ObIOChannel ------------------------------------
  */
-ObIOChannel::ObIOChannel() : inited_(false), context_(), submit_cnt_(0), can_submit_request_(true)
+ObIOChannel::ObIOChannel()
+    : inited_(false),
+      context_(),
+      submit_cnt_(0),
+      can_submit_request_(true),
+      use_io_uring_(false),
+      ring_(),
+      ring_mutex_()
 {}
 
 ObIOChannel::~ObIOChannel()
@@ -393,7 +402,7 @@ ObIOChannel::~ObIOChannel()
   destroy();
 }
 
-int ObIOChannel::init(const int32_t queue_depth)
+int ObIOChannel::init(const int32_t queue_depth, const bool enable_io_uring, const ObIOAllocator* fixed_buf_allocator)
 {
   int ret = OB_SUCCESS;
   int io_ret = 0;
@@ -409,7 +418,12 @@ int ObIOChannel::init(const int32_t queue_depth)
     COMMON_LOG(WARN, "Fail to init io queue, ", K(ret));
   } else {
     MEMSET(&context_, 0, sizeof(context_));
-    if (0 != (io_ret = ob_io_setup(MAX_AIO_EVENT_CNT, &context_))) {
+    use_io_uring_ = enable_io_uring && OB_SUCCESS == init_io_uring(fixed_buf_allocator);
+    if (use_io_uring_) {
+      submit_cnt_ = 0;
+      can_submit_request_ = true;
+      inited_ = true;
+    } else if (0 != (io_ret = ob_io_setup(MAX_AIO_EVENT_CNT, &context_))) {
       ret = OB_IO_ERROR;
       COMMON_LOG(ERROR, "Fail to setup io context, check config aio-max-nr of operating system", K(ret), K(io_ret));
     } else {
@@ -425,9 +439,44 @@ int ObIOChannel::init(const int32_t queue_depth)
   return ret;
 }
 
+int ObIOChannel::init_io_uring(const ObIOAllocator* fixed_buf_allocator)
+{
+  int ret = OB_SUCCESS;
+  const char* buf_begin = NULL;
+  int64_t block_size = 0;
+  int64_t block_cnt = 0;
+  if (!ObIOUring::is_supported()) {
+    ret = OB_NOT_SUPPORTED;
+    if (REACH_TIME_INTERVAL(60 * 1000 * 1000)) {
+      COMMON_LOG(WARN, "io_uring is not supported by kernel, use libaio instead", K(ret));
+    }
+  } else if (OB_FAIL(ring_.init(MAX_AIO_EVENT_CNT))) {
+    COMMON_LOG(WARN, "Fail to init io_uring, use libaio instead", K(ret));
+  } else if (NULL == fixed_buf_allocator) {
+    // no buffer to register
+  } else if (OB_FAIL(fixed_buf_allocator->get_macro_pool_buf(buf_begin, block_size, block_cnt))) {
+    COMMON_LOG(WARN, "Fail to get macro pool buffer", K(ret));
+  } else if (OB_FAIL(ring_.register_buffers(buf_begin, block_size, block_cnt))) {
+    COMMON_LOG(WARN, "Fail to register macro pool buffer, check RLIMIT_MEMLOCK", K(ret), K(block_size), K(block_cnt));
+  }
+  if (ring_.is_inited() && OB_FAIL(ret)) {
+    // registered buffers only save the page mapping, go on without them
+    ret = OB_SUCCESS;
+  }
+  if (OB_FAIL(ret)) {
+    ring_.destroy();
+  }
+  return ret;
+}
+
 void ObIOChannel::destroy()
 {
-  ob_io_destroy(context_);
+  if (use_io_uring_) {
+    ring_.destroy();
+    use_io_uring_ = false;
+  } else {
+    ob_io_destroy(context_);
+  }
   MEMSET(&context_, 0, sizeof(context_));
   submit_cnt_ = 0;
   can_submit_request_ = false;
@@ -470,7 +519,7 @@ int ObIOChannel::enqueue_request(ObIORequest& req)
   return ret;
 }
 
-int ObIOChannel::dequeue_request(ObIORequest*& req)
+int ObIOChannel::dequeue_request(ObIORequest*& req, const bool need_wait)
 {
   int ret = OB_SUCCESS;
   if (!inited_) {
@@ -478,7 +527,7 @@ int ObIOChannel::dequeue_request(ObIORequest*& req)
     COMMON_LOG(WARN, "not init", K(ret));
   } else {
     ObThreadCondGuard cond_guard(queue_cond_);
-    const int64_t timeout_us = get_pop_wait_timeout(queue_.get_deadline());
+    const int64_t timeout_us = need_wait ? get_pop_wait_timeout(queue_.get_deadline()) : 0;
     if (OB_FAIL(cond_guard.get_ret())) {
       COMMON_LOG(ERROR, "Fail to guard queue condition", K(ret));
     } else if (timeout_us > 0 && OB_FAIL(queue_cond_.wait_us(timeout_us))) {
@@ -570,6 +619,8 @@ void ObIOChannel::submit()
     if (OB_SUCC(ret) && !can_submit_request_) {
       clear_all_requests();
     }
+  } else if (use_io_uring_) {
+    submit_batch();
   } else {
     if (OB_FAIL(dequeue_request(req))) {
       if (OB_EAGAIN == ret || OB_ENTRY_NOT_EXIST == ret) {
@@ -600,6 +651,111 @@ void ObIOChannel::submit()
   }
 }
 
+void ObIOChannel::submit_batch()
+{
+  int ret = OB_SUCCESS;
+  ObIORequest* reqs[MAX_SUBMIT_BATCH_CNT];
+  MasterHolder master_holders[MAX_SUBMIT_BATCH_CNT];
+  DiskHolder disk_holders[MAX_SUBMIT_BATCH_CNT];
+  int64_t req_cnt = 0;
+  // only wait for the first request, the others are taken if they are due already
+  while (OB_SUCC(ret) && req_cnt < MAX_SUBMIT_BATCH_CNT) {
+    ObIORequest* req = NULL;
+    if (OB_FAIL(dequeue_request(req, 0 == req_cnt))) {
+      if (OB_EAGAIN != ret && OB_ENTRY_NOT_EXIST != ret) {
+        COMMON_LOG(WARN, "Fail to pop io request from disk, ", K(ret));
+      }
+    } else if (OB_ISNULL(req)) {
+      ret = OB_ERR_UNEXPECTED;
+      COMMON_LOG(WARN, "req is null", K(ret));
+    } else {
+      master_holders[req_cnt].hold(req->master_);
+      disk_holders[req_cnt].hold(req->get_disk());
+      reqs[req_cnt++] = req;
+    }
+  }
+
+  if (req_cnt > 0) {
+    ObCurTraceId::TraceId saved_trace_id = *ObCurTraceId::get_trace_id();
+    lib::ObMutexGuard guard(ring_mutex_);
+    int64_t prepared_cnt = 0;
+    int64_t submitted_cnt = 0;
+    for (int64_t i = 0; i < req_cnt; ++i) {
+      ObIORequest& req = *reqs[i];
+      ObCurTraceId::set(req.master_->get_trace_id());
+      req.channel_ = this;
+      int sys_ret = 0;
+      if (OB_FAIL(inner_submit(req, sys_ret))) {
+        if (OB_CANCELED != ret) {
+          COMMON_LOG(WARN, "fail to inner submit req", K(ret), K(sys_ret));
+        }
+        req.finish(ret, sys_ret);
+      } else {
+        // keep prepared requests in the order of sqes
+        reqs[prepared_cnt] = reqs[i];
+        master_holders[prepared_cnt].hold(req.master_);
+        disk_holders[prepared_cnt].hold(req.get_disk());
+        ++prepared_cnt;
+      }
+    }
+    ObCurTraceId::set(saved_trace_id);
+    if (prepared_cnt > 0) {
+      if (OB_FAIL(flush_io_uring(submitted_cnt))) {
+        COMMON_LOG(WARN, "fail to submit io_uring requests", K(ret), K(prepared_cnt), K(submitted_cnt));
+      }
+      for (int64_t i = 0; i < prepared_cnt; ++i) {
+        if (i < submitted_cnt) {
+          disk_holders[i].get_ptr()->inc_ref();  // safe only under disk holder
+        } else {
+          ATOMIC_DEC(&submit_cnt_);
+          reqs[i]->finish(OB_IO_ERROR, 0);
+        }
+      }
+    }
+  }
+}
+
+int ObIOChannel::flush_io_uring(int64_t& submitted)
+{
+  int ret = OB_SUCCESS;
+  int64_t retry_cnt = 0;
+  submitted = 0;
+  while (OB_SUCC(ret) && ring_.get_pending_cnt() > 0) {
+    int64_t cnt = 0;
+    if (OB_FAIL(ring_.submit(cnt))) {
+      if (OB_EAGAIN == ret && ++retry_cnt < MAX_SUBMIT_RETRY_CNT) {
+        ret = OB_SUCCESS;
+        usleep(DISK_WAIT_PERIOD_US);
+      }
+    } else {
+      submitted += cnt;
+    }
+  }
+  if (OB_FAIL(ret)) {
+    const int64_t discard_cnt = ring_.discard_unsubmitted();
+    COMMON_LOG(WARN, "discard io_uring requests", K(ret), K(submitted), K(discard_cnt), K_(ring));
+  }
+  return ret;
+}
+
+int ObIOChannel::resubmit(ObIORequest& req, int& sys_ret)
+{
+  int ret = OB_SUCCESS;
+  if (!use_io_uring_) {
+    ret = inner_submit(req, sys_ret);
+  } else {
+    lib::ObMutexGuard guard(ring_mutex_);
+    int64_t submitted = 0;
+    if (OB_FAIL(inner_submit(req, sys_ret))) {
+      COMMON_LOG(WARN, "fail to prepare io_uring request", K(ret));
+    } else if (OB_FAIL(flush_io_uring(submitted))) {
+      ATOMIC_DEC(&submit_cnt_);
+      COMMON_LOG(WARN, "fail to submit io_uring request", K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObIOChannel::inner_submit(ObIORequest& req, int& sys_ret)
 {
   int ret = OB_SUCCESS;
@@ -622,9 +778,17 @@ int ObIOChannel::inner_submit(ObIORequest& req, int& sys_ret)
       req.io_time_.os_submit_time_ = ObTimeUtility::current_time();
       ATOMIC_INC(&submit_cnt_);
 
-      struct iocb* iocbp = &(req.iocb_);
-      if (1 != (sys_ret = ob_io_submit(context_, 1, &iocbp))) {
-        ret = OB_IO_ERROR;
+      if (use_io_uring_) {
+        // only prepared here, submitted to kernel by flush_io_uring
+        const bool is_read = IO_CMD_PREAD == req.iocb_.aio_lio_opcode;
+        if (OB_FAIL(ring_.prep_rw(is_read, req.fd_.fd_, req.io_buf_, req.io_size_, req.io_offset_, &req))) {
+          ret = OB_EAGAIN == ret ? OB_EAGAIN : OB_IO_ERROR;
+        }
+      } else {
+        struct iocb* iocbp = &(req.iocb_);
+        if (1 != (sys_ret = ob_io_submit(context_, 1, &iocbp))) {
+          ret = OB_IO_ERROR;
+        }
       }
 
       if (OB_FAIL(ret)) {
@@ -654,6 +818,16 @@ void ObIOChannel::get_events()
   if (OB_UNLIKELY(!inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObIOChannel has not been inited, ", K(ret));
+  } else if (use_io_uring_) {
+    int64_t reaped_cnt = 0;
+    int sys_errno = 0;
+    if (OB_FAIL(ring_.wait_events(AIO_TIMEOUT_NS, events, MAX_AIO_EVENT_CNT, reaped_cnt, sys_errno))) {
+      // errno may be overwritten by the logging of wait_events
+      event_cnt = -sys_errno;
+      ret = OB_SUCCESS;
+    } else {
+      event_cnt = static_cast<int32_t>(reaped_cnt);
+    }
   } else {
     event_cnt = ob_io_getevents(context_, 1, MAX_AIO_EVENT_CNT, events, &timeout);
   }
@@ -690,7 +864,7 @@ void ObIOChannel::get_events()
         req->iocb_.data = req;
 
         int sys_ret = 0;
-        if (OB_SUCC(inner_submit(*req, sys_ret))) {
+        if (OB_SUCC(resubmit(*req, sys_ret))) {
           --finish_cnt;
         } else {
           finish_flying_req(*req, OB_IO_ERROR, sys_ret);
@@ -720,7 +894,8 @@ void ObIOChannel::cancel(ObIORequest& req)
   int sys_ret = 0;
   bool is_cancel = false;
 
-  if (0 != req.io_time_.os_submit_time_ && 0 == req.io_time_.os_return_time_) {
+  // io_uring requests are not canceled in flight, callback is skipped when they complete
+  if (!use_io_uring_ && 0 != req.io_time_.os_submit_time_ && 0 == req.io_time_.os_return_time_) {
     // Note: here if ob_io_cancel failed (possibly due to kernel not supporting io_cancel),
     // neither we or the get_events thread would call control.callback_->process(),
     // as we previously set need_callback to false.
@@ -33,6 +33,8 @@
 #include "lib/container/ob_array.h"
 #include "lib/container/ob_array_wrap.h"
 #include "lib/worker.h"
+#include "lib/lock/ob_mutex.h"
+#include "lib/io/ob_io_uring.h"
 
 namespace oceanbase {
 namespace common {
@@ -118,7 +120,7 @@ public:
   TO_STRING_KV(K_(sys_io_low_percent), K_(sys_io_high_percent), K_(user_iort_up_percent), K_(cpu_high_water_level),
       K_(write_failure_detect_interval), K_(read_failure_black_list_interval), K_(data_storage_warning_tolerance_time),
       K_(data_storage_error_tolerance_time), K_(disk_io_thread_count), K_(callback_thread_count),
-      K_(large_query_io_percent), K_(data_storage_io_timeout_ms));
+      K_(large_query_io_percent), K_(data_storage_io_timeout_ms), K_(enable_io_uring));
 
 public:
   // schedule related
@@ -136,6 +138,8 @@ public:
   int64_t callback_thread_count_;
   int64_t large_query_io_percent_;
   int64_t data_storage_io_timeout_ms_;
+  // use io_uring for disks added afterwards
+  bool enable_io_uring_;
 };
 
 struct ObIODesc {
@@ -343,10 +347,13 @@ class ObIOChannel {
 public:
   ObIOChannel();
   virtual ~ObIOChannel();
-  int init(const int32_t queue_depth);
+  // io_uring is used if enabled and supported by kernel, otherwise libaio.
+  // the macro pool of fixed_buf_allocator is registered to io_uring if given.
+  int init(
+      const int32_t queue_depth, const bool enable_io_uring = false, const ObIOAllocator* fixed_buf_allocator = NULL);
   void destroy();
   int enqueue_request(ObIORequest& req);
-  int dequeue_request(ObIORequest*& req);
+  int dequeue_request(ObIORequest*& req, const bool need_wait = true);
   int clear_all_requests();
   void submit();
   void get_events();
@@ -355,10 +362,18 @@ public:
   {
     can_submit_request_ = false;
   }
-  TO_STRING_KV(K_(inited), K_(submit_cnt), K_(can_submit_request));
+  bool is_io_uring() const
+  {
+    return use_io_uring_;
+  }
+  TO_STRING_KV(K_(inited), K_(submit_cnt), K_(can_submit_request), K_(use_io_uring));
 
 private:
+  int init_io_uring(const ObIOAllocator* fixed_buf_allocator);
+  void submit_batch();
   int inner_submit(ObIORequest& req, int& sys_ret);
+  int resubmit(ObIORequest& req, int& sys_ret);
+  int flush_io_uring(int64_t& submitted);
   void finish_flying_req(ObIORequest& req, int io_ret, int system_errno);
   int64_t get_pop_wait_timeout(const int64_t queue_deadline);
 
@@ -367,12 +382,19 @@ private:
   static const int64_t DISK_WAIT_PERIOD_US = 1000;
   static const int64_t AIO_TIMEOUT_NS = 1000L * 10000L;  // 10ms
   static const int64_t DEFAULT_SUBMIT_WAIT_US = 10 * 1000;
+  // requests dequeued and submitted by one io_uring_enter
+  static const int64_t MAX_SUBMIT_BATCH_CNT = 32;
+  static const int64_t MAX_SUBMIT_RETRY_CNT = 10;
   bool inited_;
   io_context_t context_;
   int64_t submit_cnt_;
   ObIOQueue queue_;
   ObThreadCond queue_cond_;
   bool can_submit_request_;
+  bool use_io_uring_;
+  ObIOUring ring_;
+  // submit thread and partial io retry of get_events thread share the submission queue
+  lib::ObMutex ring_mutex_;
 };
 
 struct ObIOInfo final {
@@ -166,11 +166,16 @@ int ObDisk::init(
     sys_iops_up_limit_ = DEFAULT_SYS_IOPS;
     ref_cnt_ = 0;
     channel_count_ = channel_count;
+    const bool enable_io_uring = OB_IO_MANAGER.get_io_config().enable_io_uring_;
+    const ObIOAllocator* fixed_buf_allocator = OB_IO_MANAGER.get_resource_manager().get_allocator();
     for (int64_t i = 0; OB_SUCC(ret) && i < MAX_DISK_CHANNEL_CNT; ++i) {
-      if (OB_FAIL(channels_[i].init(queue_depth))) {
-        COMMON_LOG(WARN, "fail to init channel", K(ret), K(i), K(queue_depth));
+      if (OB_FAIL(channels_[i].init(queue_depth, enable_io_uring, fixed_buf_allocator))) {
+        COMMON_LOG(WARN, "fail to init channel", K(ret), K(i), K(queue_depth), K(enable_io_uring));
       }
     }
+    if (OB_SUCC(ret)) {
+      COMMON_LOG(INFO, "disk channel backend", K(fd), K(enable_io_uring), "use_io_uring", channels_[0].is_io_uring());
+    }
 
     if (OB_SUCC(ret)) {
       real_max_channel_cnt_ = !lib::is_mini_mode() ? MAX_DISK_CHANNEL_CNT : MINI_MODE_DISK_CHANNEL_CNT;
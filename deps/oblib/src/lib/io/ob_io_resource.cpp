@@ -312,6 +312,20 @@ int64_t ObIOAllocator::allocated()
   return allocator_.allocated();
 }
 
+int ObIOAllocator::get_macro_pool_buf(const char*& begin, int64_t& block_size, int64_t& block_cnt) const
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "io allocator is not inited", K(ret));
+  } else {
+    begin = macro_pool_.get_begin_ptr();
+    block_size = macro_pool_.get_block_size();
+    block_cnt = macro_pool_.get_capacity();
+  }
+  return ret;
+}
+
 /**
  * ---------------------------------------- ObIOPool -------------------------------
  */
@@ -42,6 +42,14 @@ public:
   {
     return SIZE;
   }
+  int64_t get_capacity() const
+  {
+    return capacity_;
+  }
+  const char* get_begin_ptr() const
+  {
+    return begin_ptr_;
+  }
 
 private:
   int init_bitmap(const int64_t block_count, ObIAllocator& allocator);
@@ -68,6 +76,8 @@ public:
   void* alloc(const int64_t size);
   void free(void* ptr);
   int64_t allocated();
+  // the macro pool is a contiguous array of blocks, registered as fixed buffers of io_uring
+  int get_macro_pool_buf(const char*& begin, int64_t& block_size, int64_t& block_cnt) const;
 
 private:
   static const int64_t MICRO_POOL_BLOCK_SIZE = 16L * 1024L + 2 * DIO_READ_ALIGN_SIZE;
@@ -0,0 +1,474 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX COMMON
+#include "lib/io/ob_io_uring.h"
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "lib/atomic/ob_atomic.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/allocator/ob_malloc.h"
+
+// the syscall numbers are the same on x86_64 and aarch64
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+namespace oceanbase {
+namespace common {
+
+// kernel abi, see include/uapi/linux/io_uring.h
+namespace io_uring_abi {
+static const uint8_t IORING_OP_READ_FIXED = 4;
+static const uint8_t IORING_OP_WRITE_FIXED = 5;
+static const uint8_t IORING_OP_READ = 22;
+static const uint8_t IORING_OP_WRITE = 23;
+static const uint32_t IORING_FEAT_SINGLE_MMAP = 1U << 0;
+static const uint32_t IORING_FEAT_EXT_ARG = 1U << 8;
+static const uint32_t IORING_ENTER_GETEVENTS = 1U << 0;
+static const uint32_t IORING_ENTER_EXT_ARG = 1U << 3;
+static const uint32_t IORING_REGISTER_BUFFERS = 0;
+static const uint32_t IORING_UNREGISTER_BUFFERS = 1;
+static const uint64_t IORING_OFF_SQ_RING = 0ULL;
+static const uint64_t IORING_OFF_SQES = 0x10000000ULL;
+
+struct SqringOffsets {
+  uint32_t head_;
+  uint32_t tail_;
+  uint32_t ring_mask_;
+  uint32_t ring_entries_;
+  uint32_t flags_;
+  uint32_t dropped_;
+  uint32_t array_;
+  uint32_t resv1_;
+  uint64_t resv2_;
+};
+
+struct CqringOffsets {
+  uint32_t head_;
+  uint32_t tail_;
+  uint32_t ring_mask_;
+  uint32_t ring_entries_;
+  uint32_t overflow_;
+  uint32_t cqes_;
+  uint32_t flags_;
+  uint32_t resv1_;
+  uint64_t resv2_;
+};
+
+struct Params {
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+  uint32_t flags_;
+  uint32_t sq_thread_cpu_;
+  uint32_t sq_thread_idle_;
+  uint32_t features_;
+  uint32_t wq_fd_;
+  uint32_t resv_[3];
+  SqringOffsets sq_off_;
+  CqringOffsets cq_off_;
+};
+
+struct GeteventsArg {
+  uint64_t sigmask_;
+  uint32_t sigmask_sz_;
+  uint32_t pad_;
+  uint64_t ts_;
+};
+
+struct KernelTimespec {
+  int64_t tv_sec_;
+  int64_t tv_nsec_;
+};
+
+static int setup(const uint32_t entries, Params& params)
+{
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+}
+
+static int enter(const int fd, const uint32_t to_submit, const uint32_t min_complete, const uint32_t flags,
+    const void* arg, const size_t arg_size)
+{
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, arg_size));
+}
+
+static int do_register(const int fd, const uint32_t opcode, const void* arg, const uint32_t nr_args)
+{
+  return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+}  // namespace io_uring_abi
+
+using namespace io_uring_abi;
+
+struct ObIOUring::Sqe {
+  uint8_t opcode_;
+  uint8_t flags_;
+  uint16_t ioprio_;
+  int32_t fd_;
+  uint64_t off_;
+  uint64_t addr_;
+  uint32_t len_;
+  uint32_t rw_flags_;
+  uint64_t user_data_;
+  uint16_t buf_index_;
+  uint16_t personality_;
+  int32_t splice_fd_in_;
+  uint64_t pad_[2];
+};
+
+struct ObIOUring::Cqe {
+  uint64_t user_data_;
+  int32_t res_;
+  uint32_t flags_;
+};
+
+ObIOUring::ObIOUring()
+    : inited_(false),
+      ring_fd_(-1),
+      sq_ring_ptr_(MAP_FAILED),
+      sq_ring_size_(0),
+      sqes_(static_cast<Sqe*>(MAP_FAILED)),
+      sqes_size_(0),
+      sq_entries_(0),
+      cq_entries_(0),
+      sq_head_(NULL),
+      sq_tail_(NULL),
+      sq_mask_(NULL),
+      sq_array_(NULL),
+      cq_head_(NULL),
+      cq_tail_(NULL),
+      cq_mask_(NULL),
+      cqes_(NULL),
+      sq_local_tail_(0),
+      sq_submitted_(0),
+      fixed_buf_begin_(NULL),
+      fixed_buf_size_(0),
+      fixed_buf_cnt_(0)
+{}
+
+ObIOUring::~ObIOUring()
+{
+  destroy();
+}
+
+bool ObIOUring::is_supported()
+{
+  // -1 for not probed yet, racing probes get the same result
+  static int supported = -1;
+  if (-1 == ATOMIC_LOAD(&supported)) {
+    Params params;
+    MEMSET(&params, 0, sizeof(params));
+    const int fd = setup(2, params);
+    if (fd < 0) {
+      ATOMIC_STORE(&supported, 0);
+      COMMON_LOG(INFO, "io_uring is not supported by kernel", K(errno));
+    } else {
+      const uint32_t required = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_EXT_ARG;
+      ATOMIC_STORE(&supported, required == (params.features_ & required) ? 1 : 0);
+      COMMON_LOG(INFO, "probe io_uring features", "features", params.features_, K(required));
+      close(fd);
+    }
+  }
+  return 1 == ATOMIC_LOAD(&supported);
+}
+
+int ObIOUring::init(const uint32_t entries)
+{
+  STATIC_ASSERT(sizeof(Sqe) == 64, "io_uring sqe size mismatch");
+  STATIC_ASSERT(sizeof(Cqe) == 16, "io_uring cqe size mismatch");
+  STATIC_ASSERT(sizeof(Params) == 120, "io_uring params size mismatch");
+  int ret = OB_SUCCESS;
+  Params params;
+  MEMSET(&params, 0, sizeof(params));
+  if (OB_UNLIKELY(inited_)) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "The ObIOUring has been inited, ", K(ret));
+  } else if (OB_UNLIKELY(0 == entries)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), K(entries));
+  } else if (!is_supported()) {
+    ret = OB_NOT_SUPPORTED;
+    COMMON_LOG(WARN, "io_uring is not supported", K(ret));
+  } else if ((ring_fd_ = setup(entries, params)) < 0) {
+    ret = OB_IO_ERROR;
+    COMMON_LOG(WARN, "Fail to setup io_uring", K(ret), K(entries), K(errno));
+  } else {
+    sq_entries_ = params.sq_entries_;
+    cq_entries_ = params.cq_entries_;
+    // sq and cq rings share one mapping with IORING_FEAT_SINGLE_MMAP
+    sq_ring_size_ = std::max(params.sq_off_.array_ + params.sq_entries_ * sizeof(uint32_t),
+        params.cq_off_.cqes_ + params.cq_entries_ * sizeof(Cqe));
+    sqes_size_ = params.sq_entries_ * sizeof(Sqe);
+    if (MAP_FAILED == (sq_ring_ptr_ = mmap(NULL,
+                           sq_ring_size_,
+                           PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE,
+                           ring_fd_,
+                           IORING_OFF_SQ_RING))) {
+      ret = OB_IO_ERROR;
+      COMMON_LOG(WARN, "Fail to mmap io_uring rings", K(ret), K(errno), K_(sq_ring_size));
+    } else if (MAP_FAILED == (sqes_ = static_cast<Sqe*>(mmap(NULL,
+                                  sqes_size_,
+                                  PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE,
+                                  ring_fd_,
+                                  IORING_OFF_SQES)))) {
+      ret = OB_IO_ERROR;
+      COMMON_LOG(WARN, "Fail to mmap io_uring sqes", K(ret), K(errno), K_(sqes_size));
+    } else {
+      char* ring = static_cast<char*>(sq_ring_ptr_);
+      sq_head_ = reinterpret_cast<uint32_t*>(ring + params.sq_off_.head_);
+      sq_tail_ = reinterpret_cast<uint32_t*>(ring + params.sq_off_.tail_);
+      sq_mask_ = reinterpret_cast<uint32_t*>(ring + params.sq_off_.ring_mask_);
+      sq_array_ = reinterpret_cast<uint32_t*>(ring + params.sq_off_.array_);
+      cq_head_ = reinterpret_cast<uint32_t*>(ring + params.cq_off_.head_);
+      cq_tail_ = reinterpret_cast<uint32_t*>(ring + params.cq_off_.tail_);
+      cq_mask_ = reinterpret_cast<uint32_t*>(ring + params.cq_off_.ring_mask_);
+      cqes_ = reinterpret_cast<Cqe*>(ring + params.cq_off_.cqes_);
+      sq_local_tail_ = ATOMIC_LOAD(sq_tail_);
+      sq_submitted_ = sq_local_tail_;
+      inited_ = true;
+      COMMON_LOG(INFO, "Success to init io_uring", K(*this));
+    }
+  }
+  if (OB_FAIL(ret)) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObIOUring::destroy()
+{
+  unregister_buffers();
+  if (MAP_FAILED != static_cast<void*>(sqes_)) {
+    munmap(sqes_, sqes_size_);
+    sqes_ = static_cast<Sqe*>(MAP_FAILED);
+  }
+  if (MAP_FAILED != sq_ring_ptr_) {
+    munmap(sq_ring_ptr_, sq_ring_size_);
+    sq_ring_ptr_ = MAP_FAILED;
+  }
+  if (ring_fd_ >= 0) {
+    close(ring_fd_);
+    ring_fd_ = -1;
+  }
+  sq_ring_size_ = 0;
+  sqes_size_ = 0;
+  sq_entries_ = 0;
+  cq_entries_ = 0;
+  sq_head_ = NULL;
+  sq_tail_ = NULL;
+  sq_mask_ = NULL;
+  sq_array_ = NULL;
+  cq_head_ = NULL;
+  cq_tail_ = NULL;
+  cq_mask_ = NULL;
+  cqes_ = NULL;
+  sq_local_tail_ = 0;
+  sq_submitted_ = 0;
+  inited_ = false;
+}
+
+int ObIOUring::register_buffers(const char* begin, const int64_t block_size, const int64_t block_cnt)
+{
+  int ret = OB_SUCCESS;
+  struct iovec* iovs = NULL;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObIOUring has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(NULL != fixed_buf_begin_)) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "buffers have been registered", K(ret), KP_(fixed_buf_begin));
+  } else if (OB_ISNULL(begin) || OB_UNLIKELY(block_size <= 0 || block_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), KP(begin), K(block_size), K(block_cnt));
+  } else if (OB_ISNULL(iovs = static_cast<struct iovec*>(
+                           ob_malloc(sizeof(struct iovec) * block_cnt, ObModIds::OB_IO_CONTROL)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    COMMON_LOG(WARN, "Fail to allocate iovecs", K(ret), K(block_cnt));
+  } else {
+    for (int64_t i = 0; i < block_cnt; ++i) {
+      iovs[i].iov_base = const_cast<char*>(begin + i * block_size);
+      iovs[i].iov_len = block_size;
+    }
+    if (0 != do_register(ring_fd_, IORING_REGISTER_BUFFERS, iovs, static_cast<uint32_t>(block_cnt))) {
+      // usually limited by RLIMIT_MEMLOCK
+      ret = OB_IO_ERROR;
+      COMMON_LOG(WARN, "Fail to register io_uring buffers", K(ret), K(errno), K(block_size), K(block_cnt));
+    } else {
+      fixed_buf_begin_ = begin;
+      fixed_buf_size_ = block_size;
+      fixed_buf_cnt_ = block_cnt;
+    }
+    ob_free(iovs);
+  }
+  return ret;
+}
+
+void ObIOUring::unregister_buffers()
+{
+  if (NULL != fixed_buf_begin_) {
+    if (0 != do_register(ring_fd_, IORING_UNREGISTER_BUFFERS, NULL, 0)) {
+      COMMON_LOG(WARN, "Fail to unregister io_uring buffers", K(errno));
+    }
+    fixed_buf_begin_ = NULL;
+    fixed_buf_size_ = 0;
+    fixed_buf_cnt_ = 0;
+  }
+}
+
+int ObIOUring::get_fixed_buf_index(const void* buf, const int64_t size) const
+{
+  int index = -1;
+  const char* ptr = static_cast<const char*>(buf);
+  if (NULL != fixed_buf_begin_ && ptr >= fixed_buf_begin_ &&
+      ptr + size <= fixed_buf_begin_ + fixed_buf_size_ * fixed_buf_cnt_) {
+    const int64_t idx = (ptr - fixed_buf_begin_) / fixed_buf_size_;
+    if (ptr + size <= fixed_buf_begin_ + fixed_buf_size_ * (idx + 1)) {
+      index = static_cast<int>(idx);
+    }
+  }
+  return index;
+}
+
+int ObIOUring::prep_rw(
+    const bool is_read, const int fd, void* buf, const int64_t size, const int64_t offset, void* data)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObIOUring has not been inited, ", K(ret));
+  } else if (OB_ISNULL(buf) || OB_UNLIKELY(fd < 0 || size <= 0 || offset < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), K(fd), KP(buf), K(size), K(offset));
+  } else if (sq_local_tail_ - ATOMIC_LOAD(sq_head_) >= sq_entries_) {
+    ret = OB_EAGAIN;
+  } else {
+    const uint32_t idx = sq_local_tail_ & *sq_mask_;
+    const int buf_index = get_fixed_buf_index(buf, size);
+    Sqe& sqe = sqes_[idx];
+    MEMSET(&sqe, 0, sizeof(sqe));
+    if (buf_index >= 0) {
+      sqe.opcode_ = is_read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+      sqe.buf_index_ = static_cast<uint16_t>(buf_index);
+    } else {
+      sqe.opcode_ = is_read ? IORING_OP_READ : IORING_OP_WRITE;
+    }
+    sqe.fd_ = fd;
+    sqe.off_ = static_cast<uint64_t>(offset);
+    sqe.addr_ = reinterpret_cast<uint64_t>(buf);
+    sqe.len_ = static_cast<uint32_t>(size);
+    sqe.user_data_ = reinterpret_cast<uint64_t>(data);
+    sq_array_[idx] = idx;
+    ++sq_local_tail_;
+  }
+  return ret;
+}
+
+int ObIOUring::submit(int64_t& submitted)
+{
+  int ret = OB_SUCCESS;
+  submitted = 0;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObIOUring has not been inited, ", K(ret));
+  } else if (get_pending_cnt() > 0) {
+    // publish sqes before entering kernel
+    ATOMIC_STORE(sq_tail_, sq_local_tail_);
+    int sys_ret = 0;
+    int sys_errno = 0;
+    while ((sys_ret = enter(ring_fd_, static_cast<uint32_t>(get_pending_cnt()), 0, 0, NULL, 0)) < 0 &&
+           EINTR == (sys_errno = errno)) {}
+    if (sys_ret < 0) {
+      ret = (EAGAIN == sys_errno || EBUSY == sys_errno) ? OB_EAGAIN : OB_IO_ERROR;
+      COMMON_LOG(WARN, "Fail to submit io_uring sqes", K(ret), K(sys_errno), K(*this));
+    } else {
+      submitted = sys_ret;
+      sq_submitted_ += static_cast<uint32_t>(sys_ret);
+    }
+  }
+  return ret;
+}
+
+int64_t ObIOUring::discard_unsubmitted()
+{
+  // kernel only consumes sqes inside io_uring_enter, the tail can be rolled back safely
+  const int64_t discard_cnt = get_pending_cnt();
+  if (inited_ && discard_cnt > 0) {
+    sq_local_tail_ = sq_submitted_;
+    ATOMIC_STORE(sq_tail_, sq_local_tail_);
+  }
+  return discard_cnt;
+}
+
+int64_t ObIOUring::reap_events(struct io_event* events, const int64_t max_cnt)
+{
+  int64_t cnt = 0;
+  uint32_t head = *cq_head_;
+  const uint32_t tail = ATOMIC_LOAD(cq_tail_);
+  while (head != tail && cnt < max_cnt) {
+    const Cqe& cqe = cqes_[head & *cq_mask_];
+    struct io_event& event = events[cnt++];
+    event.data = reinterpret_cast<void*>(cqe.user_data_);
+    event.obj = NULL;
+    // negative errno on failure, same as libaio
+    event.res = static_cast<unsigned long>(static_cast<long>(cqe.res_));
+    event.res2 = 0;
+    ++head;
+  }
+  if (cnt > 0) {
+    ATOMIC_STORE(cq_head_, head);
+  }
+  return cnt;
+}
+
+int ObIOUring::wait_events(
+    const int64_t timeout_ns, struct io_event* events, const int64_t max_cnt, int64_t& event_cnt, int& sys_errno)
+{
+  int ret = OB_SUCCESS;
+  event_cnt = 0;
+  sys_errno = 0;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObIOUring has not been inited, ", K(ret));
+  } else if (OB_ISNULL(events) || OB_UNLIKELY(max_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid argument", K(ret), KP(events), K(max_cnt));
+  } else if (0 == (event_cnt = reap_events(events, max_cnt)) && timeout_ns > 0) {
+    KernelTimespec ts;
+    ts.tv_sec_ = timeout_ns / 1000000000L;
+    ts.tv_nsec_ = timeout_ns % 1000000000L;
+    GeteventsArg arg;
+    MEMSET(&arg, 0, sizeof(arg));
+    arg.ts_ = reinterpret_cast<uint64_t>(&ts);
+    if (enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg)) < 0 &&
+        ETIME != (sys_errno = errno) && EINTR != sys_errno) {
+      ret = OB_IO_ERROR;
+      COMMON_LOG(WARN, "Fail to wait io_uring cqes", K(ret), K(sys_errno));
+    } else {
+      event_cnt = reap_events(events, max_cnt);
+    }
+  }
+  return ret;
+}
+
+} /* namespace common */
+} /* namespace oceanbase */
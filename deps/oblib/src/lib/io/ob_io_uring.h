@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_IO_URING_H
+#define OB_IO_URING_H
+
+#include <libaio.h>
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase {
+namespace common {
+
+/*
+ * Minimal io_uring ring driven by raw syscalls, so that neither liburing nor kernel headers
+ * with io_uring definitions are needed at build time.
+ * Only the features required by ObIOChannel are wrapped: read/write with optional registered
+ * buffers, batched submission and completion reaping with timeout.
+ * Kernel 5.11+ is required (IORING_FEAT_EXT_ARG), otherwise is_supported() returns false and
+ * the caller should fall back to libaio.
+ *
+ * Submission queue is not thread safe, caller should serialize prep_rw() and submit().
+ * Completion queue has a single consumer, wait_events() must not be called concurrently.
+ */
+class ObIOUring {
+public:
+  ObIOUring();
+  virtual ~ObIOUring();
+  // probe kernel support once
+  static bool is_supported();
+  int init(const uint32_t entries);
+  void destroy();
+  // pin block_cnt buffers of block_size starting from begin,
+  // reads and writes totally inside one of them avoid mapping pages per io
+  int register_buffers(const char* begin, const int64_t block_size, const int64_t block_cnt);
+  void unregister_buffers();
+  // prepare one sqe, return OB_EAGAIN if submission queue is full
+  int prep_rw(const bool is_read, const int fd, void* buf, const int64_t size, const int64_t offset, void* data);
+  // hand all prepared sqes to kernel by one syscall, submitted is the count consumed by kernel
+  int submit(int64_t& submitted);
+  // drop the prepared sqes which are not consumed by kernel
+  int64_t discard_unsubmitted();
+  // reap at most max_cnt completions, wait at most timeout_ns if there is none.
+  // completions are converted to io_event, so that the same logic of libaio handles them.
+  // sys_errno is the errno of the failed io_uring_enter, saved before anything else can overwrite it
+  int wait_events(const int64_t timeout_ns, struct io_event* events, const int64_t max_cnt, int64_t& event_cnt,
+      int& sys_errno);
+  bool is_inited() const
+  {
+    return inited_;
+  }
+  int64_t get_pending_cnt() const
+  {
+    return sq_local_tail_ - sq_submitted_;
+  }
+  TO_STRING_KV(K_(inited), K_(ring_fd), K_(sq_entries), K_(cq_entries), K_(sq_local_tail), K_(sq_submitted),
+      K_(fixed_buf_cnt));
+
+private:
+  struct Sqe;
+  struct Cqe;
+  int get_fixed_buf_index(const void* buf, const int64_t size) const;
+  int64_t reap_events(struct io_event* events, const int64_t max_cnt);
+
+private:
+  bool inited_;
+  int ring_fd_;
+  // sq and cq rings in one mapping
+  void* sq_ring_ptr_;
+  int64_t sq_ring_size_;
+  Sqe* sqes_;
+  int64_t sqes_size_;
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+  // pointers into the rings shared with kernel
+  uint32_t* sq_head_;
+  uint32_t* sq_tail_;
+  uint32_t* sq_mask_;
+  uint32_t* sq_array_;
+  uint32_t* cq_head_;
+  uint32_t* cq_tail_;
+  uint32_t* cq_mask_;
+  Cqe* cqes_;
+  // tail of prepared sqes, published to kernel on submit
+  uint32_t sq_local_tail_;
+  uint32_t sq_submitted_;
+  // registered buffers, only an array of equal sized blocks is supported
+  const char* fixed_buf_begin_;
+  int64_t fixed_buf_size_;
+  int64_t fixed_buf_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObIOUring);
+};
+
+} /* namespace common */
+} /* namespace oceanbase */
+
+#endif
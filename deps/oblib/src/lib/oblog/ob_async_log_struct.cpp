@@ -22,11 +22,14 @@ ObPLogItem::ObPLogItem()
       tl_type_(common::OB_INVALID_INDEX),
       is_force_allow_(false),
       is_size_overflow_(false),
+      is_header_deferred_(false),
       timestamp_(0),
       header_pos_(0),
       buf_size_(0),
       pos_(0)
-{}
+{
+  memset(&header_, 0, sizeof(header_));
+}
 
 void ObPLogItem::deep_copy_header_only(const ObPLogItem& other)
 {
@@ -35,6 +38,8 @@ void ObPLogItem::deep_copy_header_only(const ObPLogItem& other)
   fd_type_ = other.get_fd_type();
   log_level_ = other.get_log_level();
   is_size_overflow_ = false;
+  is_header_deferred_ = other.is_header_deferred();
+  header_ = other.get_header();
   timestamp_ = other.get_timestamp();
   header_pos_ = other.get_header_len();
   pos_ = other.get_header_len();  // use header pos
@@ -35,6 +35,20 @@ enum ObPLogFDType {
   MAX_FD_FILE,
 };
 
+// raw fields of log header. mod_name, file and function point to string literals of
+// the log macros, so the header can be rendered later by the flush thread.
+struct ObPLogHeader {
+  const char* mod_name_;
+  const char* file_;
+  const char* function_;
+  int32_t line_;
+  int64_t tid_;
+  uint64_t co_id_;
+  uint64_t trace_id_[2];
+  int64_t last_cost_time_us_;
+  uint64_t dropped_log_count_;
+};
+
 // program log
 class ObPLogItem : public ObIBaseLogItem {
 public:
@@ -139,6 +153,23 @@ public:
   {
     return MAX_FD_FILE != fd_type_;
   }
+  ObPLogHeader& get_header()
+  {
+    return header_;
+  }
+  const ObPLogHeader& get_header() const
+  {
+    return header_;
+  }
+  // buf_ holds the message only, the header is rendered from header_ when flushed
+  bool is_header_deferred() const
+  {
+    return is_header_deferred_;
+  }
+  void set_header_deferred(const bool flag)
+  {
+    is_header_deferred_ = flag;
+  }
   void deep_copy_header_only(const ObPLogItem& other);
 
 private:
@@ -147,6 +178,8 @@ private:
   int32_t tl_type_;
   bool is_force_allow_;
   bool is_size_overflow_;
+  bool is_header_deferred_;
+  ObPLogHeader header_;
   int64_t timestamp_;
   int64_t header_pos_;
   int64_t buf_size_;
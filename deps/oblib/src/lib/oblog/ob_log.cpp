@@ -465,6 +465,7 @@ ObLogger::ObLogger()
       rec_old_file_flag_(false),
       can_print_(true),
       enable_async_log_(true),
+      enable_deferred_header_(false),
       use_multi_flush_(false),
       stop_append_log_(false),
       enable_perf_mode_(false),
@@ -1793,10 +1794,13 @@ void ObLogger::flush_logs_to_file(ObPLogItem** log_item, const int64_t count)
         }
       }
 
-      struct iovec vec[MAX_FD_FILE][GROUP_COMMIT_MAX_ITEM_COUNT];
+      // a log item with deferred header takes two iovecs, one for the header rendered here
+      struct iovec vec[MAX_FD_FILE][2 * GROUP_COMMIT_MAX_ITEM_COUNT];
       int iovcnt[MAX_FD_FILE] = {0};
-      struct iovec wf_vec[MAX_FD_FILE][GROUP_COMMIT_MAX_ITEM_COUNT];
+      int item_cnt[MAX_FD_FILE] = {0};
+      struct iovec wf_vec[MAX_FD_FILE][2 * GROUP_COMMIT_MAX_ITEM_COUNT];
       int wf_iovcnt[MAX_FD_FILE] = {0};
+      char header_buf[GROUP_COMMIT_MAX_ITEM_COUNT][MAX_LOG_HEAD_SIZE];
 
       ObPLogFDType fd_type = MAX_FD_FILE;
       for (int64_t i = 0; i < count; ++i) {
@@ -1809,10 +1813,25 @@ void ObLogger::flush_logs_to_file(ObPLogItem** log_item, const int64_t count)
           LOG_STDERR("unknown log, it should not happened, item=%s\n", log_item[i]->get_buf());
         } else {
           fd_type = log_item[i]->get_fd_type();
+          const bool is_wf = (enable_wf_flag_ && open_wf_flag_ && log_item[i]->get_log_level() <= wf_level_);
+          if (log_item[i]->is_header_deferred()) {
+            int64_t header_len = 0;
+            // header is truncated on overflow, write it anyway
+            (void)format_log_header(*log_item[i], header_buf[i], MAX_LOG_HEAD_SIZE, header_len);
+            vec[fd_type][iovcnt[fd_type]].iov_base = header_buf[i];
+            vec[fd_type][iovcnt[fd_type]].iov_len = static_cast<size_t>(header_len);
+            iovcnt[fd_type] += 1;
+            if (is_wf) {
+              wf_vec[fd_type][wf_iovcnt[fd_type]].iov_base = header_buf[i];
+              wf_vec[fd_type][wf_iovcnt[fd_type]].iov_len = static_cast<size_t>(header_len);
+              wf_iovcnt[fd_type] += 1;
+            }
+          }
           vec[fd_type][iovcnt[fd_type]].iov_base = log_item[i]->get_buf();
           vec[fd_type][iovcnt[fd_type]].iov_len = static_cast<size_t>(log_item[i]->get_data_len());
           iovcnt[fd_type] += 1;
-          if ((enable_wf_flag_ && open_wf_flag_ && log_item[i]->get_log_level() <= wf_level_)) {
+          item_cnt[fd_type] += 1;
+          if (is_wf) {
             wf_vec[fd_type][wf_iovcnt[fd_type]].iov_base = log_item[i]->get_buf();
             wf_vec[fd_type][wf_iovcnt[fd_type]].iov_len = static_cast<size_t>(log_item[i]->get_data_len());
             wf_iovcnt[fd_type] += 1;
@@ -1838,7 +1857,7 @@ void ObLogger::flush_logs_to_file(ObPLogItem** log_item, const int64_t count)
           writen[i] = size;
           (void)ATOMIC_AAF(&log_file_[i].write_size_, size);
           (void)ATOMIC_AAF(&log_file_[i].file_size_, size);
-          (void)ATOMIC_AAF(&log_file_[i].write_count_, iovcnt[i]);
+          (void)ATOMIC_AAF(&log_file_[i].write_count_, item_cnt[i]);
         }
         if (wf_iovcnt[i] > 0 && log_file_[i].wf_fd_ > 0) {
           (void)::writev(log_file_[i].wf_fd_, wf_vec[i], wf_iovcnt[i]);
@@ -1861,9 +1880,8 @@ int ObLogger::async_log_data_header(ObPLogItem& log_item, const timeval& tv, con
   int ret = OB_SUCCESS;
   const size_t RS_MODULE_LEN = strlen("[RS");
   const size_t ELEC_MODULE_LEN = strlen("[ELECT");
-  struct tm tm;
-  ob_fast_localtime(last_unix_sec_, last_localtime_, static_cast<time_t>(tv.tv_sec), &tm);
 
+  log_item.set_log_level(level);
   log_item.set_timestamp(tv);
   log_item.set_tl_type(+tl_type_);
   log_item.set_force_allow(is_force_allows());
@@ -1875,20 +1893,51 @@ int ObLogger::async_log_data_header(ObPLogItem& log_item, const timeval& tv, con
     log_item.set_fd_type(FD_SVR_FILE);
   }
 
-  char* data_buf = log_item.get_buf();
+  ObPLogHeader& header = log_item.get_header();
+  const uint64_t* trace_id = ObCurTraceId::get();
+  header.mod_name_ = mod_name;
+  header.file_ = file;
+  header.function_ = function;
+  header.line_ = line;
+  header.tid_ = GETTID();
+  header.co_id_ = lib::CO_IS_ENABLED() ? lib::CO_ID() : 0lu;
+  header.trace_id_[0] = (OB_ISNULL(trace_id)) ? OB_INVALID_ID : trace_id[0];
+  header.trace_id_[1] = (OB_ISNULL(trace_id)) ? OB_INVALID_ID : trace_id[1];
+  header.last_cost_time_us_ = last_logging_cost_time_us_;
+  header.dropped_log_count_ = curr_logging_seq_ - last_logging_seq_ - 1;
+
   int64_t pos = 0;
+  if (enable_deferred_header_) {
+    log_item.set_header_deferred(true);
+  } else {
+    log_item.set_header_deferred(false);
+    ret = format_log_header(log_item, log_item.get_buf(), log_item.get_buf_size(), pos);
+  }
+  if (OB_SUCC(ret)) {
+    log_item.set_data_len(pos);
+    log_item.set_header_len(pos);
+  }
+  return ret;
+}
+
+int ObLogger::format_log_header(const ObPLogItem& log_item, char* buf, const int64_t buf_len, int64_t& pos)
+{
+  int ret = OB_SUCCESS;
+  const ObPLogHeader& header = log_item.get_header();
+  const int32_t level = log_item.get_log_level();
+  const int64_t timestamp = log_item.get_timestamp();
+  const int64_t usec = timestamp % 1000000;
+  struct tm tm;
+  ob_fast_localtime(last_unix_sec_, last_localtime_, static_cast<time_t>(timestamp / 1000000), &tm);
+
   // only print base filename.
-  const char* base_file_name = strrchr(file, '/');
-  base_file_name = (NULL != base_file_name) ? base_file_name + 1 : file;
-  const uint64_t* trace_id = ObCurTraceId::get();
-  const uint64_t trace_id_0 = (OB_ISNULL(trace_id)) ? OB_INVALID_ID : trace_id[0];
-  const uint64_t trace_id_1 = (OB_ISNULL(trace_id)) ? OB_INVALID_ID : trace_id[1];
-  const uint64_t dropped_log_count = curr_logging_seq_ - last_logging_seq_ - 1;
+  const char* base_file_name = strrchr(header.file_, '/');
+  base_file_name = (NULL != base_file_name) ? base_file_name + 1 : header.file_;
   //[lt=%ld] last log cost time us
   //[dc=%lu] async dropped log count
   if (level < OB_LOG_LEVEL_INFO || log_item.is_elec_file()) {
-    ret = logdata_printf(data_buf,
-        log_item.get_buf_size(),
+    ret = logdata_printf(buf,
+        buf_len,
         pos,
         "[%04d-%02d-%02d %02d:%02d:%02d.%06ld] "
         "%-5s %s%s "
@@ -1900,21 +1949,21 @@ int ObLogger::async_log_data_header(ObPLogItem& log_item, const timeval& tv, con
         tm.tm_hour,
         tm.tm_min,
         tm.tm_sec,
-        tv.tv_usec,
+        usec,
         errstr_[level],
-        mod_name,
-        function,
+        header.mod_name_,
+        header.function_,
         base_file_name,
-        line,
-        GETTID(),
-        lib::CO_IS_ENABLED() ? lib::CO_ID() : 0lu,
-        trace_id_0,
-        trace_id_1,
-        +last_logging_cost_time_us_,
-        dropped_log_count);
+        header.line_,
+        header.tid_,
+        header.co_id_,
+        header.trace_id_[0],
+        header.trace_id_[1],
+        header.last_cost_time_us_,
+        header.dropped_log_count_);
   } else {
-    ret = logdata_printf(data_buf,
-        log_item.get_buf_size(),
+    ret = logdata_printf(buf,
+        buf_len,
         pos,
         "[%04d-%02d-%02d %02d:%02d:%02d.%06ld] "
         "%-5s %s%s:%d "
@@ -1925,21 +1974,17 @@ int ObLogger::async_log_data_header(ObPLogItem& log_item, const timeval& tv, con
         tm.tm_hour,
         tm.tm_min,
         tm.tm_sec,
-        tv.tv_usec,
+        usec,
         errstr_[level],
-        mod_name,
+        header.mod_name_,
         base_file_name,
-        line,
-        GETTID(),
-        lib::CO_IS_ENABLED() ? lib::CO_ID() : 0lu,
-        trace_id_0,
-        trace_id_1,
-        +last_logging_cost_time_us_,
-        dropped_log_count);
-  }
-  if (OB_SUCC(ret)) {
-    log_item.set_data_len(pos);
-    log_item.set_header_len(pos);
+        header.line_,
+        header.tid_,
+        header.co_id_,
+        header.trace_id_[0],
+        header.trace_id_[1],
+        header.last_cost_time_us_,
+        header.dropped_log_count_);
   }
   return ret;
 }
@@ -2034,7 +2079,8 @@ int ObLogger::check_tl_log_limiter(ObPLogItem& log_item, const uint64_t location
   int ret = OB_SUCCESS;
   static const char* EXCEED_INFO = " REACH SYSLOG RATE LIMIT";
   auto log_limiter = (nullptr != tl_log_limiter_ ? tl_log_limiter_ : default_log_limiter_);
-  const int64_t log_size = log_item.get_data_len();
+  // a deferred header is not in the item buffer yet, charge it with its max size
+  const int64_t log_size = log_item.get_data_len() + (log_item.is_header_deferred() ? MAX_LOG_HEAD_SIZE : 0);
   bool limit =
       nullptr != log_limiter &&
       (log_size <= NORMAL_LOG_SIZE ? false : (OB_SUCCESS != log_limiter->try_acquire(log_size - NORMAL_LOG_SIZE)));
@@ -704,6 +704,15 @@ public:
   {
     enable_async_log_ = flag;
   }
+  bool enable_deferred_header() const
+  {
+    return enable_deferred_header_;
+  }
+  // render header of async log in flush thread instead of the logging thread
+  void set_enable_deferred_header(const bool flag)
+  {
+    enable_deferred_header_ = flag;
+  }
   void set_stop_append_log()
   {
     stop_append_log_ = true;
@@ -1040,6 +1049,7 @@ private:
 
   int async_log_data_header(ObPLogItem& log_item, const timeval& tv, const char* mod_name, const int32_t level,
       const char* file, const int32_t line, const char* function);
+  int format_log_header(const ObPLogItem& log_item, char* buf, const int64_t buf_len, int64_t& pos);
 
   int try_upgrade_log_item(ObPLogItem*& log_item, bool& upgrade_result);
 
@@ -1103,6 +1113,7 @@ private:
   volatile bool can_print_;  // when disk has no space, logger control
 
   bool enable_async_log_;  // if false, use sync way logging
+  bool enable_deferred_header_;  // whether render async log header in flush thread
   bool use_multi_flush_;   // whether use multi flush, default false
   bool stop_append_log_;   // whether stop product log
   bool enable_perf_mode_;
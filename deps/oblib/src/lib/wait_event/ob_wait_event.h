@@ -365,6 +365,8 @@ WAIT_EVENT_DEF(
     UNDO_STATUS_LOCK_WAIT, 16007, "undo status lock wait", "", "", "", CONCURRENCY, "UNDO_STATUS_LOCK_WAIT", true)
 WAIT_EVENT_DEF(FREEZE_ASYNC_WORKER_LOCK_WAIT, 16008, "freeze async worker lock wait", "", "", "", CONCURRENCY,
     "FREEZE_ASYNC_WORKER_LOCK_WAIT", true)
+WAIT_EVENT_DEF(TABLE_WRITE_COALESCE_WAIT, 16009, "wait table api write coalesce", "address", "", "", COMMIT,
+    "wait table api write coalesce", false)
 
 // replication group
 WAIT_EVENT_DEF(RG_TRANSFER_LOCK_WAIT, 17000, "transfer lock wait", "src_rg", "dst_rg", "transfer_pkey", CONCURRENCY,
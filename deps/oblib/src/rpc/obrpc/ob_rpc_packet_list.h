@@ -435,6 +435,8 @@ PCODE_DEF(OB_REMOTE_ASYNC_EXECUTE, 0x51D)  // remote async execute with sql
 PCODE_DEF(OB_REMOTE_POST_RESULT, 0x51E)    // remote execute response result async
 PCODE_DEF(OB_PX_FAST_INIT_SQC, 0x51F)
 PCODE_DEF(OB_CHECK_BUILD_INDEX_TASK_EXIST, 0x520)  // check build index task exist
+PCODE_DEF(OB_LOAD_DATA_DIRECT_FINISH, 0x521)       // write sorted rows of direct load into sstable
+PCODE_DEF(OB_LOAD_DATA_DIRECT_CHECK, 0x522)        // check follower has synced the direct load sstable
 PCODE_DEF(OB_SQL_PCODE_END, 0x54F)                 // as a guardian
 
 // for test schema
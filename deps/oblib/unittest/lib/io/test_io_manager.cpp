@@ -475,6 +475,59 @@ TEST_F(TestIOManager, normal)
   //  ASSERT_NE(OB_SUCCESS, ret);
 }
 
+TEST_F(TestIOManager, io_uring)
+{
+  int ret = OB_SUCCESS;
+  ObIOInfo io_info;
+  ObIOHandle io_handle;
+  // macro block size, read into the buffer of macro pool which is registered to io_uring
+  const int64_t data_size = 2L * 1024L * 1024L;
+  static char data[data_size];
+  for (int64_t i = 0; i < data_size; ++i) {
+    data[i] = static_cast<char>(i % 251);
+  }
+
+  ObIOManager::get_instance().destroy();
+  ASSERT_EQ(OB_SUCCESS, ObIOManager::get_instance().init());
+  ObIOConfig io_conf = ObIOManager::get_instance().get_io_config();
+  io_conf.enable_io_uring_ = true;
+  ASSERT_EQ(OB_SUCCESS, ObIOManager::get_instance().set_io_config(io_conf));
+  ASSERT_EQ(OB_SUCCESS, ObIOManager::get_instance().add_disk(fd_, ObDisk::DEFAULT_SYS_IO_PERCENT));
+  {
+    // fall back to libaio on old kernels
+    ObDiskGuard guard;
+    ASSERT_EQ(OB_SUCCESS, ObIOManager::get_instance().get_disk_manager().get_disk_with_guard(fd_, guard));
+    ASSERT_EQ(ObIOUring::is_supported(), guard.get_disk()->channels_[0].is_io_uring());
+  }
+
+  io_info.batch_count_ = 1;
+  ObIOPoint& io_point = io_info.io_points_[0];
+  io_point.fd_ = fd_;
+  io_point.size_ = data_size;
+  io_point.offset_ = data_size;
+  io_point.write_buf_ = data;
+  io_info.size_ = io_point.size_;
+  io_info.io_desc_.category_ = USER_IO;
+
+  io_info.io_desc_.mode_ = ObIOMode::IO_MODE_WRITE;
+  ret = ObIOManager::get_instance().write(io_info, DEFAULT_IO_WAIT_TIME_MS);
+  ASSERT_EQ(OB_SUCCESS, ret);
+
+  // many requests in flight are submitted in batch
+  ObIOHandle handles[64];
+  io_info.io_desc_.mode_ = ObIOMode::IO_MODE_READ;
+  for (int64_t i = 0; i < 64; ++i) {
+    ASSERT_EQ(OB_SUCCESS, ObIOManager::get_instance().aio_read(io_info, handles[i]));
+  }
+  for (int64_t i = 0; i < 64; ++i) {
+    ASSERT_EQ(OB_SUCCESS, handles[i].wait(DEFAULT_IO_WAIT_TIME_MS));
+    ASSERT_EQ(data_size, handles[i].get_data_size());
+    ASSERT_EQ(0, MEMCMP(data, handles[i].get_buffer(), data_size));
+    handles[i].reset();
+  }
+  ObIOManager::get_instance().destroy();
+}
+
 TEST_F(TestIOManager, multi)
 {
   static const int64_t MULTI_CNT = 1024;
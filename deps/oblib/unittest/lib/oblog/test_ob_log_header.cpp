@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <time.h>
+#define private public
+#include "lib/oblog/ob_log.h"
+#undef private
+#include "lib/profile/ob_trace_id.h"
+
+namespace oceanbase {
+namespace common {
+
+static const char* TEST_MOD_NAME = "[TEST] ";
+static const char* TEST_FILE_NAME = "/path/to/ob_test_log_header.cpp";
+static const char* TEST_FUNC_NAME = "test_func";
+static const int32_t TEST_LINE = 123;
+
+class TestLogHeader : public ::testing::Test {
+public:
+  static const int64_t ITEM_BUF_SIZE = ObLogger::MAX_LOG_HEAD_SIZE;
+  TestLogHeader() : inline_buf_(NULL), deferred_buf_(NULL), inline_item_(NULL), deferred_item_(NULL)
+  {}
+  virtual void SetUp()
+  {
+    inline_buf_ = new char[sizeof(ObPLogItem) + ITEM_BUF_SIZE];
+    deferred_buf_ = new char[sizeof(ObPLogItem) + ITEM_BUF_SIZE];
+    inline_item_ = new (inline_buf_) ObPLogItem();
+    inline_item_->set_buf_size(ITEM_BUF_SIZE);
+    deferred_item_ = new (deferred_buf_) ObPLogItem();
+    deferred_item_->set_buf_size(ITEM_BUF_SIZE);
+    const uint64_t trace_id[2] = {0x1234567890ABCDEFUL, 0x0FEDCBA987654321UL};
+    ObCurTraceId::set(trace_id);
+  }
+  virtual void TearDown()
+  {
+    ObCurTraceId::reset();
+    delete[] inline_buf_;
+    delete[] deferred_buf_;
+  }
+
+protected:
+  void fill_header(ObPLogItem& item, const timeval& tv, const int32_t level, const bool deferred);
+  void check_header(const timeval& tv, const int32_t level);
+
+  char* inline_buf_;
+  char* deferred_buf_;
+  ObPLogItem* inline_item_;
+  ObPLogItem* deferred_item_;
+};
+
+void TestLogHeader::fill_header(ObPLogItem& item, const timeval& tv, const int32_t level, const bool deferred)
+{
+  ObLogger& logger = ObLogger::get_logger();
+  const bool old_deferred = logger.enable_deferred_header();
+  logger.set_enable_deferred_header(deferred);
+  const int ret =
+      logger.async_log_data_header(item, tv, TEST_MOD_NAME, level, TEST_FILE_NAME, TEST_LINE, TEST_FUNC_NAME);
+  logger.set_enable_deferred_header(old_deferred);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(deferred, item.is_header_deferred());
+}
+
+void TestLogHeader::check_header(const timeval& tv, const int32_t level)
+{
+  fill_header(*inline_item_, tv, level, false);
+  ASSERT_FALSE(HasFatalFailure());
+  fill_header(*deferred_item_, tv, level, true);
+  ASSERT_FALSE(HasFatalFailure());
+
+  // the message of a deferred item starts at the beginning of its buffer
+  ASSERT_LT(0, inline_item_->get_header_len());
+  ASSERT_EQ(0, deferred_item_->get_header_len());
+  ASSERT_EQ(0, deferred_item_->get_data_len());
+
+  // the flush thread renders exactly what the logging thread used to write
+  char header[ITEM_BUF_SIZE];
+  int64_t header_len = 0;
+  ASSERT_EQ(OB_SUCCESS,
+      ObLogger::get_logger().format_log_header(*deferred_item_, header, ITEM_BUF_SIZE, header_len));
+  ASSERT_EQ(inline_item_->get_header_len(), header_len);
+  ASSERT_EQ(0, memcmp(inline_item_->get_buf(), header, header_len));
+
+  // time, level, location, tid and trace id
+  struct tm tm;
+  const time_t sec = static_cast<time_t>(tv.tv_sec);
+  localtime_r(&sec, &tm);
+  char expect[ITEM_BUF_SIZE];
+  int64_t expect_len = 0;
+  if (level < OB_LOG_LEVEL_INFO) {
+    expect_len = snprintf(expect,
+        sizeof(expect),
+        "[%04d-%02d-%02d %02d:%02d:%02d.%06ld] %-5s %s%s (%s:%d) [%ld][%lu][" TRACE_ID_FORMAT "] ",
+        tm.tm_year + 1900,
+        tm.tm_mon + 1,
+        tm.tm_mday,
+        tm.tm_hour,
+        tm.tm_min,
+        tm.tm_sec,
+        static_cast<int64_t>(tv.tv_usec),
+        ObLogger::errstr_[level],
+        TEST_MOD_NAME,
+        TEST_FUNC_NAME,
+        "ob_test_log_header.cpp",
+        TEST_LINE,
+        static_cast<int64_t>(GETTID()),
+        0lu,
+        0x1234567890ABCDEFUL,
+        0x0FEDCBA987654321UL);
+  } else {
+    expect_len = snprintf(expect,
+        sizeof(expect),
+        "[%04d-%02d-%02d %02d:%02d:%02d.%06ld] %-5s %s%s:%d [%ld][%lu][" TRACE_ID_FORMAT "] ",
+        tm.tm_year + 1900,
+        tm.tm_mon + 1,
+        tm.tm_mday,
+        tm.tm_hour,
+        tm.tm_min,
+        tm.tm_sec,
+        static_cast<int64_t>(tv.tv_usec),
+        ObLogger::errstr_[level],
+        TEST_MOD_NAME,
+        "ob_test_log_header.cpp",
+        TEST_LINE,
+        static_cast<int64_t>(GETTID()),
+        0lu,
+        0x1234567890ABCDEFUL,
+        0x0FEDCBA987654321UL);
+  }
+  ASSERT_LT(expect_len, header_len);
+  ASSERT_EQ(0, memcmp(expect, header, expect_len));
+}
+
+TEST_F(TestLogHeader, info_header)
+{
+  timeval tv;
+  tv.tv_sec = 1609459200;  // 2021-01-01 00:00:00 UTC
+  tv.tv_usec = 123456;
+  check_header(tv, OB_LOG_LEVEL_INFO);
+  ASSERT_FALSE(HasFatalFailure());
+
+  // a different second and a small usec part
+  tv.tv_sec += 86400 + 3661;
+  tv.tv_usec = 7;
+  check_header(tv, OB_LOG_LEVEL_TRACE);
+  ASSERT_FALSE(HasFatalFailure());
+}
+
+TEST_F(TestLogHeader, warn_header)
+{
+  timeval tv;
+  gettimeofday(&tv, NULL);
+  check_header(tv, OB_LOG_LEVEL_WARN);
+  ASSERT_FALSE(HasFatalFailure());
+  check_header(tv, OB_LOG_LEVEL_ERROR);
+  ASSERT_FALSE(HasFatalFailure());
+}
+
+TEST_F(TestLogHeader, no_trace_id)
+{
+  ObCurTraceId::reset();
+  timeval tv;
+  gettimeofday(&tv, NULL);
+  fill_header(*inline_item_, tv, OB_LOG_LEVEL_INFO, false);
+  ASSERT_FALSE(HasFatalFailure());
+  fill_header(*deferred_item_, tv, OB_LOG_LEVEL_INFO, true);
+  ASSERT_FALSE(HasFatalFailure());
+  char header[ITEM_BUF_SIZE];
+  int64_t header_len = 0;
+  ASSERT_EQ(OB_SUCCESS,
+      ObLogger::get_logger().format_log_header(*deferred_item_, header, ITEM_BUF_SIZE, header_len));
+  ASSERT_EQ(inline_item_->get_header_len(), header_len);
+  ASSERT_EQ(0, memcmp(inline_item_->get_buf(), header, header_len));
+}
+
+}  // end namespace common
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -60,6 +60,7 @@ void ObIBatchBufferTask::reset()
   batch_buf_ = NULL;
   batch_size_ = 0;
   subtask_count_ = 0;
+  entry_cnt_ = 0;
   task_list_tail_ = &head_;
   head_.next_ = NULL;
   alloc_.reset();
@@ -75,6 +76,9 @@ ObIBatchBufferTask& ObIBatchBufferTask::set_batch_buffer(char* buf, const int64_
 void ObIBatchBufferTask::add_callback_to_list(ObIBufferTask* task)
 {
   (void)ATOMIC_FAA(&subtask_count_, 1);
+  if (NULL != task) {
+    (void)ATOMIC_FAA(&entry_cnt_, task->get_entry_cnt());
+  }
   if (NULL != task && task->need_callback_) {
     task->next_ = NULL;
     while (true) {
@@ -90,7 +90,8 @@ private:
 // BatchBuffer will submit a batch to BufferConsumer, which will construct a header and submit to disk/net.
 class ObIBatchBufferTask {
 public:
-  ObIBatchBufferTask() : batch_buf_(NULL), batch_size_(0), subtask_count_(0), head_(), task_list_tail_(&head_)
+  ObIBatchBufferTask()
+      : batch_buf_(NULL), batch_size_(0), subtask_count_(0), entry_cnt_(0), head_(), task_list_tail_(&head_)
   {}
   virtual ~ObIBatchBufferTask()
   {}
@@ -113,6 +114,10 @@ public:
   {
     return subtask_count_;
   }
+  int64_t get_entry_cnt() const
+  {
+    return entry_cnt_;
+  }
   void add_callback_to_list(ObIBufferTask* task);
   int st_handle_callback_list(const int handle_err, int64_t& task_num);
   ObIBufferTask* get_header_task()
@@ -131,6 +136,7 @@ private:
   char* batch_buf_;
   int64_t batch_size_;
   int64_t subtask_count_;
+  int64_t entry_cnt_;  // sum of entry count of the filled tasks
   DummyBuffferTask head_;
   ObIBufferTask* task_list_tail_;  // callback list
 
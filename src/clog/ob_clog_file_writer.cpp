@@ -99,6 +99,21 @@ bool ObCLogBaseFileWriter::enough_file_space(const uint64_t write_len) const
   return enough;
 }
 
+bool ObCLogBaseFileWriter::enough_buf_space(const uint64_t write_len) const
+{
+  bool enough = false;
+  if (IS_NOT_INIT) {
+    CLOG_LOG(WARN, "not inited", K(write_len));
+  } else {
+    uint64_t new_buf_pos = buf_write_pos_ + write_len;
+    if (need_align()) {
+      new_buf_pos += ObPaddingEntry::get_padding_size(new_buf_pos, align_size_);
+    }
+    enough = new_buf_pos <= CLOG_MAX_WRITE_BUFFER_SIZE;
+  }
+  return enough;
+}
+
 int ObCLogLocalFileWriter::load_file(uint32_t& file_id, uint32_t& offset, bool enable_pre_creation)
 {
   UNUSED(enable_pre_creation);
@@ -308,7 +323,7 @@ int ObCLogBaseFileWriter::cache_buf(ObLogCache* log_cache, const char* buf, cons
   return ret;
 }
 
-int ObCLogBaseFileWriter::append_log_entry(const char* item_buf, const uint32_t len)
+int ObCLogBaseFileWriter::append_log_entry(const char* item_buf, const uint32_t len, const bool need_align_buf)
 {
   int ret = OB_SUCCESS;
   if (IS_NOT_INIT) {
@@ -320,12 +335,15 @@ int ObCLogBaseFileWriter::append_log_entry(const char* item_buf, const uint32_t
   } else if (OB_UNLIKELY(!is_valid_file_id(file_id_))) {
     ret = OB_ERR_UNEXPECTED;
     CLOG_LOG(WARN, "file not start", K_(file_id), K(ret));
+  } else if (OB_UNLIKELY(buf_write_pos_ + len > CLOG_MAX_WRITE_BUFFER_SIZE)) {
+    ret = OB_BUF_NOT_ENOUGH;
+    CLOG_LOG(WARN, "buffer not enough", K_(buf_write_pos), K(len), K(ret));
   } else {
     // copy log to memory buffer
     memcpy(aligned_data_buf_ + buf_write_pos_, item_buf, len);
     buf_write_pos_ += (uint32_t)len;
 
-    if (OB_FAIL(align_buf())) {
+    if (need_align_buf && OB_FAIL(align_buf())) {
       CLOG_LOG(ERROR, "fail to add padding, ", K(ret));
     }
   }
@@ -82,8 +82,11 @@ public:
     return log_dir_;
   }
   bool enough_file_space(const uint64_t write_len) const;
-  // append log item meta and data to buffer
-  int append_log_entry(const char* item_buf, const uint32_t len);
+  // whether buffer can hold another log item of write_len and the padding entry after it
+  bool enough_buf_space(const uint64_t write_len) const;
+  // append log item meta and data to buffer, several items can be appended back to back
+  // and flushed together, only the last one of the group should pad the buffer
+  int append_log_entry(const char* item_buf, const uint32_t len, const bool need_align_buf = true);
 
 protected:
   // align memory buffer, append padding_entry if need
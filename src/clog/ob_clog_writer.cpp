@@ -58,7 +58,7 @@ int ObCLogWriter::init(ObCLogWriterCfg& clog_cfg)
     ret = OB_INIT_TWICE;
     CLOG_LOG(WARN, "The ObCLogWriter has been inited, ", K(ret));
   } else if (OB_UNLIKELY(!clog_cfg.is_valid()) || OB_UNLIKELY(1 != clog_cfg.base_cfg_.group_commit_min_item_cnt_) ||
-             OB_UNLIKELY(1 != clog_cfg.base_cfg_.group_commit_max_item_cnt_)) {
+             OB_UNLIKELY(clog_cfg.base_cfg_.group_commit_max_item_cnt_ < 1)) {
     ret = OB_INVALID_ARGUMENT;
     CLOG_LOG(WARN, "Invalid argument, ", K(clog_cfg), K(ret));
   } else if (OB_FAIL(ObBaseLogWriter::init(clog_cfg.base_cfg_))) {
@@ -185,26 +185,24 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
   finish_cnt = 0;
   ObLogBlockMetaV2 block_meta;
   const int64_t block_meta_len = block_meta.get_serialize_size();
-  int64_t meta_pos = 0;
   const bool is_disk_error = ATOMIC_LOAD(&is_disk_error_);
   set_clog_writer_thread_name();
   if (OB_UNLIKELY(!is_started_)) {
     ret = OB_NOT_INIT;
     CLOG_LOG(WARN, "The ObCLogWriter has not been started, ", K(ret));
-  } else if (OB_UNLIKELY(NULL == items) || OB_UNLIKELY(item_cnt <= 0) || OB_UNLIKELY(item_cnt > 1) ||
-             NULL == (item = reinterpret_cast<ObICLogItem*>(items[0])) || OB_UNLIKELY(!item->is_valid()) ||
-             OB_UNLIKELY(item->get_data_len() > OB_MAX_LOG_BUFFER_SIZE)) {
+  } else if (OB_UNLIKELY(NULL == items) || OB_UNLIKELY(item_cnt <= 0) || OB_UNLIKELY(!is_valid_item(items[0]))) {
     ret = OB_INVALID_ARGUMENT;
     CLOG_LOG(WARN, "Invalid argument, ", K(ret), KP(items), K(item_cnt));
   } else if (OB_UNLIKELY(is_disk_error)) {
+    item = reinterpret_cast<ObICLogItem*>(items[0]);
     ret = OB_STATE_NOT_MATCH;
     CLOG_LOG(ERROR, "The ObCLogWriter met disk error and been frozen, ", K(ret), K(is_disk_error));
     after_flush(item, block_meta_len, ret, file_writer_->get_cur_file_len(), finish_cnt);
   } else {
     const bool is_idempotent = false;
-    const uint64_t write_len = block_meta_len + item->get_data_len();
     const int64_t warning_value = GCONF.data_storage_warning_tolerance_time;
     ObCLogDiskErrorCB* cb = NULL;
+    int64_t group_cnt = 0;
 
     lib::ObMutexGuard guard(file_mutex_);
     BG_NEW_CALLBACK(cb, ObCLogDiskErrorCB, this);
@@ -212,25 +210,35 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
 
     // The timestamp value in block header must be generated by the time order, so
     // call inner_switch_file first here.
-    if (need_switch_file(write_len) && OB_FAIL(inner_switch_file())) {
+    item = reinterpret_cast<ObICLogItem*>(items[0]);
+    if (need_switch_file(block_meta_len + item->get_data_len()) && OB_FAIL(inner_switch_file())) {
       CLOG_LOG(ERROR, "Fail to switch file, ", K(ret), K(file_writer_->get_cur_file_id()));
-    } else if (OB_FAIL(block_meta.build_serialized_block(item->get_buf() - block_meta_len,
-                   block_meta_len,
-                   item->get_buf(),
-                   item->get_data_len(),
-                   OB_DATA_BLOCK,
-                   meta_pos))) {
-      CLOG_LOG(ERROR, "build serialized block meta fail", K(ret));
-    }
-
-    // invoke callback when fail
-    if (OB_FAIL(ret)) {
       after_flush(item, block_meta_len, ret, file_writer_->get_cur_file_len(), finish_cnt);
-    }
+    } else {
+      // Items queued while the previous group was being written are appended to the
+      // buffer back to back and written by one IO, only the last one pads the buffer.
+      group_cnt = calc_group_cnt(items, item_cnt, block_meta_len);
+      for (int64_t i = 0; OB_SUCC(ret) && i < group_cnt; ++i) {
+        int64_t meta_pos = 0;
+        item = reinterpret_cast<ObICLogItem*>(items[i]);
+        const uint64_t write_len = block_meta_len + item->get_data_len();
+        if (OB_FAIL(block_meta.build_serialized_block(item->get_buf() - block_meta_len,
+                block_meta_len,
+                item->get_buf(),
+                item->get_data_len(),
+                OB_DATA_BLOCK,
+                meta_pos))) {
+          CLOG_LOG(ERROR, "build serialized block meta fail", K(ret));
+        } else if (OB_FAIL(file_writer_->append_log_entry(
+                       item->get_buf() - block_meta_len, (uint32_t)write_len, i == group_cnt - 1))) {
+          CLOG_LOG(ERROR, "fail to add log item to buf, ", K(ret));
+        }
+      }
 
-    if (OB_SUCC(ret)) {
-      if (OB_FAIL(file_writer_->append_log_entry(item->get_buf() - block_meta_len, (uint32_t)write_len))) {
-        CLOG_LOG(ERROR, "fail to add log item to buf, ", K(ret));
+      // invoke callback when fail
+      for (int64_t i = 0; OB_FAIL(ret) && i < group_cnt; ++i) {
+        item = reinterpret_cast<ObICLogItem*>(items[i]);
+        after_flush(item, block_meta_len, ret, file_writer_->get_cur_file_len(), finish_cnt);
       }
     }
 
@@ -257,7 +265,12 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
     if (OB_SUCC(ret)) {
       io_time = ObTimeUtility::current_time() - cur_time;
       // log flush succeed, invoke callback when disk sync
-      after_flush(item, block_meta_len, ret, flush_start_offset, finish_cnt);
+      int64_t item_offset = flush_start_offset;
+      for (int64_t i = 0; i < group_cnt; ++i) {
+        item = reinterpret_cast<ObICLogItem*>(items[i]);
+        after_flush(item, block_meta_len, ret, (uint32_t)item_offset, finish_cnt);
+        item_offset += block_meta_len + item->get_data_len();
+      }
       flush_time = ObTimeUtility::current_time() - cur_time - io_time;
 
       if (flush_time + io_time > 100 * 1000) {
@@ -265,6 +278,7 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
             "slow flush",
             K(flush_time),
             K(io_time),
+            K(group_cnt),
             "file_id",
             file_writer_->get_cur_file_id(),
             K(flush_start_offset),
@@ -295,7 +309,42 @@ void ObCLogWriter::process_log_items(common::ObIBaseLogItem** items, const int64
   }
 }
 
-bool ObCLogWriter::need_switch_file(const uint64_t write_len) const
+bool ObCLogWriter::is_valid_item(common::ObIBaseLogItem* base_item) const
+{
+  ObICLogItem* item = reinterpret_cast<ObICLogItem*>(base_item);
+  return NULL != item && item->is_valid() && item->get_data_len() <= OB_MAX_LOG_BUFFER_SIZE;
+}
+
+int64_t ObCLogWriter::calc_group_cnt(
+    common::ObIBaseLogItem** items, const int64_t item_cnt, const int64_t block_meta_len) const
+{
+  // items[0] always fits after switch file, the group is cut before the first item which
+  // is invalid, needs to switch file or overflows the buffer. The left items are processed
+  // in next round, invalid one will be rejected there.
+  int64_t group_cnt = 1;
+  uint64_t group_len = block_meta_len + reinterpret_cast<ObICLogItem*>(items[0])->get_data_len();
+  int64_t group_entry_cnt = reinterpret_cast<ObICLogItem*>(items[0])->get_entry_cnt();
+  bool is_cut = false;
+  for (int64_t i = 1; !is_cut && i < item_cnt; ++i) {
+    if (!is_valid_item(items[i])) {
+      is_cut = true;
+    } else {
+      ObICLogItem* item = reinterpret_cast<ObICLogItem*>(items[i]);
+      const uint64_t write_len = block_meta_len + item->get_data_len();
+      if (need_switch_file(group_len + write_len, group_entry_cnt) ||
+          !file_writer_->enough_buf_space(group_len + write_len)) {
+        is_cut = true;
+      } else {
+        group_len += write_len;
+        group_entry_cnt += item->get_entry_cnt();
+        ++group_cnt;
+      }
+    }
+  }
+  return group_cnt;
+}
+
+bool ObCLogWriter::need_switch_file(const uint64_t write_len, const int64_t group_entry_cnt) const
 {
   // Left space is not enough for data or info block
   uint64_t max_switch_file_limit = 0;
@@ -304,7 +353,8 @@ bool ObCLogWriter::need_switch_file(const uint64_t write_len) const
   } else {
     max_switch_file_limit = ILOG_MAX_SWITCH_FILE_LIMIT;
   }
-  return !file_writer_->enough_file_space(write_len) || (info_getter_->get_entry_cnt() > max_switch_file_limit);
+  return !file_writer_->enough_file_space(write_len) ||
+         (info_getter_->get_entry_cnt() + group_entry_cnt > max_switch_file_limit);
 }
 
 void ObCLogWriter::after_flush(ObICLogItem* item, const int64_t block_meta_len, const int err_code,
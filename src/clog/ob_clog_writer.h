@@ -93,11 +93,21 @@ public:
   // when switch leader. In this case, clog file will switch file before write to the EOF.
   static const int64_t CLOG_MAX_SWITCH_FILE_LIMIT = 44000;
   static const int64_t ILOG_MAX_SWITCH_FILE_LIMIT = 17000;
+  //
+  // The 5000 reserved above covers the item being written. When several batch buffers are
+  // flushed as one group, the entries of the buffers already in the group are reserved too.
+  // They are counted by ObICLogItem::get_entry_cnt(), so a group of full buffers (5000
+  // entries each) is cut at 9 items for clog and 4 for ilog, lightly loaded buffers form
+  // a group of _ob_clog_group_commit_max_item_cnt items.
 
 private:
   static const int TASK_NUM = 1024;
   void set_clog_writer_thread_name();
-  bool need_switch_file(const uint64_t write_len) const;
+  bool is_valid_item(common::ObIBaseLogItem* base_item) const;
+  // group_entry_cnt is the entry count of items already appended to buffer but not flushed
+  bool need_switch_file(const uint64_t write_len, const int64_t group_entry_cnt = 0) const;
+  // count of the leading items which can be flushed together with items[0] by one IO
+  int64_t calc_group_cnt(common::ObIBaseLogItem** items, const int64_t item_cnt, const int64_t block_meta_len) const;
   void after_flush(ObICLogItem* item, const int64_t block_meta_len, const int err_code, const uint32_t file_offset,
       int64_t& finish_cnt);
   int inner_switch_file();
@@ -64,6 +64,11 @@ int64_t ObCLogItem::get_data_len() const
   return NULL == buffer_task_ ? 0 : buffer_task_->get_batch_size();
 }
 
+int64_t ObCLogItem::get_entry_cnt() const
+{
+  return NULL == buffer_task_ ? 0 : buffer_task_->get_entry_cnt();
+}
+
 int ObCLogItem::after_flushed(
     const file_id_t file_id, const offset_t offset, const int error_code, const ObLogWritePoolType type)
 {
@@ -80,6 +80,7 @@ public:
   virtual char* get_buf();
   virtual const char* get_buf() const;
   virtual int64_t get_data_len() const;
+  virtual int64_t get_entry_cnt() const;
   virtual int after_flushed(
       const file_id_t file_id, const offset_t offset, const int error_code, const ObLogWritePoolType type);
   TO_STRING_KV(KP_(host), KP_(buffer_task), KP_(batch_buffer));
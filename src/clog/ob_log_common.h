@@ -34,6 +34,8 @@ public:
   virtual char* get_buf() = 0;
   virtual const char* get_buf() const = 0;
   virtual int64_t get_data_len() const = 0;
+  // count of log entries in the item, each of them may add one entry to the info block
+  virtual int64_t get_entry_cnt() const = 0;
   virtual int after_flushed(
       const file_id_t file_id, const offset_t offset, const int error_code, const ObLogWritePoolType type) = 0;
   virtual int64_t to_string(char* buf, const int64_t buf_len) const = 0;
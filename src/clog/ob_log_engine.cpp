@@ -42,7 +42,8 @@ bool ObLogEnv::Config::is_valid() const
   return NULL != log_dir_ && NULL != index_log_dir_ && NULL != log_shm_path_ && NULL != index_log_shm_path_ &&
          NULL != cache_name_ && NULL != index_cache_name_ && cache_priority_ > 0 && index_cache_priority_ > 0 &&
          file_size_ > 0 && read_timeout_ > 0 && write_timeout_ > 0 && write_queue_size_ > 0 &&
-         disk_log_buffer_cnt_ > 0 && disk_log_buffer_size_ > 0 && ethernet_speed_ > 0;
+         disk_log_buffer_cnt_ > 0 && disk_log_buffer_size_ > 0 && ethernet_speed_ > 0 &&
+         group_commit_max_item_cnt_ > 0;
 }
 
 void ObLogEnv::Config::reset()
@@ -59,6 +60,7 @@ void ObLogEnv::Config::reset()
   disk_log_buffer_cnt_ = 0;
   disk_log_buffer_size_ = 0;
   ethernet_speed_ = 0;
+  group_commit_max_item_cnt_ = 1;
 }
 
 ObLogEnv::~ObLogEnv()
@@ -117,7 +119,7 @@ int ObLogEnv::init(const Config& cfg, const ObAddr& self_addr, ObIInfoBlockHandl
     log_cfg.type_ = write_pool_type;
     log_cfg.use_cache_ = enable_log_cache;
     log_cfg.base_cfg_.max_buffer_item_cnt_ = DEFAULT_WRITER_MAX_BUFFER_ITEM_CNT;
-    log_cfg.base_cfg_.group_commit_max_item_cnt_ = 1;
+    log_cfg.base_cfg_.group_commit_max_item_cnt_ = cfg.group_commit_max_item_cnt_;
     log_cfg.base_cfg_.group_commit_min_item_cnt_ = 1;
     log_cfg.base_cfg_.group_commit_max_wait_us_ = 1000;
 
@@ -84,9 +84,11 @@ public:
     int64_t disk_log_buffer_cnt_;
     int64_t disk_log_buffer_size_;
     int64_t ethernet_speed_;
+    int64_t group_commit_max_item_cnt_;
     TO_STRING_KV(K_(log_dir), K_(index_log_dir), K_(log_shm_path), K_(index_log_shm_path), K_(cache_name),
         K_(index_cache_name), K_(cache_priority), K_(index_cache_priority), K_(file_size), K_(read_timeout),
-        K_(write_timeout), K_(disk_log_buffer_size), K_(disk_log_buffer_cnt), K_(ethernet_speed));
+        K_(write_timeout), K_(disk_log_buffer_size), K_(disk_log_buffer_cnt), K_(ethernet_speed),
+        K_(group_commit_max_item_cnt));
   };
 
 public:
@@ -71,6 +71,7 @@
 #include "share/backup/ob_backup_lease_info_mgr.h"
 #include "share/resource_manager/ob_resource_manager.h"
 #include "sql/engine/cmd/ob_load_data_utils.h"
+#include "sql/engine/cmd/ob_load_data_direct.h"
 #include "observer/ob_server_memory_cutter.h"
 #include "share/ob_bg_thread_monitor.h"
 #include "observer/omt/ob_tenant_timezone_mgr.h"
@@ -996,6 +997,7 @@ int ObServer::init_pre_setting()
     OB_LOGGER.set_log_warn(log_warn);
     LOG_INFO("Whether log warn", K(log_warn));
     OB_LOGGER.set_enable_async_log(enable_async_syslog);
+    OB_LOGGER.set_enable_deferred_header(config_._enable_deferred_log_header);
     LOG_INFO("init log config", K(record_old_log_file), K(log_warn), K(enable_async_syslog));
     if (0 == max_log_cnt) {
       LOG_INFO("won't recycle log file");
@@ -1100,6 +1102,7 @@ int ObServer::init_io()
       io_config.cpu_high_water_level_ = GCONF.sys_cpu_limit_trigger * cpu_cnt;
       io_config.disk_io_thread_count_ = GCONF.disk_io_thread_count;
       io_config.callback_thread_count_ = GCONF._io_callback_thread_count;
+      io_config.enable_io_uring_ = GCONF._enable_io_uring;
       if (OB_FAIL(ObIOManager::get_instance().set_io_config(io_config))) {
         LOG_ERROR("config io manager fail, ", K(ret));
       } else {
@@ -1149,6 +1152,8 @@ int ObServer::init_loaddata_global_stat()
     LOG_ERROR("fail allocate load data map for status", K(ret));
   } else if (OB_FAIL(map->init())) {
     LOG_WARN("fail init load data map", K(ret));
+  } else if (OB_FAIL(ObLoadDataDirectMgr::get_instance().init())) {
+    LOG_WARN("fail init load data direct mgr", K(ret));
   }
   return ret;
 }
@@ -108,6 +108,7 @@ int ObServerReloadConfig::operator()()
     io_config.cpu_high_water_level_ = GCONF.sys_cpu_limit_trigger * cpu_cnt;
     io_config.disk_io_thread_count_ = GCONF.disk_io_thread_count;
     io_config.callback_thread_count_ = GCONF._io_callback_thread_count;
+    io_config.enable_io_uring_ = GCONF._enable_io_uring;
     io_config.large_query_io_percent_ = GCONF._large_query_io_percentage;
     // In the 2.x version, reuse the sys_bkgd_io_timeout configuration item to indicate the data disk io timeout time
     // After version 3.1, use the data_storage_io_timeout configuration item.
@@ -150,6 +150,8 @@ void oceanbase::observer::init_srv_xlator_for_executor(ObSrvRpcXlator* xlator)
   RPC_PROCESSOR(ObFetchIntermResultItemP, gctx_);
   RPC_PROCESSOR(ObRpcLoadDataShuffleTaskExecuteP, gctx_);
   RPC_PROCESSOR(ObRpcLoadDataInsertTaskExecuteP, gctx_);
+  RPC_PROCESSOR(ObRpcLoadDataDirectFinishP, gctx_);
+  RPC_PROCESSOR(ObRpcLoadDataDirectCheckP, gctx_);
   RPC_PROCESSOR(ObRpcAPPingSqlTaskP, gctx_);
   RPC_PROCESSOR(ObRpcRemoteSyncExecuteP, gctx_);
   RPC_PROCESSOR(ObRpcRemoteASyncExecuteP, gctx_);
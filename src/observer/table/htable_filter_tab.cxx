@@ -1771,17 +1771,25 @@ yyreduce:
 /* Line 1455 of yacc.c  */
 #line 284 "../../../src/observer/table/htable_filter_tab.yxx"
     {
-                    int &ret = parse_ctx->error_code_ = OB_NOT_SUPPORTED;
-                    UNUSED(ret);
-                    ob_hfilter_error(&((yyloc)), parse_ctx, "PageFilter not supported");
-                    YYABORT;
+                    int &ret = parse_ctx->error_code_ = OB_SUCCESS;
+                    (yyval.fval) = OB_NEWx(hfilter::PageFilter, parse_ctx->allocator(), (yyvsp[(3) - (4)].lval));
+                    if (nullptr == (yyval.fval)) {
+                        ret = OB_ALLOCATE_MEMORY_FAILED;
+                        LOG_WARN("no memory", K(ret));
+                    } else if (OB_FAIL(parse_ctx->store_filter((yyval.fval)))) {
+                        LOG_WARN("failed to store filter", K(ret));
+                    }
+                    if (OB_SUCCESS != ret) {
+                        ob_hfilter_error(&((yyloc)), parse_ctx, "failed to parse PageFilter");
+                        YYABORT;
+                    }
                 ;}
     break;
 
   case 16:
 
 /* Line 1455 of yacc.c  */
-#line 291 "../../../src/observer/table/htable_filter_tab.yxx"
+#line 299 "../../../src/observer/table/htable_filter_tab.yxx"
     {
                     int &ret = parse_ctx->error_code_ = OB_SUCCESS;
                     (yyval.fval) = OB_NEWx(hfilter::ColumnCountGetFilter, parse_ctx->allocator(), (yyvsp[(3) - (4)].lval));
@@ -1801,7 +1809,7 @@ yyreduce:
   case 17:
 
 /* Line 1455 of yacc.c  */
-#line 306 "../../../src/observer/table/htable_filter_tab.yxx"
+#line 314 "../../../src/observer/table/htable_filter_tab.yxx"
     {
                     int &ret = parse_ctx->error_code_ = OB_SUCCESS;
                     hfilter::Comparable *comparable = nullptr;
@@ -1830,77 +1838,77 @@ yyreduce:
   case 18:
 
 /* Line 1455 of yacc.c  */
-#line 331 "../../../src/observer/table/htable_filter_tab.yxx"
+#line 339 "../../../src/observer/table/htable_filter_tab.yxx"
     { (yyval.sval) = (yyvsp[(1) - (1)].sval); ;}
     break;
 
   case 19:
 
 /* Line 1455 of yacc.c  */
-#line 334 "../../../src/observer/table/htable_filter_tab.yxx"
+#line 342 "../../../src/observer/table/htable_filter_tab.yxx"
     { (yyval.sval) = (yyvsp[(1) - (1)].sval); ;}
     break;
 
   case 20:
 
 /* Line 1455 of yacc.c  */
-#line 337 "../../../src/observer/table/htable_filter_tab.yxx"
+#line 345 "../../../src/observer/table/htable_filter_tab.yxx"
     { (yyval.cmp_op) = hfilter::CompareOperator::LESS; ;}
     break;
 
   case 21:
 
 /* Line 1455 of yacc.c  */
-#line 338 "../../../src/observer/table/htable_filter_tab.yxx"
+#line 346 "../../../src/observer/table/htable_filter_tab.yxx"
     { (yyval.cmp_op) = hfilter::CompareOperator::LESS_OR_EQUAL; ;}
     break;
 
   case 22:
 
 /* Line 1455 of yacc.c  */
-#line 339 "../../../src/observer/table/htable_filter_tab.yxx"
+#line 347 "../../../src/observer/table/htable_filter_tab.yxx"
     { (yyval.cmp_op) = hfilter::CompareOperator::EQUAL; ;}
     break;
 
   case 23:
 
 /* Line 1455 of yacc.c  */
-#line 340 "../../../src/observer/table/htable_filter_tab.yxx"
+#line 348 "../../../src/observer/table/htable_filter_tab.yxx"
     { (yyval.cmp_op) = hfilter::CompareOperator::NOT_EQUAL; ;}
     break;
 
   case 24:
 
 /* Line 1455 of yacc.c  */
-#line 341 "../../../src/observer/table/htable_filter_tab.yxx"
+#line 349 "../../../src/observer/table/htable_filter_tab.yxx"
     { (yyval.cmp_op) = hfilter::CompareOperator::GREATER; ;}
     break;
 
   case 25:
 
 /* Line 1455 of yacc.c  */
-#line 342 "../../../src/observer/table/htable_filter_tab.yxx"
+#line 350 "../../../src/observer/table/htable_filter_tab.yxx"
     { (yyval.cmp_op) = hfilter::CompareOperator::GREATER_OR_EQUAL; ;}
     break;
 
   case 26:
 
 /* Line 1455 of yacc.c  */
-#line 343 "../../../src/observer/table/htable_filter_tab.yxx"
+#line 351 "../../../src/observer/table/htable_filter_tab.yxx"
     { (yyval.cmp_op) = hfilter::CompareOperator::NO_OP; ;}
     break;
 
   case 27:
 
 /* Line 1455 of yacc.c  */
-#line 347 "../../../src/observer/table/htable_filter_tab.yxx"
+#line 355 "../../../src/observer/table/htable_filter_tab.yxx"
     { (yyval.sval) = (yyvsp[(1) - (1)].sval); ;}
     break;
 
 
 
 /* Line 1455 of yacc.c  */
-#line 1904 "../../../src/observer/table/htable_filter_tab.cxx"
+#line 1912 "../../../src/observer/table/htable_filter_tab.cxx"
       default: break;
     }
   YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
@@ -2119,6 +2127,6 @@ yyreturn:
 
 
 /* Line 1675 of yacc.c  */
-#line 349 "../../../src/observer/table/htable_filter_tab.yxx"
+#line 357 "../../../src/observer/table/htable_filter_tab.yxx"
 
 
@@ -247,6 +247,7 @@ public:
   void set_max_version(int32_t max_version_value) { row_iterator_.set_max_version(max_version_value); }
   // parse the filter string
   int parse_filter_string(common::ObArenaAllocator* allocator);
+  table::hfilter::Filter *get_hfilter() { return hfilter_; }
 
 public:
   // query async
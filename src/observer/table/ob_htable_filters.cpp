@@ -25,6 +25,26 @@ Filter::~Filter()
 
 FilterBase::~FilterBase() {}
 ////////////////////////////////////////////////////////////////
+void RowKeyBound::narrow_lower(const ObString &key, bool inclusive)
+{
+  const int cmp_ret = has_lower_ ? key.compare(lower_) : 1;
+  if (cmp_ret > 0 || (0 == cmp_ret && !inclusive)) {
+    lower_ = key;
+    lower_inclusive_ = inclusive;
+    has_lower_ = true;
+  }
+}
+
+void RowKeyBound::narrow_upper(const ObString &key, bool inclusive)
+{
+  const int cmp_ret = has_upper_ ? key.compare(upper_) : -1;
+  if (cmp_ret < 0 || (0 == cmp_ret && !inclusive)) {
+    upper_ = key;
+    upper_inclusive_ = inclusive;
+    has_upper_ = true;
+  }
+}
+////////////////////////////////////////////////////////////////
 CompareFilter::~CompareFilter()
 {}
 
@@ -208,6 +228,57 @@ bool RowFilter::filter_row()
   return filter_out_row_;
 }
 
+int RowFilter::narrow_row_key_bound(common::ObIAllocator &allocator, RowKeyBound &bound)
+{
+  int ret = OB_SUCCESS;
+  if (NULL != dynamic_cast<BinaryComparator*>(comparator_)) {
+    const ObString &key = comparator_->get_comparator_value();
+    switch (cmp_op_) {
+      case CompareOperator::EQUAL:
+        bound.narrow_lower(key, true);
+        bound.narrow_upper(key, true);
+        break;
+      case CompareOperator::GREATER:
+        bound.narrow_lower(key, false);
+        break;
+      case CompareOperator::GREATER_OR_EQUAL:
+        bound.narrow_lower(key, true);
+        break;
+      case CompareOperator::LESS:
+        bound.narrow_upper(key, false);
+        break;
+      case CompareOperator::LESS_OR_EQUAL:
+        bound.narrow_upper(key, true);
+        break;
+      default:
+        break;
+    }
+  } else if (NULL != dynamic_cast<BinaryPrefixComparator*>(comparator_)
+             && CompareOperator::EQUAL == cmp_op_) {
+    // PrefixFilter, row keys in [prefix, successor of prefix)
+    const ObString &prefix = comparator_->get_comparator_value();
+    int64_t len = prefix.length();
+    if (len > 0) {
+      bound.narrow_lower(prefix, true);
+      while (len > 0 && UINT8_MAX == static_cast<uint8_t>(prefix.ptr()[len - 1])) {
+        --len;
+      }
+    }
+    if (len > 0) {
+      char *buf = static_cast<char*>(allocator.alloc(len));
+      if (NULL == buf) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("no memory", K(ret), K(len));
+      } else {
+        MEMCPY(buf, prefix.ptr(), len);
+        buf[len - 1] = static_cast<char>(static_cast<uint8_t>(buf[len - 1]) + 1);
+        bound.narrow_upper(ObString(static_cast<int32_t>(len), buf), false);
+      }
+    }
+  }
+  return ret;
+}
+
 ////////////////////////////////////////////////////////////////
 QualifierFilter::~QualifierFilter()
 {}
@@ -277,6 +348,17 @@ void FilterListBase::reset()
     filters_.at(i)->reset();
   } // end for
 }
+
+bool FilterListBase::has_filter_row()
+{
+  bool bret = false;
+  const int64_t N = filters_.count();
+  for (int64_t i = 0; !bret && i < N; ++i)
+  {
+    bret = filters_.at(i)->has_filter_row();
+  } // end for
+  return bret;
+}
 ////////////////////////////////////////////////////////////////
 FilterListAND::~FilterListAND()
 {}
@@ -450,6 +532,19 @@ bool FilterListAND::filter_row()
   }
   return bret;
 }
+// a row key passes the list only if it passes every filter
+int FilterListAND::narrow_row_key_bound(common::ObIAllocator &allocator, RowKeyBound &bound)
+{
+  int ret = OB_SUCCESS;
+  const int64_t N = filters_.count();
+  for (int64_t i = 0; OB_SUCC(ret) && i < N; ++i)
+  {
+    if (OB_FAIL(filters_.at(i)->narrow_row_key_bound(allocator, bound))) {
+      LOG_WARN("failed to narrow row key bound", K(ret), K(i));
+    }
+  } // end for
+  return ret;
+}
 ////////////////////////////////////////////////////////////////
 FilterListOR::~FilterListOR()
 {}
@@ -671,6 +766,23 @@ bool FilterListOR::filter_row()
   }
   return bret;
 }
+
+// the bounds of sub filters are not merged, only check whether the scan can be bounded
+int FilterListOR::narrow_row_key_bound(common::ObIAllocator &allocator, RowKeyBound &bound)
+{
+  int ret = OB_SUCCESS;
+  const int64_t N = filters_.count();
+  for (int64_t i = 0; OB_SUCC(ret) && i < N; ++i)
+  {
+    RowKeyBound sub_bound;
+    if (OB_FAIL(filters_.at(i)->narrow_row_key_bound(allocator, sub_bound))) {
+      LOG_WARN("failed to narrow row key bound", K(ret), K(i));
+    } else if (sub_bound.is_disabled()) {
+      bound.disable();
+    }
+  } // end for
+  return ret;
+}
 ////////////////////////////////////////////////////////////////
 SkipFilter::~SkipFilter() {}
 void SkipFilter::reset()
@@ -707,6 +819,19 @@ int SkipFilter::transform_cell(const ObHTableCell &cell, const ObHTableCell *&ne
 {
   return filter_->transform_cell(cell, new_cell);
 }
+
+// row keys are not checked by the sub filter, see filter_row_key()
+int SkipFilter::narrow_row_key_bound(common::ObIAllocator &allocator, RowKeyBound &bound)
+{
+  int ret = OB_SUCCESS;
+  RowKeyBound sub_bound;
+  if (OB_FAIL(filter_->narrow_row_key_bound(allocator, sub_bound))) {
+    LOG_WARN("failed to narrow row key bound", K(ret));
+  } else if (sub_bound.is_disabled()) {
+    bound.disable();
+  }
+  return ret;
+}
 ////////////////////////////////////////////////////////////////
 WhileMatchFilter::~WhileMatchFilter() {}
 
@@ -756,6 +881,14 @@ bool WhileMatchFilter::filter_row()
   return bret;
 }
 
+// the scan stops at the first row not matched, which may be out of the bound
+int WhileMatchFilter::narrow_row_key_bound(common::ObIAllocator &allocator, RowKeyBound &bound)
+{
+  UNUSED(allocator);
+  bound.disable();
+  return OB_SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////
 SingleColumnValueFilter::~SingleColumnValueFilter()
 {}
@@ -841,6 +974,25 @@ int ColumnCountGetFilter::filter_cell(const ObHTableCell &cell, ReturnCode &ret_
   }
   return ret;
 }
+////////////////////////////////////////////////////////////////
+bool PageFilter::filter_all_remaining()
+{
+  return rows_accepted_ >= page_size_;
+}
+
+int PageFilter::filter_cell(const ObHTableCell &cell, ReturnCode &ret_code)
+{
+  UNUSED(cell);
+  ret_code = ReturnCode::INCLUDE;
+  return OB_SUCCESS;
+}
+
+bool PageFilter::filter_row()
+{
+  ++rows_accepted_;
+  return rows_accepted_ > page_size_;
+}
+
 ////////////////////////////////////////////////////////////////
 CheckAndMutateFilter::~CheckAndMutateFilter()
 {}
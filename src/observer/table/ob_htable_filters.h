@@ -23,6 +23,38 @@ namespace table
 namespace hfilter
 {
 typedef table::ObTableQueryResult RowCells;
+
+/// The range of row keys which may pass a filter, compiled from row key filters
+/// to bound the storage scan of a query. No bound on a side means unlimited.
+struct RowKeyBound
+{
+  RowKeyBound()
+      :has_lower_(false),
+       lower_inclusive_(false),
+       has_upper_(false),
+       upper_inclusive_(false),
+       is_disabled_(false)
+  {}
+  bool is_bounded() const { return !is_disabled_ && (has_lower_ || has_upper_); }
+  /// the filter depends on rows out of the bound, e.g. WhileMatchFilter, so the scan can not be bounded
+  void disable() { is_disabled_ = true; }
+  bool is_disabled() const { return is_disabled_; }
+  /// intersect with [key, +inf) or (key, +inf)
+  void narrow_lower(const ObString &key, bool inclusive);
+  /// intersect with (-inf, key] or (-inf, key)
+  void narrow_upper(const ObString &key, bool inclusive);
+  TO_STRING_KV(K_(has_lower), K_(lower), K_(lower_inclusive), K_(has_upper), K_(upper), K_(upper_inclusive),
+               K_(is_disabled));
+
+  ObString lower_;
+  bool has_lower_;
+  bool lower_inclusive_;
+  ObString upper_;
+  bool has_upper_;
+  bool upper_inclusive_;
+  bool is_disabled_;
+};
+
 /** Interface Filter
  * Interface for row and column filters directly applied within the regionserver. A filter can expect the following call sequence:
  * + reset() : reset the filter state before filtering a new row.
@@ -67,6 +99,8 @@ public:
 
   /// Primarily used to check for conflicts with scans(such as scans that do not read a full row at a time).
   virtual bool has_filter_row() = 0;
+  /// Narrow %bound to the row keys which may pass the filter, used to bound the scan range.
+  virtual int narrow_row_key_bound(common::ObIAllocator &allocator, RowKeyBound &bound) = 0;
 
   void set_reversed(bool reversed) { is_reversed_ = reversed; }
   bool is_reversed() const { return is_reversed_; }
@@ -98,6 +132,8 @@ public:
   { UNUSED(cells); return common::OB_SUCCESS; }
   virtual bool filter_row() override { return false; }
   virtual bool has_filter_row() override { return false; }
+  virtual int narrow_row_key_bound(common::ObIAllocator &allocator, RowKeyBound &bound) override
+  { UNUSED(allocator); UNUSED(bound); return common::OB_SUCCESS; }
 
   static const char* compare_operator_to_string(CompareOperator cmp_op);
 private:
@@ -112,6 +148,7 @@ public:
   {}
   virtual ~Comparable() {}
   virtual int compare_to(const ObString &b) = 0;
+  const ObString &get_comparator_value() const { return comparator_value_; }
   VIRTUAL_TO_STRING_KV("comprable", "Comprable");
 protected:
   ObString comparator_value_;
@@ -210,6 +247,7 @@ public:
   virtual bool filter_row_key(const ObHTableCell &first_row_cell) override;
   virtual int filter_cell(const ObHTableCell &cell, ReturnCode &ret_code) override;
   virtual bool filter_row() override;
+  virtual int narrow_row_key_bound(common::ObIAllocator &allocator, RowKeyBound &bound) override;
   TO_STRING_KV("filter", "RowFilter",
                "cmp_op", compare_operator_to_string(cmp_op_),
                "comparator", comparator_);
@@ -270,6 +308,7 @@ public:
   int add_filter(Filter *filter);
   Operator get_operator() const { return op_; }
   virtual void reset() override;
+  virtual bool has_filter_row() override;
 
   TO_STRING_KV("filter", "FilterList",
                "op", operator_to_string(op_),
@@ -295,6 +334,7 @@ public:
   virtual bool filter_row_key(const ObHTableCell &first_row_cell) override;
   virtual int filter_cell(const ObHTableCell &cell, ReturnCode &ret_code) override;
   virtual bool filter_row() override;
+  virtual int narrow_row_key_bound(common::ObIAllocator &allocator, RowKeyBound &bound) override;
 private:
   static ReturnCode merge_return_code(ReturnCode rc, ReturnCode local_rc);
   ObSEArray<Filter*, 8> seek_hint_filters_;
@@ -314,6 +354,7 @@ public:
   virtual bool filter_row_key(const ObHTableCell &first_row_cell) override;
   virtual int filter_cell(const ObHTableCell &cell, ReturnCode &ret_code) override;
   virtual bool filter_row() override;
+  virtual int narrow_row_key_bound(common::ObIAllocator &allocator, RowKeyBound &bound) override;
 private:
   static ReturnCode merge_return_code(ReturnCode rc, ReturnCode local_rc);
   // disallow copy
@@ -335,6 +376,7 @@ public:
   virtual bool has_filter_row() override { return true; }
   virtual int transform_cell(const ObHTableCell &cell, const ObHTableCell *&new_cell) override;
   virtual int filter_cell(const ObHTableCell &cell, ReturnCode &ret_code) override;
+  virtual int narrow_row_key_bound(common::ObIAllocator &allocator, RowKeyBound &bound) override;
   TO_STRING_KV("filter", "SkipFilter",
                "sub_filter", filter_);
 private:
@@ -362,6 +404,7 @@ public:
   virtual int transform_cell(const ObHTableCell &cell, const ObHTableCell *&new_cell) override;
   virtual bool filter_row() override;
   virtual bool has_filter_row() override { return true; }
+  virtual int narrow_row_key_bound(common::ObIAllocator &allocator, RowKeyBound &bound) override;
 
   TO_STRING_KV("filter", "WhileMatchFilter",
                "sub_filter", filter_);
@@ -439,6 +482,28 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ColumnCountGetFilter);
 };
 
+/// Limits the number of rows returned by a scan, the scan terminates once the limit is reached.
+class PageFilter: public FilterBase
+{
+public:
+  PageFilter(int64_t page_size)
+      :page_size_(page_size),
+      rows_accepted_(0)
+  {}
+  virtual ~PageFilter() {}
+  virtual bool filter_all_remaining() override;
+  virtual int filter_cell(const ObHTableCell &cell, ReturnCode &ret_code) override;
+  virtual bool filter_row() override;
+  virtual bool has_filter_row() override { return true; }
+  TO_STRING_KV("filter", "PageFilter",
+               K_(page_size));
+private:
+  int64_t page_size_;
+  int64_t rows_accepted_;
+  // disallow copy
+  DISALLOW_COPY_AND_ASSIGN(PageFilter);
+};
+
 /// CheckAndMutateFilter is used to implement the check logic of CheckAndMutate
 /// @see https://hbase.apache.org/apidocs/org/apache/hadoop/hbase/client/Table.html#checkAndMutate-byte:A-byte:A-
 class CheckAndMutateFilter: public FilterBase
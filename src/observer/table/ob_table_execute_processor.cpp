@@ -18,6 +18,7 @@
 #include "ob_table_end_trans_cb.h"
 #include "sql/optimizer/ob_table_location.h"  // ObTableLocation
 #include "lib/stat/ob_session_stat.h"
+#include "share/config/ob_server_config.h"
 
 using namespace oceanbase::observer;
 using namespace oceanbase::common;
@@ -129,10 +130,11 @@ int ObTableApiExecuteP::try_process()
     ret = OB_NOT_SUPPORTED;
     LOG_WARN("index type is not supported by table api", K(ret));
   } else {
+    const bool need_coalesce = need_coalesce_write();
     switch (table_operation.type()) {
       case ObTableOperationType::INSERT:
         stat_event_type_ = ObTableProccessType::TABLE_API_SINGLE_INSERT;
-        ret = process_insert();
+        ret = need_coalesce ? process_coalesced_write() : process_insert();
         break;
       case ObTableOperationType::GET:
         stat_event_type_ = ObTableProccessType::TABLE_API_SINGLE_GET;
@@ -140,19 +142,19 @@ int ObTableApiExecuteP::try_process()
         break;
       case ObTableOperationType::DEL:
         stat_event_type_ = ObTableProccessType::TABLE_API_SINGLE_DELETE;
-        ret = process_del();
+        ret = need_coalesce ? process_coalesced_write() : process_del();
         break;
       case ObTableOperationType::UPDATE:
         stat_event_type_ = ObTableProccessType::TABLE_API_SINGLE_UPDATE;
-        ret = process_update();
+        ret = need_coalesce ? process_coalesced_write() : process_update();
         break;
       case ObTableOperationType::INSERT_OR_UPDATE:
         stat_event_type_ = ObTableProccessType::TABLE_API_SINGLE_INSERT_OR_UPDATE;
-        ret = process_insert_or_update();
+        ret = need_coalesce ? process_coalesced_write() : process_insert_or_update();
         break;
       case ObTableOperationType::REPLACE:
         stat_event_type_ = ObTableProccessType::TABLE_API_SINGLE_REPLACE;
-        ret = process_replace();
+        ret = need_coalesce ? process_coalesced_write() : process_replace();
         break;
       case ObTableOperationType::INCREMENT:
         stat_event_type_ = ObTableProccessType::TABLE_API_SINGLE_INCREMENT;
@@ -527,3 +529,214 @@ int ObTableApiExecuteP::process_increment()
   ret = (OB_SUCCESS == tmp_ret) ? ret : tmp_ret;
   return ret;
 }
+
+////////////////////////////////////////////////////////////////
+// write coalescing
+static stmt::StmtType get_write_stmt_type(const ObTableOperationType::Type op_type)
+{
+  stmt::StmtType stmt_type = stmt::T_INSERT;
+  switch (op_type) {
+    case ObTableOperationType::DEL:
+      stmt_type = stmt::T_DELETE;
+      break;
+    case ObTableOperationType::UPDATE:
+      stmt_type = stmt::T_UPDATE;
+      break;
+    case ObTableOperationType::REPLACE:
+      stmt_type = stmt::T_REPLACE;
+      break;
+    default:
+      // INSERT and INSERT_OR_UPDATE
+      break;
+  }
+  return stmt_type;
+}
+
+bool ObTableApiExecuteP::need_coalesce_write() const
+{
+  // a retried request may have met a lock conflict, execute it alone to wait for the lock
+  return GCONF._tableapi_write_coalesce_window > 0
+      && ObTableConsistencyLevel::STRONG == arg_.consistency_level_
+      && 0 == retry_count_
+      && (NULL == req_ || 0 == req_->get_retry_times());
+}
+
+int ObTableApiExecuteP::process_write()
+{
+  int ret = OB_SUCCESS;
+  switch (arg_.table_operation_.type()) {
+    case ObTableOperationType::INSERT:
+      ret = process_insert();
+      break;
+    case ObTableOperationType::DEL:
+      ret = process_del();
+      break;
+    case ObTableOperationType::UPDATE:
+      ret = process_update();
+      break;
+    case ObTableOperationType::INSERT_OR_UPDATE:
+      ret = process_insert_or_update();
+      break;
+    case ObTableOperationType::REPLACE:
+      ret = process_replace();
+      break;
+    default:
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected operation type to coalesce", K(ret), K_(arg));
+      break;
+  }
+  return ret;
+}
+
+int ObTableApiExecuteP::process_coalesced_write()
+{
+  int ret = OB_SUCCESS;
+  ObTableCoalesceTask task;
+  ObRowkey rowkey = const_cast<ObITableEntity&>(arg_.table_operation_.entity()).get_rowkey();
+  if (OB_FAIL(check_arg2())) {
+  } else if (OB_FAIL(get_table_id(arg_.table_name_, arg_.table_id_, task.table_id_))) {
+    LOG_WARN("failed to get table id", K(ret), K(task));
+  } else if (OB_FAIL(get_partition_id(task.table_id_, rowkey, task.partition_id_))) {
+    LOG_WARN("failed to get partition id", K(ret));
+  } else {
+    ObTableWriteCoalescer &coalescer = table_service_->get_write_coalescer();
+    task.operation_ = &arg_.table_operation_;
+    task.result_ = &result_;
+    task.returning_affected_rows_ = arg_.returning_affected_rows_;
+    task.entity_type_ = arg_.entity_type_;
+    task.binlog_row_image_type_ = arg_.binlog_row_image_type_;
+    task.timeout_ts_ = get_timeout_ts();
+    switch (coalescer.join(task)) {
+      case ObTableWriteCoalescer::LEADER:
+        ret = process_coalesce_group(task);
+        break;
+      case ObTableWriteCoalescer::FOLLOWER:
+        // executed by the leader, unless handed back because of a lock conflict
+        if (OB_FAIL(coalescer.wait(task))) {
+          LOG_WARN("failed to execute coalesced operation", K(ret), K(task));
+        } else if (task.is_handed_back_) {
+          // execute it alone, so that a lock conflict is waited for by this request
+          ret = process_write();
+        }
+        break;
+      default:
+        ret = process_write();
+        break;
+    }
+  }
+  return ret;
+}
+
+int ObTableApiExecuteP::process_coalesce_group(ObTableCoalesceTask &leader)
+{
+  int ret = OB_SUCCESS;
+  ObTableWriteCoalescer &coalescer = table_service_->get_write_coalescer();
+  const int64_t window_us = GCONF._tableapi_write_coalesce_window;
+  ObTableCoalesceTask *head = coalescer.close_group(leader, window_us);
+  int64_t timeout_ts = leader.timeout_ts_;
+  int64_t task_count = 0;
+  for (ObTableCoalesceTask *task = head; NULL != task; task = task->next_) {
+    timeout_ts = std::min(timeout_ts, task->timeout_ts_);
+    ++task_count;
+  }
+  // every operation runs as a stmt of the group transaction,
+  // a failed operation rolls back its own stmt only.
+  // the leader never waits for a row lock on behalf of a follower: an operation meeting a lock
+  // conflict is handed back to its requester, and nothing is executed after a conflict of the leader
+  const bool is_readonly = false;
+  const bool is_autocommit = false;
+  const bool use_sync = true;
+  ObSEArray<int64_t, 1> part_ids;
+  if (OB_FAIL(part_ids.push_back(leader.partition_id_))) {
+    LOG_WARN("failed to push back", K(ret));
+  }
+  for (ObTableCoalesceTask *task = head; OB_SUCC(ret) && NULL != task; task = task->next_) {
+    const sql::stmt::StmtType stmt_type = get_write_stmt_type(task->operation_->type());
+    if (head == task) {
+      if (OB_FAIL(start_trans(is_readonly, stmt_type, leader.table_id_, part_ids, timeout_ts, is_autocommit))) {
+        LOG_WARN("failed to start transaction", K(ret));
+      }
+    } else if (OB_FAIL(start_stmt(stmt_type, timeout_ts))) {
+      LOG_WARN("failed to start stmt", K(ret));
+    }
+    if (OB_SUCC(ret)) {
+      task->ret_ = execute_coalesce_task(*task, timeout_ts);
+      bool is_rollback = (OB_SUCCESS != task->ret_ || OB_SUCCESS != task->result_->get_errno());
+      if (OB_FAIL(end_stmt(is_rollback))) {
+        LOG_WARN("failed to end stmt", K(ret), K(is_rollback));
+      } else if (OB_TRY_LOCK_ROW_CONFLICT != task->ret_) {
+      } else if (&leader == task) {
+        // the conflict is waited for by the retry of the leader, hand back the rest
+        for (ObTableCoalesceTask *follower = task->next_; NULL != follower; follower = follower->next_) {
+          follower->is_handed_back_ = true;
+        }
+        ret = task->ret_;
+      } else {
+        // the conflict was posted to the lock wait node of the leader request,
+        // whose own operation succeeded and must not wait for it
+        task->ret_ = OB_SUCCESS;
+        task->is_handed_back_ = true;
+        if (NULL != req_) {
+          req_->get_lock_wait_node().reset_need_wait();
+        }
+      }
+    }
+  }
+  int tmp_ret = ret;
+  if (OB_FAIL(end_trans(OB_SUCCESS != ret, req_, timeout_ts, use_sync))) {
+    LOG_WARN("failed to end trans", K(ret), K(task_count));
+  }
+  ret = (OB_SUCCESS == tmp_ret) ? ret : tmp_ret;
+  if (OB_FAIL(ret)) {
+    // nothing of the group is committed
+    for (ObTableCoalesceTask *task = head; NULL != task; task = task->next_) {
+      if (OB_SUCCESS == task->ret_ && !task->is_handed_back_) {
+        task->ret_ = ret;
+      }
+    }
+  }
+  LOG_DEBUG("execute coalesced operations", K(ret), K(task_count), K(window_us));
+  ret = leader.ret_;
+  coalescer.finish_group(leader);
+  return ret;
+}
+
+int ObTableApiExecuteP::execute_coalesce_task(ObTableCoalesceTask &task, int64_t timeout_ts)
+{
+  int ret = OB_SUCCESS;
+  ObNewRowIterator *duplicate_row_iter = nullptr;
+  const ObTableOperation &table_operation = *task.operation_;
+  ObTableOperationResult &result = *task.result_;
+  get_ctx_.reset_get_ctx();
+  get_ctx_.init_param(timeout_ts, this->get_trans_desc(), &allocator_,
+                      task.returning_affected_rows_,
+                      task.entity_type_,
+                      task.binlog_row_image_type_);
+  get_ctx_.param_table_id() = task.table_id_;
+  get_ctx_.param_partition_id() = task.partition_id_;
+  switch (table_operation.type()) {
+    case ObTableOperationType::INSERT:
+      ret = table_service_->execute_insert(get_ctx_, table_operation, result, duplicate_row_iter);
+      break;
+    case ObTableOperationType::DEL:
+      ret = table_service_->execute_delete(get_ctx_, table_operation, result);
+      break;
+    case ObTableOperationType::UPDATE:
+      ret = table_service_->execute_update(get_ctx_, table_operation, nullptr, result);
+      break;
+    case ObTableOperationType::INSERT_OR_UPDATE:
+      ret = table_service_->execute_insert_or_update(get_ctx_, table_operation, result);
+      break;
+    case ObTableOperationType::REPLACE:
+      ret = table_service_->execute_replace(get_ctx_, table_operation, result);
+      break;
+    default:
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected operation type to coalesce", K(ret), K(table_operation));
+      break;
+  }
+  if (OB_FAIL(ret) && OB_TRY_LOCK_ROW_CONFLICT != ret) {
+    LOG_WARN("failed to execute coalesced operation", K(ret), K(task));
+  }
+  return ret;
+}
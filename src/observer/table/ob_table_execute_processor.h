@@ -52,6 +52,12 @@ private:
   int process_insert_or_update();
   int process_replace();
   int process_increment();
+  // write coalescing
+  bool need_coalesce_write() const;
+  int process_write();
+  int process_coalesced_write();
+  int process_coalesce_group(ObTableCoalesceTask &leader);
+  int execute_coalesce_task(ObTableCoalesceTask &task, int64_t timeout_ts);
 private:
   table::ObTableEntity request_entity_;
   table::ObTableEntity result_entity_;
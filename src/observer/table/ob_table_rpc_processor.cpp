@@ -448,7 +448,8 @@ int ObTableApiProcessorBase::start_trans(bool is_readonly, const sql::stmt::Stmt
 }
 
 int ObTableApiProcessorBase::start_trans(bool is_readonly, const sql::stmt::StmtType stmt_type,
-                                         uint64_t table_id, const common::ObIArray<int64_t> &part_ids, int64_t timeout_ts)
+                                         uint64_t table_id, const common::ObIArray<int64_t> &part_ids,
+                                         int64_t timeout_ts, bool is_autocommit /*=true*/)
 {
   int ret = OB_SUCCESS;
   NG_TRACE(T_start_trans_begin);
@@ -457,9 +458,6 @@ int ObTableApiProcessorBase::start_trans(bool is_readonly, const sql::stmt::Stmt
   }
   const uint64_t tenant_id = credential_.tenant_id_;
   const int64_t trans_timeout_ts = timeout_ts;
-  const int64_t trans_consistency_level = (ObTableConsistencyLevel::STRONG == consistency_level_) ?  
-      transaction::ObTransConsistencyLevel::STRONG : 
-      transaction::ObTransConsistencyLevel::WEAK;
   const int32_t trans_consistency_type = (ObTableConsistencyLevel::STRONG == consistency_level_) ? 
       transaction::ObTransConsistencyType::CURRENT_READ :
       transaction::ObTransConsistencyType::BOUNDED_STALENESS_READ;
@@ -471,7 +469,7 @@ int ObTableApiProcessorBase::start_trans(bool is_readonly, const sql::stmt::Stmt
     start_trans_param.set_access_mode(access_mode);
     start_trans_param.set_type(transaction::ObTransType::TRANS_USER);
     start_trans_param.set_isolation(transaction::ObTransIsolation::READ_COMMITED);
-    start_trans_param.set_autocommit(true);
+    start_trans_param.set_autocommit(is_autocommit);
     start_trans_param.set_consistency_type(trans_consistency_type);
     // use statement snapshot in default
     // see ObTransConsistencyType and ObTransReadSnapshotType for more details 
@@ -499,6 +497,19 @@ int ObTableApiProcessorBase::start_trans(bool is_readonly, const sql::stmt::Stmt
     }
   }
   NG_TRACE(T_start_trans_end);
+  if (OB_SUCC(ret)) {
+    ret = start_stmt(stmt_type, timeout_ts);
+  }
+  return ret;
+}
+
+int ObTableApiProcessorBase::start_stmt(const sql::stmt::StmtType stmt_type, int64_t timeout_ts)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t tenant_id = credential_.tenant_id_;
+  const int64_t trans_consistency_level = (ObTableConsistencyLevel::STRONG == consistency_level_) ?
+      transaction::ObTransConsistencyLevel::STRONG :
+      transaction::ObTransConsistencyLevel::WEAK;
   // 2. start stmt
   if (OB_SUCC(ret)) {
     transaction::ObStmtDesc &stmt_desc = trans_desc_ptr_->get_cur_stmt_desc();
@@ -513,7 +524,7 @@ int ObTableApiProcessorBase::start_trans(bool is_readonly, const sql::stmt::Stmt
     stmt_desc.inner_sql_ = false;
     stmt_desc.consistency_level_ = trans_consistency_level;
     stmt_desc.is_contain_inner_table_ = false;
-    const int64_t stmt_timeout_ts = trans_timeout_ts;
+    const int64_t stmt_timeout_ts = timeout_ts;
     const bool is_retry_sql = false;
     transaction::ObStmtParam stmt_param;
     ObPartitionArray unreachable_partitions;
@@ -549,6 +560,27 @@ int ObTableApiProcessorBase::start_trans(bool is_readonly, const sql::stmt::Stmt
 
 int ObTableApiProcessorBase::end_trans(bool is_rollback, rpc::ObRequest *req, int64_t timeout_ts,
                                        bool use_sync /*=false*/)
+{
+  int ret = end_stmt(is_rollback);
+  NG_TRACE(T_end_trans_begin);
+  if (trans_state_ptr_->is_start_trans_executed() && trans_state_ptr_->is_start_trans_success()) {
+    if (trans_desc_ptr_->is_readonly() || use_sync) {
+      ret = sync_end_trans(is_rollback, timeout_ts);
+    } else {
+      if (is_rollback) {
+        ret = sync_end_trans(true, timeout_ts);
+      } else {
+        ret = async_commit_trans(req, timeout_ts);
+      }
+    }
+    trans_state_ptr_->clear_start_trans_executed();
+  }
+  trans_state_ptr_->reset();
+  NG_TRACE(T_end_trans_end);
+  return ret;
+}
+
+int ObTableApiProcessorBase::end_stmt(bool &is_rollback)
 {
   int ret = OB_SUCCESS;
   NG_TRACE(T_end_part_begin);
@@ -575,21 +607,6 @@ int ObTableApiProcessorBase::end_trans(bool is_rollback, rpc::ObRequest *req, in
     }
     trans_state_ptr_->clear_start_stmt_executed();
   }
-  NG_TRACE(T_end_trans_begin);
-  if (trans_state_ptr_->is_start_trans_executed() && trans_state_ptr_->is_start_trans_success()) {
-    if (trans_desc_ptr_->is_readonly() || use_sync) {
-      ret = sync_end_trans(is_rollback, timeout_ts);
-    } else {
-      if (is_rollback) {
-        ret = sync_end_trans(true, timeout_ts);
-      } else {
-        ret = async_commit_trans(req, timeout_ts);
-      }
-    }
-    trans_state_ptr_->clear_start_trans_executed();
-  }
-  trans_state_ptr_->reset();
-  NG_TRACE(T_end_trans_end);
   return ret;
 }
 
@@ -132,8 +132,12 @@ public:
                   const ObTableConsistencyLevel consistency_level, uint64_t table_id,
                   const common::ObIArray<int64_t> &part_ids, int64_t timeout_ts);
   int start_trans(bool is_readonly, const sql::stmt::StmtType stmt_type, uint64_t table_id,
-                  const common::ObIArray<int64_t> &part_ids, int64_t timeout_ts);
+                  const common::ObIArray<int64_t> &part_ids, int64_t timeout_ts, bool is_autocommit = true);
   int end_trans(bool is_rollback, rpc::ObRequest *req, int64_t timeout_ts, bool use_sync = false);
+  // start the next stmt of the started transaction
+  int start_stmt(const sql::stmt::StmtType stmt_type, int64_t timeout_ts);
+  // end the current stmt, %is_rollback is set if the stmt is rolled back
+  int end_stmt(bool &is_rollback);
   inline bool did_async_end_trans() const { return did_async_end_trans_; }
   inline transaction::ObTransDesc& get_trans_desc() { return *trans_desc_ptr_; }
   int get_partition_by_rowkey(uint64_t table_id, const ObIArray<common::ObRowkey> &rowkeys,
@@ -67,6 +67,9 @@ int ObTableService::init(ObGlobalContext &gctx)
   int ret = OB_SUCCESS;
   part_service_ = gctx.par_ser_;
   schema_service_ = gctx.schema_service_;
+  if (OB_FAIL(write_coalescer_.init())) {
+    LOG_WARN("failed to init write coalescer", K(ret));
+  }
   return ret;
 }
 
@@ -1869,6 +1872,102 @@ int ObTableService::fill_query_scan_ranges(ObTableServiceCtx &ctx,
   return ret;
 }
 
+// compile the row key filters of htable filter into a bound of K and narrow the scan ranges with it,
+// so that rows filtered out by row key filters are not read from storage
+int ObTableService::narrow_htable_scan_ranges(ObTableServiceQueryCtx &ctx, const ObTableQuery &query,
+                                              uint64_t index_id)
+{
+  int ret = OB_SUCCESS;
+  hfilter::Filter *hfilter = NULL;
+  hfilter::RowKeyBound bound;
+  if (!query.get_htable_filter().is_valid() || ctx.param_.table_id_ != index_id) {
+    // not htable query or not scan by rowkey
+  } else if (OB_ISNULL(ctx.htable_result_iterator_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected null htable result iterator", K(ret));
+  } else if (NULL == (hfilter = ctx.htable_result_iterator_->get_hfilter())) {
+    // no filter
+  } else if (OB_FAIL(hfilter->narrow_row_key_bound(*ctx.param_.allocator_, bound))) {
+    LOG_WARN("failed to narrow row key bound", K(ret));
+  } else if (!bound.is_bounded()) {
+    // the scan can not be narrowed
+  } else if (OB_FAIL(narrow_scan_ranges(
+                 *ctx.param_.allocator_, ctx.columns_type_.count(), bound, ctx.scan_param_.key_ranges_))) {
+    LOG_WARN("failed to narrow scan ranges", K(ret), K(bound));
+  }
+  return ret;
+}
+
+// intersect the scan ranges with the row keys (K) in %bound, the ranges are replaced by a false range
+// if no row key in them passes, the scan order does not matter as storage orders the ranges itself
+int ObTableService::narrow_scan_ranges(ObIAllocator &allocator,
+                                       const int64_t rowkey_cnt,
+                                       const hfilter::RowKeyBound &bound,
+                                       ObIArray<ObNewRange> &key_ranges)
+{
+  int ret = OB_SUCCESS;
+  ObObj *lower_objs = NULL;
+  ObObj *upper_objs = NULL;
+  ObRowkey lower_key;
+  ObRowkey upper_key;
+  ObSEArray<ObNewRange, 16> narrowed_ranges;
+  if (OB_UNLIKELY(rowkey_cnt <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid rowkey columns", K(ret), K(rowkey_cnt));
+  } else if (NULL == (lower_objs = static_cast<ObObj*>(allocator.alloc(sizeof(ObObj) * rowkey_cnt)))
+             || NULL == (upper_objs = static_cast<ObObj*>(allocator.alloc(sizeof(ObObj) * rowkey_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("no memory", K(ret), K(rowkey_cnt));
+  } else {
+    // (K, MIN, MIN) is before all cells of row K, (K, MAX, MAX) is after them
+    lower_objs[0].set_varbinary(bound.lower_);
+    upper_objs[0].set_varbinary(bound.upper_);
+    for (int64_t i = 1; i < rowkey_cnt; ++i) {
+      lower_objs[i] = bound.lower_inclusive_ ? ObObj::make_min_obj() : ObObj::make_max_obj();
+      upper_objs[i] = bound.upper_inclusive_ ? ObObj::make_max_obj() : ObObj::make_min_obj();
+    }
+    lower_key.assign(lower_objs, rowkey_cnt);
+    upper_key.assign(upper_objs, rowkey_cnt);
+  }
+  const int64_t N = key_ranges.count();
+  for (int64_t i = 0; OB_SUCCESS == ret && i < N; ++i) {
+    ObNewRange range = key_ranges.at(i);
+    if (bound.has_lower_ && (range.start_key_.is_min_row() || range.start_key_.compare(lower_key) < 0)) {
+      range.start_key_ = lower_key;
+      range.border_flag_.set_inclusive_start();
+    }
+    if (bound.has_upper_ && (range.end_key_.is_max_row() || range.end_key_.compare(upper_key) > 0)) {
+      range.end_key_ = upper_key;
+      range.border_flag_.set_inclusive_end();
+    }
+    if (range.empty()) {
+      // no row of this range passes the filter
+    } else if (OB_FAIL(narrowed_ranges.push_back(range))) {
+      LOG_WARN("fail to push back key range", K(ret), K(range));
+    }
+  } // end for
+  if (OB_FAIL(ret) || 0 == N) {
+  } else if (narrowed_ranges.empty()) {
+    // no ranges means the whole table to storage, so scan a false range which storage skips
+    ObNewRange false_range;
+    false_range.table_id_ = key_ranges.at(0).table_id_;
+    false_range.start_key_.set_max_row();
+    false_range.end_key_.set_min_row();
+    if (OB_FAIL(narrowed_ranges.push_back(false_range))) {
+      LOG_WARN("fail to push back false range", K(ret), K(false_range));
+    } else {
+      LOG_DEBUG("no scan range passes the htable filter", K(bound), K(key_ranges));
+    }
+  }
+  if (OB_FAIL(ret) || 0 == N) {
+  } else if (OB_FAIL(key_ranges.assign(narrowed_ranges))) {
+    LOG_WARN("fail to assign key ranges", K(ret));
+  } else {
+    LOG_DEBUG("narrow htable scan ranges", K(bound), K(key_ranges));
+  }
+  return ret;
+}
+
 int ObTableService::fill_query_scan_param(ObTableServiceCtx &ctx, const ObIArray<uint64_t> &output_column_ids,
     int64_t schema_version, ObQueryFlag::ScanOrder scan_order, uint64_t index_id, int32_t limit, int32_t offset,
     storage::ObTableScanParam &scan_param, bool for_update /* false */)
@@ -2107,6 +2206,8 @@ int ObTableService::execute_query(ObTableServiceQueryCtx &ctx, const ObTableQuer
                                             (table_id != index_id) ? padding_num : -1,
                                             ctx.scan_param_))) {
     LOG_WARN("failed to fill range", K(ret));
+  } else if (OB_FAIL(narrow_htable_scan_ranges(ctx, query, index_id))) {
+    LOG_WARN("failed to narrow htable scan ranges", K(ret));
   } else if (OB_FAIL(fill_query_scan_param(ctx,
                  output_column_ids,
                  schema_version,
@@ -19,12 +19,17 @@
 #include "storage/ob_dml_param.h"
 #include "share/schema/ob_table_param.h"
 #include "common/row/ob_row_iterator.h"
+#include "ob_table_write_coalescer.h"
 namespace oceanbase
 {
 namespace table
 {
 class ObHTableFilterOperator;
 class ObHColumnDescriptor;
+namespace hfilter
+{
+struct RowKeyBound;
+} // end namespace hfilter
 } // end namespace table
 namespace storage
 {
@@ -261,6 +266,7 @@ public:
       table::ObTableQueryResultIterator *&query_result, bool for_update = false);
   int batch_execute(ObTableServiceGetCtx &ctx, const ObTableBatchOperation &batch_operation, ObTableBatchOperationResult &result);
   int execute_ttl_delete(ObTableServiceTTLCtx &ctx, const ObTableTTLOperation &ttl_operation, ObTableTTLOperationResult &result);
+  ObTableWriteCoalescer &get_write_coalescer() { return write_coalescer_; }
 private:
   static int cons_rowkey_infos(const share::schema::ObTableSchema &table_schema,
                                common::ObIArray<uint64_t> *column_ids,
@@ -350,6 +356,11 @@ private:
                              const ObTableQuery &query,
                              int64_t padding_num,
                              storage::ObTableScanParam &scan_param);
+  int narrow_htable_scan_ranges(ObTableServiceQueryCtx &ctx, const ObTableQuery &query, uint64_t index_id);
+  static int narrow_scan_ranges(common::ObIAllocator &allocator,
+                                const int64_t rowkey_cnt,
+                                const table::hfilter::RowKeyBound &bound,
+                                common::ObIArray<common::ObNewRange> &key_ranges);
   int fill_query_scan_param(ObTableServiceCtx &ctx,
                             const common::ObIArray<uint64_t> &output_column_ids,
                             int64_t schema_version,
@@ -384,6 +395,7 @@ private:
   static const int64_t COMMON_COLUMN_NUM = 16;
   storage::ObPartitionService *part_service_;
   share::schema::ObMultiVersionSchemaService *schema_service_;
+  ObTableWriteCoalescer write_coalescer_;
 };
 
 } // end namespace observer
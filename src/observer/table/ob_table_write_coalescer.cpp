@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SERVER
+#include "ob_table_write_coalescer.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "lib/time/ob_time_utility.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::observer;
+
+ObTableWriteCoalescer::ObTableWriteCoalescer()
+    :is_inited_(false)
+{
+}
+
+ObTableWriteCoalescer::~ObTableWriteCoalescer()
+{
+  destroy();
+}
+
+int ObTableWriteCoalescer::init()
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("write coalescer is inited twice", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < BUCKET_COUNT; ++i) {
+      if (OB_FAIL(buckets_[i].cond_.init(ObWaitEventIds::TABLE_WRITE_COALESCE_WAIT))) {
+        LOG_WARN("failed to init bucket cond", K(ret), K(i));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      is_inited_ = true;
+    }
+  }
+  return ret;
+}
+
+void ObTableWriteCoalescer::destroy()
+{
+  for (int64_t i = 0; i < BUCKET_COUNT; ++i) {
+    buckets_[i].cond_.destroy();
+    buckets_[i].head_ = NULL;
+    buckets_[i].tail_ = NULL;
+    buckets_[i].task_count_ = 0;
+    buckets_[i].running_group_count_ = 0;
+  }
+  is_inited_ = false;
+}
+
+ObTableWriteCoalescer::Bucket &ObTableWriteCoalescer::get_bucket(const uint64_t table_id,
+                                                                 const uint64_t partition_id)
+{
+  uint64_t hash_val = murmurhash(&table_id, sizeof(table_id), 0);
+  hash_val = murmurhash(&partition_id, sizeof(partition_id), hash_val);
+  return buckets_[hash_val % BUCKET_COUNT];
+}
+
+ObTableWriteCoalescer::Role ObTableWriteCoalescer::join(ObTableCoalesceTask &task)
+{
+  Role role = ALONE;
+  task.ret_ = OB_SUCCESS;
+  task.is_done_ = false;
+  task.is_handed_back_ = false;
+  task.next_ = NULL;
+  if (OB_LIKELY(is_inited_)) {
+    Bucket &bucket = get_bucket(task.table_id_, task.partition_id_);
+    ObThreadCondGuard guard(bucket.cond_);
+    if (NULL == bucket.head_) {
+      bucket.head_ = &task;
+      bucket.tail_ = &task;
+      bucket.task_count_ = 1;
+      role = LEADER;
+    } else if (bucket.head_->table_id_ == task.table_id_
+               && bucket.head_->partition_id_ == task.partition_id_
+               && bucket.task_count_ < MAX_GROUP_SIZE) {
+      bucket.tail_->next_ = &task;
+      bucket.tail_ = &task;
+      ++bucket.task_count_;
+      role = FOLLOWER;
+      if (MAX_GROUP_SIZE == bucket.task_count_) {
+        // the group is full, let the leader go
+        (void)bucket.cond_.broadcast();
+      }
+    }
+  }
+  return role;
+}
+
+ObTableCoalesceTask *ObTableWriteCoalescer::close_group(ObTableCoalesceTask &leader, const int64_t window_us)
+{
+  Bucket &bucket = get_bucket(leader.table_id_, leader.partition_id_);
+  const int64_t deadline = std::min(ObTimeUtility::current_time() + window_us, leader.timeout_ts_);
+  ObThreadCondGuard guard(bucket.cond_);
+  if (1 == bucket.task_count_ && 0 == bucket.running_group_count_) {
+    // nothing to coalesce with, do not delay a lone request
+  } else {
+    int64_t wait_us = deadline - ObTimeUtility::current_time();
+    // the cond is shared by all groups of the bucket, wake ups of other groups are ignored
+    while (bucket.task_count_ < MAX_GROUP_SIZE && wait_us > 0) {
+      (void)bucket.cond_.wait_us(wait_us);
+      wait_us = deadline - ObTimeUtility::current_time();
+    }
+  }
+  if (OB_UNLIKELY(bucket.head_ != &leader)) {
+    LOG_ERROR("the group of leader is not in the bucket", K(leader), KP(bucket.head_));
+  } else {
+    LOG_DEBUG("close write coalesce group", K(leader), "task_count", bucket.task_count_);
+    bucket.head_ = NULL;
+    bucket.tail_ = NULL;
+    bucket.task_count_ = 0;
+    ++bucket.running_group_count_;
+  }
+  return &leader;
+}
+
+void ObTableWriteCoalescer::finish_group(ObTableCoalesceTask &leader)
+{
+  Bucket &bucket = get_bucket(leader.table_id_, leader.partition_id_);
+  ObThreadCondGuard guard(bucket.cond_);
+  ObTableCoalesceTask *task = leader.next_;
+  leader.next_ = NULL;
+  while (NULL != task) {
+    // a follower may return as soon as it is done, so read its next first
+    ObTableCoalesceTask *next = task->next_;
+    task->is_done_ = true;
+    task = next;
+  }
+  --bucket.running_group_count_;
+  (void)bucket.cond_.broadcast();
+}
+
+// take %task out of the group which is not closed yet, the caller holds the bucket lock
+bool ObTableWriteCoalescer::remove_task(Bucket &bucket, ObTableCoalesceTask &task)
+{
+  bool is_removed = false;
+  ObTableCoalesceTask *prev = bucket.head_;
+  while (NULL != prev && NULL != prev->next_ && prev->next_ != &task) {
+    prev = prev->next_;
+  }
+  if (NULL != prev && prev->next_ == &task) {
+    prev->next_ = task.next_;
+    if (bucket.tail_ == &task) {
+      bucket.tail_ = prev;
+    }
+    --bucket.task_count_;
+    task.next_ = NULL;
+    is_removed = true;
+  }
+  return is_removed;
+}
+
+int ObTableWriteCoalescer::wait(ObTableCoalesceTask &task)
+{
+  int ret = OB_SUCCESS;
+  const int64_t WAIT_INTERVAL_US = 100 * 1000;
+  Bucket &bucket = get_bucket(task.table_id_, task.partition_id_);
+  ObThreadCondGuard guard(bucket.cond_);
+  bool is_removed = false;
+  while (!task.is_done_ && !is_removed) {
+    const int64_t wait_us = task.timeout_ts_ - ObTimeUtility::current_time();
+    if (wait_us > 0) {
+      (void)bucket.cond_.wait_us(std::min(wait_us, WAIT_INTERVAL_US));
+    } else if (remove_task(bucket, task)) {
+      is_removed = true;
+    } else {
+      // the leader has taken the group, which is executed within the timeout of this task
+      (void)bucket.cond_.wait_us(WAIT_INTERVAL_US);
+    }
+  }
+  if (is_removed) {
+    ret = OB_TIMEOUT;
+    LOG_WARN("write coalesce task timeout before executed", K(ret), K(task));
+  } else {
+    ret = task.ret_;
+  }
+  return ret;
+}
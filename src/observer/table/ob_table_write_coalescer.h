@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef _OB_TABLE_WRITE_COALESCER_H
+#define _OB_TABLE_WRITE_COALESCER_H 1
+#include "lib/lock/ob_thread_cond.h"
+#include "share/table/ob_table.h"
+
+namespace oceanbase
+{
+namespace observer
+{
+/// a single-row mutation executed by the leader of its group on behalf of the requester
+struct ObTableCoalesceTask
+{
+  ObTableCoalesceTask()
+      :table_id_(common::OB_INVALID_ID),
+       partition_id_(common::OB_INVALID_ID),
+       operation_(NULL),
+       result_(NULL),
+       returning_affected_rows_(false),
+       entity_type_(table::ObTableEntityType::ET_DYNAMIC),
+       binlog_row_image_type_(table::ObBinlogRowImageType::FULL),
+       timeout_ts_(0),
+       ret_(common::OB_SUCCESS),
+       is_done_(false),
+       is_handed_back_(false),
+       next_(NULL)
+  {}
+  TO_STRING_KV(K_(table_id), K_(partition_id), KPC_(operation), K_(returning_affected_rows),
+               K_(entity_type), K_(binlog_row_image_type), K_(timeout_ts), K_(ret), K_(is_done),
+               K_(is_handed_back));
+
+  uint64_t table_id_;
+  uint64_t partition_id_;
+  const table::ObTableOperation *operation_;
+  table::ObTableOperationResult *result_;
+  bool returning_affected_rows_;
+  table::ObTableEntityType entity_type_;
+  table::ObBinlogRowImageType binlog_row_image_type_;
+  int64_t timeout_ts_;
+  int ret_;
+  bool is_done_;
+  // not executed by the leader because of a lock conflict, the requester executes it alone
+  // so that the lock wait is attached to its own request
+  bool is_handed_back_;
+  ObTableCoalesceTask *next_;
+};
+
+/// Group concurrent single-row mutations of the same partition into one transaction.
+///
+/// The first request of a partition becomes the leader of a group, it closes the group
+/// and executes all tasks of the group in one transaction. The leader waits for the
+/// coalesce window only if there is concurrency to coalesce, that is followers have
+/// joined already or an earlier group of the bucket is still executing, a lone leader
+/// closes its group at once. Requests arriving before the group is closed join it as
+/// followers and block until the leader finishes the group or their own timeout.
+/// An operation which meets a lock conflict is handed back to its requester, the leader
+/// never waits for a row lock on behalf of another request.
+/// Partitions are hashed into buckets, a request whose bucket is taken by a group of
+/// another partition or by a full group is executed alone.
+class ObTableWriteCoalescer
+{
+public:
+  enum Role
+  {
+    ALONE = 0,
+    LEADER = 1,
+    FOLLOWER = 2
+  };
+  static const int64_t BUCKET_COUNT = 128;
+  static const int64_t MAX_GROUP_SIZE = 64;
+public:
+  ObTableWriteCoalescer();
+  virtual ~ObTableWriteCoalescer();
+  int init();
+  void destroy();
+  Role join(ObTableCoalesceTask &task);
+  /// leader only, wait at most %window_us for followers and detach the group from its bucket,
+  /// the leader task is the head of the returned list
+  ObTableCoalesceTask *close_group(ObTableCoalesceTask &leader, const int64_t window_us);
+  /// leader only, mark the followers of a closed group as done and wake them up
+  void finish_group(ObTableCoalesceTask &leader);
+  /// follower only, wait until the leader finishes the group.
+  /// return OB_TIMEOUT if %task leaves the group before it is closed because of its timeout,
+  /// a closed group refers to %task and is executed within the timeout of %task
+  /// %task is not executed if it is handed back, the requester executes it alone
+  int wait(ObTableCoalesceTask &task);
+private:
+  struct Bucket
+  {
+    Bucket()
+        :head_(NULL),
+         tail_(NULL),
+         task_count_(0),
+         running_group_count_(0)
+    {}
+    common::ObThreadCond cond_;
+    ObTableCoalesceTask *head_;
+    ObTableCoalesceTask *tail_;
+    int64_t task_count_;
+    int64_t running_group_count_;  // closed but not finished groups
+  };
+  Bucket &get_bucket(const uint64_t table_id, const uint64_t partition_id);
+  bool remove_task(Bucket &bucket, ObTableCoalesceTask &task);
+private:
+  bool is_inited_;
+  Bucket buckets_[BUCKET_COUNT];
+  DISALLOW_COPY_AND_ASSIGN(ObTableWriteCoalescer);
+};
+
+} // end namespace observer
+} // end namespace oceanbase
+
+#endif /* _OB_TABLE_WRITE_COALESCER_H */
@@ -267,6 +267,8 @@ int ObKVCacheInstMap::get_cache_inst(const ObKVCacheInstKey& inst_key, ObKVCache
         } else if (OB_FAIL(inst->node_allocator_.init(
                        OB_MALLOC_BIG_BLOCK_SIZE, ObNewModIds::OB_KVSTORE_CACHE, inst_key.tenant_id_, 1))) {
           COMMON_LOG(WARN, "Fail to init node allocator, ", K(ret));
+        } else if (OB_FAIL(inst->freq_sketch_.init(inst_key.tenant_id_))) {
+          COMMON_LOG(WARN, "Fail to init freq sketch, ", K(ret));
         } else if (OB_FAIL(inst_map_.set_refactored(inst_key, inst))) {
           COMMON_LOG(WARN, "Fail to set inst to inst map, ", K(ret));
         } else {
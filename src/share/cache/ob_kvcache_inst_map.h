@@ -92,6 +92,9 @@ struct ObTenantMBListHandle {
 };
 
 struct ObKVCacheInst {
+  // a new key seen at least once before is always admitted
+  static const uint64_t MIN_ADMIT_FREQ = 1;
+  static const int64_t PERMILLE = 1000;
   int64_t cache_id_;
   uint64_t tenant_id_;
   ObKVMemBlockHandle* handles_[MAX_POLICY];
@@ -99,7 +102,20 @@ struct ObKVCacheInst {
   ObKVCacheStatus status_;
   int64_t ref_cnt_;
   ObTenantMBListHandle mb_list_handle_;  // list of tenant mbs
-  ObKVCacheInst() : cache_id_(0), tenant_id_(0), node_allocator_(), status_(), ref_cnt_(0), mb_list_handle_()
+  ObKVCacheFreqSketch freq_sketch_;
+  // set by wash thread to the share of the tenant cache which has to be washed, in per mille.
+  // The same share of new keys never accessed before is rejected from the map, so that the cache
+  // keeps admitting new keys while it is only washed a little.
+  int64_t reject_permille_;
+  ObKVCacheInst()
+      : cache_id_(0),
+        tenant_id_(0),
+        node_allocator_(),
+        status_(),
+        ref_cnt_(0),
+        mb_list_handle_(),
+        freq_sketch_(),
+        reject_permille_(0)
   {
     MEMSET(handles_, 0, sizeof(handles_));
   }
@@ -117,6 +133,8 @@ struct ObKVCacheInst {
     status_.reset();
     ref_cnt_ = 0;
     mb_list_handle_.reset();
+    freq_sketch_.destroy();
+    reject_permille_ = 0;
     MEMSET(handles_, 0, sizeof(handles_));
   }
   bool is_valid() const
@@ -124,6 +142,24 @@ struct ObKVCacheInst {
     return ref_cnt_ > 0;
   }
 
+  // TinyLFU admission of a key not in map yet
+  inline bool admit(const uint64_t hash)
+  {
+    bool admitted = true;
+    const int64_t reject_permille = ATOMIC_LOAD(&reject_permille_);
+    if (reject_permille > 0 && freq_sketch_.estimate(hash) < MIN_ADMIT_FREQ) {
+      // key hashes may be plain integers, mix them before picking the rejected share
+      admitted = static_cast<int64_t>(((hash * 0x9e3779b97f4a7c15UL) >> 32) % PERMILLE) >= reject_permille;
+    }
+    freq_sketch_.record(hash);
+    if (admitted) {
+      status_.total_admit_cnt_.inc();
+    } else {
+      status_.total_reject_cnt_.inc();
+    }
+    return admitted;
+  }
+
   // hold size related
   inline bool need_hold_cache()
   {
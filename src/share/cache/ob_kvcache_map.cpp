@@ -81,6 +81,9 @@ void ObKVCacheMap::destroy()
         }
         iter = NULL;
       }
+      // free nodes and freq sketch tables retired by threads
+      purge_nodes();
+      ObKVCacheFreqSketch::purge_tables();
     }
     const int64_t bucket_cnt = bucket_num_ % Bucket::BUCKET_SIZE == 0 ? bucket_num_ / Bucket::BUCKET_SIZE
                                                                       : bucket_num_ / Bucket::BUCKET_SIZE + 1;
@@ -107,7 +110,8 @@ int ObKVCacheMap::put(ObKVCacheInst& inst, const ObIKVCacheKey& key, const ObKVC
   Node* insert_node = NULL;
   Node* iter = NULL;
   Node* prev = NULL;
-  bool is_overwrite = false;
+  Node* overwrite_node = NULL;
+  HazardList retire_list;
 
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
@@ -116,23 +120,23 @@ int ObKVCacheMap::put(ObKVCacheInst& inst, const ObIKVCacheKey& key, const ObKVC
     ret = OB_INVALID_ARGUMENT;
     COMMON_LOG(WARN, "Invalid argument, ", KP(kvpair), KP(mb_handle), K(ret));
   } else {
-    uint64_t hash_code = key.hash() + inst.cache_id_;
+    const uint64_t key_hash = key.hash();
+    uint64_t hash_code = key_hash + inst.cache_id_;
     uint64_t bucket_pos = hash_code % bucket_num_;
 
     ObBucketWLockGuard guard(bucket_lock_, bucket_pos);
-    Node*& bucket_ptr = get_bucket_node(bucket_pos);
     if (OB_FAIL(guard.get_ret())) {
       COMMON_LOG(WARN, "Fail to lock bucket, ", K(bucket_pos), K(ret));
     } else {
-      if (NULL != (iter = bucket_ptr)) {
+      if (NULL != (iter = get_bucket_node(bucket_pos))) {
         while (NULL != iter && OB_SUCC(ret)) {
           if (!store_->add_handle_ref(iter->mb_handle_, iter->seq_num_)) {
             // remove expired kv-pairs
-            internal_map_erase(prev, iter, bucket_pos);
+            internal_map_erase(prev, iter, bucket_pos, retire_list);
           } else {
             // fragment node collection
             if (iter->inst_->node_allocator_.is_fragment(iter)) {
-              internal_map_replace(prev, iter, bucket_pos);
+              internal_map_replace(prev, iter, bucket_pos, retire_list);
             }
 
             if (hash_code == iter->hash_code_ && key == *(iter->key_)) {
@@ -140,8 +144,7 @@ int ObKVCacheMap::put(ObKVCacheInst& inst, const ObIKVCacheKey& key, const ObKVC
               if (overwrite) {
                 (void)ATOMIC_SAF(&iter->mb_handle_->kv_cnt_, 1);
                 (void)ATOMIC_SAF(&iter->mb_handle_->get_cnt_, iter->get_cnt_);
-                insert_node = iter;
-                is_overwrite = true;
+                overwrite_node = iter;
               } else {
                 ret = OB_ENTRY_EXIST;
               }
@@ -156,46 +159,47 @@ int ObKVCacheMap::put(ObKVCacheInst& inst, const ObIKVCacheKey& key, const ObKVC
         }
       }
 
-      if (OB_SUCC(ret)) {
-        if (NULL == insert_node) {
-          void* buf = NULL;
-          if (NULL == (buf = inst.node_allocator_.alloc(sizeof(Node)))) {
-            ret = OB_ALLOCATE_MEMORY_FAILED;
-            COMMON_LOG(ERROR, "Fail to allocate memory, ", K(ret), "size", sizeof(Node));
-          } else {
-            insert_node = new (buf) Node();
-            if (NULL == prev) {
-              bucket_ptr = insert_node;
-            }
-            insert_node->next_ = NULL;
-          }
-        }
-
-        if (OB_SUCC(ret)) {
-          if (prev != NULL) {
-            prev->next_ = insert_node;
-          }
-
+      bool admitted = NULL != overwrite_node;
+      if (OB_SUCC(ret) && !admitted) {
+        // the freq sketch table may be retired by the wash thread
+        QClockGuard qclock_guard(get_qclock());
+        admitted = inst.admit(key_hash);
+      }
+      if (OB_SUCC(ret) && admitted) {
+        void* buf = NULL;
+        if (NULL == (buf = inst.node_allocator_.alloc(sizeof(Node)))) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          COMMON_LOG(ERROR, "Fail to allocate memory, ", K(ret), "size", sizeof(Node));
+        } else {
+          insert_node = new (buf) Node();
           insert_node->inst_ = &inst;
-          insert_node->get_cnt_++;
+          insert_node->get_cnt_ = NULL == overwrite_node ? 1 : overwrite_node->get_cnt_ + 1;
           insert_node->mb_handle_ = mb_handle;
           insert_node->key_ = kvpair->key_;
           insert_node->value_ = kvpair->value_;
           insert_node->hash_code_ = hash_code;
           insert_node->seq_num_ = mb_handle->handle_ref_.get_seq_num();
 
+          if (NULL == overwrite_node) {
+            insert_node->next_ = NULL;
+            internal_map_link(prev, insert_node, bucket_pos);
+            (void)ATOMIC_AAF(&inst.status_.kv_cnt_, 1);
+          } else {
+            // readers may be visiting the old node, replace it instead of writing in place
+            insert_node->next_ = overwrite_node->next_;
+            internal_map_link(prev, insert_node, bucket_pos);
+            retire_node(overwrite_node, retire_list);
+          }
+
           (void)ATOMIC_AAF(&mb_handle->kv_cnt_, 1);
           (void)ATOMIC_AAF(&mb_handle->get_cnt_, 1);
           (void)ATOMIC_AAF(&mb_handle->recent_get_cnt_, 1);
-
-          if (!is_overwrite) {
-            (void)ATOMIC_AAF(&inst.status_.kv_cnt_, 1);
-          }
           inst.status_.total_put_cnt_.inc();
         }
       }
     }
   }
+  retire_nodes(retire_list);
 
   return ret;
 }
@@ -209,95 +213,89 @@ int ObKVCacheMap::get(
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObKVCacheMap has not been inited, ", K(ret));
   } else {
-    const uint64_t tenant_id = key.get_tenant_id();
     bool need_modify = false;
-    uint64_t hash_code = key.hash() + cache_id;
+    const uint64_t key_hash = key.hash();
+    uint64_t hash_code = key_hash + cache_id;
     uint64_t bucket_pos = hash_code % bucket_num_;
     Node* iter = NULL;
     Node* prev = NULL;
 
-    // add read lock and read
+    // lock free read, nodes unlinked from the chain are not freed until we leave the critical section
     {
-      ObBucketRLockGuard rd_guard(bucket_lock_, bucket_pos);
-      if (OB_FAIL(rd_guard.get_ret())) {
-        COMMON_LOG(WARN, "Fail to lock bucket, ", K(bucket_pos), K(ret));
-      } else {
-        if (NULL != (iter = get_bucket_node(bucket_pos))) {
-
-          while (NULL != iter && OB_SUCC(ret)) {
-            if (!store_->add_handle_ref(iter->mb_handle_, iter->seq_num_)) {
-              // garbage node
-              need_modify = true;
-            } else {
-              if (hash_code == iter->hash_code_ && key == *(iter->key_)) {
-                break;
-              }
-              // The handle ref must be deref
-              store_->de_handle_ref(iter->mb_handle_);
-            }
-            iter = iter->next_;
-          }
-
-          if (NULL == iter) {
-            ret = OB_ENTRY_NOT_EXIST;
+      QClockGuard guard(get_qclock());
+      iter = ATOMIC_LOAD(&get_bucket_node(bucket_pos));
+      while (NULL != iter) {
+        if (!store_->add_handle_ref(iter->mb_handle_, iter->seq_num_)) {
+          // garbage node
+          need_modify = true;
+        } else {
+          if (hash_code == iter->hash_code_ && key == *(iter->key_)) {
+            break;
           }
+          // The handle ref must be deref
+          store_->de_handle_ref(iter->mb_handle_);
+        }
+        iter = ATOMIC_LOAD(&iter->next_);
+      }
 
-          if (OB_SUCC(ret)) {
-            pvalue = iter->value_;
-            out_handle = iter->mb_handle_;
-            if (LRU == out_handle->policy_) {
-              need_modify = need_modify_cache(iter->get_cnt_, out_handle->get_cnt_, out_handle->kv_cnt_);
-            }
-            out_handle->get_cnt_++;
-            out_handle->recent_get_cnt_++;
-            iter->get_cnt_++;
-          }
-        } else {
-          ret = OB_ENTRY_NOT_EXIST;
+      if (NULL == iter) {
+        ret = OB_ENTRY_NOT_EXIST;
+      } else {
+        pvalue = iter->value_;
+        out_handle = iter->mb_handle_;
+        if (LRU == out_handle->policy_) {
+          need_modify = need_modify_cache(iter->get_cnt_, out_handle->get_cnt_, out_handle->kv_cnt_);
         }
+        out_handle->get_cnt_++;
+        out_handle->recent_get_cnt_++;
+        iter->get_cnt_++;
+        iter->inst_->freq_sketch_.record(key_hash);
       }
     }
 
     if (OB_SUCC(ret)) {
       out_handle->inst_->status_.total_hit_cnt_.inc();
       if (need_modify) {
-        // need add write lock and do some modification
-        ObBucketWLockGuard wr_guard(bucket_lock_, bucket_pos);
-        if (OB_FAIL(wr_guard.get_ret())) {
-          COMMON_LOG(WARN, "Fail to add write lock, ", K(wr_guard.get_ret()));
-        } else {
-          if (NULL != (iter = get_bucket_node(bucket_pos))) {
-            prev = NULL;
-            Node* move_node = NULL;
-
-            while (NULL != iter && OB_SUCC(ret)) {
-              if (!store_->add_handle_ref(iter->mb_handle_, iter->seq_num_)) {
-                // remove expire node
-                internal_map_erase(prev, iter, bucket_pos);
-              } else {
-                // fragment node collection
-                if (iter->inst_->node_allocator_.is_fragment(iter)) {
-                  internal_map_replace(prev, iter, bucket_pos);
-                }
+        HazardList retire_list;
+        {
+          // need add write lock and do some modification
+          ObBucketWLockGuard wr_guard(bucket_lock_, bucket_pos);
+          if (OB_FAIL(wr_guard.get_ret())) {
+            COMMON_LOG(WARN, "Fail to add write lock, ", K(wr_guard.get_ret()));
+          } else {
+            if (NULL != (iter = get_bucket_node(bucket_pos))) {
+              prev = NULL;
+
+              while (NULL != iter && OB_SUCC(ret)) {
+                if (!store_->add_handle_ref(iter->mb_handle_, iter->seq_num_)) {
+                  // remove expire node
+                  internal_map_erase(prev, iter, bucket_pos, retire_list);
+                } else {
+                  // fragment node collection
+                  if (iter->inst_->node_allocator_.is_fragment(iter)) {
+                    internal_map_replace(prev, iter, bucket_pos, retire_list);
+                  }
 
-                if (iter->mb_handle_ == out_handle && LRU == out_handle->policy_) {
-                  if (hash_code == iter->hash_code_ && key == *(iter->key_)) {
-                    move_node = iter;
+                  bool need_move = false;
+                  if (iter->mb_handle_ == out_handle && LRU == out_handle->policy_) {
+                    if (hash_code == iter->hash_code_ && key == *(iter->key_)) {
+                      need_move = true;
+                    }
                   }
-                }
 
-                // The handle ref must be deref
-                store_->de_handle_ref(iter->mb_handle_);
-                prev = iter;
-                iter = iter->next_;
+                  // The handle ref must be deref
+                  store_->de_handle_ref(iter->mb_handle_);
+                  if (need_move) {
+                    internal_data_move(prev, iter, bucket_pos, LFU, retire_list);
+                  }
+                  prev = iter;
+                  iter = iter->next_;
+                }
               }
             }
-
-            if (OB_NOT_NULL(move_node)) {
-              internal_data_move(move_node, LFU);
-            }
           }
         }
+        retire_nodes(retire_list);
       }
     }
   }
@@ -308,6 +306,7 @@ int ObKVCacheMap::get(
 int ObKVCacheMap::erase(ObKVCacheInst& inst, const ObIKVCacheKey& key)
 {
   int ret = OB_SUCCESS;
+  HazardList retire_list;
 
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
@@ -330,11 +329,11 @@ int ObKVCacheMap::erase(ObKVCacheInst& inst, const ObIKVCacheKey& key)
 
         while (NULL != iter && OB_SUCC(ret)) {
           if (!store_->add_handle_ref(iter->mb_handle_, iter->seq_num_)) {
-            internal_map_erase(prev, iter, bucket_pos);
+            internal_map_erase(prev, iter, bucket_pos, retire_list);
           } else {
             // fragment node collection
             if (iter->inst_->node_allocator_.is_fragment(iter)) {
-              internal_map_replace(prev, iter, bucket_pos);
+              internal_map_replace(prev, iter, bucket_pos, retire_list);
             }
 
             if (&inst == iter->inst_ && key == *(iter->key_)) {
@@ -344,7 +343,7 @@ int ObKVCacheMap::erase(ObKVCacheInst& inst, const ObIKVCacheKey& key)
               (void)ATOMIC_SAF(&mb_handle->get_cnt_, iter->get_cnt_);
 
               store_->de_handle_ref(iter->mb_handle_);
-              internal_map_erase(prev, iter, bucket_pos);
+              internal_map_erase(prev, iter, bucket_pos, retire_list);
               found = true;
               break;
             } else {
@@ -363,6 +362,7 @@ int ObKVCacheMap::erase(ObKVCacheInst& inst, const ObIKVCacheKey& key)
       }
     }
   }
+  retire_nodes(retire_list);
 
   return ret;
 }
@@ -370,6 +370,7 @@ int ObKVCacheMap::erase(ObKVCacheInst& inst, const ObIKVCacheKey& key)
 int ObKVCacheMap::erase_all()
 {
   int ret = OB_SUCCESS;
+  HazardList retire_list;
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObKVCacheMap has not been inited, ", K(ret));
@@ -381,26 +382,29 @@ int ObKVCacheMap::erase_all()
       } else {
         Node*& bucket_ptr = get_bucket_node(i);
         Node* iter = get_bucket_node(i);
+        ATOMIC_STORE(&bucket_ptr, NULL);
         while (NULL != iter) {
           Node* tmp = iter;
           ObKVCacheInst* inst = iter->inst_;
           iter = iter->next_;
-          tmp->inst_->node_allocator_.free(tmp);
+          retire_node(tmp, retire_list);
           if (NULL != inst) {
             (void)ATOMIC_SAF(&inst->status_.kv_cnt_, 1);
           }
           tmp = NULL;
         }
-        bucket_ptr = NULL;
       }
     }
   }
+  retire_nodes(retire_list);
+  purge_nodes();
   return ret;
 }
 
 int ObKVCacheMap::erase_all(const int64_t cache_id)
 {
   int ret = OB_SUCCESS;
+  HazardList retire_list;
 
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
@@ -419,7 +423,7 @@ int ObKVCacheMap::erase_all(const int64_t cache_id)
           Node* prev = NULL;
           while (NULL != iter) {
             if (iter->inst_->cache_id_ == cache_id) {
-              internal_map_erase(prev, iter, i);
+              internal_map_erase(prev, iter, i, retire_list);
             } else {
               prev = iter;
               iter = iter->next_;
@@ -429,6 +433,8 @@ int ObKVCacheMap::erase_all(const int64_t cache_id)
       }
     }
   }
+  retire_nodes(retire_list);
+  purge_nodes();
 
   return ret;
 }
@@ -436,6 +442,7 @@ int ObKVCacheMap::erase_all(const int64_t cache_id)
 int ObKVCacheMap::erase_tenant(const uint64_t tenant_id)
 {
   int ret = OB_SUCCESS;
+  HazardList retire_list;
 
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
@@ -451,7 +458,7 @@ int ObKVCacheMap::erase_tenant(const uint64_t tenant_id)
           Node* prev = NULL;
           while (NULL != iter) {
             if (iter->inst_->tenant_id_ == tenant_id) {
-              internal_map_erase(prev, iter, i);
+              internal_map_erase(prev, iter, i, retire_list);
             } else {
               prev = iter;
               iter = iter->next_;
@@ -461,6 +468,8 @@ int ObKVCacheMap::erase_tenant(const uint64_t tenant_id)
       }
     }
   }
+  retire_nodes(retire_list);
+  purge_nodes();
 
   return ret;
 }
@@ -468,6 +477,7 @@ int ObKVCacheMap::erase_tenant(const uint64_t tenant_id)
 int ObKVCacheMap::erase_tenant_cache(const uint64_t tenant_id, const int64_t cache_id)
 {
   int ret = OB_SUCCESS;
+  HazardList retire_list;
 
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
@@ -486,7 +496,7 @@ int ObKVCacheMap::erase_tenant_cache(const uint64_t tenant_id, const int64_t cac
           Node* prev = NULL;
           while (NULL != iter) {
             if (iter->inst_->tenant_id_ == tenant_id && iter->inst_->cache_id_ == cache_id) {
-              internal_map_erase(prev, iter, i);
+              internal_map_erase(prev, iter, i, retire_list);
             } else {
               prev = iter;
               iter = iter->next_;
@@ -496,6 +506,8 @@ int ObKVCacheMap::erase_tenant_cache(const uint64_t tenant_id, const int64_t cac
       }
     }
   }
+  retire_nodes(retire_list);
+  purge_nodes();
 
   return ret;
 }
@@ -503,6 +515,7 @@ int ObKVCacheMap::erase_tenant_cache(const uint64_t tenant_id, const int64_t cac
 int ObKVCacheMap::clean_garbage_node(int64_t& start_pos, const int64_t clean_num)
 {
   int ret = OB_SUCCESS;
+  HazardList retire_list;
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObKVCacheMap has not been inited, ", K(ret));
@@ -522,7 +535,7 @@ int ObKVCacheMap::clean_garbage_node(int64_t& start_pos, const int64_t clean_num
           Node* prev = NULL;
           while (NULL != iter) {
             if (!store_->add_handle_ref(iter->mb_handle_, iter->seq_num_)) {
-              internal_map_erase(prev, iter, i);
+              internal_map_erase(prev, iter, i, retire_list);
             } else {
               store_->de_handle_ref(iter->mb_handle_);
               // don't replace in wash task, put it in single task
@@ -540,12 +553,15 @@ int ObKVCacheMap::clean_garbage_node(int64_t& start_pos, const int64_t clean_num
     start_pos = clean_end_pos >= bucket_num_ ? 0 : clean_end_pos;
   }
 
+  retire_nodes(retire_list);
+
   return ret;
 }
 
 int ObKVCacheMap::replace_fragment_node(int64_t& start_pos, const int64_t replace_num)
 {
   int ret = OB_SUCCESS;
+  HazardList retire_list;
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObKVCacheMap has not been inited, ", K(ret));
@@ -565,7 +581,7 @@ int ObKVCacheMap::replace_fragment_node(int64_t& start_pos, const int64_t replac
           Node* prev = NULL;
           while (NULL != iter) {
             if (iter->inst_->node_allocator_.is_fragment(iter)) {
-              internal_map_replace(prev, iter, i);
+              internal_map_replace(prev, iter, i, retire_list);
             }
             prev = iter;
             iter = iter->next_;
@@ -576,6 +592,7 @@ int ObKVCacheMap::replace_fragment_node(int64_t& start_pos, const int64_t replac
 
     start_pos = replace_end_pos >= bucket_num_ ? 0 : replace_end_pos;
   }
+  retire_nodes(retire_list);
   return ret;
 }
 
@@ -583,6 +600,7 @@ int ObKVCacheMap::multi_get(
     const int64_t cache_id, const int64_t pos, common::ObList<Node, common::ObArenaAllocator>& list)
 {
   int ret = OB_SUCCESS;
+  HazardList retire_list;
 
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
@@ -600,7 +618,7 @@ int ObKVCacheMap::multi_get(
         Node* prev = NULL;
         while (NULL != iter) {
           if (!store_->add_handle_ref(iter->mb_handle_, iter->seq_num_)) {
-            internal_map_erase(prev, iter, pos);
+            internal_map_erase(prev, iter, pos, retire_list);
             if (NULL == iter) {
               break;
             }
@@ -610,7 +628,7 @@ int ObKVCacheMap::multi_get(
             }
             store_->de_handle_ref(iter->mb_handle_);
             if (iter->inst_->node_allocator_.is_fragment(iter)) {
-              internal_map_replace(prev, iter, pos);
+              internal_map_replace(prev, iter, pos, retire_list);
             }
 
             prev = iter;
@@ -621,29 +639,23 @@ int ObKVCacheMap::multi_get(
     }
   }
 
+  retire_nodes(retire_list);
+
   return ret;
 }
 
-void ObKVCacheMap::internal_map_erase(Node*& prev, Node*& iter, const uint64_t bucket_pos)
+void ObKVCacheMap::internal_map_erase(Node*& prev, Node*& iter, const uint64_t bucket_pos, HazardList& retire_list)
 {
   if (NULL != iter) {
     ObKVCacheInst* inst = iter->inst_;
+    Node* next = iter->next_;
     if (NULL == prev) {
-      Node*& bucket_ptr = get_bucket_node(bucket_pos);
-      if (NULL == iter->next_) {
-        bucket_ptr->inst_->node_allocator_.free(bucket_ptr);
-        bucket_ptr = NULL;
-        iter = NULL;
-      } else {
-        bucket_ptr = iter->next_;
-        iter->inst_->node_allocator_.free(iter);
-        iter = bucket_ptr;
-      }
+      ATOMIC_STORE(&get_bucket_node(bucket_pos), next);
     } else {
-      prev->next_ = iter->next_;
-      iter->inst_->node_allocator_.free(iter);
-      iter = prev->next_;
+      ATOMIC_STORE(&prev->next_, next);
     }
+    retire_node(iter, retire_list);
+    iter = next;
 
     if (NULL != inst) {
       (void)ATOMIC_SAF(&inst->status_.kv_cnt_, 1);
@@ -651,7 +663,7 @@ void ObKVCacheMap::internal_map_erase(Node*& prev, Node*& iter, const uint64_t b
   }
 }
 
-void ObKVCacheMap::internal_map_replace(Node*& prev, Node*& iter, const uint64_t bucket_pos)
+void ObKVCacheMap::internal_map_replace(Node*& prev, Node*& iter, const uint64_t bucket_pos, HazardList& retire_list)
 {
   if (NULL != iter) {
     Node* node = NULL;
@@ -659,43 +671,98 @@ void ObKVCacheMap::internal_map_replace(Node*& prev, Node*& iter, const uint64_t
     if (NULL != (buf = iter->inst_->node_allocator_.alloc(sizeof(Node)))) {
       node = new (buf) Node();
       *node = *iter;
-      if (NULL == prev) {
-        get_bucket_node(bucket_pos) = node;
-      } else {
-        prev->next_ = node;
-      }
-      iter->inst_->node_allocator_.free(iter);
+      internal_map_link(prev, node, bucket_pos);
+      retire_node(iter, retire_list);
       iter = node;
     }
   }
 }
 
-void ObKVCacheMap::internal_data_move(Node* iter, const enum ObKVCachePolicy policy)
+void ObKVCacheMap::internal_data_move(
+    Node*& prev, Node*& iter, const uint64_t bucket_pos, const enum ObKVCachePolicy policy, HazardList& retire_list)
 {
   const ObIKVCacheKey* old_key = iter->key_;
   const ObIKVCacheValue* old_value = iter->value_;
   ObKVCachePair* new_kvpair = NULL;
   ObKVMemBlockHandle* mb_handle = iter->mb_handle_;
   ObKVMemBlockHandle* new_mb_handle = NULL;
+  Node* node = NULL;
+  void* buf = NULL;
 
   if (NULL != old_key && NULL != old_value) {
-    if (OB_SUCCESS == store_->store(*iter->inst_, *old_key, *old_value, new_kvpair, new_mb_handle, policy)) {
+    if (NULL == (buf = iter->inst_->node_allocator_.alloc(sizeof(Node)))) {
+      // just keep the node in old memory block
+    } else if (OB_SUCCESS == store_->store(*iter->inst_, *old_key, *old_value, new_kvpair, new_mb_handle, policy)) {
       (void)ATOMIC_SAF(&mb_handle->kv_cnt_, 1);
       (void)ATOMIC_SAF(&mb_handle->get_cnt_, iter->get_cnt_);
 
       (void)ATOMIC_AAF(&new_mb_handle->kv_cnt_, 1);
       (void)ATOMIC_AAF(&new_mb_handle->get_cnt_, iter->get_cnt_);
       (void)ATOMIC_AAF(&new_mb_handle->recent_get_cnt_, 1);
-      iter->mb_handle_ = new_mb_handle;
-      iter->key_ = new_kvpair->key_;
-      iter->value_ = new_kvpair->value_;
-      iter->seq_num_ = new_mb_handle->handle_ref_.get_seq_num();
-      // dec ref of old handle since we already inc ref outside
-      store_->de_handle_ref(iter->mb_handle_);
+      // readers may be visiting the old node, link a moved copy instead of writing in place
+      node = new (buf) Node();
+      *node = *iter;
+      node->mb_handle_ = new_mb_handle;
+      node->key_ = new_kvpair->key_;
+      node->value_ = new_kvpair->value_;
+      node->seq_num_ = new_mb_handle->handle_ref_.get_seq_num();
+      internal_map_link(prev, node, bucket_pos);
+      retire_node(iter, retire_list);
+      iter = node;
+      // dec the ref of new handle got by store, the map does not hold handle ref
+      store_->de_handle_ref(new_mb_handle);
+    } else {
+      iter->inst_->node_allocator_.free(buf);
     }
   }
 }
 
+// link %node into the chain after %prev, %node must be filled before since readers may see it at once
+void ObKVCacheMap::internal_map_link(Node* prev, Node* node, const uint64_t bucket_pos)
+{
+  if (NULL == prev) {
+    ATOMIC_STORE(&get_bucket_node(bucket_pos), node);
+  } else {
+    ATOMIC_STORE(&prev->next_, node);
+  }
+}
+
+void ObKVCacheMap::retire_node(Node* node, HazardList& retire_list)
+{
+  if (NULL != node) {
+    // the node memory comes from its inst, hold the inst until the node is reclaimed
+    (void)ATOMIC_AAF(&node->inst_->ref_cnt_, 1);
+    retire_list.push(&node->retire_link_);
+  }
+}
+
+void ObKVCacheMap::retire_nodes(HazardList& retire_list)
+{
+  if (retire_list.size() > 0) {
+    HazardList reclaim_list;
+    get_retire_station().retire(reclaim_list, retire_list);
+    reclaim_nodes(reclaim_list);
+  }
+}
+
+void ObKVCacheMap::purge_nodes()
+{
+  HazardList reclaim_list;
+  get_retire_station().purge(reclaim_list);
+  reclaim_nodes(reclaim_list);
+}
+
+void ObKVCacheMap::reclaim_nodes(HazardList& reclaim_list)
+{
+  ObLink* p = NULL;
+  while (NULL != (p = reclaim_list.pop())) {
+    Node* node = CONTAINER_OF(p, Node, retire_link_);
+    ObKVCacheInst* inst = node->inst_;
+    inst->node_allocator_.free(node);
+    (void)ATOMIC_SAF(&inst->ref_cnt_, 1);
+  }
+}
+
 ObKVCacheMap::Node*& ObKVCacheMap::get_bucket_node(const int64_t idx)
 {
   const int64_t bucket_idx = idx / Bucket::BUCKET_SIZE;
@@ -15,6 +15,7 @@
 
 #include "lib/allocator/ob_malloc.h"
 #include "lib/lock/ob_bucket_lock.h"
+#include "lib/allocator/ob_retire_station.h"
 #include "share/cache/ob_kvcache_struct.h"
 #include "share/cache/ob_kvcache_store.h"
 
@@ -41,6 +42,9 @@ public:
 
 private:
   friend class ObKVCacheIterator;
+  // Readers walk the bucket chain without bucket lock, so a node linked into the map is never modified
+  // except get_cnt_. Writers hold the bucket write lock, link a new node after it is filled, and retire
+  // the unlinked node which is freed after all readers in QClock critical section leave.
   struct Node {
     ObKVCacheInst* inst_;
     uint64_t hash_code_;
@@ -50,8 +54,17 @@ private:
     const ObIKVCacheValue* value_;
     Node* next_;
     int64_t get_cnt_;
+    ObLink retire_link_;
     Node()
-        : inst_(NULL), hash_code_(0), seq_num_(0), mb_handle_(NULL), key_(NULL), value_(NULL), next_(NULL), get_cnt_(0)
+        : inst_(NULL),
+          hash_code_(0),
+          seq_num_(0),
+          mb_handle_(NULL),
+          key_(NULL),
+          value_(NULL),
+          next_(NULL),
+          get_cnt_(0),
+          retire_link_()
     {}
   };
   struct Bucket {
@@ -59,11 +72,28 @@ private:
     Node* nodes_[BUCKET_SIZE];
   };
 
+  static const int64_t RETIRE_LIMIT = 64;
+
 private:
   int multi_get(const int64_t cache_id, const int64_t pos, common::ObList<Node, common::ObArenaAllocator>& list);
-  void internal_map_erase(Node*& prev, Node*& iter, const uint64_t bucket_pos);
-  void internal_map_replace(Node*& prev, Node*& iter, const uint64_t bucket_pos);
-  void internal_data_move(Node* iter, const enum ObKVCachePolicy policy);
+  void internal_map_erase(Node*& prev, Node*& iter, const uint64_t bucket_pos, HazardList& retire_list);
+  void internal_map_replace(Node*& prev, Node*& iter, const uint64_t bucket_pos, HazardList& retire_list);
+  void internal_data_move(
+      Node*& prev, Node*& iter, const uint64_t bucket_pos, const enum ObKVCachePolicy policy, HazardList& retire_list);
+  void internal_map_link(Node* prev, Node* node, const uint64_t bucket_pos);
+  void retire_node(Node* node, HazardList& retire_list);
+  void retire_nodes(HazardList& retire_list);
+  void purge_nodes();
+  void reclaim_nodes(HazardList& reclaim_list);
+  static QClock& get_qclock()
+  {
+    return get_kvcache_qclock();
+  }
+  static RetireStation& get_retire_station()
+  {
+    static RetireStation retire_station(get_qclock(), RETIRE_LIMIT);
+    return retire_station;
+  }
   OB_INLINE bool need_modify_cache(const int64_t iter_get_cnt, const int64_t total_get_cnt, const int64_t kv_cnt) const
   {
     float avg_get_cnt = (float)(total_get_cnt) / (float)(kv_cnt);
@@ -642,6 +642,7 @@ void ObKVCacheStore::de_handle_ref(ObKVMemBlockHandle* mb_handle)
 void ObKVCacheStore::compute_tenant_wash_size()
 {
   int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
   int64_t tenant_min_wash_size = 0;
   int64_t tenant_max_wash_size = 0;
   uint64_t tenant_id = 0;
@@ -693,7 +694,8 @@ void ObKVCacheStore::compute_tenant_wash_size()
     } else if (OB_SUCC(tenant_wash_map_.get(inst->tenant_id_, tenant_wash_info))) {
       tenant_wash_info->cache_size_ += (inst->status_.store_size_ + inst->status_.map_size_);
       global_cache_size += (inst->status_.store_size_ + inst->status_.map_size_);
-    } else if (OB_HASH_NOT_EXIST == ret) {
+    } else if (OB_ENTRY_NOT_EXIST == ret) {
+      // ObFixedHashMap returns OB_ENTRY_NOT_EXIST for the cache of a tenant which is already removed
       ret = OB_SUCCESS;
     }
   }
@@ -772,13 +774,24 @@ void ObKVCacheStore::compute_tenant_wash_size()
     }
   }
 
-  // allocate memory for cache wash heaps whose hold size is set
+  // allocate memory for cache wash heaps whose hold size is set,
+  // and turn on frequency admission of caches whose tenant has to be washed
   for (int64_t i = 0; OB_SUCC(ret) && i < inst_handles_.count(); ++i) {
     inst = inst_handles_.at(i).get_inst();
     if (OB_ISNULL(inst)) {
       ret = OB_ERR_UNEXPECTED;
       COMMON_LOG(WARN, "ObKVCacheInst is NULL", K(ret));
+    } else if (OB_SUCCESS != (tmp_ret = inst->freq_sketch_.try_expand(ATOMIC_LOAD(&inst->status_.kv_cnt_)))) {
+      COMMON_LOG(WARN, "Fail to expand freq sketch", K(tmp_ret), K(inst->status_));
+    }
+    if (OB_FAIL(ret)) {
     } else if (OB_SUCC(tenant_wash_map_.get(inst->tenant_id_, tenant_wash_info))) {
+      int64_t reject_permille = 0;
+      if (tenant_wash_info->wash_size_ > 0 && tenant_wash_info->cache_size_ > 0) {
+        reject_permille = std::min(ObKVCacheInst::PERMILLE,
+            tenant_wash_info->wash_size_ * ObKVCacheInst::PERMILLE / tenant_wash_info->cache_size_);
+      }
+      ATOMIC_STORE(&inst->reject_permille_, reject_permille);
       if (inst->status_.hold_size_ > 0) {
         const int64_t heap_size =
             std::min(tenant_wash_info->wash_size_, inst->status_.store_size_ - inst->status_.hold_size_) / block_size_;
@@ -786,7 +799,9 @@ void ObKVCacheStore::compute_tenant_wash_size()
           COMMON_LOG(WARN, "init_wash_heap failed", K(ret), K(heap_size));
         }
       }
-    } else if (OB_HASH_NOT_EXIST == ret) {
+    } else if (OB_ENTRY_NOT_EXIST == ret) {
+      // the tenant is already removed, same as above
+      ATOMIC_STORE(&inst->reject_permille_, 0L);
       ret = OB_SUCCESS;
     }
   }
@@ -11,6 +11,7 @@
  */
 
 #include "ob_kvcache_struct.h"
+#include "lib/allocator/ob_malloc.h"
 
 namespace oceanbase {
 namespace common {
@@ -63,6 +64,185 @@ void ObKVCacheStatus::reset()
   base_mb_score_ = 0;
   hold_size_ = 0;
   total_miss_cnt_ = 0;
+  total_admit_cnt_.reset();
+  total_reject_cnt_.reset();
+}
+
+/**
+ * ------------------------------------------------------------ObKVCacheFreqSketch------------------------------------------------------
+ */
+ObKVCacheFreqSketch::ObKVCacheFreqSketch()
+    : tenant_id_(OB_INVALID_ID), table_(NULL), counter_cnt_(0), sample_cnt_(0), age_cnt_(0)
+{}
+
+ObKVCacheFreqSketch::~ObKVCacheFreqSketch()
+{
+  destroy();
+}
+
+int ObKVCacheFreqSketch::init(const uint64_t tenant_id)
+{
+  int ret = OB_SUCCESS;
+  Table* table = NULL;
+  if (OB_UNLIKELY(NULL != table_)) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "The ObKVCacheFreqSketch has been inited, ", K(ret));
+  } else {
+    tenant_id_ = tenant_id;
+    if (OB_FAIL(alloc_table(MIN_COUNTER_CNT, table))) {
+      COMMON_LOG(WARN, "Fail to alloc sketch table, ", K(ret), K(tenant_id));
+    } else {
+      sample_cnt_ = 0;
+      age_cnt_ = 0;
+      counter_cnt_ = table->counter_cnt_;
+      ATOMIC_STORE(&table_, table);
+    }
+  }
+  return ret;
+}
+
+void ObKVCacheFreqSketch::destroy()
+{
+  // the cache instance is destroyed after all map nodes referring to it are reclaimed,
+  // no reader can see the current table any more
+  if (NULL != table_) {
+    ob_free(table_);
+    table_ = NULL;
+  }
+  tenant_id_ = OB_INVALID_ID;
+  counter_cnt_ = 0;
+  sample_cnt_ = 0;
+  age_cnt_ = 0;
+}
+
+void ObKVCacheFreqSketch::purge_tables()
+{
+  HazardList reclaim_list;
+  get_retire_station().purge(reclaim_list);
+  reclaim_tables(reclaim_list);
+}
+
+void ObKVCacheFreqSketch::retire_table(Table* table)
+{
+  if (NULL != table) {
+    HazardList retire_list;
+    HazardList reclaim_list;
+    retire_list.push(&table->retire_link_);
+    get_retire_station().retire(reclaim_list, retire_list);
+    reclaim_tables(reclaim_list);
+  }
+}
+
+void ObKVCacheFreqSketch::reclaim_tables(HazardList& reclaim_list)
+{
+  ObLink* p = NULL;
+  while (NULL != (p = reclaim_list.pop())) {
+    ob_free(CONTAINER_OF(p, Table, retire_link_));
+  }
+}
+
+int ObKVCacheFreqSketch::alloc_table(const int64_t counter_cnt, Table*& table)
+{
+  int ret = OB_SUCCESS;
+  const int64_t word_cnt = counter_cnt / COUNTER_PER_WORD;
+  ObMemAttr attr(tenant_id_, ObNewModIds::OB_KVSTORE_CACHE);
+  if (OB_ISNULL(table = static_cast<Table*>(ob_malloc(sizeof(Table) + sizeof(uint64_t) * word_cnt, attr)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    COMMON_LOG(WARN, "Fail to allocate sketch table, ", K(ret), K(counter_cnt));
+  } else {
+    table->counter_cnt_ = counter_cnt;
+    table->sample_size_ = counter_cnt / COUNTER_PER_KV * SAMPLE_PER_KV;
+    table->retire_link_.reset();
+    MEMSET(table->words_, 0, sizeof(uint64_t) * word_cnt);
+  }
+  return ret;
+}
+
+int ObKVCacheFreqSketch::try_expand(const int64_t kv_cnt)
+{
+  int ret = OB_SUCCESS;
+  Table* old_table = ATOMIC_LOAD(&table_);
+  if (OB_UNLIKELY(NULL == old_table)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVCacheFreqSketch has not been inited, ", K(ret));
+  } else if (kv_cnt * COUNTER_PER_KV > old_table->counter_cnt_ && old_table->counter_cnt_ < MAX_COUNTER_CNT) {
+    const int64_t counter_cnt = std::min(MAX_COUNTER_CNT, static_cast<int64_t>(next_pow2(kv_cnt * COUNTER_PER_KV)));
+    Table* table = NULL;
+    if (OB_FAIL(alloc_table(counter_cnt, table))) {
+      COMMON_LOG(WARN, "Fail to alloc sketch table, ", K(ret), K(counter_cnt));
+    } else {
+      // counter i of new table covers the keys of counter (i % old counter count) in old table,
+      // so copy the old counters to keep the estimation
+      const int64_t old_word_cnt = old_table->counter_cnt_ / COUNTER_PER_WORD;
+      const int64_t word_cnt = counter_cnt / COUNTER_PER_WORD;
+      for (int64_t i = 0; i < word_cnt; ++i) {
+        table->words_[i] = ATOMIC_LOAD(&old_table->words_[i & (old_word_cnt - 1)]);
+      }
+      ATOMIC_STORE(&table_, table);
+      ATOMIC_STORE(&counter_cnt_, counter_cnt);
+      retire_table(old_table);
+      COMMON_LOG(INFO, "expand kvcache freq sketch", K(kv_cnt), K(counter_cnt), K_(tenant_id));
+    }
+  }
+  return ret;
+}
+
+void ObKVCacheFreqSketch::record(const uint64_t hash)
+{
+  static __thread uint64_t record_seq = 0;
+  Table* table = ATOMIC_LOAD(&table_);
+  if (OB_LIKELY(NULL != table)) {
+    // conservative update, only the smallest counters are increased
+    const uint64_t freq = estimate(*table, hash);
+    if (freq < MAX_FREQ) {
+      for (int64_t i = 0; i < HASH_CNT; ++i) {
+        const uint64_t idx = counter_idx(*table, hash, i);
+        const uint64_t shift = (idx % COUNTER_PER_WORD) * 4;
+        uint64_t* word = table->words_ + idx / COUNTER_PER_WORD;
+        const uint64_t old_val = ATOMIC_LOAD(word);
+        if (((old_val >> shift) & MAX_FREQ) == freq) {
+          (void)ATOMIC_BCAS(word, old_val, old_val + (1UL << shift));
+        }
+      }
+    }
+    if (0 == (++record_seq % SAMPLE_STEP)) {
+      if (ATOMIC_AAF(&sample_cnt_, SAMPLE_STEP) >= table->sample_size_) {
+        age(*table);
+      }
+    }
+  }
+}
+
+uint64_t ObKVCacheFreqSketch::estimate(const uint64_t hash) const
+{
+  const Table* table = ATOMIC_LOAD(&table_);
+  return NULL == table ? 0 : estimate(*table, hash);
+}
+
+uint64_t ObKVCacheFreqSketch::estimate(const Table& table, const uint64_t hash) const
+{
+  uint64_t freq = MAX_FREQ;
+  for (int64_t i = 0; i < HASH_CNT; ++i) {
+    const uint64_t idx = counter_idx(table, hash, i);
+    const uint64_t shift = (idx % COUNTER_PER_WORD) * 4;
+    freq = std::min(freq, (ATOMIC_LOAD(&table.words_[idx / COUNTER_PER_WORD]) >> shift) & MAX_FREQ);
+  }
+  return freq;
+}
+
+void ObKVCacheFreqSketch::age(Table& table)
+{
+  const int64_t sample_cnt = ATOMIC_LOAD(&sample_cnt_);
+  // only the thread resetting the sample count halves the counters
+  if (sample_cnt >= table.sample_size_ && ATOMIC_BCAS(&sample_cnt_, sample_cnt, sample_cnt / 2)) {
+    // mask out the bit shifted in from the next counter
+    static const uint64_t HALVE_MASK = 0x7777777777777777UL;
+    const int64_t word_cnt = table.counter_cnt_ / COUNTER_PER_WORD;
+    for (int64_t i = 0; i < word_cnt; ++i) {
+      ATOMIC_STORE(&table.words_[i], (ATOMIC_LOAD(&table.words_[i]) >> 1) & HALVE_MASK);
+    }
+    (void)ATOMIC_AAF(&age_cnt_, 1);
+  }
 }
 
 /*
@@ -21,6 +21,7 @@
 #include "lib/queue/ob_link.h"  // lock free double linked list
 #include "lib/resource/ob_resource_mgr.h"
 #include "lib/allocator/ob_lf_fifo_allocator.h"
+#include "lib/allocator/ob_retire_station.h"
 #include "lib/metrics/ob_counter.h"
 
 namespace oceanbase {
@@ -217,6 +218,101 @@ public:
   double base_mb_score_;
   // guarantee at least hold_size_ memory left in cache after wash
   int64_t hold_size_;
+  // new keys admitted into and rejected from the map by the frequency sketch
+  ObPCNonAtomicCounter total_admit_cnt_;
+  ObPCNonAtomicCounter total_reject_cnt_;
+};
+
+// The kvcache map reads its nodes and the freq sketch tables of cache instances without lock in the
+// critical section of this clock.
+inline QClock& get_kvcache_qclock()
+{
+  static QClock qclock;
+  return qclock;
+}
+
+// Count-min sketch of 4-bit counters, estimates how many times a key is accessed recently.
+// It is used as the TinyLFU admission filter of a cache instance, so that keys touched only once
+// (e.g. by a large range scan) can not flood the cache and evict the working set.
+// Like TinyLFU, the table keeps COUNTER_PER_KV counters for each kv in cache and all counters are
+// halved once SAMPLE_PER_KV times of kv count accesses are recorded. The table grows with the kv count
+// of the cache by the wash thread, counters are copied into the new table and the old one is retired.
+// Tables are read in the critical section of the kvcache QClock, so a retired table is freed after
+// all readers leave, the same way as the map nodes.
+// Counters are updated with a single CAS try, a lost update only makes the estimation a bit lower.
+class ObKVCacheFreqSketch {
+public:
+  static const int64_t MIN_COUNTER_CNT = 1L << 14;
+  static const int64_t MAX_COUNTER_CNT = 1L << 24;
+  static const int64_t COUNTER_PER_WORD = 16;
+  static const int64_t COUNTER_PER_KV = 16;
+  static const int64_t SAMPLE_PER_KV = 10;
+  static const int64_t HASH_CNT = 4;
+  static const uint64_t MAX_FREQ = 15;
+  // the sample count is shared by all threads, only one of SAMPLE_STEP records touches it
+  static const int64_t SAMPLE_STEP = 16;
+
+public:
+  ObKVCacheFreqSketch();
+  ~ObKVCacheFreqSketch();
+  int init(const uint64_t tenant_id);
+  void destroy();
+  inline bool is_inited() const
+  {
+    return NULL != table_;
+  }
+  // called by wash thread only
+  int try_expand(const int64_t kv_cnt);
+  // record and estimate must be called in the critical section of get_kvcache_qclock()
+  void record(const uint64_t hash);
+  uint64_t estimate(const uint64_t hash) const;
+  int64_t get_counter_cnt() const
+  {
+    return ATOMIC_LOAD(&counter_cnt_);
+  }
+  int64_t get_age_cnt() const
+  {
+    return ATOMIC_LOAD(&age_cnt_);
+  }
+  TO_STRING_KV(K_(tenant_id), K_(counter_cnt), K_(sample_cnt), K_(age_cnt));
+  // free all retired tables, called when the kvcache map is destroyed
+  static void purge_tables();
+
+private:
+  struct Table {
+    int64_t counter_cnt_;
+    int64_t sample_size_;
+    ObLink retire_link_;
+    uint64_t words_[0];
+  };
+  // tables are retired by the wash thread only, free the previous one once a new one is retired
+  static const int64_t RETIRE_LIMIT = 0;
+  static RetireStation& get_retire_station()
+  {
+    static RetireStation retire_station(get_kvcache_qclock(), RETIRE_LIMIT);
+    return retire_station;
+  }
+  static void retire_table(Table* table);
+  static void reclaim_tables(HazardList& reclaim_list);
+  int alloc_table(const int64_t counter_cnt, Table*& table);
+  uint64_t estimate(const Table& table, const uint64_t hash) const;
+  void age(Table& table);
+  OB_INLINE static uint64_t counter_idx(const Table& table, const uint64_t hash, const int64_t i)
+  {
+    static const uint64_t SEEDS[HASH_CNT] = {
+        0xc3a5c85c97cb3127UL, 0xb492b66fbe98f273UL, 0x9ae16a3b2f90404fUL, 0xcbf29ce484222325UL};
+    uint64_t h = (hash + SEEDS[i]) * SEEDS[i];
+    h += h >> 32;
+    return h & (table.counter_cnt_ - 1);
+  }
+
+private:
+  uint64_t tenant_id_;
+  Table* table_;
+  int64_t counter_cnt_;
+  int64_t sample_cnt_;
+  int64_t age_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObKVCacheFreqSketch);
 };
 
 struct ObKVCacheInfo {
@@ -41,6 +41,7 @@ int ObReloadConfig::reload_ob_logger_set()
     } else {
       OB_LOGGER.set_log_warn(conf_->enable_syslog_wf);
       OB_LOGGER.set_enable_async_log(conf_->enable_async_syslog);
+      OB_LOGGER.set_enable_deferred_header(conf_->_enable_deferred_log_header);
       ASYNC_LOG_LOGGER.set_log_warn(conf_->enable_syslog_wf);
       ObKVGlobalCache::get_instance().reload_priority();
     }
@@ -5559,6 +5559,8 @@ def_table_schema(
   ('total_hit_cnt', 'int', 'false'),
   ('total_miss_cnt', 'int', 'false'),
   ('hold_size', 'int', 'false'),
+  ('total_admit_cnt', 'int', 'false'),
+  ('total_reject_cnt', 'int', 'false'),
   ],
   partition_columns = ['svr_ip', 'svr_port'],
 )
@@ -34,7 +34,8 @@ const uint64_t ObUpgradeChecker::UPGRADE_PATH[CLUTER_VERSION_NUM] = {
     CALC_CLUSTER_VERSION(3UL, 1UL, 2UL),   //3.1.2
     CALC_CLUSTER_VERSION(3UL, 1UL, 3UL),   //3.1.3
     CALC_CLUSTER_VERSION(3UL, 1UL, 4UL),   //3.1.4
-  CALC_CLUSTER_VERSION(3UL, 1UL, 5UL)   //3.1.5
+    CALC_CLUSTER_VERSION(3UL, 1UL, 5UL),   //3.1.5
+    CALC_CLUSTER_VERSION(3UL, 1UL, 6UL)    //3.1.6
 };
 
 bool ObUpgradeChecker::check_cluster_version_exist(const uint64_t version)
@@ -1094,6 +1095,7 @@ int ObUpgradeProcesserSet::init(ObBaseUpgradeProcessor::UpgradeMode mode, common
     INIT_PROCESSOR_BY_VERSION(3, 1, 3);
     INIT_PROCESSOR_BY_VERSION(3, 1, 4);
     INIT_PROCESSOR_BY_VERSION(3, 1, 5);
+    INIT_PROCESSOR_BY_VERSION(3, 1, 6);
 #undef INIT_PROCESSOR_BY_VERSION
     inited_ = true;
   }
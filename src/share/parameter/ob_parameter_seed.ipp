@@ -238,6 +238,10 @@ DEF_INT(max_syslog_file_count, OB_CLUSTER_PARAMETER, "0", "[0,]",
 DEF_BOOL(enable_async_syslog, OB_CLUSTER_PARAMETER, "True",
     "specifies whether use async log for observer.log, elec.log and rs.log",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_deferred_log_header, OB_CLUSTER_PARAMETER, "False",
+    "specifies whether the header of async syslog is rendered by the log flush thread "
+    "instead of the logging thread. Value: True:turned on; False: turned off",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(enable_syslog_wf, OB_CLUSTER_PARAMETER, "True",
     "specifies whether any log message with a log level higher than \\'WARN\\' "
     "would be printed into a separate file with a suffix of \\'wf\\'",
@@ -270,6 +274,10 @@ DEF_STR_WITH_CHECKER(tableapi_transport_compress_func, OB_CLUSTER_PARAMETER, "no
     common::ObConfigCompressFuncChecker,
     "compressor used for tableAPI query result. Values: none, lz4_1.0, snappy_1.0, zlib_1.0, zstd_1.0 zstd 1.3.8",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_tableapi_write_coalesce_window, OB_CLUSTER_PARAMETER, "0us", "[0us, 10ms]",
+    "the time a single-row tableAPI mutation waits for concurrent mutations of the same partition "
+    "to commit them in one transaction, 0 means disabled. Range: [0us, 10ms]",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_CAP(_sort_area_size, OB_TENANT_PARAMETER, "128M", "[2M,]",
     "size of maximum memory that could be used by SORT. Range: [2M,+∞)",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -405,6 +413,10 @@ DEF_BOOL(_px_message_compression, OB_TENANT_PARAMETER, "False",
     "Enable DTL send message with compression"
     "Value: True: enable compression False: disable compression",
     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_columnar_message, OB_TENANT_PARAMETER, "False",
+    "Enable DTL send data message in columnar format, takes effect after all servers are upgraded to 3.1.6"
+    "Value: True: columnar format False: row format",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_px_chunklist_count_ratio, OB_CLUSTER_PARAMETER, "1", "[1, 128]",
     "the ratio of the dtl buffer manager list. Range: [1, 128]",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -424,6 +436,13 @@ DEF_BOOL(_enable_filter_push_down_storage, OB_TENANT_PARAMETER, "False",
     "Enable filter push down to storage"
     "Value:  True:turned on  False: turned off",
     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_rowsets_enabled, OB_TENANT_PARAMETER, "False",
+    "Enable vectorized (batch) execution of static typing engine"
+    "Value:  True:turned on  False: turned off",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_rowsets_max_rows, OB_TENANT_PARAMETER, "256", "[1, 65535]",
+    "max row count of one batch in vectorized execution. Range: [1, 65535]",
+    ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_WORK_AREA_POLICY(workarea_size_policy, OB_TENANT_PARAMETER, "AUTO",
     "policy used to size SQL working areas (MANUAL/AUTO)",
     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -528,7 +547,7 @@ DEF_TIME(get_leader_candidate_rpc_timeout, OB_CLUSTER_PARAMETER, "9s", "[2s, 180
     "the time during a get leader candidate rpc request "
     "is permitted to execute before it is terminated. Range: [2s, 180s]",
     ObParameterAttr(Section::ROOT_SERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
-DEF_STR(min_observer_version, OB_CLUSTER_PARAMETER, "3.1.5", "the min observer version",
+DEF_STR(min_observer_version, OB_CLUSTER_PARAMETER, "3.1.6", "the min observer version",
     ObParameterAttr(Section::ROOT_SERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(enable_ddl, OB_CLUSTER_PARAMETER, "True",
     "specifies whether DDL operation is turned on. "
@@ -782,6 +801,9 @@ DEF_TIME(_ob_clog_timeout_to_force_switch_leader, OB_CLUSTER_PARAMETER, "10s", "
     ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_ob_clog_disk_buffer_cnt, OB_CLUSTER_PARAMETER, "64", "[1, 2000]", "clog disk buffer cnt. Range: [1, 2000]",
     ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_ob_clog_group_commit_max_item_cnt, OB_CLUSTER_PARAMETER, "16", "[1, 64]",
+    "maximum count of clog disk buffers flushed together by one IO, 1 means flush one by one. Range: [1, 64]",
+    ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 DEF_TIME(_ob_trans_rpc_timeout, OB_CLUSTER_PARAMETER, "3s", "[0s, 3600s]",
     "transaction rpc timeout(s). Range: [0s, 3600s]",
     ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -879,6 +901,10 @@ DEF_INT(bf_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "bf cache priority
 DEF_INT(bf_cache_miss_count_threshold, OB_CLUSTER_PARAMETER, "100", "[0,)",
     "bf cache miss count threshold, 0 means disable bf cache. Range: [0, )",
     ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_minor_sstable_bloom_filter, OB_CLUSTER_PARAMETER, "True",
+    "build the rowkey bloom filter of minor sstable for all user tables during minor merge, "
+    "otherwise only for tables with USE_BLOOM_FILTER",
+    ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(fuse_row_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "fuse row cache priority. Range: [1, )",
     ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
@@ -931,6 +957,10 @@ DEF_INT_WITH_CHECKER(disk_io_thread_count, OB_CLUSTER_PARAMETER, "8", common::Ob
 DEF_INT(_io_callback_thread_count, OB_CLUSTER_PARAMETER, "8", "[1,64]",
     "The number of io callback threads. The default value is 8. Range: [1,64] in integer",
     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_io_uring, OB_CLUSTER_PARAMETER, "False",
+    "specifies whether data disks submit io requests through io_uring instead of libaio, "
+    "it falls back to libaio on kernels earlier than 5.11. Value: True:turned on; False: turned off",
+    ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 DEF_INT(_large_query_io_percentage, OB_CLUSTER_PARAMETER, "0", "[0,100]",
     "the max percentage of io resource for big queries. Range: [0,100] in integer. Especially, 0 means unlimited. The "
     "default value is 0.",
@@ -1098,6 +1128,10 @@ DEF_CAP(multiblock_read_size, OB_CLUSTER_PARAMETER, "128K", "[0K,2M]",
 DEF_CAP(multiblock_read_gap_size, OB_CLUSTER_PARAMETER, "0K", "[0K,2M]",
     "max gap size in one read io request, gap means blocks that hit in block cache. Range: [0K,2M]",
     ObParameterAttr(Section::SSTABLE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_sstable_scan_max_prefetch_micro_cnt, OB_CLUSTER_PARAMETER, "128", "[32, 1024]",
+    "max count of micro blocks prefetched by one sstable range scan when it waits for io, "
+    "each of them costs about 370 bytes of memory for every scan. Range: [32, 1024]",
+    ObParameterAttr(Section::SSTABLE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 // TODO : to be remove
 DEF_CAP(dtl_buffer_size, OB_CLUSTER_PARAMETER, "64K", "[4K,2M]", "to be removed",
@@ -1380,6 +1380,11 @@ int ObSchemaPrinter::print_table_definition_table_options(const ObTableSchema &t
       SHARE_SCHEMA_LOG(WARN, "fail to print table read only", K(ret));
     }
   }
+  if (OB_SUCC(ret) && !is_index_tbl && table_schema.is_zone_map_enabled() && !is_no_table_options(sql_mode)) {
+    if (OB_FAIL(databuff_printf(buf, buf_len, pos, "ZONE_MAP = TRUE "))) {
+      SHARE_SCHEMA_LOG(WARN, "fail to print zone map", K(ret));
+    }
+  }
   ObString table_mode_str = "";
   if (OB_SUCC(ret) && !is_index_tbl && !is_no_table_options(sql_mode)) {
     if (!agent_mode) {
@@ -1795,6 +1800,11 @@ int ObSchemaPrinter::print_table_definition_table_options(const ObTableSchema& t
       SHARE_SCHEMA_LOG(WARN, "fail to print table read only", K(ret));
     }
   }
+  if (OB_SUCC(ret) && !is_index_tbl && table_schema.is_zone_map_enabled()) {
+    if (OB_FAIL(databuff_printf(buf, buf_len, pos, "ZONE_MAP = TRUE "))) {
+      SHARE_SCHEMA_LOG(WARN, "fail to print zone map", K(ret));
+    }
+  }
   // backup table mode
   ObString table_mode_str = "";
   if (OB_SUCC(ret) && !is_index_tbl) {
@@ -116,7 +116,8 @@ private:
   static const int32_t TM_MODE_FLAG_BITS = 8;
   static const int32_t TM_PK_MODE_OFFSET = 8;
   static const int32_t TM_PK_MODE_BITS = 4;
-  static const int32_t TM_RESERVED = 20;
+  static const int32_t TM_ZONE_MAP_BITS = 1;
+  static const int32_t TM_RESERVED = 19;
 
   static const uint32_t MODE_FLAG_MASK = (1U << TM_MODE_FLAG_BITS) - 1;
   static const uint32_t PK_MODE_MASK = (1U << TM_PK_MODE_BITS) - 1;
@@ -151,12 +152,13 @@ public:
     return (ObTablePKMode)((table_mode >> TM_PK_MODE_OFFSET) & PK_MODE_MASK);
   }
 
-  TO_STRING_KV("table_mode_flag", mode_flag_, "pk_mode", pk_mode_);
+  TO_STRING_KV("table_mode_flag", mode_flag_, "pk_mode", pk_mode_, "zone_map", zone_map_);
   union {
     int32_t mode_;
     struct {
       uint32_t mode_flag_ : TM_MODE_FLAG_BITS;
       uint32_t pk_mode_ : TM_PK_MODE_BITS;
+      uint32_t zone_map_ : TM_ZONE_MAP_BITS;  // major sstable records micro block zone maps, set by ZONE_MAP option
       uint32_t reserved_ : TM_RESERVED;
     };
   };
@@ -364,6 +366,10 @@ public:
   {
     return TPKM_NEW_NO_PK == (enum ObTablePKMode)table_mode_.pk_mode_;
   }
+  inline bool is_zone_map_enabled() const
+  {
+    return 0 != table_mode_.zone_map_;
+  }
   inline int set_primary_zone(const common::ObString& primary_zone)
   {
     return deep_copy_str(primary_zone, primary_zone_);
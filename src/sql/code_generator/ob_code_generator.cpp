@@ -16,6 +16,12 @@
 #include "sql/code_generator/ob_code_generator_impl.h"
 #include "sql/code_generator/ob_static_engine_expr_cg.h"
 #include "sql/code_generator/ob_static_engine_cg.h"
+#include "sql/optimizer/ob_log_plan.h"
+#include "sql/optimizer/ob_log_table_scan.h"
+#include "sql/optimizer/ob_log_group_by.h"
+#include "sql/optimizer/ob_log_exchange.h"
+#include "sql/optimizer/ob_log_join.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase {
 namespace sql {
@@ -28,7 +34,9 @@ int ObCodeGenerator::generate(const ObLogPlan& log_plan, ObPhysicalPlan& phy_pla
       LOG_WARN("fail to generate old plan", K(ret));
     }
   } else {
-    if (OB_FAIL(generate_exprs(log_plan, phy_plan))) {
+    if (OB_FAIL(detect_batch_size(log_plan, batch_size_))) {
+      LOG_WARN("detect batch size failed", K(ret));
+    } else if (OB_FAIL(generate_exprs(log_plan, phy_plan))) {
       LOG_WARN("fail to get all raw exprs", K(ret));
     } else if (OB_FAIL(generate_operators(log_plan, phy_plan))) {
       LOG_WARN("fail to generate plan", K(ret));
@@ -52,7 +60,7 @@ int ObCodeGenerator::generate_old_plan(const ObLogPlan& log_plan, ObPhysicalPlan
 int ObCodeGenerator::generate_exprs(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan)
 {
   int ret = OB_SUCCESS;
-  ObStaticEngineExprCG expr_cg(phy_plan.get_allocator(), param_store_);
+  ObStaticEngineExprCG expr_cg(phy_plan.get_allocator(), param_store_, batch_size_);
   // init ctx for operator cg
   expr_cg.init_operator_cg_ctx(log_plan.get_optimizer_context().get_exec_ctx());
   ObRawExprUniqueSet all_raw_exprs(phy_plan.get_allocator());
@@ -73,6 +81,7 @@ int ObCodeGenerator::generate_operators(const ObLogPlan& log_plan, ObPhysicalPla
 {
   int ret = OB_SUCCESS;
   ObStaticEngineCG static_engin_cg(min_cluster_version_);
+  static_engin_cg.set_batch_size(batch_size_);
   if (OB_FAIL(static_engin_cg.generate(log_plan, phy_plan))) {
     LOG_WARN("fail to code generate", K(ret));
   }
@@ -80,6 +89,99 @@ int ObCodeGenerator::generate_operators(const ObLogPlan& log_plan, ObPhysicalPla
   return ret;
 }
 
+int ObCodeGenerator::detect_batch_size(const ObLogPlan& log_plan, int64_t& batch_size)
+{
+  int ret = OB_SUCCESS;
+  batch_size = 0;
+  bool enabled = false;
+  int64_t max_rows = 0;
+  const ObSQLSessionInfo* session = log_plan.get_optimizer_context().get_session_info();
+  if (OB_ISNULL(session) || OB_ISNULL(log_plan.get_stmt())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session or stmt is NULL", K(ret), KP(session));
+  } else {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(session->get_effective_tenant_id()));
+    if (tenant_config.is_valid()) {
+      enabled = tenant_config->_rowsets_enabled;
+      max_rows = tenant_config->_rowsets_max_rows;
+    }
+  }
+  // old servers can not execute vectorized plan, operator and expression layout of batch is
+  // only serialized to servers of the same version in PX.
+  if (min_cluster_version_ < CLUSTER_VERSION_316) {
+    enabled = false;
+  }
+  if (OB_SUCC(ret) && enabled && max_rows > 0 && log_plan.get_stmt()->is_select_stmt()) {
+    ObSEArray<const ObLogPlan*, 4> plans;
+    bool supported = false;
+    if (OB_FAIL(get_all_log_plan(&log_plan, plans))) {
+      LOG_WARN("get all log plan failed", K(ret));
+    } else if (plans.count() > 1) {
+      // subquery not supported
+    } else if (OB_FAIL(check_vectorize_supported(log_plan.get_plan_root(), supported))) {
+      LOG_WARN("check vectorize supported failed", K(ret));
+    } else if (supported) {
+      batch_size = max_rows;
+    }
+    LOG_DEBUG("detect batch size", K(enabled), K(max_rows), K(supported), K(batch_size));
+  }
+  return ret;
+}
+
+int ObCodeGenerator::check_vectorize_supported(const ObLogicalOperator* op, bool& supported)
+{
+  int ret = OB_SUCCESS;
+  supported = false;
+  if (OB_ISNULL(op)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("operator is NULL", K(ret));
+  } else if (OB_FAIL(check_stack_overflow())) {
+    LOG_WARN("check stack overflow failed", K(ret));
+  } else {
+    switch (op->get_type()) {
+      case log_op_def::LOG_TABLE_SCAN: {
+        ObLogTableScan* scan = static_cast<ObLogTableScan*>(const_cast<ObLogicalOperator*>(op));
+        supported = !scan->get_is_fake_cte_table() && !scan->is_sample_scan() &&
+                    !scan->get_is_multi_part_table_scan() && !scan->is_for_update() &&
+                    !is_virtual_table(scan->get_ref_table_id());
+        break;
+      }
+      case log_op_def::LOG_GROUP_BY: {
+        const ObLogGroupBy* group_by = static_cast<const ObLogGroupBy*>(op);
+        supported = HASH_AGGREGATE == group_by->get_algo() || SCALAR_AGGREGATE == group_by->get_algo();
+        break;
+      }
+      case log_op_def::LOG_EXCHANGE: {
+        // PX exchange in fifo order, transmit fetches batches from child but sends rows one by one.
+        const ObLogExchange* exchange = static_cast<const ObLogExchange*>(op);
+        supported = (exchange->is_px_producer() || exchange->is_px_consumer()) && !exchange->get_is_remote() &&
+                    !exchange->is_merge_sort() && !exchange->is_task_order() && !exchange->is_local_order() &&
+                    !exchange->is_rescanable();
+        break;
+      }
+      case log_op_def::LOG_GRANULE_ITERATOR: {
+        supported = true;
+        break;
+      }
+      case log_op_def::LOG_JOIN: {
+        // children of hash join are executed row by row in the batch rows of hash join.
+        supported = HASH_JOIN == static_cast<const ObLogJoin*>(op)->get_join_algo();
+        break;
+      }
+      default: {
+        // nested loop join, merge join, sort ... are executed row by row.
+        break;
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && supported && i < op->get_num_of_child(); i++) {
+      if (OB_FAIL(check_vectorize_supported(op->get_child(i), supported))) {
+        LOG_WARN("check vectorize supported failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObCodeGenerator::get_plan_all_exprs(const ObLogPlan& plan, ObRawExprUniqueSet& exprs)
 {
   int ret = OB_SUCCESS;
@@ -36,7 +36,8 @@ public:
       : use_jit_(use_jit),
         use_static_typing_engine_(use_static_typing_engine),
         min_cluster_version_(min_cluster_version),
-        param_store_(param_store)
+        param_store_(param_store),
+        batch_size_(0)
   {}
   virtual ~ObCodeGenerator()
   {}
@@ -49,6 +50,11 @@ private:
 
   int generate_operators(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan);
 
+  // Detect batch size of vectorized execution, zero means row by row execution.
+  // Only plans with all operators support vectorized execution are vectorized.
+  int detect_batch_size(const ObLogPlan& log_plan, int64_t& batch_size);
+  int check_vectorize_supported(const ObLogicalOperator* op, bool& supported);
+
   // get all raw exprs of logical plan (include the subplans)
   int get_plan_all_exprs(const ObLogPlan& plan, ObRawExprUniqueSet& exprs);
 
@@ -79,6 +85,8 @@ private:
   bool use_static_typing_engine_;
   uint64_t min_cluster_version_;
   DatumParamStore* param_store_;
+  // batch size of vectorized execution, zero for row by row execution.
+  int64_t batch_size_;
 };
 
 }  // end namespace sql
@@ -133,6 +133,8 @@ int ObStaticEngineCG::generate(const ObLogPlan& log_plan, ObPhysicalPlan& phy_pl
   } else if (OB_ISNULL(root_spec)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("generated root spec is NULL", K(ret));
+  } else if (batch_size_ > 0 && OB_FAIL(disable_batch_below_hash_join(*root_spec, false))) {
+    LOG_WARN("disable batch below hash join failed", K(ret));
   } else {
     phy_plan.set_root_op_spec(root_spec);
     if (OB_FAIL(set_other_properties(log_plan, phy_plan))) {
@@ -148,6 +150,28 @@ int ObStaticEngineCG::generate(const ObLogPlan& log_plan, ObPhysicalPlan& phy_pl
   return ret;
 }
 
+int ObStaticEngineCG::disable_batch_below_hash_join(ObOpSpec& spec, const bool below_hash_join)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(check_stack_overflow())) {
+    LOG_WARN("check stack overflow failed", K(ret));
+  } else {
+    if (below_hash_join) {
+      spec.max_batch_size_ = 0;
+    }
+    for (uint32_t i = 0; OB_SUCC(ret) && i < spec.get_child_cnt(); i++) {
+      if (OB_ISNULL(spec.get_child(i))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("child is NULL", K(ret), K(i));
+      } else if (OB_FAIL(SMART_CALL(disable_batch_below_hash_join(
+                     *spec.get_child(i), below_hash_join || PHY_HASH_JOIN == spec.type_)))) {
+        LOG_WARN("disable batch below hash join failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObStaticEngineCG::postorder_generate_op(
     ObLogicalOperator& op, ObOpSpec*& spec, const bool in_root_job, const bool is_subplan, bool& check_eval_once)
 {
@@ -429,6 +453,8 @@ int ObStaticEngineCG::generate_spec_basic(ObLogicalOperator& op, ObOpSpec& spec,
   spec.width_ = op.get_width();
   spec.plan_depth_ = op.get_plan_depth();
   spec.px_est_size_factor_ = op.get_px_est_size_factor();
+  // transmit is the root of DFO, it fetches batches from child itself and sends rows one by one.
+  spec.max_batch_size_ = IS_PX_TRANSMIT(spec.type_) ? 0 : batch_size_;
 
   OZ(generate_rt_exprs(op.get_startup_exprs(), spec.startup_filters_));
 
@@ -3552,6 +3578,7 @@ int ObStaticEngineCG::generate_spec(ObLogGroupBy& op, ObHashGroupBySpec& spec, c
     LOG_ERROR("wrong number of children", K(ret), K(op.get_num_of_child()));
   } else {
     spec.set_est_group_cnt(op.get_distinct_card());
+    spec.set_bypass_enabled(op.is_push_down());
   }
 
   // 1. add group columns
@@ -4288,6 +4315,56 @@ int ObStaticEngineCG::generate_spec(ObLogJoin& op, ObMergeJoinSpec& spec, const
   return generate_join_spec(op, spec);
 }
 
+// Bloom filter of the hash join build side is shipped through datahub to the transmit which feeds the probe
+// side, so rows that can not be joined are dropped before they are sent over the network.
+int ObStaticEngineCG::generate_join_filter(ObLogJoin& op, ObHashJoinSpec& spec, const ObIArray<ObExpr*>& right_keys,
+    const ObIArray<ObHashFunc>& right_hash_funcs)
+{
+  int ret = OB_SUCCESS;
+  ObOpSpec* receive = spec.get_child(1);
+  ObOpSpec* transmit = NULL;
+  // probe rows not in the build side are never output by these join types
+  bool can_filter = INNER_JOIN == op.get_join_type() || LEFT_SEMI_JOIN == op.get_join_type() ||
+                    RIGHT_SEMI_JOIN == op.get_join_type() || LEFT_OUTER_JOIN == op.get_join_type() ||
+                    LEFT_ANTI_JOIN == op.get_join_type();
+  if (!can_filter || OB_ISNULL(receive) || OB_ISNULL(op.get_child(0))) {
+    can_filter = false;
+  } else if (min_cluster_version_ < CLUSTER_VERSION_316) {
+    // old servers can not handle the join filter datahub messages
+    can_filter = false;
+  } else if (PHY_PX_FIFO_RECEIVE != receive->get_type() && PHY_PX_MERGE_SORT_RECEIVE != receive->get_type()) {
+    can_filter = false;
+  } else if (OB_ISNULL(transmit = receive->get_child(0)) || !IS_PX_TRANSMIT(transmit->get_type()) ||
+             static_cast<ObPxTransmitSpec*>(transmit)->has_join_filter()) {
+    can_filter = false;
+  } else {
+    // join keys are calculated by the transmit, only those output by it can be used
+    for (int64_t i = 0; can_filter && i < right_keys.count(); ++i) {
+      can_filter = has_exist_in_array(transmit->output_, right_keys.at(i));
+    }
+  }
+  if (can_filter) {
+    ObPxTransmitSpec* transmit_spec = static_cast<ObPxTransmitSpec*>(transmit);
+    const int64_t bit_cnt = ObPxBloomFilter::calc_bit_count(static_cast<int64_t>(op.get_child(0)->get_card()));
+    if (bit_cnt <= 0) {
+      // build side too large, the filter would be saturated
+    } else if (OB_FAIL(transmit_spec->join_filter_exprs_.init(right_keys.count()))) {
+      LOG_WARN("failed to init join filter exprs", K(ret));
+    } else if (OB_FAIL(append(transmit_spec->join_filter_exprs_, right_keys))) {
+      LOG_WARN("failed to append join filter exprs", K(ret));
+    } else if (OB_FAIL(transmit_spec->join_filter_hash_funcs_.init(right_hash_funcs.count()))) {
+      LOG_WARN("failed to init join filter hash funcs", K(ret));
+    } else if (OB_FAIL(append(transmit_spec->join_filter_hash_funcs_, right_hash_funcs))) {
+      LOG_WARN("failed to append join filter hash funcs", K(ret));
+    } else {
+      transmit_spec->join_filter_id_ = spec.id_;
+      spec.join_filter_bit_cnt_ = bit_cnt;
+      LOG_TRACE("generate join filter", K(spec.id_), K(transmit_spec->id_), K(bit_cnt));
+    }
+  }
+  return ret;
+}
+
 int ObStaticEngineCG::generate_join_spec(ObLogJoin& op, ObJoinSpec& spec)
 {
   int ret = OB_SUCCESS;
@@ -4463,6 +4540,8 @@ int ObStaticEngineCG::generate_join_spec(ObLogJoin& op, ObJoinSpec& spec)
           LOG_WARN("failed to append join keys", K(ret));
         } else if (OB_FAIL(append(hj_spec.all_hash_funcs_, right_hash_funcs))) {
           LOG_WARN("failed to append join keys", K(ret));
+        } else if (OB_FAIL(generate_join_filter(op, hj_spec, right_key_exprs, right_hash_funcs))) {
+          LOG_WARN("failed to generate join filter", K(ret));
         }
       }
     }
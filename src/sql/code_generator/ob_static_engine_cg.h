@@ -121,11 +121,16 @@ public:
   template <int TYPE>
   friend class GenSpecHelper;
 
-  ObStaticEngineCG(uint64_t min_cluster_version) : ObCodeGeneratorImpl(min_cluster_version)
+  ObStaticEngineCG(uint64_t min_cluster_version) : ObCodeGeneratorImpl(min_cluster_version), batch_size_(0)
   {}
   // generate physical plan
   int generate(const ObLogPlan& log_plan, ObPhysicalPlan& phy_plan) override;
 
+  void set_batch_size(const int64_t batch_size)
+  {
+    batch_size_ = batch_size;
+  }
+
   // Dangerous: there is a dragon!!!
   int generate_rt_expr(const ObRawExpr& raw_expr, ObExpr*& rt_expr);
   int generate_rt_exprs(const common::ObIArray<ObRawExpr*>& src, common::ObIArray<ObExpr*>& dst);
@@ -145,6 +150,10 @@ private:
   int check_expr_columnlized(const ObRawExpr* expr);
   int check_exprs_columnlized(ObLogicalOperator& op);
 
+  // Children of vectorized hash join are executed row by row, they write rows to the batch row
+  // which hash join is filling.
+  int disable_batch_below_hash_join(ObOpSpec& spec, const bool below_hash_join);
+
   // generate basic attributes (attributes of ObOpSpec class),
   int generate_spec_basic(ObLogicalOperator& op, ObOpSpec& spec, const bool check_eval_once);
 
@@ -335,6 +344,8 @@ private:
   int generate_basic_transmit_spec(ObLogExchange& op, ObPxTransmitSpec& spec, const bool in_root_job);
   int generate_basic_receive_spec(ObLogExchange& op, ObPxReceiveSpec& spec, const bool in_root_job);
   int calc_equal_cond_opposite(const ObLogJoin& op, const ObRawExpr& raw_expr, bool& is_opposite);
+  int generate_join_filter(ObLogJoin& op, ObHashJoinSpec& spec, const common::ObIArray<ObExpr*>& right_keys,
+      const common::ObIArray<common::ObHashFunc>& right_hash_funcs);
   int fill_sort_info(const ObIArray<OrderItem>& sort_keys, ObSortCollations& collations, ObIArray<ObExpr*>& sort_exprs);
   int fill_sort_funcs(const ObSortCollations& collations, ObSortFuncs& sort_funcs, const ObIArray<ObExpr*>& sort_exprs);
   int add_column_infos(
@@ -409,6 +420,8 @@ private:
   // all self_produced exprs of current operator
   ObSEArray<ObRawExpr*, 8> cur_op_self_produced_exprs_;
   common::ObSEArray<uint64_t, 10> fake_cte_tables_;
+  // batch size of vectorized execution, zero for row by row execution.
+  int64_t batch_size_;
 };
 
 }  // end namespace sql
@@ -352,6 +352,15 @@ int ObStaticEngineExprCG::cg_all_frame_layout(const ObIArray<ObRawExpr*>& raw_ex
     LOG_WARN("fail to init param frame layout", K(ret), K(param_exprs));
   } else if (OB_FAIL(cg_dynamic_frame_layout(dynamic_param_exprs, frame_idx_pos, expr_info.dynamic_frame_))) {
     LOG_WARN("fail to init const", K(ret), K(dynamic_param_exprs));
+  }
+  if (OB_SUCC(ret) && batch_size_ > 0) {
+    // only expressions in datum frame are evaluated in batch
+    FOREACH_CNT(e, no_const_param_exprs)
+    {
+      get_rt_expr(**e)->batch_idx_mask_ = UINT64_MAX;
+    }
+  }
+  if (OB_FAIL(ret)) {
   } else if (OB_FAIL(cg_datum_frame_layout(no_const_param_exprs, frame_idx_pos, expr_info.datum_frame_))) {
     LOG_WARN("fail to init const", K(ret), K(no_const_param_exprs));
   } else if (OB_FAIL(alloc_const_frame(const_exprs, expr_info.const_frame_, expr_info.const_frame_ptrs_))) {
@@ -557,10 +566,12 @@ int ObStaticEngineExprCG::cg_frame_layout(const ObIArray<ObRawExpr*>& exprs, con
     } else {
       rt_expr->res_buf_len_ = def_res_len;
     }
+    rt_expr->res_buf_stride_ = reserve_data_consume(*rt_expr);
   }
   for (int64_t expr_idx = 0; OB_SUCC(ret) && expr_idx < exprs.count(); expr_idx++) {
     ObExpr* rt_expr = get_rt_expr(*exprs.at(expr_idx));
-    const int64_t datum_size = DATUM_EVAL_INFO_SIZE + reserve_data_consume(*rt_expr);
+    const int64_t datum_size =
+        get_expr_datum_eval_info_size(*rt_expr) + reserve_data_consume(*rt_expr) * get_expr_datum_cnt(*rt_expr);
     if (frame_size + datum_size <= MAX_FRAME_SIZE) {
       frame_size += datum_size;
       frame_expr_cnt++;
@@ -612,16 +623,24 @@ int ObStaticEngineExprCG::arrange_datum_data(
 {
   int ret = OB_SUCCESS;
   if (continuous_datum) {
-    int64_t data_off = frame.expr_cnt_ * DATUM_EVAL_INFO_SIZE;
+    // batch result expression's datums are continuous, followed by ObEvalInfo:
+    //   | datum * batch_size | eval info | ... | res buf * batch_size | ...
+    int64_t data_off = 0;
+    for (int64_t i = 0; i < exprs.count(); i++) {
+      data_off += get_expr_datum_eval_info_size(*get_rt_expr(*exprs.at(i)));
+    }
+    int64_t datum_off = 0;
     for (int64_t i = 0; OB_SUCC(ret) && i < exprs.count(); i++) {
       ObExpr* e = get_rt_expr(*exprs.at(i));
+      const int64_t datum_cnt = get_expr_datum_cnt(*e);
       e->frame_idx_ = frame.frame_idx_;
-      e->datum_off_ = i * DATUM_EVAL_INFO_SIZE;
-      e->eval_info_off_ = e->datum_off_ + sizeof(ObDatum);
+      e->datum_off_ = datum_off;
+      e->eval_info_off_ = e->datum_off_ + datum_cnt * sizeof(ObDatum);
+      datum_off += get_expr_datum_eval_info_size(*e);
       const int64_t consume_size = reserve_data_consume(*e);
       if (consume_size > 0) {
-        data_off += consume_size;
-        e->res_buf_off_ = data_off - e->res_buf_len_;
+        e->res_buf_off_ = data_off + consume_size - e->res_buf_len_;
+        data_off += consume_size * datum_cnt;
       } else {
         e->res_buf_off_ = 0;
       }
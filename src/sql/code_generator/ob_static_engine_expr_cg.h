@@ -48,8 +48,8 @@ public:
   static const int64_t STACK_OVERFLOW_CHECK_DEPTH = 16;
   static const int64_t DATUM_EVAL_INFO_SIZE = sizeof(ObDatum) + sizeof(ObEvalInfo);
   friend class ObRawExpr;
-  ObStaticEngineExprCG(common::ObIAllocator& allocator, DatumParamStore* param_store)
-      : allocator_(allocator), param_store_(param_store), op_cg_ctx_(), flying_param_cnt_(0)
+  ObStaticEngineExprCG(common::ObIAllocator& allocator, DatumParamStore* param_store, const int64_t batch_size = 0)
+      : allocator_(allocator), param_store_(param_store), op_cg_ctx_(), flying_param_cnt_(0), batch_size_(batch_size)
   {}
   virtual ~ObStaticEngineExprCG()
   {}
@@ -142,6 +142,18 @@ private:
     return expr.res_buf_len_ + (need_dyn_buf && expr.res_buf_len_ > 0 ? sizeof(ObDynReserveBuf) : 0);
   }
 
+  // datum count in frame, batch result expression has %batch_size_ datums.
+  int64_t get_expr_datum_cnt(const ObExpr& expr) const
+  {
+    return expr.is_batch_result() ? batch_size_ : 1;
+  }
+
+  // size of datums and ObEvalInfo
+  int64_t get_expr_datum_eval_info_size(const ObExpr& expr) const
+  {
+    return get_expr_datum_cnt(expr) * sizeof(ObDatum) + sizeof(ObEvalInfo);
+  }
+
   int arrange_datum_data(common::ObIArray<ObRawExpr*>& exprs, const ObFrameInfo& frame, const bool continuous_datum);
 
   int inner_generate_calculable_exprs(
@@ -157,6 +169,8 @@ private:
   ObExprCGCtx op_cg_ctx_;
   // Count of param store in generating, for calculable expressions CG.
   int64_t flying_param_cnt_;
+  // batch size of vectorized execution, zero for row by row execution.
+  int64_t batch_size_;
 };
 
 }  // end namespace sql
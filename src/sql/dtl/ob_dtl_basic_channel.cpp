@@ -523,6 +523,19 @@ int ObDtlBasicChannel::get_processed_buffer(int64_t timeout)
                     K(get_processed_buffer_cnt()),
                     K(get_recv_buffer_cnt()));
               }
+            } else if (ObDtlMsgType::PX_VECTOR_ROW == process_buffer_->msg_type()) {
+              if (msg_reader_ != &vectors_iter_) {
+                msg_reader_->reset();
+                msg_reader_ = &vectors_iter_;
+              }
+              if (OB_FAIL(msg_reader_->load_buffer(*process_buffer_))) {
+                LOG_WARN("failed to init px vectors iter",
+                    KP(id_),
+                    K_(peer),
+                    K(ret),
+                    K(get_processed_buffer_cnt()),
+                    K(get_recv_buffer_cnt()));
+              }
             }
           }
         } else {
@@ -561,7 +574,8 @@ int ObDtlBasicChannel::process1(ObIDtlChannelProc* proc, int64_t timeout, bool&
           }
         } else if (nullptr != process_buffer_) {
           auto& buffer = process_buffer_;
-          if (ObDtlMsgType::PX_DATUM_ROW == process_buffer_->msg_type()) {
+          if (ObDtlMsgType::PX_DATUM_ROW == process_buffer_->msg_type() ||
+              ObDtlMsgType::PX_VECTOR_ROW == process_buffer_->msg_type()) {
             if (!msg_reader_->is_inited()) {
               ret = OB_ERR_UNEXPECTED;
               LOG_WARN("px row iter is not init", K(ret));
@@ -972,6 +986,8 @@ int ObDtlBasicChannel::switch_writer(const ObDtlMsg& msg)
         msg_writer_ = &row_msg_writer_;
       } else if (DtlWriterType::CHUNK_DATUM_WRITER == msg_writer_map[px_row.get_data_type()]) {
         msg_writer_ = &datum_msg_writer_;
+      } else if (DtlWriterType::VECTORS_WRITER == msg_writer_map[px_row.get_data_type()]) {
+        msg_writer_ = &vectors_msg_writer_;
       } else {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("unkown msg writer", K(msg.get_type()), K(px_row.get_data_type()), K(msg_writer_->type()), K(ret));
@@ -1254,6 +1270,92 @@ int ObDtlDatumMsgWriter::serialize()
 }
 //--------------end ObDtlDatumMsgWriter---------------
 
+//-----------------start ObDtlVectorsMsgWriter-------------
+ObDtlVectorsMsgWriter::ObDtlVectorsMsgWriter()
+    : type_(VECTORS_WRITER), write_buffer_(nullptr), block_(nullptr), builder_(), pos_(0), write_ret_(OB_SUCCESS)
+{}
+
+ObDtlVectorsMsgWriter::~ObDtlVectorsMsgWriter()
+{
+  reset();
+  builder_.reset();
+}
+
+int ObDtlVectorsMsgWriter::init(ObDtlLinkedBuffer* buffer, uint64_t tenant_id)
+{
+  int ret = OB_SUCCESS;
+  if (nullptr == buffer) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("write buffer is null", K(ret));
+  } else if (buffer->size() < static_cast<int64_t>(sizeof(ObDtlVectorsBlock))) {
+    ret = OB_BUF_NOT_ENOUGH;
+    LOG_WARN("write buffer is too small", K(ret), K(buffer->size()));
+  } else {
+    reset();
+    builder_.set_tenant_id(tenant_id);
+    block_ = new (buffer->buf()) ObDtlVectorsBlock();
+    pos_ = sizeof(ObDtlVectorsBlock);
+    write_buffer_ = buffer;
+  }
+  return ret;
+}
+
+int ObDtlVectorsMsgWriter::need_new_buffer(const ObDtlMsg& msg, ObEvalCtx* ctx, int64_t& need_size, bool& need_new)
+{
+  int ret = OB_SUCCESS;
+  if (OB_LIKELY(OB_BUF_NOT_ENOUGH != write_ret_ && nullptr != write_buffer_)) {
+    need_new = false;
+  } else {
+    const ObPxNewRow& px_row = static_cast<const ObPxNewRow&>(msg);
+    const ObIArray<ObExpr*>* row = px_row.get_exprs();
+    need_size = sizeof(ObDtlVectorsBlock);
+    if (nullptr != row) {
+      int64_t batch_size = 0;
+      if (OB_FAIL(ObDtlVectorsBuilder::row_encoded_size(*row, *ctx, batch_size))) {
+        LOG_WARN("failed to calc row encoded size", K(ret));
+      }
+      need_size += batch_size;
+    }
+    // the row is rejected by the staged batch, always switch to a new buffer
+    need_new = true;
+    if (OB_SUCC(ret) && nullptr != write_buffer_) {
+      if (OB_FAIL(serialize())) {
+        LOG_WARN("failed to serialize", K(ret));
+      } else {
+        write_buffer_->pos() = rows() > 0 ? used() : 0;
+      }
+    }
+  }
+  write_ret_ = OB_SUCCESS;
+  return ret;
+}
+
+void ObDtlVectorsMsgWriter::reset()
+{
+  builder_.reuse();
+  block_ = nullptr;
+  write_buffer_ = nullptr;
+  pos_ = 0;
+  write_ret_ = OB_SUCCESS;
+}
+
+// encode the staged rows into buffer as a batch
+int ObDtlVectorsMsgWriter::serialize()
+{
+  int ret = OB_SUCCESS;
+  if (!builder_.is_empty()) {
+    const int64_t row_cnt = builder_.get_row_cnt();
+    if (OB_FAIL(builder_.encode(write_buffer_->buf(), write_buffer_->size(), pos_))) {
+      LOG_WARN("failed to encode batch", K(ret));
+    } else {
+      block_->row_cnt_ += row_cnt;
+      block_->batch_cnt_ += 1;
+    }
+  }
+  return ret;
+}
+//--------------end ObDtlVectorsMsgWriter---------------
+
 //----------------start ObDtlControlMsgWriter----------
 int ObDtlControlMsgWriter::write(const ObDtlMsg& msg, ObEvalCtx* eval_ctx, const bool is_eof)
 {
@@ -29,6 +29,7 @@
 #include "sql/dtl/ob_dtl_fc_server.h"
 #include "sql/engine/px/ob_px_row_store.h"
 #include "sql/engine/basic/ob_chunk_row_store.h"
+#include "sql/dtl/ob_dtl_vectors.h"
 #include "lib/ob_define.h"
 
 namespace oceanbase {
@@ -45,7 +46,13 @@ namespace dtl {
 
 class ObDtlBcastService;
 
-enum DtlWriterType { CONTROL_WRITER = 0, CHUNK_ROW_WRITER = 1, CHUNK_DATUM_WRITER = 2, MAX_WRITER = 3 };
+enum DtlWriterType {
+  CONTROL_WRITER = 0,
+  CHUNK_ROW_WRITER = 1,
+  CHUNK_DATUM_WRITER = 2,
+  VECTORS_WRITER = 3,
+  MAX_WRITER = 4
+};
 
 static DtlWriterType msg_writer_map[] = {
     MAX_WRITER,          // 0
@@ -74,14 +81,18 @@ static DtlWriterType msg_writer_map[] = {
     CONTROL_WRITER,      // DH_BARRIER_WHOLE_MSG,
     CONTROL_WRITER,      // DH_WINBUF_PIECE_MSG,
     CONTROL_WRITER,      // DH_WINBUF_WHOLE_MSG,
+    CONTROL_WRITER,      // DH_JOIN_FILTER_PIECE_MSG,
+    CONTROL_WRITER,      // DH_JOIN_FILTER_WHOLE_MSG,
+    VECTORS_WRITER,      // PX_VECTOR_ROW
 };
 
 static_assert(ARRAYSIZEOF(msg_writer_map) == ObDtlMsgType::MAX, "invalid ms_writer_map size");
 
-// 3 Encoder
+// 4 Encoder
 // 1) control msg
 // 2) ObRow msg
 // 3) Array<ObExprs> new engine msg
+// 4) Array<ObExprs> new engine msg in columnar format
 class ObDtlChannelEncoder {
 public:
   virtual int write(const ObDtlMsg& msg, ObEvalCtx* eval_ctx, const bool is_eof) = 0;
@@ -282,6 +293,79 @@ OB_INLINE int ObDtlDatumMsgWriter::write(const ObDtlMsg& msg, ObEvalCtx* eval_ct
   return ret;
 }
 
+// Rows are staged by builder_ and encoded into the buffer batch by batch, see ob_dtl_vectors.h
+class ObDtlVectorsMsgWriter : public ObDtlChannelEncoder {
+public:
+  ObDtlVectorsMsgWriter();
+  virtual ~ObDtlVectorsMsgWriter();
+
+  virtual DtlWriterType type()
+  {
+    return type_;
+  }
+  int init(ObDtlLinkedBuffer* buffer, uint64_t tenant_id);
+  void reset();
+
+  int write(const ObDtlMsg& msg, ObEvalCtx* eval_ctx, const bool is_eof);
+  int serialize();
+
+  int need_new_buffer(const ObDtlMsg& msg, ObEvalCtx* ctx, int64_t& need_size, bool& need_new);
+
+  OB_INLINE int64_t used()
+  {
+    return pos_ + builder_.encoded_size();
+  }
+  OB_INLINE int64_t rows()
+  {
+    return block_->row_cnt_ + builder_.get_row_cnt();
+  }
+  OB_INLINE int64_t remain()
+  {
+    return write_buffer_->size() - used();
+  }
+
+  virtual void write_msg_type(ObDtlLinkedBuffer* buffer)
+  {
+    buffer->msg_type() = ObDtlMsgType::PX_VECTOR_ROW;
+  }
+
+private:
+  DtlWriterType type_;
+  ObDtlLinkedBuffer* write_buffer_;
+  ObDtlVectorsBlock* block_;
+  ObDtlVectorsBuilder builder_;
+  int64_t pos_;  // end of the encoded batches
+  int write_ret_;
+};
+
+OB_INLINE int ObDtlVectorsMsgWriter::write(const ObDtlMsg& msg, ObEvalCtx* eval_ctx, const bool is_eof)
+{
+  int ret = OB_SUCCESS;
+  const ObPxNewRow& px_row = static_cast<const ObPxNewRow&>(msg);
+  const ObIArray<ObExpr*>* row = px_row.get_exprs();
+  if (nullptr != row) {
+    if (OB_FAIL(builder_.add_row(*row, *eval_ctx, write_buffer_->size() - pos_))) {
+      if (OB_BUF_NOT_ENOUGH != ret) {
+        SQL_DTL_LOG(WARN, "failed to add row", K(ret));
+      } else {
+        write_ret_ = OB_BUF_NOT_ENOUGH;
+      }
+    } else if (builder_.is_full() && OB_FAIL(serialize())) {
+      SQL_DTL_LOG(WARN, "failed to serialize", K(ret));
+    }
+  } else {
+    if (!is_eof) {
+      ret = OB_ERR_UNEXPECTED;
+      SQL_DTL_LOG(WARN, "unexpected status: it's must be eof", K(ret));
+    } else if (OB_FAIL(serialize())) {
+      SQL_DTL_LOG(WARN, "failed to serialize", K(ret));
+    }
+    write_buffer_->is_eof() = is_eof;
+    write_buffer_->pos() = used();
+  }
+  return ret;
+}
+
 class SendMsgResponse {
 public:
   SendMsgResponse();
@@ -496,9 +580,11 @@ protected:
   ObDtlControlMsgWriter ctl_msg_writer_;
   ObDtlRowMsgWriter row_msg_writer_;
   ObDtlDatumMsgWriter datum_msg_writer_;
+  ObDtlVectorsMsgWriter vectors_msg_writer_;
   ObDtlChannelEncoder* msg_writer_;
   sql::ObPxDatumRowIterator datum_row_iter_;
   sql::ObPxNewRowIterator px_row_iter_;
+  sql::ObPxVectorsIterator vectors_iter_;
   sql::ObDtlMsgReader* msg_reader_;
 
   bool channel_is_eof_;
@@ -35,6 +35,9 @@ enum ObDtlMsgType {
   DH_BARRIER_WHOLE_MSG,
   DH_WINBUF_PIECE_MSG,
   DH_WINBUF_WHOLE_MSG,
+  DH_JOIN_FILTER_PIECE_MSG,
+  DH_JOIN_FILTER_WHOLE_MSG,
+  PX_VECTOR_ROW,
   MAX
 };
 
@@ -36,6 +36,9 @@ public:
   virtual void set_iterator_end() = 0;
   virtual int get_next_row(common::ObNewRow& row) = 0;
   virtual int get_next_row(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx) = 0;
+  // get at most %max_rows rows of current buffer into batch datums of %exprs
+  virtual int get_next_batch(
+      const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, const int64_t max_rows, int64_t& read_rows) = 0;
 };
 
 class ObDtlPacketProcBase {
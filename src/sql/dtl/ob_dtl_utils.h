@@ -54,8 +54,11 @@ private:
 class ObTransmitEofAsynSender : public ObDtlAsynSender {
 public:
   ObTransmitEofAsynSender(ObIArray<ObDtlChannel*>& channels, ObDtlChTotalInfo* ch_info, bool is_transmit,
-      int64_t timeout_ts, sql::ObEvalCtx* eval_ctx)
-      : ObDtlAsynSender(channels, ch_info, is_transmit), timeout_ts_(timeout_ts), eval_ctx_(eval_ctx)
+      int64_t timeout_ts, sql::ObEvalCtx* eval_ctx, ObDtlMsgType data_type = ObDtlMsgType::PX_DATUM_ROW)
+      : ObDtlAsynSender(channels, ch_info, is_transmit),
+        timeout_ts_(timeout_ts),
+        eval_ctx_(eval_ctx),
+        data_type_(data_type)
   {}
 
   virtual int action(ObDtlChannel* ch);
@@ -63,6 +66,8 @@ public:
 private:
   int64_t timeout_ts_;
   sql::ObEvalCtx* eval_ctx_;
+  // eof row must be written by the same writer as data rows
+  ObDtlMsgType data_type_;
 };
 
 class ObDfcDrainAsynSender : public ObDtlAsynSender {
@@ -0,0 +1,263 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_DTL
+
+#include "ob_dtl_vectors.h"
+#include "sql/engine/expr/ob_expr.h"
+
+using namespace oceanbase::common;
+
+namespace oceanbase {
+namespace sql {
+namespace dtl {
+
+void ObDtlVectors::get_datums(const int64_t col_idx, ObDatum* datums) const
+{
+  const int32_t fixed_len = columns()[col_idx].fixed_len_;
+  const char* vals = values(col_idx);
+  if (VAR_LEN != fixed_len) {
+    for (int64_t i = 0; i < row_cnt_; i++) {
+      datums[i].ptr_ = vals + i * fixed_len;
+      datums[i].pack_ = fixed_len;
+    }
+  } else {
+    const uint32_t* offsets = reinterpret_cast<const uint32_t*>(vals);
+    const char* data = reinterpret_cast<const char*>(offsets + row_cnt_ + 1);
+    for (int64_t i = 0; i < row_cnt_; i++) {
+      datums[i].ptr_ = data + offsets[i];
+      datums[i].pack_ = offsets[i + 1] - offsets[i];
+    }
+  }
+  const ObBitVector& null_bits = nulls(col_idx);
+  if (!null_bits.is_all_false(row_cnt_)) {
+    for (int64_t i = 0; i < row_cnt_; i++) {
+      if (null_bits.at(i)) {
+        datums[i].set_null();
+      }
+    }
+  }
+}
+
+ObDtlVectorsBuilder::ObDtlVectorsBuilder()
+    : allocator_(ObModIds::OB_SQL_DTL), cols_(NULL), col_cnt_(0), row_cnt_(0), data_size_(0)
+{}
+
+void ObDtlVectorsBuilder::reset()
+{
+  cols_ = NULL;
+  col_cnt_ = 0;
+  row_cnt_ = 0;
+  data_size_ = 0;
+  allocator_.reset();
+}
+
+void ObDtlVectorsBuilder::reuse()
+{
+  for (int64_t i = 0; NULL != cols_ && i < col_cnt_; i++) {
+    ColumnBuf& col = cols_[i];
+    col.nulls_->reset(MAX_BATCH_ROWS);
+    col.offsets_[0] = 0;
+    col.fixed_len_ = ColumnBuf::NO_VALUE;
+  }
+  row_cnt_ = 0;
+  data_size_ = 0;
+}
+
+int ObDtlVectorsBuilder::init_columns(const int64_t col_cnt)
+{
+  int ret = OB_SUCCESS;
+  void* mem = NULL;
+  if (OB_ISNULL(mem = allocator_.alloc(sizeof(ColumnBuf) * col_cnt))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc memory failed", K(ret), K(col_cnt));
+  } else {
+    cols_ = new (mem) ColumnBuf[col_cnt];
+    col_cnt_ = col_cnt;
+    for (int64_t i = 0; OB_SUCC(ret) && i < col_cnt; i++) {
+      ColumnBuf& col = cols_[i];
+      if (OB_ISNULL(mem = allocator_.alloc(ObBitVector::memory_size(MAX_BATCH_ROWS)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc memory failed", K(ret));
+      } else {
+        col.nulls_ = to_bit_vector(mem);
+        if (OB_ISNULL(mem = allocator_.alloc(sizeof(uint32_t) * (MAX_BATCH_ROWS + 1)))) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("alloc memory failed", K(ret));
+        } else {
+          col.offsets_ = static_cast<uint32_t*>(mem);
+        }
+      }
+    }
+    if (OB_FAIL(ret)) {
+      cols_ = NULL;
+      col_cnt_ = 0;
+    } else {
+      reuse();
+    }
+  }
+  return ret;
+}
+
+int ObDtlVectorsBuilder::reserve(ColumnBuf& col, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t need = col.offsets_[row_cnt_] + size;
+  if (need > col.data_cap_) {
+    // staged data of previous batches is kept in arena, the capacity only grows
+    const int64_t new_cap = std::max(std::max(need, col.data_cap_ * 2), MIN_DATA_CAPACITY);
+    char* data = static_cast<char*>(allocator_.alloc(new_cap));
+    if (OB_ISNULL(data)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc memory failed", K(ret), K(new_cap));
+    } else {
+      if (col.offsets_[row_cnt_] > 0) {
+        MEMCPY(data, col.data_, col.offsets_[row_cnt_]);
+      }
+      col.data_ = data;
+      col.data_cap_ = new_cap;
+    }
+  }
+  return ret;
+}
+
+int ObDtlVectorsBuilder::add_row(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, const int64_t max_size)
+{
+  int ret = OB_SUCCESS;
+  int64_t row_size = 0;
+  ObDatum* datum = NULL;
+  if (OB_UNLIKELY(NULL == cols_) && OB_FAIL(init_columns(exprs.count()))) {
+    LOG_WARN("init columns failed", K(ret));
+  } else if (OB_UNLIKELY(exprs.count() != col_cnt_ || is_full())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected column count or batch is full", K(ret), K(exprs.count()), K(*this));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < col_cnt_; i++) {
+    if (OB_FAIL(exprs.at(i)->eval(eval_ctx, datum))) {
+      LOG_WARN("eval expr failed", K(ret));
+    } else if (!datum->is_null()) {
+      row_size += datum->len_;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    if (max_encoded_size(row_cnt_ + 1, col_cnt_, data_size_ + row_size) > max_size) {
+      ret = OB_BUF_NOT_ENOUGH;
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < col_cnt_; i++) {
+    ColumnBuf& col = cols_[i];
+    // evaluated already, get the result datum
+    if (OB_FAIL(exprs.at(i)->eval(eval_ctx, datum))) {
+      LOG_WARN("eval expr failed", K(ret));
+    } else if (datum->is_null()) {
+      col.nulls_->set(row_cnt_);
+      col.offsets_[row_cnt_ + 1] = col.offsets_[row_cnt_];
+    } else if (OB_FAIL(reserve(col, datum->len_))) {
+      LOG_WARN("reserve column data failed", K(ret));
+    } else {
+      MEMCPY(col.data_ + col.offsets_[row_cnt_], datum->ptr_, datum->len_);
+      col.offsets_[row_cnt_ + 1] = col.offsets_[row_cnt_] + datum->len_;
+      if (ColumnBuf::NO_VALUE == col.fixed_len_) {
+        col.fixed_len_ = datum->len_;
+      } else if (col.fixed_len_ != static_cast<int32_t>(datum->len_)) {
+        col.fixed_len_ = ObDtlVectors::VAR_LEN;
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    row_cnt_ += 1;
+    data_size_ += row_size;
+  }
+  return ret;
+}
+
+int ObDtlVectorsBuilder::row_encoded_size(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, int64_t& size)
+{
+  int ret = OB_SUCCESS;
+  int64_t row_size = 0;
+  ObDatum* datum = NULL;
+  for (int64_t i = 0; OB_SUCC(ret) && i < exprs.count(); i++) {
+    if (OB_FAIL(exprs.at(i)->eval(eval_ctx, datum))) {
+      LOG_WARN("eval expr failed", K(ret));
+    } else if (!datum->is_null()) {
+      row_size += datum->len_;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    size = max_encoded_size(1, exprs.count(), row_size);
+  }
+  return ret;
+}
+
+int64_t ObDtlVectorsBuilder::encode_column(const ColumnBuf& col, const int32_t fixed_len, char* buf) const
+{
+  int64_t pos = ObBitVector::memory_size(row_cnt_);
+  MEMCPY(buf, col.nulls_, pos);
+  if (ObDtlVectors::VAR_LEN != fixed_len) {
+    for (int64_t i = 0; i < row_cnt_; i++) {
+      if (col.nulls_->at(i)) {
+        MEMSET(buf + pos, 0, fixed_len);
+      } else {
+        MEMCPY(buf + pos, col.data_ + col.offsets_[i], fixed_len);
+      }
+      pos += fixed_len;
+    }
+  } else {
+    MEMCPY(buf + pos, col.offsets_, sizeof(uint32_t) * (row_cnt_ + 1));
+    pos += sizeof(uint32_t) * (row_cnt_ + 1);
+    MEMCPY(buf + pos, col.data_, col.offsets_[row_cnt_]);
+    pos += col.offsets_[row_cnt_];
+  }
+  const int64_t aligned = ObDtlVectors::align(pos);
+  MEMSET(buf + pos, 0, aligned - pos);
+  return aligned;
+}
+
+int ObDtlVectorsBuilder::encode(char* buf, const int64_t buf_len, int64_t& pos)
+{
+  int ret = OB_SUCCESS;
+  if (is_empty()) {
+    // do nothing
+  } else if (OB_ISNULL(buf) || OB_UNLIKELY(pos + encoded_size() > buf_len)) {
+    ret = OB_BUF_NOT_ENOUGH;
+    LOG_WARN("buffer not enough", K(ret), KP(buf), K(buf_len), K(pos), K(*this));
+  } else {
+    ObDtlVectors* vectors = reinterpret_cast<ObDtlVectors*>(buf + pos);
+    int64_t offset = ObDtlVectors::align(ObDtlVectors::header_size(col_cnt_));
+    MEMSET(vectors, 0, offset);
+    vectors->row_cnt_ = static_cast<int32_t>(row_cnt_);
+    vectors->col_cnt_ = static_cast<int32_t>(col_cnt_);
+    for (int64_t i = 0; i < col_cnt_; i++) {
+      const ColumnBuf& col = cols_[i];
+      // values of the same length are stored without offsets if it is smaller
+      int32_t fixed_len = ObDtlVectors::VAR_LEN;
+      if (ColumnBuf::NO_VALUE == col.fixed_len_) {
+        fixed_len = 0;
+      } else if (ObDtlVectors::VAR_LEN != col.fixed_len_ &&
+                 row_cnt_ * col.fixed_len_ <= sizeof(uint32_t) * (row_cnt_ + 1) + col.offsets_[row_cnt_]) {
+        fixed_len = col.fixed_len_;
+      }
+      ObDtlVectors::Column& column = vectors->columns()[i];
+      column.offset_ = static_cast<uint32_t>(offset);
+      column.fixed_len_ = fixed_len;
+      offset += encode_column(col, fixed_len, buf + pos + offset);
+    }
+    vectors->size_ = static_cast<int32_t>(offset);
+    pos += offset;
+    reuse();
+  }
+  return ret;
+}
+
+}  // namespace dtl
+}  // namespace sql
+}  // namespace oceanbase
@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_DTL_VECTORS_H
+#define OB_DTL_VECTORS_H
+
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_iarray.h"
+#include "share/datum/ob_datum.h"
+#include "sql/engine/ob_bit_vector.h"
+
+namespace oceanbase {
+namespace sql {
+struct ObExpr;
+struct ObEvalCtx;
+
+namespace dtl {
+
+/*
+ * Columnar format of PX data message (PX_VECTOR_ROW).
+ *
+ * Rows of a buffer are grouped into batches, each batch stores its rows column by column:
+ *
+ *   buffer: | ObDtlVectorsBlock | batch | batch | ... |
+ *   batch:  | ObDtlVectors | Column * col_cnt | column data | column data | ... |
+ *
+ *   column data of fixed length column:    | null bitmap | value * row_cnt |
+ *   column data of variable length column: | null bitmap | uint32_t offset * (row_cnt + 1) | values |
+ *
+ * All offsets are relative to the batch, so the buffer is sent as is and the receiver points
+ * datums to the values in buffer directly, rows are never copied on both sides.
+ * Batches and column data are 8 bytes aligned.
+ */
+struct ObDtlVectorsBlock {
+  ObDtlVectorsBlock() : row_cnt_(0), batch_cnt_(0)
+  {}
+  char* payload()
+  {
+    return reinterpret_cast<char*>(this) + sizeof(*this);
+  }
+  const char* payload() const
+  {
+    return reinterpret_cast<const char*>(this) + sizeof(*this);
+  }
+  TO_STRING_KV(K_(row_cnt), K_(batch_cnt));
+
+  int64_t row_cnt_;
+  int64_t batch_cnt_;
+};
+
+struct ObDtlVectors {
+  static const int32_t VAR_LEN = -1;
+  static const int64_t ALIGN_SIZE = 8;
+
+  struct Column {
+    uint32_t offset_;   // offset of column data in batch
+    int32_t fixed_len_;  // length of values, VAR_LEN for variable length column
+  };
+
+  static int64_t header_size(const int64_t col_cnt)
+  {
+    return sizeof(ObDtlVectors) + col_cnt * sizeof(Column);
+  }
+  static int64_t align(const int64_t size)
+  {
+    return (size + ALIGN_SIZE - 1) / ALIGN_SIZE * ALIGN_SIZE;
+  }
+  Column* columns()
+  {
+    return reinterpret_cast<Column*>(reinterpret_cast<char*>(this) + sizeof(*this));
+  }
+  const Column* columns() const
+  {
+    return reinterpret_cast<const Column*>(reinterpret_cast<const char*>(this) + sizeof(*this));
+  }
+  const ObBitVector& nulls(const int64_t col_idx) const
+  {
+    return *to_bit_vector(reinterpret_cast<const char*>(this) + columns()[col_idx].offset_);
+  }
+  const char* values(const int64_t col_idx) const
+  {
+    return reinterpret_cast<const char*>(this) + columns()[col_idx].offset_ + ObBitVector::memory_size(row_cnt_);
+  }
+  OB_INLINE void get_datum(const int64_t col_idx, const int64_t row_idx, common::ObDatum& datum) const
+  {
+    const int32_t fixed_len = columns()[col_idx].fixed_len_;
+    if (nulls(col_idx).at(row_idx)) {
+      datum.set_null();
+    } else if (VAR_LEN != fixed_len) {
+      datum.ptr_ = values(col_idx) + row_idx * fixed_len;
+      datum.pack_ = fixed_len;
+    } else {
+      const uint32_t* offsets = reinterpret_cast<const uint32_t*>(values(col_idx));
+      datum.ptr_ = reinterpret_cast<const char*>(offsets + row_cnt_ + 1) + offsets[row_idx];
+      datum.pack_ = offsets[row_idx + 1] - offsets[row_idx];
+    }
+  }
+  // assign datums of column to rows [0, row_cnt_) of %datums
+  void get_datums(const int64_t col_idx, common::ObDatum* datums) const;
+  TO_STRING_KV(K_(size), K_(row_cnt), K_(col_cnt));
+
+  int32_t size_;  // size of batch, include header
+  int32_t row_cnt_;
+  int32_t col_cnt_;
+  int32_t reserved_;
+};
+
+// Stage rows column by column and encode them into an ObDtlVectors batch.
+class ObDtlVectorsBuilder {
+public:
+  static const int64_t MAX_BATCH_ROWS = 256;
+  static const int64_t MIN_DATA_CAPACITY = 4L << 10;
+
+  ObDtlVectorsBuilder();
+  ~ObDtlVectorsBuilder()
+  {
+    reset();
+  }
+  void reset();
+  void reuse();
+  void set_tenant_id(const uint64_t tenant_id)
+  {
+    allocator_.set_tenant_id(tenant_id);
+  }
+  // add row to batch, return OB_BUF_NOT_ENOUGH and keep batch unchanged if the
+  // encoded batch will exceed %max_size with the row.
+  int add_row(const common::ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, const int64_t max_size);
+  int encode(char* buf, const int64_t buf_len, int64_t& pos);
+  bool is_empty() const
+  {
+    return 0 == row_cnt_;
+  }
+  bool is_full() const
+  {
+    return MAX_BATCH_ROWS == row_cnt_;
+  }
+  int64_t get_row_cnt() const
+  {
+    return row_cnt_;
+  }
+  // upper bound of encoded size of the staged rows
+  int64_t encoded_size() const
+  {
+    return is_empty() ? 0 : max_encoded_size(row_cnt_, col_cnt_, data_size_);
+  }
+  static int64_t max_encoded_size(const int64_t row_cnt, const int64_t col_cnt, const int64_t data_size)
+  {
+    return ObDtlVectors::align(ObDtlVectors::header_size(col_cnt)) +
+           col_cnt * (ObBitVector::memory_size(row_cnt) + sizeof(uint32_t) * (row_cnt + 1) +
+                         ObDtlVectors::ALIGN_SIZE) +
+           data_size;
+  }
+  // encoded size of a batch with only one row
+  static int row_encoded_size(const common::ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, int64_t& size);
+  TO_STRING_KV(K_(col_cnt), K_(row_cnt), K_(data_size));
+
+private:
+  // staged values of one column, values are always stored in variable length format
+  struct ColumnBuf {
+    static const int32_t NO_VALUE = -2;
+    ColumnBuf() : nulls_(NULL), offsets_(NULL), data_(NULL), data_cap_(0), fixed_len_(NO_VALUE)
+    {}
+    ObBitVector* nulls_;
+    uint32_t* offsets_;
+    char* data_;
+    int64_t data_cap_;
+    int32_t fixed_len_;  // length of all not null values, VAR_LEN if they differ
+  };
+  int init_columns(const int64_t col_cnt);
+  int reserve(ColumnBuf& col, const int64_t size);
+  int64_t encode_column(const ColumnBuf& col, const int32_t fixed_len, char* buf) const;
+
+private:
+  common::ObArenaAllocator allocator_;
+  ColumnBuf* cols_;
+  int64_t col_cnt_;
+  int64_t row_cnt_;
+  int64_t data_size_;  // total length of staged values
+  DISALLOW_COPY_AND_ASSIGN(ObDtlVectorsBuilder);
+};
+
+}  // namespace dtl
+}  // namespace sql
+}  // namespace oceanbase
+
+#endif /* OB_DTL_VECTORS_H */
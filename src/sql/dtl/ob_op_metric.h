@@ -107,6 +107,10 @@ public:
   {
     ++counter_;
   }
+  OB_INLINE void count(const int64_t cnt)
+  {
+    counter_ += cnt;
+  }
   int64_t get_counter()
   {
     return counter_;
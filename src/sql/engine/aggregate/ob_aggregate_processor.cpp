@@ -2994,21 +2994,8 @@ bool ObGroupRowHashTable::compare(const ObGroupRowItem& left, const ObGroupRowIt
 
 const ObGroupRowItem* ObGroupRowHashTable::get(const ObGroupRowItem& item) const
 {
-  ObGroupRowItem* res = NULL;
-  if (OB_UNLIKELY(NULL == buckets_)) {
-    // do nothing
-  } else {
-    const uint64_t hash_val = item.hash();
-    ObGroupRowItem* bucket = buckets_->at(hash_val & (get_bucket_num() - 1));
-    while (NULL != bucket) {
-      if (hash_val == bucket->hash() && compare(*bucket, item)) {
-        res = bucket;
-        break;
-      }
-      bucket = bucket->next();
-    }
-  }
-  return res;
+  auto eqf = [this, &item](const ObGroupRowItem& other) { return compare(other, item); };
+  return buckets_.get(item.hash(), eqf);
 }
 
 int ObAggregateCalcFunc::add_calc(const ObDatum& left_value, const ObDatum& right_value, ObDatum& result_datum,
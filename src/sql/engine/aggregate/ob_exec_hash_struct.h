@@ -30,14 +30,298 @@ class ObRowStore;
 
 namespace sql {
 
-// Auto extended hash table, extend to double buckets size if hash table is quarter filled.
+/*
+ * Buckets of open addressing hash table with linear probing.
+ *
+ * The hash value is kept in the bucket beside the item pointer, so mismatched items are skipped
+ * without touching them, and a probe mostly stays in one cache line instead of following a chain.
+ * The owner keeps the buckets sparse enough, there is always an empty bucket to stop probing.
+ *
+ * Extending is incremental: the old buckets are kept after a larger array is allocated, and are
+ * moved to the new one MOVE_STEP buckets at a time by each insert. The old array is never changed
+ * before it is freed, so items not moved yet are still found in it and there is no pause to rehash
+ * the whole table.
+ */
+template <typename Item>
+class ObLinearProbeBuckets {
+public:
+  struct Bucket {
+    uint64_t hash_;
+    Item* item_;
+    TO_STRING_KV(K_(hash), KP_(item));
+  };
+  using BucketArray = common::ObSegmentArray<Bucket, OB_MALLOC_BIG_BLOCK_SIZE, common::ModulePageAllocator>;
+  const static int64_t MOVE_STEP = 64;
+  // prefetch the target bucket of the item several buckets ahead when moving buckets
+  const static int64_t PREFETCH_DISTANCE = 8;
+
+  ObLinearProbeBuckets() : allocator_(NULL), buckets_(NULL), old_buckets_(NULL), moved_pos_(0), bucket_item_cnt_(0)
+  {}
+  ~ObLinearProbeBuckets()
+  {
+    destroy();
+  }
+  int init(common::ModulePageAllocator& allocator, const int64_t bucket_num);
+  bool is_inited() const
+  {
+    return NULL != buckets_;
+  }
+  int64_t count() const
+  {
+    return NULL == buckets_ ? 0 : buckets_->count();
+  }
+  int64_t mem_used() const
+  {
+    return (NULL == buckets_ ? 0 : buckets_->mem_used()) + (NULL == old_buckets_ ? 0 : old_buckets_->mem_used());
+  }
+  // allocate a larger bucket array, items are moved to it by the following inserts.
+  int extend(const int64_t bucket_num);
+  // (Do not check item is exist or not)
+  int insert(const uint64_t hash_val, Item& item);
+  // return the first item with the same hash value and eq(item) is true, NULL for none exist.
+  template <typename EQ>
+  Item* get(const uint64_t hash_val, EQ& eq) const
+  {
+    Item* res = NULL;
+    if (NULL != buckets_) {
+      res = probe(*buckets_, hash_val, eq);
+      if (NULL == res && NULL != old_buckets_) {
+        res = probe(*old_buckets_, hash_val, eq);
+      }
+    }
+    return res;
+  }
+  template <typename CB>
+  int foreach (CB& cb) const
+  {
+    int ret = common::OB_SUCCESS;
+    if (OB_ISNULL(buckets_)) {
+      ret = OB_INVALID_ARGUMENT;
+      SQL_ENG_LOG(WARN, "invalid null buckets", K(ret), K(buckets_));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < buckets_->count(); i++) {
+      Item* item = buckets_->at(i).item_;
+      if (NULL != item && OB_FAIL(cb(*item))) {
+        SQL_ENG_LOG(WARN, "call back failed", K(ret));
+      }
+    }
+    // items in the old buckets before moved_pos_ are already in the new ones
+    for (int64_t i = moved_pos_; OB_SUCC(ret) && NULL != old_buckets_ && i < old_buckets_->count(); i++) {
+      Item* item = old_buckets_->at(i).item_;
+      if (NULL != item && OB_FAIL(cb(*item))) {
+        SQL_ENG_LOG(WARN, "call back failed", K(ret));
+      }
+    }
+    return ret;
+  }
+  // remove all items, keep the bucket count
+  void reuse();
+  void destroy();
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObLinearProbeBuckets);
+  template <typename EQ>
+  static Item* probe(const BucketArray& buckets, const uint64_t hash_val, EQ& eq)
+  {
+    Item* res = NULL;
+    const int64_t mask = buckets.count() - 1;
+    for (int64_t pos = hash_val & mask; NULL == res; pos = (pos + 1) & mask) {
+      const Bucket& bucket = buckets.at(pos);
+      if (NULL == bucket.item_) {
+        break;
+      } else if (hash_val == bucket.hash_ && eq(*bucket.item_)) {
+        res = bucket.item_;
+      }
+    }
+    return res;
+  }
+  static void insert_bucket(BucketArray& buckets, const uint64_t hash_val, Item* item)
+  {
+    const int64_t mask = buckets.count() - 1;
+    int64_t pos = hash_val & mask;
+    while (NULL != buckets.at(pos).item_) {
+      pos = (pos + 1) & mask;
+    }
+    Bucket& bucket = buckets.at(pos);
+    bucket.hash_ = hash_val;
+    bucket.item_ = item;
+  }
+  void move_old_buckets(const int64_t step);
+  int create_bucket_array(const int64_t bucket_num, BucketArray*& buckets);
+  void free_bucket_array(BucketArray*& buckets);
+
+private:
+  common::ModulePageAllocator* allocator_;
+  BucketArray* buckets_;
+  BucketArray* old_buckets_;
+  int64_t moved_pos_;  // buckets of old_buckets_ before it are moved
+  int64_t bucket_item_cnt_;  // item count of buckets_, not including items left in old_buckets_
+};
+
+template <typename Item>
+int ObLinearProbeBuckets<Item>::init(common::ModulePageAllocator& allocator, const int64_t bucket_num)
+{
+  int ret = common::OB_SUCCESS;
+  if (OB_UNLIKELY(NULL != buckets_)) {
+    ret = common::OB_INIT_TWICE;
+    SQL_ENG_LOG(WARN, "init twice", K(ret));
+  } else if (OB_UNLIKELY(bucket_num < 2 || 0 != (bucket_num & (bucket_num - 1)))) {
+    ret = common::OB_INVALID_ARGUMENT;
+    SQL_ENG_LOG(WARN, "bucket num must be power of 2", K(ret), K(bucket_num));
+  } else {
+    allocator_ = &allocator;
+    if (OB_FAIL(create_bucket_array(bucket_num, buckets_))) {
+      SQL_ENG_LOG(WARN, "failed to create bucket array", K(ret), K(bucket_num));
+      allocator_ = NULL;
+    } else {
+      moved_pos_ = 0;
+      bucket_item_cnt_ = 0;
+    }
+  }
+  return ret;
+}
+
+template <typename Item>
+int ObLinearProbeBuckets<Item>::create_bucket_array(const int64_t bucket_num, BucketArray*& buckets)
+{
+  int ret = common::OB_SUCCESS;
+  void* buf = NULL;
+  buckets = NULL;
+  if (OB_ISNULL(buf = allocator_->alloc(sizeof(BucketArray)))) {
+    ret = common::OB_ALLOCATE_MEMORY_FAILED;
+    SQL_ENG_LOG(WARN, "failed to allocate memory", K(ret));
+  } else {
+    buckets = new (buf) BucketArray(*allocator_);
+    if (OB_FAIL(buckets->init(bucket_num))) {
+      SQL_ENG_LOG(WARN, "resize bucket array failed", K(ret), K(bucket_num));
+      free_bucket_array(buckets);
+    }
+  }
+  return ret;
+}
+
+template <typename Item>
+void ObLinearProbeBuckets<Item>::free_bucket_array(BucketArray*& buckets)
+{
+  if (NULL != buckets) {
+    buckets->destroy();
+    allocator_->free(buckets);
+    buckets = NULL;
+  }
+}
+
+template <typename Item>
+int ObLinearProbeBuckets<Item>::extend(const int64_t bucket_num)
+{
+  int ret = common::OB_SUCCESS;
+  BucketArray* new_buckets = NULL;
+  if (OB_ISNULL(buckets_)) {
+    ret = common::OB_NOT_INIT;
+    SQL_ENG_LOG(WARN, "not init", K(ret));
+  } else if (OB_UNLIKELY(bucket_num <= buckets_->count() || 0 != (bucket_num & (bucket_num - 1)))) {
+    ret = common::OB_INVALID_ARGUMENT;
+    SQL_ENG_LOG(WARN, "invalid bucket num", K(ret), K(bucket_num), K(count()));
+  } else if (OB_FAIL(create_bucket_array(bucket_num, new_buckets))) {
+    SQL_ENG_LOG(WARN, "failed to create bucket array", K(ret), K(bucket_num));
+  } else {
+    // extended again before the previous one is done, finish it at once
+    if (NULL != old_buckets_) {
+      move_old_buckets(old_buckets_->count());
+    }
+    old_buckets_ = buckets_;
+    buckets_ = new_buckets;
+    moved_pos_ = 0;
+    bucket_item_cnt_ = 0;
+    move_old_buckets(MOVE_STEP);
+  }
+  return ret;
+}
+
+template <typename Item>
+void ObLinearProbeBuckets<Item>::move_old_buckets(const int64_t step)
+{
+  const int64_t old_bucket_num = old_buckets_->count();
+  const int64_t mask = buckets_->count() - 1;
+  const int64_t end = std::min(moved_pos_ + step, old_bucket_num);
+  for (; moved_pos_ < end; ++moved_pos_) {
+    if (moved_pos_ + PREFETCH_DISTANCE < end) {
+      const Bucket& ahead = old_buckets_->at(moved_pos_ + PREFETCH_DISTANCE);
+      if (NULL != ahead.item_) {
+        __builtin_prefetch(&buckets_->at(ahead.hash_ & mask), 1 /* write */);
+      }
+    }
+    const Bucket& bucket = old_buckets_->at(moved_pos_);
+    if (NULL != bucket.item_) {
+      insert_bucket(*buckets_, bucket.hash_, bucket.item_);
+      ++bucket_item_cnt_;
+    }
+  }
+  if (moved_pos_ >= old_bucket_num) {
+    free_bucket_array(old_buckets_);
+    moved_pos_ = 0;
+  }
+}
+
+template <typename Item>
+int ObLinearProbeBuckets<Item>::insert(const uint64_t hash_val, Item& item)
+{
+  int ret = common::OB_SUCCESS;
+  if (OB_ISNULL(buckets_)) {
+    ret = common::OB_NOT_INIT;
+    SQL_ENG_LOG(WARN, "not init", K(ret));
+  } else if (OB_UNLIKELY(bucket_item_cnt_ + 1 >= buckets_->count())) {
+    // an empty bucket is needed to end probing
+    ret = common::OB_SIZE_OVERFLOW;
+    SQL_ENG_LOG(WARN, "buckets are full", K(ret), K(bucket_item_cnt_), K(count()));
+  } else {
+    insert_bucket(*buckets_, hash_val, &item);
+    ++bucket_item_cnt_;
+    if (NULL != old_buckets_) {
+      move_old_buckets(MOVE_STEP);
+    }
+  }
+  return ret;
+}
+
+template <typename Item>
+void ObLinearProbeBuckets<Item>::reuse()
+{
+  if (NULL != buckets_) {
+    free_bucket_array(old_buckets_);
+    Bucket empty_bucket;
+    empty_bucket.hash_ = 0;
+    empty_bucket.item_ = NULL;
+    if (OB_UNLIKELY(common::OB_SUCCESS != buckets_->set_all(empty_bucket))) {
+      SQL_ENG_LOG(ERROR, "reset buckets failed", K(count()));
+    }
+  }
+  moved_pos_ = 0;
+  bucket_item_cnt_ = 0;
+}
+
+template <typename Item>
+void ObLinearProbeBuckets<Item>::destroy()
+{
+  if (NULL != allocator_) {
+    free_bucket_array(old_buckets_);
+    free_bucket_array(buckets_);
+  }
+  allocator_ = NULL;
+  moved_pos_ = 0;
+  bucket_item_cnt_ = 0;
+}
+
+// Auto extended hash table, extend to double buckets size if hash table is half filled.
 template <typename Item>
 class ObExtendHashTable {
 public:
   const static int64_t INITIAL_SIZE = 128;
-  const static int64_t SIZE_BUCKET_SCALE = 4;
+  const static int64_t SIZE_BUCKET_SCALE = 2;
+  // open addressing buckets can not be overfilled, extend regardless of the memory bound beyond it
+  const static int64_t MAX_FILL_PERCENT = 75;
   const static int64_t MAX_MEM_PERCENT = 40;
-  ObExtendHashTable() : initial_bucket_num_(0), size_(0), buckets_(NULL), allocator_(NULL),
+  const static int64_t BUCKET_SIZE = sizeof(typename ObLinearProbeBuckets<Item>::Bucket);
+  ObExtendHashTable() : initial_bucket_num_(0), size_(0), buckets_(), allocator_(NULL),
   sql_mem_processor_(nullptr)
   {}
   ~ObExtendHashTable()
@@ -49,11 +333,11 @@ public:
            ObSqlMemMgrProcessor *sql_mem_processor, int64_t initial_size = INITIAL_SIZE);
   bool is_inited() const
   {
-    return NULL != buckets_;
+    return buckets_.is_inited();
   }
   // return the first item which equal to, NULL for none exist.
   const Item* get(const Item& item) const;
-  // Link item to hash table, extend buckets if needed.
+  // Add item to hash table, extend buckets if needed.
   // (Do not check item is exist or not)
   int set(Item& item);
   int64_t size() const
@@ -63,14 +347,7 @@ public:
 
   void reuse()
   {
-    int ret = common::OB_SUCCESS;
-    if (nullptr != buckets_) {
-      int64_t bucket_num = get_bucket_num();
-      buckets_->reuse();
-      if (OB_FAIL(buckets_->init(bucket_num))) {
-        SQL_ENG_LOG(ERROR, "resize bucket array failed", K(size_), K(bucket_num), K(get_bucket_num()));
-      }
-    }
+    buckets_.reuse();
     size_ = 0;
   }
 
@@ -78,11 +355,7 @@ public:
 
   void destroy()
   {
-    if (NULL != buckets_) {
-      buckets_->destroy();
-      allocator_.free(buckets_);
-      buckets_ = NULL;
-    }
+    buckets_.destroy();
     allocator_.set_allocator(nullptr);
     size_ = 0;
     initial_bucket_num_ = 0;
@@ -90,37 +363,22 @@ public:
   }
   int64_t mem_used() const
   {
-    return NULL == buckets_ ? 0 : buckets_->mem_used();
+    return buckets_.mem_used();
   }
 
   inline int64_t get_bucket_num() const
   {
-    return NULL == buckets_ ? 0 : buckets_->count();
+    return buckets_.count();
   }
   template <typename CB>
   int foreach (CB& cb) const
   {
-    int ret = common::OB_SUCCESS;
-    if (OB_ISNULL(buckets_)) {
-      ret = OB_INVALID_ARGUMENT;
-      SQL_ENG_LOG(WARN, "invalid null buckets", K(ret), K(buckets_));
-    }
-    for (int64_t i = 0; OB_SUCC(ret) && i < get_bucket_num(); i++) {
-      Item* item = buckets_->at(i);
-      while (NULL != item && OB_SUCC(ret)) {
-        if (OB_FAIL(cb(*item))) {
-          SQL_ENG_LOG(WARN, "call back failed", K(ret));
-        } else {
-          item = item->next();
-        }
-      }
-    }
-    return ret;
+    return buckets_.foreach(cb);
   }
 
 protected:
   DISALLOW_COPY_AND_ASSIGN(ObExtendHashTable);
-  int extend();
+  int extend(const bool ignore_mem_bound);
   int64_t estimate_bucket_num(
       const int64_t bucket_num,
       const int64_t max_hash_mem);
@@ -129,8 +387,7 @@ protected:
   lib::ObMemAttr mem_attr_;
   int64_t initial_bucket_num_;
   int64_t size_;
-  using BucketArray = common::ObSegmentArray<Item*, OB_MALLOC_BIG_BLOCK_SIZE, common::ModulePageAllocator>;
-  BucketArray* buckets_;
+  ObLinearProbeBuckets<Item> buckets_;
   common::ModulePageAllocator allocator_;
   ObSqlMemMgrProcessor *sql_mem_processor_;
 };
@@ -142,10 +399,10 @@ int64_t ObExtendHashTable<Item>::estimate_bucket_num(
 {
   int64_t max_bound_size = max_hash_mem * MAX_MEM_PERCENT / 100;
   int64_t est_bucket_num = common::next_pow2(bucket_num);
-  int64_t est_size = est_bucket_num * sizeof(void*);
+  int64_t est_size = est_bucket_num * BUCKET_SIZE;
   while (est_size > max_bound_size) {
     est_bucket_num >>= 1;
-    est_size = est_bucket_num * sizeof(void*);
+    est_size = est_bucket_num * BUCKET_SIZE;
   }
   if (est_bucket_num < INITIAL_SIZE) {
     est_bucket_num = INITIAL_SIZE;
@@ -170,19 +427,12 @@ int ObExtendHashTable<Item>::init(
     sql_mem_processor_ = sql_mem_processor;
     allocator_.set_allocator(allocator);
     allocator_.set_label(mem_attr.label_);
-    void* buckets_buf = NULL;
-    if (OB_ISNULL(buckets_buf = allocator_.alloc(sizeof(BucketArray), mem_attr))) {
-      ret = OB_ALLOCATE_MEMORY_FAILED;
-      SQL_ENG_LOG(WARN, "failed to allocate memory", K(ret));
-    } else {
-      buckets_ = new (buckets_buf) BucketArray(allocator_);
-      initial_bucket_num_ = common::next_pow2(initial_size * SIZE_BUCKET_SCALE);
-      size_ = 0;
-    }
-    if (OB_FAIL(ret)) {
-      // do nothing
-    } else if (OB_FAIL(extend())) {
-      SQL_ENG_LOG(WARN, "extend failed", K(ret));
+    allocator_.set_tenant_id(mem_attr.tenant_id_);
+    initial_bucket_num_ = common::next_pow2(initial_size * SIZE_BUCKET_SCALE);
+    size_ = 0;
+    const int64_t bucket_num = estimate_bucket_num(initial_bucket_num_, sql_mem_processor_->get_mem_bound());
+    if (OB_FAIL(buckets_.init(allocator_, bucket_num))) {
+      SQL_ENG_LOG(WARN, "init buckets failed", K(ret), K(bucket_num));
     }
   }
   return ret;
@@ -207,23 +457,9 @@ int ObExtendHashTable<Item>::resize(ObIAllocator* allocator, int64_t bucket_num,
 template <typename Item>
 const Item* ObExtendHashTable<Item>::get(const Item& item) const
 {
-  Item* res = NULL;
-  if (NULL == buckets_) {
-    // do nothing
-  } else {
-    common::hash::hash_func<Item> hf;
-    common::hash::equal_to<Item> eqf;
-    const uint64_t hash_val = hf(item);
-    Item* bucket = buckets_->at(hash_val & (get_bucket_num() - 1));
-    while (NULL != bucket) {
-      if (hash_val == hf(*bucket) && eqf(*bucket, item)) {
-        res = bucket;
-        break;
-      }
-      bucket = bucket->next();
-    }
-  }
-  return res;
+  common::hash::hash_func<Item> hf;
+  auto eqf = [&item](const Item& other) { return common::hash::equal_to<Item>()(other, item); };
+  return buckets_.get(hf(item), eqf);
 }
 
 template <typename Item>
@@ -232,76 +468,34 @@ int ObExtendHashTable<Item>::set(Item& item)
   common::hash::hash_func<Item> hf;
   int ret = common::OB_SUCCESS;
   if (size_ * SIZE_BUCKET_SCALE >= get_bucket_num()) {
-    if (OB_FAIL(extend())) {
+    if (OB_FAIL(extend(false))) {
+      SQL_ENG_LOG(WARN, "extend failed", K(ret));
+    } else if (size_ * 100 >= get_bucket_num() * MAX_FILL_PERCENT && OB_FAIL(extend(true))) {
       SQL_ENG_LOG(WARN, "extend failed", K(ret));
     }
   }
   if (OB_FAIL(ret)) {
     // do nothing
-  } else if (OB_ISNULL(buckets_)) {
-    ret = OB_INVALID_ARGUMENT;
-    SQL_ENG_LOG(WARN, "invalid argument", K(ret), K(buckets_));
+  } else if (OB_FAIL(buckets_.insert(hf(item), item))) {
+    SQL_ENG_LOG(WARN, "insert item failed", K(ret), K(size_));
   } else {
-    Item*& bucket = buckets_->at(hf(item) & (get_bucket_num() - 1));
-    item.next() = bucket;
-    bucket = &item;
     size_ += 1;
   }
   return ret;
 }
 
 template <typename Item>
-int ObExtendHashTable<Item>::extend()
+int ObExtendHashTable<Item>::extend(const bool ignore_mem_bound)
 {
-  common::hash::hash_func<Item> hf;
   int ret = common::OB_SUCCESS;
   int64_t pre_bucket_num = get_bucket_num();
-  int64_t new_bucket_num = 0 == pre_bucket_num ?
-                          (0 == initial_bucket_num_ ? INITIAL_SIZE : initial_bucket_num_)
-                          : pre_bucket_num * 2;
-  new_bucket_num = estimate_bucket_num(new_bucket_num, sql_mem_processor_->get_mem_bound());
+  int64_t new_bucket_num = pre_bucket_num * 2;
+  if (!ignore_mem_bound) {
+    new_bucket_num = estimate_bucket_num(new_bucket_num, sql_mem_processor_->get_mem_bound());
+  }
   if (new_bucket_num <= pre_bucket_num) {
-  } else {
-    BucketArray* new_buckets = NULL;
-    void* buckets_buf = NULL;
-    if (OB_ISNULL(buckets_buf = allocator_.alloc(sizeof(BucketArray), mem_attr_))) {
-      ret = OB_ALLOCATE_MEMORY_FAILED;
-      SQL_ENG_LOG(WARN, "failed to allocate memory", K(ret));
-    } else {
-      new_buckets = new (buckets_buf) BucketArray(allocator_);
-    }
-    if (OB_FAIL(ret)) {
-      // do nothing
-    } else if (OB_ISNULL(buckets_)) {
-      ret = OB_INVALID_ARGUMENT;
-      SQL_ENG_LOG(WARN, "invalid argument", K(ret), K(buckets_));
-    } else if (OB_FAIL(new_buckets->init(new_bucket_num))) {
-      SQL_ENG_LOG(WARN, "resize bucket array failed", K(ret), K(new_bucket_num));
-    } else {
-      for (int64_t i = 0; i < get_bucket_num(); i++) {
-        Item* bucket = buckets_->at(i);
-        while (bucket != NULL) {
-          Item* item = bucket;
-          bucket = bucket->next();
-          Item*& new_bucket = new_buckets->at(hf(*item) & (new_bucket_num - 1));
-          item->next() = new_bucket;
-          new_bucket = item;
-        }
-      }
-      buckets_->destroy();
-      allocator_.free(buckets_);
-
-      buckets_ = new_buckets;
-    }
-    if (OB_FAIL(ret)) {
-      if (buckets_ == new_buckets) {
-        SQL_ENG_LOG(ERROR, "unexpected status: failed allocate new bucket", K(ret));
-      } else if (nullptr != new_buckets) {
-        new_buckets->destroy();
-        allocator_.free(new_buckets);
-        new_buckets = nullptr;
-      }
-    }
+  } else if (OB_FAIL(buckets_.extend(new_bucket_num))) {
+    SQL_ENG_LOG(WARN, "extend buckets failed", K(ret), K(pre_bucket_num), K(new_bucket_num));
   }
   return ret;
 }
@@ -191,7 +191,8 @@ void ObHashGroupBy::ObHashGroupByCtx::adjust_part_cnt(int64_t& part_cnt)
 
 int64_t ObHashGroupBy::ObHashGroupByCtx::estimate_hash_bucket_size(int64_t bucket_cnt)
 {
-  return next_pow2(ObExtendHashTable<ObGbyHashCols>::SIZE_BUCKET_SCALE * bucket_cnt) * sizeof(void*);
+  return next_pow2(ObExtendHashTable<ObGbyHashCols>::SIZE_BUCKET_SCALE * bucket_cnt) *
+         ObExtendHashTable<ObGbyHashCols>::BUCKET_SIZE;
 }
 
 int64_t ObHashGroupBy::ObHashGroupByCtx::estimate_hash_bucket_cnt_by_mem_size(
@@ -204,7 +205,7 @@ int64_t ObHashGroupBy::ObHashGroupByCtx::estimate_hash_bucket_cnt_by_mem_size(
       mem_size >>= 1;
     }
   }
-  return mem_size / sizeof(void*) / ObExtendHashTable<ObGbyHashCols>::SIZE_BUCKET_SCALE;
+  return mem_size / ObExtendHashTable<ObGbyHashCols>::BUCKET_SIZE / ObExtendHashTable<ObGbyHashCols>::SIZE_BUCKET_SCALE;
 }
 ObHashGroupBy::ObHashGroupBy(ObIAllocator& alloc) : ObGroupBy(alloc)
 {}
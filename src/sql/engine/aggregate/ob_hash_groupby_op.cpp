@@ -22,7 +22,7 @@ using namespace common::hash;
 
 namespace sql {
 
-OB_SERIALIZE_MEMBER((ObHashGroupBySpec, ObGroupBySpec), group_exprs_, cmp_funcs_, est_group_cnt_);
+OB_SERIALIZE_MEMBER((ObHashGroupBySpec, ObGroupBySpec), group_exprs_, cmp_funcs_, est_group_cnt_, bypass_enabled_);
 
 DEF_TO_STRING(ObHashGroupBySpec)
 {
@@ -32,7 +32,7 @@ DEF_TO_STRING(ObHashGroupBySpec)
   J_COLON();
   pos += ObGroupBySpec::to_string(buf + pos, buf_len - pos);
   J_COMMA();
-  J_KV(K_(group_exprs));
+  J_KV(K_(group_exprs), K_(bypass_enabled));
   J_OBJ_END();
   return pos;
 }
@@ -57,6 +57,9 @@ void ObHashGroupByOp::reset()
   sql_mem_processor_.reset();
   destroy_all_parts();
   group_store_.reset();
+  bypass_ = false;
+  input_remain_ = false;
+  bypass_group_cnt_ = 0;
 }
 
 int ObHashGroupByOp::inner_open()
@@ -123,6 +126,11 @@ int ObHashGroupByOp::inner_open()
           K(sql_mem_processor_.get_mem_bound()));
     }
   }
+  if (OB_SUCC(ret)) {
+    // distinct and order by aggregation can not be merged by the parent group by
+    bypass_enabled_ =
+        MY_SPEC.bypass_enabled_ && !(aggr_processor_.has_distinct() || aggr_processor_.has_order_by());
+  }
   return ret;
 }
 
@@ -229,8 +237,16 @@ int ObHashGroupByOp::inner_get_next_row()
     ++curr_group_id_;
   }
 
+  if (OB_SUCC(ret) && OB_UNLIKELY(curr_group_id_ >= get_output_group_cnt()) && input_remain_) {
+    if (OB_FAIL(load_remain_data())) {
+      LOG_WARN("load remain data failed", K(ret));
+    } else {
+      curr_group_id_ = 0;
+    }
+  }
+
   if (OB_SUCC(ret)) {
-    if (OB_UNLIKELY(curr_group_id_ >= local_group_rows_.size())) {
+    if (OB_UNLIKELY(curr_group_id_ >= get_output_group_cnt())) {
       if (dumped_group_parts_.is_empty()) {
         op_monitor_info_.otherstat_2_value_ = agged_group_cnt_;
         op_monitor_info_.otherstat_2_id_ = ObSqlMonitorStatIds::HASH_ROW_COUNT;
@@ -275,6 +291,48 @@ int ObHashGroupByOp::inner_get_next_row()
   return ret;
 }
 
+int ObHashGroupByOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  // Child rows are fetched by child_->get_next_row() in load_data(), which iterate child's batch
+  // rows. Output group rows are restored to batch rows one by one, filters and outputs are
+  // evaluated in batch.
+  ObSEArray<ObExpr*, 16> aggr_exprs;
+  FOREACH_CNT_X(info, MY_SPEC.aggr_infos_, OB_SUCC(ret))
+  {
+    if (OB_FAIL(aggr_exprs.push_back(info->expr_))) {
+      LOG_WARN("array push back failed", K(ret));
+    }
+  }
+  int64_t size = 0;
+  while (OB_SUCC(ret) && size < max_row_cnt) {
+    eval_ctx_.set_batch_idx(size);
+    if (OB_FAIL(inner_get_next_row())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("inner get next row failed", K(ret));
+      } else {
+        ret = OB_SUCCESS;
+        brs_.end_ = true;
+        break;
+      }
+    } else if (OB_FAIL(deep_copy_batch_row(MY_SPEC.group_exprs_))) {
+      LOG_WARN("deep copy group by datum failed", K(ret));
+    } else if (OB_FAIL(deep_copy_batch_row(aggr_exprs))) {
+      LOG_WARN("deep copy aggregate datum failed", K(ret));
+    } else {
+      size++;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    set_batch_evaluated(MY_SPEC.group_exprs_, size);
+    set_batch_evaluated(aggr_exprs, size);
+    if (OB_FAIL(filter_and_project_batch(size))) {
+      LOG_WARN("filter and project batch failed", K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObHashGroupByOp::load_data()
 {
   int ret = OB_SUCCESS;
@@ -285,6 +343,9 @@ int ObHashGroupByOp::load_data()
   int64_t input_rows = child_->get_spec().rows_;
   int64_t input_size = child_->get_spec().width_ * input_rows;
   static_assert(MAX_PARTITION_CNT <= (1 << (CHAR_BIT)), "max partition cnt is too big");
+  // child_->get_next_row() of vectorized child changes batch index, restore it after loaded.
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+  input_remain_ = false;
 
   if (!dumped_group_parts_.is_empty()) {
     aggr_processor_.reuse();
@@ -340,6 +401,12 @@ int ObHashGroupByOp::load_data()
   const ObChunkDatumStore::StoredRow* srow = NULL;
 
   for (int64_t loop_cnt = 0; OB_SUCC(ret); ++loop_cnt) {
+    if (bypass_enabled_ && loop_cnt > 0 && 0 == loop_cnt % BYPASS_CHECK_ROWS && need_bypass()) {
+      bypass_ = true;
+      input_remain_ = true;
+      LOG_TRACE("switch to bypass", K(agged_group_cnt_), K(agged_row_cnt_), K(local_group_rows_.size()));
+      break;
+    }
     if (NULL == cur_part) {
       ret = child_->get_next_row();
     } else {
@@ -388,7 +455,11 @@ int ObHashGroupByOp::load_data()
         LOG_WARN("fail to process row", K(ret), KPC(exist_curr_gr_item));
       }
     } else {
-      if (!is_dump_enabled || local_group_rows_.size() < MIN_INMEM_GROUPS ||
+      // The pushed down group by stops loading when memory is used up, groups in memory are
+      // emitted and merged by the parent group by.
+      const bool need_emit = bypass_enabled_ && local_group_rows_.size() >= MIN_INMEM_GROUPS &&
+                             need_start_dump(input_rows, est_part_cnt, check_dump);
+      if (bypass_enabled_ || !is_dump_enabled || local_group_rows_.size() < MIN_INMEM_GROUPS ||
           (!start_dump && !need_start_dump(input_rows, est_part_cnt, check_dump))) {
         ++agged_row_cnt_;
         ++agged_group_cnt_;
@@ -399,6 +470,17 @@ int ObHashGroupByOp::load_data()
           LOG_WARN("fail to prepare row", K(ret), KPC(tmp_gr_item->group_row_));
         } else if (OB_FAIL(local_group_rows_.set(*tmp_gr_item))) {
           LOG_WARN("hash table set failed", K(ret));
+        } else if (need_emit) {
+          bypass_ = need_bypass();
+          input_remain_ = true;
+          LOG_TRACE("emit groups in memory",
+              K(bypass_),
+              K(agged_group_cnt_),
+              K(agged_row_cnt_),
+              K(local_group_rows_.size()),
+              K(get_mem_used_size()),
+              K(get_mem_bound_size()));
+          break;
         }
       } else {
         if (OB_UNLIKELY(!start_dump)) {
@@ -447,6 +529,69 @@ int ObHashGroupByOp::load_data()
   return ret;
 }
 
+int ObHashGroupByOp::load_bypass_data()
+{
+  int ret = OB_SUCCESS;
+  // child_->get_next_row() of vectorized child changes batch index, restore it after loaded.
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+  input_remain_ = false;
+  for (int64_t loop_cnt = 0; OB_SUCC(ret) && !input_remain_; ++loop_cnt) {
+    ObAggregateProcessor::GroupRow* group_row = NULL;
+    ObChunkDatumStore::StoredRow* groupby_store_row = NULL;
+    if (loop_cnt >= BYPASS_BATCH_ROWS) {
+      input_remain_ = true;
+    } else if (OB_FAIL(child_->get_next_row())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("get input row failed", K(ret));
+      }
+    } else if (FALSE_IT(clear_evaluated_flag())) {
+    } else if (OB_FAIL(aggr_processor_.init_one_group(bypass_group_cnt_))) {
+      LOG_WARN("failed to init one group", K(bypass_group_cnt_), K(ret));
+    } else if (OB_FAIL(aggr_processor_.get_group_row(bypass_group_cnt_, group_row))) {
+      LOG_WARN("failed to get group_row", K(bypass_group_cnt_), K(ret));
+    } else if (OB_ISNULL(group_row)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("group_row is null", K(bypass_group_cnt_), K(ret));
+    } else if (OB_FAIL(group_store_.add_row(MY_SPEC.group_exprs_, &eval_ctx_, &groupby_store_row))) {
+      LOG_WARN("failed to add row", K(ret));
+    } else if (FALSE_IT(group_row->groupby_store_row_ = groupby_store_row)) {
+    } else if (OB_FAIL(aggr_processor_.prepare(*group_row))) {
+      LOG_WARN("fail to prepare row", K(ret), KPC(group_row));
+    } else {
+      ++bypass_group_cnt_;
+      ++agged_row_cnt_;
+      ++agged_group_cnt_;
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+  }
+  IGNORE_RETURN sql_mem_processor_.update_used_mem_size(get_mem_used_size());
+  return ret;
+}
+
+int ObHashGroupByOp::load_remain_data()
+{
+  int ret = OB_SUCCESS;
+  local_group_rows_.reuse();
+  aggr_processor_.reuse();
+  bypass_group_cnt_ = 0;
+  if (OB_FAIL(ctx_.check_status())) {
+    LOG_WARN("check status failed", K(ret));
+  } else if (OB_FAIL(init_group_store())) {
+    LOG_WARN("failed to init group store", K(ret));
+  } else if (OB_FAIL(sql_mem_processor_.update_used_mem_size(get_mem_used_size()))) {
+    LOG_WARN("failed to update used memory size", K(ret));
+  } else if (bypass_) {
+    if (OB_FAIL(load_bypass_data())) {
+      LOG_WARN("load bypass data failed", K(ret));
+    }
+  } else if (OB_FAIL(load_data())) {
+    LOG_WARN("load data failed", K(ret));
+  }
+  return ret;
+}
+
 int ObHashGroupByOp::init_group_row_item(const ObGroupRowItem& curr_item, ObGroupRowItem*& gr_row_item)
 {
   int ret = common::OB_SUCCESS;
@@ -27,7 +27,7 @@ class ObHashGroupBySpec : public ObGroupBySpec {
 
 public:
   ObHashGroupBySpec(common::ObIAllocator& alloc, const ObPhyOperatorType type)
-      : ObGroupBySpec(alloc, type), group_exprs_(alloc), cmp_funcs_(alloc), est_group_cnt_(0)
+      : ObGroupBySpec(alloc, type), group_exprs_(alloc), cmp_funcs_(alloc), est_group_cnt_(0), bypass_enabled_(false)
   {}
 
   DECLARE_VIRTUAL_TO_STRING;
@@ -40,6 +40,10 @@ public:
   {
     est_group_cnt_ = cnt;
   }
+  inline void set_bypass_enabled(const bool bypass_enabled)
+  {
+    bypass_enabled_ = bypass_enabled;
+  }
 
 private:
   // disallow copy
@@ -49,6 +53,8 @@ public:
   ExprFixedArray group_exprs_;  // group by column
   ObCmpFuncs cmp_funcs_;
   int64_t est_group_cnt_;
+  // first stage of two stage aggregation, groups can be emitted partially
+  bool bypass_enabled_;
 };
 
 // input rows is already sorted by groupby columns
@@ -73,6 +79,11 @@ public:
   static constexpr const double MAX_PART_MEM_RATIO = 0.5;
   static constexpr const double EXTRA_MEM_RATIO = 0.25;
   static const int64_t FIX_SIZE_PER_PART = sizeof(DatumStoreLinkPartition) + ObChunkRowStore::BLOCK_SIZE;
+  // The pushed down group by passes rows through when more than BYPASS_GROUP_PERCENT percent
+  // of the rows are new groups, which is checked every BYPASS_CHECK_ROWS rows.
+  static const int64_t BYPASS_CHECK_ROWS = 1 << 14;  // 16384
+  static const int64_t BYPASS_GROUP_PERCENT = 80;
+  static const int64_t BYPASS_BATCH_ROWS = 1 << 10;  // 1024
 
 public:
   ObHashGroupByOp(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOpInput* input)
@@ -84,7 +95,11 @@ public:
         agged_dumped_cnt_(0),
         profile_(ObSqlWorkAreaType::HASH_WORK_AREA),
         sql_mem_processor_(profile_),
-        iter_end_(false)
+        iter_end_(false),
+        bypass_enabled_(false),
+        bypass_(false),
+        input_remain_(false),
+        bypass_group_cnt_(0)
   {}
   void reset();
   virtual int inner_open() override;
@@ -92,8 +107,13 @@ public:
   virtual int rescan() override;
   virtual int switch_iterator() override;
   virtual int inner_get_next_row() override;
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
   virtual void destroy() override;
   int load_data();
+  // Pass rows of the pushed down group by through, each row is a group.
+  int load_bypass_data();
+  // Clear the groups emitted and continue loading the input.
+  int load_remain_data();
 
   int check_same_group(int64_t& diff_pos);
   int restore_groupby_datum(const int64_t diff_pos);
@@ -146,7 +166,7 @@ public:
   }
   OB_INLINE int64_t estimate_hash_bucket_size(const int64_t bucket_cnt) const
   {
-    return next_pow2(ObGroupRowHashTable::SIZE_BUCKET_SCALE * bucket_cnt) * sizeof(void*);
+    return next_pow2(ObGroupRowHashTable::SIZE_BUCKET_SCALE * bucket_cnt) * ObGroupRowHashTable::BUCKET_SIZE;
   }
   OB_INLINE int64_t estimate_hash_bucket_cnt_by_mem_size(
       const int64_t bucket_cnt, const int64_t max_mem_size, const double extra_ratio) const
@@ -158,9 +178,17 @@ public:
         mem_size >>= 1;
       }
     }
-    return (mem_size / sizeof(void*) / ObGroupRowHashTable::SIZE_BUCKET_SCALE);
+    return (mem_size / ObGroupRowHashTable::BUCKET_SIZE / ObGroupRowHashTable::SIZE_BUCKET_SCALE);
   }
   int init_group_store();
+  OB_INLINE int64_t get_output_group_cnt() const
+  {
+    return local_group_rows_.size() + bypass_group_cnt_;
+  }
+  OB_INLINE bool need_bypass() const
+  {
+    return agged_row_cnt_ >= BYPASS_CHECK_ROWS && agged_group_cnt_ * 100 >= agged_row_cnt_ * BYPASS_GROUP_PERCENT;
+  }
   int update_mem_status_periodically(
       const int64_t nth_cnt, const int64_t input_row, int64_t& est_part_cnt, bool& need_dump);
   int64_t detect_part_cnt(const int64_t rows) const;
@@ -198,6 +226,13 @@ private:
   ObSqlWorkAreaProfile profile_;
   ObSqlMemMgrProcessor sql_mem_processor_;
   bool iter_end_;
+  // The pushed down group by emits groups in memory instead of dumping them, and passes
+  // rows through when local aggregation doesn't reduce rows.
+  bool bypass_enabled_;
+  bool bypass_;
+  // input rows are not loaded completely
+  bool input_remain_;
+  int64_t bypass_group_cnt_;
 };
 
 }  // end namespace sql
@@ -130,5 +130,68 @@ int ObScalarAggregateOp::inner_get_next_row()
   return ret;
 }
 
+int ObScalarAggregateOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  UNUSED(max_row_cnt);
+  if (started_) {
+    brs_.size_ = 0;
+    brs_.end_ = true;
+  } else {
+    started_ = true;
+    bool prepared = false;
+    const ObBatchRows* child_brs = NULL;
+    ObAggregateProcessor::GroupRow* group_row = NULL;
+    if (OB_FAIL(aggr_processor_.get_group_row(0, group_row))) {
+      LOG_WARN("failed to get_group_row", K(ret));
+    } else if (OB_ISNULL(group_row)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("group_row is null", K(ret));
+    }
+    while (OB_SUCC(ret) && (NULL == child_brs || !child_brs->end_)) {
+      if (OB_FAIL(child_->get_next_batch(MY_SPEC.max_batch_size_, child_brs))) {
+        LOG_WARN("get child next batch failed", K(ret));
+      } else if (OB_FAIL(try_check_status())) {
+        LOG_WARN("check status failed", K(ret));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < child_brs->size_; i++) {
+        if (child_brs->skip_->at(i)) {
+          continue;
+        }
+        eval_ctx_.set_batch_idx(i);
+        clear_evaluated_flag();
+        if (!prepared) {
+          if (OB_FAIL(aggr_processor_.prepare(*group_row))) {
+            LOG_WARN("fail to prepare the aggr func", K(ret));
+          } else {
+            prepared = true;
+          }
+        } else if (OB_FAIL(aggr_processor_.process(*group_row))) {
+          LOG_WARN("fail to process the aggr func", K(ret));
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      // one row result in the first row of batch
+      eval_ctx_.set_batch_idx(0);
+      clear_evaluated_flag();
+      if (!prepared) {
+        if (OB_FAIL(aggr_processor_.collect_for_empty_set())) {
+          LOG_WARN("fail to collect for empty set", K(ret));
+        }
+      } else if (OB_FAIL(aggr_processor_.collect())) {
+        LOG_WARN("fail to collect result", K(ret));
+      }
+      if (OB_FAIL(ret)) {
+      } else if (OB_FAIL(filter_and_project_batch(1))) {
+        LOG_WARN("filter and project batch failed", K(ret));
+      } else {
+        brs_.end_ = true;
+      }
+    }
+  }
+  return ret;
+}
+
 }  // end namespace sql
 }  // end namespace oceanbase
@@ -20,6 +20,7 @@
 #include "sql/engine/basic/ob_chunk_datum_store.h"
 #include "sql/engine/ob_sql_mem_mgr_processor.h"
 #include "sql/engine/expr/ob_expr.h"
+#include "sql/engine/aggregate/ob_exec_hash_struct.h"
 
 namespace oceanbase {
 namespace sql {
@@ -72,14 +73,16 @@ template <typename Item>
 class ObHashPartitionExtendHashTable {
 public:
   const static int64_t INITIAL_SIZE = 128;
-  const static int64_t SIZE_BUCKET_PERCENT = 80;
+  const static int64_t SIZE_BUCKET_PERCENT = 50;
+  // open addressing buckets can not be overfilled, extend regardless of max bucket num and memory bound beyond it
+  const static int64_t MAX_FILL_PERCENT = 75;
   const static int64_t MAX_MEM_PERCENT = 40;
   ObHashPartitionExtendHashTable()
       : size_(0),
         bucket_num_(0),
         min_bucket_num_(INITIAL_SIZE),
         max_bucket_num_(INT64_MAX),
-        buckets_(nullptr),
+        buckets_(),
         allocator_(nullptr),
         hash_funcs_(nullptr),
         sort_collations_(nullptr),
@@ -97,7 +100,7 @@ public:
   // return the first item which equal to, NULL for none exist.
   int get(const Item& item, const Item*& res) const;
   int get(uint64_t hash_value, const ObTempHashPartCols& part_cols, const Item*& res) const;
-  // Link item to hash table, extend buckets if needed.
+  // Add item to hash table, extend buckets if needed.
   // (Do not check item is exist or not)
   int set(Item& item);
   int64_t size() const
@@ -107,9 +110,7 @@ public:
 
   void reuse()
   {
-    if (OB_NOT_NULL(buckets_)) {
-      buckets_->set_all(nullptr);
-    }
+    buckets_.reuse();
     size_ = 0;
   }
 
@@ -117,15 +118,7 @@ public:
 
   void destroy()
   {
-    if (OB_NOT_NULL(buckets_)) {
-      buckets_->destroy();
-      if (nullptr != allocator_) {
-        allocator_->free(buckets_);
-      } else {
-        SQL_ENG_LOG(ERROR, "buckets is not null", KP(buckets_));
-      }
-      buckets_ = nullptr;
-    }
+    buckets_.destroy();
     if (OB_NOT_NULL(allocator_)) {
       ob_delete(allocator_);
       allocator_ = nullptr;
@@ -134,33 +127,18 @@ public:
   }
   int64_t mem_used() const
   {
-    return nullptr == buckets_ ? 0 : buckets_->mem_used();
+    return buckets_.mem_used();
   }
 
   template <typename CB>
   int foreach (CB& cb) const
   {
-    int ret = common::OB_SUCCESS;
-    if (OB_ISNULL(buckets_)) {
-      ret = OB_INVALID_ARGUMENT;
-      SQL_ENG_LOG(WARN, "invalid null buckets", K(ret), K(buckets_));
-    }
-    for (int64_t i = 0; OB_SUCC(ret) && i < get_bucket_num(); i++) {
-      Item* item = buckets_->at(i);
-      while (NULL != item && OB_SUCC(ret)) {
-        if (OB_FAIL(cb(*item))) {
-          SQL_ENG_LOG(WARN, "call back failed", K(ret));
-        } else {
-          item = item->next();
-        }
-      }
-    }
-    return ret;
+    return buckets_.foreach(cb);
   }
 
   inline int64_t get_bucket_num() const
   {
-    return NULL == buckets_ ? 0 : buckets_->count();
+    return buckets_.count();
   }
 
   void set_funcs(const common::ObIArray<ObHashFunc>* hash_funcs,
@@ -179,18 +157,17 @@ public:
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObHashPartitionExtendHashTable);
-  using BucketArray = common::ObSegmentArray<Item*, OB_MALLOC_BIG_BLOCK_SIZE, common::ModulePageAllocator>;
+  const static int64_t BUCKET_SIZE = sizeof(typename ObLinearProbeBuckets<Item>::Bucket);
   int extend(const int64_t new_bucket_num);
   static int64_t estimate_bucket_num(
       const int64_t bucket_num, const int64_t max_hash_mem, const int64_t min_bucket, const int64_t max_bucket);
-  int create_bucket_array(const int64_t bucket_num, BucketArray*& new_buckets);
 
 private:
   int64_t size_;
   int64_t bucket_num_;
   int64_t min_bucket_num_;
   int64_t max_bucket_num_;
-  BucketArray* buckets_;
+  ObLinearProbeBuckets<Item> buckets_;
   common::ModulePageAllocator* allocator_;
   const common::ObIArray<ObHashFunc>* hash_funcs_;
   const common::ObIArray<ObSortFieldCollation>* sort_collations_;
@@ -1702,8 +1679,8 @@ int ObHashPartitionExtendHashTable<Item>::init(common::ObIAllocator* allocator,
       ret = OB_ALLOCATE_MEMORY_FAILED;
       SQL_ENG_LOG(WARN, "failed to allocate memory", K(ret));
     } else if (FALSE_IT(allocator_->set_allocator(allocator))) {
-    } else if (OB_FAIL(create_bucket_array(est_bucket_num, buckets_))) {
-      SQL_ENG_LOG(WARN, "failed to create bucket array", K(ret), K(est_bucket_num));
+    } else if (OB_FAIL(buckets_.init(*allocator_, common::next_pow2(est_bucket_num)))) {
+      SQL_ENG_LOG(WARN, "failed to init buckets", K(ret), K(est_bucket_num));
     } else {
       size_ = 0;
     }
@@ -1721,10 +1698,10 @@ int64_t ObHashPartitionExtendHashTable<Item>::estimate_bucket_num(
 {
   int64_t max_bound_size = std::max(0l, max_hash_mem * MAX_MEM_PERCENT / 100);
   int64_t est_bucket_num = common::next_pow2(bucket_num);
-  int64_t est_size = est_bucket_num * sizeof(void *);
+  int64_t est_size = est_bucket_num * BUCKET_SIZE;
   while (est_size > max_bound_size && est_bucket_num > 0) {
     est_bucket_num >>= 1;
-    est_size = est_bucket_num * sizeof(void*);
+    est_size = est_bucket_num * BUCKET_SIZE;
   }
   if (est_bucket_num < INITIAL_SIZE) {
     est_bucket_num = INITIAL_SIZE;
@@ -1738,31 +1715,6 @@ int64_t ObHashPartitionExtendHashTable<Item>::estimate_bucket_num(
   return est_bucket_num;
 }
 
-template <typename Item>
-int ObHashPartitionExtendHashTable<Item>::create_bucket_array(const int64_t bucket_num, BucketArray*& new_buckets)
-{
-  int ret = OB_SUCCESS;
-  void* buckets_buf = NULL;
-  int64_t tmp_bucket_num = common::next_pow2(bucket_num);
-  new_buckets = nullptr;
-  if (OB_ISNULL(allocator_)) {
-    ret = OB_ERR_UNEXPECTED;
-    SQL_ENG_LOG(WARN, "allocator is null", K(ret));
-  } else if (OB_ISNULL(buckets_buf = allocator_->alloc(sizeof(BucketArray)))) {
-    ret = OB_ALLOCATE_MEMORY_FAILED;
-    SQL_ENG_LOG(WARN, "failed to allocate memory", K(ret));
-  } else {
-    new_buckets = new (buckets_buf) BucketArray(*allocator_);
-    if (OB_FAIL(new_buckets->init(tmp_bucket_num))) {
-      new_buckets->reset();
-      allocator_->free(new_buckets);
-      new_buckets = nullptr;
-      SQL_ENG_LOG(WARN, "resize bucket array failed", K(ret), K(tmp_bucket_num));
-    }
-  }
-  return ret;
-}
-
 template <typename Item>
 int ObHashPartitionExtendHashTable<Item>::resize(
     common::ObIAllocator* allocator, int64_t bucket_num, ObSqlMemMgrProcessor* sql_mem_processor)
@@ -1790,25 +1742,14 @@ int ObHashPartitionExtendHashTable<Item>::get(
     uint64_t hash_value, const ObTempHashPartCols& part_cols, const Item*& item) const
 {
   int ret = OB_SUCCESS;
-  item = NULL;
-  if (NULL == buckets_) {
-    // do nothing
-  } else {
-    common::hash::hash_func<Item> hf;
+  auto eqf = [&](const Item& other) {
     bool equal_res = false;
-    Item* bucket = buckets_->at(hash_value & (get_bucket_num() - 1));
-    while (NULL != bucket) {
-      if (hash_value == hf(*bucket)) {
-        if (OB_FAIL(bucket->equal_temp(part_cols, sort_collations_, cmp_funcs_, eval_ctx_, equal_res))) {
-          SQL_ENG_LOG(WARN, "compare info is null", K(ret));
-        } else if (equal_res) {
-          item = bucket;
-          break;
-        }
-      }
-      bucket = bucket->next();
+    if (OB_SUCC(ret) && OB_FAIL(other.equal_temp(part_cols, sort_collations_, cmp_funcs_, eval_ctx_, equal_res))) {
+      SQL_ENG_LOG(WARN, "compare info is null", K(ret));
     }
-  }
+    return equal_res;
+  };
+  item = buckets_.get(hash_value, eqf);
   return ret;
 }
 
@@ -1816,21 +1757,9 @@ template <typename Item>
 int ObHashPartitionExtendHashTable<Item>::get(const Item& item, const Item*& res) const
 {
   int ret = OB_SUCCESS;
-  res = NULL;
-  if (NULL == buckets_) {
-    // do nothing
-  } else {
-    common::hash::hash_func<Item> hf;
-    const uint64_t hash_val = hf(item);
-    Item* bucket = buckets_->at(hash_val & (get_bucket_num() - 1));
-    while (NULL != bucket) {
-      if (hash_val == hf(*bucket) && bucket->equal(item, sort_collations_, cmp_funcs_)) {
-        res = bucket;
-        break;
-      }
-      bucket = bucket->next();
-    }
-  }
+  common::hash::hash_func<Item> hf;
+  auto eqf = [&](const Item& other) { return other.equal(item, sort_collations_, cmp_funcs_); };
+  res = buckets_.get(hf(item), eqf);
   return ret;
 }
 
@@ -1839,25 +1768,21 @@ int ObHashPartitionExtendHashTable<Item>::set(Item& item)
 {
   int ret = common::OB_SUCCESS;
   common::hash::hash_func<Item> hf;
-  if (size_ >= get_bucket_num() * SIZE_BUCKET_PERCENT) {
+  if (size_ * 100 >= get_bucket_num() * SIZE_BUCKET_PERCENT) {
     int64_t extend_bucket_num = estimate_bucket_num(
         get_bucket_num() * 2, sql_mem_processor_->get_mem_bound(), min_bucket_num_, max_bucket_num_);
-    if (extend_bucket_num <= get_bucket_num()) {
+    if (extend_bucket_num <= get_bucket_num() && size_ * 100 < get_bucket_num() * MAX_FILL_PERCENT) {
     } else if (OB_FAIL(extend(get_bucket_num() * 2))) {
       SQL_ENG_LOG(WARN, "extend failed", K(ret));
     }
   }
   if (OB_FAIL(ret)) {
-  } else if (OB_ISNULL(buckets_)) {
-    ret = OB_INVALID_ARGUMENT;
-    SQL_ENG_LOG(WARN, "invalid argument", K(ret), K(buckets_));
   } else if (OB_ISNULL(item.store_row_)) {
     ret = OB_ERR_UNEXPECTED;
     SQL_ENG_LOG(WARN, "unexpected status: store_row is null", K(ret));
+  } else if (OB_FAIL(buckets_.insert(hf(item), item))) {
+    SQL_ENG_LOG(WARN, "failed to insert item", K(ret), K(size_));
   } else {
-    Item*& bucket = buckets_->at(hf(item) & (get_bucket_num() - 1));
-    item.next() = bucket;
-    bucket = &item;
     size_ += 1;
   }
   return ret;
@@ -1867,33 +1792,8 @@ template <typename Item>
 int ObHashPartitionExtendHashTable<Item>::extend(const int64_t new_bucket_num)
 {
   int ret = common::OB_SUCCESS;
-  common::hash::hash_func<Item> hf;
-  BucketArray* new_buckets = NULL;
-  if (OB_FAIL(ret)) {
-  } else if (OB_ISNULL(buckets_)) {
-    ret = OB_INVALID_ARGUMENT;
-    SQL_ENG_LOG(WARN, "invalid argument", K(ret), K(buckets_));
-  } else if (OB_FAIL(create_bucket_array(new_bucket_num, new_buckets))) {
-    SQL_ENG_LOG(WARN, "failed to create bucket array", K(ret));
-  } else if (get_bucket_num() * 2 != new_buckets->count()) {
-    ret = OB_ERR_UNEXPECTED;
-    SQL_ENG_LOG(WARN, "unexpected extend", K(ret), K(new_bucket_num), K(get_bucket_num()));
-  } else {
-    // rehash
-    const int64_t tmp_new_bucket_num = new_buckets->count();
-    for (int64_t i = 0; i < get_bucket_num(); i++) {
-      Item* bucket = buckets_->at(i);
-      while (nullptr != bucket) {
-        Item* item = bucket;
-        bucket = bucket->next();
-        Item*& new_bucket = new_buckets->at(hf(*item) & (tmp_new_bucket_num - 1));
-        item->next() = new_bucket;
-        new_bucket = item;
-      }
-    }
-    buckets_->destroy();
-    allocator_->free(buckets_);
-    buckets_ = new_buckets;
+  if (OB_FAIL(buckets_.extend(common::next_pow2(new_bucket_num)))) {
+    SQL_ENG_LOG(WARN, "failed to extend buckets", K(ret), K(new_bucket_num), K(get_bucket_num()));
   }
   return ret;
 }
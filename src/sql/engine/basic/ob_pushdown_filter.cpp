@@ -41,7 +41,7 @@ OB_SERIALIZE_MEMBER(ObPushdownFilterNode, type_, n_child_, col_ids_);
 OB_SERIALIZE_MEMBER((ObPushdownAndFilterNode, ObPushdownFilterNode));
 OB_SERIALIZE_MEMBER((ObPushdownOrFilterNode, ObPushdownFilterNode));
 OB_SERIALIZE_MEMBER((ObPushdownBlackFilterNode, ObPushdownFilterNode), column_exprs_, filter_exprs_);
-OB_SERIALIZE_MEMBER((ObPushdownWhiteFilterNode, ObPushdownFilterNode));
+OB_SERIALIZE_MEMBER((ObPushdownWhiteFilterNode, ObPushdownFilterNode), op_type_, column_exprs_, param_exprs_);
 
 int ObPushdownBlackFilterNode::merge(ObIArray<ObPushdownFilterNode*>& merged_node)
 {
@@ -168,6 +168,172 @@ int ObPushdownFilterConstructor::deduplicate_filter_node(
   return ret;
 }
 
+bool ObPushdownFilterConstructor::is_white_param(const ObRawExpr* column_expr, const ObRawExpr* param_expr) const
+{
+  bool is_white = false;
+  if (OB_NOT_NULL(column_expr) && OB_NOT_NULL(param_expr) && param_expr->has_const_or_const_expr_flag() &&
+      !param_expr->has_flag(CNT_COLUMN) && !param_expr->has_flag(CNT_SUB_QUERY) &&
+      !param_expr->has_flag(CNT_RAND_FUNC) && !param_expr->has_flag(CNT_STATE_FUNC) &&
+      !param_expr->has_flag(CNT_SEQ_EXPR)) {
+    // storage compares the stored cell with the constant directly, so no implicit cast is allowed
+    const ObExprResType& column_type = column_expr->get_result_type();
+    const ObExprResType& param_type = param_expr->get_result_type();
+    is_white = column_type.get_type() == param_type.get_type() &&
+               (!column_type.is_string_type() || column_type.get_collation_type() == param_type.get_collation_type());
+  }
+  return is_white;
+}
+
+bool ObPushdownFilterConstructor::is_white_mode(ObRawExpr* raw_expr)
+{
+  bool is_white = false;
+  ObRawExpr* column_expr = nullptr;
+  if (OB_ISNULL(raw_expr) || lib::is_oracle_mode() || 2 != raw_expr->get_param_count()) {
+  } else {
+    switch (raw_expr->get_expr_type()) {
+      case T_OP_EQ:
+      case T_OP_LE:
+      case T_OP_LT:
+      case T_OP_GE:
+      case T_OP_GT:
+      case T_OP_NE: {
+        ObRawExpr* left = raw_expr->get_param_expr(0);
+        ObRawExpr* right = raw_expr->get_param_expr(1);
+        if (OB_NOT_NULL(left) && left->is_column_ref_expr()) {
+          column_expr = left;
+          is_white = is_white_param(left, right);
+        } else if (OB_NOT_NULL(right) && right->is_column_ref_expr()) {
+          column_expr = right;
+          is_white = is_white_param(right, left);
+        }
+        break;
+      }
+      case T_OP_IN: {
+        ObRawExpr* left = raw_expr->get_param_expr(0);
+        ObRawExpr* row = raw_expr->get_param_expr(1);
+        if (OB_NOT_NULL(left) && left->is_column_ref_expr() && OB_NOT_NULL(row) && T_OP_ROW == row->get_expr_type() &&
+            0 < row->get_param_count()) {
+          column_expr = left;
+          is_white = true;
+          for (int64_t i = 0; is_white && i < row->get_param_count(); ++i) {
+            is_white = is_white_param(left, row->get_param_expr(i));
+          }
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  if (is_white) {
+    switch (column_expr->get_result_type().get_type_class()) {
+      case ObIntTC:
+      case ObUIntTC:
+      case ObFloatTC:
+      case ObDoubleTC:
+      case ObNumberTC:
+      case ObDateTimeTC:
+      case ObDateTC:
+      case ObTimeTC:
+      case ObYearTC:
+      case ObStringTC:
+        // char is padded before filtering in PAD_CHAR_TO_FULL_LENGTH mode
+        is_white = !column_expr->get_result_type().is_fixed_len_char_type();
+        break;
+      default:
+        is_white = false;
+        break;
+    }
+  }
+  return is_white;
+}
+
+int ObPushdownFilterConstructor::create_white_filter_node(ObRawExpr* raw_expr, ObPushdownFilterNode*& filter_node)
+{
+  int ret = OB_SUCCESS;
+  ObRawExpr* column_expr = nullptr;
+  ObSEArray<ObRawExpr*, 4> param_exprs;
+  ObWhiteFilterOperatorType op_type = WHITE_OP_MAX;
+  ObPushdownWhiteFilterNode* white_filter_node = nullptr;
+  if (OB_ISNULL(raw_expr) || OB_UNLIKELY(2 != raw_expr->get_param_count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid raw expr", K(ret), KP(raw_expr));
+  } else if (T_OP_IN == raw_expr->get_expr_type()) {
+    ObRawExpr* row = raw_expr->get_param_expr(1);
+    op_type = WHITE_OP_IN;
+    column_expr = raw_expr->get_param_expr(0);
+    for (int64_t i = 0; OB_SUCC(ret) && i < row->get_param_count(); ++i) {
+      OZ(param_exprs.push_back(row->get_param_expr(i)));
+    }
+  } else {
+    // normalize to "column op param"
+    const bool column_at_left = raw_expr->get_param_expr(0)->is_column_ref_expr();
+    column_expr = raw_expr->get_param_expr(column_at_left ? 0 : 1);
+    OZ(param_exprs.push_back(raw_expr->get_param_expr(column_at_left ? 1 : 0)));
+    switch (raw_expr->get_expr_type()) {
+      case T_OP_EQ:
+        op_type = WHITE_OP_EQ;
+        break;
+      case T_OP_NE:
+        op_type = WHITE_OP_NE;
+        break;
+      case T_OP_LE:
+        op_type = column_at_left ? WHITE_OP_LE : WHITE_OP_GE;
+        break;
+      case T_OP_LT:
+        op_type = column_at_left ? WHITE_OP_LT : WHITE_OP_GT;
+        break;
+      case T_OP_GE:
+        op_type = column_at_left ? WHITE_OP_GE : WHITE_OP_LE;
+        break;
+      case T_OP_GT:
+        op_type = column_at_left ? WHITE_OP_GT : WHITE_OP_LT;
+        break;
+      default:
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected white filter expr type", K(ret), K(raw_expr->get_expr_type()));
+        break;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(factory_.alloc(PushdownFilterType::WHITE_FILTER, 0, filter_node))) {
+    LOG_WARN("failed t o alloc pushdown filter", K(ret));
+  } else if (OB_ISNULL(filter_node)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("white filter node is null", K(ret));
+  } else {
+    ObExpr* column_rt_expr = nullptr;
+    white_filter_node = static_cast<ObPushdownWhiteFilterNode*>(filter_node);
+    white_filter_node->op_type_ = op_type;
+    if (OB_FAIL(static_cg_.generate_rt_expr(*column_expr, column_rt_expr))) {
+      LOG_WARN("failed to generate rt expr", K(ret));
+    } else if (OB_FAIL(white_filter_node->col_ids_.init(1))) {
+      LOG_WARN("failed to init column ids", K(ret));
+    } else if (OB_FAIL(white_filter_node->col_ids_.push_back(
+                   static_cast<ObColumnRefRawExpr*>(column_expr)->get_column_id()))) {
+      LOG_WARN("failed to push back column id", K(ret));
+    } else if (OB_FAIL(white_filter_node->column_exprs_.init(1))) {
+      LOG_WARN("failed to init column exprs", K(ret));
+    } else if (OB_FAIL(white_filter_node->column_exprs_.push_back(column_rt_expr))) {
+      LOG_WARN("failed to push back column expr", K(ret));
+    } else if (OB_FAIL(white_filter_node->param_exprs_.init(param_exprs.count()))) {
+      LOG_WARN("failed to init param exprs", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < param_exprs.count(); ++i) {
+      ObExpr* param_rt_expr = nullptr;
+      if (OB_FAIL(static_cg_.generate_rt_expr(*param_exprs.at(i), param_rt_expr))) {
+        LOG_WARN("failed to generate rt expr", K(ret));
+      } else if (OB_FAIL(white_filter_node->param_exprs_.push_back(param_rt_expr))) {
+        LOG_WARN("failed to push back param expr", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      LOG_DEBUG("debug white_filter_node", K(*raw_expr), K(*white_filter_node));
+    }
+  }
+  return ret;
+}
+
 int ObPushdownFilterConstructor::apply(ObRawExpr* raw_expr, ObPushdownFilterNode*& filter_tree)
 {
   int ret = OB_SUCCESS;
@@ -183,12 +349,9 @@ int ObPushdownFilterConstructor::apply(ObRawExpr* raw_expr, ObPushdownFilterNode
     ret = OB_NOT_SUPPORTED;
     LOG_WARN("not supported", K(ret));
   } else if (is_white_mode(raw_expr)) {
-    // create white filter
-    // if (OB_FAIL(factory_.alloc(PushdownFilterType::WHITE, filter_node))) {
-    //   LOG_WARN("failed t o alloc pushdown filter", K(ret));
-    // }
-    ret = OB_NOT_SUPPORTED;
-    LOG_WARN("not supported", K(ret));
+    if (OB_FAIL(create_white_filter_node(raw_expr, filter_node))) {
+      LOG_WARN("failed t o alloc pushdown filter", K(ret));
+    }
   } else {
     if (OB_FAIL(create_black_filter_node(raw_expr, filter_node))) {
       LOG_WARN("failed t o alloc pushdown filter", K(ret));
@@ -674,10 +837,111 @@ int ObWhiteFilterExecutor::init_evaluated_datums(
     ObIAllocator& alloc, const ObIArray<ObExpr*>& calc_exprs, ObEvalCtx* eval_ctx)
 {
   int ret = OB_SUCCESS;
-  UNUSED(alloc);
-  UNUSED(calc_exprs);
-  UNUSED(eval_ctx);
-  ret = OB_NOT_SUPPORTED;
+  eval_ctx_ = eval_ctx;
+  ObArray<ObExpr*> eval_exprs;
+  ObPushdownWhiteFilterNode& node = static_cast<ObPushdownWhiteFilterNode&>(filter_);
+  if (OB_ISNULL(eval_ctx)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("eval ctx is null", K(ret));
+  } else if (OB_FAIL(find_evaluated_datums(node.param_exprs_, calc_exprs, eval_exprs))) {
+    LOG_WARN("failed to find evaluated datums", K(ret));
+  } else if (OB_FAIL(params_.init(node.param_exprs_.count()))) {
+    LOG_WARN("failed to init params", K(ret), K(node.param_exprs_.count()));
+  } else if (0 < eval_exprs.count()) {
+    eval_infos_ = reinterpret_cast<ObEvalInfo**>(alloc.alloc(eval_exprs.count() * sizeof(ObEvalInfo*)));
+    if (OB_ISNULL(eval_infos_)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to allocator memory", K(ret));
+    } else {
+      for (int64_t i = 0; i < eval_exprs.count() && OB_SUCC(ret); ++i) {
+        eval_infos_[i] = &eval_exprs.at(i)->get_eval_info(*eval_ctx_);
+      }
+      n_eval_infos_ = eval_exprs.count();
+    }
+  }
+  return ret;
+}
+
+int ObWhiteFilterExecutor::init_params()
+{
+  int ret = OB_SUCCESS;
+  ObPushdownWhiteFilterNode& node = static_cast<ObPushdownWhiteFilterNode&>(filter_);
+  if (OB_ISNULL(eval_ctx_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("eval ctx is null", K(ret));
+  } else {
+    for (int32_t i = 0; i < n_eval_infos_; i++) {
+      eval_infos_[i]->clear_evaluated_flag();
+    }
+    params_.reuse();
+    for (int64_t i = 0; OB_SUCC(ret) && i < node.param_exprs_.count(); ++i) {
+      ObExpr* expr = node.param_exprs_.at(i);
+      ObDatum* datum = nullptr;
+      ObObj param;
+      if (OB_FAIL(expr->eval(*eval_ctx_, datum))) {
+        LOG_WARN("failed to eval param expr", K(ret), K(i));
+      } else if (OB_FAIL(datum->to_obj(param, expr->obj_meta_))) {
+        LOG_WARN("failed to convert datum to obj", K(ret), K(i));
+      } else if (OB_FAIL(params_.push_back(param))) {
+        LOG_WARN("failed to push back param", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObWhiteFilterExecutor::filter(const ObObj& obj, bool& filtered) const
+{
+  int ret = OB_SUCCESS;
+  const ObWhiteFilterOperatorType op_type = get_op_type();
+  filtered = true;
+  if (OB_UNLIKELY(params_.count() <= 0 || (WHITE_OP_IN != op_type && 1 != params_.count()))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected white filter params", K(ret), K(op_type), K_(params));
+  } else if (obj.is_null()) {
+    // null never satisfies a comparison
+  } else if (WHITE_OP_IN == op_type) {
+    for (int64_t i = 0; OB_SUCC(ret) && filtered && i < params_.count(); ++i) {
+      int cmp = 0;
+      if (params_.at(i).is_null()) {
+      } else if (OB_FAIL(obj.compare(params_.at(i), obj.get_collation_type(), cmp))) {
+        LOG_WARN("failed to compare obj", K(ret), K(obj), K(params_.at(i)));
+      } else if (0 == cmp) {
+        filtered = false;
+      }
+    }
+  } else if (params_.at(0).is_null()) {
+  } else {
+    int cmp = 0;
+    if (OB_FAIL(obj.compare(params_.at(0), obj.get_collation_type(), cmp))) {
+      LOG_WARN("failed to compare obj", K(ret), K(obj), K(params_.at(0)));
+    } else {
+      switch (op_type) {
+        case WHITE_OP_EQ:
+          filtered = 0 != cmp;
+          break;
+        case WHITE_OP_LE:
+          filtered = cmp > 0;
+          break;
+        case WHITE_OP_LT:
+          filtered = cmp >= 0;
+          break;
+        case WHITE_OP_GE:
+          filtered = cmp < 0;
+          break;
+        case WHITE_OP_GT:
+          filtered = cmp <= 0;
+          break;
+        case WHITE_OP_NE:
+          filtered = 0 == cmp;
+          break;
+        default:
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("unexpected white filter op type", K(ret), K(op_type));
+          break;
+      }
+    }
+  }
   return ret;
 }
 
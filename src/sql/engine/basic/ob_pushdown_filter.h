@@ -44,6 +44,18 @@ enum FilterExecutorType {
   MAX_EXECUTOR_TYPE
 };
 
+// comparison applied by a white filter between one column and constant operands
+enum ObWhiteFilterOperatorType {
+  WHITE_OP_EQ = 0,
+  WHITE_OP_LE,
+  WHITE_OP_LT,
+  WHITE_OP_GE,
+  WHITE_OP_GT,
+  WHITE_OP_NE,
+  WHITE_OP_IN,
+  WHITE_OP_MAX
+};
+
 class ObPushdownFilterUtils {
 public:
   static bool is_pushdown_storage(int32_t pd_storage_flag)
@@ -136,10 +148,17 @@ class ObPushdownWhiteFilterNode : public ObPushdownFilterNode {
   OB_UNIS_VERSION_V(1);
 
 public:
-  ObPushdownWhiteFilterNode(common::ObIAllocator& alloc) : ObPushdownFilterNode(alloc)
+  ObPushdownWhiteFilterNode(common::ObIAllocator& alloc)
+      : ObPushdownFilterNode(alloc), op_type_(WHITE_OP_MAX), column_exprs_(alloc), param_exprs_(alloc)
   {}
   ~ObPushdownWhiteFilterNode()
   {}
+  INHERIT_TO_STRING_KV("ObPushdownFilterNode", ObPushdownFilterNode, K_(op_type), K_(column_exprs), K_(param_exprs));
+
+public:
+  ObWhiteFilterOperatorType op_type_;
+  ExprFixedArray column_exprs_;  // exactly one column
+  ExprFixedArray param_exprs_;   // constant operands, more than one only for WHITE_OP_IN
 };
 
 class ObPushdownFilterExecutor;
@@ -184,16 +203,14 @@ private:
       common::ObIArray<ObPushdownFilterNode*>& merged_node, bool& merged);
   int deduplicate_filter_node(common::ObIArray<ObPushdownFilterNode*>& filter_nodes, uint32_t& n_node);
   int create_black_filter_node(ObRawExpr* raw_expr, ObPushdownFilterNode*& filter_tree);
+  int create_white_filter_node(ObRawExpr* raw_expr, ObPushdownFilterNode*& filter_tree);
   bool can_split_or(ObRawExpr* raw_expr)
   {
     UNUSED(raw_expr);
     return false;
   }
-  bool is_white_mode(ObRawExpr* raw_expr)
-  {
-    UNUSED(raw_expr);
-    return false;
-  }
+  bool is_white_mode(ObRawExpr* raw_expr);
+  bool is_white_param(const ObRawExpr* column_expr, const ObRawExpr* param_expr) const;
 
 private:
   common::ObIAllocator* alloc_;
@@ -429,7 +446,11 @@ OB_INLINE void ObBlackFilterExecutor::clear_evaluated_datums()
 class ObWhiteFilterExecutor : public ObPushdownFilterExecutor {
 public:
   ObWhiteFilterExecutor(common::ObIAllocator& alloc, ObPushdownWhiteFilterNode& filter)
-      : ObPushdownFilterExecutor(alloc, filter)
+      : ObPushdownFilterExecutor(alloc, filter),
+        params_(alloc),
+        n_eval_infos_(0),
+        eval_infos_(nullptr),
+        eval_ctx_(nullptr)
   {}
   ~ObWhiteFilterExecutor()
   {}
@@ -437,9 +458,27 @@ public:
   virtual int filter(bool& filtered) override;
   virtual int init_evaluated_datums(
       common::ObIAllocator& alloc, const common::ObIArray<ObExpr*>& calc_exprs, ObEvalCtx* eval_ctx) override;
-  INHERIT_TO_STRING_KV("ObPushdownFilterExecutor", ObPushdownFilterExecutor, K_(filter));
+  // evaluate the constant operands, must be called before filtering a new micro block
+  // since exec params may change between rescans.
+  int init_params();
+  // filter a single cell of the filter column read by storage, %filtered is true when
+  // the comparison is false or null.
+  int filter(const common::ObObj& obj, bool& filtered) const;
+  OB_INLINE ObWhiteFilterOperatorType get_op_type() const
+  {
+    return static_cast<const ObPushdownWhiteFilterNode&>(filter_).op_type_;
+  }
+  OB_INLINE const common::ObIArray<common::ObObj>& get_params() const
+  {
+    return params_;
+  }
+  INHERIT_TO_STRING_KV("ObPushdownFilterExecutor", ObPushdownFilterExecutor, K_(filter), K_(params));
 
 private:
+  common::ObFixedArray<common::ObObj, common::ObIAllocator> params_;
+  int32_t n_eval_infos_;
+  ObEvalInfo** eval_infos_;
+  ObEvalCtx* eval_ctx_;
 };
 
 class ObAndFilterExecutor : public ObPushdownFilterExecutor {
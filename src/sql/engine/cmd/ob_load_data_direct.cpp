@@ -0,0 +1,755 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/cmd/ob_load_data_direct.h"
+
+#include "lib/charset/ob_charset.h"
+#include "share/object/ob_obj_cast.h"
+#include "share/schema/ob_multi_version_schema_service.h"
+#include "share/schema/ob_schema_getter_guard.h"
+#include "share/schema/ob_schema_struct.h"
+#include "observer/ob_server_struct.h"
+#include "observer/omt/ob_tenant_timezone_mgr.h"
+#include "storage/ob_partition_service.h"
+#include "sql/engine/cmd/ob_load_data_utils.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace share;
+using namespace share::schema;
+using namespace storage;
+
+namespace sql {
+
+int ObLoadDataDirectCtx::SortedRowIterator::get_next_row(ObNewRow*& row)
+{
+  int ret = OB_SUCCESS;
+  const ObStoreRow* store_row = NULL;
+  if (OB_FAIL(sorter_.get_next_item(store_row))) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("fail to get next sorted row", K(ret));
+    }
+  } else if (OB_ISNULL(store_row)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("sorted row is null", K(ret));
+  } else {
+    row = const_cast<ObNewRow*>(&store_row->row_val_);
+  }
+  return ret;
+}
+
+ObLoadDataDirectCtx::ObLoadDataDirectCtx()
+    : is_inited_(false),
+      tenant_id_(OB_INVALID_TENANT_ID),
+      table_schema_version_(OB_INVALID_VERSION),
+      rowkey_cnt_(0),
+      task_column_cnt_(0),
+      allocator_(ObModIds::OB_SQL_LOAD_DATA),
+      comp_ret_(OB_SUCCESS),
+      comparer_(comp_ret_, sort_column_indexes_),
+      row_count_(0),
+      err_ret_(OB_SUCCESS),
+      is_finished_(false),
+      last_active_ts_(0),
+      ref_cnt_(0)
+{}
+
+ObLoadDataDirectCtx::~ObLoadDataDirectCtx()
+{
+  sorter_.clean_up();
+}
+
+int ObLoadDataDirectCtx::init(const ObInsertTask& task)
+{
+  int ret = OB_SUCCESS;
+  ObSchemaGetterGuard schema_guard;
+  const ObTableSchema* table_schema = NULL;
+  const uint64_t table_id = task.direct_key_.pkey_.get_table_id();
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_UNLIKELY(!task.is_direct_load_ || !task.direct_key_.is_valid() ||
+                         task.column_ids_.count() != task.column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid insert task", K(ret), K(task));
+  } else if (OB_ISNULL(GCTX.schema_service_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("schema service is null", K(ret));
+  } else if (OB_FAIL(GCTX.schema_service_->get_tenant_schema_guard(task.tenant_id_, schema_guard))) {
+    LOG_WARN("fail to get schema guard", K(ret), K(task.tenant_id_));
+  } else if (OB_FAIL(schema_guard.get_table_schema(table_id, table_schema))) {
+    LOG_WARN("fail to get table schema", K(ret), K(table_id));
+  } else if (OB_ISNULL(table_schema)) {
+    ret = OB_TABLE_NOT_EXIST;
+    LOG_WARN("table not exist", K(ret), K(table_id));
+  } else if (table_schema->get_schema_version() != task.table_schema_version_) {
+    ret = OB_SCHEMA_EAGAIN;
+    LOG_WARN("table schema changed", K(ret), K(task.table_schema_version_), K(table_schema->get_schema_version()));
+  } else if (OB_FAIL(init_columns(*table_schema, task))) {
+    LOG_WARN("fail to init columns", K(ret), K(task));
+  } else if (OB_FAIL(tz_info_wrap_.deep_copy(task.tz_info_wrap_))) {
+    LOG_WARN("fail to copy time zone info", K(ret));
+  } else if (OB_FAIL(OTTZ_MGR.get_tenant_tz(task.tenant_id_, tz_map_wrap_))) {
+    LOG_WARN("fail to get tenant time zone map", K(ret), K(task.tenant_id_));
+  } else if (FALSE_IT(tz_info_wrap_.set_tz_info_map(tz_map_wrap_.get_tz_map()))) {
+  } else if (OB_FAIL(sorter_.init(SORT_MEMORY_LIMIT,
+                 ObExternalSortConstant::DEFAULT_FILE_READ_WRITE_BUFFER,
+                 0 /*no expire*/,
+                 task.tenant_id_,
+                 &comparer_))) {
+    LOG_WARN("fail to init external sort", K(ret));
+  } else {
+    key_ = task.direct_key_;
+    tenant_id_ = task.tenant_id_;
+    table_schema_version_ = task.table_schema_version_;
+    task_column_cnt_ = task.column_count_;
+    last_active_ts_ = ObTimeUtility::current_time();
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObLoadDataDirectCtx::init_columns(const ObTableSchema& table_schema, const ObInsertTask& task)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObColDesc, EXPECTED_INSERT_COLUMN_NUM> col_descs;
+  int64_t used_value_cnt = 0;
+  rowkey_cnt_ = table_schema.get_rowkey_column_num();
+  if (OB_FAIL(table_schema.get_store_column_ids(col_descs))) {
+    LOG_WARN("fail to get store column ids", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < rowkey_cnt_; ++i) {
+    if (OB_FAIL(sort_column_indexes_.push_back(i))) {
+      LOG_WARN("fail to push back", K(ret));
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < col_descs.count(); ++i) {
+    const uint64_t column_id = col_descs.at(i).col_id_;
+    const ObColumnSchemaV2* column_schema = NULL;
+    ColumnDesc column;
+    if (OB_ISNULL(column_schema = table_schema.get_column_schema(column_id))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("column not exist", K(ret), K(column_id));
+    } else {
+      column.meta_ = column_schema->get_meta_type();
+      column.accuracy_ = column_schema->get_accuracy();
+      column.is_nullable_ = column_schema->is_nullable();
+      for (int64_t j = 0; j < task.column_ids_.count(); ++j) {
+        if (task.column_ids_.at(j) == column_id) {
+          column.value_idx_ = j;
+          ++used_value_cnt;
+          break;
+        }
+      }
+      if (OB_INVALID_INDEX != column.value_idx_) {
+        // value from file
+      } else if (IS_DEFAULT_NOW_OBJ(column_schema->get_cur_default_value())) {
+        ret = OB_NOT_SUPPORTED;
+        LOG_WARN("current timestamp default is not supported in direct load", K(ret), K(column_id));
+      } else if (column_schema->get_cur_default_value().is_null()) {
+        if (!column.is_nullable_) {
+          ret = OB_ERR_NO_DEFAULT_FOR_FIELD;
+          LOG_WARN("column has no default value", K(ret), K(column_id));
+        } else {
+          column.default_value_.set_null();
+        }
+      } else if (OB_FAIL(cast_value(column, column_schema->get_cur_default_value(), allocator_, column.default_value_))) {
+        LOG_WARN("fail to cast default value", K(ret), K(column_id));
+      } else if (OB_FAIL(ob_write_obj(allocator_, column.default_value_, column.default_value_))) {
+        LOG_WARN("fail to copy default value", K(ret), K(column_id));
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(columns_.push_back(column))) {
+      LOG_WARN("fail to push back", K(ret));
+    }
+  }
+  if (OB_SUCC(ret) && used_value_cnt != task.column_ids_.count()) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("some columns are not stored", K(ret), K(used_value_cnt), K(task.column_ids_));
+  }
+  return ret;
+}
+
+int ObLoadDataDirectCtx::cast_value(
+    const ColumnDesc& column, const ObObj& in, ObIAllocator& allocator, ObObj& out) const
+{
+  int ret = OB_SUCCESS;
+  const ObCollationType cs_type = column.meta_.get_collation_type();
+  const ObDataTypeCastParams dtc_params(tz_info_wrap_.get_time_zone_info());
+  ObCastCtx cast_ctx(&allocator, &dtc_params, CM_NONE, cs_type);
+  ObObj tmp_obj;
+  ObObj buf_obj;
+  const ObObj* res_obj = NULL;
+  if (OB_FAIL(ObObjCaster::to_type(column.meta_.get_type(), cs_type, cast_ctx, in, tmp_obj))) {
+    LOG_WARN("fail to cast value", K(ret), K(in), K(column));
+  } else if (OB_FAIL(obj_accuracy_check(cast_ctx, column.accuracy_, cs_type, tmp_obj, buf_obj, res_obj))) {
+    LOG_WARN("fail to check accuracy", K(ret), K(tmp_obj), K(column));
+  } else if (OB_ISNULL(res_obj)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("accuracy check result is null", K(ret));
+  } else {
+    out = *res_obj;
+  }
+  return ret;
+}
+
+// same as row reshape of ObPartitionStorage before rows go into memtable
+int ObLoadDataDirectCtx::reshape_cell(const ColumnDesc& column, ObIAllocator& allocator, ObObj& cell) const
+{
+  int ret = OB_SUCCESS;
+  if (cell.is_binary()) {
+    const int32_t len = cell.get_string_len();
+    const int32_t binary_len = column.accuracy_.get_length();
+    char* buf = NULL;
+    if (binary_len > len) {
+      if (OB_ISNULL(buf = static_cast<char*>(allocator.alloc(binary_len)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to alloc binary", K(ret), K(binary_len));
+      } else {
+        MEMCPY(buf, cell.get_string_ptr(), len);
+        MEMSET(buf + len, '\0', binary_len - len);
+        cell.set_binary(ObString(binary_len, buf));
+      }
+    }
+  } else if (cell.is_fixed_len_char_type()) {
+    const char* str = cell.get_string_ptr();
+    int32_t len = cell.get_string_len();
+    ObString space_pattern = ObCharsetUtils::get_const_str(cell.get_collation_type(), ' ');
+    for (; len >= space_pattern.length(); len -= space_pattern.length()) {
+      if (0 != MEMCMP(str + len - space_pattern.length(), space_pattern.ptr(), space_pattern.length())) {
+        break;
+      }
+    }
+    cell.set_string(cell.get_type(), ObString(len, str));
+  }
+  return ret;
+}
+
+int ObLoadDataDirectCtx::fill_row(const ObIArray<ObString>& values, ObIAllocator& allocator, ObStoreRow& row) const
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < columns_.count(); ++i) {
+    const ColumnDesc& column = columns_.at(i);
+    ObObj& cell = row.row_val_.cells_[i];
+    if (OB_INVALID_INDEX == column.value_idx_) {
+      cell = column.default_value_;
+    } else {
+      const ObString& value = values.at(column.value_idx_);
+      ObObj in;
+      if (ObLoadDataUtils::is_null_field(value)) {
+        if (!column.is_nullable_) {
+          ret = OB_BAD_NULL_ERROR;
+          LOG_WARN("null value for not null column", K(ret), K(i));
+        } else {
+          cell.set_null();
+        }
+      } else {
+        if (ObLoadDataUtils::is_zero_field(value)) {
+          in.set_int(0);
+        } else {
+          in.set_varchar(value);
+          in.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+        }
+        if (OB_FAIL(cast_value(column, in, allocator, cell))) {
+          LOG_WARN("fail to cast value", K(ret), K(i), K(value));
+        } else if (OB_FAIL(reshape_cell(column, allocator, cell))) {
+          LOG_WARN("fail to reshape cell", K(ret), K(i));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectCtx::add_rows(const ObInsertTask& task)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator row_allocator(ObModIds::OB_SQL_LOAD_DATA, OB_MALLOC_NORMAL_BLOCK_SIZE, tenant_id_);
+  ObSEArray<ObString, EXPECTED_INSERT_COLUMN_NUM> values;
+  ObSEArray<ObObj, EXPECTED_INSERT_COLUMN_NUM> cells;
+  ObStoreRow row;
+  int64_t deserialized_rows = 0;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(task.column_count_ != task_column_cnt_ || task.table_schema_version_ != table_schema_version_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("insert task not match", K(ret), K(task), KPC(this));
+  } else if (OB_FAIL(values.reserve(task_column_cnt_))) {
+    LOG_WARN("fail to reserve", K(ret));
+  } else if (OB_FAIL(cells.prepare_allocate(columns_.count()))) {
+    LOG_WARN("fail to prepare allocate", K(ret));
+  } else {
+    row.flag_ = ObActionFlag::OP_ROW_EXIST;
+    row.row_val_.cells_ = &cells.at(0);
+    row.row_val_.count_ = cells.count();
+    ATOMIC_STORE(&last_active_ts_, ObTimeUtility::current_time());
+  }
+
+  // the same row format as ObLoadDataSPImpl::exec_insert
+  for (int64_t buf_i = 0; OB_SUCC(ret) && buf_i < task.insert_value_data_.count(); ++buf_i) {
+    int64_t pos = 0;
+    const char* buf = task.insert_value_data_[buf_i].ptr();
+    int64_t data_len = task.insert_value_data_[buf_i].length();
+    while (OB_SUCC(ret) && pos < data_len) {
+      int64_t row_ser_size = 0;
+      int64_t row_num = 0;
+      OB_UNIS_DECODE(row_ser_size);
+      int64_t pos_back = pos;
+      OB_UNIS_DECODE(row_num);
+      values.reuse();
+      OB_UNIS_DECODE(values);
+      if (OB_SUCC(ret) && (pos - pos_back != row_ser_size || values.count() != task_column_cnt_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("row size is not as expected", "pos diff", pos - pos_back, K(row_ser_size));
+      } else if (OB_FAIL(fill_row(values, row_allocator, row))) {
+        LOG_WARN("fail to fill row", K(ret), K(row_num));
+      } else {
+        lib::ObMutexGuard guard(lock_);
+        if (OB_UNLIKELY(is_finished_)) {
+          ret = OB_STATE_NOT_MATCH;
+          LOG_WARN("direct load is finished", K(ret), KPC(this));
+        } else if (OB_FAIL(sorter_.add_item(row))) {
+          LOG_WARN("fail to add row to sorter", K(ret));
+        } else {
+          ++row_count_;
+        }
+      }
+      row_allocator.reuse();
+      ++deserialized_rows;
+    }
+  }
+
+  if (OB_SUCC(ret) && deserialized_rows != task.row_count_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("data in task not match deserialized result", K(ret), K(deserialized_rows), K(task.row_count_));
+  }
+  if (OB_FAIL(ret) && IS_INIT) {
+    lib::ObMutexGuard guard(lock_);
+    if (OB_SUCCESS == err_ret_) {
+      err_ret_ = ret;
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectCtx::prepare(const int64_t snapshot_version, int64_t& row_count)
+{
+  int ret = OB_SUCCESS;
+  lib::ObMutexGuard guard(lock_);
+  row_count = 0;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(is_finished_)) {
+    ret = OB_STATE_NOT_MATCH;
+    LOG_WARN("direct load is finished", K(ret), KPC(this));
+  } else if (OB_SUCCESS != err_ret_) {
+    ret = err_ret_;
+    LOG_WARN("some rows failed to add", K(ret), KPC(this));
+  } else if (FALSE_IT(is_finished_ = true)) {
+  } else if (OB_ISNULL(GCTX.par_ser_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("partition service is null", K(ret));
+  } else if (OB_FAIL(sorter_.do_sort(true /*final merge*/))) {
+    LOG_WARN("fail to sort rows", K(ret));
+  } else if (OB_FAIL(comp_ret_)) {
+    LOG_WARN("fail to compare rows", K(ret));
+  } else {
+    SortedRowIterator iter(sorter_);
+    if (OB_FAIL(GCTX.par_ser_->prepare_direct_load_sstable(
+            key_.pkey_, table_schema_version_, snapshot_version, iter, sstable_ctx_))) {
+      LOG_WARN("fail to prepare direct load sstable", K(ret), K(snapshot_version), KPC(this));
+    } else if (OB_UNLIKELY(sstable_ctx_.row_count_ != row_count_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("written row count not match", K(ret), KPC(this));
+    } else {
+      row_count = row_count_;
+    }
+  }
+  ATOMIC_STORE(&last_active_ts_, ObTimeUtility::current_time());
+  LOG_INFO("LOAD DATA direct load prepare", K(ret), K(snapshot_version), K(row_count), KPC(this));
+  return ret;
+}
+
+// the ctxs are locked in the order of the request, an abort of the same load waits until publish returns
+int ObLoadDataDirectCtx::publish(const ObIArray<ObLoadDataDirectCtx*>& ctxs)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObPartitionKey, 16> pkeys;
+  ObSEArray<ObDirectLoadSSTableCtx*, 16> sstable_ctxs;
+  ObSEArray<ObMemberList, 16> member_lists;
+  for (int64_t i = 0; i < ctxs.count(); ++i) {
+    (void)ctxs.at(i)->lock_.lock();
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < ctxs.count(); ++i) {
+    ObLoadDataDirectCtx* ctx = ctxs.at(i);
+    if (OB_UNLIKELY(!ctx->is_inited_)) {
+      ret = OB_NOT_INIT;
+      LOG_WARN("not init", K(ret), KPC(ctx));
+    } else if (OB_UNLIKELY(!ctx->sstable_ctx_.is_prepared() || ctx->sstable_ctx_.is_published())) {
+      ret = OB_STATE_NOT_MATCH;
+      LOG_WARN("direct load is not prepared", K(ret), KPC(ctx));
+    } else if (OB_FAIL(pkeys.push_back(ctx->key_.pkey_))) {
+      LOG_WARN("fail to push back pkey", K(ret));
+    } else if (OB_FAIL(sstable_ctxs.push_back(&ctx->sstable_ctx_))) {
+      LOG_WARN("fail to push back sstable ctx", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_ISNULL(GCTX.par_ser_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("partition service is null", K(ret));
+  } else if (OB_FAIL(GCTX.par_ser_->publish_direct_load_sstables(pkeys, sstable_ctxs, member_lists))) {
+    LOG_WARN("fail to publish direct load sstables", K(ret), K(pkeys));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < ctxs.count(); ++i) {
+    if (OB_FAIL(ctxs.at(i)->wait_followers_synced(member_lists.at(i)))) {
+      LOG_WARN("fail to wait followers synced", K(ret), "member_list", member_lists.at(i), KPC(ctxs.at(i)));
+    }
+  }
+  for (int64_t i = 0; i < ctxs.count(); ++i) {
+    ATOMIC_STORE(&ctxs.at(i)->last_active_ts_, ObTimeUtility::current_time());
+    LOG_INFO("LOAD DATA direct load publish", K(ret), KPC(ctxs.at(i)));
+    (void)ctxs.at(i)->lock_.unlock();
+  }
+  return ret;
+}
+
+// publish is all or nothing, so either all ctxs are published or none of them
+int ObLoadDataDirectCtx::rollback(const ObIArray<ObLoadDataDirectCtx*>& ctxs)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObPartitionKey, 16> pkeys;
+  ObSEArray<ObDirectLoadSSTableCtx*, 16> sstable_ctxs;
+  for (int64_t i = 0; i < ctxs.count(); ++i) {
+    (void)ctxs.at(i)->lock_.lock();
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < ctxs.count(); ++i) {
+    ObLoadDataDirectCtx* ctx = ctxs.at(i);
+    if (!ctx->is_inited_ || !ctx->sstable_ctx_.is_published()) {
+      // nothing visible
+    } else if (OB_FAIL(pkeys.push_back(ctx->key_.pkey_))) {
+      LOG_WARN("fail to push back pkey", K(ret));
+    } else if (OB_FAIL(sstable_ctxs.push_back(&ctx->sstable_ctx_))) {
+      LOG_WARN("fail to push back sstable ctx", K(ret));
+    }
+  }
+  if (OB_FAIL(ret) || pkeys.empty()) {
+  } else if (OB_ISNULL(GCTX.par_ser_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("partition service is null", K(ret));
+  } else if (OB_FAIL(GCTX.par_ser_->rollback_direct_load_sstables(pkeys, sstable_ctxs))) {
+    LOG_WARN("fail to rollback direct load sstables", K(ret), K(pkeys));
+  }
+  for (int64_t i = 0; i < ctxs.count(); ++i) {
+    LOG_INFO("LOAD DATA direct load rollback", K(ret), KPC(ctxs.at(i)));
+    (void)ctxs.at(i)->lock_.unlock();
+  }
+  return ret;
+}
+
+// followers are rebuilt by publish, a follower is synced once its major sstable is the published one
+int ObLoadDataDirectCtx::wait_followers_synced(const ObMemberList& member_list)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObAddr, OB_MAX_MEMBER_NUMBER> unsynced_servers;
+  ObLoadDataDirectCheckArg arg;
+  const ObITable* sstable = sstable_ctx_.sstable_handle_.get_table();
+  if (OB_ISNULL(sstable) || OB_ISNULL(GCTX.load_data_proxy_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("published sstable or rpc proxy is null", K(ret), KP(sstable), KP(GCTX.load_data_proxy_));
+  } else {
+    arg.tenant_id_ = tenant_id_;
+    arg.table_key_ = sstable->get_key();
+    arg.row_count_ = sstable_ctx_.row_count_;
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < member_list.get_member_number(); ++i) {
+    ObAddr server;
+    if (OB_FAIL(member_list.get_server_by_index(i, server))) {
+      LOG_WARN("fail to get server", K(ret), K(i));
+    } else if (server == GCTX.self_addr_) {
+      // leader
+    } else if (OB_FAIL(unsynced_servers.push_back(server))) {
+      LOG_WARN("fail to push back", K(ret));
+    }
+  }
+  while (OB_SUCC(ret) && !unsynced_servers.empty()) {
+    for (int64_t i = unsynced_servers.count() - 1; OB_SUCC(ret) && i >= 0; --i) {
+      ObLoadDataDirectCheckResult result;
+      int tmp_ret = OB_SUCCESS;
+      if (OB_SUCCESS != (tmp_ret = GCTX.load_data_proxy_->to(unsynced_servers.at(i))
+                                       .by(tenant_id_)
+                                       .timeout(std::max(THIS_WORKER.get_timeout_remain(), 0L))
+                                       .load_data_direct_check(arg, result))) {
+        LOG_WARN("fail to check direct load of follower", K(tmp_ret), K(arg), "server", unsynced_servers.at(i));
+      } else if (result.is_synced_ && OB_FAIL(unsynced_servers.remove(i))) {
+        LOG_WARN("fail to remove synced server", K(ret), K(i));
+      }
+    }
+    if (OB_FAIL(ret) || unsynced_servers.empty()) {
+    } else if (OB_UNLIKELY(THIS_WORKER.is_timeout())) {
+      ret = OB_TIMEOUT;
+      LOG_WARN("followers are not synced before timeout", K(ret), K(unsynced_servers), K(arg));
+    } else {
+      usleep(static_cast<uint32_t>(std::min(CHECK_SYNC_INTERVAL_US, THIS_WORKER.get_timeout_remain())));
+    }
+  }
+  return ret;
+}
+
+ObLoadDataDirectMgr& ObLoadDataDirectMgr::get_instance()
+{
+  static ObLoadDataDirectMgr instance;
+  return instance;
+}
+
+ObLoadDataDirectMgr::~ObLoadDataDirectMgr()
+{
+  if (ctx_map_.created()) {
+    for (CtxMap::iterator iter = ctx_map_.begin(); iter != ctx_map_.end(); ++iter) {
+      revert_ctx(iter->second);
+    }
+    ctx_map_.destroy();
+  }
+}
+
+int ObLoadDataDirectMgr::init()
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+  } else if (OB_FAIL(ctx_map_.create(BUCKET_NUM, ObModIds::OB_SQL_LOAD_DATA, ObModIds::OB_SQL_LOAD_DATA))) {
+    LOG_WARN("create hash table failed", K(ret));
+  } else {
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObLoadDataDirectMgr::add_rows(const ObInsertTask& task)
+{
+  int ret = OB_SUCCESS;
+  ObLoadDataDirectCtx* ctx = NULL;
+  if (OB_FAIL(acquire_ctx(task, ctx))) {
+    LOG_WARN("fail to acquire direct load ctx", K(ret), K(task));
+  } else {
+    if (OB_FAIL(ctx->add_rows(task))) {
+      LOG_WARN("fail to add rows", K(ret), K(task));
+    }
+    revert_ctx(ctx);
+  }
+  return ret;
+}
+
+int ObLoadDataDirectMgr::finish(const ObLoadDataDirectFinishArg& arg, int64_t& row_count)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObLoadDataDirectCtx*, 16> ctxs;
+  row_count = 0;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(!arg.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(arg));
+  } else if (ObLoadDataDirectFinishArg::PREPARE == arg.phase_) {
+    int64_t snapshot_version = 0;
+    if (OB_FAIL(get_ctxs(arg, ctxs))) {
+      LOG_WARN("fail to get direct load ctxs", K(ret), K(arg));
+    } else if (OB_ISNULL(GCTX.par_ser_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("partition service is null", K(ret));
+    } else if (OB_FAIL(GCTX.par_ser_->get_direct_load_snapshot(arg.tenant_id_, snapshot_version))) {
+      LOG_WARN("fail to get direct load snapshot", K(ret), K(arg));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < ctxs.count(); ++i) {
+      int64_t part_row_count = 0;
+      if (OB_FAIL(ctxs.at(i)->prepare(snapshot_version, part_row_count))) {
+        LOG_WARN("fail to prepare direct load", K(ret), "key", ctxs.at(i)->get_key());
+      } else {
+        row_count += part_row_count;
+      }
+    }
+  } else if (ObLoadDataDirectFinishArg::PUBLISH == arg.phase_) {
+    if (OB_FAIL(get_ctxs(arg, ctxs))) {
+      LOG_WARN("fail to get direct load ctxs", K(ret), K(arg));
+    } else if (OB_FAIL(ObLoadDataDirectCtx::publish(ctxs))) {
+      LOG_WARN("fail to publish direct load", K(ret), K(arg));
+    }
+  } else if (ObLoadDataDirectFinishArg::COMMIT == arg.phase_) {
+    if (OB_FAIL(remove_ctxs(arg, false /*allow missing*/, ctxs))) {
+      LOG_WARN("fail to remove direct load ctxs", K(ret), K(arg));
+    } else {
+      LOG_INFO("LOAD DATA direct load committed", K(arg));
+    }
+  } else if (OB_FAIL(remove_ctxs(arg, true /*allow missing*/, ctxs))) {
+    LOG_WARN("fail to remove direct load ctxs", K(ret), K(arg));
+  } else if (OB_FAIL(ObLoadDataDirectCtx::rollback(ctxs))) {
+    // the ctxs are gone, the published partitions keep the loaded rows
+    LOG_ERROR("fail to rollback direct load", K(ret), K(arg));
+  } else {
+    LOG_INFO("LOAD DATA direct load aborted", K(arg));
+  }
+  revert_ctxs(ctxs);
+  return ret;
+}
+
+int ObLoadDataDirectMgr::get_ctxs(const ObLoadDataDirectFinishArg& arg, ObIArray<ObLoadDataDirectCtx*>& ctxs)
+{
+  int ret = OB_SUCCESS;
+  ObLoadDataDirectKey key;
+  for (int64_t i = 0; OB_SUCC(ret) && i < arg.pkeys_.count(); ++i) {
+    ObLoadDataDirectCtx* ctx = NULL;
+    arg.get_key(i, key);
+    if (OB_FAIL(get_ctx(key, ctx))) {
+      LOG_WARN("fail to get direct load ctx", K(ret), K(key));
+    } else if (OB_FAIL(ctxs.push_back(ctx))) {
+      LOG_WARN("fail to push back ctx", K(ret));
+      revert_ctx(ctx);
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectMgr::remove_ctxs(
+    const ObLoadDataDirectFinishArg& arg, const bool allow_missing, ObIArray<ObLoadDataDirectCtx*>& ctxs)
+{
+  int ret = OB_SUCCESS;
+  ObLoadDataDirectKey key;
+  for (int64_t i = 0; OB_SUCC(ret) && i < arg.pkeys_.count(); ++i) {
+    ObLoadDataDirectCtx* ctx = NULL;
+    arg.get_key(i, key);
+    if (OB_FAIL(remove_ctx(key, ctx))) {
+      if (OB_HASH_NOT_EXIST == ret && allow_missing) {
+        ret = OB_SUCCESS;
+      } else {
+        LOG_WARN("fail to remove direct load ctx", K(ret), K(key));
+      }
+    } else if (OB_FAIL(ctxs.push_back(ctx))) {
+      LOG_WARN("fail to push back ctx", K(ret));
+      revert_ctx(ctx);
+    }
+  }
+  return ret;
+}
+
+void ObLoadDataDirectMgr::revert_ctxs(ObIArray<ObLoadDataDirectCtx*>& ctxs)
+{
+  for (int64_t i = 0; i < ctxs.count(); ++i) {
+    revert_ctx(ctxs.at(i));
+  }
+  ctxs.reset();
+}
+
+int ObLoadDataDirectMgr::get_ctx(const ObLoadDataDirectKey& key, ObLoadDataDirectCtx*& ctx)
+{
+  int ret = OB_SUCCESS;
+  lib::ObMutexGuard guard(lock_);
+  ctx = NULL;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_FAIL(ctx_map_.get_refactored(key, ctx))) {
+    LOG_WARN("fail to get ctx", K(ret), K(key));
+  } else {
+    ctx->inc_ref();
+  }
+  return ret;
+}
+
+int ObLoadDataDirectMgr::acquire_ctx(const ObInsertTask& task, ObLoadDataDirectCtx*& ctx)
+{
+  int ret = OB_SUCCESS;
+  lib::ObMutexGuard guard(lock_);
+  ctx = NULL;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_SUCC(ctx_map_.get_refactored(task.direct_key_, ctx))) {
+    ctx->inc_ref();
+  } else if (OB_HASH_NOT_EXIST != ret) {
+    LOG_WARN("fail to get ctx", K(ret), K(task.direct_key_));
+  } else {
+    ret = OB_SUCCESS;
+    purge_expired_ctx();
+    if (OB_ISNULL(ctx = OB_NEW(ObLoadDataDirectCtx, ObMemAttr(task.tenant_id_, ObModIds::OB_SQL_LOAD_DATA)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc direct load ctx", K(ret));
+    } else if (FALSE_IT(ctx->inc_ref())) {
+    } else if (OB_FAIL(ctx->init(task))) {
+      LOG_WARN("fail to init direct load ctx", K(ret), K(task));
+    } else if (OB_FAIL(ctx_map_.set_refactored(task.direct_key_, ctx))) {
+      LOG_WARN("fail to add ctx", K(ret), K(task.direct_key_));
+    } else {
+      ctx->inc_ref();  // one for map and one for caller
+      LOG_INFO("LOAD DATA direct load ctx created", KPC(ctx));
+    }
+    if (OB_FAIL(ret) && OB_NOT_NULL(ctx)) {
+      revert_ctx(ctx);
+      ctx = NULL;
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectMgr::remove_ctx(const ObLoadDataDirectKey& key, ObLoadDataDirectCtx*& ctx)
+{
+  int ret = OB_SUCCESS;
+  lib::ObMutexGuard guard(lock_);
+  ctx = NULL;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_FAIL(ctx_map_.erase_refactored(key, &ctx))) {
+    if (OB_HASH_NOT_EXIST != ret) {
+      LOG_WARN("fail to erase ctx", K(ret), K(key));
+    }
+  }
+  return ret;
+}
+
+void ObLoadDataDirectMgr::revert_ctx(ObLoadDataDirectCtx* ctx)
+{
+  if (OB_NOT_NULL(ctx) && 0 == ctx->dec_ref()) {
+    OB_DELETE(ObLoadDataDirectCtx, ObModIds::OB_SQL_LOAD_DATA, ctx);
+  }
+}
+
+void ObLoadDataDirectMgr::purge_expired_ctx()
+{
+  int ret = OB_SUCCESS;
+  const int64_t cur_ts = ObTimeUtility::current_time();
+  ObSEArray<ObLoadDataDirectKey, 16> expired_keys;
+  for (CtxMap::iterator iter = ctx_map_.begin(); OB_SUCC(ret) && iter != ctx_map_.end(); ++iter) {
+    if (OB_NOT_NULL(iter->second) && iter->second->is_expired(cur_ts)) {
+      ret = expired_keys.push_back(iter->first);
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < expired_keys.count(); ++i) {
+    ObLoadDataDirectCtx* ctx = NULL;
+    if (OB_SUCC(ctx_map_.erase_refactored(expired_keys.at(i), &ctx))) {
+      if (ctx->is_published()) {
+        // neither committed nor aborted after publish, the loaded rows are kept
+        LOG_WARN("LOAD DATA direct load ctx expired after publish", KPC(ctx));
+      } else {
+        LOG_WARN("LOAD DATA direct load ctx expired", KPC(ctx));
+      }
+      revert_ctx(ctx);
+    }
+  }
+}
+
+}  // namespace sql
+}  // namespace oceanbase
@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_CMD_LOAD_DATA_DIRECT_H_
+#define OCEANBASE_SQL_ENGINE_CMD_LOAD_DATA_DIRECT_H_
+
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_se_array.h"
+#include "lib/hash/ob_hashmap.h"
+#include "lib/lock/ob_mutex.h"
+#include "lib/timezone/ob_timezone_info.h"
+#include "common/row/ob_row_iterator.h"
+#include "storage/ob_i_store.h"
+#include "storage/ob_parallel_external_sort.h"
+#include "storage/ob_pg_storage.h"
+#include "storage/ob_store_row_comparer.h"
+#include "sql/engine/cmd/ob_load_data_rpc.h"
+
+namespace oceanbase {
+namespace share {
+namespace schema {
+class ObTableSchema;
+class ObColumnSchemaV2;
+}  // namespace schema
+}  // namespace share
+
+namespace sql {
+
+/*
+ * Direct load of LOAD DATA:
+ * insert tasks of one partition are sent to the leader as usual, but instead of executing insert statements,
+ * the leader casts the values to column types and puts rows into an external sort.
+ * All loaded partitions must be led by one server. When all tasks are returned, the coordinator prepares the
+ * partitions, that is the sorted rows are written into macro blocks with one snapshot taken for the load.
+ * Only if all partitions are prepared, the coordinator publishes them: the macro blocks become major sstables,
+ * which replace the empty ones of all partitions in one slog transaction, so either all partitions or none of
+ * them have the loaded rows, also after a restart. The sstables bypass clog, so publish rebuilds the followers
+ * and waits until they have the sstables. Abort puts the empty major sstables back in the same way.
+ */
+class ObLoadDataDirectCtx {
+public:
+  static const int64_t SORT_MEMORY_LIMIT = 64L * 1024L * 1024L;
+  static const int64_t MAX_IDLE_TIME_US = 30L * 60L * 1000L * 1000L;  // 30min
+  static const int64_t CHECK_SYNC_INTERVAL_US = 100L * 1000L;          // 100ms
+
+  ObLoadDataDirectCtx();
+  ~ObLoadDataDirectCtx();
+  int init(const ObInsertTask& task);
+  // cast values of the rows in task and add them to sorter, can be called concurrently
+  int add_rows(const ObInsertTask& task);
+  // sort rows and write them into macro blocks, no more rows can be added after that
+  int prepare(const int64_t snapshot_version, int64_t& row_count);
+  // make the prepared rows of all ctxs visible at once and wait the followers to sync
+  static int publish(const common::ObIArray<ObLoadDataDirectCtx*>& ctxs);
+  // undo publish of the published ctxs at once, nothing to do for the others
+  static int rollback(const common::ObIArray<ObLoadDataDirectCtx*>& ctxs);
+  bool is_published() const
+  {
+    return sstable_ctx_.is_published();
+  }
+  bool is_expired(const int64_t cur_ts) const
+  {
+    return cur_ts - ATOMIC_LOAD(&last_active_ts_) > MAX_IDLE_TIME_US;
+  }
+  int64_t inc_ref()
+  {
+    return ATOMIC_AAF(&ref_cnt_, 1);
+  }
+  int64_t dec_ref()
+  {
+    return ATOMIC_AAF(&ref_cnt_, -1);
+  }
+  const ObLoadDataDirectKey& get_key() const
+  {
+    return key_;
+  }
+  TO_STRING_KV(K_(is_inited), K_(key), K_(tenant_id), K_(table_schema_version), K_(rowkey_cnt), K_(row_count),
+      K_(err_ret), K_(is_finished), K_(sstable_ctx), K_(ref_cnt));
+
+private:
+  // column of the row written to sstable, in the order of table store
+  struct ColumnDesc {
+    ColumnDesc() : value_idx_(common::OB_INVALID_INDEX), is_nullable_(true)
+    {}
+    int64_t value_idx_;  // index of value in task row, OB_INVALID_INDEX means using default value
+    common::ObObjMeta meta_;
+    common::ObAccuracy accuracy_;
+    bool is_nullable_;
+    common::ObObj default_value_;
+    TO_STRING_KV(K_(value_idx), K_(meta), K_(accuracy), K_(is_nullable), K_(default_value));
+  };
+
+  class SortedRowIterator : public common::ObNewRowIterator {
+  public:
+    typedef storage::ObExternalSort<storage::ObStoreRow, storage::ObStoreRowComparer> Sorter;
+    explicit SortedRowIterator(Sorter& sorter) : sorter_(sorter)
+    {}
+    virtual ~SortedRowIterator()
+    {}
+    virtual int get_next_row(common::ObNewRow*& row) override;
+    virtual void reset() override
+    {}
+
+  private:
+    Sorter& sorter_;
+  };
+
+  int init_columns(const share::schema::ObTableSchema& table_schema, const ObInsertTask& task);
+  int cast_value(const ColumnDesc& column, const common::ObObj& in, common::ObIAllocator& allocator,
+      common::ObObj& out) const;
+  int fill_row(const common::ObIArray<common::ObString>& values, common::ObIAllocator& allocator,
+      storage::ObStoreRow& row) const;
+  int reshape_cell(const ColumnDesc& column, common::ObIAllocator& allocator, common::ObObj& cell) const;
+  int wait_followers_synced(const common::ObMemberList& member_list);
+
+private:
+  bool is_inited_;
+  ObLoadDataDirectKey key_;
+  uint64_t tenant_id_;
+  int64_t table_schema_version_;
+  int64_t rowkey_cnt_;
+  int64_t task_column_cnt_;
+  common::ObArenaAllocator allocator_;
+  common::ObSEArray<ColumnDesc, EXPECTED_INSERT_COLUMN_NUM> columns_;
+  common::ObSEArray<int64_t, common::OB_MAX_ROWKEY_COLUMN_NUMBER> sort_column_indexes_;
+  common::ObTimeZoneInfoWrap tz_info_wrap_;
+  common::ObTZMapWrap tz_map_wrap_;
+  int comp_ret_;
+  storage::ObStoreRowComparer comparer_;
+  SortedRowIterator::Sorter sorter_;
+  lib::ObMutex lock_;  // protect sorter_
+  int64_t row_count_;
+  int err_ret_;  // rows are lost once adding fails, never write them into partition
+  bool is_finished_;
+  storage::ObDirectLoadSSTableCtx sstable_ctx_;
+  int64_t last_active_ts_;
+  int64_t ref_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObLoadDataDirectCtx);
+};
+
+class ObLoadDataDirectMgr {
+public:
+  static ObLoadDataDirectMgr& get_instance();
+  ObLoadDataDirectMgr() : is_inited_(false)
+  {}
+  ~ObLoadDataDirectMgr();
+  int init();
+  // the ctx of a partition is created by its first insert task
+  int add_rows(const ObInsertTask& task);
+  // runs one finish phase of all partitions in arg, row_count is the sum of prepared rows
+  int finish(const ObLoadDataDirectFinishArg& arg, int64_t& row_count);
+  // the ctx is referenced until revert_ctx()
+  int get_ctx(const ObLoadDataDirectKey& key, ObLoadDataDirectCtx*& ctx);
+  // take the ctx out of the manager, it is freed after revert_ctx()
+  int remove_ctx(const ObLoadDataDirectKey& key, ObLoadDataDirectCtx*& ctx);
+  void revert_ctx(ObLoadDataDirectCtx* ctx);
+
+private:
+  typedef common::hash::ObHashMap<ObLoadDataDirectKey, ObLoadDataDirectCtx*, common::hash::NoPthreadDefendMode>
+      CtxMap;
+  static const int64_t BUCKET_NUM = 1024;
+  int acquire_ctx(const ObInsertTask& task, ObLoadDataDirectCtx*& ctx);
+  // ctxs of all partitions in arg, in the order of arg
+  int get_ctxs(const ObLoadDataDirectFinishArg& arg, common::ObIArray<ObLoadDataDirectCtx*>& ctxs);
+  // partitions whose ctx is gone already are skipped if allow_missing
+  int remove_ctxs(
+      const ObLoadDataDirectFinishArg& arg, const bool allow_missing, common::ObIArray<ObLoadDataDirectCtx*>& ctxs);
+  void revert_ctxs(common::ObIArray<ObLoadDataDirectCtx*>& ctxs);
+  // ctx of a statement whose coordinator is gone is never committed or aborted
+  void purge_expired_ctx();
+
+private:
+  bool is_inited_;
+  lib::ObMutex lock_;
+  CtxMap ctx_map_;
+  DISALLOW_COPY_AND_ASSIGN(ObLoadDataDirectMgr);
+};
+
+}  // namespace sql
+}  // namespace oceanbase
+
+#endif  // OCEANBASE_SQL_ENGINE_CMD_LOAD_DATA_DIRECT_H_
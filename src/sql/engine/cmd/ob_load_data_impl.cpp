@@ -1323,6 +1323,22 @@ int ObCSVParser::init(
     LOG_WARN("fail to reserve array", K(ret));
   } else if (OB_FAIL(string_type_column_.add_members(string_type_column))) {
     LOG_WARN("fail to add member", K(ret));
+  } else {
+    special_chars_.reset();
+    line_chars_.reset();
+    const int64_t special_chars[] = {
+        formats_.enclose_char_, formats_.escape_char_, formats_.field_term_char_, formats_.line_term_char_};
+    const int64_t line_chars[] = {formats_.escape_char_, formats_.line_term_char_};
+    for (int64_t i = 0; OB_SUCC(ret) && i < ARRAYSIZEOF(special_chars); ++i) {
+      if (OB_FAIL(special_chars_.add_char(special_chars[i]))) {
+        LOG_WARN("fail to add special char", K(ret), K(i));
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < ARRAYSIZEOF(line_chars); ++i) {
+      if (OB_FAIL(line_chars_.add_char(line_chars[i]))) {
+        LOG_WARN("fail to add line char", K(ret), K(i));
+      }
+    }
   }
   return ret;
 }
@@ -1346,7 +1362,15 @@ int ObCSVParser::next_line(bool& yield_line)
 
   for (; !yield && cur_pos_ < buf_end_pos_; ++cur_pos_, ++cur_field_end_pos_) {
     bool line_term_matched = false;
-    if (*cur_pos_ == formats_.enclose_char_ && !in_enclose_flag_ && cur_pos_ == cur_field_begin_pos_) {
+    if (!special_chars_.is_special(*cur_pos_)) {
+      // plain bytes till the next special char belong to the current field, only need copying
+      int64_t plain_len = special_chars_.find(cur_pos_, buf_end_pos_) - cur_pos_;
+      if (cur_field_end_pos_ != cur_pos_ && !is_fast_parse_) {
+        MEMMOVE(cur_field_end_pos_, cur_pos_, plain_len);
+      }
+      cur_pos_ += plain_len - 1;
+      cur_field_end_pos_ += plain_len - 1;
+    } else if (*cur_pos_ == formats_.enclose_char_ && !in_enclose_flag_ && cur_pos_ == cur_field_begin_pos_) {
       in_enclose_flag_ = true;
       last_end_enclosed_ = NULL;
     } else if (cur_pos_ + 1 < buf_end_pos_ &&
@@ -1449,9 +1473,15 @@ int ObCSVParser::fast_parse_lines(
     ret = OB_INVALID_ARGUMENT;
   } else if (formats.is_simple_format_) {
     char *cur_pos = buffer.begin_ptr();
-    for (char *p = buffer.begin_ptr(); p < buffer.current_ptr(); ++p) {
+    const char *buf_end = buffer.current_ptr();
+    for (char *p = buffer.begin_ptr(); p < buf_end; ++p) {
+      // only escape and line term chars matter here, jump over the others
+      p = const_cast<char *>(parser.line_chars_.find(p, buf_end));
+      if (p >= buf_end) {
+        break;
+      }
       char cur_char = *p;
-      if (formats.escape_char_ == cur_char && p + 1 < buffer.current_ptr()) {
+      if (formats.escape_char_ == cur_char && p + 1 < buf_end) {
         p++;
       } else if (formats.line_term_char_ == cur_char) {
         cur_lines++;
@@ -3337,6 +3367,10 @@ int ObLoadDataSPImpl::handle_returned_insert_task(
                "task_id", insert_task.task_id_,
                "ret", result.exec_ret_,
                "row_count", insert_task.row_count_);
+      if (box.is_direct_load) {
+        // rows of the partition are written at once, the whole load fails
+        ret = (OB_SUCCESS == result.exec_ret_) ? OB_ERR_UNEXPECTED : result.exec_ret_;
+      }
       break;
     default:
       ret = OB_ERR_UNEXPECTED;
@@ -3405,6 +3439,82 @@ int ObLoadDataSPImpl::wait_insert_task_return(ObExecContext& ctx, ToolBox& box)
   return ret;
 }
 
+// sends one phase of finish for all partitions which have rows to their leader in one request
+int ObLoadDataSPImpl::direct_load_send_phase(ToolBox& box, const int64_t phase, int64_t& row_count)
+{
+  int ret = OB_SUCCESS;
+  ObLoadServerInfo* server_info = NULL;
+  ObLoadDataDirectFinishArg arg;
+  ObLoadDataDirectFinishResult result;
+  row_count = 0;
+  if (OB_UNLIKELY(1 != box.server_infos.count()) || OB_ISNULL(server_info = box.server_infos.at(0))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("direct load needs exactly one leader server", K(ret), "server_count", box.server_infos.count());
+  } else {
+    arg.coordinator_ = box.self_addr;
+    arg.load_id_ = box.gid.id;
+    arg.tenant_id_ = box.tenant_id;
+    arg.phase_ = phase;
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < server_info->part_datafrag_group.count(); ++i) {
+    ObPartDataFragMgr* part_mgr = server_info->part_datafrag_group.at(i);
+    if (OB_ISNULL(part_mgr)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("part data frag mgr is null", K(ret));
+    } else if (0 == part_mgr->total_row_consumed_) {
+      // no rows sent to this partition
+    } else if (OB_FAIL(arg.pkeys_.push_back(part_mgr->get_part_key()))) {
+      LOG_WARN("fail to push back pkey", K(ret));
+    }
+  }
+  if (OB_FAIL(ret) || arg.pkeys_.empty()) {
+  } else if (OB_FAIL(GCTX.load_data_proxy_->to(server_info->addr)
+                         .by(box.tenant_id)
+                         .timeout(std::max(box.txn_timeout, THIS_WORKER.get_timeout_remain()))
+                         .load_data_direct_finish(arg, result))) {
+    LOG_WARN("fail to finish direct load", K(ret), K(arg), "leader", server_info->addr);
+  } else {
+    row_count = result.row_count_;
+  }
+  return ret;
+}
+
+// all partitions are prepared before they are published at once. A failure before publish leaves no rows,
+// ABORT then only releases the sorted rows. A failure after publish, e.g. while waiting the followers, is
+// undone by ABORT, which puts the empty major sstables back at once. A failed ABORT is only logged, the
+// published partitions keep the loaded rows then.
+int ObLoadDataSPImpl::direct_load_finish(ToolBox& box, const bool is_abort)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  int64_t row_count = 0;
+  int64_t unused_row_count = 0;
+  if (is_abort) {
+  } else if (OB_FAIL(direct_load_send_phase(box, ObLoadDataDirectFinishArg::PREPARE, row_count))) {
+    LOG_WARN("fail to prepare direct load", K(ret), K(box.gid));
+  } else if (OB_FAIL(direct_load_send_phase(box, ObLoadDataDirectFinishArg::PUBLISH, unused_row_count))) {
+    LOG_WARN("fail to publish direct load", K(ret), K(box.gid));
+  }
+  if (OB_SUCC(ret) && !is_abort) {
+    box.affected_rows = row_count;
+    if (OB_SUCCESS !=
+        (tmp_ret = direct_load_send_phase(box, ObLoadDataDirectFinishArg::COMMIT, unused_row_count))) {
+      // rows are visible already, the remaining ctxs expire on the leader
+      LOG_WARN("fail to commit direct load", K(tmp_ret), K(box.gid));
+    }
+  } else {
+    if (OB_SUCCESS != (tmp_ret = direct_load_send_phase(box, ObLoadDataDirectFinishArg::ABORT, unused_row_count))) {
+      LOG_ERROR("fail to abort direct load, the partitions keep the loaded rows if they are published",
+          K(tmp_ret), K(box.gid));
+    }
+    if (OB_ERR_PRIMARY_KEY_DUPLICATE == ret) {
+      LOG_USER_ERROR(OB_ERR_PRIMARY_KEY_DUPLICATE, "", static_cast<int>(sizeof("PRIMARY") - 1), "PRIMARY");
+    }
+  }
+  LOG_INFO("LOAD DATA direct load finish", K(ret), K(is_abort), K(row_count), K(box.gid));
+  return ret;
+}
+
 int ObLoadDataSPImpl::insert_task_send(ObInsertTask* insert_task, ToolBox& box)
 {
   int ret = OB_SUCCESS;
@@ -3482,6 +3592,9 @@ int ObLoadDataSPImpl::insert_task_gen_and_dispatch(ObExecContext& ctx, ToolBox&
         } else {
           // CASE3: for new insert task
           insert_task->part_mgr = part_datafrag_mgr;
+          if (box.is_direct_load) {
+            insert_task->direct_key_.pkey_ = part_datafrag_mgr->get_part_key();
+          }
           insert_task->task_id_ = box.insert_task_controller.get_next_task_id();
           if (OB_FAIL(part_datafrag_mgr->next_insert_task(row_count, *insert_task))) {
             LOG_WARN("fail to generate insert task", K(ret));
@@ -3574,6 +3687,13 @@ int ObLoadDataSPImpl::execute(ObExecContext& ctx, ObLoadDataStmt& load_stmt)
     OZ(ObLoadDataUtils::check_session_status(*ctx.get_my_session()));
   }
 
+  if (box.is_direct_load) {
+    int tmp_ret = direct_load_finish(box, OB_SUCCESS != ret);
+    if (OB_SUCC(ret)) {
+      ret = tmp_ret;
+    }
+  }
+
   // release
   OW(box.release_resources());
 
@@ -4046,6 +4166,7 @@ int ObLoadDataSPImpl::ToolBox::init(ObExecContext& ctx, ObLoadDataStmt& load_stm
   load_file_storage = load_args.load_file_storage_;
   ignore_rows = load_args.ignore_rows_;
   last_session_check_ts = 0;
+  is_direct_load = false;
 
   ObSQLSessionInfo* session = NULL;
 
@@ -4411,6 +4532,72 @@ int ObLoadDataSPImpl::ToolBox::init(ObExecContext& ctx, ObLoadDataStmt& load_stm
     }
   }
 
+  if (OB_SUCC(ret)) {
+    int64_t hint_direct_load = 0;
+    if (OB_FAIL(hint.get_value(ObLoadDataHint::DIRECT_LOAD, hint_direct_load))) {
+      LOG_WARN("fail to get value", K(ret));
+    } else if (0 != hint_direct_load && OB_FAIL(init_direct_load(ctx, load_stmt))) {
+      LOG_WARN("fail to init direct load", K(ret));
+    }
+  }
+
+  return ret;
+}
+
+// rows are cast on the leaders without any sql expression, so only tables and statements which do not
+// need them can be direct loaded. the empty partition is checked by storage when the load finishes.
+int ObLoadDataSPImpl::ToolBox::init_direct_load(ObExecContext& ctx, ObLoadDataStmt& load_stmt)
+{
+  int ret = OB_SUCCESS;
+  const ObLoadArgument& load_args = load_stmt.get_load_arguments();
+  const ObTableSchema* table_schema = NULL;
+  ObSQLSessionInfo* session = ctx.get_my_session();
+  bool is_supported = !is_oracle_mode && ObLoadDupActionType::LOAD_STOP_ON_DUP == insert_mode &&
+                      0 == load_stmt.get_table_assignment().count();
+
+  if (OB_ISNULL(session) || OB_ISNULL(ctx.get_sql_ctx()) || OB_ISNULL(ctx.get_sql_ctx()->schema_guard_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid exec ctx", K(ret));
+  } else if (OB_FAIL(ctx.get_sql_ctx()->schema_guard_->get_table_schema(load_args.table_id_, table_schema))) {
+    LOG_WARN("fail to get table schema", K(ret), K(load_args.table_id_));
+  } else if (OB_ISNULL(table_schema)) {
+    ret = OB_TABLE_NOT_EXIST;
+    LOG_WARN("table not exist", K(ret), K(load_args.table_id_));
+  } else {
+    is_supported = is_supported && !table_schema->is_no_pk_table() && 0 == table_schema->get_index_tid_count() &&
+                   0 == table_schema->get_autoinc_column_id() && !table_schema->has_generated_column() &&
+                   0 == table_schema->get_foreign_key_infos().count();
+    if (!is_supported) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("direct load is not supported", K(ret), K(insert_mode), K(load_args.table_id_));
+      LOG_USER_ERROR(OB_NOT_SUPPORTED, "direct load with the table or statement");
+    } else if (1 != server_infos.count()) {
+      // the partitions are published in one slog transaction of their leader
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("direct load needs all partitions led by one server", K(ret), "server_count", server_infos.count());
+      LOG_USER_ERROR(OB_NOT_SUPPORTED, "direct load into partitions led by more than one server");
+    }
+  }
+
+  for (int64_t i = 0; OB_SUCC(ret) && i < insert_resource.count(); ++i) {
+    ObInsertTask* insert_task = insert_resource.at(i);
+    insert_task->is_direct_load_ = true;
+    insert_task->direct_key_.coordinator_ = self_addr;
+    insert_task->direct_key_.load_id_ = gid.id;
+    insert_task->table_schema_version_ = table_schema->get_schema_version();
+    for (int64_t j = 0; OB_SUCC(ret) && j < generator.get_table_column_value_descs().count(); ++j) {
+      if (OB_FAIL(insert_task->column_ids_.push_back(generator.get_table_column_value_descs().at(j).column_id_))) {
+        LOG_WARN("fail to push back", K(ret));
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(insert_task->tz_info_wrap_.deep_copy(session->get_tz_info_wrap()))) {
+      LOG_WARN("fail to copy time zone info", K(ret));
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    is_direct_load = true;
+  }
   return ret;
 }
 /*
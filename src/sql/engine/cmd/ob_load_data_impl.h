@@ -602,6 +602,8 @@ private:
   bool in_enclose_flag_;
   bool is_escaped_flag_;
   int64_t total_field_nums_;
+  ObCSVSpecialCharScanner special_chars_;  // all chars need handling in next_line
+  ObCSVSpecialCharScanner line_chars_;     // escape and line term chars for fast_parse_lines
   // ObLoadEscapeSM escape_sm_;
   // parsing result: the pointers of each value in one line
   common::ObSEArray<ObString, 1> values_in_line_;
@@ -805,6 +807,7 @@ public:
     ToolBox() : expr_buffer(nullptr)
     {}
     int init(ObExecContext& ctx, ObLoadDataStmt& load_stmt);
+    int init_direct_load(ObExecContext& ctx, ObLoadDataStmt& load_stmt);
     int release_resources();
 
     // modules
@@ -847,6 +850,7 @@ public:
     ObLoadFileLocation load_file_storage;
     ObLoadDataGID gid;
     int64_t txn_timeout;
+    bool is_direct_load;
 
     // temp data
     ObLoadFileBuffer* expr_buffer;
@@ -892,6 +896,8 @@ public:
   int handle_returned_insert_task(ObExecContext& ctx, ToolBox& box, ObInsertTask& insert_task, bool& need_retry);
   int log_failed_insert_task(ToolBox& box, ObInsertTask& task);
   int wait_insert_task_return(ObExecContext& ctx, ToolBox& box);
+  int direct_load_finish(ToolBox& box, const bool is_abort);
+  int direct_load_send_phase(ToolBox& box, const int64_t phase, int64_t& row_count);
 
   int create_log_file(ToolBox& box);
   int log_failed_line(ToolBox& box, const char* task_type, int64_t task_id, int64_t line_num, int err_code);
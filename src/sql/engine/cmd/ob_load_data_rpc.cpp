@@ -29,6 +29,7 @@
 #include "sql/code_generator/ob_code_generator.h"
 #include "sql/engine/ob_exec_context.h"
 #include "sql/engine/cmd/ob_load_data_impl.h"
+#include "sql/engine/cmd/ob_load_data_direct.h"
 
 using namespace oceanbase::sql;
 using namespace oceanbase::common;
@@ -566,6 +567,10 @@ int ObRpcLoadDataInsertTaskExecuteP::process()
   if (OB_UNLIKELY(THIS_WORKER.is_timeout())) {
     ret = OB_TIMEOUT;
     LOG_WARN("LOAD DATA shuffle task timeout", K(ret), K(task));
+  } else if (task.is_direct_load_) {
+    if (OB_FAIL(ObLoadDataDirectMgr::get_instance().add_rows(task))) {
+      LOG_WARN("fail to add rows of direct load", K(ret));
+    }
   } else if (OB_FAIL(ObLoadDataSPImpl::exec_insert(task, result))) {
     LOG_WARN("fail to exec insert", K(ret));
   }
@@ -585,6 +590,46 @@ int ObRpcLoadDataInsertTaskExecuteP::process()
   return OB_SUCCESS;
 }
 
+int ObRpcLoadDataDirectFinishP::process()
+{
+  int ret = OB_SUCCESS;
+  ObLoadDataDirectFinishArg& arg = arg_;
+  ObLoadDataDirectFinishResult& result = result_;
+  result.row_count_ = 0;
+
+  if (OB_UNLIKELY(!arg.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(arg));
+  } else if ((ObLoadDataDirectFinishArg::PREPARE == arg.phase_ || ObLoadDataDirectFinishArg::PUBLISH == arg.phase_) &&
+             OB_UNLIKELY(THIS_WORKER.is_timeout())) {
+    ret = OB_TIMEOUT;
+    LOG_WARN("LOAD DATA direct finish timeout", K(ret), K(arg));
+  } else if (OB_FAIL(ObLoadDataDirectMgr::get_instance().finish(arg, result.row_count_))) {
+    LOG_WARN("fail to finish direct load", K(ret), K(arg));
+  }
+  return ret;
+}
+
+int ObRpcLoadDataDirectCheckP::process()
+{
+  int ret = OB_SUCCESS;
+  ObLoadDataDirectCheckArg& arg = arg_;
+  ObLoadDataDirectCheckResult& result = result_;
+  result.is_synced_ = false;
+
+  if (OB_UNLIKELY(!arg.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(arg));
+  } else if (OB_ISNULL(gctx_.par_ser_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("partition service is null", K(ret));
+  } else if (OB_FAIL(gctx_.par_ser_->check_direct_load_sstable(
+                 arg.table_key_.pkey_, arg.table_key_, arg.row_count_, result.is_synced_))) {
+    LOG_WARN("fail to check direct load sstable", K(ret), K(arg));
+  }
+  return ret;
+}
+
 int ObInsertResult::assign(const ObInsertResult& other)
 {
   int ret = OB_SUCCESS;
@@ -705,8 +750,14 @@ OB_DEF_SERIALIZE_SIZE(ObLoadResult)
 OB_SERIALIZE_MEMBER(ObShuffleTask, task_id_, shuffle_task_handle_, gid_);
 OB_SERIALIZE_MEMBER(ObShuffleResult, task_id_, flags_, exec_ret_, row_cnt_);
 
-OB_SERIALIZE_MEMBER(
-    ObInsertTask, tenant_id_, task_id_, row_count_, column_count_, insert_stmt_head_, insert_value_data_);
+OB_SERIALIZE_MEMBER(ObLoadDataDirectKey, coordinator_, load_id_, pkey_);
+OB_SERIALIZE_MEMBER(ObLoadDataDirectFinishArg, coordinator_, load_id_, pkeys_, tenant_id_, phase_);
+OB_SERIALIZE_MEMBER(ObLoadDataDirectFinishResult, row_count_);
+OB_SERIALIZE_MEMBER(ObLoadDataDirectCheckArg, tenant_id_, table_key_, row_count_);
+OB_SERIALIZE_MEMBER(ObLoadDataDirectCheckResult, is_synced_);
+
+OB_SERIALIZE_MEMBER(ObInsertTask, tenant_id_, task_id_, row_count_, column_count_, insert_stmt_head_,
+    insert_value_data_, is_direct_load_, direct_key_, table_schema_version_, column_ids_, tz_info_wrap_);
 OB_SERIALIZE_MEMBER(ObInsertResult, flags_, exec_ret_, failed_row_offset_, row_errors_);
 
 }  // namespace sql
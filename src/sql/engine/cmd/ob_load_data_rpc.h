@@ -17,12 +17,16 @@
 #include "rpc/obrpc/ob_rpc_proxy.h"
 #include "rpc/obrpc/ob_rpc_processor.h"
 #include "lib/container/ob_bit_set.h"
+#include "lib/container/ob_array_serialization.h"
 #include "lib/lock/ob_thread_cond.h"
 #include "sql/ob_sql_utils.h"
 #include "sql/engine/cmd/ob_load_data_utils.h"
 #include "share/config/ob_server_config.h"
 #include "observer/ob_server_struct.h"
 #include "lib/lock/ob_spin_lock.h"
+#include "lib/timezone/ob_timezone_info.h"
+#include "common/ob_partition_key.h"
+#include "storage/ob_i_table.h"
 
 namespace oceanbase {
 namespace observer {
@@ -36,6 +40,10 @@ class ObLoadFileBuffer;
 class ObDesExecContext;
 class ObShuffleTask;
 class ObShuffleResult;
+class ObLoadDataDirectFinishArg;
+class ObLoadDataDirectFinishResult;
+class ObLoadDataDirectCheckArg;
+class ObLoadDataDirectCheckResult;
 class ObInsertTask;
 class ObInsertResult;
 class ObDataFragMgr;
@@ -53,6 +61,10 @@ public:
   RPC_AP(@PR5 ap_load_data_execute, obrpc::OB_LOAD_DATA_EXECUTE, (sql::ObLoadbuffer), sql::ObLoadResult);
   RPC_AP(@PR5 ap_load_data_shuffle, obrpc::OB_LOAD_DATA_SHUFFLE, (sql::ObShuffleTask), sql::ObShuffleResult);
   RPC_AP(@PR5 ap_load_data_insert, obrpc::OB_LOAD_DATA_INSERT, (sql::ObInsertTask), sql::ObInsertResult);
+  RPC_S(@PR5 load_data_direct_finish, obrpc::OB_LOAD_DATA_DIRECT_FINISH, (sql::ObLoadDataDirectFinishArg),
+      sql::ObLoadDataDirectFinishResult);
+  RPC_S(@PR5 load_data_direct_check, obrpc::OB_LOAD_DATA_DIRECT_CHECK, (sql::ObLoadDataDirectCheckArg),
+      sql::ObLoadDataDirectCheckResult);
 };
 }  // namespace obrpc
 
@@ -142,6 +154,102 @@ struct ObInsertResult {
   OB_UNIS_VERSION(1);
 };
 
+// identify the rows of one partition sent by one LOAD DATA statement in direct load mode
+struct ObLoadDataDirectKey {
+  ObLoadDataDirectKey() : load_id_(common::OB_INVALID_ID)
+  {}
+  void reset()
+  {
+    coordinator_.reset();
+    load_id_ = common::OB_INVALID_ID;
+    pkey_.reset();
+  }
+  bool is_valid() const
+  {
+    return coordinator_.is_valid() && common::OB_INVALID_ID != load_id_ && pkey_.is_valid();
+  }
+  uint64_t hash() const
+  {
+    uint64_t hash_val = coordinator_.hash();
+    hash_val = common::murmurhash(&load_id_, sizeof(load_id_), hash_val);
+    hash_val = common::murmurhash(&hash_val, sizeof(hash_val), pkey_.hash());
+    return hash_val;
+  }
+  bool operator==(const ObLoadDataDirectKey& other) const
+  {
+    return coordinator_ == other.coordinator_ && load_id_ == other.load_id_ && pkey_ == other.pkey_;
+  }
+  common::ObAddr coordinator_;  // server executing the LOAD DATA statement
+  int64_t load_id_;             // ObLoadDataGID of the statement on the coordinator
+  common::ObPartitionKey pkey_;
+  TO_STRING_KV(K_(coordinator), K_(load_id), K_(pkey));
+  OB_UNIS_VERSION(1);
+};
+
+// one request carries a phase of all partitions of the statement on their leader: all partitions are prepared,
+// then published at once, then committed, or all of them are aborted
+struct ObLoadDataDirectFinishArg {
+  enum Phase {
+    PREPARE = 0,  // sort rows and write them into macro blocks with the snapshot of the load
+    PUBLISH,      // replace the empty major sstables in one slog transaction and wait followers to sync
+    COMMIT,       // release the partition ctxs
+    ABORT,        // drop the sorted rows and roll back the published partitions
+    MAX_PHASE
+  };
+  ObLoadDataDirectFinishArg()
+      : load_id_(common::OB_INVALID_ID), tenant_id_(common::OB_INVALID_TENANT_ID), phase_(MAX_PHASE)
+  {}
+  bool is_valid() const
+  {
+    return common::OB_INVALID_TENANT_ID != tenant_id_ && coordinator_.is_valid() &&
+           common::OB_INVALID_ID != load_id_ && !pkeys_.empty() && phase_ >= PREPARE && phase_ < MAX_PHASE;
+  }
+  void get_key(const int64_t idx, ObLoadDataDirectKey& key) const
+  {
+    key.coordinator_ = coordinator_;
+    key.load_id_ = load_id_;
+    key.pkey_ = pkeys_.at(idx);
+  }
+  common::ObAddr coordinator_;
+  int64_t load_id_;
+  common::ObSArray<common::ObPartitionKey> pkeys_;
+  uint64_t tenant_id_;
+  int64_t phase_;
+  TO_STRING_KV(K_(coordinator), K_(load_id), K_(pkeys), K_(tenant_id), K_(phase));
+  OB_UNIS_VERSION(1);
+};
+
+struct ObLoadDataDirectFinishResult {
+  ObLoadDataDirectFinishResult() : row_count_(0)
+  {}
+  int64_t row_count_;
+  TO_STRING_KV(K_(row_count));
+  OB_UNIS_VERSION(1);
+};
+
+// sent by the leader to its followers, a follower is synced once it has rebuilt with the published sstable
+struct ObLoadDataDirectCheckArg {
+  ObLoadDataDirectCheckArg() : tenant_id_(common::OB_INVALID_TENANT_ID), row_count_(0)
+  {}
+  bool is_valid() const
+  {
+    return common::OB_INVALID_TENANT_ID != tenant_id_ && table_key_.is_valid() && row_count_ >= 0;
+  }
+  uint64_t tenant_id_;
+  storage::ObITable::TableKey table_key_;
+  int64_t row_count_;
+  TO_STRING_KV(K_(tenant_id), K_(table_key), K_(row_count));
+  OB_UNIS_VERSION(1);
+};
+
+struct ObLoadDataDirectCheckResult {
+  ObLoadDataDirectCheckResult() : is_synced_(false)
+  {}
+  bool is_synced_;
+  TO_STRING_KV(K_(is_synced));
+  OB_UNIS_VERSION(1);
+};
+
 struct ObInsertTask {
   static constexpr int64_t RETRY_LIMIT = 3;
   static constexpr int64_t COMMON_SIZE = 10;
@@ -174,6 +282,11 @@ struct ObInsertTask {
     insert_stmt_head_.reset();
     insert_value_data_.reset();
     source_frag_.reset();
+    is_direct_load_ = false;
+    direct_key_.reset();
+    table_schema_version_ = common::OB_INVALID_VERSION;
+    column_ids_.reset();
+    tz_info_wrap_.reset();
   }
 
   bool is_empty_task()
@@ -181,7 +294,8 @@ struct ObInsertTask {
     return task_id_ == OB_INVALID_ID;
   }
 
-  TO_STRING_KV(K(tenant_id_), K(task_id_), K(row_count_), K(column_count_), K(insert_value_data_.count()));
+  TO_STRING_KV(K(tenant_id_), K(task_id_), K(row_count_), K(column_count_), K(insert_value_data_.count()),
+      K(is_direct_load_), K(direct_key_));
 
   // serialized data:
   uint64_t tenant_id_;
@@ -197,6 +311,14 @@ struct ObInsertTask {
   // + for serialize
   common::ObSEArray<common::ObString, COMMON_SIZE> insert_value_data_;
 
+  // direct load: rows are cast and sorted on the leader and written to major sstable when the load finishes,
+  // insert_stmt_head_ is not used
+  bool is_direct_load_;
+  ObLoadDataDirectKey direct_key_;
+  int64_t table_schema_version_;
+  common::ObSEArray<uint64_t, EXPECTED_INSERT_COLUMN_NUM> column_ids_;  // column of each value in a row
+  common::ObTimeZoneInfoWrap tz_info_wrap_;
+
   // no serialized data
   common::ObSEArray<void*, COMMON_SIZE> source_frag_;
   ObPartDataFragMgr* part_mgr;
@@ -653,6 +775,36 @@ private:
   const observer::ObGlobalContext& gctx_;
 };
 
+class ObRpcLoadDataDirectFinishP
+    : public oceanbase::obrpc::ObRpcProcessor<obrpc::ObLoadDataRpcProxy::ObRpc<obrpc::OB_LOAD_DATA_DIRECT_FINISH> > {
+public:
+  explicit ObRpcLoadDataDirectFinishP(const observer::ObGlobalContext& gctx) : gctx_(gctx)
+  {}
+  virtual ~ObRpcLoadDataDirectFinishP()
+  {}
+
+protected:
+  int process();
+
+private:
+  const observer::ObGlobalContext& gctx_;
+};
+
+class ObRpcLoadDataDirectCheckP
+    : public oceanbase::obrpc::ObRpcProcessor<obrpc::ObLoadDataRpcProxy::ObRpc<obrpc::OB_LOAD_DATA_DIRECT_CHECK> > {
+public:
+  explicit ObRpcLoadDataDirectCheckP(const observer::ObGlobalContext& gctx) : gctx_(gctx)
+  {}
+  virtual ~ObRpcLoadDataDirectCheckP()
+  {}
+
+protected:
+  int process();
+
+private:
+  const observer::ObGlobalContext& gctx_;
+};
+
 class ObRpcLoadDataInsertTaskCallBack : public obrpc::ObLoadDataRpcProxy::AsyncCB<obrpc::OB_LOAD_DATA_INSERT> {
 public:
   ObRpcLoadDataInsertTaskCallBack(ObParallelTaskController& task_controller,
@@ -15,6 +15,9 @@
 #include "sql/engine/cmd/ob_load_data_utils.h"
 #include "sql/resolver/cmd/ob_load_data_stmt.h"
 #include "sql/session/ob_sql_session_info.h"
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 namespace oceanbase {
 using namespace common;
@@ -264,6 +267,123 @@ bool ObKMPStateMachine::scan_buf(char*& cur_pos, const char* buf_end)
   return matched;
 }
 
+int ObCSVSpecialCharScanner::add_char(const int64_t c)
+{
+  int ret = OB_SUCCESS;
+  if (c < CHAR_MIN || c > CHAR_MAX || is_special(static_cast<char>(c))) {
+    // never matched or already added
+  } else if (OB_UNLIKELY(char_cnt_ >= MAX_SPECIAL_CHAR_NUM)) {
+    ret = OB_SIZE_OVERFLOW;
+    LOG_WARN("too many special chars", K(ret), K(c), K(*this));
+  } else {
+    chars_[char_cnt_++] = static_cast<char>(c);
+    is_special_[static_cast<uint8_t>(c)] = true;
+  }
+  return ret;
+}
+
+const char* ObCSVSpecialCharScanner::scan_scalar(
+    const ObCSVSpecialCharScanner& scanner, const char* begin, const char* end)
+{
+  const char* pos = begin;
+  while (pos < end && !scanner.is_special(*pos)) {
+    ++pos;
+  }
+  return pos;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) const char* ObCSVSpecialCharScanner::scan_sse42(
+    const ObCSVSpecialCharScanner& scanner, const char* begin, const char* end)
+{
+  static const int64_t STRIDE = sizeof(__m128i);
+  const char* pos = begin;
+  bool found = false;
+  if (scanner.char_cnt_ > 0) {
+    const __m128i needle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(scanner.chars_));
+    for (; !found && pos + STRIDE <= end; pos += STRIDE) {
+      const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+      const int idx = _mm_cmpestri(
+          needle, scanner.char_cnt_, data, STRIDE, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+      if (idx < STRIDE) {
+        found = true;
+        pos += idx - STRIDE;  // compensate the step of the loop
+      }
+    }
+  }
+  return found ? pos : scan_scalar(scanner, pos, end);
+}
+
+__attribute__((target("avx2"))) const char* ObCSVSpecialCharScanner::scan_avx2(
+    const ObCSVSpecialCharScanner& scanner, const char* begin, const char* end)
+{
+  static const int64_t STRIDE = sizeof(__m256i);
+  const char* pos = begin;
+  bool found = false;
+  if (scanner.char_cnt_ > 0) {
+    // unused slots repeat the first char, so that 4 compares are always enough
+    const char* chars = scanner.chars_;
+    const int32_t cnt = scanner.char_cnt_;
+    const __m256i c0 = _mm256_set1_epi8(chars[0]);
+    const __m256i c1 = _mm256_set1_epi8(chars[cnt > 1 ? 1 : 0]);
+    const __m256i c2 = _mm256_set1_epi8(chars[cnt > 2 ? 2 : 0]);
+    const __m256i c3 = _mm256_set1_epi8(chars[cnt > 3 ? 3 : 0]);
+    for (; !found && pos + STRIDE <= end; pos += STRIDE) {
+      const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos));
+      const __m256i matched = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(data, c0), _mm256_cmpeq_epi8(data, c1)),
+          _mm256_or_si256(_mm256_cmpeq_epi8(data, c2), _mm256_cmpeq_epi8(data, c3)));
+      const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(matched));
+      if (0 != mask) {
+        found = true;
+        pos += __builtin_ctz(mask) - STRIDE;  // compensate the step of the loop
+      }
+    }
+  }
+  return found ? pos : scan_scalar(scanner, pos, end);
+}
+#endif
+
+const char* ObCSVSpecialCharScanner::scan_dispatch(
+    const ObCSVSpecialCharScanner& scanner, const char* begin, const char* end)
+{
+#if defined(__x86_64__)
+  uint32_t a = 0;
+  uint32_t b = 0;
+  uint32_t c = 0;
+  uint32_t d = 0;
+  bool has_avx2 = false;
+
+  asm("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "0"(1));
+  const bool has_sse42 = (c & (1 << 20)) != 0;
+  // avx needs the support of os to save ymm registers, check OSXSAVE and XCR0 first
+  if ((c & (1 << 27)) != 0 && (c & (1 << 28)) != 0) {
+    uint32_t xcr0_lo = 0;
+    uint32_t xcr0_hi = 0;
+    asm("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    if ((xcr0_lo & 0x6) == 0x6) {
+      asm("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "0"(7), "2"(0));
+      has_avx2 = (b & (1 << 5)) != 0;
+    }
+  }
+  if (has_avx2) {
+    scan_func_ = &scan_avx2;
+    _OB_LOG(INFO, "Use avx2 instructs for csv special char scanning");
+  } else if (has_sse42) {
+    scan_func_ = &scan_sse42;
+    _OB_LOG(INFO, "Use sse4.2 instructs for csv special char scanning");
+  } else {
+    scan_func_ = &scan_scalar;
+    _OB_LOG(INFO, "Use table lookup for csv special char scanning");
+  }
+#else
+  scan_func_ = &scan_scalar;
+  _OB_LOG(INFO, "Use table lookup for csv special char scanning");
+#endif
+  return scan_func_(scanner, begin, end);
+}
+
+ObCSVSpecialCharScanner::ScanFunc ObCSVSpecialCharScanner::scan_func_ = &ObCSVSpecialCharScanner::scan_dispatch;
+
 int ObKMPStateMachine::init(ObIAllocator& allocator, const ObString& str)
 {
   int ret = OB_SUCCESS;
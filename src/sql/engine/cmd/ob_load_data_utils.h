@@ -297,6 +297,59 @@ private:
   int32_t* next_;        // next array of KMP algorithm
 };
 
+/*
+ * ObCSVSpecialCharScanner finds the next byte which is one of a few special chars
+ * (terminators, enclose and escape chars) in a char stream.
+ * Bytes between special chars need no handling other than copying, so the csv parser
+ * jumps over them in one step. 32 or 16 bytes are compared at a time with AVX2 or SSE4.2,
+ * which is chosen by cpuid at the first call, other cpus fall back to a table lookup loop.
+ */
+class ObCSVSpecialCharScanner {
+public:
+  static const int64_t MAX_SPECIAL_CHAR_NUM = 4;
+  typedef const char* (*ScanFunc)(const ObCSVSpecialCharScanner& scanner, const char* begin, const char* end);
+
+  ObCSVSpecialCharScanner()
+  {
+    reset();
+  }
+  void reset()
+  {
+    MEMSET(chars_, 0, sizeof(chars_));
+    MEMSET(is_special_, 0, sizeof(is_special_));
+    char_cnt_ = 0;
+  }
+  /*
+   * the format chars are int64_t, compared with a char after sign extension,
+   * so a value out of the range of char never matches and is ignored
+   */
+  int add_char(const int64_t c);
+  OB_INLINE bool is_special(const char c) const
+  {
+    return is_special_[static_cast<uint8_t>(c)];
+  }
+  // return the first special char in [begin, end), or end if not found
+  OB_INLINE const char* find(const char* begin, const char* end) const
+  {
+    return scan_func_(*this, begin, end);
+  }
+  static const char* scan_scalar(const ObCSVSpecialCharScanner& scanner, const char* begin, const char* end);
+  TO_STRING_KV(K_(char_cnt), "chars", common::ObString(char_cnt_, chars_));
+
+private:
+  static const char* scan_dispatch(const ObCSVSpecialCharScanner& scanner, const char* begin, const char* end);
+#if defined(__x86_64__)
+  static const char* scan_sse42(const ObCSVSpecialCharScanner& scanner, const char* begin, const char* end);
+  static const char* scan_avx2(const ObCSVSpecialCharScanner& scanner, const char* begin, const char* end);
+#endif
+
+private:
+  static ScanFunc scan_func_;
+  char chars_[16];  // loaded as the needle of pcmpestri, only the first char_cnt_ chars are valid
+  int32_t char_cnt_;
+  bool is_special_[UINT8_MAX + 1];
+};
+
 struct ObLoadDataGID {
   static volatile int64_t GlobalLoadDataID;
   static void generate_new_id(ObLoadDataGID& gid)
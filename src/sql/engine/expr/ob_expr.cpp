@@ -19,6 +19,7 @@
 #include "sql/engine/expr/ob_expr_calc_partition_id.h"
 #include "sql/engine/expr/ob_expr_extra_info_factory.h"
 #include "sql/engine/expr/ob_datum_cast.h"
+#include "sql/engine/ob_bit_vector.h"
 
 namespace oceanbase {
 using namespace common;
@@ -31,7 +32,12 @@ STATIC_ASSERT(sizeof(ObPrecision) == sizeof(ObLengthSemantics), "size of ObPreci
 OB_SERIALIZE_MEMBER(ObDatumMeta, type_, cs_type_, scale_, precision_);
 
 ObEvalCtx::ObEvalCtx(ObExecContext& exec_ctx, ObArenaAllocator& res_alloc, ObArenaAllocator& tmp_alloc)
-    : frames_(exec_ctx.get_frames()), exec_ctx_(exec_ctx), expr_res_alloc_(res_alloc), tmp_alloc_(tmp_alloc)
+    : frames_(exec_ctx.get_frames()),
+      exec_ctx_(exec_ctx),
+      batch_idx_(0),
+      batch_size_(0),
+      expr_res_alloc_(res_alloc),
+      tmp_alloc_(tmp_alloc)
 
 {}
 
@@ -75,7 +81,7 @@ OB_DEF_SERIALIZE(ObExpr)
     }
   }
 
-  LST_DO_CODE(OB_UNIS_ENCODE, eval_info_off_);
+  LST_DO_CODE(OB_UNIS_ENCODE, eval_info_off_, batch_idx_mask_, res_buf_stride_);
 
   return ret;
 }
@@ -112,7 +118,7 @@ OB_DEF_DESERIALIZE(ObExpr)
     }
   }
 
-  LST_DO_CODE(OB_UNIS_DECODE, eval_info_off_);
+  LST_DO_CODE(OB_UNIS_DECODE, eval_info_off_, batch_idx_mask_, res_buf_stride_);
   if (0 == eval_info_off_ && OB_SUCC(ret)) {
     // compatible with 3.0, ObExprDatum::flag_ is ObEvalInfo
     eval_info_off_ = datum_off_ + sizeof(ObDatum);
@@ -153,7 +159,7 @@ OB_DEF_SERIALIZE_SIZE(ObExpr)
     OB_UNIS_ADD_LEN(extra_);
   }
 
-  LST_DO_CODE(OB_UNIS_ADD_LEN, eval_info_off_);
+  LST_DO_CODE(OB_UNIS_ADD_LEN, eval_info_off_, batch_idx_mask_, res_buf_stride_);
 
   return len;
 }
@@ -180,7 +186,9 @@ ObExpr::ObExpr()
       res_buf_len_(0),
       expr_ctx_id_(INVALID_EXP_CTX_ID),
       extra_(0),
-      basic_funcs_(NULL)
+      basic_funcs_(NULL),
+      batch_idx_mask_(0),
+      res_buf_stride_(0)
 {}
 
 char* ObExpr::alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
@@ -190,8 +198,7 @@ char* ObExpr::alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
   if (OB_UNLIKELY(!ObDynReserveBuf::supported(datum_meta_.type_))) {
     LOG_ERROR("unexpected alloc string result memory called", K(size), K(*this));
   } else {
-    ObDynReserveBuf* drb =
-        reinterpret_cast<ObDynReserveBuf*>(ctx.frames_[frame_idx_] + res_buf_off_ - sizeof(ObDynReserveBuf));
+    ObDynReserveBuf* drb = reinterpret_cast<ObDynReserveBuf*>(get_res_buf(ctx) - sizeof(ObDynReserveBuf));
     if (OB_LIKELY(drb->len_ >= size)) {
       mem = drb->mem_;
     } else {
@@ -217,6 +224,58 @@ char* ObExpr::alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
   return mem;
 };
 
+void ObExpr::clear_batch_row_evaluated_flag(ObEvalCtx& ctx) const
+{
+  for (uint32_t i = 0; i < arg_cnt_; i++) {
+    const ObExpr* e = args_[i];
+    if (NULL != e && e->is_batch_result()) {
+      ObEvalInfo& info = e->get_eval_info(ctx);
+      // projected expression is evaluated for the whole batch, no need to evaluate again.
+      if (!info.projected_) {
+        info.evaluated_ = false;
+        e->clear_batch_row_evaluated_flag(ctx);
+      }
+    }
+  }
+}
+
+int ObExpr::eval_batch(ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size) const
+{
+  int ret = OB_SUCCESS;
+  ObEvalInfo& info = get_eval_info(ctx);
+  ObDatum* datum = NULL;
+  if (!is_batch_result()) {
+    // non batch result expression has only one datum, evaluate once.
+    ret = eval(ctx, datum);
+  } else if (info.projected_ && info.cnt_ >= size) {
+    // already evaluated in batch
+  } else if (NULL == eval_func_) {
+    // column reference expression, datums are filled by operator.
+    info.projected_ = true;
+    info.cnt_ = static_cast<uint16_t>(size);
+  } else {
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(ctx);
+    batch_info_guard.set_batch_size(size);
+    for (int64_t i = 0; OB_SUCC(ret) && i < size; i++) {
+      if (skip.at(i)) {
+        continue;
+      }
+      batch_info_guard.set_batch_idx(i);
+      info.evaluated_ = false;
+      clear_batch_row_evaluated_flag(ctx);
+      if (OB_FAIL(eval(ctx, datum))) {
+        LOG_WARN("expr evaluate failed", K(ret), K(i), K(*this));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      info.evaluated_ = true;
+      info.projected_ = true;
+      info.cnt_ = static_cast<uint16_t>(size);
+    }
+  }
+  return ret;
+}
+
 int ObExpr::eval_enumset(ObEvalCtx& ctx, const common::ObIArray<common::ObString>& str_values, const uint64_t cast_mode,
     common::ObDatum*& datum) const
 {
@@ -224,13 +283,14 @@ int ObExpr::eval_enumset(ObEvalCtx& ctx, const common::ObIArray<common::ObString
   int ret = common::OB_SUCCESS;
   char* frame = ctx.frames_[frame_idx_];
   OB_ASSERT(NULL != frame);
-  datum = (ObDatum*)(frame + datum_off_);
+  datum = &locate_expr_datum(ctx);
   ObEvalInfo* eval_info = (ObEvalInfo*)(frame + eval_info_off_);
 
   // do nothing for const/column reference expr or already evaluated expr
   if (!eval_info->evaluated_) {
-    if (datum->ptr_ != frame + res_buf_off_) {
-      datum->ptr_ = frame + res_buf_off_;
+    char* res_buf = get_res_buf(ctx);
+    if (datum->ptr_ != res_buf) {
+      datum->ptr_ = res_buf;
     }
     const common::ObObjTypeClass in_tc = args_[0]->obj_meta_.get_type_class();
     EvalEnumSetFunc eval_func;
@@ -30,6 +30,7 @@ using lib::is_oracle_mode;
 
 class ObExecContext;
 class ObIExprExtraInfo;
+struct ObBitVector;
 using common::ObDatum;
 
 typedef ObItemType ObExprOperatorType;
@@ -80,8 +81,10 @@ public:
 struct ObEvalInfo {
   void clear_evaluated_flag()
   {
-    if (evaluated_) {
+    if (flag_) {
       evaluated_ = false;
+      projected_ = false;
+      cnt_ = 0;
     }
   }
   DECLARE_TO_STRING;
@@ -110,6 +113,51 @@ struct ObEvalCtx {
   friend class ObExpr;
   ObEvalCtx(ObExecContext& exec_ctx, common::ObArenaAllocator& res_alloc, common::ObArenaAllocator& tmp_alloc);
 
+  // Row index of current batch, only batch result expressions (ObExpr::is_batch_result())
+  // locate datum by this index.
+  OB_INLINE int64_t get_batch_idx() const
+  {
+    return batch_idx_;
+  }
+  OB_INLINE void set_batch_idx(const int64_t batch_idx)
+  {
+    batch_idx_ = batch_idx;
+  }
+  OB_INLINE int64_t get_batch_size() const
+  {
+    return batch_size_;
+  }
+  OB_INLINE void set_batch_size(const int64_t batch_size)
+  {
+    batch_size_ = batch_size;
+  }
+
+  // Save batch index and batch size, restore them when out of scope.
+  class BatchInfoScopeGuard {
+  public:
+    explicit BatchInfoScopeGuard(ObEvalCtx& eval_ctx)
+        : eval_ctx_(eval_ctx), batch_idx_(eval_ctx.batch_idx_), batch_size_(eval_ctx.batch_size_)
+    {}
+    ~BatchInfoScopeGuard()
+    {
+      eval_ctx_.batch_idx_ = batch_idx_;
+      eval_ctx_.batch_size_ = batch_size_;
+    }
+    void set_batch_idx(const int64_t batch_idx)
+    {
+      eval_ctx_.batch_idx_ = batch_idx;
+    }
+    void set_batch_size(const int64_t batch_size)
+    {
+      eval_ctx_.batch_size_ = batch_size;
+    }
+
+  private:
+    ObEvalCtx& eval_ctx_;
+    int64_t batch_idx_;
+    int64_t batch_size_;
+  };
+
   common::ObArenaAllocator& get_reset_tmp_alloc()
   {
 #ifndef NDEBUG
@@ -134,6 +182,8 @@ public:
   ObExecContext& exec_ctx_;
 
 private:
+  int64_t batch_idx_;
+  int64_t batch_size_;
   // Expression result allocator, never reset.
   common::ObArenaAllocator& expr_res_alloc_;
 
@@ -193,10 +243,33 @@ public:
   {
     new (this) ObExpr();
   }
+  // Expression evaluated in batch has %batch_size datums and reserved buffers in frame,
+  // located by ObEvalCtx::get_batch_idx(). Other expressions (const, param...) always
+  // locate the first datum (batch_idx_mask_ is zero).
+  OB_INLINE bool is_batch_result() const
+  {
+    return 0 != batch_idx_mask_;
+  }
+  OB_INLINE int64_t get_datum_idx(const ObEvalCtx& ctx) const
+  {
+    return ctx.get_batch_idx() & batch_idx_mask_;
+  }
+
   ObDatum& locate_expr_datum(ObEvalCtx& ctx) const
   {
     // performance critical, do not check pointer validity.
-    return *reinterpret_cast<ObDatum*>(ctx.frames_[frame_idx_] + datum_off_);
+    return reinterpret_cast<ObDatum*>(ctx.frames_[frame_idx_] + datum_off_)[get_datum_idx(ctx)];
+  }
+
+  ObDatum& locate_expr_datum(ObEvalCtx& ctx, const int64_t batch_idx) const
+  {
+    return reinterpret_cast<ObDatum*>(ctx.frames_[frame_idx_] + datum_off_)[batch_idx & batch_idx_mask_];
+  }
+
+  // datum array of batch result expression
+  ObDatum* locate_batch_datums(ObEvalCtx& ctx) const
+  {
+    return reinterpret_cast<ObDatum*>(ctx.frames_[frame_idx_] + datum_off_);
   }
 
   ObEvalInfo& get_eval_info(ObEvalCtx& ctx) const
@@ -215,9 +288,20 @@ public:
   // Dynamic allocated memory is allocated if reserved buffer if not enough.
   char* get_str_res_mem(ObEvalCtx& ctx, const int64_t size) const
   {
-    return OB_LIKELY(size <= res_buf_len_) ? ctx.frames_[frame_idx_] + res_buf_off_ : alloc_str_res_mem(ctx, size);
+    return OB_LIKELY(size <= res_buf_len_) ? get_res_buf(ctx) : alloc_str_res_mem(ctx, size);
   }
 
+  // reserved result buffer of current row
+  OB_INLINE char* get_res_buf(ObEvalCtx& ctx) const
+  {
+    return ctx.frames_[frame_idx_] + res_buf_off_ + get_datum_idx(ctx) * res_buf_stride_;
+  }
+
+  // Evaluate expression for all rows not skipped in batch, the result datums are located
+  // by locate_batch_datums(). Expression is marked as projected after evaluated, the datums
+  // will not be evaluated again until the evaluated flag cleared.
+  int eval_batch(ObEvalCtx& ctx, const ObBitVector& skip, const int64_t size) const;
+
   // Evaluate all parameters, assign the first sizeof...(args) parameters to %args.
   //
   // e.g.:
@@ -247,10 +331,13 @@ public:
 
   TO_STRING_KV("type", get_type_name(type_), K_(datum_meta), K_(obj_meta), K_(obj_datum_map), KP_(eval_func),
       KP_(inner_functions), K_(inner_func_cnt), K_(arg_cnt), K_(parent_cnt), K_(frame_idx), K_(datum_off),
-      K_(res_buf_off), K_(res_buf_len), K_(expr_ctx_id), K_(extra), KP(this));
+      K_(res_buf_off), K_(res_buf_len), K_(expr_ctx_id), K_(extra), K_(batch_idx_mask), K_(res_buf_stride),
+      KP(this));
 
 private:
   char* alloc_str_res_mem(ObEvalCtx& ctx, const int64_t size) const;
+  // clear evaluated flag of expressions need to be evaluated again for new row in batch.
+  void clear_batch_row_evaluated_flag(ObEvalCtx& ctx) const;
 
 public:
   typedef int (*EvalFunc)(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& expr_datum);
@@ -312,6 +399,10 @@ public:
     ObIExprExtraInfo* extra_info_;
   };
   ObExprBasicFuncs* basic_funcs_;
+  // mask of ObEvalCtx::batch_idx_ to locate datum, all bits set for batch result expression.
+  uint64_t batch_idx_mask_;
+  // reserve buffer (with dynamic reserve buffer header) size of each row in batch
+  uint32_t res_buf_stride_;
 };
 
 // helper template to access ObExpr::extra_
@@ -577,9 +668,11 @@ OB_INLINE ObDatum& ObExpr::locate_datum_for_write(ObEvalCtx& ctx) const
   // performance critical, do not check pointer validity.
   char* frame = ctx.frames_[frame_idx_];
   OB_ASSERT(NULL != frame);
-  ObDatum* expr_datum = (ObDatum*)(frame + datum_off_);
-  if (expr_datum->ptr_ != frame + res_buf_off_) {
-    expr_datum->ptr_ = frame + res_buf_off_;
+  const int64_t datum_idx = get_datum_idx(ctx);
+  ObDatum* expr_datum = (ObDatum*)(frame + datum_off_) + datum_idx;
+  char* res_buf = frame + res_buf_off_ + datum_idx * res_buf_stride_;
+  if (expr_datum->ptr_ != res_buf) {
+    expr_datum->ptr_ = res_buf;
   }
   return *expr_datum;
 }
@@ -604,13 +697,15 @@ OB_INLINE int ObExpr::eval(ObEvalCtx& ctx, common::ObDatum*& datum) const
   int ret = common::OB_SUCCESS;
   char* frame = ctx.frames_[frame_idx_];
   OB_ASSERT(NULL != frame);
-  datum = (ObDatum*)(frame + datum_off_);
+  const int64_t datum_idx = get_datum_idx(ctx);
+  datum = (ObDatum*)(frame + datum_off_) + datum_idx;
   ObEvalInfo* eval_info = (ObEvalInfo*)(frame + eval_info_off_);
 
   // do nothing for const/column reference expr or already evaluated expr
   if (NULL != eval_func_ && !eval_info->evaluated_) {
-    if (datum->ptr_ != frame + res_buf_off_) {
-      datum->ptr_ = frame + res_buf_off_;
+    char* res_buf = frame + res_buf_off_ + datum_idx * res_buf_stride_;
+    if (datum->ptr_ != res_buf) {
+      datum->ptr_ = res_buf;
     }
     ret = eval_func_(*this, ctx, *datum);
     if (OB_LIKELY(common::OB_SUCCESS == ret)) {
@@ -20,6 +20,7 @@
 #include "observer/omt/ob_tenant_config_mgr.h"
 #include "sql/engine/px/ob_px_util.h"
 #include "share/diagnosis/ob_sql_monitor_statname.h"
+#include "sql/engine/px/ob_px_sqc_handler.h"
 
 namespace oceanbase {
 using namespace omt;
@@ -31,10 +32,12 @@ ObHashJoinSpec::ObHashJoinSpec(common::ObIAllocator& alloc, const ObPhyOperatorT
       equal_join_conds_(alloc),
       all_join_keys_(alloc),
       all_hash_funcs_(alloc),
-      has_join_bf_(false)
+      has_join_bf_(false),
+      join_filter_bit_cnt_(0)
 {}
 
-OB_SERIALIZE_MEMBER((ObHashJoinSpec, ObJoinSpec), equal_join_conds_, all_join_keys_, all_hash_funcs_, has_join_bf_);
+OB_SERIALIZE_MEMBER((ObHashJoinSpec, ObJoinSpec), equal_join_conds_, all_join_keys_, all_hash_funcs_, has_join_bf_,
+    join_filter_bit_cnt_);
 
 int ObHashJoinOp::PartHashJoinTable::init(ObIAllocator& alloc)
 {
@@ -129,6 +132,8 @@ ObHashJoinOp::ObHashJoinOp(ObExecContext& ctx_, const ObOpSpec& spec, ObOpInput*
       has_fill_right_row_(false),
       has_fill_left_row_(false),
       right_last_row_(),
+      batch_probe_row_(ctx_.get_allocator()),
+      batch_probe_row_saved_(false),
       need_return_(false),
       iter_end_(false),
       opt_cache_aware_(false),
@@ -148,6 +153,9 @@ ObHashJoinOp::ObHashJoinOp(ObExecContext& ctx_, const ObOpSpec& spec, ObOpInput*
       cur_right_hist_(nullptr),
       cur_probe_row_idx_(0),
       max_right_bucket_idx_(0),
+      join_filter_(),
+      join_filter_sent_(false),
+      join_filter_reuse_hash_(false),
       probe_cnt_(0),
       bitset_filter_cnt_(0),
       hash_link_cnt_(0),
@@ -310,6 +318,9 @@ int ObHashJoinOp::inner_open()
         K(left_join_keys_.count()),
         K(right_join_keys_.count()));
   }
+  if (OB_SUCC(ret) && OB_FAIL(init_join_filter())) {
+    LOG_WARN("failed to init join filter", K(ret));
+  }
   if (OB_SUCC(ret)) {
     part_count_ = 0;
     hj_state_ = ObHashJoinOp::INIT;
@@ -335,6 +346,9 @@ int ObHashJoinOp::inner_open()
   if (OB_SUCC(ret)) {
     if (OB_FAIL(right_last_row_.init(*alloc_, right_->get_spec().output_.count()))) {
       LOG_WARN("failed to init right last row", K(ret));
+    } else {
+      batch_probe_row_.reuse_ = true;
+      batch_probe_row_saved_ = false;
     }
   }
   return ret;
@@ -460,6 +474,7 @@ int ObHashJoinOp::rescan()
     LOG_WARN("join rescan failed", K(ret));
   } else {
     iter_end_ = false;
+    batch_probe_row_saved_ = false;
   }
   LOG_TRACE("hash join rescan", K(ret));
   return ret;
@@ -580,6 +595,74 @@ int ObHashJoinOp::inner_get_next_row()
   return ret;
 }
 
+int ObHashJoinOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  const ObIArray<ObExpr*>& probe_exprs = right_->get_spec().output_;
+  int64_t size = 0;
+  eval_ctx_.set_batch_idx(0);
+  if (batch_probe_row_saved_) {
+    batch_probe_row_saved_ = false;
+    if (OB_FAIL(batch_probe_row_.store_row_->to_expr(probe_exprs, eval_ctx_))) {
+      LOG_WARN("restore probe row of last batch failed", K(ret));
+    }
+  }
+  while (OB_SUCC(ret) && size < max_row_cnt) {
+    if (size > 0 && size - 1 == eval_ctx_.get_batch_idx() && is_probe_row_continued() &&
+        OB_FAIL(copy_probe_row(size - 1, size))) {
+      LOG_WARN("copy probe row failed", K(ret), K(size));
+    } else if (FALSE_IT(eval_ctx_.set_batch_idx(size))) {
+    } else if (OB_FAIL(inner_get_next_row())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("inner get next row failed", K(ret));
+      } else {
+        ret = OB_SUCCESS;
+        brs_.end_ = true;
+      }
+      break;
+    } else if (OB_FAIL(add_batch_row(size))) {
+      LOG_WARN("add batch row failed", K(ret));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    brs_.size_ = size;
+    set_batch_evaluated(spec_.output_, size);
+    // datums of the last batch row may point to memory of this batch, deep copy the probe row.
+    if (!brs_.end_ && size > 0 && is_probe_row_continued() && probe_exprs.count() > 0) {
+      if (OB_FAIL(batch_probe_row_.save_store_row(probe_exprs, eval_ctx_))) {
+        LOG_WARN("save probe row failed", K(ret));
+      } else {
+        batch_probe_row_saved_ = true;
+      }
+    }
+  }
+  return ret;
+}
+
+bool ObHashJoinOp::is_probe_row_continued() const
+{
+  // probe row read from dumped partition is not converted to exprs yet, converted when joined.
+  return JS_READ_HASH_ROW == state_ && (NULL == right_read_row_ || has_fill_right_row_);
+}
+
+int ObHashJoinOp::copy_probe_row(const int64_t from_idx, const int64_t to_idx)
+{
+  int ret = OB_SUCCESS;
+  const ObIArray<ObExpr*>& probe_exprs = right_->get_spec().output_;
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+  batch_info_guard.set_batch_idx(from_idx);
+  ObDatum* datum = NULL;
+  for (int64_t i = 0; OB_SUCC(ret) && i < probe_exprs.count(); i++) {
+    // evaluate before copy, the child's datums of the probe row are only valid in %from_idx.
+    if (OB_FAIL(probe_exprs.at(i)->eval(eval_ctx_, datum))) {
+      LOG_WARN("expr evaluate failed", K(ret));
+    } else {
+      probe_exprs.at(i)->locate_expr_datum(eval_ctx_, to_idx) = *datum;
+    }
+  }
+  return ret;
+}
+
 void ObHashJoinOp::destroy()
 {
   if (OB_LIKELY(nullptr != alloc_)) {
@@ -589,6 +672,7 @@ void ObHashJoinOp::destroy()
     DESTROY_CONTEXT(mem_context_);
     mem_context_ = NULL;
   }
+  join_filter_.reset();
   ObJoinOp::destroy();
 }
 
@@ -598,6 +682,7 @@ int ObHashJoinOp::inner_close()
   sql_mem_processor_.unregister_profile();
   reset();
   tmp_hash_funcs_.reset();
+  join_filter_.reset();
   if (batch_mgr_ != NULL) {
     batch_mgr_->~ObHashJoinBatchMgr();
     if (OB_NOT_NULL(alloc_)) {
@@ -613,6 +698,7 @@ int ObHashJoinOp::inner_close()
     buf_mgr_ = NULL;
   }
   right_last_row_.reset();
+  batch_probe_row_saved_ = false;
   if (nullptr != alloc_) {
     hash_table_.free(alloc_);
     alloc_->reset();
@@ -1453,6 +1539,11 @@ int ObHashJoinOp::split_partition(int64_t& num_left_rows)
           }
         }
       }
+      if (OB_SUCC(ret) && join_filter_.is_inited() && top_part_level()) {
+        if (OB_FAIL(add_join_filter_row(hash_value))) {
+          LOG_WARN("fail to add row to join filter", K(ret));
+        }
+      }
     }
   }
   // overwrite OB_ITER_END error code
@@ -1500,6 +1591,69 @@ int ObHashJoinOp::split_partition(int64_t& num_left_rows)
   return ret;
 }
 
+int ObHashJoinOp::init_join_filter()
+{
+  int ret = OB_SUCCESS;
+  // filter is built only once by the first open, rescan reads the same build side again.
+  // The filter message is never sent to servers which can not handle it.
+  if (MY_SPEC.join_filter_bit_cnt_ > 0 && !join_filter_sent_ && nullptr != ctx_.get_sqc_handler() &&
+      GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_316) {
+    if (OB_FAIL(join_filter_.init(MY_SPEC.join_filter_bit_cnt_))) {
+      LOG_WARN("fail to init join filter", K(ret), K(MY_SPEC.join_filter_bit_cnt_));
+    } else {
+      join_filter_reuse_hash_ = 0 == tmp_hash_funcs_.count();
+    }
+  }
+  return ret;
+}
+
+int ObHashJoinOp::add_join_filter_row(const uint64_t hash_value)
+{
+  int ret = OB_SUCCESS;
+  if (join_filter_reuse_hash_) {
+    join_filter_.set(hash_value);
+  } else {
+    // the probe side always hashes with murmur, rehash if wy/xx hash is used by the join
+    uint64_t filter_hash = 0;
+    ObArrayHelper<ObHashFunc> murmur_funcs(left_join_keys_.count(),
+        const_cast<ObHashFunc*>(&MY_SPEC.all_hash_funcs_.at(0)),
+        left_join_keys_.count());
+    if (OB_FAIL(ObPxBloomFilter::calc_hash_value(left_join_keys_, murmur_funcs, eval_ctx_, filter_hash))) {
+      LOG_WARN("fail to calc join filter hash value", K(ret));
+    } else {
+      join_filter_.set(filter_hash);
+    }
+  }
+  return ret;
+}
+
+int ObHashJoinOp::send_join_filter()
+{
+  int ret = OB_SUCCESS;
+  ObPxSqcHandler* handler = ctx_.get_sqc_handler();
+  if (OB_ISNULL(handler)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("join filter only supported in parallel execution mode", K(ret));
+  } else {
+    ObPxSQCProxy& proxy = handler->get_sqc_proxy();
+    ObJoinFilterPieceMsg piece;
+    piece.op_id_ = MY_SPEC.id_;
+    piece.thread_id_ = GETTID();
+    piece.dfo_id_ = proxy.get_dfo_id();
+    piece.is_build_ = true;
+    if (OB_FAIL(piece.filter_.assign(join_filter_))) {
+      LOG_WARN("fail to assign join filter", K(ret));
+    } else if (OB_FAIL(proxy.send_dh_piece(piece, ctx_.get_physical_plan_ctx()->get_timeout_timestamp()))) {
+      LOG_WARN("fail to send join filter piece", K(ret));
+    } else {
+      LOG_TRACE("join filter sent", K(MY_SPEC.id_), "fill_ratio", join_filter_.get_fill_ratio());
+    }
+  }
+  join_filter_sent_ = true;
+  join_filter_.reset();
+  return ret;
+}
+
 void ObHashJoinOp::free_bloom_filter()
 {
   if (nullptr != bloom_filter_) {
@@ -2412,6 +2566,8 @@ int ObHashJoinOp::split_partition_and_build_hash_table(int64_t& num_left_rows)
   num_left_rows = 0;
   if (OB_FAIL(split_partition(num_left_rows))) {
     LOG_WARN("failed split partition", K(ret), K(part_level_));
+  } else if (join_filter_.is_inited() && top_part_level() && OB_FAIL(send_join_filter())) {
+    LOG_WARN("failed to send join filter", K(ret));
   } else {
     can_use_cache_aware_opt();
     if (0 == num_left_rows && OB_FAIL(recursive_postprocess())) {
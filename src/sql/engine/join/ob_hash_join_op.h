@@ -20,6 +20,7 @@
 #include "sql/engine/ob_sql_mem_mgr_processor.h"
 #include "lib/container/ob_2d_array.h"
 #include "sql/engine/aggregate/ob_exec_hash_struct.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 
 namespace oceanbase {
 namespace sql {
@@ -34,6 +35,8 @@ public:
   ExprFixedArray all_join_keys_;
   common::ObHashFuncs all_hash_funcs_;
   bool has_join_bf_;
+  // bit count of the bloom filter shipped to the probe side through datahub, 0 means no join filter
+  int64_t join_filter_bit_cnt_;
 };
 
 // hash join has no expression result overwrite problem:
@@ -371,10 +374,16 @@ public:
   virtual int inner_open() override;
   virtual int rescan() override;
   virtual int inner_get_next_row() override;
+  // Children are executed row by row and write their rows to the batch row being filled,
+  // see ObStaticEngineCG::disable_batch_below_hash_join().
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
   virtual void destroy() override;
   virtual int inner_close() override;
 
 private:
+  // The probe row may join with more build rows, it is copied to the next batch row.
+  bool is_probe_row_continued() const;
+  int copy_probe_row(const int64_t from_idx, const int64_t to_idx);
   void calc_cache_aware_partition_count();
   int recursive_postprocess();
   int insert_batch_row(const int64_t cur_partition_in_memory);
@@ -442,6 +451,9 @@ private:
   int update_remain_data_memory_size_periodically(int64_t row_count, bool& need_dump);
   int dump_build_table(int64_t row_count);
   int split_partition(int64_t& num_left_rows);
+  int init_join_filter();
+  int add_join_filter_row(const uint64_t hash_value);
+  int send_join_filter();
   int prepare_hash_table();
   void trace_hash_table_collision(int64_t row_cnt);
   int build_hash_table_for_recursive();
@@ -691,6 +703,9 @@ private:
   bool has_fill_right_row_;
   bool has_fill_left_row_;
   ObChunkDatumStore::ShadowStoredRow right_last_row_;
+  // probe row of the last batch row, restored to the first row of the next batch
+  ObChunkDatumStore::LastStoredRow batch_probe_row_;
+  bool batch_probe_row_saved_;
   bool need_return_;
   bool iter_end_;
   bool opt_cache_aware_;
@@ -710,6 +725,11 @@ private:
   HashJoinHistogram* cur_right_hist_;
   int64_t cur_probe_row_idx_;
   int64_t max_right_bucket_idx_;
+  // join filter of the build side, see ObJoinFilterPieceMsg
+  ObPxBloomFilter join_filter_;
+  bool join_filter_sent_;
+  // hash value of the build row is reusable if the join hash funcs are the murmur ones of the spec
+  bool join_filter_reuse_hash_;
 
   // statistics
   int64_t probe_cnt_;
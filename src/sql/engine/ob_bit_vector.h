@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENGINE_OB_BIT_VECTOR_H_
+#define OCEANBASE_ENGINE_OB_BIT_VECTOR_H_
+
+#include <limits.h>
+#include "lib/ob_define.h"
+#include "lib/alloc/alloc_assist.h"
+
+namespace oceanbase {
+namespace sql {
+
+// Fixed size bit vector on caller provided memory, used as the skip bitmap of
+// vectorized execution (bit set means the row is skipped).
+//
+// The bit vector has no size member, the size is maintained by caller:
+//
+//   void *mem = alloc.alloc(ObBitVector::memory_size(size));
+//   ObBitVector *skip = to_bit_vector(mem);
+//   skip->reset(size);
+//
+struct ObBitVector {
+  typedef uint64_t WordType;
+  const static int64_t WORD_BITS = sizeof(WordType) * CHAR_BIT;
+
+  static int64_t word_count(const int64_t size)
+  {
+    return (size + WORD_BITS - 1) / WORD_BITS;
+  }
+
+  static int64_t memory_size(const int64_t size)
+  {
+    return word_count(size) * sizeof(WordType);
+  }
+
+  OB_INLINE void reset(const int64_t size)
+  {
+    MEMSET(data_, 0, memory_size(size));
+  }
+
+  OB_INLINE bool at(const int64_t idx) const
+  {
+    return data_[idx / WORD_BITS] & (1LU << (idx % WORD_BITS));
+  }
+
+  OB_INLINE void set(const int64_t idx)
+  {
+    data_[idx / WORD_BITS] |= (1LU << (idx % WORD_BITS));
+  }
+
+  OB_INLINE void unset(const int64_t idx)
+  {
+    data_[idx / WORD_BITS] &= ~(1LU << (idx % WORD_BITS));
+  }
+
+  // set all bits in [0, size)
+  void set_all(const int64_t size)
+  {
+    const int64_t full_words = size / WORD_BITS;
+    MEMSET(data_, 0xFF, full_words * sizeof(WordType));
+    if (size % WORD_BITS > 0) {
+      data_[full_words] |= (1LU << (size % WORD_BITS)) - 1;
+    }
+  }
+
+  // count of set bits in [0, size)
+  int64_t accumulate_bit_cnt(const int64_t size) const
+  {
+    int64_t cnt = 0;
+    const int64_t full_words = size / WORD_BITS;
+    for (int64_t i = 0; i < full_words; i++) {
+      cnt += __builtin_popcountl(data_[i]);
+    }
+    if (size % WORD_BITS > 0) {
+      cnt += __builtin_popcountl(data_[full_words] & ((1LU << (size % WORD_BITS)) - 1));
+    }
+    return cnt;
+  }
+
+  bool is_all_false(const int64_t size) const
+  {
+    return 0 == accumulate_bit_cnt(size);
+  }
+
+  bool is_all_true(const int64_t size) const
+  {
+    return size == accumulate_bit_cnt(size);
+  }
+
+  // bitwise OR of %other in [0, size)
+  void bit_or(const ObBitVector& other, const int64_t size)
+  {
+    for (int64_t i = 0; i < word_count(size); i++) {
+      data_[i] |= other.data_[i];
+    }
+  }
+
+  WordType data_[0];
+};
+
+inline ObBitVector* to_bit_vector(void* mem)
+{
+  return static_cast<ObBitVector*>(mem);
+}
+
+inline const ObBitVector* to_bit_vector(const void* mem)
+{
+  return static_cast<const ObBitVector*>(mem);
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_ENGINE_OB_BIT_VECTOR_H_
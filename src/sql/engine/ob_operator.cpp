@@ -87,14 +87,15 @@ ObOpSpec::ObOpSpec(ObIAllocator& alloc, const ObPhyOperatorType type)
       rows_(0),
       width_(0),
       px_est_size_factor_(),
-      plan_depth_(0)
+      plan_depth_(0),
+      max_batch_size_(0)
 {}
 
 ObOpSpec::~ObOpSpec()
 {}
 
 OB_SERIALIZE_MEMBER(ObOpSpec, id_, output_, startup_filters_, filters_, calc_exprs_, cost_, rows_, width_,
-    px_est_size_factor_, plan_depth_);
+    px_est_size_factor_, plan_depth_, max_batch_size_);
 
 DEF_TO_STRING(ObOpSpec)
 {
@@ -111,7 +112,8 @@ DEF_TO_STRING(ObOpSpec)
       startup_filters_.count(),
       "calc_exprs_cnt",
       calc_exprs_.count(),
-      K_(rows));
+      K_(rows),
+      K_(max_batch_size));
   J_OBJ_END();
   return pos;
 }
@@ -369,7 +371,10 @@ ObOperator::ObOperator(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOpInput*
       opened_(false),
       startup_passed_(spec_.startup_filters_.empty()),
       exch_drained_(false),
-      got_first_row_(false)
+      got_first_row_(false),
+      brs_(),
+      batch_alloc_(NULL),
+      brs_iter_idx_(0)
 {}
 
 ObOperator::~ObOperator()
@@ -449,6 +454,8 @@ int ObOperator::open()
       case OPEN_SELF_ONLY: {
         if (OB_FAIL(init_evaluated_flags())) {
           LOG_WARN("init evaluate flags failed", K(ret));
+        } else if (spec_.is_vectorized() && OB_FAIL(init_batch_rows())) {
+          LOG_WARN("init batch rows failed", K(ret));
         } else if (OB_FAIL(inner_open())) {
           if (OB_TRY_LOCK_ROW_CONFLICT != ret && OB_TRANSACTION_SET_VIOLATION != ret) {
             LOG_WARN("Open this operator failed", K(ret), "op_type", op_name());
@@ -488,6 +495,29 @@ int ObOperator::init_evaluated_flags()
   return ret;
 }
 
+int ObOperator::init_batch_rows()
+{
+  int ret = OB_SUCCESS;
+  void* skip_mem = NULL;
+  void* alloc_mem = NULL;
+  const uint64_t tenant_id =
+      NULL == ctx_.get_my_session() ? OB_SERVER_TENANT_ID : ctx_.get_my_session()->get_effective_tenant_id();
+  if (NULL != brs_.skip_) {
+    // already inited
+  } else if (OB_ISNULL(skip_mem = ctx_.get_allocator().alloc(ObBitVector::memory_size(spec_.max_batch_size_))) ||
+             OB_ISNULL(alloc_mem = ctx_.get_allocator().alloc(sizeof(ObArenaAllocator)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(spec_.max_batch_size_));
+  } else {
+    brs_.skip_ = to_bit_vector(skip_mem);
+    brs_.skip_->reset(spec_.max_batch_size_);
+    reset_batch_rows();
+    batch_alloc_ = new (alloc_mem) ObArenaAllocator(ObModIds::OB_SQL_EXECUTOR, OB_MALLOC_NORMAL_BLOCK_SIZE, tenant_id);
+    eval_ctx_.set_batch_idx(0);
+  }
+  return ret;
+}
+
 // copy from ob_phy_operator.cpp
 int ObOperator::rescan()
 {
@@ -499,6 +529,7 @@ int ObOperator::rescan()
   int ret = OB_SUCCESS;
 
   startup_passed_ = spec_.startup_filters_.empty();
+  reset_batch_rows();
 
   for (int64_t i = 0; OB_SUCC(ret) && i < child_cnt_; ++i) {
     if (OB_FAIL(children_[i]->rescan())) {
@@ -522,6 +553,7 @@ int ObOperator::switch_iterator()
     ret = OB_ITER_END;
   } else {
     startup_passed_ = spec_.startup_filters_.empty();
+    reset_batch_rows();
 
     // Differ from ObPhyOperator::switch_iterator(), current binding array index is moved from
     // ObExprCtx to ObPhysicalPlanCtx, can not increase in Operator.
@@ -580,6 +612,9 @@ int ObOperator::close()
 int ObOperator::get_next_row()
 {
   int ret = OB_SUCCESS;
+  if (spec_.is_vectorized()) {
+    return get_next_row_from_batch();
+  }
   if (OB_UNLIKELY(!startup_passed_)) {
     bool filtered = false;
     if (OB_FAIL(startup_filter(filtered))) {
@@ -633,6 +668,211 @@ int ObOperator::get_next_row()
   return ret;
 }
 
+int ObOperator::get_next_row_from_batch()
+{
+  int ret = OB_SUCCESS;
+  bool got_row = false;
+  while (OB_SUCC(ret) && !got_row) {
+    if (brs_iter_idx_ < brs_.size_) {
+      if (!brs_.skip_->at(brs_iter_idx_)) {
+        eval_ctx_.set_batch_idx(brs_iter_idx_);
+        got_row = true;
+      }
+      brs_iter_idx_++;
+    } else if (brs_.end_) {
+      ret = OB_ITER_END;
+    } else {
+      const ObBatchRows* brs = NULL;
+      if (OB_FAIL(get_next_batch(spec_.max_batch_size_, brs))) {
+        LOG_WARN("get next batch failed", K(ret), "op", op_name());
+      } else {
+        brs_iter_idx_ = 0;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObOperator::get_next_batch(const int64_t max_row_cnt, const ObBatchRows*& batch_rows)
+{
+  int ret = OB_SUCCESS;
+  batch_rows = &brs_;
+  if (OB_UNLIKELY(!spec_.is_vectorized() || NULL == brs_.skip_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("operator is not vectorized or not opened", K(ret), "op", op_name(), K(spec_.max_batch_size_));
+  } else if (OB_UNLIKELY(max_row_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid max row count", K(ret), K(max_row_cnt));
+  } else {
+    brs_.size_ = 0;
+    brs_.skip_->reset(spec_.max_batch_size_);
+    if (OB_UNLIKELY(!startup_passed_) && !brs_.end_) {
+      bool filtered = false;
+      if (OB_FAIL(startup_filter(filtered))) {
+        LOG_WARN("do startup filter failed", K(ret), "op", op_name());
+      } else if (filtered) {
+        brs_.end_ = true;
+      } else {
+        startup_passed_ = true;
+      }
+    }
+  }
+  if (OB_SUCC(ret) && !brs_.end_) {
+    // rows of the previous batch are consumed by parent, release the deep copied datums.
+    batch_alloc_->reset_remain_one_page();
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+    const int64_t batch_size = std::min(max_row_cnt, spec_.max_batch_size_);
+    batch_info_guard.set_batch_size(batch_size);
+    if (OB_FAIL(inner_get_next_batch(batch_size))) {
+      LOG_WARN("inner get next batch failed", K(ret), "type", spec_.type_, "op", op_name());
+    }
+  }
+  if (OB_SUCC(ret)) {
+    const int64_t row_cnt = brs_.size_ - brs_.skip_->accumulate_bit_cnt(brs_.size_);
+    op_monitor_info_.output_row_count_ += row_cnt;
+    if (!got_first_row_ && row_cnt > 0) {
+      op_monitor_info_.first_row_time_ = oceanbase::common::ObClockGenerator::getClock();
+      got_first_row_ = true;
+    }
+    if (brs_.end_) {
+      if (OB_FAIL(drain_exch())) {
+        LOG_WARN("drain exchange data failed", K(ret));
+      }
+      if (got_first_row_) {
+        op_monitor_info_.last_row_time_ = oceanbase::common::ObClockGenerator::getClock();
+      }
+    }
+  }
+  return ret;
+}
+
+int ObOperator::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  int64_t size = 0;
+  // fetch rows one by one, filter and project each row in row mode.
+  while (OB_SUCC(ret) && size < max_row_cnt) {
+    eval_ctx_.set_batch_idx(size);
+    if (OB_FAIL(inner_get_next_row())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("inner get next row failed", K(ret), "op", op_name());
+      } else {
+        ret = OB_SUCCESS;
+        brs_.end_ = true;
+        break;
+      }
+    } else if (OB_FAIL(add_batch_row(size))) {
+      LOG_WARN("add batch row failed", K(ret), "op", op_name());
+    }
+  }
+  if (OB_SUCC(ret)) {
+    brs_.size_ = size;
+    set_batch_evaluated(spec_.output_, size);
+  }
+  return ret;
+}
+
+int ObOperator::add_batch_row(int64_t& size)
+{
+  int ret = OB_SUCCESS;
+  bool filtered = false;
+  if (!spec_.filters_.empty() && OB_FAIL(filter_row(filtered))) {
+    LOG_WARN("filter row failed", K(ret), "op", op_name());
+  } else if (filtered) {
+    // reuse the row of batch
+  } else {
+    ObDatum* datum = NULL;
+    FOREACH_CNT_X(e, spec_.output_, OB_SUCC(ret))
+    {
+      if (OB_FAIL((*e)->eval(eval_ctx_, datum))) {
+        LOG_WARN("expr evaluate failed", K(ret), KPC(*e));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(deep_copy_batch_row(spec_.output_))) {
+      LOG_WARN("deep copy batch row failed", K(ret));
+    } else {
+      size++;
+    }
+  }
+  return ret;
+}
+
+int ObOperator::filter_and_project_batch(const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  brs_.size_ = size;
+  FOREACH_CNT_X(e, spec_.filters_, OB_SUCC(ret))
+  {
+    if (OB_FAIL((*e)->eval_batch(eval_ctx_, *brs_.skip_, size))) {
+      LOG_WARN("expr evaluate failed", K(ret), KPC(*e));
+    } else {
+      OB_ASSERT(ob_is_int_tc((*e)->datum_meta_.type_));
+      for (int64_t i = 0; i < size; i++) {
+        if (!brs_.skip_->at(i)) {
+          const ObDatum& datum = (*e)->locate_expr_datum(eval_ctx_, i);
+          if (datum.null_ || 0 == *datum.int_) {
+            brs_.skip_->set(i);
+          }
+        }
+      }
+    }
+  }
+  FOREACH_CNT_X(e, spec_.output_, OB_SUCC(ret))
+  {
+    if (OB_FAIL((*e)->eval_batch(eval_ctx_, *brs_.skip_, size))) {
+      LOG_WARN("expr evaluate failed", K(ret), KPC(*e));
+    }
+  }
+  return ret;
+}
+
+void ObOperator::set_batch_evaluated(const common::ObIArray<ObExpr*>& exprs, const int64_t size)
+{
+  FOREACH_CNT(e, exprs)
+  {
+    if (NULL != *e && (*e)->is_batch_result()) {
+      ObEvalInfo& info = (*e)->get_eval_info(eval_ctx_);
+      info.evaluated_ = true;
+      info.projected_ = true;
+      info.cnt_ = static_cast<uint16_t>(size);
+    }
+  }
+}
+
+int ObOperator::deep_copy_batch_row(const common::ObIArray<ObExpr*>& exprs)
+{
+  int ret = OB_SUCCESS;
+  FOREACH_CNT_X(e, exprs, OB_SUCC(ret))
+  {
+    const ObExpr* expr = *e;
+    if (NULL == expr || !expr->is_batch_result()) {
+      continue;
+    }
+    ObDatum& datum = expr->locate_expr_datum(eval_ctx_);
+    if (datum.null_ || 0 == datum.len_) {
+      continue;
+    }
+    const char* res_buf = expr->get_res_buf(eval_ctx_);
+    bool in_res_buf = datum.ptr_ >= res_buf && datum.ptr_ + datum.len_ <= res_buf + expr->res_buf_len_;
+    if (!in_res_buf && expr->res_buf_len_ > 0 && ObDynReserveBuf::supported(expr->datum_meta_.type_)) {
+      const ObDynReserveBuf* drb = reinterpret_cast<const ObDynReserveBuf*>(res_buf - sizeof(ObDynReserveBuf));
+      in_res_buf = drb->len_ > 0 && datum.ptr_ >= drb->mem_ && datum.ptr_ + datum.len_ <= drb->mem_ + drb->len_;
+    }
+    if (!in_res_buf) {
+      char* buf = static_cast<char*>(batch_alloc_->alloc(datum.len_));
+      if (OB_ISNULL(buf)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("allocate memory failed", K(ret), K(datum.len_));
+      } else {
+        MEMCPY(buf, datum.ptr_, datum.len_);
+        datum.ptr_ = buf;
+      }
+    }
+  }
+  return ret;
+}
+
 int ObOperator::filter(const common::ObIArray<ObExpr*>& exprs, bool& filtered)
 {
   ObDatum* datum = NULL;
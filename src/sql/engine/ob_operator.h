@@ -17,6 +17,7 @@
 #include "sql/engine/ob_phy_operator_type.h"
 #include "sql/engine/expr/ob_expr.h"
 #include "sql/engine/ob_operator_reg.h"
+#include "sql/engine/ob_bit_vector.h"
 #include "sql/engine/ob_phy_operator.h"
 #include "sql/engine/px/ob_px_op_size_factor.h"
 #include "sql/engine/px/ob_px_basic_info.h"
@@ -61,6 +62,21 @@ public:
   TO_STRING_KV(K_(param_idx), K_(src), K_(dst));
 };
 
+// Batch rows of vectorized execution, rows with skip bit set are filtered.
+struct ObBatchRows {
+  ObBatchRows() : skip_(NULL), size_(0), end_(false)
+  {}
+
+  TO_STRING_KV(K_(size), K_(end));
+
+  // skip bitmap, bit set means the row is filtered.
+  ObBitVector* skip_;
+  // batch size, including the filtered rows
+  int64_t size_;
+  // iterate end, rows of this batch are still valid.
+  bool end_;
+};
+
 class ObOpSpecVisitor;
 // Physical operator specification, immutable in execution.
 // (same with the old ObPhyOperator)
@@ -191,6 +207,11 @@ public:
   {
     return plan_depth_;
   }
+  // rows are fetched in batch by get_next_batch()
+  bool is_vectorized() const
+  {
+    return max_batch_size_ > 0;
+  }
 
   // find all specs of the DFO (stop when reach receive)
   template <typename T, typename FILTER>
@@ -248,6 +269,8 @@ public:
   int64_t width_;
   PxOpSizeFactor px_est_size_factor_;
   int64_t plan_depth_;
+  // max row count of batch for vectorized execution, zero for row by row execution.
+  int64_t max_batch_size_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObOpSpec);
@@ -305,9 +328,19 @@ public:
 
   // fetch next row
   // return OB_ITER_END if reach end.
+  // For vectorized operator, rows are iterated from batch rows of get_next_batch(),
+  // and the batch index of eval ctx is set to the current row.
   virtual int get_next_row();
   virtual int inner_get_next_row() = 0;
 
+  // fetch next batch rows (at most %max_row_cnt rows) for vectorized operator.
+  // %batch_rows is valid until next call, batch_rows->end_ is set when reach end.
+  int get_next_batch(const int64_t max_row_cnt, const ObBatchRows*& batch_rows);
+  // Fill brs_ with at most %max_row_cnt rows. The default implementation fetch rows by
+  // inner_get_next_row() and compact them into batch, only suitable for operators which
+  // output expressions are not referenced by child's batch index (leaf or blocking operators).
+  virtual int inner_get_next_batch(const int64_t max_row_cnt);
+
   // close operator, cascading close child operators
   virtual int close();
   // close operator, not including child operators.
@@ -396,6 +429,25 @@ protected:
     return opened_ ? common::OB_SUCCESS : open();
   }
 
+  // reset batch rows iterating state, called in rescan
+  void reset_batch_rows()
+  {
+    brs_.size_ = 0;
+    brs_.end_ = false;
+    brs_iter_idx_ = 0;
+  }
+  // Filter the row fetched by inner_get_next_row() to batch row %size, evaluate and deep copy
+  // outputs, %size is increased if the row is not filtered.
+  int add_batch_row(int64_t& size);
+  // Evaluate filters (set skip bit of filtered rows) and outputs of the batch rows.
+  int filter_and_project_batch(const int64_t size);
+  // Datums of batch rows assigned by operator (e.g.: restored from stored row), mark them
+  // evaluated to avoid evaluate again in batch evaluating.
+  void set_batch_evaluated(const common::ObIArray<ObExpr*>& exprs, const int64_t size);
+  // Deep copy datums of current batch row which may be overwritten by next row, e.g.:
+  // datums point to storage row or stored row of row store.
+  int deep_copy_batch_row(const common::ObIArray<ObExpr*>& exprs);
+
   // Drain exchange in data for PX, or producer DFO will be blocked.
   virtual int drain_exch();
 
@@ -426,8 +478,19 @@ protected:
   bool got_first_row_;
   // gv$sql_plan_monitor
   ObMonitorNode op_monitor_info_;
+  // batch rows of vectorized operator
+  ObBatchRows brs_;
+  // memory of deep copied datums, reused for each batch
+  common::ObArenaAllocator* batch_alloc_;
 
 private:
+  int init_batch_rows();
+  // iterate batch rows in get_next_row()
+  int get_next_row_from_batch();
+
+  // next row index of brs_ to be iterated in get_next_row()
+  int64_t brs_iter_idx_;
+
   DISALLOW_COPY_AND_ASSIGN(ObOperator);
 };
 
@@ -491,7 +554,12 @@ int ObOpSpec::find_target_specs(T& spec, const FILTER& f, common::ObIArray<T*>&
 }
 
 inline void ObOperator::destroy()
-{}
+{
+  if (NULL != batch_alloc_) {
+    batch_alloc_->~ObArenaAllocator();
+    batch_alloc_ = NULL;
+  }
+}
 
 OB_INLINE void ObOperator::clear_evaluated_flag()
 {
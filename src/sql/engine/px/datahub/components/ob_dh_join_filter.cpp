@@ -0,0 +1,358 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
+#include "sql/engine/px/datahub/ob_dh_msg_ctx.h"
+#include "sql/engine/px/ob_dfo.h"
+#include "sql/engine/px/ob_px_util.h"
+#include "sql/engine/px/datahub/ob_dh_msg.h"
+#include "sql/engine/expr/ob_expr.h"
+
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+
+int ObPxBloomFilter::init(const int64_t bit_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (bit_cnt < MIN_BIT_COUNT || bit_cnt > MAX_BIT_COUNT || 0 != (bit_cnt & (bit_cnt - 1))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid bit count", K(ret), K(bit_cnt));
+  } else {
+    reset();
+    if (OB_FAIL(bits_.prepare_allocate(bit_cnt / 64))) {
+      LOG_WARN("fail to allocate bloom filter bits", K(ret), K(bit_cnt));
+    } else {
+      bit_cnt_ = bit_cnt;
+    }
+  }
+  return ret;
+}
+
+int ObPxBloomFilter::merge(const ObPxBloomFilter& other)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited() || other.bit_cnt_ != bit_cnt_) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("bloom filters of different size can not be merged", K(ret), K(bit_cnt_), K(other.bit_cnt_));
+  } else {
+    uint64_t* words = &bits_.at(0);
+    const uint64_t* other_words = &other.bits_.at(0);
+    for (int64_t i = 0; i < bits_.count(); ++i) {
+      words[i] |= other_words[i];
+    }
+  }
+  return ret;
+}
+
+int ObPxBloomFilter::assign(const ObPxBloomFilter& other)
+{
+  int ret = OB_SUCCESS;
+  if (!other.is_inited()) {
+    reset();
+  } else if (OB_FAIL(init(other.bit_cnt_))) {
+    LOG_WARN("fail to init bloom filter", K(ret));
+  } else {
+    MEMCPY(&bits_.at(0), &other.bits_.at(0), bits_.count() * sizeof(uint64_t));
+  }
+  return ret;
+}
+
+int64_t ObPxBloomFilter::get_fill_ratio() const
+{
+  int64_t set_cnt = 0;
+  for (int64_t i = 0; i < bits_.count(); ++i) {
+    set_cnt += __builtin_popcountl(bits_.at(i));
+  }
+  return bit_cnt_ > 0 ? set_cnt * 100 / bit_cnt_ : 0;
+}
+
+int64_t ObPxBloomFilter::calc_bit_count(const int64_t row_cnt)
+{
+  int64_t bit_cnt = 0;
+  // less than 4 bits per row makes the filter nearly saturated
+  if (row_cnt <= MAX_BIT_COUNT / 4) {
+    bit_cnt = next_pow2(std::max(row_cnt, 1L) * BITS_PER_ROW);
+    bit_cnt = std::min(std::max(bit_cnt, MIN_BIT_COUNT), MAX_BIT_COUNT);
+  }
+  return bit_cnt;
+}
+
+int ObPxBloomFilter::calc_hash_value(
+    const ObIArray<ObExpr*>& keys, const ObIArray<ObHashFunc>& funcs, ObEvalCtx& eval_ctx, uint64_t& hash_val)
+{
+  int ret = OB_SUCCESS;
+  hash_val = HASH_SEED;
+  ObDatum* datum = NULL;
+  for (int64_t i = 0; OB_SUCC(ret) && i < keys.count(); ++i) {
+    if (OB_FAIL(keys.at(i)->eval(eval_ctx, datum))) {
+      LOG_WARN("failed to eval datum", K(ret));
+    } else {
+      hash_val = funcs.at(i).hash_func_(*datum, hash_val);
+    }
+  }
+  hash_val = hash_val & HASH_VAL_MASK;
+  return ret;
+}
+
+OB_DEF_SERIALIZE(ObPxBloomFilter)
+{
+  int ret = OB_SUCCESS;
+  OB_UNIS_ENCODE(bit_cnt_);
+  if (OB_SUCC(ret) && bit_cnt_ > 0) {
+    const int64_t size = bits_.count() * sizeof(uint64_t);
+    if (buf_len - pos < size) {
+      ret = OB_SIZE_OVERFLOW;
+      LOG_WARN("buffer not enough", K(ret), K(buf_len), K(pos), K(size));
+    } else {
+      MEMCPY(buf + pos, &bits_.at(0), size);
+      pos += size;
+    }
+  }
+  return ret;
+}
+
+OB_DEF_DESERIALIZE(ObPxBloomFilter)
+{
+  int ret = OB_SUCCESS;
+  int64_t bit_cnt = 0;
+  OB_UNIS_DECODE(bit_cnt);
+  if (OB_FAIL(ret)) {
+  } else if (0 == bit_cnt) {
+    reset();
+  } else if (OB_FAIL(init(bit_cnt))) {
+    LOG_WARN("fail to init bloom filter", K(ret), K(bit_cnt));
+  } else {
+    const int64_t size = bits_.count() * sizeof(uint64_t);
+    if (data_len - pos < size) {
+      ret = OB_SIZE_OVERFLOW;
+      LOG_WARN("the size is overflow", K(ret), K(data_len), K(pos), K(size));
+    } else {
+      MEMCPY(&bits_.at(0), buf + pos, size);
+      pos += size;
+    }
+  }
+  return ret;
+}
+
+OB_DEF_SERIALIZE_SIZE(ObPxBloomFilter)
+{
+  int64_t len = 0;
+  OB_UNIS_ADD_LEN(bit_cnt_);
+  if (bit_cnt_ > 0) {
+    len += bits_.count() * sizeof(uint64_t);
+  }
+  return len;
+}
+
+OB_DEF_SERIALIZE(ObJoinFilterPieceMsg)
+{
+  int ret = OB_SUCCESS;
+  ret = ObDatahubPieceMsg::serialize(buf, buf_len, pos);
+  if (OB_SUCC(ret)) {
+    LST_DO_CODE(OB_UNIS_ENCODE, is_build_, filter_);
+  }
+  return ret;
+}
+
+OB_DEF_DESERIALIZE(ObJoinFilterPieceMsg)
+{
+  int ret = OB_SUCCESS;
+  ret = ObDatahubPieceMsg::deserialize(buf, data_len, pos);
+  if (OB_SUCC(ret)) {
+    LST_DO_CODE(OB_UNIS_DECODE, is_build_, filter_);
+  }
+  return ret;
+}
+
+OB_DEF_SERIALIZE_SIZE(ObJoinFilterPieceMsg)
+{
+  int64_t len = 0;
+  len += ObDatahubPieceMsg::get_serialize_size();
+  LST_DO_CODE(OB_UNIS_ADD_LEN, is_build_, filter_);
+  return len;
+}
+
+OB_DEF_SERIALIZE(ObJoinFilterWholeMsg)
+{
+  int ret = OB_SUCCESS;
+  ret = ObDatahubWholeMsg::serialize(buf, buf_len, pos);
+  if (OB_SUCC(ret)) {
+    LST_DO_CODE(OB_UNIS_ENCODE, is_valid_, filter_);
+  }
+  return ret;
+}
+
+OB_DEF_DESERIALIZE(ObJoinFilterWholeMsg)
+{
+  int ret = OB_SUCCESS;
+  ret = ObDatahubWholeMsg::deserialize(buf, data_len, pos);
+  if (OB_SUCC(ret)) {
+    LST_DO_CODE(OB_UNIS_DECODE, is_valid_, filter_);
+  }
+  return ret;
+}
+
+OB_DEF_SERIALIZE_SIZE(ObJoinFilterWholeMsg)
+{
+  int64_t len = 0;
+  len += ObDatahubWholeMsg::get_serialize_size();
+  LST_DO_CODE(OB_UNIS_ADD_LEN, is_valid_, filter_);
+  return len;
+}
+
+int ObJoinFilterWholeMsg::assign(const ObJoinFilterWholeMsg& other)
+{
+  int ret = OB_SUCCESS;
+  op_id_ = other.op_id_;
+  is_valid_ = other.is_valid_;
+  if (OB_FAIL(filter_.assign(other.filter_))) {
+    LOG_WARN("fail to assign bloom filter", K(ret));
+  }
+  return ret;
+}
+
+int ObJoinFilterPieceMsgListener::on_message(
+    ObJoinFilterPieceMsgCtx& ctx, common::ObIArray<ObPxSqcMeta*>& sqcs, const ObJoinFilterPieceMsg& pkt)
+{
+  int ret = OB_SUCCESS;
+  if (pkt.op_id_ != ctx.op_id_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected piece msg", K(pkt), K(ctx));
+  } else if (pkt.is_build_) {
+    if (OB_FAIL(on_build_piece(ctx, sqcs, pkt))) {
+      LOG_WARN("fail to merge build side filter", K(ret));
+    }
+  } else if (OB_FAIL(on_subscribe_piece(ctx, sqcs))) {
+    LOG_WARN("fail to subscribe join filter", K(ret));
+  }
+  // the merged filter is shipped to every SQC of the probe side once,
+  // and SQC makes it visible to all its tasks through the whole msg provider
+  if (OB_SUCC(ret) && ctx.ready_ && !ctx.pending_sqcs_.empty()) {
+    if (OB_FAIL(send_whole_msg(ctx))) {
+      LOG_WARN("fail to send join filter", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObJoinFilterPieceMsgListener::on_build_piece(
+    ObJoinFilterPieceMsgCtx& ctx, common::ObIArray<ObPxSqcMeta*>& sqcs, const ObJoinFilterPieceMsg& pkt)
+{
+  int ret = OB_SUCCESS;
+  if (0 == ctx.received_) {
+    // ctx may be created by a subscribe piece of the probe side DFO, so the
+    // expected piece count is taken from the SQCs of the build side here
+    ctx.task_cnt_ = 0;
+    ARRAY_FOREACH_X(sqcs, idx, cnt, OB_SUCC(ret))
+    {
+      ctx.task_cnt_ += sqcs.at(idx)->get_task_count();
+    }
+  }
+  if (ctx.ready_ || ctx.received_ >= ctx.task_cnt_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("should not receive any more pkt. already get all pkt expected", K(pkt), K(ctx));
+  } else if (!pkt.filter_.is_inited()) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("build piece without filter", K(ret), K(pkt));
+  } else if (!ctx.whole_msg_.filter_.is_inited()) {
+    if (OB_FAIL(ctx.whole_msg_.filter_.assign(pkt.filter_))) {
+      LOG_WARN("fail to assign filter", K(ret));
+    }
+  } else if (OB_FAIL(ctx.whole_msg_.filter_.merge(pkt.filter_))) {
+    LOG_WARN("fail to merge filter", K(ret));
+  }
+  if (OB_SUCC(ret)) {
+    ctx.received_++;
+    LOG_TRACE("got a join filter piece msg", "all_got", ctx.received_, "expected", ctx.task_cnt_);
+    if (ctx.received_ == ctx.task_cnt_) {
+      const int64_t fill_ratio = ctx.whole_msg_.filter_.get_fill_ratio();
+      ctx.ready_ = true;
+      ctx.whole_msg_.op_id_ = ctx.op_id_;
+      ctx.whole_msg_.is_valid_ = fill_ratio <= ObJoinFilterPieceMsgCtx::MAX_FILL_RATIO;
+      LOG_TRACE("join filter is ready", K(fill_ratio), K(ctx));
+    }
+  }
+  return ret;
+}
+
+int ObJoinFilterPieceMsgListener::on_subscribe_piece(ObJoinFilterPieceMsgCtx& ctx, common::ObIArray<ObPxSqcMeta*>& sqcs)
+{
+  int ret = OB_SUCCESS;
+  ARRAY_FOREACH_X(sqcs, idx, cnt, OB_SUCC(ret))
+  {
+    ObPxSqcMeta* sqc = sqcs.at(idx);
+    if (has_exist_in_array(ctx.subscribed_sqcs_, sqc)) {
+      // every task of the probe side subscribes, SQC only needs the filter once
+    } else if (OB_FAIL(ctx.subscribed_sqcs_.push_back(sqc))) {
+      LOG_WARN("fail to push back sqc", K(ret));
+    } else if (OB_FAIL(ctx.pending_sqcs_.push_back(sqc))) {
+      LOG_WARN("fail to push back sqc", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObJoinFilterPieceMsgListener::send_whole_msg(ObJoinFilterPieceMsgCtx& ctx)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObPxSqcMeta*, 8> sent_sqcs;
+  ARRAY_FOREACH_X(ctx.pending_sqcs_, idx, cnt, OB_SUCC(ret))
+  {
+    ObPxSqcMeta* sqc = ctx.pending_sqcs_.at(idx);
+    dtl::ObDtlChannel* ch = sqc->get_qc_channel();
+    int tmp_ret = OB_SUCCESS;
+    if (sqc->is_thread_finish()) {
+      // probe side finished before the build side, nobody waits for the filter
+    } else if (OB_ISNULL(ch)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null expected", K(ret));
+    } else if (OB_SUCCESS != (tmp_ret = ch->send(ctx.whole_msg_, ctx.timeout_ts_))) {
+      // the filter is only an optimization, the probe side goes on without it
+      LOG_WARN("fail push data to channel", K(tmp_ret));
+    } else if (OB_SUCCESS != (tmp_ret = ch->flush(true, false))) {
+      LOG_WARN("fail flush dtl data", K(tmp_ret));
+    } else if (OB_FAIL(sent_sqcs.push_back(sqc))) {
+      LOG_WARN("fail to push back sqc", K(ret));
+    } else {
+      LOG_DEBUG("dispatched join filter whole msg", K(idx), K(cnt), K(ctx.whole_msg_), K(*ch));
+    }
+  }
+  if (OB_SUCC(ret) && !sent_sqcs.empty() && OB_FAIL(ObPxChannelUtil::sqcs_channles_asyn_wait(sent_sqcs))) {
+    LOG_WARN("failed to wait response", K(ret));
+  }
+  if (OB_SUCC(ret)) {
+    ctx.pending_sqcs_.reuse();
+  }
+  return ret;
+}
+
+int ObJoinFilterPieceMsgCtx::alloc_piece_msg_ctx(
+    const ObJoinFilterPieceMsg& pkt, ObExecContext& ctx, int64_t task_cnt, ObPieceMsgCtx*& msg_ctx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(ctx.get_physical_plan_ctx())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("physical plan ctx is null", K(ret));
+  } else {
+    void* buf = ctx.get_allocator().alloc(sizeof(ObJoinFilterPieceMsgCtx));
+    if (OB_ISNULL(buf)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+    } else {
+      msg_ctx = new (buf) ObJoinFilterPieceMsgCtx(pkt.op_id_,
+          pkt.is_build_ ? task_cnt : 0,
+          ctx.get_physical_plan_ctx()->get_timeout_timestamp(),
+          ctx.get_allocator());
+    }
+  }
+  return ret;
+}
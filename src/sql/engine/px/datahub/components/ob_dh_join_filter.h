@@ -0,0 +1,200 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef __OB_SQL_ENG_PX_DH_JOIN_FILTER_H__
+#define __OB_SQL_ENG_PX_DH_JOIN_FILTER_H__
+
+#include "lib/container/ob_array.h"
+#include "share/datum/ob_datum_funcs.h"
+#include "sql/engine/px/datahub/ob_dh_msg.h"
+#include "sql/engine/px/datahub/ob_dh_dtl_proc.h"
+#include "sql/engine/px/datahub/ob_dh_msg_ctx.h"
+#include "sql/engine/px/datahub/ob_dh_msg_provider.h"
+
+namespace oceanbase {
+namespace sql {
+
+class ObExpr;
+class ObEvalCtx;
+class ObJoinFilterPieceMsg;
+class ObJoinFilterWholeMsg;
+typedef ObPieceMsgP<ObJoinFilterPieceMsg> ObJoinFilterPieceMsgP;
+typedef ObWholeMsgP<ObJoinFilterWholeMsg> ObJoinFilterWholeMsgP;
+class ObJoinFilterPieceMsgListener;
+class ObJoinFilterPieceMsgCtx;
+
+// Bloom filter over the join key hash values of the hash join build side.
+// Every build task sizes its filter with the same bit count, so the filters are merged by OR-ing the words.
+class ObPxBloomFilter {
+  OB_UNIS_VERSION(1);
+
+public:
+  static const int64_t MIN_BIT_COUNT = 1L << 12;
+  static const int64_t MAX_BIT_COUNT = 1L << 23;
+  static const int64_t BITS_PER_ROW = 16;
+  // must be the same with ObHashJoinOp, the build side reuses the hash value of hash join
+  static const uint64_t HASH_SEED = 16777213;
+  static const uint64_t HASH_VAL_MASK = UINT64_MAX >> 1;
+
+public:
+  ObPxBloomFilter() : bit_cnt_(0), bits_()
+  {}
+  ~ObPxBloomFilter() = default;
+  int init(const int64_t bit_cnt);
+  void reset()
+  {
+    bit_cnt_ = 0;
+    bits_.reset();
+  }
+  void set_allocator(common::ObIAllocator& alloc)
+  {
+    bits_.set_block_allocator(common::ModulePageAllocator(alloc, "PxJoinFilter"));
+  }
+  bool is_inited() const
+  {
+    return bit_cnt_ > 0;
+  }
+  int64_t get_bit_count() const
+  {
+    return bit_cnt_;
+  }
+  OB_INLINE void set(const uint64_t hash_val)
+  {
+    const uint64_t h1 = hash_val & (bit_cnt_ - 1);
+    const uint64_t h2 = (hash_val >> 32) & (bit_cnt_ - 1);
+    bits_.at(h1 >> 6) |= (1UL << (h1 & 63));
+    bits_.at(h2 >> 6) |= (1UL << (h2 & 63));
+  }
+  OB_INLINE bool might_contain(const uint64_t hash_val) const
+  {
+    const uint64_t h1 = hash_val & (bit_cnt_ - 1);
+    const uint64_t h2 = (hash_val >> 32) & (bit_cnt_ - 1);
+    return (bits_.at(h1 >> 6) & (1UL << (h1 & 63))) && (bits_.at(h2 >> 6) & (1UL << (h2 & 63)));
+  }
+  int merge(const ObPxBloomFilter& other);
+  int assign(const ObPxBloomFilter& other);
+  // ratio of bits set, in percent
+  int64_t get_fill_ratio() const;
+
+  // bit count for a build side of %row_cnt rows, 0 means not worth building a filter
+  static int64_t calc_bit_count(const int64_t row_cnt);
+  // hash value of the join keys, same as the one ObHashJoinOp computes with murmur hash
+  static int calc_hash_value(const common::ObIArray<ObExpr*>& keys, const common::ObIArray<common::ObHashFunc>& funcs,
+      ObEvalCtx& eval_ctx, uint64_t& hash_val);
+  TO_STRING_KV(K_(bit_cnt), "word_cnt", bits_.count());
+
+private:
+  int64_t bit_cnt_;  // power of 2
+  common::ObArray<uint64_t> bits_;
+  DISALLOW_COPY_AND_ASSIGN(ObPxBloomFilter);
+};
+
+// Two kinds of piece are sent to the same datahub ctx, which is keyed by the hash join operator id:
+//   - build piece, one for each task of the hash join DFO, carries the filter of the rows it read from the build side.
+//   - subscribe piece, sent by the transmit feeding the probe side, asks QC to ship the merged filter to its SQC.
+class ObJoinFilterPieceMsg : public ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_JOIN_FILTER_PIECE_MSG> {
+  OB_UNIS_VERSION_V(1);
+
+public:
+  using PieceMsgListener = ObJoinFilterPieceMsgListener;
+  using PieceMsgCtx = ObJoinFilterPieceMsgCtx;
+
+public:
+  ObJoinFilterPieceMsg() : is_build_(false), filter_()
+  {}
+  ~ObJoinFilterPieceMsg() = default;
+  void reset()
+  {
+    is_build_ = false;
+    filter_.reset();
+  }
+  INHERIT_TO_STRING_KV("meta", ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_JOIN_FILTER_PIECE_MSG>, K_(op_id),
+      K_(is_build), K_(filter));
+
+public:
+  bool is_build_;
+  ObPxBloomFilter filter_;  // valid only for build piece
+  DISALLOW_COPY_AND_ASSIGN(ObJoinFilterPieceMsg);
+};
+
+class ObJoinFilterWholeMsg : public ObDatahubWholeMsg<dtl::ObDtlMsgType::DH_JOIN_FILTER_WHOLE_MSG> {
+  OB_UNIS_VERSION_V(1);
+
+public:
+  using WholeMsgProvider = ObWholeMsgProvider<ObJoinFilterWholeMsg>;
+
+public:
+  ObJoinFilterWholeMsg() : is_valid_(false), filter_()
+  {}
+  ~ObJoinFilterWholeMsg() = default;
+  int assign(const ObJoinFilterWholeMsg& other);
+  void reset()
+  {
+    is_valid_ = false;
+    filter_.reset();
+  }
+  VIRTUAL_TO_STRING_KV(K_(op_id), K_(is_valid), K_(filter));
+  // false if the merged filter is too dense to filter anything, the probe side stops checking rows then
+  bool is_valid_;
+  ObPxBloomFilter filter_;
+};
+
+class ObJoinFilterPieceMsgCtx : public ObPieceMsgCtx {
+public:
+  // above this fill ratio the false positive rate is over 25%, the filter costs more than it saves
+  static const int64_t MAX_FILL_RATIO = 50;
+
+public:
+  // ctx is never destructed, all its memory comes from the allocator of QC exec ctx
+  ObJoinFilterPieceMsgCtx(uint64_t op_id, int64_t task_cnt, int64_t timeout_ts, common::ObIAllocator& alloc)
+      : ObPieceMsgCtx(op_id, task_cnt, timeout_ts),
+        received_(0),
+        ready_(false),
+        whole_msg_(),
+        subscribed_sqcs_(common::OB_MALLOC_NORMAL_BLOCK_SIZE, common::ModulePageAllocator(alloc, "PxJoinFilter")),
+        pending_sqcs_(common::OB_MALLOC_NORMAL_BLOCK_SIZE, common::ModulePageAllocator(alloc, "PxJoinFilter"))
+  {
+    whole_msg_.filter_.set_allocator(alloc);
+  }
+  ~ObJoinFilterPieceMsgCtx() = default;
+  INHERIT_TO_STRING_KV("meta", ObPieceMsgCtx, K_(received), K_(ready), "subscriber_cnt", subscribed_sqcs_.count());
+  static int alloc_piece_msg_ctx(
+      const ObJoinFilterPieceMsg& pkt, ObExecContext& ctx, int64_t task_cnt, ObPieceMsgCtx*& msg_ctx);
+  int received_;  // build pieces received
+  bool ready_;    // all build pieces merged
+  ObJoinFilterWholeMsg whole_msg_;
+  common::ObSEArray<ObPxSqcMeta*, 8> subscribed_sqcs_;
+  common::ObSEArray<ObPxSqcMeta*, 8> pending_sqcs_;  // subscribed but whole msg not sent yet
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObJoinFilterPieceMsgCtx);
+};
+
+class ObJoinFilterPieceMsgListener {
+public:
+  ObJoinFilterPieceMsgListener() = default;
+  ~ObJoinFilterPieceMsgListener() = default;
+  static int on_message(
+      ObJoinFilterPieceMsgCtx& ctx, common::ObIArray<ObPxSqcMeta*>& sqcs, const ObJoinFilterPieceMsg& pkt);
+
+private:
+  static int on_build_piece(
+      ObJoinFilterPieceMsgCtx& ctx, common::ObIArray<ObPxSqcMeta*>& sqcs, const ObJoinFilterPieceMsg& pkt);
+  static int on_subscribe_piece(ObJoinFilterPieceMsgCtx& ctx, common::ObIArray<ObPxSqcMeta*>& sqcs);
+  static int send_whole_msg(ObJoinFilterPieceMsgCtx& ctx);
+  DISALLOW_COPY_AND_ASSIGN(ObJoinFilterPieceMsgListener);
+};
+
+}  // namespace sql
+}  // namespace oceanbase
+#endif /* __OB_SQL_ENG_PX_DH_JOIN_FILTER_H__ */
+//// end of header file
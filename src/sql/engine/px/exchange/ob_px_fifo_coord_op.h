@@ -26,6 +26,7 @@
 #include "sql/engine/px/ob_dfo_scheduler.h"
 #include "sql/engine/px/datahub/components/ob_dh_barrier.h"
 #include "sql/engine/px/datahub/components/ob_dh_winbuf.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 
 namespace oceanbase {
 namespace sql {
@@ -98,6 +99,7 @@ private:
   ObPxInitSqcResultP sqc_init_msg_proc_;
   ObBarrierPieceMsgP barrier_piece_msg_proc_;
   ObWinbufPieceMsgP winbuf_piece_msg_proc_;
+  ObJoinFilterPieceMsgP join_filter_piece_msg_proc_;
   ObPxQcInterruptedP interrupt_proc_;
 };
 
@@ -363,6 +363,39 @@ int ObPxFifoReceiveOp::inner_close()
 }
 
 int ObPxFifoReceiveOp::inner_get_next_row()
+{
+  int64_t read_rows = 0;
+  return fetch_rows(0, read_rows);
+}
+
+// Rows of the batch are read from one message, datums may point to the message buffer
+// which is kept until next message processed.
+int ObPxFifoReceiveOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  int64_t read_rows = 0;
+  if (iter_end_) {
+    brs_.size_ = 0;
+    brs_.end_ = true;
+  } else if (OB_FAIL(fetch_rows(max_row_cnt, read_rows))) {
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+      brs_.size_ = 0;
+      brs_.end_ = true;
+    } else {
+      LOG_WARN("fetch rows failed", K(ret));
+    }
+  } else {
+    const ObPxReceiveSpec& spec = static_cast<const ObPxReceiveSpec&>(get_spec());
+    set_batch_evaluated(spec.child_exprs_, read_rows);
+    if (OB_FAIL(filter_and_project_batch(read_rows))) {
+      LOG_WARN("filter and project batch failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObPxFifoReceiveOp::fetch_rows(const int64_t max_row_cnt, int64_t& read_rows)
 {
   int ret = OB_SUCCESS;
   ObPhysicalPlanCtx* phy_plan_ctx = GET_PHY_PLAN_CTX(ctx_);
@@ -382,11 +415,11 @@ int ObPxFifoReceiveOp::inner_get_next_row()
     int64_t retry_cnt = 0;
     do {
       clear_evaluated_flag();
-      ret = get_one_row_from_channels(timeout_ts - get_timestamp());
+      ret = get_rows_from_channels(max_row_cnt, timeout_ts - get_timestamp(), read_rows);
       if (OB_SUCCESS == ret) {
         metric_.mark_first_out();
-        LOG_DEBUG("Got one row from channel", K(ret));
-        break;  // got one row
+        LOG_DEBUG("Got rows from channel", K(ret), K(read_rows));
+        break;  // got rows
       } else if (OB_ITER_END == ret) {
         if (GCONF.enable_sql_audit) {
           op_monitor_info_.otherstat_2_id_ = ObSqlMonitorStatIds::EXCHANGE_EOF_TIMESTAMP;
@@ -441,10 +474,12 @@ int ObPxFifoReceiveOp::try_link_channel()
   return ret;
 }
 
-int ObPxFifoReceiveOp::get_one_row_from_channels(int64_t timeout_us)
+int ObPxFifoReceiveOp::get_rows_from_channels(const int64_t max_row_cnt, int64_t timeout_us, int64_t& read_rows)
 {
   int ret = OB_SUCCESS;
   bool got_row = false;
+  const ObIArray<ObExpr*>& child_exprs = (static_cast<const ObPxReceiveSpec*>(&get_spec()))->child_exprs_;
+  read_rows = 0;
   while (!got_row && OB_SUCC(ret)) {
     clear_evaluated_flag();
     if (OB_FAIL(msg_loop_.process_one(timeout_us))) {
@@ -452,7 +487,12 @@ int ObPxFifoReceiveOp::get_one_row_from_channels(int64_t timeout_us)
         LOG_WARN("fail pop sqc execution result from channel", K(ret));
       }
     } else {
-      ret = px_row_.get_next_row((static_cast<const ObPxReceiveSpec*>(&get_spec()))->child_exprs_, eval_ctx_);
+      if (0 == max_row_cnt) {
+        ret = px_row_.get_next_row(child_exprs, eval_ctx_);
+        read_rows = 1;
+      } else {
+        ret = px_row_.get_next_batch(child_exprs, eval_ctx_, max_row_cnt, read_rows);
+      }
       if (OB_ITER_END == ret) {
         finish_ch_cnt_++;
         if (finish_ch_cnt_ < task_channels_.count()) {
@@ -462,7 +502,7 @@ int ObPxFifoReceiveOp::get_one_row_from_channels(int64_t timeout_us)
         }
       } else if (OB_SUCCESS == ret) {
         got_row = true;
-        metric_.count();
+        metric_.count(read_rows);
       } else {
         LOG_WARN("fail get row from row store", K(ret));
       }
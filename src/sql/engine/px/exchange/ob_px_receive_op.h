@@ -200,10 +200,13 @@ protected:
   virtual int inner_open();
   virtual int inner_close();
   virtual int inner_get_next_row();
+  virtual int inner_get_next_batch(const int64_t max_row_cnt) override;
   virtual int try_link_channel() override;
 
 private:
-  int get_one_row_from_channels(int64_t timeout_us);
+  // fetch one row if %max_row_cnt is zero, otherwise fetch at most %max_row_cnt rows of one message.
+  int fetch_rows(const int64_t max_row_cnt, int64_t& read_rows);
+  int get_rows_from_channels(const int64_t max_row_cnt, int64_t timeout_us, int64_t& read_rows);
 
 private:
   ObPxInterruptP interrupt_proc_;
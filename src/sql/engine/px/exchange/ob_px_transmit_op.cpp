@@ -19,6 +19,8 @@
 #include "sql/engine/px/ob_px_util.h"
 #include "sql/dtl/ob_dtl_channel_group.h"
 #include "sql/dtl/ob_dtl_utils.h"
+#include "sql/engine/px/ob_px_sqc_handler.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase {
 using namespace common;
@@ -72,10 +74,39 @@ int ObPxTransmitOpInput::get_data_ch(ObPxTaskChSet& task_ch_set, int64_t timeout
   return ret;
 }
 //------------- end ObPxTransmitOpInput -------
-OB_SERIALIZE_MEMBER((ObPxTransmitSpec, ObTransmitSpec), partition_id_idx_);
+OB_SERIALIZE_MEMBER((ObPxTransmitSpec, ObTransmitSpec), partition_id_idx_, join_filter_id_, join_filter_exprs_,
+    join_filter_hash_funcs_);
+
+int ObPxTransmitSpec::register_to_datahub(ObExecContext& ctx) const
+{
+  int ret = OB_SUCCESS;
+  if (has_join_filter()) {
+    if (OB_ISNULL(ctx.get_sqc_handler())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null unexpected", K(ret));
+    } else {
+      void* buf = ctx.get_allocator().alloc(sizeof(ObJoinFilterWholeMsg::WholeMsgProvider));
+      if (OB_ISNULL(buf)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+      } else {
+        ObJoinFilterWholeMsg::WholeMsgProvider* provider = new (buf) ObJoinFilterWholeMsg::WholeMsgProvider();
+        ObSqcCtx& sqc_ctx = ctx.get_sqc_handler()->get_sqc_ctx();
+        // the whole msg is keyed by the hash join which builds the filter
+        if (OB_FAIL(sqc_ctx.add_whole_msg_provider(join_filter_id_, *provider))) {
+          LOG_WARN("fail add whole msg provider", K(ret));
+        }
+      }
+    }
+  }
+  return ret;
+}
 
 ObPxTransmitSpec::ObPxTransmitSpec(ObIAllocator& alloc, const ObPhyOperatorType type)
-    : ObTransmitSpec(alloc, type), partition_id_idx_(OB_INVALID_INDEX)
+    : ObTransmitSpec(alloc, type),
+      partition_id_idx_(OB_INVALID_INDEX),
+      join_filter_id_(OB_INVALID_ID),
+      join_filter_exprs_(alloc),
+      join_filter_hash_funcs_(alloc)
 {}
 
 ObPxTransmitOp::ObPxTransmitOp(ObExecContext& exec_ctx, const ObOpSpec& spec, ObOpInput* input)
@@ -89,8 +120,17 @@ ObPxTransmitOp::ObPxTransmitOp(ObExecContext& exec_ctx, const ObOpSpec& spec, Ob
       chs_agent_(),
       use_bcast_opt_(false),
       part_ch_info_(),
-      ch_info_(nullptr)
-
+      ch_info_(nullptr),
+      join_filter_msg_(nullptr),
+      join_filter_subscribed_(false),
+      join_filter_disabled_(false),
+      join_filter_row_cnt_(0),
+      join_filter_last_poll_ts_(0),
+      join_filter_filtered_cnt_(0),
+      child_brs_(nullptr),
+      child_brs_idx_(0),
+      slice_indexes_(nullptr),
+      data_msg_type_(ObDtlMsgType::PX_DATUM_ROW)
 {}
 
 void ObPxTransmitOp::destroy()
@@ -125,6 +165,13 @@ int ObPxTransmitOp::inner_open()
     if (child_->get_spec().is_dml_operator() && !child_->get_spec().is_pdml_operator()) {
       iter_end_ = true;
       LOG_TRACE("transmit iter end", K(ret), K(iter_end_));
+    } else if (child_->get_spec().is_vectorized()) {
+      if (OB_FAIL(next_batch())) {
+        LOG_WARN("fail to get next batch", K(ret));
+      } else {
+        iter_end_ = child_brs_->end_ && 0 == child_brs_->size_;
+        LOG_TRACE("transmit iter end", K(ret), K(iter_end_));
+      }
     } else if ((ret = ObOperator::get_next_row()) != OB_SUCCESS && (ret != OB_ITER_END)) {
       LOG_WARN("fail to get next row", K(ret));
     } else {
@@ -217,6 +264,13 @@ int ObPxTransmitOp::init_channel(ObPxTransmitOpInput& trans_input)
       LOG_WARN("fail to get ch provider ptr", K(ret));
     } else {
       use_interm_result = sqc_proxy->get_transmit_use_interm_result();
+      // interm result is stored and read in datum row format,
+      // and receivers of an older version can not decode the columnar format
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(ctx_.get_my_session()->get_effective_tenant_id()));
+      if (tenant_config.is_valid() && tenant_config->_px_columnar_message && !use_interm_result &&
+          GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_316) {
+        data_msg_type_ = ObDtlMsgType::PX_VECTOR_ROW;
+      }
     }
     loop_.set_interm_result(use_interm_result);
     ARRAY_FOREACH_X(channels, idx, cnt, OB_SUCC(ret))
@@ -240,9 +294,88 @@ int ObPxTransmitOp::init_channel(ObPxTransmitOpInput& trans_input)
 int ObPxTransmitOp::inner_get_next_row()
 {
   int ret = OB_SUCCESS;
-  clear_evaluated_flag();
-  if (OB_FAIL(child_->get_next_row()) && OB_ITER_END != ret) {
-    LOG_WARN("get next row from child failed", K(ret));
+  const bool has_join_filter = static_cast<const ObPxTransmitSpec&>(get_spec()).has_join_filter();
+  bool filtered = false;
+  do {
+    clear_evaluated_flag();
+    if (OB_FAIL(child_->get_next_row())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("get next row from child failed", K(ret));
+      }
+    } else if (has_join_filter && !join_filter_disabled_ && OB_FAIL(filter_by_join_filter(filtered))) {
+      LOG_WARN("fail to filter row by join filter", K(ret));
+    }
+  } while (OB_SUCC(ret) && filtered);
+  return ret;
+}
+
+// Rows whose join keys are not in the build side of the hash join are dropped here, before they
+// are shipped through DTL. Never waits for the filter, it is checked every JOIN_FILTER_POLL_INTERVAL.
+int ObPxTransmitOp::filter_by_join_filter(bool& filtered)
+{
+  int ret = OB_SUCCESS;
+  const ObPxTransmitSpec& spec = static_cast<const ObPxTransmitSpec&>(get_spec());
+  filtered = false;
+  if (nullptr == join_filter_msg_ && 0 == (join_filter_row_cnt_ % JOIN_FILTER_CHECK_INTERVAL) &&
+      ObTimeUtility::current_time() - join_filter_last_poll_ts_ >= JOIN_FILTER_POLL_INTERVAL) {
+    if (OB_FAIL(fetch_join_filter())) {
+      LOG_WARN("fail to fetch join filter", K(ret));
+    }
+  }
+  join_filter_row_cnt_++;
+  if (OB_SUCC(ret) && nullptr != join_filter_msg_) {
+    uint64_t hash_val = 0;
+    if (OB_FAIL(ObPxBloomFilter::calc_hash_value(
+            spec.join_filter_exprs_, spec.join_filter_hash_funcs_, eval_ctx_, hash_val))) {
+      LOG_WARN("fail to calc join filter hash value", K(ret));
+    } else if (!join_filter_msg_->filter_.might_contain(hash_val)) {
+      filtered = true;
+      join_filter_filtered_cnt_++;
+    }
+  }
+  return ret;
+}
+
+int ObPxTransmitOp::fetch_join_filter()
+{
+  int ret = OB_SUCCESS;
+  const ObPxTransmitSpec& spec = static_cast<const ObPxTransmitSpec&>(get_spec());
+  ObPxSqcHandler* handler = ctx_.get_sqc_handler();
+  const int64_t timeout_ts = ctx_.get_physical_plan_ctx()->get_timeout_timestamp();
+  join_filter_last_poll_ts_ = ObTimeUtility::current_time();
+  if (OB_ISNULL(handler) || GET_MIN_CLUSTER_VERSION() < CLUSTER_VERSION_316) {
+    // the build side never sends the filter to old servers, do not subscribe
+    join_filter_disabled_ = true;
+  } else if (!join_filter_subscribed_) {
+    ObJoinFilterPieceMsg piece;
+    piece.op_id_ = spec.join_filter_id_;
+    piece.thread_id_ = GETTID();
+    piece.dfo_id_ = handler->get_sqc_proxy().get_dfo_id();
+    piece.is_build_ = false;
+    if (OB_FAIL(handler->get_sqc_proxy().send_dh_piece(piece, timeout_ts))) {
+      LOG_WARN("fail to subscribe join filter", K(ret));
+    } else {
+      join_filter_subscribed_ = true;
+    }
+  }
+  if (OB_SUCC(ret) && join_filter_subscribed_) {
+    const ObJoinFilterWholeMsg* whole = nullptr;
+    if (OB_FAIL(handler->get_sqc_proxy().poll_dh_msg(spec.join_filter_id_, whole, timeout_ts))) {
+      if (OB_EAGAIN == ret) {
+        ret = OB_SUCCESS;
+      } else {
+        LOG_WARN("fail to poll join filter", K(ret));
+      }
+    } else if (OB_ISNULL(whole)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("whole msg is unexpected", K(ret));
+    } else if (!whole->is_valid_ || !whole->filter_.is_inited()) {
+      join_filter_disabled_ = true;
+      LOG_TRACE("join filter is not selective, disabled", K(spec.join_filter_id_), K(join_filter_row_cnt_));
+    } else {
+      join_filter_msg_ = whole;
+      LOG_TRACE("join filter arrived", K(spec.join_filter_id_), K(join_filter_row_cnt_));
+    }
   }
   return ret;
 }
@@ -262,6 +395,14 @@ int ObPxTransmitOp::inner_close()
   }
   op_monitor_info_.otherstat_3_id_ = ObSqlMonitorStatIds::DTL_SEND_RECV_COUNT;
   op_monitor_info_.otherstat_3_value_ = recv_cnt;
+  if (static_cast<const ObPxTransmitSpec&>(get_spec()).has_join_filter()) {
+    LOG_TRACE("join filter stat",
+        "op_id",
+        get_spec().id_,
+        K(join_filter_row_cnt_),
+        K(join_filter_filtered_cnt_),
+        K(join_filter_disabled_));
+  }
   int release_channel_ret = loop_.unregister_all_channel();
   if (release_channel_ret != common::OB_SUCCESS) {
     // the following unlink actions is not safe is any unregister failure happened
@@ -283,6 +424,20 @@ int ObPxTransmitOp::inner_close()
 }
 
 int ObPxTransmitOp::send_rows(ObSliceIdxCalc& slice_calc)
+{
+  int ret = OB_SUCCESS;
+  const ObPxTransmitSpec& spec = static_cast<const ObPxTransmitSpec&>(get_spec());
+  // partition id of pdml is got row by row after slice index calculated.
+  if (child_->get_spec().is_vectorized() && slice_calc.support_slice_idx_batch() &&
+      !spec.has_partition_id_column_idx()) {
+    ret = send_rows_in_batch(slice_calc);
+  } else {
+    ret = send_rows_one_by_one(slice_calc);
+  }
+  return ret;
+}
+
+int ObPxTransmitOp::send_rows_one_by_one(ObSliceIdxCalc& slice_calc)
 {
   int ret = OB_SUCCESS;
   int64_t send_row_time_recorder = 0;
@@ -335,6 +490,76 @@ int ObPxTransmitOp::send_rows(ObSliceIdxCalc& slice_calc)
   return ret;
 }
 
+int ObPxTransmitOp::send_rows_in_batch(ObSliceIdxCalc& slice_calc)
+{
+  int ret = OB_SUCCESS;
+  int64_t send_row_time_recorder = 0;
+  int64_t row_count = 0;
+  const ObPxTransmitSpec& spec = static_cast<const ObPxTransmitSpec&>(get_spec());
+  const bool has_join_filter = spec.has_join_filter();
+  const int64_t max_batch_size = child_->get_spec().max_batch_size_;
+  if (nullptr == slice_indexes_) {
+    void* buf = ctx_.get_allocator().alloc(sizeof(int64_t) * max_batch_size);
+    if (OB_ISNULL(buf)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc slice indexes failed", K(ret), K(max_batch_size));
+    } else {
+      slice_indexes_ = static_cast<int64_t*>(buf);
+    }
+  }
+  while (OB_SUCC(ret)) {
+    if (iter_end_) {
+      if (OB_FAIL(send_eof_row())) {
+        LOG_WARN("fail send eof rows to channels", K(ret));
+      }
+      break;
+    }
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+    batch_info_guard.set_batch_size(child_brs_->size_);
+    clear_evaluated_flag();
+    if (OB_FAIL(slice_calc.get_slice_idx_batch(
+            get_spec().output_, eval_ctx_, *child_brs_->skip_, child_brs_->size_, slice_indexes_))) {
+      LOG_WARN("fail get slice idx batch", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < child_brs_->size_; i++) {
+      bool filtered = false;
+      if (child_brs_->skip_->at(i)) {
+        continue;
+      }
+      clear_evaluated_flag();
+      batch_info_guard.set_batch_idx(i);
+      if (has_join_filter && !join_filter_disabled_ && OB_FAIL(filter_by_join_filter(filtered))) {
+        LOG_WARN("fail to filter row by join filter", K(ret));
+      } else if (filtered) {
+        // drop the row
+      } else if (dfc_.all_ch_drained()) {
+        ret = OB_ITER_END;
+        LOG_DEBUG("all channel has been drained");
+      } else {
+        row_count++;
+        metric_.count();
+        if (OB_FAIL(send_row(slice_indexes_[i], send_row_time_recorder, OB_INVALID_INDEX))) {
+          if (OB_ITER_END != ret) {
+            LOG_WARN("fail emit row to interm result", K(ret), K(slice_indexes_[i]));
+          }
+        }
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (child_brs_->end_) {
+      iter_end_ = true;
+    } else if (OB_FAIL(next_batch())) {
+      LOG_WARN("fail to get next batch", K(ret));
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+    LOG_TRACE("transmit meet a iter end");
+  }
+  LOG_TRACE("Transmit time record", K(row_count), K(ret));
+  return ret;
+}
+
 int ObPxTransmitOp::send_eof_row()
 {
   int ret = OB_SUCCESS;
@@ -345,7 +570,7 @@ int ObPxTransmitOp::send_eof_row()
     LOG_WARN("unexpected status: ch info is null", K(ret), KP(ch_info_), K(task_channels_.count()));
   } else {
     ObTransmitEofAsynSender eof_asyn_sender(
-        task_channels_, ch_info_, true, phy_plan_ctx->get_timeout_timestamp(), &eval_ctx_);
+        task_channels_, ch_info_, true, phy_plan_ctx->get_timeout_timestamp(), &eval_ctx_, data_msg_type_);
     if (OB_FAIL(eof_asyn_sender.asyn_send())) {
       LOG_WARN("failed to asyn send drain", K(ret), K(lbt()));
     } else if (GCONF.enable_sql_audit) {
@@ -448,6 +673,7 @@ int ObPxTransmitOp::send_row(int64_t slice_idx, int64_t& time_recorder, int64_t
     LOG_WARN("failed to update cur row expr", K(ret));
   } else {
     ObPxNewRow px_row(get_spec().output_);
+    px_row.set_data_type(data_msg_type_);
     if (OB_FAIL(ret)) {
     } else if (OB_FAIL(ch->send(px_row, phy_plan_ctx->get_timeout_timestamp(), &eval_ctx_))) {
       if (OB_ITER_END != ret) {
@@ -488,6 +714,8 @@ int ObPxTransmitOp::next_row()
     ret = OB_ITER_END;
     consume_first_row_ = true;
     LOG_TRACE("transmit iter end", K(ret), K(iter_end_));
+  } else if (child_->get_spec().is_vectorized()) {
+    ret = next_row_from_batch();
   } else if (!consume_first_row_) {
     consume_first_row_ = true;
   } else {
@@ -496,6 +724,44 @@ int ObPxTransmitOp::next_row()
   return ret;
 }
 
+// Iterate rows of child batch, the same as inner_get_next_row() for row by row child.
+int ObPxTransmitOp::next_row_from_batch()
+{
+  int ret = OB_SUCCESS;
+  const bool has_join_filter = static_cast<const ObPxTransmitSpec&>(get_spec()).has_join_filter();
+  bool got_row = false;
+  while (OB_SUCC(ret) && !got_row) {
+    if (child_brs_idx_ < child_brs_->size_) {
+      const int64_t idx = child_brs_idx_++;
+      bool filtered = false;
+      if (!child_brs_->skip_->at(idx)) {
+        clear_evaluated_flag();
+        eval_ctx_.set_batch_idx(idx);
+        if (has_join_filter && !join_filter_disabled_ && OB_FAIL(filter_by_join_filter(filtered))) {
+          LOG_WARN("fail to filter row by join filter", K(ret));
+        } else {
+          got_row = !filtered;
+        }
+      }
+    } else if (child_brs_->end_) {
+      ret = OB_ITER_END;
+    } else if (OB_FAIL(next_batch())) {
+      LOG_WARN("fail to get next batch", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObPxTransmitOp::next_batch()
+{
+  int ret = OB_SUCCESS;
+  child_brs_idx_ = 0;
+  if (OB_FAIL(child_->get_next_batch(child_->get_spec().max_batch_size_, child_brs_))) {
+    LOG_WARN("get next batch from child failed", K(ret));
+  }
+  return ret;
+}
+
 int ObPxTransmitOp::link_ch_sets(
     ObPxTaskChSet& ch_set, common::ObIArray<dtl::ObDtlChannel*>& channels, ObDtlFlowControl* dfc)
 {
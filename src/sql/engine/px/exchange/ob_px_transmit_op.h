@@ -24,6 +24,7 @@
 #include "sql/dtl/ob_dtl_task.h"
 #include "sql/engine/px/ob_px_dtl_proc.h"
 #include "sql/engine/px/ob_px_sqc_proxy.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
 #include "sql/dtl/ob_dtl_linked_buffer.h"
 #include "sql/executor/ob_slice_calc.h"
 
@@ -83,9 +84,23 @@ public:
     return partition_id_idx_;
   }
 
+  OB_INLINE bool has_join_filter() const
+  {
+    return common::OB_INVALID_ID != join_filter_id_;
+  }
+
+  virtual int register_to_datahub(ObExecContext& ctx) const override;
+
 private:
   // in pdm, partition_id_exprs position of output_exprs
   int32_t partition_id_idx_;
+
+public:
+  // id of the hash join whose build side filter is applied to the rows sent by this transmit
+  uint64_t join_filter_id_;
+  // right join keys of the hash join and their murmur hash funcs
+  ExprFixedArray join_filter_exprs_;
+  common::ObHashFuncs join_filter_hash_funcs_;
 };
 
 class ObPxTransmitOp : public ObTransmitOp {
@@ -116,6 +131,11 @@ public:
     return task_channels_;
   }
 
+protected:
+  // rows between two checks of the poll interval
+  static const int64_t JOIN_FILTER_CHECK_INTERVAL = 1024;
+  static const int64_t JOIN_FILTER_POLL_INTERVAL = 50 * 1000;  // 50ms
+
 protected:
   virtual int do_transmit() = 0;
   static int link_ch_sets(
@@ -124,11 +144,18 @@ protected:
   int broadcast_rows(ObSliceIdxCalc& slice_calc);
 
 private:
+  int send_rows_one_by_one(ObSliceIdxCalc& slice_calc);
+  // rows are fetched from vectorized child in batch, slice indexes of the batch are calculated at once.
+  int send_rows_in_batch(ObSliceIdxCalc& slice_calc);
   int update_row(int partition_id_column_idx, int64_t partition_id);
   int send_row(int64_t slice_idx, int64_t& time_recorder, int64_t partition_id);
   int send_eof_row();
   int broadcast_eof_row();
   int next_row();
+  int next_row_from_batch();
+  int next_batch();
+  int filter_by_join_filter(bool& filtered);
+  int fetch_join_filter();
 
 protected:
   common::ObArray<dtl::ObDtlChannel*> task_channels_;
@@ -147,6 +174,19 @@ protected:
   bool use_bcast_opt_;
   ObPxPartChInfo part_ch_info_;
   dtl::ObDtlChTotalInfo* ch_info_;
+  // join filter arrives asynchronously, rows pass through unfiltered until then
+  const ObJoinFilterWholeMsg* join_filter_msg_;
+  bool join_filter_subscribed_;
+  bool join_filter_disabled_;
+  int64_t join_filter_row_cnt_;
+  int64_t join_filter_last_poll_ts_;
+  int64_t join_filter_filtered_cnt_;
+  // batch of vectorized child and index of next row in it
+  const ObBatchRows* child_brs_;
+  int64_t child_brs_idx_;
+  int64_t* slice_indexes_;
+  // PX_VECTOR_ROW if rows are sent in columnar format, otherwise PX_DATUM_ROW
+  dtl::ObDtlMsgType data_msg_type_;
 };
 
 }  // end namespace sql
@@ -434,6 +434,60 @@ int ObGranuleIteratorOp::try_get_next_row()
   return ret;
 }
 
+// The same state machine as try_get_next_row(), batches of child are passed through.
+int ObGranuleIteratorOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  bool got_batch = false;
+  const ObBatchRows* child_brs = NULL;
+  do {
+    clear_evaluated_flag();
+    switch (state_) {
+      case GI_UNINITIALIZED: {
+        state_ = GI_GET_NEXT_GRANULE_TASK;
+        break;
+      }
+      case GI_GET_NEXT_GRANULE_TASK: {
+        if (OB_FAIL(do_get_next_granule_task())) {
+          if (ret != OB_ITER_END) {
+            LOG_WARN("fail to get next granule task", K(ret));
+          }
+        }
+      } break;
+      case GI_PREPARED:
+      case GI_TABLE_SCAN: {
+        if (OB_FAIL(child_->get_next_batch(max_row_cnt, child_brs))) {
+          LOG_WARN("get next batch from child failed", K(ret));
+        } else {
+          if (child_brs->end_) {
+            state_ = GI_GET_NEXT_GRANULE_TASK;
+          }
+          if (child_brs->size_ > 0) {
+            brs_.size_ = child_brs->size_;
+            brs_.skip_->bit_or(*child_brs->skip_, child_brs->size_);
+            got_batch = true;
+          }
+        }
+        break;
+      }
+      case GI_END: {
+        ret = OB_ITER_END;
+        break;
+      }
+      default: {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected state", K(ret), K(state_));
+      }
+    }
+  } while (!(got_batch || OB_FAIL(ret)));
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+    brs_.size_ = 0;
+    brs_.end_ = true;
+  }
+  return ret;
+}
+
 /*
  *  this function will get a scan task from the task pump,
  *  and reset the table-scan operator below this operator.
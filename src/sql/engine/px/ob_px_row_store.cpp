@@ -150,6 +150,23 @@ int ObPxNewRow::get_next_row(const ObIArray<ObExpr*>& exprs, ObEvalCtx& ctx)
   return ret;
 }
 
+int ObPxNewRow::get_next_batch(
+    const ObIArray<ObExpr*>& exprs, ObEvalCtx& ctx, const int64_t max_rows, int64_t& read_rows)
+{
+  int ret = OB_SUCCESS;
+  if (has_iter()) {
+    if (OB_FAIL(iter_->get_next_batch(exprs, ctx, max_rows, read_rows))) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("failed to get batch from iterator", K(ret));
+      }
+    }
+  } else {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected status: get datum without iterator", K(ret));
+  }
+  return ret;
+}
+
 int ObPxNewRow::get_row_from_serialization(ObNewRow& row)
 {
   int ret = OB_SUCCESS;
@@ -342,6 +359,27 @@ int ObPxDatumRowIterator::get_next_row(const ObIArray<ObExpr*>& exprs, ObEvalCtx
   return ret;
 }
 
+int ObPxDatumRowIterator::get_next_batch(
+    const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, const int64_t max_rows, int64_t& read_rows)
+{
+  int ret = OB_SUCCESS;
+  read_rows = 0;
+  ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx);
+  batch_info_guard.set_batch_size(max_rows);
+  // the first row is always got to report iterate end, rows of next buffer are never read.
+  while (OB_SUCC(ret) && read_rows < max_rows && (0 == read_rows || has_next())) {
+    batch_info_guard.set_batch_idx(read_rows);
+    if (OB_FAIL(get_next_row(exprs, eval_ctx))) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("get next row failed", K(ret));
+      }
+    } else {
+      read_rows += 1;
+    }
+  }
+  return ret;
+}
+
 void ObPxDatumRowIterator::reset()
 {
   datum_store_.remove_added_blocks();
@@ -352,3 +390,178 @@ void ObPxDatumRowIterator::reset()
   is_inited_ = false;
 }
 //-------- end ObPxDatumRowIterator --------
+
+//-------- start ObPxVectorsIterator --------
+ObPxVectorsIterator::ObPxVectorsIterator()
+    : is_eof_(false),
+      is_iter_end_(false),
+      rows_(0),
+      read_rows_(0),
+      buf_end_(NULL),
+      vectors_(NULL),
+      vectors_row_idx_(0),
+      is_inited_(false)
+{}
+
+ObPxVectorsIterator::~ObPxVectorsIterator()
+{
+  reset();
+}
+
+void ObPxVectorsIterator::set_iterator_end()
+{
+  if (is_eof_) {
+    is_iter_end_ = true;
+    vectors_ = NULL;
+  }
+}
+
+void ObPxVectorsIterator::set_end()
+{
+  is_iter_end_ = true;
+  is_eof_ = true;
+}
+
+int ObPxVectorsIterator::load_buffer(const dtl::ObDtlLinkedBuffer& buffer)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_UNLIKELY(buffer.size() < static_cast<int64_t>(sizeof(dtl::ObDtlVectorsBlock)))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid vectors buffer", K(ret), K(buffer.size()));
+  } else {
+    const dtl::ObDtlVectorsBlock* block = reinterpret_cast<const dtl::ObDtlVectorsBlock*>(buffer.buf());
+    rows_ = block->row_cnt_;
+    read_rows_ = 0;
+    buf_end_ = buffer.buf() + buffer.size();
+    vectors_ = rows_ > 0 ? reinterpret_cast<const dtl::ObDtlVectors*>(block->payload()) : NULL;
+    vectors_row_idx_ = 0;
+    is_eof_ = buffer.is_eof();
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObPxVectorsIterator::check_status()
+{
+  int ret = OB_SUCCESS;
+  if (is_iter_end_) {
+    if (!is_eof_) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("row store is not eof", K(ret));
+    } else {
+      ret = OB_ITER_END;
+    }
+  } else if (!is_inited_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("row store is not init", K(ret));
+  } else if (!has_next()) {
+    ret = OB_ITER_END;
+  }
+  return ret;
+}
+
+int ObPxVectorsIterator::next_vectors()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(vectors_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("vectors is null", K(ret), K_(rows), K_(read_rows));
+  } else if (vectors_row_idx_ >= vectors_->row_cnt_) {
+    const char* next = reinterpret_cast<const char*>(vectors_) + vectors_->size_;
+    if (OB_UNLIKELY(next + sizeof(dtl::ObDtlVectors) > buf_end_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("vectors out of buffer", K(ret), K(*vectors_), K_(rows), K_(read_rows));
+    } else {
+      vectors_ = reinterpret_cast<const dtl::ObDtlVectors*>(next);
+      vectors_row_idx_ = 0;
+    }
+  }
+  return ret;
+}
+
+int ObPxVectorsIterator::get_next_row(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(check_status())) {
+  } else if (OB_FAIL(next_vectors())) {
+    LOG_WARN("move to next vectors failed", K(ret));
+  } else if (OB_UNLIKELY(exprs.count() != vectors_->col_cnt_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("column count mismatch", K(ret), K(exprs.count()), K(*vectors_));
+  } else {
+    for (int64_t i = 0; i < exprs.count(); i++) {
+      ObExpr* expr = exprs.at(i);
+      vectors_->get_datum(i, vectors_row_idx_, expr->locate_expr_datum(eval_ctx));
+      expr->get_eval_info(eval_ctx).evaluated_ = true;
+    }
+    vectors_row_idx_ += 1;
+    read_rows_ += 1;
+  }
+  if (OB_FAIL(ret)) {
+    if (OB_ITER_END == ret) {
+      if (!is_eof_) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("expect eof", K(ret));
+      }
+      LOG_TRACE("iterator end from px vectors", K(ret), K(is_eof_));
+      reset();
+    }
+  }
+  return ret;
+}
+
+// Datums of batch are assigned only, caller should mark the expressions evaluated.
+int ObPxVectorsIterator::get_next_batch(
+    const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, const int64_t max_rows, int64_t& read_rows)
+{
+  int ret = OB_SUCCESS;
+  read_rows = 0;
+  if (OB_FAIL(check_status())) {
+  } else if (OB_FAIL(next_vectors())) {
+    LOG_WARN("move to next vectors failed", K(ret));
+  } else if (OB_UNLIKELY(exprs.count() != vectors_->col_cnt_ || max_rows <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("column count mismatch or invalid max rows", K(ret), K(exprs.count()), K(max_rows), K(*vectors_));
+  } else {
+    const int64_t batch_rows = vectors_->row_cnt_ - vectors_row_idx_;
+    read_rows = std::min(batch_rows, max_rows);
+    for (int64_t i = 0; i < exprs.count(); i++) {
+      ObExpr* expr = exprs.at(i);
+      if (0 == vectors_row_idx_ && read_rows == batch_rows && expr->is_batch_result()) {
+        // the whole batch, assign column at once
+        vectors_->get_datums(i, expr->locate_batch_datums(eval_ctx));
+      } else {
+        for (int64_t j = 0; j < read_rows; j++) {
+          vectors_->get_datum(i, vectors_row_idx_ + j, expr->locate_expr_datum(eval_ctx, j));
+        }
+      }
+    }
+    vectors_row_idx_ += read_rows;
+    read_rows_ += read_rows;
+  }
+  if (OB_FAIL(ret)) {
+    if (OB_ITER_END == ret) {
+      if (!is_eof_) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("expect eof", K(ret));
+      }
+      LOG_TRACE("iterator end from px vectors", K(ret), K(is_eof_));
+      reset();
+    }
+  }
+  return ret;
+}
+
+void ObPxVectorsIterator::reset()
+{
+  rows_ = 0;
+  read_rows_ = 0;
+  buf_end_ = NULL;
+  vectors_ = NULL;
+  vectors_row_idx_ = 0;
+  is_eof_ = false;
+  is_iter_end_ = false;
+  is_inited_ = false;
+}
+//-------- end ObPxVectorsIterator --------
@@ -20,6 +20,7 @@
 #include "sql/dtl/ob_dtl_msg_type.h"
 #include "sql/dtl/ob_dtl_processor.h"
 #include "sql/dtl/ob_dtl_linked_buffer.h"
+#include "sql/dtl/ob_dtl_vectors.h"
 #include "sql/engine/basic/ob_chunk_row_store.h"
 #include "sql/engine/basic/ob_chunk_datum_store.h"
 
@@ -50,6 +51,15 @@ public:
     UNUSED(eval_ctx);
     return common::OB_ERR_UNEXPECTED;
   }
+  int get_next_batch(
+      const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, const int64_t max_rows, int64_t& read_rows) override
+  {
+    UNUSED(exprs);
+    UNUSED(eval_ctx);
+    UNUSED(max_rows);
+    UNUSED(read_rows);
+    return common::OB_ERR_UNEXPECTED;
+  }
   void reset() override;
 
   bool is_inited() override
@@ -106,6 +116,8 @@ public:
   virtual ~ObPxDatumRowIterator();
 
   int get_next_row(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx) override;
+  int get_next_batch(
+      const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, const int64_t max_rows, int64_t& read_rows) override;
   int get_next_row(common::ObNewRow& row) override
   {
     UNUSED(row);
@@ -161,6 +173,61 @@ private:
   bool is_inited_;
 };
 
+// Reader of PX_VECTOR_ROW buffer, datums point to the buffer directly.
+class ObPxVectorsIterator : public ObDtlMsgReader {
+public:
+  ObPxVectorsIterator();
+  virtual ~ObPxVectorsIterator();
+
+  int get_next_row(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx) override;
+  // rows of one batch at most, %max_rows is ignored if it is less than the rows of batch
+  int get_next_batch(
+      const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, const int64_t max_rows, int64_t& read_rows) override;
+  int get_next_row(common::ObNewRow& row) override
+  {
+    UNUSED(row);
+    return common::OB_ERR_UNEXPECTED;
+  }
+  void reset() override;
+
+  bool is_inited() override
+  {
+    return is_inited_;
+  }
+  bool has_next() override
+  {
+    return read_rows_ < rows_;
+  }
+  bool is_eof()
+  {
+    return is_eof_;
+  }
+
+  bool is_iter_end() override
+  {
+    return is_iter_end_;
+  }
+
+  void set_iterator_end() override;
+  int load_buffer(const dtl::ObDtlLinkedBuffer& buffer) override;
+  void set_end() override;
+
+private:
+  int check_status();
+  // move to next batch if rows of current batch are all read
+  int next_vectors();
+
+private:
+  bool is_eof_;
+  bool is_iter_end_;
+  int64_t rows_;
+  int64_t read_rows_;
+  const char* buf_end_;
+  const dtl::ObDtlVectors* vectors_;
+  int64_t vectors_row_idx_;  // index of next row in vectors_
+  bool is_inited_;
+};
+
 class ObPxNewRow : public dtl::ObDtlMsgTemp<dtl::ObDtlMsgType::PX_NEW_ROW> {
   OB_UNIS_VERSION_V(1);
 
@@ -228,6 +295,8 @@ public:
   }
   virtual int get_row(common::ObNewRow& row);
   virtual int get_next_row(const ObIArray<ObExpr*>& exprs, ObEvalCtx& ctx);
+  virtual int get_next_batch(
+      const ObIArray<ObExpr*>& exprs, ObEvalCtx& ctx, const int64_t max_rows, int64_t& read_rows);
   int deep_copy(common::ObIAllocator& alloc, const ObPxNewRow& other);
   int get_row_from_serialization(ObNewRow& row);
   inline dtl::ObDtlMsgType get_data_type() const
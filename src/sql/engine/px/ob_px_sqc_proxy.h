@@ -75,6 +75,14 @@ public:
   template <class PieceMsg, class WholeMsg>
   int get_dh_msg(uint64_t op_id, const PieceMsg& piece, const WholeMsg*& whole, int64_t timeout_ts);
 
+  // send piece msg to QC without waiting for the whole msg
+  template <class PieceMsg>
+  int send_dh_piece(const PieceMsg& piece, int64_t timeout_ts);
+
+  // non-blocking version of get_dh_msg, OB_EAGAIN is returned if the whole msg is not arrived yet
+  template <class WholeMsg>
+  int poll_dh_msg(uint64_t op_id, const WholeMsg*& whole, int64_t timeout_ts);
+
   int report_task_finish_status(int64_t task_idx, int rc);
 
   // for root thread
@@ -130,6 +138,62 @@ private:
 
 template <class PieceMsg, class WholeMsg>
 int ObPxSQCProxy::get_dh_msg(uint64_t op_id, const PieceMsg& piece, const WholeMsg*& whole, int64_t timeout_ts)
+{
+  int ret = common::OB_SUCCESS;
+  ObPxDatahubDataProvider* provider = nullptr;
+  if (OB_FAIL(get_whole_msg_provider(op_id, provider))) {
+    SQL_LOG(WARN, "fail get provider", K(ret));
+  } else if (OB_FAIL(send_dh_piece(piece, timeout_ts))) {
+    SQL_LOG(WARN, "fail send piece msg", K(ret));
+  } else {
+    typename WholeMsg::WholeMsgProvider* p = static_cast<typename WholeMsg::WholeMsgProvider*>(provider);
+    int64_t wait_count = 0;
+    do {
+      ObSqcLeaderTokenGuard guard(leader_token_lock_);
+      if (guard.hold_token()) {
+        ret = process_dtl_msg(timeout_ts);
+        SQL_LOG(DEBUG, "process dtl msg done", K(ret));
+      }
+      if (OB_SUCC(ret)) {
+        const dtl::ObDtlMsg* msg = nullptr;
+        if (OB_FAIL(p->get_msg_nonblock(msg, timeout_ts))) {
+          SQL_LOG(WARN, "fail get msg", K(timeout_ts), K(ret));
+        } else {
+          whole = static_cast<const WholeMsg*>(msg);
+        }
+      }
+      if (common::OB_EAGAIN == ret) {
+        if (0 == (++wait_count) % 100) {
+          SQL_LOG(TRACE, "try to get datahub data repeatly", K(timeout_ts), K(wait_count), K(ret));
+        }
+        // wait 1000us
+        usleep(1000);
+      }
+    } while (common::OB_EAGAIN == ret);
+  }
+  return ret;
+}
+
+template <class PieceMsg>
+int ObPxSQCProxy::send_dh_piece(const PieceMsg& piece, int64_t timeout_ts)
+{
+  int ret = common::OB_SUCCESS;
+  ObLockGuard<ObSpinLock> lock_guard(dtl_lock_);
+  // TODO: LOCK sqc channel
+  dtl::ObDtlChannel* ch = sqc_arg_.sqc_.get_sqc_channel();
+  if (OB_ISNULL(ch)) {
+    ret = common::OB_ERR_UNEXPECTED;
+    SQL_LOG(WARN, "empty channel", K(ret));
+  } else if (OB_FAIL(ch->send(piece, timeout_ts))) {
+    SQL_LOG(WARN, "fail push data to channel", K(ret));
+  } else if (OB_FAIL(ch->flush())) {
+    SQL_LOG(WARN, "fail flush dtl data", K(ret));
+  }
+  return ret;
+}
+
+template <class WholeMsg>
+int ObPxSQCProxy::poll_dh_msg(uint64_t op_id, const WholeMsg*& whole, int64_t timeout_ts)
 {
   int ret = common::OB_SUCCESS;
   ObPxDatahubDataProvider* provider = nullptr;
@@ -137,44 +201,22 @@ int ObPxSQCProxy::get_dh_msg(uint64_t op_id, const PieceMsg& piece, const WholeM
     SQL_LOG(WARN, "fail get provider", K(ret));
   } else {
     {
-      ObLockGuard<ObSpinLock> lock_guard(dtl_lock_);
-      // TODO: LOCK sqc channel
-      dtl::ObDtlChannel* ch = sqc_arg_.sqc_.get_sqc_channel();
-      if (OB_ISNULL(ch)) {
-        ret = common::OB_ERR_UNEXPECTED;
-        SQL_LOG(WARN, "empty channel", K(ret));
-      } else if (OB_FAIL(ch->send(piece, timeout_ts))) {
-        SQL_LOG(WARN, "fail push data to channel", K(ret));
-      } else if (OB_FAIL(ch->flush())) {
-        SQL_LOG(WARN, "fail flush dtl data", K(ret));
+      ObSqcLeaderTokenGuard guard(leader_token_lock_);
+      if (guard.hold_token()) {
+        ret = process_dtl_msg(timeout_ts);
+        SQL_LOG(DEBUG, "process dtl msg done", K(ret));
       }
     }
-
     if (OB_SUCC(ret)) {
       typename WholeMsg::WholeMsgProvider* p = static_cast<typename WholeMsg::WholeMsgProvider*>(provider);
-      int64_t wait_count = 0;
-      do {
-        ObSqcLeaderTokenGuard guard(leader_token_lock_);
-        if (guard.hold_token()) {
-          ret = process_dtl_msg(timeout_ts);
-          SQL_LOG(DEBUG, "process dtl msg done", K(ret));
+      const dtl::ObDtlMsg* msg = nullptr;
+      if (OB_FAIL(p->get_msg_nonblock(msg, timeout_ts))) {
+        if (common::OB_EAGAIN != ret) {
+          SQL_LOG(WARN, "fail get msg", K(timeout_ts), K(ret));
         }
-        if (OB_SUCC(ret)) {
-          const dtl::ObDtlMsg* msg = nullptr;
-          if (OB_FAIL(p->get_msg_nonblock(msg, timeout_ts))) {
-            SQL_LOG(WARN, "fail get msg", K(timeout_ts), K(ret));
-          } else {
-            whole = static_cast<const WholeMsg*>(msg);
-          }
-        }
-        if (common::OB_EAGAIN == ret) {
-          if (0 == (++wait_count) % 100) {
-            SQL_LOG(TRACE, "try to get datahub data repeatly", K(timeout_ts), K(wait_count), K(ret));
-          }
-          // wait 1000us
-          usleep(1000);
-        }
-      } while (common::OB_EAGAIN == ret);
+      } else {
+        whole = static_cast<const WholeMsg*>(msg);
+      }
     }
   }
   return ret;
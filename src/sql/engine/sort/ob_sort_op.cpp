@@ -285,6 +285,7 @@ int ObSortOp::inner_get_next_row()
     } else {
       OZ(sort_impl_.init(
           tenant_id, &MY_SPEC.sort_collations_, &MY_SPEC.sort_cmp_funs_, &eval_ctx_, MY_SPEC.is_local_merge_sort_));
+      OZ(sort_impl_.init_norm_key(MY_SPEC.all_exprs_));
       read_func_ = &ObSortOp::sort_impl_next;
       sort_impl_.set_input_rows(row_count);
       sort_impl_.set_input_width(MY_SPEC.width_);
@@ -20,6 +20,126 @@ namespace oceanbase {
 using namespace common;
 namespace sql {
 
+/************************************* start ObSortNormKey *********************************/
+bool ObSortNormKey::is_supported(const ObObjType type)
+{
+  bool supported = false;
+  if (type >= ObNullType && type < ObMaxType) {
+    switch (ob_obj_type_class(type)) {
+      case ObIntTC:
+      case ObUIntTC:
+      case ObFloatTC:
+      case ObDoubleTC:
+      case ObDateTimeTC:
+      case ObDateTC:
+      case ObTimeTC:
+      case ObYearTC:
+        supported = true;
+        break;
+      default:
+        break;
+    }
+  }
+  return supported;
+}
+
+static OB_INLINE uint64_t encode_norm_key_double(double v)
+{
+  // -0.0 equals to 0.0
+  v = (0.0 == v) ? 0.0 : v;
+  uint64_t bits = 0;
+  MEMCPY(&bits, &v, sizeof(bits));
+  // negative: reverse all bits, positive: set sign bit
+  return (bits & (1ULL << 63)) ? ~bits : (bits | (1ULL << 63));
+}
+
+uint64_t ObSortNormKey::encode(const ObDatum& datum, const ObObjTypeClass tc, const ObSortFieldCollation& collation)
+{
+  const uint64_t sign_bit = 1ULL << 63;
+  uint64_t key = 0;
+  if (datum.is_null()) {
+    key = (NULL_FIRST == collation.null_pos_) ? 0 : UINT64_MAX;
+  } else {
+    switch (tc) {
+      case ObIntTC:
+        key = static_cast<uint64_t>(ObDatumPayload<ObIntTC>::get(datum)) ^ sign_bit;
+        break;
+      case ObUIntTC:
+        key = ObDatumPayload<ObUIntTC>::get(datum);
+        break;
+      case ObFloatTC:
+        key = encode_norm_key_double(ObDatumPayload<ObFloatTC>::get(datum));
+        break;
+      case ObDoubleTC:
+        key = encode_norm_key_double(ObDatumPayload<ObDoubleTC>::get(datum));
+        break;
+      case ObDateTimeTC:
+        key = static_cast<uint64_t>(ObDatumPayload<ObDateTimeTC>::get(datum)) ^ sign_bit;
+        break;
+      case ObDateTC:
+        key = static_cast<uint64_t>(static_cast<int64_t>(ObDatumPayload<ObDateTC>::get(datum))) ^ sign_bit;
+        break;
+      case ObTimeTC:
+        key = static_cast<uint64_t>(ObDatumPayload<ObTimeTC>::get(datum)) ^ sign_bit;
+        break;
+      case ObYearTC:
+        key = ObDatumPayload<ObYearTC>::get(datum);
+        break;
+      default:
+        // all rows get the same key, falls back to full comparison
+        break;
+    }
+  }
+  return collation.is_ascending_ ? key : ~key;
+}
+
+void ObSortNormKey::radix_sort(Item* items, const int64_t cnt, const int64_t byte_idx)
+{
+  const int64_t BUCKET_CNT = 256;
+  if (cnt <= RADIX_SORT_THRESHOLD || byte_idx >= static_cast<int64_t>(sizeof(uint64_t))) {
+    std::sort(items, items + cnt, [](const Item& l, const Item& r) { return l.key_ < r.key_; });
+  } else {
+    const int64_t shift = (sizeof(uint64_t) - 1 - byte_idx) * 8;
+    int64_t heads[BUCKET_CNT];
+    int64_t tails[BUCKET_CNT];
+    MEMSET(tails, 0, sizeof(tails));
+    for (int64_t i = 0; i < cnt; i++) {
+      tails[(items[i].key_ >> shift) & 0xFF]++;
+    }
+    if (cnt == tails[(items[0].key_ >> shift) & 0xFF]) {
+      // all keys share this byte, move to next byte directly
+      radix_sort(items, cnt, byte_idx + 1);
+    } else {
+      int64_t pos = 0;
+      for (int64_t i = 0; i < BUCKET_CNT; i++) {
+        heads[i] = pos;
+        pos += tails[i];
+        tails[i] = pos;
+      }
+      // permute in place: swap each item into its bucket until the current slot is filled right.
+      for (int64_t i = 0; i < BUCKET_CNT; i++) {
+        while (heads[i] < tails[i]) {
+          Item item = items[heads[i]];
+          int64_t digit = (item.key_ >> shift) & 0xFF;
+          while (digit != i) {
+            std::swap(item, items[heads[digit]++]);
+            digit = (item.key_ >> shift) & 0xFF;
+          }
+          items[heads[i]++] = item;
+        }
+      }
+      // heads[i] is the end of bucket i now
+      int64_t begin = 0;
+      for (int64_t i = 0; i < BUCKET_CNT; i++) {
+        if (heads[i] - begin > 1) {
+          radix_sort(items + begin, heads[i] - begin, byte_idx + 1);
+        }
+        begin = heads[i];
+      }
+    }
+  }
+}
+
 /************************************* start ObSortOpImpl *********************************/
 ObSortOpImpl::Compare::Compare() : ret_(OB_SUCCESS), sort_collations_(nullptr), sort_cmp_funs_(nullptr)
 {}
@@ -155,6 +275,7 @@ ObSortOpImpl::ObSortOpImpl()
       imms_heap_(NULL),
       ems_heap_(NULL),
       next_stored_row_func_(&ObSortOpImpl::array_next_stored_row),
+      norm_key_tc_(ObMaxTC),
       input_rows_(OB_INVALID_ID),
       input_width_(OB_INVALID_ID),
       profile_(ObSqlWorkAreaType::SORT_WORK_AREA),
@@ -219,6 +340,27 @@ int ObSortOpImpl::init(const uint64_t tenant_id, const ObIArray<ObSortFieldColla
   return ret;
 }
 
+int ObSortOpImpl::init_norm_key(const ObIArray<ObExpr*>& exprs)
+{
+  int ret = OB_SUCCESS;
+  norm_key_tc_ = ObMaxTC;
+  if (!is_inited()) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (sort_collations_->empty()) {
+    // no sort column, nothing to do
+  } else {
+    const int64_t idx = sort_collations_->at(0).field_idx_;
+    if (idx < 0 || idx >= exprs.count() || OB_ISNULL(exprs.at(idx))) {
+      ret = OB_INVALID_ARGUMENT;
+      LOG_WARN("invalid sort column", K(ret), K(idx), K(exprs.count()));
+    } else if (ObSortNormKey::is_supported(exprs.at(idx)->datum_meta_.type_)) {
+      norm_key_tc_ = ob_obj_type_class(exprs.at(idx)->datum_meta_.type_);
+    }
+  }
+  return ret;
+}
+
 void ObSortOpImpl::reuse()
 {
   sorted_ = false;
@@ -261,6 +403,7 @@ void ObSortOpImpl::reset()
   need_rewind_ = false;
   sorted_ = false;
   got_first_row_ = false;
+  norm_key_tc_ = ObMaxTC;
   comp_.reset();
   if (NULL != mem_context_) {
     if (NULL != imms_heap_) {
@@ -826,10 +969,16 @@ int ObSortOpImpl::sort_inmem_data()
           }
         }
       }
-      std::sort(&rows_.at(begin), &rows_.at(0) + rows_.count(), CopyableComparer(comp_));
-      if (OB_SUCCESS != comp_.ret_) {
-        ret = comp_.ret_;
-        LOG_WARN("compare failed", K(ret));
+      if (ObMaxTC != norm_key_tc_ && rows_.count() - begin >= NORM_KEY_SORT_MIN_ROW_CNT) {
+        if (OB_FAIL(norm_key_sort(begin))) {
+          LOG_WARN("normalized key sort failed", K(ret), K(begin));
+        }
+      } else {
+        std::sort(&rows_.at(begin), &rows_.at(0) + rows_.count(), CopyableComparer(comp_));
+        if (OB_SUCCESS != comp_.ret_) {
+          ret = comp_.ret_;
+          LOG_WARN("compare failed", K(ret));
+        }
       }
     }
     if (OB_SUCC(ret) && need_imms()) {
@@ -870,6 +1019,52 @@ int ObSortOpImpl::sort_inmem_data()
   return ret;
 }
 
+// Sort rows_[begin, rows_.count()) by normalized key of the first sort column, then sort
+// the rows with equal key by full comparison.
+int ObSortOpImpl::norm_key_sort(const int64_t begin)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cnt = rows_.count() - begin;
+  ObSortNormKey::Item* items = NULL;
+  if (begin < 0 || cnt <= 0 || sort_collations_->empty()) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(begin), K(rows_.count()));
+  } else if (OB_ISNULL(items = static_cast<ObSortNormKey::Item*>(
+                           mem_context_->get_malloc_allocator().alloc(sizeof(*items) * cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(cnt));
+  } else {
+    const ObSortFieldCollation& collation = sort_collations_->at(0);
+    for (int64_t i = 0; i < cnt; i++) {
+      ObChunkDatumStore::StoredRow* row = rows_.at(begin + i);
+      items[i].row_ = row;
+      items[i].key_ = ObSortNormKey::encode(row->cells()[collation.field_idx_], norm_key_tc_, collation);
+    }
+    ObSortNormKey::radix_sort(items, cnt);
+    ObChunkDatumStore::StoredRow** rows = &rows_.at(begin);
+    for (int64_t i = 0; i < cnt; i++) {
+      rows[i] = items[i].row_;
+    }
+    for (int64_t i = 0; i < cnt && OB_SUCC(ret);) {
+      int64_t end = i + 1;
+      while (end < cnt && items[end].key_ == items[i].key_) {
+        end++;
+      }
+      if (end - i > 1) {
+        std::sort(rows + i, rows + end, CopyableComparer(comp_));
+        if (OB_SUCCESS != comp_.ret_) {
+          ret = comp_.ret_;
+          LOG_WARN("compare failed", K(ret));
+        }
+      }
+      i = end;
+    }
+    mem_context_->get_malloc_allocator().free(items);
+    items = NULL;
+  }
+  return ret;
+}
+
 int ObSortOpImpl::sort()
 {
   int ret = OB_SUCCESS;
@@ -1062,6 +1257,8 @@ int ObPrefixSortImpl::init(const int64_t tenant_id, const int64_t prefix_pos,
     sort_row_count_ = &sort_row_cnt;
     if (OB_FAIL(ObSortOpImpl::init(tenant_id, &base_sort_collations_, &base_sort_cmp_funs_, eval_ctx))) {
       LOG_WARN("sort impl init failed", K(ret));
+    } else if (OB_FAIL(init_norm_key(all_exprs))) {
+      LOG_WARN("init normalized key failed", K(ret));
     } else if (OB_FAIL(next_prefix_row_store_.init(mem_context_->get_malloc_allocator(), all_exprs.count()))) {
       LOG_WARN("failed to init next prefix row store", K(ret));
     } else if (OB_FAIL(fetch_rows(all_exprs))) {
@@ -35,6 +35,35 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObSortOpChunk);
 };
 
+/*
+ * Normalized sort key: fixed width image of the leading sort column, ordered the same way
+ * as the column (with direction and null position applied) when compared as unsigned integer,
+ * which is memcmp of the big endian bytes.
+ * Different values may have the same key (e.g.: NULL and INT64_MIN), rows with equal key
+ * must be compared by the full sort columns.
+ */
+class ObSortNormKey {
+public:
+  struct Item {
+    uint64_t key_;
+    ObChunkDatumStore::StoredRow* row_;
+  };
+  // buckets smaller than this are sorted by std::sort
+  static const int64_t RADIX_SORT_THRESHOLD = 64;
+
+  static bool is_supported(const common::ObObjType type);
+  static uint64_t encode(
+      const common::ObDatum& datum, const common::ObObjTypeClass tc, const ObSortFieldCollation& collation);
+  // MSD radix sort (american flag sort) by key, one byte per level.
+  static void radix_sort(Item* items, const int64_t cnt)
+  {
+    radix_sort(items, cnt, 0);
+  }
+
+private:
+  static void radix_sort(Item* items, const int64_t cnt, const int64_t byte_idx);
+};
+
 /*
  * Sort rows, do in memory sort if memory can hold all rows, otherwise do disk sort.
  * Prefix sorting is not supported it can be implemented by by simply wrapping ObSortOpImpl.
@@ -78,6 +107,10 @@ public:
   int init(const uint64_t tenant_id, const ObIArray<ObSortFieldCollation>* sort_collations,
       const ObIArray<ObSortCmpFunc>* sort_cmp_funs, ObEvalCtx* eval_ctx, const bool in_local_order = false,
       const bool need_rewind = false);
+  // Sort rows by normalized key of the first sort column before full comparison,
+  // enabled only if the type of the column is supported by ObSortNormKey.
+  // %exprs are the exprs rows added with, which sort collations' field_idx_ refer to.
+  int init_norm_key(const common::ObIArray<ObExpr*>& exprs);
 
   // keep initialized, can sort same rows (same cell type, cell count, projector) after reuse.
   void reuse();
@@ -247,6 +280,7 @@ protected:
     return rows_.count() > datum_store_.get_row_cnt();
   }
   int sort_inmem_data();
+  int norm_key_sort(const int64_t begin);
   int do_dump();
   template <typename Input>
   int build_chunk(const int64_t level, Input& input);
@@ -277,6 +311,8 @@ protected:
   typedef common::ObBinaryHeap<ObChunkDatumStore::StoredRow**, Compare, 16> IMMSHeap;
   typedef common::ObBinaryHeap<ObSortOpChunk*, Compare, MAX_MERGE_WAYS> EMSHeap;
   static const int64_t MAX_ROW_CNT = 268435456;  // (2G / 8)
+  // std::sort is good enough for few rows
+  static const int64_t NORM_KEY_SORT_MIN_ROW_CNT = 256;
   bool inited_;
   bool local_merge_sort_;
   bool need_rewind_;
@@ -302,6 +338,8 @@ protected:
   // heap for external merge sort
   EMSHeap* ems_heap_;
   NextStoredRowFunc next_stored_row_func_;
+  // type class of the first sort column, ObMaxTC if normalized key sort is disabled
+  common::ObObjTypeClass norm_key_tc_;
   int64_t input_rows_;
   int64_t input_width_;
   ObSqlWorkAreaProfile profile_;
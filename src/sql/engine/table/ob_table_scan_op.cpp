@@ -1026,6 +1026,7 @@ int ObTableScanOp::fill_storage_feedback_info()
 int ObTableScanOp::rescan()
 {
   int ret = OB_SUCCESS;
+  reset_batch_rows();
   if (ctx_.is_gi_restart()) {
     // this scan is started by a gi operator, so, scan a new range.
     if (OB_FAIL(get_gi_task_and_restart())) {
@@ -1214,6 +1215,7 @@ int ObTableScanOp::batch_rescan()
 int ObTableScanOp::switch_iterator()
 {
   int ret = OB_SUCCESS;
+  reset_batch_rows();
   if (OB_ISNULL(result_)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("result is null", K(ret), K(result_));
@@ -1337,6 +1339,34 @@ int ObTableScanOp::get_next_row_with_mode()
   return ret;
 }
 
+int ObTableScanOp::inner_get_next_batch(const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  int64_t size = 0;
+  // storage rows are projected to batch rows one by one, filters and outputs are evaluated in batch.
+  while (OB_SUCC(ret) && size < max_row_cnt) {
+    eval_ctx_.set_batch_idx(size);
+    if (OB_FAIL(inner_get_next_row())) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("inner get next row failed", K(ret));
+      } else {
+        ret = OB_SUCCESS;
+        brs_.end_ = true;
+        break;
+      }
+    } else if (OB_FAIL(deep_copy_batch_row(MY_SPEC.storage_output_))) {
+      // string datums point to storage row which is invalid after next row fetched.
+      LOG_WARN("deep copy storage row failed", K(ret));
+    } else {
+      size++;
+    }
+  }
+  if (OB_SUCC(ret) && OB_FAIL(filter_and_project_batch(size))) {
+    LOG_WARN("filter and project batch failed", K(ret));
+  }
+  return ret;
+}
+
 int ObTableScanOp::inner_get_next_row()
 {
   int ret = OB_SUCCESS;
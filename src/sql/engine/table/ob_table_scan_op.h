@@ -251,6 +251,7 @@ public:
   int switch_iterator() override;
   int bnl_switch_iterator();
   int inner_get_next_row() override;
+  int inner_get_next_batch(const int64_t max_row_cnt) override;
   int inner_close() override;
   void destroy() override;
 
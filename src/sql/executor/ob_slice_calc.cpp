@@ -16,6 +16,7 @@
 #include "sql/executor/ob_slice_calc.h"
 #include "sql/executor/ob_range_hash_key_getter.h"
 #include "sql/engine/ob_exec_context.h"
+#include "sql/engine/ob_bit_vector.h"
 #include "sql/engine/expr/ob_expr_calc_partition_id.h"
 #include "share/schema/ob_table_schema.h"
 #include "common/row/ob_row.h"
@@ -740,6 +741,40 @@ int ObHashSliceIdCalc::get_slice_idx(const ObIArray<ObExpr*>&, ObEvalCtx& eval_c
   return ret;
 }
 
+int ObHashSliceIdCalc::get_slice_idx_batch(const ObIArray<ObExpr*>&, ObEvalCtx& eval_ctx, const ObBitVector& skip,
+    const int64_t batch_size, int64_t* slice_indexes)
+{
+  int ret = OB_SUCCESS;
+  // hash values are accumulated in %slice_indexes
+  uint64_t* hash_vals = reinterpret_cast<uint64_t*>(slice_indexes);
+  if (OB_ISNULL(hash_dist_exprs_) || OB_ISNULL(hash_funcs_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("hash func and expr not init", K(ret));
+  } else if (OB_ISNULL(slice_indexes)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("slice indexes is NULL", K(ret));
+  } else {
+    MEMSET(hash_vals, 0, sizeof(uint64_t) * batch_size);
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < hash_dist_exprs_->count(); ++i) {
+    const ObExpr* dist_expr = hash_dist_exprs_->at(i);
+    const ObDatumHashFuncType hash_func = hash_funcs_->at(i).hash_func_;
+    if (OB_FAIL(dist_expr->eval_batch(eval_ctx, skip, batch_size))) {
+      LOG_WARN("failed to eval batch", K(ret));
+    } else {
+      for (int64_t j = 0; j < batch_size; j++) {
+        if (!skip.at(j)) {
+          hash_vals[j] = hash_func(dist_expr->locate_expr_datum(eval_ctx, j), hash_vals[j]);
+        }
+      }
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; i++) {
+    slice_indexes[i] = hash_vals[i] % task_cnt_;
+  }
+  return ret;
+}
+
 int ObSlaveMapPkeyHashIdxCalc::init()
 {
   int ret = OB_SUCCESS;
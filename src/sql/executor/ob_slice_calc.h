@@ -50,6 +50,21 @@ public:
   virtual int get_slice_indexes(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, SliceIdxArray& slice_idx_array);
   // get partition_if of the row of previous get_slice_indexes() call.
   virtual int get_previous_row_partition_id(ObObj& partition_id);
+  virtual bool support_slice_idx_batch() const
+  {
+    return false;
+  }
+  // get slice index of every row not skipped in batch, supported only if support_slice_idx_batch() is true.
+  virtual int get_slice_idx_batch(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, const ObBitVector& skip,
+      const int64_t batch_size, int64_t* slice_indexes)
+  {
+    UNUSED(exprs);
+    UNUSED(eval_ctx);
+    UNUSED(skip);
+    UNUSED(batch_size);
+    UNUSED(slice_indexes);
+    return common::OB_NOT_IMPLEMENT;
+  }
 
 protected:
   virtual int get_slice_idx(const common::ObNewRow& row, int64_t& slice_idx) = 0;
@@ -397,6 +412,13 @@ public:
   int get_multi_hash_value(const ObNewRow& row, uint64_t& hash_val);
   virtual int get_slice_idx(const ObNewRow& row, int64_t& slice_idx) override;
   int get_slice_idx(const ObIArray<ObExpr*>& row, ObEvalCtx& eval_ctx, int64_t& slice_idx) override;
+  virtual bool support_slice_idx_batch() const override
+  {
+    return true;
+  }
+  // hash values of the batch are calculated column by column
+  virtual int get_slice_idx_batch(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, const ObBitVector& skip,
+      const int64_t batch_size, int64_t* slice_indexes) override;
 
   common::ObExprCtx* expr_ctx_;
   const common::ObIArray<ObHashColumn>* hash_dist_columns_;
@@ -444,6 +466,11 @@ public:
   virtual int get_slice_idx(const common::ObNewRow& row, int64_t& slice_idx) override;
   // for static engine
   virtual int get_slice_idx(const ObIArray<ObExpr*>& exprs, ObEvalCtx& eval_ctx, int64_t& slice_idx) override;
+  // slice index depends on partition of the row
+  virtual bool support_slice_idx_batch() const override
+  {
+    return false;
+  }
 
 private:
   virtual int get_part_id_by_one_level_sub_ch_map(int64_t& part_id) override;
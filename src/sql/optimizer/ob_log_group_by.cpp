@@ -51,6 +51,7 @@ int ObLogGroupBy::copy_without_child(ObLogicalOperator*& out)
     group_by->rollup_exprs_ = rollup_exprs_;
     group_by->distinct_card_ = distinct_card_;
     group_by->from_pivot_ = from_pivot_;
+    group_by->is_push_down_ = is_push_down_;
     out = static_cast<ObLogicalOperator*>(group_by);
   }
   return ret;
@@ -301,7 +302,12 @@ int ObLogGroupBy::allocate_groupby_below(const ObIArray<ObRawExpr*>& distinct_ex
     } else if (distinct_exprs.empty() &&
                OB_FAIL(allocate_topk_if_needed(exchange_point, child_group_by, push_down_agg_expr))) {
       LOG_WARN("failed to alloc_topk_if needed", K(ret));
-    } else { /*do nothing*/
+    } else if (distinct_exprs.empty()) {
+      // Child group by may emit partial groups which are merged by this one, except for topk
+      // which sorts and cuts the child groups.
+      const bool is_match_topk =
+          get_stmt()->is_select_stmt() && static_cast<ObSelectStmt*>(get_stmt())->is_match_topk();
+      child_group_by->set_is_push_down(!is_match_topk);
     }
   }
   return ret;
@@ -29,7 +29,8 @@ public:
         approx_count_distinct_estimate_ndv_exprs_(),
         algo_(AGGREGATE_UNINITIALIZED),
         distinct_card_(0.0),
-        from_pivot_(false)
+        from_pivot_(false),
+        is_push_down_(false)
   {}
   virtual ~ObLogGroupBy()
   {}
@@ -128,10 +129,18 @@ public:
   {
     from_pivot_ = value;
   }
+  bool is_push_down() const
+  {
+    return is_push_down_;
+  }
+  void set_is_push_down(const bool value)
+  {
+    is_push_down_ = value;
+  }
   int get_group_rollup_exprs(common::ObIArray<ObRawExpr*>& group_rollup_exprs) const;
   int allocate_startup_expr_post() override;
   VIRTUAL_TO_STRING_KV(K_(group_exprs), K_(rollup_exprs), K_(aggr_exprs), K_(avg_div_exprs),
-      K_(approx_count_distinct_estimate_ndv_exprs), K_(algo), K_(distinct_card));
+      K_(approx_count_distinct_estimate_ndv_exprs), K_(algo), K_(distinct_card), K_(is_push_down));
 
 private:
   /**
@@ -187,6 +196,8 @@ private:
   // if no having clause, distinct_card_ = card_
   double distinct_card_;
   bool from_pivot_;
+  // pushed down below exchange, groups are aggregated again by the parent group by
+  bool is_push_down_;
 };
 }  // end of namespace sql
 }  // end of namespace oceanbase
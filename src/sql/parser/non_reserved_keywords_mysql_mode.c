@@ -98,6 +98,7 @@ static const NonReservedKeyword Mysql_none_reserved_keywords[] = {
     {"compressed", COMPRESSED},
     {"compression", COMPRESSION},
     {"concurrent", CONCURRENT},
+    {"condensed", CONDENSED},
     {"connection", CONNECTION},
     {"consistent", CONSISTENT},
     {"constraint_catalog", CONSTRAINT_CATALOG},
@@ -661,6 +662,7 @@ static const NonReservedKeyword Mysql_none_reserved_keywords[] = {
     {"year", YEAR},
     {"zone", ZONE},
     {"zone_list", ZONE_LIST},
+    {"zone_map", ZONE_MAP},
     {"time_zone_info", TIME_ZONE_INFO},
     {"zone_type", ZONE_TYPE},
     {"audit", AUDIT},
@@ -1764,6 +1764,8 @@ typedef enum ObItemType
 
   T_PREVIEW,
   T_TABLE_TTL,
+  T_DIRECT_LOAD,
+  T_ZONE_MAP,
   T_MAX  // Attention: add a new type before T_MAX
 } ObItemType;
 
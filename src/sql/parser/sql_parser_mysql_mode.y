@@ -140,7 +140,7 @@ QB_NAME USE_HASH_AGGREGATION NO_USE_HASH_AGGREGATION NEG_SIGN USE_LATE_MATERIALI
 USE_BNL MAX_CONCURRENT PX_JOIN_FILTER NO_USE_PX PQ_DISTRIBUTE RANDOM_LOCAL BROADCAST TRACING
 MERGE_HINT NO_MERGE_HINT NO_EXPAND USE_CONCAT UNNEST NO_UNNEST PLACE_GROUP_BY NO_PLACE_GROUP_BY NO_PRED_DEDUCE
 TRANS_PARAM FORCE_REFRESH_LOCATION_CACHE LOAD_BATCH_SIZE NO_PX_JOIN_FILTER DISABLE_PARALLEL_DML PQ_MAP
-ENABLE_PARALLEL_DML NO_PARALLEL
+ENABLE_PARALLEL_DML NO_PARALLEL DIRECT_LOAD
 
 %token /*can not be relation name*/
 _BINARY _UTF8 _UTF8MB4 _GBK _UTF16 _GB18030 CNNOP
@@ -206,7 +206,7 @@ END_P SET_VAR DELIMITER
         CACHE CANCEL CASCADED CAST CATALOG_NAME CHAIN CHANGED CHARSET CHECKSUM CHECKPOINT CHUNK CIPHER
         CLASS_ORIGIN CLEAN CLEAR CLIENT CLOG CLOSE CLUSTER CLUSTER_ID CLUSTER_NAME COALESCE COLUMN_STAT
         CODE COLLATION COLUMN_FORMAT COLUMN_NAME COLUMNS COMMENT COMMIT COMMITTED COMPACT COMPLETION
-        COMPRESSED COMPRESSION CONCURRENT CONNECTION CONSISTENT CONSISTENT_MODE CONSTRAINT_CATALOG
+        COMPRESSED COMPRESSION CONCURRENT CONDENSED CONNECTION CONSISTENT CONSISTENT_MODE CONSTRAINT_CATALOG
         CONSTRAINT_NAME CONSTRAINT_SCHEMA CONTAINS CONTEXT CONTRIBUTORS COPY COUNT CPU CREATE_TIMESTAMP
         CTX_ID CUBE CURDATE CURRENT CURTIME CURSOR_NAME CUME_DIST CYCLE
 
@@ -299,7 +299,7 @@ END_P SET_VAR DELIMITER
 
         YEAR
 
-        ZONE ZONE_LIST ZONE_TYPE
+        ZONE ZONE_LIST ZONE_MAP ZONE_TYPE
 
 %type <node> sql_stmt stmt_list stmt opt_end_p
 %type <node> select_stmt update_stmt delete_stmt
@@ -5267,6 +5267,11 @@ TABLE_MODE opt_equal_mark STRING_VALUE
   (void)($2) ; /* make bison mute */
   malloc_non_terminal_node($$, result->malloc_pool_, T_USE_BLOOM_FILTER, 1, $3);
 }
+| ZONE_MAP opt_equal_mark BOOL_VALUE
+{
+  (void)($2) ; /* make bison mute */
+  malloc_non_terminal_node($$, result->malloc_pool_, T_ZONE_MAP, 1, $3);
+}
 | opt_default_mark charset_key opt_equal_mark charset_name
 {
   (void)($1) ; /* make bison mute */
@@ -6126,6 +6131,11 @@ REDUNDANT
   malloc_terminal_node($$, result->malloc_pool_, T_INT);
   $$->value_ = 4;
 }
+| CONDENSED
+{
+  malloc_terminal_node($$, result->malloc_pool_, T_INT);
+  $$->value_ = 5;
+}
 | DEFAULT
 {
   malloc_terminal_node($$, result->malloc_pool_, T_INT);
@@ -7778,6 +7788,10 @@ malloc_non_terminal_node($$, result->malloc_pool_, T_QB_NAME, 1, $3);
 {
   malloc_non_terminal_node($$, result->malloc_pool_, T_LOAD_BATCH_SIZE, 1, $3);
 }
+| DIRECT_LOAD
+{
+  malloc_terminal_node($$, result->malloc_pool_, T_DIRECT_LOAD);
+}
 | PQ_MAP '(' qb_name_option relation_factor_in_hint ')'
 {
   malloc_non_terminal_node($$, result->malloc_pool_, T_PQ_MAP, 2, $3, $4);
@@ -13793,6 +13807,7 @@ ACCOUNT
 |       COMPRESSED
 |       COMPRESSION
 |       CONCURRENT
+|       CONDENSED
 |       CONNECTION %prec KILL_EXPR
 |       CONSISTENT
 |       CONSISTENT_MODE
@@ -14343,6 +14358,7 @@ ACCOUNT
 |       YEAR
 |       ZONE
 |       ZONE_LIST
+|       ZONE_MAP
 |       ZONE_TYPE
 |       LOCATION
 |       PLAN
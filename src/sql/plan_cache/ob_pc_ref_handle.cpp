@@ -55,6 +55,7 @@ const char* ObCacheRefHandleMgr::handle_name(const CacheRefHandleID handle_id)
       "pcv_get_pl_key_handle",
       "pcv_expire_by_used_handle",
       "pcv_expire_by_mem_handle",
+      "ps_pcv_set_handle",
   };
   static_assert(sizeof(handle_names) / sizeof(const char*) == MAX_HANDLE, "invalid handle name array");
   if (handle_id < MAX_HANDLE) {
@@ -56,6 +56,7 @@ public:
   ObPCVSet(ObPlanCache* plan_cache)
       : is_inited_(false),
         plan_cache_(plan_cache),
+        id_(common::OB_INVALID_ID),
         pc_alloc_(NULL),
         rwlock_(),
         pc_key_(),
@@ -104,6 +105,15 @@ public:
   {
     return plan_cache_;
   }
+  // unique in plan cache and never reused, see ObPlanCache::get_value_by_id
+  uint64_t get_id() const
+  {
+    return id_;
+  }
+  void set_id(const uint64_t id)
+  {
+    id_ = id;
+  }
   void set_plan_cache_key(ObPlanCacheKey& key)
   {
     pc_key_ = key;
@@ -132,7 +142,7 @@ public:
   }
   int update_stmt_stat();
 
-  TO_STRING_KV(K_(is_inited), K_(ref_count), K_(min_merged_version));
+  TO_STRING_KV(K_(is_inited), K_(id), K_(ref_count), K_(min_merged_version));
 
 private:
   static const int64_t MAX_PCV_SET_PLAN_NUM = 200;
@@ -163,6 +173,7 @@ private:
 private:
   bool is_inited_;
   ObPlanCache* plan_cache_;
+  uint64_t id_;
   common::ObIAllocator* pc_alloc_;
   common::ObLatch rwlock_;
   ObPlanCacheKey pc_key_;  // used for manager key memory
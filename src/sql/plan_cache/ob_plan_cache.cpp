@@ -31,6 +31,7 @@
 #include "sql/session/ob_sql_session_info.h"
 #include "sql/engine/ob_physical_plan.h"
 #include "sql/plan_cache/ob_plan_cache_callback.h"
+#include "sql/plan_cache/ob_ps_pcv_set_cache.h"
 #include "sql/plan_cache/ob_cache_object_factory.h"
 #include "observer/ob_req_time_service.h"
 
@@ -327,6 +328,7 @@ ObPlanCache::ObPlanCache()
       mem_low_pct_(OB_PLAN_CACHE_EVICT_LOW_PERCENTAGE),
       mem_used_(0),
       bucket_num_(0),
+      pcv_set_id_(0),
       inner_allocator_(),
       location_cache_(NULL),
       plan_id_(0),
@@ -362,6 +364,11 @@ int ObPlanCache::init(
             ObModIds::OB_HASH_NODE_PLAN_CACHE,
             tenant_id))) {
       SQL_PC_LOG(WARN, "failed to init PlanCache", K(ret));
+    } else if (OB_FAIL(pcv_set_id_map_.create(hash::cal_next_prime(hash_bucket),
+                   ObModIds::OB_HASH_BUCKET_PLAN_CACHE,
+                   ObModIds::OB_HASH_NODE_PLAN_CACHE,
+                   tenant_id))) {
+      SQL_PC_LOG(WARN, "failed to init pcv set id map", K(ret));
     } else if (OB_FAIL(plan_stat_map_.create(hash::cal_next_prime(hash_bucket),
                    ObModIds::OB_HASH_BUCKET_PLAN_STAT,
                    ObModIds::OB_HASH_NODE_PLAN_STAT,
@@ -403,37 +410,99 @@ int ObPlanCache::get_cache_obj(ObPlanCacheCtx &pc_ctx, ObCacheObject *&cache_obj
     SQL_PC_LOG(DEBUG, "physical plan does not exist!", K(pc_ctx.fp_result_.pc_key_));
   } else {
     LOG_DEBUG("inner_get_plan", K(pc_ctx.fp_result_.pc_key_), K(pcv_set));
-    pcv_set->update_stmt_stat();
-    if (OB_FAIL(pcv_set->get_plan(pc_ctx, cache_obj))) {
-      if (OB_OLD_SCHEMA_VERSION != ret && OB_SQL_PC_NOT_EXIST != ret) {
-        LOG_WARN("pcv_set fail to get plan", K(ret));
-      }
+    ret = get_cache_obj_from_pcv_set(pc_ctx, *pcv_set, cache_obj);
+    // release lock whatever
+    (void)pcv_set->unlock();
+    (void)pcv_set->dec_ref_count(PCV_RD_HANDLE);
+
+    NG_TRACE(pc_choose_plan);
+  }
+
+  return ret;
+}
+
+/* get cache obj of prepared statement, try the pcv set cached in session first.
+ * The session cache only saves the lookup of sql_pcvs_map_, plan is still chosen by
+ * pcv set because table locations are calculated and plan constraints are checked there.
+ */
+int ObPlanCache::get_ps_cache_obj(const ObPsStmtId stmt_id, ObPlanCacheCtx &pc_ctx, ObCacheObject *&cache_obj)
+{
+  int ret = OB_SUCCESS;
+  ObPsPCVSetCache &session_cache = pc_ctx.sql_ctx_.session_info_->get_ps_pcv_set_cache();
+  ObPCVSet *pcv_set = NULL;
+  const uint64_t pcv_set_id = session_cache.get(stmt_id, this);
+  if (OB_INVALID_ID != pcv_set_id) {
+    ObPlanCacheRlockAndRef r_ref_lock(PS_PCV_SET_HANDLE);
+    if (OB_FAIL(get_value_by_id(pcv_set_id, pcv_set, r_ref_lock /* read locked */))) {
+      SQL_PC_LOG(DEBUG, "failed to get session cached pcv set", K(ret), K(pcv_set_id));
+    } else if (NULL == pcv_set) {
+      // removed from plan cache
+    } else if (!(pcv_set->get_plan_cache_key() == pc_ctx.fp_result_.pc_key_)) {
+      // plan cache key changed, e.g. database or sys vars of session changed
+      (void)pcv_set->unlock();
+      (void)pcv_set->dec_ref_count(PS_PCV_SET_HANDLE);
+      pcv_set = NULL;
     } else {
-      LOG_DEBUG("succ to choose a physical plan", K(pc_ctx.raw_sql_));
+      LOG_DEBUG("inner_get_plan from session cache", K(pc_ctx.fp_result_.pc_key_), K(pcv_set_id));
+      ret = get_cache_obj_from_pcv_set(pc_ctx, *pcv_set, cache_obj);
+      (void)pcv_set->unlock();
+      (void)pcv_set->dec_ref_count(PS_PCV_SET_HANDLE);
+      NG_TRACE(pc_choose_plan);
     }
-
-    ObPhysicalPlan *plan = NULL;
-    if (cache_obj != NULL && cache_obj->is_sql_crsr()) {
-      plan = static_cast<ObPhysicalPlan *>(cache_obj);
+    if (OB_FAIL(ret) || NULL == pcv_set) {
+      session_cache.remove(stmt_id);
     }
-    // if schema expired, update pcv set;
-    if (OB_OLD_SCHEMA_VERSION == ret || (plan != NULL && plan->is_expired())) {
-      if (plan != NULL && plan->is_expired()) {
-        LOG_INFO("the statistics of table is stale and evict plan.", K(plan->stat_));
-      }
-      if (OB_FAIL(remove_pcv_set(pc_ctx.fp_result_.pc_key_))) {
-        LOG_WARN("fail to remove pcv set when schema/plan expired", K(ret));
-      } else {
-        ret = OB_SQL_PC_NOT_EXIST;
+  }
+  if (OB_SUCC(ret) && NULL == pcv_set) {
+    ObPlanCacheRlockAndRef r_ref_lock(PCV_RD_HANDLE);
+    if (OB_FAIL(get_value(pc_ctx.fp_result_.pc_key_, pcv_set, r_ref_lock /* read locked */))) {
+      SQL_PC_LOG(DEBUG, "failed to access plan cache", K(pc_ctx.fp_result_.pc_key_), K(ret));
+    } else if (OB_UNLIKELY(NULL == pcv_set)) {
+      ret = OB_SQL_PC_NOT_EXIST;
+      SQL_PC_LOG(DEBUG, "physical plan does not exist!", K(pc_ctx.fp_result_.pc_key_));
+    } else {
+      LOG_DEBUG("inner_get_plan", K(pc_ctx.fp_result_.pc_key_), K(pcv_set));
+      if (OB_SUCC(get_cache_obj_from_pcv_set(pc_ctx, *pcv_set, cache_obj))) {
+        session_cache.put(stmt_id, this, pcv_set->get_id());
       }
+      // release lock whatever
+      (void)pcv_set->unlock();
+      (void)pcv_set->dec_ref_count(PCV_RD_HANDLE);
+
+      NG_TRACE(pc_choose_plan);
     }
-    // release lock whatever
-    (void)pcv_set->unlock();
-    (void)pcv_set->dec_ref_count(PCV_RD_HANDLE);
+  }
 
-    NG_TRACE(pc_choose_plan);
+  return ret;
+}
+
+int ObPlanCache::get_cache_obj_from_pcv_set(ObPlanCacheCtx &pc_ctx, ObPCVSet &pcv_set, ObCacheObject *&cache_obj)
+{
+  int ret = OB_SUCCESS;
+  pcv_set.update_stmt_stat();
+  if (OB_FAIL(pcv_set.get_plan(pc_ctx, cache_obj))) {
+    if (OB_OLD_SCHEMA_VERSION != ret && OB_SQL_PC_NOT_EXIST != ret) {
+      LOG_WARN("pcv_set fail to get plan", K(ret));
+    }
+  } else {
+    LOG_DEBUG("succ to choose a physical plan", K(pc_ctx.raw_sql_));
   }
 
+  ObPhysicalPlan *plan = NULL;
+  if (cache_obj != NULL && cache_obj->is_sql_crsr()) {
+    plan = static_cast<ObPhysicalPlan *>(cache_obj);
+  }
+  // if schema expired, update pcv set;
+  if (OB_OLD_SCHEMA_VERSION == ret || (plan != NULL && plan->is_expired())) {
+    if (plan != NULL && plan->is_expired()) {
+      LOG_INFO("the statistics of table is stale and evict plan.", K(plan->stat_));
+    }
+    if (OB_FAIL(remove_pcv_set(pc_ctx.fp_result_.pc_key_))) {
+      LOG_WARN("fail to remove pcv set when schema/plan expired", K(ret));
+    } else {
+      ret = OB_SQL_PC_NOT_EXIST;
+    }
+  }
   return ret;
 }
 
@@ -807,8 +876,11 @@ int ObPlanCache::add_cache_obj(ObCacheObject *cache_obj, ObPlanCacheCtx &pc_ctx)
          *
          */
         pcv_set->inc_ref_count(PCV_SET_HANDLE);  // inc ref count in block
+        // add id before key, so that the id is always removed by whoever erases the key
+        add_pcv_set_id(*pcv_set);
         int hash_err = sql_pcvs_map_.set_refactored(pcv_set->get_plan_cache_key(), pcv_set);
         if (OB_HASH_EXIST == hash_err) {  // may be this pcv_set has been set by other thread.
+          remove_pcv_set_id(*pcv_set);
           pcv_set->unlock();
           pcv_set->dec_ref_count(PCV_SET_HANDLE);  // pcv set dec ref in block
           pcv_set->dec_ref_count(PCV_SET_HANDLE);  // pcv set dec ref in alloc
@@ -845,6 +917,7 @@ int ObPlanCache::add_cache_obj(ObCacheObject *cache_obj, ObPlanCacheCtx &pc_ctx)
               ret = OB_ERR_UNEXPECTED;
               LOG_WARN("unexpected error", K(ret), K(tmp_ret), K(del_pcvset), K(pcv_set));
             } else {
+              remove_pcv_set_id(*pcv_set);
               pcv_set->unlock();
               pcv_set->dec_ref_count(PCV_SET_HANDLE);  // pcv set dec ref in block
               pcv_set->dec_ref_count(PCV_SET_HANDLE);  // pcv set dec ref in alloc
@@ -856,6 +929,7 @@ int ObPlanCache::add_cache_obj(ObCacheObject *cache_obj, ObPlanCacheCtx &pc_ctx)
           }
         } else {
           SQL_PC_LOG(TRACE, "failed to add pcv_set to sql_pcvs_map", K(ret), KPC(cache_obj));
+          remove_pcv_set_id(*pcv_set);
           pcv_set->unlock();
           pcv_set->dec_ref_count(PCV_SET_HANDLE);  // pcv set dec ref in block
           pcv_set->dec_ref_count(PCV_SET_HANDLE);  // pcv set dec ref in alloc
@@ -923,6 +997,41 @@ int ObPlanCache::get_value(const ObPlanCacheKey key, ObPCVSet *&pcv_set, ObPlanC
   return ret;
 }
 
+int ObPlanCache::get_value_by_id(const uint64_t pcv_set_id, ObPCVSet *&pcv_set, ObPlanCacheAtomicOp &op)
+{
+  int ret = OB_SUCCESS;
+  pcv_set = NULL;
+  int hash_err = pcv_set_id_map_.read_atomic(pcv_set_id, op);
+  if (OB_SUCCESS == hash_err) {
+    if (OB_FAIL(op.get_value(pcv_set))) {
+      SQL_PC_LOG(DEBUG, "failed to lock pcv set", K(ret), K(pcv_set_id));
+    }
+  } else if (OB_HASH_NOT_EXIST == hash_err) {
+    SQL_PC_LOG(DEBUG, "pcv set is removed", K(pcv_set_id));
+  } else {
+    ret = hash_err;
+    SQL_PC_LOG(WARN, "failed to get pcv set by id", K(ret), K(pcv_set_id));
+  }
+  return ret;
+}
+
+void ObPlanCache::add_pcv_set_id(ObPCVSet &pcv_set)
+{
+  int tmp_ret = pcv_set_id_map_.set_refactored(pcv_set.get_id(), &pcv_set);
+  if (OB_SUCCESS != tmp_ret) {
+    // sessions can not cache this pcv_set, it is still found by key
+    SQL_PC_LOG(WARN, "failed to add pcv set id", K(tmp_ret), K(pcv_set.get_id()));
+  }
+}
+
+void ObPlanCache::remove_pcv_set_id(ObPCVSet &pcv_set)
+{
+  int tmp_ret = pcv_set_id_map_.erase_refactored(pcv_set.get_id());
+  if (OB_SUCCESS != tmp_ret && OB_HASH_NOT_EXIST != tmp_ret) {
+    SQL_PC_LOG(ERROR, "failed to remove pcv set id", K(tmp_ret), K(pcv_set.get_id()));
+  }
+}
+
 int ObPlanCache::cache_evict_all_plan()
 {
   int ret = OB_SUCCESS;
@@ -1149,6 +1258,8 @@ int ObPlanCache::remove_pcv_set(const ObPlanCacheKey &key)
   hash_err = sql_pcvs_map_.erase_refactored(key, &pcv_set);
   if (OB_SUCCESS == hash_err) {
     if (NULL != pcv_set) {
+      // entries of sessions pointing to this pcv_set become stale
+      remove_pcv_set_id(*pcv_set);
       // remove plan cache reference, even remove_plan_stat() failed
       pcv_set->dec_ref_count(PCV_SET_HANDLE);
     } else {
@@ -1416,6 +1527,7 @@ int ObPlanCache::create_pcv_set_and_add_plan(ObCacheObject *cache_obj, ObPlanCac
     LOG_WARN("failed to allocate memory for pcv set", K(ret));
   } else {
     pcv_set = new (ptr) ObPCVSet(this);
+    pcv_set->set_id(ATOMIC_AAF(&pcv_set_id_, 1));
     pcv_set->inc_ref_count(PCV_SET_HANDLE);
     pcv_set->lock(true);
     if (OB_FAIL(pcv_set->init(pc_ctx, cache_obj))) {
@@ -1605,7 +1717,6 @@ int ObPlanCache::get_ps_plan(
 {
   int ret = OB_SUCCESS;
   ObGlobalReqTimeService::check_req_timeinfo();
-  UNUSED(stmt_id);
   ObSqlTraits sql_traits;
   ObCacheObject *cache_obj = NULL;
   int64_t original_param_cnt = 0;
@@ -1626,7 +1737,8 @@ int ObPlanCache::get_ps_plan(
     // do nothing
   } else if (OB_FAIL(construct_plan_cache_key(pc_ctx, NS_CRSR))) {
     LOG_WARN("fail to construnct plan cache key", K(ret));
-  } else if (OB_FAIL(get_cache_obj(pc_ctx, cache_obj))) {
+  } else if (OB_FAIL(pc_ctx.sql_ctx_.is_remote_sql_ ? get_cache_obj(pc_ctx, cache_obj)
+                                                    : get_ps_cache_obj(stmt_id, pc_ctx, cache_obj))) {
     SQL_PC_LOG(DEBUG, "fail to get plan", K(ret));
   } else if (OB_ISNULL(cache_obj) ||
              OB_UNLIKELY(!cache_obj->is_sql_crsr() && !cache_obj->is_prcr() && !cache_obj->is_sfc() &&
@@ -83,6 +83,7 @@ public:
   static const int64_t MAX_TENANT_MEM = ((int64_t)(1) << 40);  // 1T
   typedef common::hash::ObHashMap<ObCacheObjID, ObCacheObject*> PlanStatMap;
   typedef common::hash::ObHashMap<ObPlanCacheKey, ObPCVSet*> SqlPCVSetMap;
+  typedef common::hash::ObHashMap<uint64_t, ObPCVSet*> PCVSetIdMap;
 
   ObPlanCache();
   virtual ~ObPlanCache();
@@ -319,7 +320,14 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObPlanCache);
   int add_cache_obj(ObCacheObject* plan, ObPlanCacheCtx& pc_ctx);
   int get_cache_obj(ObPlanCacheCtx& pc_ctx, ObCacheObject*& cache_obj);
+  int get_ps_cache_obj(const ObPsStmtId stmt_id, ObPlanCacheCtx& pc_ctx, ObCacheObject*& cache_obj);
+  // choose plan from a read locked pcv set
+  int get_cache_obj_from_pcv_set(ObPlanCacheCtx& pc_ctx, ObPCVSet& pcv_set, ObCacheObject*& cache_obj);
   int get_value(const ObPlanCacheKey key, ObPCVSet*& pcv_set, ObPlanCacheAtomicOp& op);
+  // get pcv set which is still in sql_pcvs_map_ by its id, pcv_set is NULL if it is removed
+  int get_value_by_id(const uint64_t pcv_set_id, ObPCVSet*& pcv_set, ObPlanCacheAtomicOp& op);
+  void add_pcv_set_id(ObPCVSet& pcv_set);
+  void remove_pcv_set_id(ObPCVSet& pcv_set);
   int add_cache_obj_stat(ObPlanCacheCtx& pc_ctx, ObCacheObject* plan);
   bool calc_evict_num(int64_t& plan_cache_evict_num);
   int calc_evict_keys(int64_t evict_num, PCKeyValueArray& to_evict_keys);
@@ -354,6 +362,11 @@ private:
   int64_t bucket_num_;
   // parameterized_sql --> pcv_set
   SqlPCVSetMap sql_pcvs_map_;
+  // used for gen pcv set ids
+  volatile uint64_t pcv_set_id_;
+  // pcv_set id --> pcv_set, holds no reference. An id is removed when its pcv_set is
+  // erased from sql_pcvs_map_ by any key, before the reference of sql_pcvs_map_ is released
+  PCVSetIdMap pcv_set_id_map_;
   common::ObMalloc inner_allocator_;  // used for stmtkey and pre_calc_expr deep copy
   common::ObAddr host_;
   share::ObIPartitionLocationCache* location_cache_;
@@ -30,6 +30,15 @@ void ObPlanCacheAtomicOp::operator()(PlanCacheKV& entry)
   }
 }
 
+void ObPlanCacheAtomicOp::operator()(PCVSetIdKV& entry)
+{
+  if (NULL != entry.second) {
+    entry.second->inc_ref_count(ref_handle_);
+    pcv_set_ = entry.second;
+    SQL_PC_LOG(DEBUG, "succ to get pcv_set by id", K(entry.first), "ref_count", pcv_set_->get_ref_count());
+  }
+}
+
 // get pcvs and lock
 int ObPlanCacheAtomicOp::get_value(ObPCVSet*& pcvs)
 {
@@ -21,6 +21,7 @@ namespace sql {
 class ObPlanCacheAtomicOp {
 protected:
   typedef common::hash::HashMapPair<ObPlanCacheKey, ObPCVSet*> PlanCacheKV;
+  typedef common::hash::HashMapPair<uint64_t, ObPCVSet*> PCVSetIdKV;
 
 public:
   ObPlanCacheAtomicOp(const CacheRefHandleID ref_handle) : pcv_set_(NULL), ref_handle_(ref_handle)
@@ -31,6 +32,7 @@ public:
   virtual int get_value(ObPCVSet*& pcv_set);
   // get pcv_set and increase reference count
   void operator()(PlanCacheKV& entry);
+  void operator()(PCVSetIdKV& entry);
 
 protected:
   // when get value, need lock
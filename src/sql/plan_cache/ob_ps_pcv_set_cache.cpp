@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_PC
+#include "sql/plan_cache/ob_ps_pcv_set_cache.h"
+
+using namespace oceanbase::common;
+
+namespace oceanbase {
+namespace sql {
+
+ObPsPCVSetCache::ObPsPCVSetCache() : count_(0)
+{
+  reset();
+}
+
+uint64_t ObPsPCVSetCache::get(const ObPsStmtId stmt_id, const ObPlanCache* plan_cache) const
+{
+  uint64_t pcv_set_id = OB_INVALID_ID;
+  const Entry& entry = get_entry(stmt_id);
+  if (OB_INVALID_ID != entry.pcv_set_id_ && entry.stmt_id_ == stmt_id && entry.plan_cache_ == plan_cache) {
+    pcv_set_id = entry.pcv_set_id_;
+  }
+  return pcv_set_id;
+}
+
+void ObPsPCVSetCache::put(const ObPsStmtId stmt_id, const ObPlanCache* plan_cache, const uint64_t pcv_set_id)
+{
+  if (OB_INVALID_ID != pcv_set_id && OB_NOT_NULL(plan_cache)) {
+    Entry& entry = get_entry(stmt_id);
+    clear(entry);
+    entry.stmt_id_ = stmt_id;
+    entry.plan_cache_ = plan_cache;
+    entry.pcv_set_id_ = pcv_set_id;
+    ++count_;
+  }
+}
+
+void ObPsPCVSetCache::remove(const ObPsStmtId stmt_id)
+{
+  Entry& entry = get_entry(stmt_id);
+  if (entry.stmt_id_ == stmt_id) {
+    clear(entry);
+  }
+}
+
+void ObPsPCVSetCache::reset()
+{
+  for (int64_t i = 0; i < MAX_ENTRY_COUNT; ++i) {
+    entries_[i].stmt_id_ = OB_INVALID_ID;
+    entries_[i].plan_cache_ = NULL;
+    entries_[i].pcv_set_id_ = OB_INVALID_ID;
+  }
+  count_ = 0;
+}
+
+void ObPsPCVSetCache::clear(Entry& entry)
+{
+  if (OB_INVALID_ID != entry.pcv_set_id_) {
+    --count_;
+  }
+  entry.stmt_id_ = OB_INVALID_ID;
+  entry.plan_cache_ = NULL;
+  entry.pcv_set_id_ = OB_INVALID_ID;
+}
+
+}  // namespace sql
+}  // namespace oceanbase
@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_PLAN_CACHE_OB_PS_PCV_SET_CACHE_H_
+#define OCEANBASE_SQL_PLAN_CACHE_OB_PS_PCV_SET_CACHE_H_
+
+#include "lib/ob_define.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase {
+namespace sql {
+class ObPlanCache;
+
+/*
+ * Session local cache of pcv sets of prepared statements, indexed by inner stmt id.
+ *
+ * An entry only records the id of the pcv set chosen by the last execution of the stmt,
+ * no reference is held, so a pcv set removed from plan cache is freed at once. The id is
+ * resolved by ObPlanCache::get_value_by_id, which fails once that pcv set is removed, and
+ * removal of one pcv set does not invalidate entries of others. Not thread safe, used by
+ * session owner only.
+ */
+class ObPsPCVSetCache {
+public:
+  static const int64_t MAX_ENTRY_COUNT = 64;
+
+  ObPsPCVSetCache();
+  ~ObPsPCVSetCache()
+  {}
+  // return OB_INVALID_ID if %stmt_id of %plan_cache is not cached
+  uint64_t get(const common::ObPsStmtId stmt_id, const ObPlanCache* plan_cache) const;
+  void put(const common::ObPsStmtId stmt_id, const ObPlanCache* plan_cache, const uint64_t pcv_set_id);
+  void remove(const common::ObPsStmtId stmt_id);
+  void reset();
+  int64_t count() const
+  {
+    return count_;
+  }
+  TO_STRING_KV(K_(count));
+
+private:
+  struct Entry {
+    common::ObPsStmtId stmt_id_;
+    const ObPlanCache* plan_cache_;
+    uint64_t pcv_set_id_;
+  };
+  OB_INLINE Entry& get_entry(const common::ObPsStmtId stmt_id)
+  {
+    return entries_[stmt_id % MAX_ENTRY_COUNT];
+  }
+  OB_INLINE const Entry& get_entry(const common::ObPsStmtId stmt_id) const
+  {
+    return entries_[stmt_id % MAX_ENTRY_COUNT];
+  }
+  void clear(Entry& entry);
+
+private:
+  Entry entries_[MAX_ENTRY_COUNT];
+  int64_t count_;
+  DISALLOW_COPY_AND_ASSIGN(ObPsPCVSetCache);
+};
+
+}  // namespace sql
+}  // namespace oceanbase
+
+#endif  // OCEANBASE_SQL_PLAN_CACHE_OB_PS_PCV_SET_CACHE_H_
@@ -446,6 +446,12 @@ int ObLoadDataResolver::resolve_hints(const ParseNode& node)
           }
           break;
         }
+        case T_DIRECT_LOAD: {
+          if (OB_FAIL(stmt_hints.set_value(ObLoadDataHint::DIRECT_LOAD, 1))) {
+            LOG_WARN("fail to set direct load value", K(ret));
+          }
+          break;
+        }
         case T_PARALLEL: {
           if (1 != hint_node->num_child_) {
             ret = OB_ERR_UNEXPECTED;
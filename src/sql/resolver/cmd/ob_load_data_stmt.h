@@ -138,6 +138,7 @@ public:
     PARALLEL_THREADS = 0,  // parallel threads on the host server, for parsing and calc partition
     BATCH_SIZE,
     QUERY_TIMEOUT,
+    DIRECT_LOAD,  // sort rows by rowkey and write major sstables, bypassing memtable
     TOTAL_INT_ITEM
   };
   enum StringHintItem { LOG_LEVEL, TOTAL_STRING_ITEM };
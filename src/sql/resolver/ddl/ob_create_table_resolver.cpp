@@ -1965,6 +1965,11 @@ int ObCreateTableResolver::set_table_option_to_schema(ObTableSchema& table_schem
         } else if (!ObStoreFormat::is_store_format_valid(store_format_, is_oracle_mode)) {
           ret = OB_ERR_UNEXPECTED;
           LOG_WARN("Unexpected store format type", K_(store_format), K(is_oracle_mode), K(ret));
+        } else if (ENCODING_ROW_STORE == ObStoreFormat::get_row_store_type(store_format_) &&
+                   GET_MIN_CLUSTER_VERSION() < CLUSTER_VERSION_316) {
+          ret = OB_NOT_SUPPORTED;
+          LOG_WARN("encoding row store not supported before cluster upgraded", K_(store_format), K(ret));
+          LOG_USER_ERROR(OB_NOT_SUPPORTED, "row format condensed before cluster upgrade to 3.1.6");
         } else {
           row_store_type_ = ObStoreFormat::get_row_store_type(store_format_);
         }
@@ -955,6 +955,11 @@ int ObDDLResolver::resolve_table_option(const ParseNode* option_node, const bool
             if (!ObStoreFormat::is_store_format_valid(store_format_, share::is_oracle_mode())) {
               ret = OB_ERR_UNEXPECTED;
               SQL_RESV_LOG(WARN, "Unexpected invalid store format value", K_(store_format), K(ret));
+            } else if (ENCODING_ROW_STORE == ObStoreFormat::get_row_store_type(store_format_) &&
+                       GET_MIN_CLUSTER_VERSION() < CLUSTER_VERSION_316) {
+              ret = OB_NOT_SUPPORTED;
+              LOG_WARN("encoding row store not supported before cluster upgraded", K_(store_format), K(ret));
+              LOG_USER_ERROR(OB_NOT_SUPPORTED, "row format condensed before cluster upgrade to 3.1.6");
             } else {
               row_store_type_ = ObStoreFormat::get_row_store_type(store_format_);
             }
@@ -1074,6 +1079,35 @@ int ObDDLResolver::resolve_table_option(const ParseNode* option_node, const bool
         }
         break;
       }
+      case T_ZONE_MAP: {
+        // zone map is kept in table mode, servers before 3.1.6 can not read sstables with it
+        if (is_index_option) {
+          ret = OB_NOT_SUPPORTED;
+          LOG_WARN("index option should not specify zone map", K(ret));
+        } else if (GET_MIN_CLUSTER_VERSION() < CLUSTER_VERSION_316) {
+          ret = OB_NOT_SUPPORTED;
+          LOG_WARN("zone map not supported before cluster upgraded", K(ret));
+          LOG_USER_ERROR(OB_NOT_SUPPORTED, "zone map before cluster upgrade to 3.1.6");
+        } else if (OB_ISNULL(option_node->children_[0])) {
+          ret = OB_ERR_UNEXPECTED;
+          SQL_RESV_LOG(WARN, "option_node child is null", K(option_node->children_[0]), K(ret));
+        } else if (stmt::T_ALTER_TABLE == stmt_->get_stmt_type() &&
+                   !alter_table_bitset_.has_member(ObAlterTableArg::TABLE_MODE)) {
+          // the whole table mode is altered, keep the other flags of the table
+          ObTableSchema tmp_table_schema;
+          if (OB_FAIL(get_table_schema_for_check(tmp_table_schema))) {
+            LOG_WARN("get table schema failed", K(ret));
+          } else if (OB_FAIL(alter_table_bitset_.add_member(ObAlterTableArg::TABLE_MODE))) {
+            SQL_RESV_LOG(WARN, "failed to add member to bitset!", K(ret));
+          } else {
+            table_mode_ = tmp_table_schema.get_table_mode_struct();
+          }
+        }
+        if (OB_SUCC(ret)) {
+          table_mode_.zone_map_ = option_node->children_[0]->value_ ? 1 : 0;
+        }
+        break;
+      }
       case T_INDEX_SCOPE: {
         if (OB_ISNULL(option_node->children_[0])) {
           ret = OB_ERR_UNEXPECTED;
@@ -1224,11 +1258,15 @@ int ObDDLResolver::resolve_table_option(const ParseNode* option_node, const bool
           bool is_sync_ddl_user = false;
           ObString table_mode_str(static_cast<int32_t>(option_node->children_[0]->str_len_),
               (char*)(option_node->children_[0]->str_value_));
+          // may be set by ZONE_MAP option before
+          const uint32_t zone_map = table_mode_.zone_map_;
           if (OB_FAIL(ObResolverUtils::check_sync_ddl_user(session_info_, is_sync_ddl_user))) {
             LOG_WARN("Failed to check sync_ddl_user", K(ret));
           } else if (is_sync_ddl_user) {  // in backup mode
             if (OB_FAIL(ObBackUpTableModeOp::get_table_mode(table_mode_str, table_mode_))) {
               LOG_WARN("Failed to get table mode from string", K(ret), K(table_mode_str));
+            } else {
+              table_mode_.zone_map_ = zone_map;
             }
           } else if (0 == table_mode_str.case_compare("normal")) {
             table_mode_.mode_flag_ = TABLE_MODE_NORMAL;
@@ -1240,6 +1278,7 @@ int ObDDLResolver::resolve_table_option(const ParseNode* option_node, const bool
           }
         }
         if (OB_SUCCESS == ret && stmt::T_ALTER_TABLE == stmt_->get_stmt_type()) {
+          const bool has_zone_map_option = alter_table_bitset_.has_member(ObAlterTableArg::TABLE_MODE);
           if (OB_FAIL(alter_table_bitset_.add_member(ObAlterTableArg::TABLE_MODE))) {
             SQL_RESV_LOG(WARN, "failed to add member to bitset!", K(ret));
           } else {
@@ -1253,6 +1292,9 @@ int ObDDLResolver::resolve_table_option(const ParseNode* option_node, const bool
               SQL_RESV_LOG(WARN, "Unsupported table mode", K(ret), K(table_mode_));
             } else {
               table_mode_.pk_mode_ = tmp_table_schema.get_table_mode_struct().pk_mode_;
+              if (!has_zone_map_option) {
+                table_mode_.zone_map_ = tmp_table_schema.get_table_mode_struct().zone_map_;
+              }
             }
           }
         }
@@ -114,6 +114,7 @@ ObSQLSessionInfo::ObSQLSessionInfo()
       plan_cache_manager_(NULL),
       plan_cache_(NULL),
       ps_cache_(NULL),
+      ps_pcv_set_cache_(),
       found_rows_(1),
       affected_rows_(-1),
       global_sessid_(0),
@@ -227,6 +228,7 @@ void ObSQLSessionInfo::reset(bool skip_sys_var)
     version_provider_ = NULL;
     config_provider_ = NULL;
     plan_cache_manager_ = NULL;
+    ps_pcv_set_cache_.reset();
     if (NULL != ps_cache_) {
       ps_cache_->dec_ref_count();
       ps_cache_ = NULL;
@@ -362,6 +364,7 @@ int ObSQLSessionInfo::close_ps_stmt(ObPsStmtId client_stmt_id)
     ObPsStmtId inner_stmt_id = ps_sess_info->get_inner_stmt_id();
     ps_sess_info->dec_ref_count();
     if (ps_sess_info->need_erase()) {
+      ps_pcv_set_cache_.remove(inner_stmt_id);
       if (OB_ISNULL(ps_cache_)) {
         ret = OB_INVALID_ARGUMENT;
         LOG_WARN("ps cache is null", K(ret));
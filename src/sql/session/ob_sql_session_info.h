@@ -33,6 +33,7 @@
 #include "sql/session/ob_session_val_map.h"
 #include "sql/session/ob_basic_session_info.h"
 #include "sql/monitor/ob_exec_stat.h"
+#include "sql/plan_cache/ob_ps_pcv_set_cache.h"
 
 namespace oceanbase {
 namespace observer {
@@ -251,6 +252,10 @@ public:
   }
   ObPlanCache* get_plan_cache();
   ObPsCache* get_ps_cache();
+  ObPsPCVSetCache& get_ps_pcv_set_cache()
+  {
+    return ps_pcv_set_cache_;
+  }
   ObPlanCacheManager* get_plan_cache_manager()
   {
     return plan_cache_manager_;
@@ -687,6 +692,8 @@ private:
   ObPlanCacheManager* plan_cache_manager_;
   ObPlanCache* plan_cache_;
   ObPsCache* ps_cache_;
+  // ids of pcv sets of prepared statements in plan_cache_
+  ObPsPCVSetCache ps_pcv_set_cache_;
   int64_t found_rows_;
   int64_t affected_rows_;
   int64_t global_sessid_;
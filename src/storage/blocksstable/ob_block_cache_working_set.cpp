@@ -61,6 +61,11 @@ void ObBlockCacheWorkingSet::reset()
   inited_ = false;
 }
 
+int64_t ObBlockCacheWorkingSet::get_limit() const
+{
+  return ATOMIC_LOAD(&use_working_set_) ? working_set_.get_limit() : INT64_MAX;
+}
+
 int ObBlockCacheWorkingSet::add_put_size(const int64_t put_size)
 {
   int ret = OB_SUCCESS;
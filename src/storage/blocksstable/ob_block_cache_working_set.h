@@ -34,6 +34,8 @@ public:
   }
   void reset();
 
+  // memory limit of the working set, INT64_MAX if blocks are put into block cache directly
+  int64_t get_limit() const;
   virtual int add_put_size(const int64_t put_size) override;
   virtual int get_cache(BaseBlockCache*& cache) override;
   virtual int get_allocator(common::ObIAllocator*& allocator) override;
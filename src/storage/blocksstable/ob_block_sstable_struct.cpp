@@ -3444,7 +3444,8 @@ ObMacroBlockMetaV2::ObMacroBlockMetaV2()
       encrypt_id_(0),
       master_key_id_(0),
       contain_uncommitted_row_(false),
-      max_merged_trans_version_(0)
+      max_merged_trans_version_(0),
+      micro_block_zone_map_offset_(0)
 {
   encrypt_key_[0] = '\0';
 }
@@ -3468,7 +3469,8 @@ bool ObMacroBlockMetaV2::operator==(const ObMacroBlockMetaV2& other) const
          column_checksum_method_ == other.column_checksum_method_ &&
          progressive_merge_round_ == other.progressive_merge_round_ && encrypt_id_ == other.encrypt_id_ &&
          master_key_id_ == other.master_key_id_ && max_merged_trans_version_ == other.max_merged_trans_version_ &&
-         contain_uncommitted_row_ == other.contain_uncommitted_row_;
+         contain_uncommitted_row_ == other.contain_uncommitted_row_ &&
+         micro_block_zone_map_offset_ == other.micro_block_zone_map_offset_;
 
   if (NULL == column_checksum_ && NULL == other.column_checksum_) {
     ;
@@ -3703,6 +3705,8 @@ int ObMacroBlockMetaV2::serialize(char* buf, int64_t data_len, int64_t& pos) con
         LOG_WARN("failed to serialize contain_uncommitted_row", K(ret), K_(contain_uncommitted_row));
       } else if (OB_FAIL(buffer_writer.write(max_merged_trans_version_))) {
         LOG_WARN("failed to serialize max_merged_trans_version", K(ret), K_(max_merged_trans_version));
+      } else if (OB_FAIL(buffer_writer.write(micro_block_zone_map_offset_))) {
+        LOG_WARN("failed to serialize micro_block_zone_map_offset", K(ret), K_(micro_block_zone_map_offset));
       }
     }
   }
@@ -4049,6 +4053,15 @@ int ObMacroBlockMetaV2::deserialize(const char* buf, int64_t data_len, int64_t&
         max_merged_trans_version_ = 0;
       }
     }
+    if (OB_SUCC(ret)) {
+      if (buffer_reader.pos() - start_pos < header_size) {
+        if (OB_FAIL(buffer_reader.read(micro_block_zone_map_offset_))) {
+          LOG_WARN("failed to deserialize micro_block_zone_map_offset", K(ret), K(buffer_reader));
+        }
+      } else {
+        micro_block_zone_map_offset_ = 0;
+      }
+    }
     if (OB_SUCC(ret)) {
       if (buffer_reader.pos() - start_pos > header_size) {
         ret = OB_BUF_NOT_ENOUGH;
@@ -4108,6 +4121,7 @@ int64_t ObMacroBlockMetaV2::get_serialize_size() const
   serialize_size += sizeof(encrypt_key_);
   serialize_size += sizeof(contain_uncommitted_row_);
   serialize_size += sizeof(max_merged_trans_version_);
+  serialize_size += sizeof(micro_block_zone_map_offset_);
   return serialize_size;
 }
 
@@ -4182,7 +4196,8 @@ int64_t ObMacroBlockMetaV2::to_string(char* buf, const int64_t buf_len) const
       K_(master_key_id),
       K_(encrypt_key),
       K_(max_merged_trans_version),
-      K_(contain_uncommitted_row));
+      K_(contain_uncommitted_row),
+      K_(micro_block_zone_map_offset));
   J_COMMA();
   if (is_data_block()) {
     if (NULL != column_checksum_ && column_number_ > 0) {
@@ -1678,7 +1678,7 @@ public:
   }
   inline int32_t get_endkey_size() const
   {
-    return 0 == micro_block_mark_deletion_offset_ ? occupy_size_ - micro_block_endkey_offset_
+    return 0 == micro_block_mark_deletion_offset_ ? get_index_tail_end() - micro_block_endkey_offset_
                                                   : micro_block_mark_deletion_offset_ - micro_block_endkey_offset_;
   }
   inline int32_t get_micro_block_mark_deletion_size() const
@@ -1687,7 +1687,11 @@ public:
   }
   inline int32_t get_micro_block_delta_size() const
   {
-    return 0 == micro_block_delta_offset_ ? 0 : occupy_size_ - micro_block_delta_offset_;
+    return 0 == micro_block_delta_offset_ ? 0 : get_index_tail_end() - micro_block_delta_offset_;
+  }
+  inline int32_t get_micro_block_zone_map_size() const
+  {
+    return 0 == micro_block_zone_map_offset_ ? 0 : occupy_size_ - micro_block_zone_map_offset_;
   }
   NEED_SERIALIZE_AND_DESERIALIZE;
   OB_INLINE bool is_data_block() const
@@ -1721,6 +1725,11 @@ public:
 
 private:
   int64_t get_meta_content_serialize_size() const;
+  // end of endkeys, mark deletion and delta, the zone map is stored behind them if exists
+  inline int32_t get_index_tail_end() const
+  {
+    return 0 == micro_block_zone_map_offset_ ? occupy_size_ : micro_block_zone_map_offset_;
+  }
 
 public:
   // For compatibility, the variables in this struct MUST NOT be deleted or moved.
@@ -1775,6 +1784,7 @@ public:
   char encrypt_key_[share::OB_MAX_TABLESPACE_ENCRYPT_KEY_LENGTH];
   bool contain_uncommitted_row_;
   int64_t max_merged_trans_version_;
+  int32_t micro_block_zone_map_offset_;  // zone_map_size = occupy_size - micro_block_zone_map_offset, 0 if not exist
 };
 
 struct ObFullMacroBlockMeta final {
@@ -0,0 +1,927 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_column_encoding.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "lib/utility/serialization.h"
+
+namespace oceanbase {
+using namespace common;
+namespace blocksstable {
+
+const char* get_column_encoding_name(const ObColumnEncodingType type)
+{
+  static const char* encoding_names[] = {"RAW", "CONST", "RLE", "DICT", "INTEGER_DELTA", "STRING_PREFIX"};
+  STATIC_ASSERT(ARRAYSIZEOF(encoding_names) == OB_COLUMN_ENCODING_MAX, "encoding names count mismatch");
+  return (type >= OB_COLUMN_ENCODING_RAW && type < OB_COLUMN_ENCODING_MAX) ? encoding_names[type] : "UNKNOWN";
+}
+
+/**
+ * -------------------------------------------------------------------ObEncodingUtil-------------------------------------------------------------------
+ */
+bool ObEncodingUtil::is_integer_encodable(const ObObjMeta& meta)
+{
+  const ObObjTypeClass tc = meta.get_type_class();
+  return ObIntTC == tc || ObUIntTC == tc || ObDateTimeTC == tc || ObDateTC == tc || ObTimeTC == tc || ObYearTC == tc;
+}
+
+bool ObEncodingUtil::is_string_encodable(const ObObjMeta& meta)
+{
+  return ObStringTC == meta.get_type_class();
+}
+
+bool ObEncodingUtil::is_same_meta(const ObObjMeta& lhs, const ObObjMeta& rhs)
+{
+  return lhs.get_type() == rhs.get_type() && lhs.get_collation_level() == rhs.get_collation_level() &&
+         lhs.get_collation_type() == rhs.get_collation_type() && lhs.get_scale() == rhs.get_scale();
+}
+
+uint64_t ObEncodingUtil::get_integer_value(const ObObj& cell)
+{
+  static const uint64_t SIGN_BIT = 1ULL << 63;
+  uint64_t value = 0;
+  switch (cell.get_type_class()) {
+    case ObIntTC:
+      value = static_cast<uint64_t>(cell.v_.int64_) ^ SIGN_BIT;
+      break;
+    case ObDateTimeTC:
+      value = static_cast<uint64_t>(cell.v_.datetime_) ^ SIGN_BIT;
+      break;
+    case ObTimeTC:
+      value = static_cast<uint64_t>(cell.v_.time_) ^ SIGN_BIT;
+      break;
+    case ObDateTC:
+      value = static_cast<uint64_t>(static_cast<int64_t>(cell.v_.date_)) ^ SIGN_BIT;
+      break;
+    case ObUIntTC:
+      value = cell.v_.uint64_;
+      break;
+    case ObYearTC:
+      value = cell.v_.year_;
+      break;
+    default:
+      break;
+  }
+  return value;
+}
+
+void ObEncodingUtil::set_integer_value(const ObObjMeta& meta, const uint64_t value, ObObj& cell)
+{
+  static const uint64_t SIGN_BIT = 1ULL << 63;
+  cell.reset();
+  cell.set_meta_type(meta);
+  switch (meta.get_type_class()) {
+    case ObIntTC:
+      cell.set_int_value(static_cast<int64_t>(value ^ SIGN_BIT));
+      break;
+    case ObDateTimeTC:
+      cell.set_datetime_value(static_cast<int64_t>(value ^ SIGN_BIT));
+      break;
+    case ObTimeTC:
+      cell.set_time_value(static_cast<int64_t>(value ^ SIGN_BIT));
+      break;
+    case ObDateTC:
+      cell.set_date_value(static_cast<int32_t>(static_cast<int64_t>(value ^ SIGN_BIT)));
+      break;
+    case ObUIntTC:
+      cell.set_uint64_value(value);
+      break;
+    case ObYearTC:
+      cell.set_year_value(static_cast<uint8_t>(value));
+      break;
+    default:
+      break;
+  }
+}
+
+static int alloc_zero_space(ObSelfBufferWriter& buffer, const int64_t size, char*& ptr)
+{
+  int ret = OB_SUCCESS;
+  ptr = NULL;
+  if (buffer.remain() < size && OB_FAIL(buffer.expand(size))) {
+    STORAGE_LOG(WARN, "fail to expand buffer", K(ret), K(size));
+  } else {
+    ptr = buffer.current();
+    if (OB_FAIL(buffer.advance_zero(size))) {
+      STORAGE_LOG(WARN, "fail to advance buffer", K(ret), K(size));
+    }
+  }
+  return ret;
+}
+
+/**
+ * -------------------------------------------------------------------ObColumnEncoder-------------------------------------------------------------------
+ */
+ObColumnEncoder::ObColumnEncoder()
+{
+  reset();
+}
+
+void ObColumnEncoder::reset()
+{
+  cells_ = ObEncodingCells();
+  type_ = OB_COLUMN_ENCODING_RAW;
+  encoded_size_ = 0;
+  bit_width_ = 0;
+  null_count_ = 0;
+  refs_ = NULL;
+  dict_rows_ = NULL;
+  dict_count_ = 0;
+  run_count_ = 0;
+  raw_bytes_ = 0;
+  dict_bytes_ = 0;
+  run_bytes_ = 0;
+  is_nulls_ = NULL;
+  values_ = NULL;
+  is_integer_ = false;
+  is_string_ = false;
+  meta_.reset();
+  base_ = 0;
+  prefix_bytes_ = 0;
+  is_inited_ = false;
+}
+
+int ObColumnEncoder::init(const ObEncodingCells& cells, ObIAllocator& allocator)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_UNLIKELY(!cells.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(cells));
+  } else {
+    cells_ = cells;
+    if (OB_FAIL(build_dict(allocator))) {
+      STORAGE_LOG(WARN, "fail to build dict", K(ret), K(cells));
+    } else if (dict_count_ > 1 && OB_FAIL(analyze_values(allocator))) {
+      STORAGE_LOG(WARN, "fail to analyze values", K(ret), K(cells));
+    } else {
+      choose_encoding();
+      is_inited_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObColumnEncoder::build_dict(ObIAllocator& allocator)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = cells_.row_count_;
+  const int64_t bucket_count = next_pow2(row_count * 2);
+  int32_t* buckets = NULL;
+  if (OB_ISNULL(refs_ = static_cast<int32_t*>(allocator.alloc(sizeof(int32_t) * row_count))) ||
+      OB_ISNULL(dict_rows_ = static_cast<int32_t*>(allocator.alloc(sizeof(int32_t) * row_count))) ||
+      OB_ISNULL(buckets = static_cast<int32_t*>(allocator.alloc(sizeof(int32_t) * bucket_count)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate memory", K(ret), K(row_count), K(bucket_count));
+  } else {
+    MEMSET(buckets, 0xFF, sizeof(int32_t) * bucket_count);
+    for (int64_t row_idx = 0; row_idx < row_count; ++row_idx) {
+      int64_t len = 0;
+      const char* cell = cells_.get_cell(row_idx, len);
+      int64_t pos = static_cast<int64_t>(murmurhash(cell, static_cast<int32_t>(len), 0) & (bucket_count - 1));
+      int32_t ref = -1;
+      while (ref < 0) {
+        const int32_t dict_idx = buckets[pos];
+        if (dict_idx < 0) {
+          ref = static_cast<int32_t>(dict_count_);
+          buckets[pos] = ref;
+          dict_rows_[dict_count_++] = static_cast<int32_t>(row_idx);
+          dict_bytes_ += len;
+        } else {
+          int64_t dict_len = 0;
+          const char* dict_cell = cells_.get_cell(dict_rows_[dict_idx], dict_len);
+          if (dict_len == len && 0 == MEMCMP(dict_cell, cell, len)) {
+            ref = dict_idx;
+          } else {
+            pos = (pos + 1) & (bucket_count - 1);
+          }
+        }
+      }
+      refs_[row_idx] = ref;
+      if (0 == row_idx || refs_[row_idx - 1] != ref) {
+        ++run_count_;
+        run_bytes_ += len;
+      }
+      raw_bytes_ += len;
+    }
+  }
+  return ret;
+}
+
+int ObColumnEncoder::analyze_values(ObIAllocator& allocator)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = cells_.row_count_;
+  bool has_meta = false;
+  uint64_t min_value = UINT64_MAX;
+  uint64_t max_value = 0;
+  if (OB_ISNULL(is_nulls_ = static_cast<bool*>(allocator.alloc(sizeof(bool) * row_count))) ||
+      OB_ISNULL(values_ = static_cast<uint64_t*>(allocator.alloc(sizeof(uint64_t) * row_count)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate memory", K(ret), K(row_count));
+  } else {
+    ObObj cell;
+    for (int64_t row_idx = 0; OB_SUCC(ret) && row_idx < row_count; ++row_idx) {
+      int64_t len = 0;
+      int64_t pos = 0;
+      const char* buf = cells_.get_cell(row_idx, len);
+      values_[row_idx] = 0;
+      if (OB_FAIL(cell.deserialize(buf, len, pos))) {
+        STORAGE_LOG(WARN, "fail to deserialize cell", K(ret), K(row_idx), K(len));
+      } else if (cell.is_null()) {
+        is_nulls_[row_idx] = true;
+        ++null_count_;
+      } else {
+        is_nulls_[row_idx] = false;
+        if (!has_meta) {
+          has_meta = true;
+          meta_ = cell.get_meta();
+          is_integer_ = ObEncodingUtil::is_integer_encodable(meta_);
+          is_string_ = ObEncodingUtil::is_string_encodable(meta_);
+        } else if (!ObEncodingUtil::is_same_meta(meta_, cell.get_meta())) {
+          is_integer_ = false;
+          is_string_ = false;
+        }
+        if (is_integer_) {
+          values_[row_idx] = ObEncodingUtil::get_integer_value(cell);
+          min_value = std::min(min_value, values_[row_idx]);
+          max_value = std::max(max_value, values_[row_idx]);
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      if (is_integer_) {
+        base_ = min_value;
+        bit_width_ = ObEncodingUtil::get_bit_width(max_value - min_value);
+      }
+      if (is_string_) {
+        ObString prev;
+        ObString cur;
+        for (int64_t row_idx = 0; OB_SUCC(ret) && row_idx < row_count; ++row_idx) {
+          if (OB_FAIL(read_string(row_idx, cur))) {
+            STORAGE_LOG(WARN, "fail to read string", K(ret), K(row_idx));
+          } else {
+            int64_t prefix_len = 0;
+            if (0 != row_idx % PREFIX_RESTART_INTERVAL) {
+              const int64_t max_len = std::min(prev.length(), cur.length());
+              while (prefix_len < max_len && prev.ptr()[prefix_len] == cur.ptr()[prefix_len]) {
+                ++prefix_len;
+              }
+            }
+            const int64_t suffix_len = cur.length() - prefix_len;
+            prefix_bytes_ += serialization::encoded_length_vi32(static_cast<int32_t>(prefix_len)) +
+                             serialization::encoded_length_vi32(static_cast<int32_t>(suffix_len)) + suffix_len;
+            prev = cur;
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObColumnEncoder::read_string(const int64_t row_idx, ObString& str) const
+{
+  int ret = OB_SUCCESS;
+  str.reset();
+  if (!is_nulls_[row_idx]) {
+    ObObj cell;
+    int64_t len = 0;
+    int64_t pos = 0;
+    const char* buf = cells_.get_cell(row_idx, len);
+    if (OB_FAIL(cell.deserialize(buf, len, pos))) {
+      STORAGE_LOG(WARN, "fail to deserialize cell", K(ret), K(row_idx), K(len));
+    } else {
+      str.assign_ptr(cell.v_.string_, cell.val_len_);
+    }
+  }
+  return ret;
+}
+
+void ObColumnEncoder::choose_encoding()
+{
+  const int64_t row_count = cells_.row_count_;
+  type_ = OB_COLUMN_ENCODING_RAW;
+  encoded_size_ = (row_count + 1) * sizeof(uint32_t) + raw_bytes_;
+  if (1 == dict_count_) {
+    type_ = OB_COLUMN_ENCODING_CONST;
+    encoded_size_ = dict_bytes_;
+    bit_width_ = 0;
+  } else {
+    const int64_t meta_size = meta_.get_serialize_size();
+    const int64_t bitmap_size = null_count_ > 0 ? ObEncodingUtil::get_bitmap_size(row_count) : 0;
+    const int64_t dict_width = ObEncodingUtil::get_bit_width(dict_count_ - 1);
+    const int64_t integer_width = bit_width_;
+    bit_width_ = 0;
+    if (is_integer_ && null_count_ < row_count) {
+      const int64_t size =
+          meta_size + sizeof(uint64_t) + bitmap_size + ObEncodingUtil::get_packed_size(row_count, integer_width);
+      if (size < encoded_size_) {
+        type_ = OB_COLUMN_ENCODING_INTEGER_DELTA;
+        encoded_size_ = size;
+        bit_width_ = integer_width;
+      }
+    }
+    {
+      const int64_t size = sizeof(uint32_t) + (dict_count_ + 1) * sizeof(uint32_t) + dict_bytes_ +
+                           ObEncodingUtil::get_packed_size(row_count, dict_width);
+      if (size < encoded_size_) {
+        type_ = OB_COLUMN_ENCODING_DICT;
+        encoded_size_ = size;
+        bit_width_ = dict_width;
+      }
+    }
+    {
+      const int64_t size = sizeof(uint32_t) + (2 * run_count_ + 1) * sizeof(uint32_t) + run_bytes_;
+      if (size < encoded_size_) {
+        type_ = OB_COLUMN_ENCODING_RLE;
+        encoded_size_ = size;
+        bit_width_ = 0;
+      }
+    }
+    if (is_string_ && null_count_ < row_count) {
+      const int64_t restart_count = (row_count + PREFIX_RESTART_INTERVAL - 1) / PREFIX_RESTART_INTERVAL;
+      const int64_t size =
+          meta_size + bitmap_size + sizeof(uint32_t) + restart_count * sizeof(uint32_t) + prefix_bytes_;
+      if (size < encoded_size_) {
+        type_ = OB_COLUMN_ENCODING_STRING_PREFIX;
+        encoded_size_ = size;
+        bit_width_ = 0;
+      }
+    }
+  }
+}
+
+int ObColumnEncoder::encode(ObSelfBufferWriter& buffer, ObColumnEncodingHeader& header) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t start_pos = buffer.length();
+  header.reset();
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "column encoder not init", K(ret));
+  } else {
+    switch (type_) {
+      case OB_COLUMN_ENCODING_RAW:
+        ret = encode_raw(buffer);
+        break;
+      case OB_COLUMN_ENCODING_CONST:
+        ret = encode_const(buffer);
+        break;
+      case OB_COLUMN_ENCODING_RLE:
+        ret = encode_rle(buffer);
+        break;
+      case OB_COLUMN_ENCODING_DICT:
+        ret = encode_dict(buffer);
+        break;
+      case OB_COLUMN_ENCODING_INTEGER_DELTA:
+        ret = encode_integer(buffer);
+        break;
+      case OB_COLUMN_ENCODING_STRING_PREFIX:
+        ret = encode_string_prefix(buffer);
+        break;
+      default:
+        ret = OB_ERR_UNEXPECTED;
+        break;
+    }
+    if (OB_FAIL(ret)) {
+      STORAGE_LOG(WARN, "fail to encode column", K(ret), K(*this));
+    } else if (OB_UNLIKELY(buffer.length() - start_pos != encoded_size_)) {
+      ret = OB_ERR_UNEXPECTED;
+      STORAGE_LOG(WARN, "encoded size mismatch", K(ret), K(start_pos), K(buffer.length()), K(*this));
+    } else {
+      header.type_ = static_cast<uint8_t>(type_);
+      header.bit_width_ = static_cast<uint8_t>(bit_width_);
+      if (null_count_ > 0 &&
+          (OB_COLUMN_ENCODING_INTEGER_DELTA == type_ || OB_COLUMN_ENCODING_STRING_PREFIX == type_)) {
+        header.attr_ |= ObColumnEncodingHeader::HAS_NULL_BITMAP;
+      }
+      header.offset_ = static_cast<uint32_t>(start_pos);
+      header.length_ = static_cast<uint32_t>(encoded_size_);
+    }
+  }
+  return ret;
+}
+
+int ObColumnEncoder::encode_raw(ObSelfBufferWriter& buffer) const
+{
+  int ret = OB_SUCCESS;
+  uint32_t offset = 0;
+  for (int64_t row_idx = 0; OB_SUCC(ret) && row_idx < cells_.row_count_; ++row_idx) {
+    int64_t len = 0;
+    cells_.get_cell(row_idx, len);
+    if (OB_FAIL(buffer.write(offset))) {
+      STORAGE_LOG(WARN, "fail to write offset", K(ret), K(row_idx));
+    } else {
+      offset += static_cast<uint32_t>(len);
+    }
+  }
+  if (OB_SUCC(ret) && OB_FAIL(buffer.write(offset))) {
+    STORAGE_LOG(WARN, "fail to write tail offset", K(ret));
+  }
+  for (int64_t row_idx = 0; OB_SUCC(ret) && row_idx < cells_.row_count_; ++row_idx) {
+    int64_t len = 0;
+    const char* cell = cells_.get_cell(row_idx, len);
+    if (OB_FAIL(buffer.write(cell, len))) {
+      STORAGE_LOG(WARN, "fail to write cell", K(ret), K(row_idx), K(len));
+    }
+  }
+  return ret;
+}
+
+int ObColumnEncoder::encode_const(ObSelfBufferWriter& buffer) const
+{
+  int ret = OB_SUCCESS;
+  int64_t len = 0;
+  const char* cell = cells_.get_cell(0, len);
+  if (OB_FAIL(buffer.write(cell, len))) {
+    STORAGE_LOG(WARN, "fail to write const cell", K(ret), K(len));
+  }
+  return ret;
+}
+
+int ObColumnEncoder::encode_rle(ObSelfBufferWriter& buffer) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = cells_.row_count_;
+  if (OB_FAIL(buffer.write(static_cast<uint32_t>(run_count_)))) {
+    STORAGE_LOG(WARN, "fail to write run count", K(ret));
+  }
+  // run ends, exclusive
+  for (int64_t row_idx = 1; OB_SUCC(ret) && row_idx <= row_count; ++row_idx) {
+    if (row_count == row_idx || refs_[row_idx] != refs_[row_idx - 1]) {
+      if (OB_FAIL(buffer.write(static_cast<uint32_t>(row_idx)))) {
+        STORAGE_LOG(WARN, "fail to write run end", K(ret), K(row_idx));
+      }
+    }
+  }
+  uint32_t offset = 0;
+  for (int64_t row_idx = 0; OB_SUCC(ret) && row_idx < row_count; ++row_idx) {
+    if (0 == row_idx || refs_[row_idx] != refs_[row_idx - 1]) {
+      int64_t len = 0;
+      cells_.get_cell(row_idx, len);
+      if (OB_FAIL(buffer.write(offset))) {
+        STORAGE_LOG(WARN, "fail to write offset", K(ret), K(row_idx));
+      } else {
+        offset += static_cast<uint32_t>(len);
+      }
+    }
+  }
+  if (OB_SUCC(ret) && OB_FAIL(buffer.write(offset))) {
+    STORAGE_LOG(WARN, "fail to write tail offset", K(ret));
+  }
+  for (int64_t row_idx = 0; OB_SUCC(ret) && row_idx < row_count; ++row_idx) {
+    if (0 == row_idx || refs_[row_idx] != refs_[row_idx - 1]) {
+      int64_t len = 0;
+      const char* cell = cells_.get_cell(row_idx, len);
+      if (OB_FAIL(buffer.write(cell, len))) {
+        STORAGE_LOG(WARN, "fail to write cell", K(ret), K(row_idx), K(len));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObColumnEncoder::encode_dict(ObSelfBufferWriter& buffer) const
+{
+  int ret = OB_SUCCESS;
+  uint32_t offset = 0;
+  char* packed = NULL;
+  if (OB_FAIL(buffer.write(static_cast<uint32_t>(dict_count_)))) {
+    STORAGE_LOG(WARN, "fail to write dict count", K(ret));
+  }
+  for (int64_t dict_idx = 0; OB_SUCC(ret) && dict_idx < dict_count_; ++dict_idx) {
+    int64_t len = 0;
+    cells_.get_cell(dict_rows_[dict_idx], len);
+    if (OB_FAIL(buffer.write(offset))) {
+      STORAGE_LOG(WARN, "fail to write offset", K(ret), K(dict_idx));
+    } else {
+      offset += static_cast<uint32_t>(len);
+    }
+  }
+  if (OB_SUCC(ret) && OB_FAIL(buffer.write(offset))) {
+    STORAGE_LOG(WARN, "fail to write tail offset", K(ret));
+  }
+  for (int64_t dict_idx = 0; OB_SUCC(ret) && dict_idx < dict_count_; ++dict_idx) {
+    int64_t len = 0;
+    const char* cell = cells_.get_cell(dict_rows_[dict_idx], len);
+    if (OB_FAIL(buffer.write(cell, len))) {
+      STORAGE_LOG(WARN, "fail to write dict cell", K(ret), K(dict_idx), K(len));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(alloc_zero_space(
+                 buffer, ObEncodingUtil::get_packed_size(cells_.row_count_, bit_width_), packed))) {
+    STORAGE_LOG(WARN, "fail to alloc packed space", K(ret));
+  } else {
+    for (int64_t row_idx = 0; row_idx < cells_.row_count_; ++row_idx) {
+      ObEncodingUtil::pack(packed, row_idx, bit_width_, static_cast<uint64_t>(refs_[row_idx]));
+    }
+  }
+  return ret;
+}
+
+int ObColumnEncoder::write_null_bitmap(ObSelfBufferWriter& buffer) const
+{
+  int ret = OB_SUCCESS;
+  char* bitmap = NULL;
+  if (null_count_ > 0) {
+    if (OB_FAIL(alloc_zero_space(buffer, ObEncodingUtil::get_bitmap_size(cells_.row_count_), bitmap))) {
+      STORAGE_LOG(WARN, "fail to alloc null bitmap", K(ret));
+    } else {
+      for (int64_t row_idx = 0; row_idx < cells_.row_count_; ++row_idx) {
+        if (is_nulls_[row_idx]) {
+          ObEncodingUtil::set_bit(bitmap, row_idx);
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObColumnEncoder::encode_integer(ObSelfBufferWriter& buffer) const
+{
+  int ret = OB_SUCCESS;
+  char* packed = NULL;
+  if (OB_FAIL(buffer.write(meta_))) {
+    STORAGE_LOG(WARN, "fail to write meta", K(ret), K_(meta));
+  } else if (OB_FAIL(buffer.write(base_))) {
+    STORAGE_LOG(WARN, "fail to write base", K(ret), K_(base));
+  } else if (OB_FAIL(write_null_bitmap(buffer))) {
+    STORAGE_LOG(WARN, "fail to write null bitmap", K(ret));
+  } else if (OB_FAIL(alloc_zero_space(
+                 buffer, ObEncodingUtil::get_packed_size(cells_.row_count_, bit_width_), packed))) {
+    STORAGE_LOG(WARN, "fail to alloc packed space", K(ret));
+  } else {
+    for (int64_t row_idx = 0; row_idx < cells_.row_count_; ++row_idx) {
+      if (!is_nulls_[row_idx]) {
+        ObEncodingUtil::pack(packed, row_idx, bit_width_, values_[row_idx] - base_);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObColumnEncoder::encode_string_prefix(ObSelfBufferWriter& buffer) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = cells_.row_count_;
+  const int64_t restart_count = (row_count + PREFIX_RESTART_INTERVAL - 1) / PREFIX_RESTART_INTERVAL;
+  char* restarts = NULL;
+  int64_t restarts_pos = 0;
+  int64_t entries_pos = 0;
+  if (OB_FAIL(buffer.write(meta_))) {
+    STORAGE_LOG(WARN, "fail to write meta", K(ret), K_(meta));
+  } else if (OB_FAIL(write_null_bitmap(buffer))) {
+    STORAGE_LOG(WARN, "fail to write null bitmap", K(ret));
+  } else if (OB_FAIL(buffer.write(static_cast<uint32_t>(restart_count)))) {
+    STORAGE_LOG(WARN, "fail to write restart count", K(ret));
+  } else if (OB_FAIL(alloc_zero_space(buffer, restart_count * sizeof(uint32_t), restarts))) {
+    STORAGE_LOG(WARN, "fail to alloc restart space", K(ret), K(restart_count));
+  } else {
+    restarts_pos = restarts - buffer.data();
+    entries_pos = buffer.length();
+    ObString prev;
+    ObString cur;
+    char len_buf[2 * sizeof(int32_t) + 2];
+    for (int64_t row_idx = 0; OB_SUCC(ret) && row_idx < row_count; ++row_idx) {
+      int64_t prefix_len = 0;
+      int64_t len_pos = 0;
+      if (0 == row_idx % PREFIX_RESTART_INTERVAL) {
+        const uint32_t restart_offset = static_cast<uint32_t>(buffer.length() - entries_pos);
+        MEMCPY(buffer.data() + restarts_pos + (row_idx / PREFIX_RESTART_INTERVAL) * sizeof(uint32_t),
+            &restart_offset,
+            sizeof(restart_offset));
+      }
+      if (OB_FAIL(read_string(row_idx, cur))) {
+        STORAGE_LOG(WARN, "fail to read string", K(ret), K(row_idx));
+      } else {
+        if (0 != row_idx % PREFIX_RESTART_INTERVAL) {
+          const int64_t max_len = std::min(prev.length(), cur.length());
+          while (prefix_len < max_len && prev.ptr()[prefix_len] == cur.ptr()[prefix_len]) {
+            ++prefix_len;
+          }
+        }
+        const int32_t suffix_len = static_cast<int32_t>(cur.length() - prefix_len);
+        if (OB_FAIL(serialization::encode_vi32(
+                len_buf, sizeof(len_buf), len_pos, static_cast<int32_t>(prefix_len)))) {
+          STORAGE_LOG(WARN, "fail to encode prefix length", K(ret), K(prefix_len));
+        } else if (OB_FAIL(serialization::encode_vi32(len_buf, sizeof(len_buf), len_pos, suffix_len))) {
+          STORAGE_LOG(WARN, "fail to encode suffix length", K(ret), K(suffix_len));
+        } else if (OB_FAIL(buffer.write(len_buf, len_pos))) {
+          STORAGE_LOG(WARN, "fail to write entry length", K(ret), K(len_pos));
+        } else if (suffix_len > 0 && OB_FAIL(buffer.write(cur.ptr() + prefix_len, suffix_len))) {
+          STORAGE_LOG(WARN, "fail to write suffix", K(ret), K(suffix_len));
+        } else {
+          prev = cur;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+/**
+ * -------------------------------------------------------------------ObColumnDecoder-------------------------------------------------------------------
+ */
+ObColumnDecoder::ObColumnDecoder()
+{
+  reset();
+}
+
+void ObColumnDecoder::reset()
+{
+  header_.reset();
+  payload_ = NULL;
+  row_count_ = 0;
+  count_ = 0;
+  offsets_ = NULL;
+  cells_ = NULL;
+  run_ends_ = NULL;
+  packed_ = NULL;
+  null_bitmap_ = NULL;
+  entries_ = NULL;
+  entries_len_ = 0;
+  meta_.reset();
+  base_ = 0;
+  const_cell_.reset();
+  last_run_ = -1;
+  last_row_ = -1;
+  last_pos_ = 0;
+  last_buf_ = NULL;
+  last_len_ = 0;
+  last_buf_size_ = 0;
+  allocator_ = NULL;
+  is_inited_ = false;
+}
+
+int ObColumnDecoder::init(
+    const char* block_buf, const ObColumnEncodingHeader& header, const int64_t row_count, ObIAllocator& allocator)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_UNLIKELY(NULL == block_buf || !header.is_valid() || row_count <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), KP(block_buf), K(header), K(row_count));
+  } else {
+    int64_t pos = 0;
+    header_ = header;
+    payload_ = block_buf + header.offset_;
+    row_count_ = row_count;
+    allocator_ = &allocator;
+    switch (header.type_) {
+      case OB_COLUMN_ENCODING_RAW: {
+        offsets_ = payload_;
+        cells_ = payload_ + (row_count_ + 1) * sizeof(uint32_t);
+        break;
+      }
+      case OB_COLUMN_ENCODING_CONST: {
+        if (OB_FAIL(const_cell_.deserialize(payload_, header_.length_, pos))) {
+          STORAGE_LOG(WARN, "fail to deserialize const cell", K(ret), K(header));
+        }
+        break;
+      }
+      case OB_COLUMN_ENCODING_RLE: {
+        count_ = ObEncodingUtil::read_uint32(payload_, 0);
+        run_ends_ = payload_ + sizeof(uint32_t);
+        offsets_ = run_ends_ + count_ * sizeof(uint32_t);
+        cells_ = offsets_ + (count_ + 1) * sizeof(uint32_t);
+        break;
+      }
+      case OB_COLUMN_ENCODING_DICT: {
+        count_ = ObEncodingUtil::read_uint32(payload_, 0);
+        offsets_ = payload_ + sizeof(uint32_t);
+        cells_ = offsets_ + (count_ + 1) * sizeof(uint32_t);
+        packed_ = cells_ + ObEncodingUtil::read_uint32(offsets_, count_);
+        break;
+      }
+      case OB_COLUMN_ENCODING_INTEGER_DELTA: {
+        if (OB_FAIL(meta_.deserialize(payload_, header_.length_, pos))) {
+          STORAGE_LOG(WARN, "fail to deserialize meta", K(ret), K(header));
+        } else {
+          MEMCPY(&base_, payload_ + pos, sizeof(base_));
+          pos += sizeof(base_);
+          if (header_.has_null_bitmap()) {
+            null_bitmap_ = payload_ + pos;
+            pos += ObEncodingUtil::get_bitmap_size(row_count_);
+          }
+          packed_ = payload_ + pos;
+        }
+        break;
+      }
+      case OB_COLUMN_ENCODING_STRING_PREFIX: {
+        if (OB_FAIL(meta_.deserialize(payload_, header_.length_, pos))) {
+          STORAGE_LOG(WARN, "fail to deserialize meta", K(ret), K(header));
+        } else {
+          if (header_.has_null_bitmap()) {
+            null_bitmap_ = payload_ + pos;
+            pos += ObEncodingUtil::get_bitmap_size(row_count_);
+          }
+          count_ = ObEncodingUtil::read_uint32(payload_ + pos, 0);
+          offsets_ = payload_ + pos + sizeof(uint32_t);
+          entries_ = offsets_ + count_ * sizeof(uint32_t);
+          entries_len_ = payload_ + header_.length_ - entries_;
+        }
+        break;
+      }
+      default: {
+        ret = OB_NOT_SUPPORTED;
+        STORAGE_LOG(WARN, "not supported column encoding", K(ret), K(header));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      is_inited_ = true;
+    }
+  }
+  return ret;
+}
+
+OB_INLINE int ObColumnDecoder::read_cell(const int64_t cell_idx, ObObj& cell) const
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  const uint32_t begin = ObEncodingUtil::read_uint32(offsets_, cell_idx);
+  const uint32_t end = ObEncodingUtil::read_uint32(offsets_, cell_idx + 1);
+  if (OB_FAIL(cell.deserialize(cells_ + begin, end - begin, pos))) {
+    STORAGE_LOG(WARN, "fail to deserialize cell", K(ret), K(cell_idx), K(begin), K(end));
+  }
+  return ret;
+}
+
+int ObColumnDecoder::decode(const int64_t row_idx, ObIAllocator& allocator, ObObj& cell)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "column decoder not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < 0 || row_idx >= row_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid row index", K(ret), K(row_idx), K_(row_count));
+  } else {
+    switch (header_.type_) {
+      case OB_COLUMN_ENCODING_RAW: {
+        ret = read_cell(row_idx, cell);
+        break;
+      }
+      case OB_COLUMN_ENCODING_CONST: {
+        cell = const_cell_;
+        break;
+      }
+      case OB_COLUMN_ENCODING_RLE: {
+        ret = decode_rle(row_idx, cell);
+        break;
+      }
+      case OB_COLUMN_ENCODING_DICT: {
+        ret = read_cell(static_cast<int64_t>(ObEncodingUtil::unpack(packed_, row_idx, header_.bit_width_)), cell);
+        break;
+      }
+      case OB_COLUMN_ENCODING_INTEGER_DELTA: {
+        if (NULL != null_bitmap_ && ObEncodingUtil::test_bit(null_bitmap_, row_idx)) {
+          cell.reset();
+          cell.set_null();
+        } else {
+          ObEncodingUtil::set_integer_value(
+              meta_, base_ + ObEncodingUtil::unpack(packed_, row_idx, header_.bit_width_), cell);
+        }
+        break;
+      }
+      case OB_COLUMN_ENCODING_STRING_PREFIX: {
+        ret = decode_string_prefix(row_idx, allocator, cell);
+        break;
+      }
+      default: {
+        ret = OB_NOT_SUPPORTED;
+      }
+    }
+    if (OB_FAIL(ret)) {
+      STORAGE_LOG(WARN, "fail to decode cell", K(ret), K(row_idx), K(*this));
+    }
+  }
+  return ret;
+}
+
+int ObColumnDecoder::decode_rle(const int64_t row_idx, ObObj& cell)
+{
+  int64_t run_idx = -1;
+  if (last_run_ >= 0) {
+    const int64_t run_begin = 0 == last_run_ ? 0 : ObEncodingUtil::read_uint32(run_ends_, last_run_ - 1);
+    if (row_idx >= run_begin && row_idx < ObEncodingUtil::read_uint32(run_ends_, last_run_)) {
+      run_idx = last_run_;
+    } else if (last_run_ + 1 < count_ && row_idx >= ObEncodingUtil::read_uint32(run_ends_, last_run_) &&
+               row_idx < ObEncodingUtil::read_uint32(run_ends_, last_run_ + 1)) {
+      run_idx = last_run_ + 1;
+    }
+  }
+  if (run_idx < 0) {
+    // first run whose exclusive end is larger than row_idx
+    int64_t low = 0;
+    int64_t high = count_ - 1;
+    while (low < high) {
+      const int64_t mid = low + (high - low) / 2;
+      if (ObEncodingUtil::read_uint32(run_ends_, mid) > row_idx) {
+        high = mid;
+      } else {
+        low = mid + 1;
+      }
+    }
+    run_idx = low;
+  }
+  last_run_ = run_idx;
+  return read_cell(run_idx, cell);
+}
+
+int ObColumnDecoder::decode_string_prefix(const int64_t row_idx, ObIAllocator& allocator, ObObj& cell)
+{
+  int ret = OB_SUCCESS;
+  if (NULL != null_bitmap_ && ObEncodingUtil::test_bit(null_bitmap_, row_idx)) {
+    cell.reset();
+    cell.set_null();
+  } else {
+    const int64_t restart_idx = row_idx / ObColumnEncoder::PREFIX_RESTART_INTERVAL;
+    int64_t cur_row = 0;
+    int64_t pos = 0;
+    int32_t prefix_len = 0;
+    int32_t suffix_len = 0;
+    if (last_row_ >= 0 && last_row_ < row_idx && last_row_ / ObColumnEncoder::PREFIX_RESTART_INTERVAL == restart_idx) {
+      cur_row = last_row_ + 1;
+      pos = last_pos_;
+    } else {
+      cur_row = restart_idx * ObColumnEncoder::PREFIX_RESTART_INTERVAL;
+      pos = ObEncodingUtil::read_uint32(offsets_, restart_idx);
+      last_len_ = 0;
+    }
+    for (; OB_SUCC(ret) && cur_row <= row_idx; ++cur_row) {
+      if (OB_FAIL(serialization::decode_vi32(entries_, entries_len_, pos, &prefix_len))) {
+        STORAGE_LOG(WARN, "fail to decode prefix length", K(ret), K(pos), K(cur_row));
+      } else if (OB_FAIL(serialization::decode_vi32(entries_, entries_len_, pos, &suffix_len))) {
+        STORAGE_LOG(WARN, "fail to decode suffix length", K(ret), K(pos), K(cur_row));
+      } else if (OB_UNLIKELY(prefix_len > last_len_ || suffix_len < 0 || pos + suffix_len > entries_len_)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "invalid prefix entry", K(ret), K(prefix_len), K(suffix_len), K(pos), K(cur_row), K(*this));
+      } else {
+        const int64_t len = prefix_len + suffix_len;
+        if (len > last_buf_size_) {
+          const int64_t buf_size = std::max(len, 2 * last_buf_size_);
+          char* buf = static_cast<char*>(allocator_->alloc(buf_size));
+          if (OB_ISNULL(buf)) {
+            ret = OB_ALLOCATE_MEMORY_FAILED;
+            STORAGE_LOG(WARN, "fail to allocate memory", K(ret), K(buf_size));
+          } else {
+            if (last_len_ > 0) {
+              MEMCPY(buf, last_buf_, last_len_);
+            }
+            last_buf_ = buf;
+            last_buf_size_ = buf_size;
+          }
+        }
+        if (OB_SUCC(ret)) {
+          if (suffix_len > 0) {
+            MEMCPY(last_buf_ + prefix_len, entries_ + pos, suffix_len);
+          }
+          pos += suffix_len;
+          last_len_ = len;
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      last_row_ = row_idx;
+      last_pos_ = pos;
+      const char* ptr = NULL;
+      if (0 == prefix_len) {
+        // the whole string is stored as suffix, no copy needed
+        ptr = entries_ + pos - suffix_len;
+      } else {
+        char* buf = static_cast<char*>(allocator.alloc(last_len_));
+        if (OB_ISNULL(buf)) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          STORAGE_LOG(WARN, "fail to allocate memory", K(ret), K_(last_len));
+        } else {
+          MEMCPY(buf, last_buf_, last_len_);
+          ptr = buf;
+        }
+      }
+      if (OB_SUCC(ret)) {
+        cell.reset();
+        cell.set_meta_type(meta_);
+        cell.set_common_value(ObString(static_cast<ObString::obstr_size_t>(last_len_), ptr));
+      }
+    } else {
+      last_row_ = -1;
+    }
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
@@ -0,0 +1,277 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_COLUMN_ENCODING_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_COLUMN_ENCODING_H_
+
+#include "lib/allocator/ob_allocator.h"
+#include "common/object/ob_object.h"
+#include "ob_data_buffer.h"
+
+namespace oceanbase {
+namespace blocksstable {
+
+// column encoding types of the encoded micro block, the value is persisted
+enum ObColumnEncodingType {
+  OB_COLUMN_ENCODING_RAW = 0,            // cell offsets | cells
+  OB_COLUMN_ENCODING_CONST = 1,          // single cell shared by all rows
+  OB_COLUMN_ENCODING_RLE = 2,            // run ends | cell offsets | one cell per run
+  OB_COLUMN_ENCODING_DICT = 3,           // cell offsets | distinct cells | bit packed references
+  OB_COLUMN_ENCODING_INTEGER_DELTA = 4,  // meta | base | null bitmap | bit packed deltas to base
+  OB_COLUMN_ENCODING_STRING_PREFIX = 5,  // meta | null bitmap | restart offsets | front coded entries
+  OB_COLUMN_ENCODING_MAX
+};
+
+const char* get_column_encoding_name(const ObColumnEncodingType type);
+
+// Column header array is stored at ObMicroBlockHeader::row_index_offset_ of an encoded micro block,
+// one header for each store column plus one for the hidden row flag column.
+struct ObColumnEncodingHeader {
+  static const uint8_t HAS_NULL_BITMAP = 0x1;
+
+  uint8_t type_;
+  uint8_t attr_;
+  uint8_t bit_width_;
+  uint8_t reserved_;
+  uint32_t offset_;  // payload offset from the beginning of micro block
+  uint32_t length_;  // payload length
+
+  ObColumnEncodingHeader()
+  {
+    reset();
+  }
+  void reset()
+  {
+    MEMSET(this, 0, sizeof(*this));
+  }
+  OB_INLINE bool has_null_bitmap() const
+  {
+    return 0 != (attr_ & HAS_NULL_BITMAP);
+  }
+  OB_INLINE bool is_valid() const
+  {
+    return type_ < OB_COLUMN_ENCODING_MAX && bit_width_ <= 64;
+  }
+  TO_STRING_KV(K_(type), K_(attr), K_(bit_width), K_(offset), K_(length));
+} __attribute__((packed));
+
+class ObEncodingUtil {
+public:
+  static const int64_t PACKED_PADDING_SIZE = sizeof(uint64_t);
+
+  OB_INLINE static int64_t get_bit_width(const uint64_t value)
+  {
+    return 0 == value ? 0 : 64 - __builtin_clzll(value);
+  }
+  // padding bytes make unpack always able to load 8 bytes at once
+  OB_INLINE static int64_t get_packed_size(const int64_t count, const int64_t bit_width)
+  {
+    return 0 == bit_width ? 0 : (count * bit_width + 7) / 8 + PACKED_PADDING_SIZE;
+  }
+  OB_INLINE static int64_t get_bitmap_size(const int64_t count)
+  {
+    return (count + 7) / 8;
+  }
+  // buf must be zeroed before packing, value must fit in bit_width
+  OB_INLINE static void pack(char* buf, const int64_t idx, const int64_t bit_width, const uint64_t value)
+  {
+    if (bit_width > 0) {
+      const int64_t bit_pos = idx * bit_width;
+      const int64_t shift = bit_pos & 7;
+      char* pos = buf + (bit_pos >> 3);
+      uint64_t word = 0;
+      MEMCPY(&word, pos, sizeof(word));
+      word |= value << shift;
+      MEMCPY(pos, &word, sizeof(word));
+      if (shift + bit_width > 64) {
+        pos[sizeof(word)] = static_cast<char>(static_cast<uint8_t>(pos[sizeof(word)]) | (value >> (64 - shift)));
+      }
+    }
+  }
+  OB_INLINE static uint64_t unpack(const char* buf, const int64_t idx, const int64_t bit_width)
+  {
+    uint64_t value = 0;
+    if (bit_width > 0) {
+      const int64_t bit_pos = idx * bit_width;
+      const int64_t shift = bit_pos & 7;
+      const char* pos = buf + (bit_pos >> 3);
+      MEMCPY(&value, pos, sizeof(value));
+      value >>= shift;
+      if (shift + bit_width > 64) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(pos[sizeof(value)])) << (64 - shift);
+      }
+      if (bit_width < 64) {
+        value &= (1ULL << bit_width) - 1;
+      }
+    }
+    return value;
+  }
+  OB_INLINE static void set_bit(char* bitmap, const int64_t idx)
+  {
+    bitmap[idx >> 3] = static_cast<char>(static_cast<uint8_t>(bitmap[idx >> 3]) | (1U << (idx & 7)));
+  }
+  OB_INLINE static bool test_bit(const char* bitmap, const int64_t idx)
+  {
+    return 0 != (static_cast<uint8_t>(bitmap[idx >> 3]) & (1U << (idx & 7)));
+  }
+  OB_INLINE static uint32_t read_uint32(const char* buf, const int64_t idx)
+  {
+    uint32_t value = 0;
+    MEMCPY(&value, buf + idx * sizeof(uint32_t), sizeof(value));
+    return value;
+  }
+
+  // integer like types are mapped to an order preserving uint64_t, so that the
+  // deltas to the minimum value can be bit packed
+  static bool is_integer_encodable(const common::ObObjMeta& meta);
+  static bool is_string_encodable(const common::ObObjMeta& meta);
+  static bool is_same_meta(const common::ObObjMeta& lhs, const common::ObObjMeta& rhs);
+  static uint64_t get_integer_value(const common::ObObj& cell);
+  static void set_integer_value(const common::ObObjMeta& meta, const uint64_t value, common::ObObj& cell);
+};
+
+// serialized cells of one column, cells are stored row by row in the buffer
+struct ObEncodingCells {
+  const char* buf_;
+  const uint32_t* offsets_;  // offsets of all cells in row major, with a tail offset
+  int64_t stride_;           // cell count of each row
+  int64_t column_idx_;
+  int64_t row_count_;
+
+  ObEncodingCells() : buf_(NULL), offsets_(NULL), stride_(0), column_idx_(0), row_count_(0)
+  {}
+  OB_INLINE bool is_valid() const
+  {
+    return NULL != buf_ && NULL != offsets_ && stride_ > 0 && column_idx_ >= 0 && column_idx_ < stride_ &&
+           row_count_ > 0;
+  }
+  OB_INLINE const char* get_cell(const int64_t row_idx, int64_t& len) const
+  {
+    const int64_t idx = row_idx * stride_ + column_idx_;
+    len = offsets_[idx + 1] - offsets_[idx];
+    return buf_ + offsets_[idx];
+  }
+  TO_STRING_KV(KP_(buf), KP_(offsets), K_(stride), K_(column_idx), K_(row_count));
+};
+
+// Analyze the serialized cells of one column, choose the smallest encoding and write it out.
+class ObColumnEncoder {
+public:
+  static const int64_t PREFIX_RESTART_INTERVAL = 16;
+
+public:
+  ObColumnEncoder();
+  ~ObColumnEncoder()
+  {}
+  int init(const ObEncodingCells& cells, common::ObIAllocator& allocator);
+  void reset();
+  int encode(ObSelfBufferWriter& buffer, ObColumnEncodingHeader& header) const;
+  OB_INLINE ObColumnEncodingType get_type() const
+  {
+    return type_;
+  }
+  OB_INLINE int64_t get_encoded_size() const
+  {
+    return encoded_size_;
+  }
+  TO_STRING_KV(K_(cells), K_(type), K_(encoded_size), K_(bit_width), K_(null_count), K_(dict_count), K_(run_count),
+      K_(raw_bytes), K_(dict_bytes), K_(run_bytes), K_(is_integer), K_(is_string), K_(meta), K_(base),
+      K_(prefix_bytes));
+
+private:
+  int build_dict(common::ObIAllocator& allocator);
+  int analyze_values(common::ObIAllocator& allocator);
+  void choose_encoding();
+  int encode_raw(ObSelfBufferWriter& buffer) const;
+  int encode_const(ObSelfBufferWriter& buffer) const;
+  int encode_rle(ObSelfBufferWriter& buffer) const;
+  int encode_dict(ObSelfBufferWriter& buffer) const;
+  int encode_integer(ObSelfBufferWriter& buffer) const;
+  int encode_string_prefix(ObSelfBufferWriter& buffer) const;
+  int write_null_bitmap(ObSelfBufferWriter& buffer) const;
+  int read_string(const int64_t row_idx, common::ObString& str) const;
+
+private:
+  ObEncodingCells cells_;
+  ObColumnEncodingType type_;
+  int64_t encoded_size_;
+  int64_t bit_width_;
+  int64_t null_count_;
+  int32_t* refs_;       // distinct value id of each row
+  int32_t* dict_rows_;  // first row of each distinct value
+  int64_t dict_count_;
+  int64_t run_count_;
+  int64_t raw_bytes_;
+  int64_t dict_bytes_;
+  int64_t run_bytes_;
+  bool* is_nulls_;
+  uint64_t* values_;  // mapped integer values
+  bool is_integer_;
+  bool is_string_;
+  common::ObObjMeta meta_;  // meta shared by all not null cells
+  uint64_t base_;
+  int64_t prefix_bytes_;
+  bool is_inited_;
+};
+
+// Decode one column of an encoded micro block.
+class ObColumnDecoder {
+public:
+  ObColumnDecoder();
+  ~ObColumnDecoder()
+  {}
+  int init(const char* block_buf, const ObColumnEncodingHeader& header, const int64_t row_count,
+      common::ObIAllocator& allocator);
+  void reset();
+  OB_INLINE bool is_inited() const
+  {
+    return is_inited_;
+  }
+  // decoded strings may point into the micro block or be allocated from the allocator
+  int decode(const int64_t row_idx, common::ObIAllocator& allocator, common::ObObj& cell);
+  TO_STRING_KV(K_(header), K_(row_count), K_(count), K_(meta), K_(base), K_(last_run), K_(last_row), K_(is_inited));
+
+private:
+  int read_cell(const int64_t cell_idx, common::ObObj& cell) const;
+  int decode_rle(const int64_t row_idx, common::ObObj& cell);
+  int decode_string_prefix(const int64_t row_idx, common::ObIAllocator& allocator, common::ObObj& cell);
+
+private:
+  ObColumnEncodingHeader header_;
+  const char* payload_;
+  int64_t row_count_;
+  int64_t count_;             // run count of RLE, dict count of DICT, restart count of STRING_PREFIX
+  const char* offsets_;       // cell offsets of RAW / RLE / DICT
+  const char* cells_;         // serialized cells of RAW / RLE / DICT
+  const char* run_ends_;      // RLE
+  const char* packed_;        // DICT references / INTEGER_DELTA deltas
+  const char* null_bitmap_;   // INTEGER_DELTA / STRING_PREFIX
+  const char* entries_;       // STRING_PREFIX
+  int64_t entries_len_;
+  common::ObObjMeta meta_;
+  uint64_t base_;
+  common::ObObj const_cell_;
+  int64_t last_run_;
+  // STRING_PREFIX keeps the last decoded string for sequential access
+  int64_t last_row_;
+  int64_t last_pos_;
+  char* last_buf_;
+  int64_t last_len_;
+  int64_t last_buf_size_;
+  common::ObIAllocator* allocator_;
+  bool is_inited_;
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_COLUMN_ENCODING_H_
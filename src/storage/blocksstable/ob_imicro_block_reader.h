@@ -253,6 +253,16 @@ public:
   virtual int get_multi_version_info(const int64_t row_idx, const int64_t version_column_idx,
       const int64_t sql_sequence_idx, storage::ObMultiVersionRowFlag& flag, transaction::ObTransID& trans_id,
       int64_t& version, int64_t& sql_sequence) = 0;
+  // read one stored cell of a row without materializing the whole row, used by pushdown filters
+  virtual int get_row_cell(
+      const int64_t row_idx, const int64_t store_idx, const common::ObObjMeta& col_meta, common::ObObj& cell)
+  {
+    UNUSED(row_idx);
+    UNUSED(store_idx);
+    UNUSED(col_meta);
+    UNUSED(cell);
+    return common::OB_NOT_SUPPORTED;
+  }
   int locate_rowkey(const common::ObStoreRowkey& rowkey, int64_t& row_idx);
   int locate_range(const common::ObStoreRange& range, const bool is_left_border, const bool is_right_border,
       int64_t& begin_idx, int64_t& end_idx);
@@ -12,6 +12,7 @@
 
 #include "ob_macro_block.h"
 #include "ob_store_file.h"
+#include "ob_micro_block_encoder.h"
 #include "lib/utility/ob_tracepoint.h"
 #include "share/ob_task_define.h"
 #include "storage/ob_multi_version_col_desc_generate.h"
@@ -48,8 +49,23 @@ int ObDataStoreDesc::cal_row_store_type(const share::schema::ObTableSchema& tabl
     } else {
       row_store_type_ = FLAT_ROW_STORE;
     }
+  } else if (ENCODING_ROW_STORE == table_schema.get_row_store_type() && !need_index_tree_ &&
+             !is_trans_table_id(table_schema.get_table_id()) &&
+             major_working_cluster_version_ >= CLUSTER_VERSION_316) {
+    // major merge writes encoded micro blocks only when all the stored columns can be encoded, and
+    // all the servers of the freeze can read them.
+    row_store_type_ = ENCODING_ROW_STORE;
+    ObTableSchema::const_column_iterator iter = table_schema.column_begin();
+    for (; OB_SUCC(ret) && ENCODING_ROW_STORE == row_store_type_ && iter != table_schema.column_end(); ++iter) {
+      if (OB_ISNULL(*iter)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "column schema is null", K(ret), K(table_schema));
+      } else if ((*iter)->is_column_stored_in_sstable() &&
+                 !ObMicroBlockEncoder::is_column_type_supported((*iter)->get_meta_type())) {
+        row_store_type_ = FLAT_ROW_STORE;
+      }
+    }
   } else {
-    // major merge support flat only
     row_store_type_ = FLAT_ROW_STORE;
   }
   STORAGE_LOG(DEBUG, "row store type", K(row_store_type_), K(merge_type));
@@ -179,12 +195,12 @@ int ObDataStoreDesc::init(const ObTableSchema& table_schema, const int64_t data_
     }
 
     if (OB_FAIL(ret)) {
+    } else if (is_major_ && OB_FAIL(get_major_working_cluster_version())) {
+      STORAGE_LOG(WARN, "Failed to get major working cluster version", K(ret));
     } else if (OB_FAIL(cal_row_store_type(table_schema, merge_type))) {
       STORAGE_LOG(WARN, "Failed to make the row store type", K(ret));
     } else if (OB_FAIL(table_schema.has_lob_column(has_lob_column_, true))) {
       STORAGE_LOG(WARN, "Failed to check lob column in table schema", K(ret));
-    } else if (is_major_ && OB_FAIL(get_major_working_cluster_version())) {
-      STORAGE_LOG(WARN, "Failed to get major working cluster version", K(ret));
     } else {
       ObSEArray<ObColDesc, OB_DEFAULT_SE_ARRAY_COUNT> column_list;
       if (OB_NOT_NULL(multi_version_row_info) && multi_version_row_info->is_valid()) {
@@ -225,6 +241,16 @@ int ObDataStoreDesc::init(const ObTableSchema& table_schema, const int64_t data_
           }
         }
       }
+
+      // the zone map is stored in the macro block, which can not be read by servers before 3.1.6
+      if (OB_SUCC(ret) && is_major_ && table_schema.is_zone_map_enabled() &&
+          major_working_cluster_version_ >= CLUSTER_VERSION_316 && ENCODING_ROW_STORE == row_store_type_ &&
+          !is_multi_version_minor_sstable()) {
+        const int64_t zone_map_size =
+            ObMicroBlockZoneMapWriter::get_max_reserve_size(column_types_.get_buf(), row_column_count_);
+        need_zone_map_ = zone_map_size > 0;
+        micro_block_size_limit_ -= zone_map_size;
+      }
     }
   }
   return ret;
@@ -280,6 +306,7 @@ void ObDataStoreDesc::reset()
   major_working_cluster_version_ = 0;
   iter_complement_ = false;
   is_unique_index_ = false;
+  need_zone_map_ = false;
   allocator_.reset();
 }
 
@@ -338,6 +365,7 @@ int ObDataStoreDesc::assign(const ObDataStoreDesc& desc)
   need_check_order_ = desc.need_check_order_;
   major_working_cluster_version_ = desc.major_working_cluster_version_;
   is_unique_index_ = desc.is_unique_index_;
+  need_zone_map_ = desc.need_zone_map_;
   if (OB_FAIL(file_handle_.assign(desc.file_handle_))) {
     STORAGE_LOG(WARN, "failed to assign file handle", K(ret), K(desc.file_handle_));
   }
@@ -465,6 +493,7 @@ void ObMicroBlockDesc::reset()
   column_checksums_ = NULL;
   max_merged_trans_version_ = 0;
   contain_uncommitted_row_ = false;
+  zone_map_ = NULL;
 }
 
 /**
@@ -475,6 +504,7 @@ ObMacroBlock::ObMacroBlock()
       row_reader_(NULL),
       data_(0, "MacrBlocData"),
       index_(),
+      zone_map_(),
       header_(NULL),
       column_ids_(NULL),
       column_types_(NULL),
@@ -503,7 +533,8 @@ ObMacroBlock::~ObMacroBlock()
 int ObMacroBlock::init_row_reader(const ObRowStoreType row_store_type)
 {
   int ret = OB_SUCCESS;
-  if (FLAT_ROW_STORE == row_store_type) {
+  if (FLAT_ROW_STORE == row_store_type || ENCODING_ROW_STORE == row_store_type) {
+    // endkeys of encoded micro blocks are stored in flat format
     row_reader_ = &flat_row_reader_;
   } else if (SPARSE_ROW_STORE == row_store_type) {
     row_reader_ = &sparse_row_reader_;
@@ -523,6 +554,8 @@ int ObMacroBlock::init(ObDataStoreDesc& spec)
   } else if (OB_FAIL(index_.init(spec.macro_block_size_, spec.is_multi_version_minor_sstable()))) {
     STORAGE_LOG(
         WARN, "macro block fail to ensure space for index.", K(ret), "macro_block_size", spec.macro_block_size_);
+  } else if (spec.need_zone_map_ && OB_FAIL(zone_map_.init(spec.column_types_.get_buf(), spec.row_column_count_))) {
+    STORAGE_LOG(WARN, "macro block fail to init zone map writer.", K(ret));
   } else if (OB_FAIL(reserve_header(spec))) {
     STORAGE_LOG(WARN, "macro block fail to reserve header.", K(ret));
   } else if (OB_ISNULL(pg_file_ = spec.file_handle_.get_storage_file())) {
@@ -597,7 +630,9 @@ int ObMacroBlock::write_micro_block(const ObMicroBlockDesc& micro_block_desc, in
         spec_->store_micro_block_column_checksum_ ? RECORD_HEADER_VERSION_V3 : RECORD_HEADER_VERSION_V2;
     const int64_t record_header_size =
         ObRecordHeaderV3::get_serialize_size(header_version, micro_block_desc.column_count_);
-    if (micro_block_desc.buf_size_ + entry_size + record_header_size + micro_block_desc.last_rowkey_.length() >
+    const int64_t zone_map_entry_size = zone_map_.get_entry_size(micro_block_desc.zone_map_);
+    if (micro_block_desc.buf_size_ + entry_size + record_header_size + micro_block_desc.last_rowkey_.length() +
+            zone_map_entry_size >
         get_remain_size()) {
       ret = OB_BUF_NOT_ENOUGH;
     }
@@ -618,6 +653,8 @@ int ObMacroBlock::write_micro_block(const ObMicroBlockDesc& micro_block_desc, in
           K(data_offset),
           K(micro_block_desc.can_mark_deletion_),
           K(micro_block_desc.row_count_delta_));
+    } else if (!zone_map_.is_empty() && OB_FAIL(zone_map_.add_entry(micro_block_desc.zone_map_))) {
+      STORAGE_LOG(WARN, "zone map add entry failed", K(ret), KP(micro_block_desc.zone_map_));
     } else if (OB_FAIL(write_micro_record_header(micro_block_desc))) {
       STORAGE_LOG(WARN, "fail to write micro record header", K(ret), K(micro_block_desc));
     } else {
@@ -741,6 +778,8 @@ int ObMacroBlock::merge(const ObMacroBlock& macro_block)
     ret = OB_BUF_NOT_ENOUGH;
   } else if (OB_FAIL(index_.merge(prev_data_offset, macro_block.index_))) {
     STORAGE_LOG(WARN, "current macro block index data out of index buffer.", K(ret));
+  } else if (!zone_map_.is_empty() && OB_FAIL(zone_map_.merge(macro_block.zone_map_))) {
+    STORAGE_LOG(WARN, "current macro block fail to merge zone map.", K(ret));
   } else if (OB_FAIL(data_.write(macro_block.get_micro_block_data_ptr(), macro_block.get_micro_block_data_size()))) {
     STORAGE_LOG(WARN,
         "macro block fail to writer micro block data.",
@@ -786,6 +825,7 @@ void ObMacroBlock::reset()
 {
   data_.reuse();
   index_.reset();
+  zone_map_.reset();
   header_ = NULL;
   column_ids_ = NULL;
   column_types_ = NULL;
@@ -895,11 +935,13 @@ int ObMacroBlock::build_header(const int64_t cur_macro_seq)
 int ObMacroBlock::build_index()
 {
   int ret = OB_SUCCESS;
-  if (index_.get_block_size() > data_.remain()) {
+  if (index_.get_block_size() + zone_map_.get_block_size() > data_.remain()) {
     STORAGE_LOG(WARN,
         "micro block index size is larger than macro data remain size.",
         "index_size",
         index_.get_block_size(),
+        "zone_map_size",
+        zone_map_.get_block_size(),
         "data_remain_size",
         data_.remain());
     ret = OB_BUF_NOT_ENOUGH;
@@ -944,6 +986,11 @@ int ObMacroBlock::build_index()
           index_.get_delta().length());
     }
   }
+  if (OB_SUCC(ret) && !zone_map_.is_empty()) {
+    if (OB_FAIL(zone_map_.build(data_))) {
+      STORAGE_LOG(WARN, "macro block fail to build zone map", K(ret), K_(zone_map));
+    }
+  }
   return ret;
 }
 
@@ -1000,6 +1047,9 @@ int ObMacroBlock::build_macro_meta(ObFullMacroBlockMeta& full_meta)
     mbi.progressive_merge_round_ = spec_->progressive_merge_round_;
     mbi.max_merged_trans_version_ = max_merged_trans_version_;
     mbi.contain_uncommitted_row_ = contain_uncommitted_row_;
+    // zone map is the last part of macro block
+    mbi.micro_block_zone_map_offset_ =
+        zone_map_.is_empty() ? 0 : header_->occupy_size_ - static_cast<int32_t>(zone_map_.get_block_size());
 
     schema.column_number_ = static_cast<int16_t>(header_->column_count_);
     schema.rowkey_column_number_ = static_cast<int16_t>(header_->rowkey_column_count_);
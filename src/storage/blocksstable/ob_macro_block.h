@@ -16,6 +16,7 @@
 #include "lib/compress/ob_compressor.h"
 #include "storage/ob_multi_version_col_desc_generate.h"
 #include "ob_micro_block_index_writer.h"
+#include "ob_micro_block_zone_map.h"
 #include "ob_block_sstable_struct.h"
 #include "storage/ob_tenant_file_struct.h"
 #include "ob_block_mark_deletion_maker.h"
@@ -76,6 +77,8 @@ struct ObDataStoreDesc {
   int64_t major_working_cluster_version_;
   bool iter_complement_;
   bool is_unique_index_;
+  // record min/max of columns for each micro block, only for encoded major sstable of ZONE_MAP table
+  bool need_zone_map_;
   
   ObDataStoreDesc()
   {
@@ -104,7 +107,8 @@ struct ObDataStoreDesc {
       K_(store_micro_block_column_checksum), K_(snapshot_version), K_(need_calc_physical_checksum), K_(need_index_tree),
       K_(need_prebuild_bloomfilter), K_(bloomfilter_rowkey_prefix), KP_(rowkey_helper), "column_types",
       common::ObArrayWrap<common::ObObjMeta>(column_types_.get_buf(), row_column_count_), K_(pg_key), K_(file_handle),
-      K_(need_check_order), K_(need_index_tree), K_(major_working_cluster_version), K_(iter_complement), K_(is_unique_index));
+      K_(need_check_order), K_(need_index_tree), K_(major_working_cluster_version), K_(iter_complement), K_(is_unique_index),
+      K_(need_zone_map));
 
 private:
   int cal_row_store_type(const share::schema::ObTableSchema& table_schema, const storage::ObMergeType merge_type);
@@ -143,6 +147,7 @@ struct ObMicroBlockDesc {
   int64_t* column_checksums_;
   int64_t max_merged_trans_version_;
   bool contain_uncommitted_row_;
+  const ObMicroBlockZoneMap* zone_map_;  // NULL if micro block is reused
 
   ObMicroBlockDesc()
   {
@@ -154,7 +159,7 @@ struct ObMicroBlockDesc {
   // last_rowkey is byte stream, don't print it
   TO_STRING_KV(K_(last_rowkey), KP_(buf), K_(buf_size), K_(data_size), K_(row_count), K_(column_count),
       K_(row_count_delta), K_(can_mark_deletion), KP_(column_checksums), K_(max_merged_trans_version),
-      K_(contain_uncommitted_row));
+      K_(contain_uncommitted_row), KP_(zone_map));
 };
 
 class ObMacroBlock {
@@ -173,7 +178,7 @@ public:
   }
   OB_INLINE int64_t get_data_size() const
   {
-    return data_.length() + index_.get_block_size();
+    return data_.length() + index_.get_block_size() + zone_map_.get_block_size();
   }
   OB_INLINE int32_t get_row_count() const
   {
@@ -219,7 +224,7 @@ private:
 private:
   OB_INLINE int64_t get_remain_size() const
   {
-    return data_.remain() - index_.get_block_size();
+    return data_.remain() - index_.get_block_size() - zone_map_.get_reserve_size();
   }
   OB_INLINE const char* get_micro_block_data_ptr() const
   {
@@ -231,7 +236,8 @@ private:
   }
   OB_INLINE int64_t get_raw_data_size() const
   {
-    return get_micro_block_data_size() + index_.get_block_size() - ObMicroBlockIndexWriter::INDEX_ENTRY_SIZE;
+    return get_micro_block_data_size() + index_.get_block_size() - ObMicroBlockIndexWriter::INDEX_ENTRY_SIZE +
+           zone_map_.get_entries_size();
   }
 
 private:
@@ -241,6 +247,7 @@ private:
   ObSparseRowReader sparse_row_reader_;
   ObSelfBufferWriter data_;  // macro header + data blocks;
   ObMicroBlockIndexWriter index_;
+  ObMicroBlockZoneMapWriter zone_map_;
   ObSSTableMacroBlockHeader* header_;  // macro header store in head of data_;
   uint16_t* column_ids_;
   common::ObObjMeta* column_types_;
@@ -414,6 +414,11 @@ int ObSSTableMacroBlockChecker::check_micro_data(
       read_out_type = SPARSE_ROW_STORE;  // write row type is sparse row
       column_map_ptr = nullptr;          // make reader read full sparse row
       request_count = meta.meta_->column_number_;
+    } else if (ENCODING_ROW_STORE == meta.meta_->row_store_type_) {
+      reader = static_cast<ObIMicroBlockReader*>(&decoder_);
+      read_out_type = FLAT_ROW_STORE;
+      column_map_ptr = &column_map_;
+      request_count = column_map_.get_request_count();
     } else {
       ret = OB_NOT_SUPPORTED;
       STORAGE_LOG(WARN, "Unexpeceted row store type", K(ret), K(meta.meta_->row_store_type_));
@@ -15,6 +15,7 @@
 #include "storage/blocksstable/ob_macro_block_reader.h"
 #include "storage/blocksstable/ob_micro_block_reader.h"
 #include "storage/blocksstable/ob_sparse_micro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
 
 namespace oceanbase {
 namespace blocksstable {
@@ -63,6 +64,7 @@ private:
 private:
   ObMicroBlockReader flat_reader_;
   ObSparseMicroBlockReader sparse_reader_;
+  ObMicroBlockDecoder decoder_;
   common::ObArenaAllocator allocator_;
   ObMacroBlockReader macro_reader_;
   ObColumnMap column_map_;
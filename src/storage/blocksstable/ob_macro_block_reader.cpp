@@ -364,7 +364,8 @@ int ObSSTableDataBlockReader::dump_sstable_micro_header(const char* micro_block_
   const ObRowStoreType row_store_type = (ObRowStoreType)block_header_->row_store_type_;
   int64_t row_cnt = 0;
 
-  if (ObRowStoreType::FLAT_ROW_STORE == row_store_type || ObRowStoreType::SPARSE_ROW_STORE == row_store_type) {
+  if (ObRowStoreType::FLAT_ROW_STORE == row_store_type || ObRowStoreType::SPARSE_ROW_STORE == row_store_type ||
+      ObRowStoreType::ENCODING_ROW_STORE == row_store_type) {
     const ObMicroBlockHeader* micro_block_header = reinterpret_cast<const ObMicroBlockHeader*>(micro_block_buf);
     ObSSTablePrinter::print_micro_header(micro_block_header);
     row_cnt = micro_block_header->row_count_;
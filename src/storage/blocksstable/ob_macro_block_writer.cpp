@@ -39,8 +39,10 @@ ObMacroBlockWriter::ObMacroBlockWriter()
       compressor_(),
       micro_writer_(&flat_writer_),
       flat_writer_(),
+      encoder_(),
       row_writer_(),
       flat_reader_(),
+      decoder_(),
       sstable_index_writer_(NULL),
       task_index_writer_(NULL),
       current_index_(0),
@@ -61,6 +63,7 @@ ObMacroBlockWriter::ObMacroBlockWriter()
       obj_buf_(NULL),
       checker_obj_buf_(NULL),
       micro_rowkey_hashs_(),
+      micro_zone_map_(),
       rowkey_helper_(nullptr)
 {
   // macro_blocks_
@@ -89,7 +92,9 @@ void ObMacroBlockWriter::reset()
   // block_size_spec_
   micro_writer_ = &flat_writer_;
   flat_writer_.reuse();
+  encoder_.reset();
   flat_reader_.reset();
+  decoder_.reset();
   sstable_index_writer_ = NULL;
   task_index_writer_ = NULL;
   macro_blocks_[0].reset();
@@ -119,7 +124,9 @@ void ObMacroBlockWriter::reset()
   }
   check_flat_reader_.reset();
   check_sparse_reader_.reset();
+  check_decoder_.reset();
   micro_rowkey_hashs_.reset();
+  micro_zone_map_.reset();
   rowkey_helper_ = nullptr;
   allocator_.reuse();
 }
@@ -200,7 +207,16 @@ int ObMacroBlockWriter::open(ObDataStoreDesc& data_store_desc, const ObMacroData
       } else if (OB_FAIL(build_column_map(index_store_desc_, index_column_map_))) {
         STORAGE_LOG(WARN, "failed to build index column map", K(data_store_desc), K(ret));
       }
-      if (OB_SUCC(ret)) {
+      if (OB_FAIL(ret)) {
+      } else if (ENCODING_ROW_STORE == data_store_desc_->row_store_type_) {
+        if (OB_FAIL(encoder_.init(data_store_desc_->micro_block_size_limit_,
+                data_store_desc_->rowkey_column_count_,
+                data_store_desc_->row_column_count_))) {
+          STORAGE_LOG(WARN, "Fail to init micro block encoder, ", K(ret));
+        } else {
+          micro_writer_ = &encoder_;
+        }
+      } else {
         if (OB_FAIL(flat_writer_.init(data_store_desc_->micro_block_size_limit_,
                 data_store_desc_->rowkey_column_count_,
                 data_store_desc_->row_column_count_))) {
@@ -231,6 +247,13 @@ int ObMacroBlockWriter::open(ObDataStoreDesc& data_store_desc, const ObMacroData
         }
       }
 
+      if (OB_SUCC(ret) && data_store_desc_->need_zone_map_) {
+        if (OB_FAIL(micro_zone_map_.init(
+                data_store_desc_->column_types_.get_buf(), data_store_desc_->row_column_count_))) {
+          STORAGE_LOG(WARN, "Fail to init micro block zone map", K(ret));
+        }
+      }
+
       if (OB_SUCC(ret) && data_store_desc_->need_prebuild_bloomfilter_ && data_store_desc_->bloomfilter_size_ > 0) {
         if (OB_FAIL(open_bf_cache_writer(*data_store_desc_))) {
           STORAGE_LOG(WARN, "Failed to open bloomfilter cache writer, ", K(ret));
@@ -306,6 +329,8 @@ int ObMacroBlockWriter::append_row(const ObStoreRow& row, const int64_t split_si
           STORAGE_LOG(ERROR, "Fail to append row to micro block, ", K(ret), K(row));
         } else if (data_store_desc_->need_calc_column_checksum_ && OB_FAIL(add_row_checksum(row_to_append->row_val_))) {
           STORAGE_LOG(WARN, "fail to add column checksum", K(ret));
+        } else if (data_store_desc_->need_zone_map_ && OB_FAIL(micro_zone_map_.update(row_to_append->row_val_))) {
+          STORAGE_LOG(WARN, "fail to update micro block zone map", K(ret));
         }
         if (OB_SUCC(ret) && data_store_desc_->need_prebuild_bloomfilter_) {
           const ObStoreRowkey rowkey(row_to_append->row_val_.cells_, data_store_desc_->bloomfilter_rowkey_prefix_);
@@ -329,6 +354,8 @@ int ObMacroBlockWriter::append_row(const ObStoreRow& row, const int64_t split_si
       }
       if (data_store_desc_->need_calc_column_checksum_ && OB_FAIL(add_row_checksum(row_to_append->row_val_))) {
         STORAGE_LOG(WARN, "fail to add column checksum", K(ret));
+      } else if (data_store_desc_->need_zone_map_ && OB_FAIL(micro_zone_map_.update(row_to_append->row_val_))) {
+        STORAGE_LOG(WARN, "fail to update micro block zone map", K(ret));
       } else if (micro_writer_->get_block_size() >= split_size) {
         if (OB_FAIL(build_micro_block())) {
           STORAGE_LOG(WARN, "Fail to build micro block, ", K(ret));
@@ -934,6 +961,7 @@ int ObMacroBlockWriter::build_micro_block(const bool force_split)
     micro_block_desc.can_mark_deletion_ = mark_deletion;
     micro_block_desc.column_checksums_ =
         data_store_desc_->need_calc_column_checksum_ ? curr_micro_column_checksum_ : NULL;
+    micro_block_desc.zone_map_ = data_store_desc_->need_zone_map_ ? &micro_zone_map_ : NULL;
     if (data_store_desc_->is_multi_version_minor_sstable()) {
       micro_block_desc.max_merged_trans_version_ = micro_writer_->get_max_merged_trans_version();
       micro_block_desc.contain_uncommitted_row_ = micro_writer_->is_contain_uncommitted_row();
@@ -942,6 +970,9 @@ int ObMacroBlockWriter::build_micro_block(const bool force_split)
       STORAGE_LOG(WARN, "build_micro_block failed", K(micro_block_desc), K(force_split), K(ret));
     } else {
       micro_writer_->reuse();
+      if (data_store_desc_->need_zone_map_) {
+        micro_zone_map_.reuse();
+      }
       if (data_store_desc_->need_prebuild_bloomfilter_ && micro_rowkey_hashs_.count() > 0) {
         micro_rowkey_hashs_.reuse();
       }
@@ -1325,8 +1356,11 @@ int ObMacroBlockWriter::check_micro_block_need_merge(const ObMicroBlock& micro_b
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN, "invalid micro_block", K(micro_block), K(ret));
   } else {
-    if (micro_writer_->get_row_count() <= 0 &&
-        micro_block.origin_data_size_ > data_store_desc_->micro_block_size_ / 2) {
+    if (micro_block.row_store_type_ != data_store_desc_->row_store_type_) {
+      // the micro block is rewritten in the row store type of the new sstable
+      need_merge = true;
+    } else if (micro_writer_->get_row_count() <= 0 &&
+               micro_block.origin_data_size_ > data_store_desc_->micro_block_size_ / 2) {
       need_merge = false;
     } else if (micro_writer_->get_block_size() > data_store_desc_->micro_block_size_ / 2 &&
                micro_block.origin_data_size_ > data_store_desc_->micro_block_size_ / 2) {
@@ -1524,6 +1558,10 @@ OB_INLINE ObIMicroBlockReader* ObMacroBlockWriter::get_micro_block_reader(const
       reader = &sparse_reader_;
       break;
     }
+    case ENCODING_ROW_STORE: {
+      reader = &decoder_;
+      break;
+    }
     default:
       STORAGE_LOG(WARN, "invalid store type", K(row_store_type));
       break;
@@ -1587,6 +1625,10 @@ int ObMacroBlockWriter::prepare_micro_block_reader(
       micro_reader = static_cast<ObIMicroBlockReader*>(&check_sparse_reader_);
       read_out_type = SPARSE_ROW_STORE;  // read row type is sparse row
       column_map_ptr = nullptr;          // make reader read full sparse row
+    } else if (ENCODING_ROW_STORE == data_store_desc_->row_store_type_) {
+      micro_reader = static_cast<ObIMicroBlockReader*>(&check_decoder_);
+      read_out_type = FLAT_ROW_STORE;
+      column_map_ptr = &column_map_;
     } else {
       ret = OB_NOT_SUPPORTED;
       STORAGE_LOG(WARN, "Unexpeceted row store type", K(ret), K(data_store_desc_->row_store_type_));
@@ -15,6 +15,8 @@
 #include "ob_micro_block_writer.h"
 #include "ob_micro_block_index_writer.h"
 #include "ob_micro_block_reader.h"
+#include "ob_micro_block_encoder.h"
+#include "ob_micro_block_decoder.h"
 #include "lib/compress/ob_compressor.h"
 #include "lib/io/ob_io_manager.h"
 #include "lib/container/ob_array_wrap.h"
@@ -178,10 +180,12 @@ private:
   IndexMicroBlockDescList task_top_block_descs_;
   ObIMicroBlockWriter* micro_writer_;
   ObMicroBlockWriter flat_writer_;
+  ObMicroBlockEncoder encoder_;
   ObRowWriter row_writer_;
   char rowkey_buf_[common::OB_MAX_ROW_KEY_LENGTH];
   ObMicroBlockReader flat_reader_;
   ObSparseMicroBlockReader sparse_reader_;
+  ObMicroBlockDecoder decoder_;
   ObMacroBlockWriter* sstable_index_writer_;
   ObMacroBlockWriter* task_index_writer_;
   ObMacroBlock macro_blocks_[2];
@@ -210,7 +214,9 @@ private:
   void* checker_obj_buf_;  // for calc or varify checksum, can not use same buf of data row
   ObMicroBlockReader check_flat_reader_; 
   ObSparseMicroBlockReader check_sparse_reader_;
+  ObMicroBlockDecoder check_decoder_;
   common::ObArray<uint32_t> micro_rowkey_hashs_;
+  ObMicroBlockZoneMap micro_zone_map_;  // zone map of current micro block
   storage::ObSSTableRowkeyHelper* rowkey_helper_;
   ObSSTableMacroBlockChecker macro_block_checker_;
   common::SpinRWLock lock_;
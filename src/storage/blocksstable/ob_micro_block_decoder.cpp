@@ -0,0 +1,528 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_micro_block_decoder.h"
+#include "common/rowkey/ob_rowkey.h"
+#include "storage/ob_i_store.h"
+#include "ob_column_map.h"
+#include "ob_row_reader.h"
+#include "ob_micro_block_encoder.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace storage;
+namespace blocksstable {
+
+/***************               ObMicroBlockDecoder              ****************/
+ObMicroBlockDecoder::ObMicroBlockDecoder()
+    : header_(NULL),
+      block_buf_(NULL),
+      column_headers_(NULL),
+      decoders_(NULL),
+      column_count_(0),
+      row_header_(),
+      allocator_(ObModIds::OB_ENCODER_ALLOCATOR)
+{}
+
+ObMicroBlockDecoder::~ObMicroBlockDecoder()
+{
+  reset();
+}
+
+void ObMicroBlockDecoder::reset()
+{
+  ObIMicroBlockReader::reset();
+  if (NULL != decoders_) {
+    for (int64_t i = 0; i <= column_count_; ++i) {
+      decoders_[i].~ObColumnDecoder();
+    }
+  }
+  header_ = NULL;
+  block_buf_ = NULL;
+  column_headers_ = NULL;
+  decoders_ = NULL;
+  column_count_ = 0;
+  allocator_.reuse();
+}
+
+int ObMicroBlockDecoder::init(
+    const ObMicroBlockData& block_data, const ObColumnMap* column_map, const ObRowStoreType out_type)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    reset();
+  }
+  if (OB_UNLIKELY(NULL == column_map || !column_map->is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "column_map is invalid", K(ret), K(column_map));
+  } else if (OB_UNLIKELY(FLAT_ROW_STORE != out_type)) {
+    ret = OB_NOT_SUPPORTED;
+    STORAGE_LOG(WARN, "encoded micro block only supports flat output", K(ret), K(out_type));
+  } else if (OB_FAIL(base_init(block_data))) {
+    STORAGE_LOG(WARN, "fail to init, ", K(ret));
+  } else if (OB_UNLIKELY(column_map->get_store_count() > column_count_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "column map does not match micro block", K(ret), K_(column_count), K(*column_map));
+    reset();
+  } else {
+    column_map_ = column_map;
+    output_row_type_ = out_type;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::init(const ObMicroBlockData& block_data)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    reset();
+  }
+  if (OB_FAIL(base_init(block_data))) {
+    STORAGE_LOG(WARN, "fail to init, ", K(ret));
+  } else {
+    output_row_type_ = FLAT_ROW_STORE;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::base_init(const ObMicroBlockData& block_data)
+{
+  int ret = OB_SUCCESS;
+  void* buf = NULL;
+  if (OB_UNLIKELY(!block_data.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "argument is invalid", K(ret), K(block_data));
+  } else {
+    header_ = reinterpret_cast<const ObMicroBlockHeader*>(block_data.get_buf());
+    block_buf_ = block_data.get_buf();
+    const int64_t header_array_size = sizeof(ObColumnEncodingHeader) * (header_->column_count_ + 1);
+    if (OB_UNLIKELY(!header_->is_valid() || header_->column_count_ <= 0 || header_->row_index_offset_ <= 0 ||
+                    header_->row_index_offset_ + header_array_size > block_data.get_buf_size())) {
+      ret = OB_INVALID_DATA;
+      STORAGE_LOG(WARN, "invalid encoded micro block", K(ret), K(*header_), K(block_data));
+    } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObColumnDecoder) * (header_->column_count_ + 1)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      STORAGE_LOG(WARN, "fail to allocate column decoders", K(ret), K(header_->column_count_));
+    } else {
+      column_count_ = header_->column_count_;
+      column_headers_ = reinterpret_cast<const ObColumnEncodingHeader*>(block_buf_ + header_->row_index_offset_);
+      decoders_ = static_cast<ObColumnDecoder*>(buf);
+      for (int64_t i = 0; i <= column_count_; ++i) {
+        new (decoders_ + i) ObColumnDecoder();
+      }
+      begin_ = 0;
+      end_ = header_->row_count_;
+    }
+    if (OB_FAIL(ret)) {
+      header_ = NULL;
+      block_buf_ = NULL;
+    }
+  }
+  return ret;
+}
+
+OB_INLINE int ObMicroBlockDecoder::decode_cell(const int64_t row_idx, const int64_t store_idx, ObObj& cell)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(store_idx < 0 || store_idx > column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid store column index", K(ret), K(store_idx), K_(column_count));
+  } else {
+    ObColumnDecoder& decoder = decoders_[store_idx];
+    if (OB_UNLIKELY(!decoder.is_inited()) &&
+        OB_FAIL(decoder.init(block_buf_, column_headers_[store_idx], header_->row_count_, allocator_))) {
+      STORAGE_LOG(WARN, "fail to init column decoder", K(ret), K(store_idx), K(column_headers_[store_idx]));
+    } else if (OB_FAIL(decoder.decode(row_idx, allocator_, cell))) {
+      STORAGE_LOG(WARN, "fail to decode cell", K(ret), K(row_idx), K(store_idx), K(decoder));
+    }
+  }
+  return ret;
+}
+
+OB_INLINE int ObMicroBlockDecoder::decode_cell(
+    const int64_t row_idx, const int64_t store_idx, const ObObjMeta& col_meta, ObObj& cell)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(decode_cell(row_idx, store_idx, cell))) {
+  } else if (!cell.is_null() && col_meta != cell.get_meta()) {
+    if (OB_FAIL(ObIRowReader::cast_obj(col_meta, allocator_, cell))) {
+      STORAGE_LOG(WARN, "fail to cast obj", K(ret), K(col_meta), K(cell));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row_flag(const int64_t index, ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  ObObj flag_cell;
+  int64_t flag_value = 0;
+  if (OB_FAIL(decode_cell(index, column_count_, flag_cell))) {
+    STORAGE_LOG(WARN, "fail to decode row flag", K(ret), K(index));
+  } else if (OB_FAIL(flag_cell.get_int(flag_value))) {
+    STORAGE_LOG(WARN, "invalid row flag cell", K(ret), K(index), K(flag_cell));
+  } else {
+    ObMicroBlockEncoder::decode_row_flag(flag_value, row);
+    row.is_sparse_row_ = false;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row(const int64_t index, ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(get_row_impl(index, row))) {
+    STORAGE_LOG(WARN, "get row failed", K(ret), K(index));
+  } else if (0 == index) {
+    row.row_pos_flag_.set_micro_first(true);
+  } else {
+    LOG_DEBUG("get row", K(row));
+  }
+  return ret;
+}
+
+OB_INLINE int ObMicroBlockDecoder::get_row_impl(const int64_t index, ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "should init reader first, ", K(ret));
+  } else if (OB_ISNULL(column_map_)) {
+    ret = OB_ERR_SYS;
+    LOG_WARN("no column map specified", K(row));
+  } else if (OB_UNLIKELY(index < 0 || index >= end() || !row.row_val_.is_valid() ||
+                         column_map_->get_request_count() > row.row_val_.count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(index), K(row.row_val_));
+  } else if (OB_FAIL(get_row_flag(index, row))) {
+    STORAGE_LOG(WARN, "fail to get row flag", K(ret), K(index));
+  } else {
+    const int64_t request_count = column_map_->get_request_count();
+    const ObColumnIndexItem* column_idx = column_map_->get_column_indexs();
+    row.row_val_.count_ = request_count;
+    for (int64_t i = 0; OB_SUCC(ret) && i < request_count; ++i) {
+      ObObj& cell = row.row_val_.cells_[i];
+      if (column_idx[i].store_index_ < 0) {
+        cell.set_nop_value();
+      } else if (OB_FAIL(decode_cell(index, column_idx[i].store_index_, column_idx[i].request_column_type_, cell))) {
+        STORAGE_LOG(WARN, "fail to decode cell", K(ret), K(index), K(i), K(column_idx[i]));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_rows(const int64_t begin_index, const int64_t end_index, const int64_t row_capacity,
+    storage::ObStoreRow* rows, int64_t& row_count)
+{
+  int ret = OB_SUCCESS;
+  row_count = 0;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY((begin_index == end_index) ||
+                         (begin_index < end_index && !(begin_index >= begin() && end_index <= end())) ||
+                         (begin_index > end_index && !(end_index >= begin() - 1 && begin_index <= end() - 1)) ||
+                         NULL == rows || row_capacity <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN,
+        "invalid argument",
+        K(ret),
+        K(begin_index),
+        K(end_index),
+        K(begin()),
+        K(end()),
+        KP(rows),
+        K(row_capacity));
+  } else if (OB_ISNULL(column_map_)) {
+    ret = OB_ERR_SYS;
+    LOG_WARN("no column map specified", K(ret));
+  } else {
+    int64_t row_pos = 0;
+    const int64_t step = begin_index < end_index ? 1 : -1;
+    for (int64_t index = begin_index; OB_SUCC(ret) && index != end_index && row_pos < row_capacity; index += step) {
+      if (OB_FAIL(get_row_impl(index, rows[row_pos]))) {
+        STORAGE_LOG(WARN, "fail to get row", K(ret), K(row_pos), K(index));
+      } else {
+        ++row_pos;
+      }
+    }
+
+    if (OB_SUCC(ret)) {
+      row_count = row_pos;
+      rows[0].row_pos_flag_.reset();
+      if (0 == begin_index) {
+        rows[0].row_pos_flag_.set_micro_first(true);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_full_row(const int64_t index, const ObObjMeta* column_types, ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "should init reader first, ", K(ret));
+  } else if (OB_UNLIKELY(index < 0 || index >= end() || NULL == column_types || !row.row_val_.is_valid() ||
+                         row.row_val_.count_ > column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(index), KP(column_types), K(row.row_val_), K_(column_count));
+  } else if (OB_FAIL(get_row_flag(index, row))) {
+    STORAGE_LOG(WARN, "fail to get row flag", K(ret), K(index));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < row.row_val_.count_; ++i) {
+      if (OB_FAIL(decode_cell(index, i, column_types[i], row.row_val_.cells_[i]))) {
+        STORAGE_LOG(WARN, "fail to decode cell", K(ret), K(index), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::compare_rowkey(const int64_t row_idx, const ObStoreRowkey& key, int32_t& cmp_result)
+{
+  int ret = OB_SUCCESS;
+  ObObj cell;
+  cmp_result = 0;
+  const ObObj* key_cells = key.get_obj_ptr();
+  for (int64_t i = 0; OB_SUCC(ret) && 0 == cmp_result && i < key.get_obj_cnt(); ++i) {
+    if (OB_FAIL(decode_cell(row_idx, i, cell))) {
+      STORAGE_LOG(WARN, "fail to decode rowkey cell", K(ret), K(row_idx), K(i));
+    } else {
+      cmp_result = cell.compare(key_cells[i], CS_TYPE_INVALID);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::find_bound(const ObStoreRowkey& key, const bool lower_bound, const int64_t begin_idx,
+    const int64_t end_idx, int64_t& row_idx, bool& equal)
+{
+  int ret = OB_SUCCESS;
+  equal = false;
+  row_idx = ObIMicroBlockReader::INVALID_ROW_INDEX;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init");
+  } else if (OB_UNLIKELY(!key.is_valid() || key.get_obj_cnt() > column_count_ || begin_idx < begin() ||
+                         end_idx > end())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key), K(begin_idx), K(begin()), K(end_idx), K(end()), K_(column_count));
+  } else {
+    // first row in [begin_idx, end_idx) which is not less (lower bound) or greater (upper bound) than key,
+    // equal is set once any compared row equals to key, the same as the flat reader
+    int64_t low = begin_idx;
+    int64_t high = end_idx;
+    int32_t cmp_result = 0;
+    while (OB_SUCC(ret) && low < high) {
+      const int64_t middle = low + ((high - low) >> 1);
+      if (OB_FAIL(compare_rowkey(middle, key, cmp_result))) {
+        LOG_WARN("fail to compare rowkey", K(ret), K(middle), K(key));
+      } else {
+        if (0 == cmp_result) {
+          equal = true;
+        }
+        if (lower_bound ? cmp_result < 0 : cmp_result <= 0) {
+          low = middle + 1;
+        } else {
+          high = middle;
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      row_idx = low;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row_count(int64_t& row_count)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "not init", K(ret));
+  } else {
+    row_count = header_->row_count_;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row_header(const int64_t row_idx, const ObRowHeader*& row_header)
+{
+  int ret = OB_SUCCESS;
+  ObStoreRow row;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "reader not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < begin() || row_idx >= end())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "id is NULL, ", K(ret), K(row_idx));
+  } else if (OB_FAIL(get_row_flag(row_idx, row))) {
+    STORAGE_LOG(WARN, "fail to get row flag", K(ret), K(row_idx));
+  } else {
+    row_header_.set_version(ObRowHeader::RHV_NO_TRANS_ID);
+    row_header_.set_row_flag(static_cast<int8_t>(row.flag_));
+    row_header_.set_row_dml(row.get_dml_val());
+    row_header_.set_row_type_flag(static_cast<int8_t>(row.row_type_flag_.flag_));
+    row_header_.set_column_count(static_cast<int16_t>(column_count_));
+    row_header = &row_header_;
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_multi_version_info(const int64_t row_idx, const int64_t version_column_idx,
+    const int64_t sql_sequence_idx, storage::ObMultiVersionRowFlag& flag, transaction::ObTransID& trans_id,
+    int64_t& trans_version, int64_t& sql_sequence)
+{
+  int ret = OB_SUCCESS;
+  ObStoreRow row;
+  ObObj cell;
+  UNUSED(trans_id);  // uncommitted rows are never encoded
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < begin() || row_idx >= end() || version_column_idx < 0 ||
+                         version_column_idx >= column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_idx), K(version_column_idx), K_(column_count));
+  } else if (OB_FAIL(get_row_flag(row_idx, row))) {
+    LOG_WARN("fail to get row flag", K(ret), K(row_idx));
+  } else {
+    flag = row.row_type_flag_;
+    if (!flag.is_uncommitted_row()) {
+      sql_sequence = 0;
+      if (OB_FAIL(decode_cell(row_idx, version_column_idx, cell))) {
+        LOG_WARN("fail to read version column", K(ret));
+      } else if (OB_FAIL(cell.get_int(trans_version))) {
+        LOG_WARN("fail to convert version cell to int", K(ret), K(cell));
+      } else {
+        trans_version = -trans_version;
+      }
+    } else {
+      trans_version = INT64_MAX;
+      if (sql_sequence_idx < 0) {
+        sql_sequence = 0;
+      } else if (OB_FAIL(decode_cell(row_idx, sql_sequence_idx, cell))) {
+        LOG_WARN("fail to read sql sequence column", K(ret));
+      } else if (OB_FAIL(cell.get_int(sql_sequence))) {
+        LOG_ERROR("fail to convert sql sequence cell to int", K(ret), K(cell));
+      } else {
+        sql_sequence = -sql_sequence;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDecoder::get_row_cell(
+    const int64_t row_idx, const int64_t store_idx, const common::ObObjMeta& col_meta, common::ObObj& cell)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < begin() || row_idx >= end() || store_idx < 0 || store_idx >= column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_idx), K(store_idx), K_(column_count));
+  } else if (OB_FAIL(decode_cell(row_idx, store_idx, col_meta, cell))) {
+    LOG_WARN("fail to decode cell", K(ret), K(row_idx), K(store_idx));
+  }
+  return ret;
+}
+
+/***************               ObEncodeBlockGetReader              ****************/
+ObEncodeBlockGetReader::ObEncodeBlockGetReader() : decoder_()
+{}
+
+ObEncodeBlockGetReader::~ObEncodeBlockGetReader()
+{}
+
+int ObEncodeBlockGetReader::get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+    const common::ObStoreRowkey& rowkey, const ObColumnMap& column_map, const ObFullMacroBlockMeta& macro_meta,
+    const storage::ObSSTableRowkeyHelper* rowkey_helper, storage::ObStoreRow& row)
+{
+  UNUSED(tenant_id);
+  UNUSED(rowkey_helper);
+  int ret = OB_SUCCESS;
+  int64_t row_idx = ObIMicroBlockReader::INVALID_ROW_INDEX;
+  if (OB_FAIL(decoder_.init(block_data, &column_map))) {
+    STORAGE_LOG(WARN, "failed to init decoder, ", K(ret), K(block_data));
+  } else if (OB_FAIL(decoder_.locate_rowkey(rowkey, row_idx))) {
+    if (OB_BEYOND_THE_RANGE != ret) {
+      STORAGE_LOG(WARN, "failed to locate row, ", K(ret), K(rowkey));
+    }
+  } else if (OB_FAIL(decoder_.get_row_impl(row_idx, row))) {
+    STORAGE_LOG(WARN, "Fail to read row, ", K(ret), K(rowkey), K(macro_meta));
+  }
+  return ret;
+}
+
+int ObEncodeBlockGetReader::get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+    const common::ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta,
+    const storage::ObSSTableRowkeyHelper* rowkey_helper, storage::ObStoreRow& row)
+{
+  UNUSED(tenant_id);
+  UNUSED(rowkey_helper);
+  int ret = OB_SUCCESS;
+  int64_t row_idx = ObIMicroBlockReader::INVALID_ROW_INDEX;
+  if (OB_FAIL(decoder_.init(block_data))) {
+    STORAGE_LOG(WARN, "failed to init decoder, ", K(ret), K(block_data));
+  } else if (OB_FAIL(decoder_.locate_rowkey(rowkey, row_idx))) {
+    if (OB_BEYOND_THE_RANGE != ret) {
+      STORAGE_LOG(WARN, "failed to locate row, ", K(ret), K(rowkey), K(macro_meta));
+    }
+  } else {
+    row.row_val_.count_ = macro_meta.meta_->column_number_;
+    if (OB_FAIL(decoder_.get_full_row(row_idx, macro_meta.schema_->column_type_array_, row))) {
+      STORAGE_LOG(WARN, "failed to read full row, ", K(ret), K(rowkey), K(row_idx), K(macro_meta));
+    }
+  }
+  return ret;
+}
+
+int ObEncodeBlockGetReader::exist_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+    const common::ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta,
+    const storage::ObSSTableRowkeyHelper* rowkey_helper, bool& exist, bool& found)
+{
+  UNUSED(tenant_id);
+  UNUSED(rowkey_helper);
+  int ret = OB_SUCCESS;
+  int64_t row_idx = ObIMicroBlockReader::INVALID_ROW_INDEX;
+  ObStoreRow row;
+  exist = false;
+  found = false;
+  if (OB_FAIL(decoder_.init(block_data))) {
+    STORAGE_LOG(WARN, "failed to init decoder, ", K(ret), K(block_data));
+  } else if (OB_FAIL(decoder_.locate_rowkey(rowkey, row_idx))) {
+    if (OB_BEYOND_THE_RANGE == ret) {
+      ret = OB_SUCCESS;
+    } else {
+      STORAGE_LOG(WARN, "failed to locate row, ", K(ret), K(rowkey), K(macro_meta));
+    }
+  } else if (OB_FAIL(decoder_.get_row_flag(row_idx, row))) {
+    STORAGE_LOG(WARN, "failed to get row flag, ", K(ret), K(rowkey), K(row_idx));
+  } else {
+    exist = ObActionFlag::OP_DEL_ROW != row.flag_;
+    found = true;
+  }
+  return ret;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DECODER_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DECODER_H_
+#include "lib/allocator/page_arena.h"
+#include "ob_block_sstable_struct.h"
+#include "ob_imicro_block_reader.h"
+#include "ob_column_encoding.h"
+
+namespace oceanbase {
+namespace storage {
+class ObStoreRow;
+}
+namespace blocksstable {
+class ObColumnMap;
+
+// Reader of the micro block built by ObMicroBlockEncoder, columns are decoded on demand,
+// so filters and rowkey comparisons only touch the columns they need.
+class ObMicroBlockDecoder : public ObIMicroBlockReader {
+  friend class ObEncodeBlockGetReader;
+
+public:
+  ObMicroBlockDecoder();
+  virtual ~ObMicroBlockDecoder();
+  virtual int init(const ObMicroBlockData& block_data, const ObColumnMap* column_map,
+      const common::ObRowStoreType out_type = common::FLAT_ROW_STORE) override;
+  // init without column map, only rowkey locating and full row reading are allowed
+  int init(const ObMicroBlockData& block_data);
+  virtual void reset() override;
+  virtual int get_row(const int64_t index, storage::ObStoreRow& row) override;
+  virtual int get_rows(const int64_t begin_index, const int64_t end_index, const int64_t row_capacity,
+      storage::ObStoreRow* rows, int64_t& row_count) override;
+  virtual int get_row_count(int64_t& row_count) override;
+  virtual int get_row_header(const int64_t row_idx, const ObRowHeader*& row_header) override;
+  virtual int get_multi_version_info(const int64_t row_idx, const int64_t version_column_idx,
+      const int64_t sql_sequence_idx, storage::ObMultiVersionRowFlag& flag, transaction::ObTransID& trans_id,
+      int64_t& version, int64_t& sql_sequence) override;
+  virtual int get_row_cell(const int64_t row_idx, const int64_t store_idx, const common::ObObjMeta& col_meta,
+      common::ObObj& cell) override;
+  // read all store columns of a row in the types of the macro block schema
+  int get_full_row(const int64_t index, const common::ObObjMeta* column_types, storage::ObStoreRow& row);
+  int get_row_flag(const int64_t index, storage::ObStoreRow& row);
+
+protected:
+  virtual int find_bound(const common::ObStoreRowkey& key, const bool lower_bound, const int64_t begin_idx,
+      const int64_t end_idx, int64_t& row_idx, bool& equal) override;
+
+private:
+  int base_init(const ObMicroBlockData& block_data);
+  int get_row_impl(const int64_t index, storage::ObStoreRow& row);
+  int decode_cell(const int64_t row_idx, const int64_t store_idx, common::ObObj& cell);
+  int decode_cell(const int64_t row_idx, const int64_t store_idx, const common::ObObjMeta& col_meta,
+      common::ObObj& cell);
+  int compare_rowkey(const int64_t row_idx, const common::ObStoreRowkey& key, int32_t& cmp_result);
+
+private:
+  const ObMicroBlockHeader* header_;
+  const char* block_buf_;
+  const ObColumnEncodingHeader* column_headers_;
+  ObColumnDecoder* decoders_;  // column_count_ + 1, the last one decodes the hidden row flag column
+  int64_t column_count_;
+  ObRowHeader row_header_;
+  common::ObArenaAllocator allocator_;
+};
+
+class ObEncodeBlockGetReader : public ObIMicroBlockGetReader {
+public:
+  ObEncodeBlockGetReader();
+  virtual ~ObEncodeBlockGetReader();
+  virtual int get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data, const common::ObStoreRowkey& rowkey,
+      const ObColumnMap& column_map, const ObFullMacroBlockMeta& macro_meta,
+      const storage::ObSSTableRowkeyHelper* rowkey_helper, storage::ObStoreRow& row) override;
+  virtual int get_row(const uint64_t tenant_id, const ObMicroBlockData& block_data, const common::ObStoreRowkey& rowkey,
+      const ObFullMacroBlockMeta& macro_meta, const storage::ObSSTableRowkeyHelper* rowkey_helper,
+      storage::ObStoreRow& row) override;
+  virtual int exist_row(const uint64_t tenant_id, const ObMicroBlockData& block_data,
+      const common::ObStoreRowkey& rowkey, const ObFullMacroBlockMeta& macro_meta,
+      const storage::ObSSTableRowkeyHelper* rowkey_helper, bool& exist, bool& found) override;
+
+private:
+  ObMicroBlockDecoder decoder_;
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+#endif
@@ -0,0 +1,447 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_micro_block_encoder.h"
+#include "common/row/ob_row.h"
+#include "storage/ob_i_store.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace storage;
+namespace blocksstable {
+/**
+ * -------------------------------------------------------------------ObEncodingColumnStat-------------------------------------------------------------------
+ */
+void ObEncodingColumnStat::reset()
+{
+  raw_bytes_ = 0;
+  run_count_ = 0;
+  run_bytes_ = 0;
+  null_count_ = 0;
+  meta_.reset();
+  min_value_ = UINT64_MAX;
+  max_value_ = 0;
+  has_meta_ = false;
+  is_integer_ = false;
+}
+
+void ObEncodingColumnStat::update(const ObObj& cell, const int64_t cell_len, const bool is_new_run)
+{
+  raw_bytes_ += cell_len;
+  if (is_new_run) {
+    ++run_count_;
+    run_bytes_ += cell_len;
+  }
+  if (cell.is_null()) {
+    ++null_count_;
+  } else {
+    if (!has_meta_) {
+      has_meta_ = true;
+      meta_ = cell.get_meta();
+      is_integer_ = ObEncodingUtil::is_integer_encodable(meta_);
+    } else if (is_integer_ && !ObEncodingUtil::is_same_meta(meta_, cell.get_meta())) {
+      is_integer_ = false;
+    }
+    if (is_integer_) {
+      const uint64_t value = ObEncodingUtil::get_integer_value(cell);
+      min_value_ = std::min(min_value_, value);
+      max_value_ = std::max(max_value_, value);
+    }
+  }
+}
+
+int64_t ObEncodingColumnStat::estimate_size(const int64_t row_count) const
+{
+  int64_t size = (row_count + 1) * sizeof(uint32_t) + raw_bytes_;
+  if (1 == run_count_) {
+    size = run_bytes_;
+  } else {
+    size = std::min(size, static_cast<int64_t>(sizeof(uint32_t) + (2 * run_count_ + 1) * sizeof(uint32_t)) + run_bytes_);
+    if (is_integer_ && has_meta_) {
+      const int64_t bitmap_size = null_count_ > 0 ? ObEncodingUtil::get_bitmap_size(row_count) : 0;
+      const int64_t bit_width = ObEncodingUtil::get_bit_width(max_value_ - min_value_);
+      size = std::min(size,
+          meta_.get_serialize_size() + static_cast<int64_t>(sizeof(uint64_t)) + bitmap_size +
+              ObEncodingUtil::get_packed_size(row_count, bit_width));
+    }
+  }
+  return size;
+}
+
+/**
+ * -------------------------------------------------------------------ObMicroBlockEncoder-------------------------------------------------------------------
+ */
+ObMicroBlockEncoder::ObMicroBlockEncoder()
+    : micro_block_size_limit_(0),
+      rowkey_column_count_(0),
+      column_count_(0),
+      row_count_(0),
+      estimate_size_(0),
+      stats_(NULL),
+      tmp_stats_(NULL),
+      column_headers_(NULL),
+      rowkey_cells_(NULL),
+      cell_buffer_(0, "MicrBlocEncoder", false),
+      offset_buffer_(0, "MicrBlocEncoder", false),
+      data_buffer_(0, "MicrBlocEncoder", false),
+      allocator_(ObModIds::OB_ENCODER_ALLOCATOR),
+      encode_allocator_(ObModIds::OB_ENCODER_ALLOCATOR),
+      column_encoder_(),
+      row_writer_(),
+      last_rowkey_length_(0),
+      is_inited_(false)
+{}
+
+ObMicroBlockEncoder::~ObMicroBlockEncoder()
+{}
+
+bool ObMicroBlockEncoder::is_column_type_supported(const ObObjMeta& meta)
+{
+  const ObObjTypeClass tc = meta.get_type_class();
+  return ObNullTC != tc && ObExtendTC != tc && ObUnknownTC != tc && ObTextTC != tc && ObLobTC != tc &&
+         ObJsonTC != tc && tc < ObMaxTC;
+}
+
+int64_t ObMicroBlockEncoder::encode_row_flag(const ObStoreRow& row)
+{
+  return static_cast<int64_t>(static_cast<uint8_t>(row.flag_)) |
+         (static_cast<int64_t>(static_cast<uint8_t>(row.get_dml_val())) << 8) |
+         (static_cast<int64_t>(row.row_type_flag_.flag_) << 16);
+}
+
+void ObMicroBlockEncoder::decode_row_flag(const int64_t value, ObStoreRow& row)
+{
+  row.flag_ = static_cast<int8_t>(value & 0xFF);
+  row.set_dml_val(static_cast<int8_t>((value >> 8) & 0xFF));
+  row.row_type_flag_.flag_ = static_cast<uint8_t>((value >> 16) & 0xFF);
+}
+
+int ObMicroBlockEncoder::init(
+    const int64_t micro_block_size_limit, const int64_t rowkey_column_count, const int64_t column_count)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    reset();
+  }
+  if (OB_UNLIKELY(micro_block_size_limit <= 0 || rowkey_column_count <= 0 || column_count < rowkey_column_count)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN,
+        "invalid micro block encoder input argument.",
+        K(ret),
+        K(micro_block_size_limit),
+        K(rowkey_column_count),
+        K(column_count));
+  } else if (OB_ISNULL(stats_ = static_cast<ObEncodingColumnStat*>(
+                           allocator_.alloc(sizeof(ObEncodingColumnStat) * (column_count + 1)))) ||
+             OB_ISNULL(tmp_stats_ = static_cast<ObEncodingColumnStat*>(
+                           allocator_.alloc(sizeof(ObEncodingColumnStat) * (column_count + 1)))) ||
+             OB_ISNULL(column_headers_ = static_cast<ObColumnEncodingHeader*>(
+                           allocator_.alloc(sizeof(ObColumnEncodingHeader) * (column_count + 1)))) ||
+             OB_ISNULL(rowkey_cells_ = static_cast<ObObj*>(allocator_.alloc(sizeof(ObObj) * rowkey_column_count)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to allocate memory", K(ret), K(column_count), K(rowkey_column_count));
+  } else if (OB_FAIL(cell_buffer_.ensure_space(DEFAULT_CELL_BUFFER_SIZE))) {
+    STORAGE_LOG(WARN, "cell buffer fail to ensure space.", K(ret));
+  } else if (OB_FAIL(offset_buffer_.ensure_space(DEFAULT_CELL_BUFFER_SIZE))) {
+    STORAGE_LOG(WARN, "offset buffer fail to ensure space.", K(ret));
+  } else {
+    for (int64_t i = 0; i <= column_count; ++i) {
+      new (stats_ + i) ObEncodingColumnStat();
+      new (tmp_stats_ + i) ObEncodingColumnStat();
+    }
+    for (int64_t i = 0; i < rowkey_column_count; ++i) {
+      new (rowkey_cells_ + i) ObObj();
+    }
+    micro_block_size_limit_ = micro_block_size_limit;
+    rowkey_column_count_ = rowkey_column_count;
+    column_count_ = column_count;
+    row_count_ = 0;
+    estimate_size_ = sizeof(ObMicroBlockHeader) + (column_count + 1) * sizeof(ObColumnEncodingHeader);
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::check_row(const ObStoreRow& row) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!row.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "row was invalid", K(ret), K(row));
+  } else if (OB_UNLIKELY(row.is_sparse_row_ || row.row_val_.count_ != column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN,
+        "append row column count is not consistent with init column count.",
+        K(ret),
+        K_(column_count),
+        K(row.row_val_.count_),
+        K(row.is_sparse_row_));
+  } else if (OB_UNLIKELY(row.row_type_flag_.is_uncommitted_row() || NULL != row.trans_id_ptr_)) {
+    ret = OB_NOT_SUPPORTED;
+    STORAGE_LOG(WARN, "encoded micro block does not support uncommitted row", K(ret), K(row));
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::append_cell(const ObObj& cell)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(offset_buffer_.write(static_cast<uint32_t>(cell_buffer_.length())))) {
+    STORAGE_LOG(WARN, "offset buffer fail to write offset.", K(ret));
+  } else if (OB_FAIL(cell_buffer_.write(cell))) {
+    STORAGE_LOG(WARN, "cell buffer fail to write cell.", K(ret), K(cell));
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::estimate_row(const ObStoreRow& row, const ObObj& flag_cell, int64_t& estimate_size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t stride = column_count_ + 1;
+  const uint32_t* offsets = reinterpret_cast<const uint32_t*>(offset_buffer_.data());
+  const uint32_t* cur_offsets = offsets + row_count_ * stride;
+  estimate_size = sizeof(ObMicroBlockHeader) + stride * sizeof(ObColumnEncodingHeader);
+  for (int64_t i = 0; i < stride; ++i) {
+    const int64_t cell_end = i + 1 < stride ? cur_offsets[i + 1] : cell_buffer_.length();
+    const int64_t cell_len = cell_end - cur_offsets[i];
+    bool is_new_run = true;
+    if (row_count_ > 0) {
+      // prev_offsets[i + 1] is the offset of the first cell of current row for the last column
+      const uint32_t* prev_offsets = cur_offsets - stride;
+      const int64_t prev_len = prev_offsets[i + 1] - prev_offsets[i];
+      is_new_run = prev_len != cell_len ||
+                   0 != MEMCMP(cell_buffer_.data() + prev_offsets[i], cell_buffer_.data() + cur_offsets[i], cell_len);
+    }
+    tmp_stats_[i] = stats_[i];
+    tmp_stats_[i].update(i < column_count_ ? row.row_val_.cells_[i] : flag_cell, cell_len, is_new_run);
+    estimate_size += tmp_stats_[i].estimate_size(row_count_ + 1);
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::append_row(const ObStoreRow& row)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cell_pos = cell_buffer_.length();
+  const int64_t offset_pos = offset_buffer_.length();
+  int64_t estimate_size = 0;
+  ObObj flag_cell;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "should init encoder before append row", K(ret));
+  } else if (OB_FAIL(check_row(row))) {
+    STORAGE_LOG(WARN, "fail to check row", K(ret), K(row));
+  } else if (row_count_ >= MAX_MICRO_BLOCK_ROW_COUNT) {
+    ret = OB_BUF_NOT_ENOUGH;
+  } else {
+    flag_cell.set_int(encode_row_flag(row));
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_count_; ++i) {
+      if (OB_FAIL(append_cell(row.row_val_.cells_[i]))) {
+        STORAGE_LOG(WARN, "fail to append cell", K(ret), K(i));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(append_cell(flag_cell))) {
+      STORAGE_LOG(WARN, "fail to append row flag cell", K(ret), K(flag_cell));
+    } else if (OB_FAIL(estimate_row(row, flag_cell, estimate_size))) {
+      STORAGE_LOG(WARN, "fail to estimate row", K(ret));
+    } else if (estimate_size > micro_block_size_limit_ || cell_buffer_.length() > 2 * micro_block_size_limit_) {
+      STORAGE_LOG(DEBUG,
+          "micro block exceed limit",
+          K(estimate_size),
+          K_(row_count),
+          K(cell_buffer_.length()),
+          K_(micro_block_size_limit));
+      ret = OB_BUF_NOT_ENOUGH;
+    } else {
+      ObEncodingColumnStat* stats = stats_;
+      stats_ = tmp_stats_;
+      tmp_stats_ = stats;
+      estimate_size_ = estimate_size;
+      ++row_count_;
+      cal_delta(row);
+      if (need_cal_row_checksum()) {
+        micro_block_checksum_ = cal_row_checksum(row, micro_block_checksum_);
+      }
+    }
+    if (OB_FAIL(ret)) {
+      // roll back cells of the row
+      cell_buffer_.set_pos(cell_pos);
+      offset_buffer_.set_pos(offset_pos);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::build_last_rowkey()
+{
+  int ret = OB_SUCCESS;
+  const int64_t stride = column_count_ + 1;
+  const uint32_t* offsets = reinterpret_cast<const uint32_t*>(offset_buffer_.data());
+  const uint32_t* last_offsets = offsets + (row_count_ - 1) * stride;
+  ObNewRow rowkey;
+  for (int64_t i = 0; OB_SUCC(ret) && i < rowkey_column_count_; ++i) {
+    int64_t pos = 0;
+    if (OB_FAIL(rowkey_cells_[i].deserialize(
+            cell_buffer_.data() + last_offsets[i], last_offsets[i + 1] - last_offsets[i], pos))) {
+      STORAGE_LOG(WARN, "fail to deserialize rowkey cell", K(ret), K(i));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    rowkey.cells_ = rowkey_cells_;
+    rowkey.count_ = rowkey_column_count_;
+    last_rowkey_length_ = 0;
+    // last rowkey is kept in flat format, it is persisted in micro block index
+    if (OB_FAIL(row_writer_.write(
+            rowkey, last_rowkey_buf_, OB_MAX_ROW_KEY_LENGTH, FLAT_ROW_STORE, last_rowkey_length_))) {
+      STORAGE_LOG(WARN, "fail to write last rowkey", K(ret), K(rowkey));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncoder::build_block(char*& buf, int64_t& size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t stride = column_count_ + 1;
+  ObColumnEncodingHeader* headers = column_headers_;
+  ObMicroBlockHeader* header = NULL;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "should init encoder before build block", K(ret));
+  } else if (OB_UNLIKELY(row_count_ <= 0)) {
+    ret = OB_INNER_STAT_ERROR;
+    STORAGE_LOG(WARN, "micro block encoder is empty", K(ret));
+  } else if (OB_FAIL(build_last_rowkey())) {
+    STORAGE_LOG(WARN, "fail to build last rowkey", K(ret));
+  } else if (OB_FAIL(offset_buffer_.write(static_cast<uint32_t>(cell_buffer_.length())))) {
+    STORAGE_LOG(WARN, "offset buffer fail to write tail offset.", K(ret));
+  } else {
+    data_buffer_.reuse();
+    if (OB_FAIL(data_buffer_.ensure_space(estimate_size_))) {
+      STORAGE_LOG(WARN, "data buffer fail to ensure space.", K(ret), K_(estimate_size));
+    } else if (OB_FAIL(data_buffer_.advance_zero(sizeof(ObMicroBlockHeader)))) {
+      STORAGE_LOG(WARN, "data buffer fail to reserve header.", K(ret));
+    }
+    ObEncodingCells cells;
+    cells.buf_ = cell_buffer_.data();
+    cells.offsets_ = reinterpret_cast<const uint32_t*>(offset_buffer_.data());
+    cells.stride_ = stride;
+    cells.row_count_ = row_count_;
+    for (int64_t i = 0; OB_SUCC(ret) && i < stride; ++i) {
+      cells.column_idx_ = i;
+      encode_allocator_.reuse();
+      if (OB_FAIL(column_encoder_.init(cells, encode_allocator_))) {
+        STORAGE_LOG(WARN, "fail to init column encoder", K(ret), K(i));
+      } else if (OB_FAIL(column_encoder_.encode(data_buffer_, headers[i]))) {
+        STORAGE_LOG(WARN, "fail to encode column", K(ret), K(i), K_(column_encoder));
+      } else {
+        STORAGE_LOG(DEBUG,
+            "encode column",
+            K(i),
+            "encoding",
+            get_column_encoding_name(column_encoder_.get_type()),
+            K(headers[i]));
+      }
+    }
+    column_encoder_.reset();
+    if (OB_SUCC(ret)) {
+      const int64_t header_array_offset = data_buffer_.length();
+      if (OB_FAIL(data_buffer_.write(reinterpret_cast<const char*>(headers), sizeof(ObColumnEncodingHeader) * stride))) {
+        STORAGE_LOG(WARN, "data buffer fail to write column headers.", K(ret));
+      } else {
+        header = reinterpret_cast<ObMicroBlockHeader*>(data_buffer_.data());
+        header->header_size_ = static_cast<int32_t>(sizeof(ObMicroBlockHeader));
+        header->version_ = MICRO_BLOCK_HEADER_VERSION;
+        header->magic_ = MICRO_BLOCK_HEADER_MAGIC;
+        header->attr_ = 0;
+        header->column_count_ = static_cast<int32_t>(column_count_);
+        header->row_index_offset_ = static_cast<int32_t>(header_array_offset);
+        header->row_count_ = static_cast<int32_t>(row_count_);
+        buf = data_buffer_.data();
+        size = data_buffer_.length();
+      }
+    }
+    // drop the tail offset, more rows are not allowed before reuse but keep the buffer consistent
+    (void)offset_buffer_.backward(sizeof(uint32_t));
+  }
+  return ret;
+}
+
+int64_t ObMicroBlockEncoder::get_block_size() const
+{
+  return estimate_size_;
+}
+
+int64_t ObMicroBlockEncoder::get_row_count() const
+{
+  return row_count_;
+}
+
+int64_t ObMicroBlockEncoder::get_data_size() const
+{
+  return data_buffer_.length();
+}
+
+int64_t ObMicroBlockEncoder::get_column_count() const
+{
+  return column_count_;
+}
+
+ObString ObMicroBlockEncoder::get_last_rowkey() const
+{
+  return ObString(0, static_cast<ObString::obstr_size_t>(last_rowkey_length_), last_rowkey_buf_);
+}
+
+void ObMicroBlockEncoder::reuse()
+{
+  ObIMicroBlockWriter::reuse();
+  if (is_inited_) {
+    for (int64_t i = 0; i <= column_count_; ++i) {
+      stats_[i].reset();
+    }
+    row_count_ = 0;
+    estimate_size_ = sizeof(ObMicroBlockHeader) + (column_count_ + 1) * sizeof(ObColumnEncodingHeader);
+    cell_buffer_.reuse();
+    offset_buffer_.reuse();
+    data_buffer_.reuse();
+    encode_allocator_.reuse();
+    last_rowkey_length_ = 0;
+  }
+}
+
+void ObMicroBlockEncoder::reset()
+{
+  ObIMicroBlockWriter::reuse();
+  micro_block_size_limit_ = 0;
+  rowkey_column_count_ = 0;
+  column_count_ = 0;
+  row_count_ = 0;
+  estimate_size_ = 0;
+  stats_ = NULL;
+  tmp_stats_ = NULL;
+  column_headers_ = NULL;
+  rowkey_cells_ = NULL;
+  cell_buffer_.reuse();
+  offset_buffer_.reuse();
+  data_buffer_.reuse();
+  column_encoder_.reset();
+  encode_allocator_.reset();
+  allocator_.reset();
+  last_rowkey_length_ = 0;
+  is_inited_ = false;
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODER_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODER_H_
+#include "lib/allocator/page_arena.h"
+#include "ob_block_sstable_struct.h"
+#include "ob_data_buffer.h"
+#include "ob_row_writer.h"
+#include "ob_imicro_block_writer.h"
+#include "ob_column_encoding.h"
+
+namespace oceanbase {
+namespace storage {
+class ObStoreRow;
+}
+namespace blocksstable {
+// running statistics of one column, used to estimate the encoded size while appending rows,
+// the estimation is never smaller than the size of the encoding chosen by ObColumnEncoder
+struct ObEncodingColumnStat {
+  int64_t raw_bytes_;
+  int64_t run_count_;
+  int64_t run_bytes_;
+  int64_t null_count_;
+  common::ObObjMeta meta_;
+  uint64_t min_value_;
+  uint64_t max_value_;
+  bool has_meta_;
+  bool is_integer_;
+
+  ObEncodingColumnStat()
+  {
+    reset();
+  }
+  void reset();
+  void update(const common::ObObj& cell, const int64_t cell_len, const bool is_new_run);
+  int64_t estimate_size(const int64_t row_count) const;
+  TO_STRING_KV(K_(raw_bytes), K_(run_count), K_(run_bytes), K_(null_count), K_(meta), K_(min_value), K_(max_value),
+      K_(has_meta), K_(is_integer));
+};
+
+// memory
+//  |- cell buffer
+//        |- serialized cells of each row, the last cell of a row is the hidden row flag
+//  |- offset buffer
+//        |- offset of each cell in cell buffer
+//
+// build output
+//  |- ObMicroBlockHeader
+//  |- column payloads, each column is encoded with the smallest one of ObColumnEncodingType
+//  |- ObColumnEncodingHeader array (column_count + 1), starts at row_index_offset_
+class ObMicroBlockEncoder : public ObIMicroBlockWriter {
+public:
+  static const int64_t MAX_MICRO_BLOCK_ROW_COUNT = 4096;
+  static const int64_t DEFAULT_CELL_BUFFER_SIZE = 64 * 1024;
+
+public:
+  ObMicroBlockEncoder();
+  virtual ~ObMicroBlockEncoder();
+  int init(const int64_t micro_block_size_limit, const int64_t rowkey_column_count, const int64_t column_count);
+  virtual int append_row(const storage::ObStoreRow& row) override;
+  virtual int build_block(char*& buf, int64_t& size) override;
+  virtual void reuse() override;
+
+  virtual int64_t get_block_size() const override;
+  virtual int64_t get_row_count() const override;
+  virtual int64_t get_data_size() const override;
+  virtual int64_t get_column_count() const override;
+  virtual common::ObString get_last_rowkey() const override;
+  void reset();
+
+  static bool is_column_type_supported(const common::ObObjMeta& meta);
+  // row flag, dml and multi version flag are packed into the hidden column
+  static int64_t encode_row_flag(const storage::ObStoreRow& row);
+  static void decode_row_flag(const int64_t value, storage::ObStoreRow& row);
+
+private:
+  int check_row(const storage::ObStoreRow& row) const;
+  int append_cell(const common::ObObj& cell);
+  int estimate_row(const storage::ObStoreRow& row, const common::ObObj& flag_cell, int64_t& estimate_size);
+  int build_last_rowkey();
+
+private:
+  int64_t micro_block_size_limit_;
+  int64_t rowkey_column_count_;
+  int64_t column_count_;
+  int64_t row_count_;
+  int64_t estimate_size_;
+  ObEncodingColumnStat* stats_;
+  ObEncodingColumnStat* tmp_stats_;
+  ObColumnEncodingHeader* column_headers_;
+  common::ObObj* rowkey_cells_;
+  ObSelfBufferWriter cell_buffer_;
+  ObSelfBufferWriter offset_buffer_;
+  ObSelfBufferWriter data_buffer_;
+  common::ObArenaAllocator allocator_;
+  common::ObArenaAllocator encode_allocator_;
+  ObColumnEncoder column_encoder_;
+  ObRowWriter row_writer_;
+  int64_t last_rowkey_length_;
+  char last_rowkey_buf_[common::OB_MAX_ROW_KEY_LENGTH];
+  bool is_inited_;
+};
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
+#endif
@@ -54,11 +54,13 @@ ObMicroBlockIndexMgr::ObMicroBlockIndexMgr()
       extra_space_base_(NULL),
       mark_deletion_array_(NULL),
       delta_array_(NULL),
+      zone_map_buf_(NULL),
       micro_index_size_(0),
       node_array_size_(0),
       extra_space_size_(0),
       mark_deletion_flags_size_(0),
       delta_size_(0),
+      zone_map_size_(0),
       micro_count_(0),
       rowkey_column_count_(0),
       schema_rowkey_col_cnt_(0),
@@ -85,6 +87,7 @@ int ObMicroBlockIndexMgr::init(
     const int64_t micro_index_size = (block_count + 1) * sizeof(ObMicroBlockIndexMgr::MemMicroIndexItem);
     const int64_t mark_deletion_flags_size = macro_meta.get_micro_block_mark_deletion_size();
     const int64_t delta_size = macro_meta.get_micro_block_delta_size();
+    const int64_t zone_map_size = macro_meta.get_micro_block_zone_map_size();
     const int64_t data_offset = macro_meta.micro_block_data_offset_;
     if ((0 == mark_deletion_flags_size && 0 < delta_size) || (0 == delta_size && 0 < mark_deletion_flags_size)) {
       ret = OB_INVALID_ARGUMENT;
@@ -105,11 +108,14 @@ int ObMicroBlockIndexMgr::init(
       delta_array_ = 0 == delta_size ? NULL
                                      : reinterpret_cast<int32_t*>(reinterpret_cast<char*>(extra_space_base_) +
                                                                   extra_space_size + mark_deletion_flags_size);
+      zone_map_buf_ = 0 == zone_map_size ? NULL
+                                         : extra_space_base_ + extra_space_size + mark_deletion_flags_size + delta_size;
       micro_index_size_ = static_cast<int32_t>(micro_index_size);
       node_array_size_ = static_cast<int32_t>(node_array_size);
       extra_space_size_ = static_cast<int32_t>(extra_space_size);
       mark_deletion_flags_size_ = static_cast<int32_t>(mark_deletion_flags_size);
       delta_size_ = static_cast<int32_t>(delta_size);
+      zone_map_size_ = static_cast<int32_t>(zone_map_size);
       micro_count_ = static_cast<int32_t>(block_count);
       rowkey_column_count_ = static_cast<int32_t>(macro_meta.rowkey_column_number_);
       schema_rowkey_col_cnt_ = static_cast<int32_t>(meta.schema_->schema_rowkey_col_cnt_);
@@ -233,7 +239,7 @@ int ObMicroBlockIndexMgr::search_blocks(const int64_t micro_block_index, ObIArra
 int64_t ObMicroBlockIndexMgr::size() const
 {
   return sizeof(ObMicroBlockIndexMgr) + micro_index_size_ + node_array_size_ + extra_space_size_ +
-         mark_deletion_flags_size_ + delta_size_;
+         mark_deletion_flags_size_ + delta_size_ + zone_map_size_;
 }
 
 int ObMicroBlockIndexMgr::deep_copy(char* buf, const int64_t buf_len, common::ObIKVCacheValue*& value) const
@@ -289,6 +295,18 @@ int ObMicroBlockIndexMgr::deep_copy(char* buf, const int64_t buf_len, common::Ob
       }
     }
 
+    if (OB_SUCC(ret)) {
+      if (NULL != zone_map_buf_) {
+        MEMCPY(buf + pos, zone_map_buf_, zone_map_size_);
+        mgr->zone_map_buf_ = buf + pos;
+        mgr->zone_map_size_ = zone_map_size_;
+        pos += zone_map_size_;
+      } else {
+        mgr->zone_map_buf_ = NULL;
+        mgr->zone_map_size_ = 0;
+      }
+    }
+
     if (OB_SUCC(ret)) {
       mgr->micro_count_ = micro_count_;
       mgr->rowkey_column_count_ = rowkey_column_count_;
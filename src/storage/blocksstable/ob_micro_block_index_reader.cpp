@@ -23,6 +23,8 @@ ObMicroBlockIndexReader::ObMicroBlockIndexReader()
       endkey_stream_(nullptr),
       mark_deletion_stream_(nullptr),
       delta_array_(nullptr),
+      zone_map_stream_(nullptr),
+      zone_map_size_(0),
       block_count_(0),
       row_key_column_cnt_(0),
       data_base_offset_(0),
@@ -39,6 +41,8 @@ void ObMicroBlockIndexReader::reset()
   micro_indexes_ = nullptr;
   endkey_stream_ = nullptr;
   mark_deletion_stream_ = nullptr;
+  zone_map_stream_ = nullptr;
+  zone_map_size_ = 0;
   block_count_ = 0;
   row_key_column_cnt_ = 0;
   data_base_offset_ = 0;
@@ -65,6 +69,10 @@ int ObMicroBlockIndexReader::init(const ObFullMacroBlockMeta& meta, const char*
         meta.meta_->get_micro_block_delta_size(),
         meta.meta_->micro_block_data_offset_,
         (ObRowStoreType)meta.meta_->row_store_type_);
+    if (OB_SUCC(ret) && meta.meta_->get_micro_block_zone_map_size() > 0) {
+      zone_map_stream_ = index_buf + meta.meta_->micro_block_zone_map_offset_ - meta.meta_->micro_block_index_offset_;
+      zone_map_size_ = meta.meta_->get_micro_block_zone_map_size();
+    }
   }
 
   return ret;
@@ -99,7 +107,8 @@ int ObMicroBlockIndexReader::init(
 int ObMicroBlockIndexReader::init_row_reader(const ObRowStoreType row_store_type)
 {
   int ret = OB_SUCCESS;
-  if (FLAT_ROW_STORE == row_store_type) {
+  if (FLAT_ROW_STORE == row_store_type || ENCODING_ROW_STORE == row_store_type) {
+    // endkeys of encoded micro blocks are stored in flat format
     row_reader_ = &flat_row_reader_;
   } else if (SPARSE_ROW_STORE == row_store_type) {
     row_reader_ = &sparse_row_reader_;
@@ -211,6 +220,23 @@ int ObMicroBlockIndexReader::get_all_deltas(int32_t* delta_array)
   return ret;
 }
 
+int ObMicroBlockIndexReader::get_zone_map(char* zone_map_buf)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "ObMicroBlockIndexReader has not been inited", K(ret));
+  } else if (OB_ISNULL(zone_map_buf)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), KP(zone_map_buf));
+  } else if (OB_ISNULL(zone_map_stream_)) {
+    // macro block without zone map
+  } else {
+    MEMCPY(zone_map_buf, zone_map_stream_, zone_map_size_);
+  }
+  return ret;
+}
+
 int ObMicroBlockIndexReader::get_end_key(const uint64_t index, ObObj* objs)
 {
   int ret = OB_SUCCESS;
@@ -151,6 +151,11 @@ public:
   {
     return nullptr == delta_array_ ? 0 : sizeof(int32_t) * block_count_;
   }
+  int get_zone_map(char* zone_map_buf);
+  inline int64_t get_zone_map_size() const
+  {
+    return nullptr == zone_map_stream_ ? 0 : zone_map_size_;
+  }
 
 private:
   int init(const char* index_buf, const common::ObObjMeta* column_type_array, const int32_t row_key_column_cnt,
@@ -211,6 +216,8 @@ private:
   const char* endkey_stream_;               // address of the endkey stream
   const char* mark_deletion_stream_;        // address of the mark deletion stream
   const int32_t* delta_array_;
+  const char* zone_map_stream_;  // address of the micro block zone map
+  int32_t zone_map_size_;
   int32_t block_count_;  // the count of the micro blocks
   int32_t row_key_column_cnt_;
   int32_t data_base_offset_;
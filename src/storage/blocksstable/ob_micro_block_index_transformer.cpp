@@ -497,6 +497,26 @@ int ObMicroBlockIndexTransformer::fill_block_index_mgr(char* buffer, int64_t siz
         }
       }
     }
+
+    // zone map
+    if (OB_SUCC(ret)) {
+      if (index_reader_.get_zone_map_size() > 0) {
+        if (pos + index_reader_.get_zone_map_size() > size) {
+          ret = OB_BUF_NOT_ENOUGH;
+          STORAGE_LOG(WARN,
+              "buffer is not enough for zone map",
+              K(ret),
+              K(pos),
+              K(size),
+              "zone map size",
+              index_reader_.get_zone_map_size());
+        } else if (OB_FAIL(index_reader_.get_zone_map(buffer + pos))) {
+          STORAGE_LOG(WARN, "failed to get zone map", K(ret));
+        } else {
+          pos += index_reader_.get_zone_map_size();
+        }
+      }
+    }
   }
   return ret;
 }
@@ -505,7 +525,8 @@ int64_t ObMicroBlockIndexTransformer::get_transformer_size() const
 {
   return sizeof(ObMicroBlockIndexMgr) + (block_count_ + 1) * sizeof(ObMicroBlockIndex) +
          node_array_.get_node_array_size() + node_array_.get_extra_space_size() +
-         index_reader_.get_mark_deletion_flags_size() + index_reader_.get_delta_size();
+         index_reader_.get_mark_deletion_flags_size() + index_reader_.get_delta_size() +
+         index_reader_.get_zone_map_size();
 }
 
 }  // end namespace blocksstable
@@ -869,5 +869,31 @@ int ObMicroBlockReader::get_multi_version_info(const int64_t row_idx, const int6
   return ret;
 }
 
+int ObMicroBlockReader::get_row_cell(
+    const int64_t row_idx, const int64_t store_idx, const common::ObObjMeta& col_meta, common::ObObj& cell)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(row_idx < begin() || row_idx >= end() || store_idx < 0 ||
+                         store_idx >= column_map_->get_store_count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_idx), K(store_idx), K(column_map_->get_store_count()));
+  } else if (OB_ISNULL(reader_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "row reader is null", K(ret), K(reader_));
+  } else {
+    reader_->reset();
+    if (OB_FAIL(reader_->setup_row(
+            data_begin_, index_data_[row_idx + 1], index_data_[row_idx], column_map_->get_store_count()))) {
+      LOG_WARN("fail to setup row", K(ret), K(row_idx), K(index_data_[row_idx + 1]), K(index_data_[row_idx]));
+    } else if (OB_FAIL(reader_->read_column(col_meta, allocator_, store_idx, cell))) {
+      LOG_WARN("fail to read column", K(ret), K(row_idx), K(store_idx));
+    }
+  }
+  return ret;
+}
+
 }  // end namespace blocksstable
 }  // end namespace oceanbase
@@ -115,6 +115,8 @@ public:
   virtual int get_multi_version_info(const int64_t row_idx, const int64_t version_column_idx,
       const int64_t sql_sequence_idx, storage::ObMultiVersionRowFlag& flag, transaction::ObTransID& trans_id,
       int64_t& version, int64_t& sql_sequence) override;
+  virtual int get_row_cell(const int64_t row_idx, const int64_t store_idx, const common::ObObjMeta& col_meta,
+      common::ObObj& cell) override;
 
 protected:
   int base_init(const ObMicroBlockData& block_data);
@@ -17,6 +17,7 @@
 #include "storage/blocksstable/ob_micro_block_row_scanner.h"
 #include "storage/blocksstable/ob_imicro_block_reader.h"
 #include "storage/blocksstable/ob_sparse_micro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
 
 namespace oceanbase {
 namespace blocksstable {
@@ -36,6 +37,7 @@ protected:
   ObMicroBlockGetReader* flat_reader_;
   ObMultiVersionBlockGetReader* multi_version_reader_;
   ObSparseMicroBlockGetReader* sparse_reader_;
+  ObEncodeBlockGetReader* encode_reader_;
   bool is_multi_version_;
   bool is_inited_;
 };
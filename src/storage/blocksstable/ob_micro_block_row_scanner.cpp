@@ -17,6 +17,7 @@
 #include "storage/blocksstable/ob_micro_block_reader.h"
 #include "storage/transaction/ob_trans_service.h"
 #include "storage/transaction/ob_trans_part_ctx.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
 
 using namespace oceanbase;
 using namespace common;
@@ -178,6 +179,10 @@ int ObIMicroBlockRowScanner::set_reader(const ObRowStoreType store_type)
       reader_ = &sparse_reader_;
       break;
     }
+    case ENCODING_ROW_STORE: {
+      reader_ = &decoder_;
+      break;
+    }
     default:
       ret = OB_NOT_SUPPORTED;
       STORAGE_LOG(WARN, "not supported row store type", K(ret), K(store_type));
@@ -498,6 +503,136 @@ int ObMicroBlockRowScanner::open(const MacroBlockId& macro_id, const ObFullMacro
     STORAGE_LOG(WARN, "failed to init micro block reader", K(ret), K(macro_id));
   } else if (OB_FAIL(set_base_scan_param(is_left_border, is_right_border))) {
     STORAGE_LOG(WARN, "failed to set base scan param", K(ret), K(is_left_border), K(is_right_border), K(macro_id));
+  } else {
+    filter_result_ = nullptr;
+    filter_begin_ = ObIMicroBlockReader::INVALID_ROW_INDEX;
+    if (nullptr != param_->pushdown_filters_ && context_->enable_pushdown_filter_ &&
+        ObIMicroBlockReader::INVALID_ROW_INDEX != current_) {
+      const int64_t begin = MIN(start_, last_);
+      const int64_t row_count = MAX(start_, last_) - begin + 1;
+      if (OB_FAIL(filter_micro_block(begin, row_count))) {
+        STORAGE_LOG(WARN, "failed to filter micro block", K(ret), K(begin), K(row_count), K(macro_id));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockRowScanner::filter_micro_block(const int64_t begin, const int64_t row_count)
+{
+  int ret = OB_SUCCESS;
+  sql::ObPushdownFilterExecutor* filter = param_->pushdown_filters_;
+  if (OB_FAIL(filter_pushdown_filter(nullptr, *filter, begin, row_count))) {
+    STORAGE_LOG(WARN, "failed to filter micro block", K(ret), K(begin), K(row_count));
+  } else if (OB_ISNULL(filter->get_result())) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "filter result is null", K(ret));
+  } else {
+    filter_result_ = filter->get_result();
+    filter_begin_ = begin;
+    if (filter_result_->is_all_false()) {
+      // nothing left in this micro block
+      current_ = ObIMicroBlockReader::INVALID_ROW_INDEX;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockRowScanner::filter_pushdown_filter(const common::ObBitmap* parent_result,
+    sql::ObPushdownFilterExecutor& filter, const int64_t begin, const int64_t row_count)
+{
+  int ret = OB_SUCCESS;
+  common::ObBitmap* result = nullptr;
+  if (OB_FAIL(filter.init_bitmap(row_count, result))) {
+    STORAGE_LOG(WARN, "failed to init filter bitmap", K(ret), K(row_count));
+  } else if (OB_ISNULL(result)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "filter bitmap is null", K(ret));
+  } else if (filter.is_filter_white_node()) {
+    if (OB_FAIL(filter_white_filter(
+            parent_result, static_cast<sql::ObWhiteFilterExecutor&>(filter), begin, row_count, *result))) {
+      STORAGE_LOG(WARN, "failed to filter white filter", K(ret));
+    }
+  } else if (filter.is_filter_black_node()) {
+    // black filters are evaluated by sql on the projected row
+    result->reuse(true);
+  } else if (filter.is_logic_op_node()) {
+    const bool is_and = filter.is_logic_and_node();
+    // rows already false under an AND ancestor need not be evaluated by any descendant
+    if (is_and && nullptr != parent_result && OB_FAIL(result->bit_and(*parent_result))) {
+      STORAGE_LOG(WARN, "failed to merge parent result", K(ret));
+    }
+    const common::ObBitmap* child_parent_result = is_and ? result : parent_result;
+    for (uint32_t i = 0; OB_SUCC(ret) && i < filter.get_child_count(); ++i) {
+      sql::ObPushdownFilterExecutor* child = nullptr;
+      if (OB_FAIL(filter.get_child(i, child))) {
+        STORAGE_LOG(WARN, "failed to get child filter", K(ret), K(i));
+      } else if (OB_ISNULL(child)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "child filter is null", K(ret), K(i));
+      } else if (OB_FAIL(filter_pushdown_filter(child_parent_result, *child, begin, row_count))) {
+        STORAGE_LOG(WARN, "failed to filter child", K(ret), K(i));
+      } else if (OB_ISNULL(child->get_result())) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "child filter result is null", K(ret), K(i));
+      } else if (is_and) {
+        if (OB_FAIL(result->bit_and(*child->get_result()))) {
+          STORAGE_LOG(WARN, "failed to merge child result", K(ret), K(i));
+        } else if (result->is_all_false()) {
+          break;
+        }
+      } else if (OB_FAIL(result->bit_or(*child->get_result()))) {
+        STORAGE_LOG(WARN, "failed to merge child result", K(ret), K(i));
+      }
+    }
+  } else {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected filter type", K(ret), K(filter));
+  }
+  return ret;
+}
+
+int ObMicroBlockRowScanner::filter_white_filter(const common::ObBitmap* parent_result,
+    sql::ObWhiteFilterExecutor& filter, const int64_t begin, const int64_t row_count, common::ObBitmap& result)
+{
+  int ret = OB_SUCCESS;
+  int32_t col_idx = -1;
+  const ObColumnIndexItem* col_item = nullptr;
+  if (OB_UNLIKELY(1 != filter.get_col_ids().count()) || OB_ISNULL(column_map_.get_cols_map())) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected white filter", K(ret), K(filter));
+  } else if (OB_FAIL(column_map_.get_cols_map()->get(filter.get_col_ids().at(0), col_idx))) {
+    STORAGE_LOG(WARN, "failed to get column index", K(ret), K(filter.get_col_ids()));
+  } else if (OB_UNLIKELY(col_idx < 0 || col_idx >= column_map_.get_request_count())) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected column index", K(ret), K(col_idx), K(column_map_));
+  } else if (FALSE_IT(col_item = column_map_.get_column_indexs() + col_idx)) {
+  } else if (col_item->store_index_ < 0 || !col_item->is_column_type_matched_) {
+    // column not stored or stored with an old type, leave it to sql
+    result.reuse(true);
+  } else if (OB_FAIL(filter.init_params())) {
+    STORAGE_LOG(WARN, "failed to init white filter params", K(ret));
+  } else {
+    ObObj cell;
+    bool filtered = false;
+    result.reuse(false);
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_count; ++i) {
+      if (nullptr != parent_result && !parent_result->test(i)) {
+      } else if (OB_FAIL(reader_->get_row_cell(begin + i, col_item->store_index_, col_item->request_column_type_, cell))) {
+        if (OB_NOT_SUPPORTED == ret) {
+          // row store type without random cell access, leave it to sql
+          ret = OB_SUCCESS;
+          result.reuse(true);
+          break;
+        } else {
+          STORAGE_LOG(WARN, "failed to get row cell", K(ret), K(begin), K(i), K(*col_item));
+        }
+      } else if (OB_FAIL(filter.filter(cell, filtered))) {
+        STORAGE_LOG(WARN, "failed to filter cell", K(ret), K(cell));
+      } else if (!filtered && OB_FAIL(result.set(i))) {
+        STORAGE_LOG(WARN, "failed to set filter result", K(ret), K(i));
+      }
+    }
   }
   return ret;
 }
@@ -516,7 +651,11 @@ int ObMicroBlockRowScanner::inner_get_next_row(const ObStoreRow*& row)
 {
   int ret = OB_SUCCESS;
   row = NULL;
-  if (OB_FAIL(end_of_block())) {
+  // skip rows filtered out by pushdown filters
+  while (OB_SUCC(end_of_block()) && is_row_filtered(current_)) {
+    current_ += step_;
+  }
+  if (OB_FAIL(ret)) {
     if (OB_UNLIKELY(OB_ITER_END != ret)) {
       STORAGE_LOG(WARN, "fail to judge end of block or not, ", K(ret));
     }
@@ -542,35 +681,69 @@ int ObMicroBlockRowScanner::inner_get_next_rows(const storage::ObStoreRow*& rows
   int ret = OB_SUCCESS;
   rows = nullptr;
   count = 0;
-  while (OB_SUCC(ret) && count == 0) {
-    if (OB_FAIL(end_of_block())) {
+  if (nullptr != filter_result_) {
+    if (OB_FAIL(inner_get_next_filtered_rows(rows, count))) {
       if (OB_UNLIKELY(OB_ITER_END != ret)) {
-        STORAGE_LOG(WARN, "fail to judge end of block or not, ", K(ret));
+        STORAGE_LOG(WARN, "fail to get filtered rows", K(ret), K(current_), K(start_), K(last_), K(macro_id_));
       }
-    } else if (OB_FAIL(reader_->get_rows(
-                   current_, last_ + step_, ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT, rows_, count))) {
-      STORAGE_LOG(WARN, "fail to get rows", K(ret), K(current_), K(start_), K(last_), K(macro_id_), K(*sstable_));
-    } else if (0 == count) {
-      current_ += step_ * ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT;
-    } else {
-      rows = rows_;
-    }
-  }
-  STORAGE_LOG(DEBUG,
-      "inner get next rows",
-      K(ret),
-      "is_iter_end",
-      end_of_block(),
-      K(current_),
-      K(last_),
-      K(step_),
-      KP(rows),
-      K(count));
-  if (OB_SUCC(ret)) {
-    if (context_->query_flag_.is_multi_version_minor_merge()) {
-      compat_old_dump_sstable_row(const_cast<ObStoreRow*>(rows), count);
     }
-    current_ += step_ * count;
+  } else {
+    while (OB_SUCC(ret) && count == 0) {
+      if (OB_FAIL(end_of_block())) {
+        if (OB_UNLIKELY(OB_ITER_END != ret)) {
+          STORAGE_LOG(WARN, "fail to judge end of block or not, ", K(ret));
+        }
+      } else if (OB_FAIL(reader_->get_rows(
+                     current_, last_ + step_, ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT, rows_, count))) {
+        STORAGE_LOG(WARN, "fail to get rows", K(ret), K(current_), K(start_), K(last_), K(macro_id_), K(*sstable_));
+      } else if (0 == count) {
+        current_ += step_ * ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT;
+      } else {
+        rows = rows_;
+      }
+    }
+    STORAGE_LOG(DEBUG,
+        "inner get next rows",
+        K(ret),
+        "is_iter_end",
+        end_of_block(),
+        K(current_),
+        K(last_),
+        K(step_),
+        KP(rows),
+        K(count));
+    if (OB_SUCC(ret)) {
+      if (context_->query_flag_.is_multi_version_minor_merge()) {
+        compat_old_dump_sstable_row(const_cast<ObStoreRow*>(rows), count);
+      }
+      current_ += step_ * count;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockRowScanner::inner_get_next_filtered_rows(const storage::ObStoreRow*& rows, int64_t& count)
+{
+  int ret = OB_SUCCESS;
+  const int64_t request_count = column_map_.get_request_count();
+  while (OB_SUCC(ret) && count < ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT && OB_SUCC(end_of_block())) {
+    if (!is_row_filtered(current_)) {
+      rows_[count].row_val_.count_ = request_count;
+      if (OB_FAIL(reader_->get_row(current_, rows_[count]))) {
+        STORAGE_LOG(WARN, "micro block reader fail to get row.", K(ret), K(current_), K(macro_id_));
+      } else {
+        ++count;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      current_ += step_;
+    }
+  }
+  if (OB_ITER_END == ret && count > 0) {
+    ret = OB_SUCCESS;
+  }
+  if (OB_SUCC(ret)) {
+    rows = rows_;
   }
   return ret;
 }
@@ -579,6 +752,15 @@ void ObMicroBlockRowScanner::reset()
 {
   ObIMicroBlockRowScanner::reset();
   obj_buf_.reset();
+  filter_result_ = nullptr;
+  filter_begin_ = ObIMicroBlockReader::INVALID_ROW_INDEX;
+}
+
+void ObMicroBlockRowScanner::rescan()
+{
+  ObIMicroBlockRowScanner::rescan();
+  filter_result_ = nullptr;
+  filter_begin_ = ObIMicroBlockReader::INVALID_ROW_INDEX;
 }
 
 /*****************           ObMultiVersionMicroBlockRowScanner        ********************/
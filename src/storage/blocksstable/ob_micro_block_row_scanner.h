@@ -14,6 +14,7 @@
 #define OB_MICRO_BLOCK_ROW_SCANNER_H_
 
 #include "lib/container/ob_raw_se_array.h"
+#include "lib/container/ob_bitmap.h"
 #include "ob_row_queue.h"
 #include "storage/ob_sstable.h"
 #include "storage/ob_row_fuse.h"
@@ -21,10 +22,15 @@
 #include "storage/blocksstable/ob_macro_block_reader.h"
 #include "storage/blocksstable/ob_imicro_block_reader.h"
 #include "storage/blocksstable/ob_sparse_micro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
 #include "storage/blocksstable/ob_lob_data_reader.h"
 #include "storage/transaction/ob_trans_define.h"
 
 namespace oceanbase {
+namespace sql {
+class ObPushdownFilterExecutor;
+class ObWhiteFilterExecutor;
+}  // namespace sql
 namespace storage {
 class ObTableIterParam;
 class ObTableAccessContext;
@@ -100,6 +106,7 @@ protected:
   ObIMicroBlockReader* reader_;
   ObMicroBlockReader flat_reader_;
   ObSparseMicroBlockReader sparse_reader_;
+  ObMicroBlockDecoder decoder_;
   int64_t current_;  // current cursor
   int64_t start_;    // start of scan, inclusive.
   int64_t last_;     // end of scan, inclusive.
@@ -116,7 +123,7 @@ protected:
 // major sstable micro block scanner for query and merge
 class ObMicroBlockRowScanner : public ObIMicroBlockRowScanner {
 public:
-  ObMicroBlockRowScanner()
+  ObMicroBlockRowScanner() : filter_result_(nullptr), filter_begin_(ObIMicroBlockReader::INVALID_ROW_INDEX)
   {}
   virtual ~ObMicroBlockRowScanner()
   {}
@@ -125,14 +132,31 @@ public:
   virtual int open(const MacroBlockId& macro_id, const ObFullMacroBlockMeta& macro_meta,
       const ObMicroBlockData& block_data, const bool is_left_border, const bool is_right_border) override;
   void reset() override;
+  void rescan() override;
 
 protected:
   virtual int inner_get_next_row(const storage::ObStoreRow*& row) override;
   virtual int inner_get_next_rows(const storage::ObStoreRow*& rows, int64_t& count) override;
 
+private:
+  int inner_get_next_filtered_rows(const storage::ObStoreRow*& rows, int64_t& count);
+  // evaluate pushdown filters on rows [begin, begin + row_count) of current micro block,
+  // rows not set in the result bitmap are skipped without being read
+  int filter_micro_block(const int64_t begin, const int64_t row_count);
+  int filter_pushdown_filter(const common::ObBitmap* parent_result, sql::ObPushdownFilterExecutor& filter,
+      const int64_t begin, const int64_t row_count);
+  int filter_white_filter(const common::ObBitmap* parent_result, sql::ObWhiteFilterExecutor& filter,
+      const int64_t begin, const int64_t row_count, common::ObBitmap& result);
+  OB_INLINE bool is_row_filtered(const int64_t row_idx) const
+  {
+    return nullptr != filter_result_ && !filter_result_->test(row_idx - filter_begin_);
+  }
+
 protected:
   storage::ObStoreRow rows_[ObIMicroBlockReader::OB_MAX_BATCH_ROW_COUNT];
   storage::ObDynamicBuffer<ObObj> obj_buf_;
+  const common::ObBitmap* filter_result_;  // pushdown filter result of current micro block
+  int64_t filter_begin_;                   // row index of the first bit in filter_result_
 };
 
 /*
@@ -16,6 +16,7 @@
 #include "lib/container/ob_bit_set.h"
 #include "ob_micro_block_reader.h"
 #include "ob_sparse_micro_block_reader.h"
+#include "ob_micro_block_decoder.h"
 
 namespace oceanbase {
 namespace common {
@@ -152,6 +153,7 @@ private:
   ObIMicroBlockReader* reader_;
   ObMicroBlockReader flat_reader_;
   ObSparseMicroBlockReader sparse_reader_;  // for dumpsstable
+  ObMicroBlockDecoder decoder_;
   int64_t current_;                         // current cursor
   int64_t start_;
   int64_t last_;  // end of scan, inclusive.
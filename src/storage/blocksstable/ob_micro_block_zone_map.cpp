@@ -0,0 +1,699 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_micro_block_zone_map.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace sql;
+namespace blocksstable {
+
+ObColumnZone::ObColumnZone() : is_valid_(true), has_value_(false), null_count_(0), min_(), max_()
+{}
+
+void ObColumnZone::reset()
+{
+  is_valid_ = true;
+  has_value_ = false;
+  null_count_ = 0;
+  min_.reset();
+  max_.reset();
+}
+
+bool ObColumnZone::is_zone_type(const ObObjType type)
+{
+  bool bret = false;
+  switch (ob_obj_type_class(type)) {
+    case ObIntTC:
+    case ObUIntTC:
+    case ObFloatTC:
+    case ObDoubleTC:
+    case ObNumberTC:
+    case ObDateTimeTC:
+    case ObDateTC:
+    case ObTimeTC:
+    case ObYearTC:
+    case ObStringTC:
+      bret = true;
+      break;
+    default:
+      bret = false;
+      break;
+  }
+  return bret;
+}
+
+int ObColumnZone::set_value(const ObObj& value, char* buf, ObObj& dst)
+{
+  int64_t pos = 0;
+  return dst.deep_copy(value, buf, MAX_VALUE_LENGTH, pos);
+}
+
+int ObColumnZone::update(const ObObj& cell)
+{
+  int ret = OB_SUCCESS;
+  int cmp = 0;
+  if (!is_valid_) {
+    // do nothing
+  } else if (cell.is_null()) {
+    ++null_count_;
+  } else if (!is_zone_type(cell.get_type()) || cell.get_deep_copy_size() > MAX_VALUE_LENGTH ||
+             cell.get_serialize_size() > MAX_VALUE_SERIALIZE_SIZE) {
+    set_invalid();
+  } else if (!has_value_) {
+    if (OB_FAIL(set_value(cell, min_buf_, min_))) {
+      STORAGE_LOG(WARN, "fail to set min value", K(ret), K(cell));
+    } else if (OB_FAIL(set_value(cell, max_buf_, max_))) {
+      STORAGE_LOG(WARN, "fail to set max value", K(ret), K(cell));
+    } else {
+      has_value_ = true;
+    }
+  } else if (OB_FAIL(cell.compare(min_, cell.get_collation_type(), cmp))) {
+    STORAGE_LOG(WARN, "fail to compare with min value", K(ret), K(cell), K_(min));
+  } else if (cmp < 0) {
+    if (OB_FAIL(set_value(cell, min_buf_, min_))) {
+      STORAGE_LOG(WARN, "fail to set min value", K(ret), K(cell));
+    }
+  } else if (OB_FAIL(cell.compare(max_, cell.get_collation_type(), cmp))) {
+    STORAGE_LOG(WARN, "fail to compare with max value", K(ret), K(cell), K_(max));
+  } else if (cmp > 0) {
+    if (OB_FAIL(set_value(cell, max_buf_, max_))) {
+      STORAGE_LOG(WARN, "fail to set max value", K(ret), K(cell));
+    }
+  }
+  return ret;
+}
+
+int ObColumnZone::merge(const ObColumnZone& other)
+{
+  int ret = OB_SUCCESS;
+  int cmp = 0;
+  if (!is_valid_) {
+    // do nothing
+  } else if (!other.is_valid_) {
+    set_invalid();
+  } else {
+    null_count_ += other.null_count_;
+    if (!other.has_value_) {
+      // do nothing
+    } else if (!has_value_) {
+      if (OB_FAIL(set_value(other.min_, min_buf_, min_))) {
+        STORAGE_LOG(WARN, "fail to set min value", K(ret), K(other));
+      } else if (OB_FAIL(set_value(other.max_, max_buf_, max_))) {
+        STORAGE_LOG(WARN, "fail to set max value", K(ret), K(other));
+      } else {
+        has_value_ = true;
+      }
+    } else if (OB_FAIL(other.min_.compare(min_, other.min_.get_collation_type(), cmp))) {
+      STORAGE_LOG(WARN, "fail to compare min value", K(ret), K(other), K(*this));
+    } else if (cmp < 0 && OB_FAIL(set_value(other.min_, min_buf_, min_))) {
+      STORAGE_LOG(WARN, "fail to set min value", K(ret), K(other));
+    } else if (OB_FAIL(other.max_.compare(max_, other.max_.get_collation_type(), cmp))) {
+      STORAGE_LOG(WARN, "fail to compare max value", K(ret), K(other), K(*this));
+    } else if (cmp > 0 && OB_FAIL(set_value(other.max_, max_buf_, max_))) {
+      STORAGE_LOG(WARN, "fail to set max value", K(ret), K(other));
+    }
+  }
+  return ret;
+}
+
+DEFINE_SERIALIZE(ObColumnZone)
+{
+  int ret = OB_SUCCESS;
+  int8_t flag = 0;
+  flag |= is_valid_ ? ZONE_FLAG_VALID : 0;
+  flag |= has_value_ ? ZONE_FLAG_HAS_VALUE : 0;
+  if (OB_FAIL(serialization::encode_i8(buf, buf_len, pos, flag))) {
+    STORAGE_LOG(WARN, "fail to encode zone flag", K(ret), K(buf_len), K(pos));
+  } else if (is_valid_ && OB_FAIL(serialization::encode_vi64(buf, buf_len, pos, null_count_))) {
+    STORAGE_LOG(WARN, "fail to encode null count", K(ret), K(buf_len), K(pos));
+  } else if (has_value_) {
+    if (OB_FAIL(min_.serialize(buf, buf_len, pos))) {
+      STORAGE_LOG(WARN, "fail to serialize min value", K(ret), K(buf_len), K(pos));
+    } else if (OB_FAIL(max_.serialize(buf, buf_len, pos))) {
+      STORAGE_LOG(WARN, "fail to serialize max value", K(ret), K(buf_len), K(pos));
+    }
+  }
+  return ret;
+}
+
+// values of string type point to %buf after deserialize
+DEFINE_DESERIALIZE(ObColumnZone)
+{
+  int ret = OB_SUCCESS;
+  int8_t flag = 0;
+  reset();
+  if (OB_FAIL(serialization::decode_i8(buf, data_len, pos, &flag))) {
+    STORAGE_LOG(WARN, "fail to decode zone flag", K(ret), K(data_len), K(pos));
+  } else {
+    is_valid_ = 0 != (flag & ZONE_FLAG_VALID);
+    has_value_ = 0 != (flag & ZONE_FLAG_HAS_VALUE);
+    if (is_valid_ && OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &null_count_))) {
+      STORAGE_LOG(WARN, "fail to decode null count", K(ret), K(data_len), K(pos));
+    } else if (has_value_) {
+      if (OB_FAIL(min_.deserialize(buf, data_len, pos))) {
+        STORAGE_LOG(WARN, "fail to deserialize min value", K(ret), K(data_len), K(pos));
+      } else if (OB_FAIL(max_.deserialize(buf, data_len, pos))) {
+        STORAGE_LOG(WARN, "fail to deserialize max value", K(ret), K(data_len), K(pos));
+      }
+    }
+  }
+  return ret;
+}
+
+DEFINE_GET_SERIALIZE_SIZE(ObColumnZone)
+{
+  int64_t size = sizeof(int8_t);
+  if (is_valid_) {
+    size += serialization::encoded_length_vi64(null_count_);
+  }
+  if (has_value_) {
+    size += min_.get_serialize_size() + max_.get_serialize_size();
+  }
+  return size;
+}
+
+ObMicroBlockZoneMap::ObMicroBlockZoneMap() : is_inited_(false), column_count_(0)
+{}
+
+int64_t ObMicroBlockZoneMap::get_zone_column_count(const ObObjMeta* column_types, const int64_t column_count)
+{
+  int64_t zone_column_count = 0;
+  for (int64_t i = 0; NULL != column_types && i < column_count && zone_column_count < MAX_COLUMN_COUNT; ++i) {
+    if (ObColumnZone::is_zone_type(column_types[i].get_type())) {
+      ++zone_column_count;
+    }
+  }
+  return zone_column_count;
+}
+
+int ObMicroBlockZoneMap::init(const ObObjMeta* column_types, const int64_t column_count)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_UNLIKELY(NULL == column_types || column_count <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid arguments", K(ret), KP(column_types), K(column_count));
+  } else {
+    for (int64_t i = 0; i < column_count && column_count_ < MAX_COLUMN_COUNT; ++i) {
+      if (ObColumnZone::is_zone_type(column_types[i].get_type())) {
+        column_idxs_[column_count_++] = static_cast<int32_t>(i);
+      }
+    }
+    is_inited_ = column_count_ > 0;
+  }
+  return ret;
+}
+
+void ObMicroBlockZoneMap::reset()
+{
+  reuse();
+  column_count_ = 0;
+  is_inited_ = false;
+}
+
+void ObMicroBlockZoneMap::reuse()
+{
+  for (int64_t i = 0; i < column_count_; ++i) {
+    zones_[i].reset();
+  }
+}
+
+void ObMicroBlockZoneMap::set_invalid()
+{
+  for (int64_t i = 0; i < column_count_; ++i) {
+    zones_[i].set_invalid();
+  }
+}
+
+int ObMicroBlockZoneMap::update(const ObNewRow& row)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "zone map is not inited", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_count_; ++i) {
+      const int64_t column_idx = column_idxs_[i];
+      if (column_idx >= row.count_) {
+        zones_[i].set_invalid();
+      } else if (OB_FAIL(zones_[i].update(row.cells_[column_idx]))) {
+        STORAGE_LOG(WARN, "fail to update column zone", K(ret), K(i), K(column_idx));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMap::merge(const ObMicroBlockZoneMap& other)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "zone map is not inited", K(ret));
+  } else if (OB_UNLIKELY(column_count_ != other.column_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "column count not match", K(ret), K(*this), K(other));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_count_; ++i) {
+      if (OB_FAIL(zones_[i].merge(other.zones_[i]))) {
+        STORAGE_LOG(WARN, "fail to merge column zone", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMap::serialize(char* buf, const int64_t buf_len, int64_t& pos) const
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < column_count_; ++i) {
+    if (OB_FAIL(zones_[i].serialize(buf, buf_len, pos))) {
+      STORAGE_LOG(WARN, "fail to serialize column zone", K(ret), K(i), K(buf_len), K(pos));
+    }
+  }
+  return ret;
+}
+
+int64_t ObMicroBlockZoneMap::get_serialize_size() const
+{
+  int64_t size = 0;
+  for (int64_t i = 0; i < column_count_; ++i) {
+    size += zones_[i].get_serialize_size();
+  }
+  return size;
+}
+
+ObMicroBlockZoneMapWriter::ObMicroBlockZoneMapWriter()
+    : macro_zone_map_(), entries_(0, "MicrZoneMap"), offsets_(0, "MicrZoneMap"), micro_block_count_(0)
+{}
+
+int ObMicroBlockZoneMapWriter::init(const ObObjMeta* column_types, const int64_t column_count)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_FAIL(macro_zone_map_.init(column_types, column_count))) {
+    STORAGE_LOG(WARN, "fail to init macro zone map", K(ret), K(column_count));
+  }
+  return ret;
+}
+
+void ObMicroBlockZoneMapWriter::reset()
+{
+  macro_zone_map_.reset();
+  entries_.reuse();
+  offsets_.reuse();
+  micro_block_count_ = 0;
+}
+
+int ObMicroBlockZoneMapWriter::add_entry(const ObMicroBlockZoneMap* zone_map)
+{
+  int ret = OB_SUCCESS;
+  const int32_t offset = static_cast<int32_t>(entries_.length());
+  if (OB_UNLIKELY(is_empty())) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "zone map writer is not inited", K(ret));
+  } else if (OB_UNLIKELY(NULL != zone_map && zone_map->get_column_count() != macro_zone_map_.get_column_count())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "column count not match", K(ret), K(*zone_map), K_(macro_zone_map));
+  } else if (OB_FAIL(offsets_.write(offset))) {
+    STORAGE_LOG(WARN, "fail to write zone map offset", K(ret), K(offset));
+  } else if (NULL == zone_map) {
+    const int8_t invalid_flag = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < macro_zone_map_.get_column_count(); ++i) {
+      if (OB_FAIL(entries_.write(invalid_flag))) {
+        STORAGE_LOG(WARN, "fail to write invalid zone", K(ret), K(i));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      macro_zone_map_.set_invalid();
+    }
+  } else if (OB_FAIL(entries_.write(*zone_map))) {
+    STORAGE_LOG(WARN, "fail to write zone map", K(ret), K(*zone_map));
+  } else if (OB_FAIL(macro_zone_map_.merge(*zone_map))) {
+    STORAGE_LOG(WARN, "fail to merge macro zone map", K(ret));
+  }
+  if (OB_SUCC(ret)) {
+    ++micro_block_count_;
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapWriter::merge(const ObMicroBlockZoneMapWriter& other)
+{
+  int ret = OB_SUCCESS;
+  const int32_t* other_offsets = reinterpret_cast<const int32_t*>(other.offsets_.data());
+  const int32_t base_offset = static_cast<int32_t>(entries_.length());
+  if (OB_UNLIKELY(is_empty() || other.is_empty())) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "zone map writer is not inited", K(ret), K(*this), K(other));
+  } else if (OB_FAIL(macro_zone_map_.merge(other.macro_zone_map_))) {
+    STORAGE_LOG(WARN, "fail to merge macro zone map", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < other.micro_block_count_; ++i) {
+      if (OB_FAIL(offsets_.write(static_cast<int32_t>(base_offset + other_offsets[i])))) {
+        STORAGE_LOG(WARN, "fail to write zone map offset", K(ret), K(i));
+      }
+    }
+    if (OB_SUCC(ret) && other.entries_.length() > 0) {
+      if (OB_FAIL(entries_.write(other.entries_.data(), other.entries_.length()))) {
+        STORAGE_LOG(WARN, "fail to write zone map entries", K(ret));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      micro_block_count_ += other.micro_block_count_;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapWriter::build(ObSelfBufferWriter& buffer) const
+{
+  int ret = OB_SUCCESS;
+  ObZoneMapHeader header;
+  header.version_ = ObZoneMapHeader::ZONE_MAP_VERSION;
+  header.column_count_ = static_cast<int16_t>(macro_zone_map_.get_column_count());
+  header.micro_block_count_ = static_cast<int32_t>(micro_block_count_);
+  const int32_t macro_entry_offset = static_cast<int32_t>(entries_.length());
+  const int32_t end_offset = static_cast<int32_t>(entries_.length() + macro_zone_map_.get_serialize_size());
+  if (OB_UNLIKELY(is_empty())) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "zone map writer is not inited", K(ret));
+  } else if (OB_FAIL(buffer.write(header))) {
+    STORAGE_LOG(WARN, "fail to write zone map header", K(ret), K(header));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < macro_zone_map_.get_column_count(); ++i) {
+    if (OB_FAIL(buffer.write(macro_zone_map_.get_column_idx(i)))) {
+      STORAGE_LOG(WARN, "fail to write zone map column idx", K(ret), K(i));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (offsets_.length() > 0 && OB_FAIL(buffer.write(offsets_.data(), offsets_.length()))) {
+    STORAGE_LOG(WARN, "fail to write zone map offsets", K(ret));
+  } else if (OB_FAIL(buffer.write(macro_entry_offset))) {
+    STORAGE_LOG(WARN, "fail to write macro zone map offset", K(ret));
+  } else if (OB_FAIL(buffer.write(end_offset))) {
+    STORAGE_LOG(WARN, "fail to write zone map end offset", K(ret));
+  } else if (entries_.length() > 0 && OB_FAIL(buffer.write(entries_.data(), entries_.length()))) {
+    STORAGE_LOG(WARN, "fail to write zone map entries", K(ret));
+  } else if (OB_FAIL(buffer.write(macro_zone_map_))) {
+    STORAGE_LOG(WARN, "fail to write macro zone map", K(ret));
+  }
+  return ret;
+}
+
+int64_t ObMicroBlockZoneMapWriter::get_fixed_size() const
+{
+  // macro entry offset and end offset are always written
+  return sizeof(ObZoneMapHeader) + macro_zone_map_.get_column_count() * sizeof(int32_t) + 2 * sizeof(int32_t);
+}
+
+int64_t ObMicroBlockZoneMapWriter::get_entry_size(const ObMicroBlockZoneMap* zone_map) const
+{
+  int64_t size = 0;
+  if (!is_empty()) {
+    size = sizeof(int32_t) +
+           (NULL == zone_map ? macro_zone_map_.get_invalid_serialize_size() : zone_map->get_serialize_size());
+  }
+  return size;
+}
+
+int64_t ObMicroBlockZoneMapWriter::get_entries_size() const
+{
+  return offsets_.length() + entries_.length();
+}
+
+int64_t ObMicroBlockZoneMapWriter::get_block_size() const
+{
+  return is_empty() ? 0 : get_fixed_size() + get_entries_size() + macro_zone_map_.get_serialize_size();
+}
+
+int64_t ObMicroBlockZoneMapWriter::get_reserve_size() const
+{
+  return is_empty() ? 0 : get_fixed_size() + get_entries_size() + macro_zone_map_.get_max_serialize_size();
+}
+
+int64_t ObMicroBlockZoneMapWriter::get_max_reserve_size(const ObObjMeta* column_types, const int64_t column_count)
+{
+  int64_t size = 0;
+  const int64_t zone_column_count = ObMicroBlockZoneMap::get_zone_column_count(column_types, column_count);
+  if (zone_column_count > 0) {
+    // header, column idxs, three offsets, entry of the micro block and entry of the macro block
+    size = sizeof(ObZoneMapHeader) + zone_column_count * sizeof(int32_t) + 3 * sizeof(int32_t) +
+           2 * zone_column_count * ObColumnZone::MAX_SERIALIZE_SIZE;
+  }
+  return size;
+}
+
+ObMicroBlockZoneMapReader::ObMicroBlockZoneMapReader()
+    : header_(NULL), column_idxs_(NULL), offsets_(NULL), entries_(NULL), size_(0)
+{}
+
+void ObMicroBlockZoneMapReader::reset()
+{
+  header_ = NULL;
+  column_idxs_ = NULL;
+  offsets_ = NULL;
+  entries_ = NULL;
+  size_ = 0;
+}
+
+int ObMicroBlockZoneMapReader::init(const char* buf, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_UNLIKELY(NULL == buf || size < static_cast<int64_t>(sizeof(ObZoneMapHeader)))) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid arguments", K(ret), KP(buf), K(size));
+  } else {
+    const ObZoneMapHeader* header = reinterpret_cast<const ObZoneMapHeader*>(buf);
+    const int64_t fixed_size = sizeof(ObZoneMapHeader) + header->column_count_ * sizeof(int32_t) +
+                               (header->micro_block_count_ + 2) * sizeof(int32_t);
+    if (OB_UNLIKELY(ObZoneMapHeader::ZONE_MAP_VERSION != header->version_ || header->column_count_ <= 0 ||
+                    header->micro_block_count_ < 0 || fixed_size > size)) {
+      ret = OB_INVALID_DATA;
+      STORAGE_LOG(WARN, "invalid zone map header", K(ret), K(*header), K(size));
+    } else {
+      const int32_t* column_idxs = reinterpret_cast<const int32_t*>(buf + sizeof(ObZoneMapHeader));
+      const int32_t* offsets = column_idxs + header->column_count_;
+      if (OB_UNLIKELY(offsets[header->micro_block_count_ + 1] > size - fixed_size)) {
+        ret = OB_INVALID_DATA;
+        STORAGE_LOG(WARN, "zone map entries out of buffer", K(ret), K(*header), K(size));
+      } else {
+        header_ = header;
+        column_idxs_ = column_idxs;
+        offsets_ = offsets;
+        entries_ = buf + fixed_size;
+        size_ = size;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapReader::get_column_zone(
+    const int64_t entry_idx, const int64_t column_idx, ObColumnZone& zone, bool& found) const
+{
+  int ret = OB_SUCCESS;
+  found = false;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "zone map reader is not inited", K(ret));
+  } else if (OB_UNLIKELY(entry_idx < 0 || entry_idx > header_->micro_block_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid entry idx", K(ret), K(entry_idx), K(*header_));
+  } else {
+    int64_t zone_idx = -1;
+    for (int64_t i = 0; zone_idx < 0 && i < header_->column_count_; ++i) {
+      if (column_idxs_[i] == column_idx) {
+        zone_idx = i;
+      }
+    }
+    if (zone_idx >= 0) {
+      // zones are variable length, decode from the first one of the entry
+      const int64_t end = offsets_[entry_idx + 1];
+      int64_t pos = offsets_[entry_idx];
+      for (int64_t i = 0; OB_SUCC(ret) && i <= zone_idx; ++i) {
+        if (OB_FAIL(zone.deserialize(entries_, end, pos))) {
+          STORAGE_LOG(WARN, "fail to deserialize column zone", K(ret), K(entry_idx), K(i), K(pos), K(end));
+        }
+      }
+      found = OB_SUCC(ret);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapReader::init_filter_params(ObPushdownFilterExecutor& filter)
+{
+  int ret = OB_SUCCESS;
+  if (filter.is_filter_white_node()) {
+    if (OB_FAIL(static_cast<ObWhiteFilterExecutor&>(filter).init_params())) {
+      STORAGE_LOG(WARN, "fail to init white filter params", K(ret));
+    }
+  } else if (filter.is_logic_op_node()) {
+    ObPushdownFilterExecutor* child = NULL;
+    for (uint32_t i = 0; OB_SUCC(ret) && i < filter.get_child_count(); ++i) {
+      if (OB_FAIL(filter.get_child(i, child))) {
+        STORAGE_LOG(WARN, "fail to get child filter", K(ret), K(i));
+      } else if (OB_ISNULL(child)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "unexpected null child filter", K(ret), K(i));
+      } else if (OB_FAIL(init_filter_params(*child))) {
+        STORAGE_LOG(WARN, "fail to init child filter params", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapReader::can_skip(ObPushdownFilterExecutor& filter, const uint16_t* column_ids,
+    const int64_t column_count, const int64_t entry_idx, bool& can_skip) const
+{
+  int ret = OB_SUCCESS;
+  can_skip = false;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "zone map reader is not inited", K(ret));
+  } else if (OB_ISNULL(column_ids)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid arguments", K(ret), KP(column_ids));
+  } else if (filter.is_filter_white_node()) {
+    if (OB_FAIL(can_skip_white(
+            static_cast<ObWhiteFilterExecutor&>(filter), column_ids, column_count, entry_idx, can_skip))) {
+      STORAGE_LOG(WARN, "fail to check white filter", K(ret), K(entry_idx));
+    }
+  } else if (filter.is_logic_op_node()) {
+    // and: any child skips, or: all children skip
+    const bool is_and = filter.is_logic_and_node();
+    ObPushdownFilterExecutor* child = NULL;
+    bool child_skip = false;
+    can_skip = !is_and && filter.get_child_count() > 0;
+    for (uint32_t i = 0; OB_SUCC(ret) && can_skip != is_and && i < filter.get_child_count(); ++i) {
+      if (OB_FAIL(filter.get_child(i, child))) {
+        STORAGE_LOG(WARN, "fail to get child filter", K(ret), K(i));
+      } else if (OB_ISNULL(child)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "unexpected null child filter", K(ret), K(i));
+      } else if (OB_FAIL(this->can_skip(*child, column_ids, column_count, entry_idx, child_skip))) {
+        STORAGE_LOG(WARN, "fail to check child filter", K(ret), K(i));
+      } else {
+        can_skip = child_skip;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockZoneMapReader::can_skip_white(ObWhiteFilterExecutor& filter, const uint16_t* column_ids,
+    const int64_t column_count, const int64_t entry_idx, bool& can_skip) const
+{
+  int ret = OB_SUCCESS;
+  can_skip = false;
+  if (1 == filter.get_col_ids().count()) {
+    const uint64_t column_id = filter.get_col_ids().at(0);
+    int64_t column_idx = -1;
+    for (int64_t i = 0; column_idx < 0 && i < column_count; ++i) {
+      if (column_ids[i] == column_id) {
+        column_idx = i;
+      }
+    }
+    if (column_idx >= 0) {
+      ObColumnZone zone;
+      bool found = false;
+      if (OB_FAIL(get_column_zone(entry_idx, column_idx, zone, found))) {
+        STORAGE_LOG(WARN, "fail to get column zone", K(ret), K(entry_idx), K(column_idx));
+      } else if (found && zone.is_valid() && OB_FAIL(can_skip_zone(filter, zone, can_skip))) {
+        STORAGE_LOG(WARN, "fail to check column zone", K(ret), K(zone));
+      }
+    }
+  }
+  return ret;
+}
+
+// white filter params have the same type and collation as the column, be conservative otherwise
+static OB_INLINE bool is_zone_comparable(const ObObj& param, const ObColumnZone& zone)
+{
+  return param.get_type() == zone.get_min().get_type() &&
+         (!param.is_string_type() || param.get_collation_type() == zone.get_min().get_collation_type());
+}
+
+int ObMicroBlockZoneMapReader::can_skip_zone(
+    const ObWhiteFilterExecutor& filter, const ObColumnZone& zone, bool& can_skip) const
+{
+  int ret = OB_SUCCESS;
+  const ObIArray<ObObj>& params = filter.get_params();
+  const ObWhiteFilterOperatorType op_type = filter.get_op_type();
+  const ObObj& min = zone.get_min();
+  const ObObj& max = zone.get_max();
+  int min_cmp = 0;
+  int max_cmp = 0;
+  can_skip = false;
+  if (params.count() <= 0 || (WHITE_OP_IN != op_type && 1 != params.count())) {
+    // do nothing
+  } else if (!zone.has_value()) {
+    // null never satisfies a comparison
+    can_skip = true;
+  } else if (WHITE_OP_IN == op_type) {
+    can_skip = true;
+    for (int64_t i = 0; OB_SUCC(ret) && can_skip && i < params.count(); ++i) {
+      const ObObj& param = params.at(i);
+      if (param.is_null()) {
+      } else if (!is_zone_comparable(param, zone)) {
+        can_skip = false;
+      } else if (OB_FAIL(min.compare(param, min.get_collation_type(), min_cmp))) {
+        STORAGE_LOG(WARN, "fail to compare with min value", K(ret), K(param), K(zone));
+      } else if (OB_FAIL(max.compare(param, max.get_collation_type(), max_cmp))) {
+        STORAGE_LOG(WARN, "fail to compare with max value", K(ret), K(param), K(zone));
+      } else {
+        can_skip = min_cmp > 0 || max_cmp < 0;
+      }
+    }
+  } else if (params.at(0).is_null()) {
+    can_skip = true;
+  } else if (!is_zone_comparable(params.at(0), zone)) {
+    // do nothing
+  } else if (OB_FAIL(min.compare(params.at(0), min.get_collation_type(), min_cmp))) {
+    STORAGE_LOG(WARN, "fail to compare with min value", K(ret), K(params.at(0)), K(zone));
+  } else if (OB_FAIL(max.compare(params.at(0), max.get_collation_type(), max_cmp))) {
+    STORAGE_LOG(WARN, "fail to compare with max value", K(ret), K(params.at(0)), K(zone));
+  } else {
+    switch (op_type) {
+      case WHITE_OP_EQ:
+        can_skip = min_cmp > 0 || max_cmp < 0;
+        break;
+      case WHITE_OP_LE:
+        can_skip = min_cmp > 0;
+        break;
+      case WHITE_OP_LT:
+        can_skip = min_cmp >= 0;
+        break;
+      case WHITE_OP_GE:
+        can_skip = max_cmp < 0;
+        break;
+      case WHITE_OP_GT:
+        can_skip = max_cmp <= 0;
+        break;
+      case WHITE_OP_NE:
+        can_skip = 0 == min_cmp && 0 == max_cmp;
+        break;
+      default:
+        can_skip = false;
+        break;
+    }
+  }
+  return ret;
+}
+
+}  // namespace blocksstable
+}  // namespace oceanbase
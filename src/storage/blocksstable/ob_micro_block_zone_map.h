@@ -0,0 +1,237 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ZONE_MAP_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ZONE_MAP_H_
+
+#include "common/object/ob_object.h"
+#include "common/row/ob_row.h"
+#include "ob_data_buffer.h"
+
+namespace oceanbase {
+namespace sql {
+class ObPushdownFilterExecutor;
+class ObWhiteFilterExecutor;
+}  // namespace sql
+namespace blocksstable {
+
+// min/max/null count of one column in a micro block (or a macro block).
+// Values longer than MAX_VALUE_LENGTH make the zone invalid, an invalid zone never prunes.
+class ObColumnZone {
+public:
+  static const int64_t MAX_VALUE_LENGTH = 48;
+  static const int64_t MAX_VALUE_SERIALIZE_SIZE = 80;
+  static const int64_t MAX_SERIALIZE_SIZE = sizeof(int8_t) + 10 /*null count*/ + 2 * MAX_VALUE_SERIALIZE_SIZE;
+
+  ObColumnZone();
+  ~ObColumnZone()
+  {}
+  void reset();
+  void set_invalid()
+  {
+    reset();
+    is_valid_ = false;
+  }
+  int update(const common::ObObj& cell);
+  int merge(const ObColumnZone& other);
+  OB_INLINE bool is_valid() const
+  {
+    return is_valid_;
+  }
+  // false if all values are null
+  OB_INLINE bool has_value() const
+  {
+    return has_value_;
+  }
+  OB_INLINE const common::ObObj& get_min() const
+  {
+    return min_;
+  }
+  OB_INLINE const common::ObObj& get_max() const
+  {
+    return max_;
+  }
+  OB_INLINE int64_t get_null_count() const
+  {
+    return null_count_;
+  }
+  static bool is_zone_type(const common::ObObjType type);
+  NEED_SERIALIZE_AND_DESERIALIZE;
+  TO_STRING_KV(K_(is_valid), K_(has_value), K_(null_count), K_(min), K_(max));
+
+private:
+  static const int8_t ZONE_FLAG_VALID = 0x1;
+  static const int8_t ZONE_FLAG_HAS_VALUE = 0x2;
+  int set_value(const common::ObObj& value, char* buf, common::ObObj& dst);
+
+private:
+  bool is_valid_;
+  bool has_value_;
+  int64_t null_count_;
+  common::ObObj min_;
+  common::ObObj max_;
+  char min_buf_[MAX_VALUE_LENGTH];
+  char max_buf_[MAX_VALUE_LENGTH];
+  DISALLOW_COPY_AND_ASSIGN(ObColumnZone);
+};
+
+// zones of the first MAX_COLUMN_COUNT columns with zone type of a micro block
+class ObMicroBlockZoneMap {
+public:
+  static const int64_t MAX_COLUMN_COUNT = 32;
+
+  ObMicroBlockZoneMap();
+  ~ObMicroBlockZoneMap()
+  {}
+  int init(const common::ObObjMeta* column_types, const int64_t column_count);
+  void reset();
+  // clear zones and keep columns
+  void reuse();
+  void set_invalid();
+  int update(const common::ObNewRow& row);
+  int merge(const ObMicroBlockZoneMap& other);
+  OB_INLINE bool is_inited() const
+  {
+    return is_inited_;
+  }
+  OB_INLINE int64_t get_column_count() const
+  {
+    return column_count_;
+  }
+  OB_INLINE int32_t get_column_idx(const int64_t idx) const
+  {
+    return column_idxs_[idx];
+  }
+  int64_t get_max_serialize_size() const
+  {
+    return column_count_ * ObColumnZone::MAX_SERIALIZE_SIZE;
+  }
+  // serialize size of an entry without valid zone
+  int64_t get_invalid_serialize_size() const
+  {
+    return column_count_ * sizeof(int8_t);
+  }
+  static int64_t get_zone_column_count(const common::ObObjMeta* column_types, const int64_t column_count);
+  int serialize(char* buf, const int64_t buf_len, int64_t& pos) const;
+  int64_t get_serialize_size() const;
+  TO_STRING_KV(
+      K_(is_inited), K_(column_count), "column_idxs", common::ObArrayWrap<int32_t>(column_idxs_, column_count_));
+
+private:
+  bool is_inited_;
+  int64_t column_count_;
+  int32_t column_idxs_[MAX_COLUMN_COUNT];
+  ObColumnZone zones_[MAX_COLUMN_COUNT];
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockZoneMap);
+};
+
+/*
+ * Zone map section of macro block, stored behind the micro block index:
+ *
+ *   | ObZoneMapHeader | column idx * column_count | offset * (micro_block_count + 2) | entries |
+ *
+ * entry i (i < micro_block_count) is the zone map of micro block i, entry micro_block_count is the
+ * zone map of the whole macro block. Offsets are relative to the first entry, an entry of reused
+ * micro block has invalid zones.
+ */
+struct ObZoneMapHeader {
+  static const int16_t ZONE_MAP_VERSION = 1;
+  int16_t version_;
+  int16_t column_count_;
+  int32_t micro_block_count_;
+  TO_STRING_KV(K_(version), K_(column_count), K_(micro_block_count));
+};
+
+class ObMicroBlockZoneMapWriter {
+public:
+  ObMicroBlockZoneMapWriter();
+  ~ObMicroBlockZoneMapWriter()
+  {}
+  // nothing is written if none of the columns has zone type
+  int init(const common::ObObjMeta* column_types, const int64_t column_count);
+  void reset();
+  OB_INLINE bool is_empty() const
+  {
+    return !macro_zone_map_.is_inited();
+  }
+  // add zone map entry of next micro block, NULL for micro block without zone map
+  int add_entry(const ObMicroBlockZoneMap* zone_map);
+  int merge(const ObMicroBlockZoneMapWriter& other);
+  int build(ObSelfBufferWriter& buffer) const;
+  // size of the entry and offset added by %zone_map
+  int64_t get_entry_size(const ObMicroBlockZoneMap* zone_map) const;
+  // size of micro block entries and offsets
+  int64_t get_entries_size() const;
+  // size of the section after build
+  int64_t get_block_size() const;
+  // upper bound of the section size before macro entry grows
+  int64_t get_reserve_size() const;
+  // space reserved in macro block for a micro block with its zone map
+  static int64_t get_max_reserve_size(const common::ObObjMeta* column_types, const int64_t column_count);
+  TO_STRING_KV(K_(micro_block_count), "entries_size", entries_.length(), K_(macro_zone_map));
+
+private:
+  int64_t get_fixed_size() const;
+
+private:
+  ObMicroBlockZoneMap macro_zone_map_;
+  ObSelfBufferWriter entries_;
+  ObSelfBufferWriter offsets_;
+  int64_t micro_block_count_;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockZoneMapWriter);
+};
+
+class ObMicroBlockZoneMapReader {
+public:
+  ObMicroBlockZoneMapReader();
+  ~ObMicroBlockZoneMapReader()
+  {}
+  void reset();
+  int init(const char* buf, const int64_t size);
+  OB_INLINE bool is_inited() const
+  {
+    return NULL != header_;
+  }
+  OB_INLINE int64_t get_micro_block_count() const
+  {
+    return NULL == header_ ? 0 : header_->micro_block_count_;
+  }
+  OB_INLINE int64_t get_macro_entry_idx() const
+  {
+    return get_micro_block_count();
+  }
+  int get_column_zone(const int64_t entry_idx, const int64_t column_idx, ObColumnZone& zone, bool& found) const;
+  // evaluate params of white filters, must be called before can_skip
+  static int init_filter_params(sql::ObPushdownFilterExecutor& filter);
+  // %can_skip is true if no row of entry %entry_idx can pass %filter,
+  // %column_ids are store column ids of macro block
+  int can_skip(sql::ObPushdownFilterExecutor& filter, const uint16_t* column_ids, const int64_t column_count,
+      const int64_t entry_idx, bool& can_skip) const;
+  TO_STRING_KV(KP_(header), KP_(column_idxs), KP_(offsets), KP_(entries), K_(size));
+
+private:
+  int can_skip_white(sql::ObWhiteFilterExecutor& filter, const uint16_t* column_ids,
+      const int64_t column_count, const int64_t entry_idx, bool& can_skip) const;
+  int can_skip_zone(const sql::ObWhiteFilterExecutor& filter, const ObColumnZone& zone, bool& can_skip) const;
+
+private:
+  const ObZoneMapHeader* header_;
+  const int32_t* column_idxs_;
+  const int32_t* offsets_;
+  const char* entries_;
+  int64_t size_;
+};
+
+}  // namespace blocksstable
+}  // namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_ZONE_MAP_H_
@@ -106,7 +106,7 @@ int ObMacroBlockBuilder::open(storage::ObSSTableMergeCtx& ctx, const int64_t idx
       }
     }
     if (!ctx.param_.is_major_merge()) {
-      if (desc_.need_prebuild_bloomfilter_ && ctx.parallel_merge_ctx_.get_concurrent_cnt() == 1 &&
+      if (need_build_sstable_bloomfilter(ctx) && ctx.parallel_merge_ctx_.get_concurrent_cnt() == 1 &&
           OB_FAIL(init_bloomfilter_if_need(ctx))) {
         STORAGE_LOG(WARN, "Failed to init bloom filter writer", K(ret));
         ret = OB_SUCCESS;
@@ -244,6 +244,18 @@ int ObMacroBlockBuilder::open(storage::ObSSTableMergeCtx& ctx, const int64_t idx
   return ret;
 }
 
+bool ObMacroBlockBuilder::need_build_sstable_bloomfilter(storage::ObSSTableMergeCtx& ctx)
+{
+  // The bloom filter of minor sstable is persisted with the sstable, point gets and unique checks
+  // consult it before looking up macro blocks, so it is built for all user tables by default.
+  bool need_build = desc_.need_prebuild_bloomfilter_;
+  if (!need_build && GCONF._enable_minor_sstable_bloom_filter) {
+    ObIPartitionGroup* pg = ctx.pg_guard_.get_partition_group();
+    need_build = OB_NOT_NULL(pg) && !is_follower_state(pg->get_partition_state());
+  }
+  return need_build;
+}
+
 int ObMacroBlockBuilder::init_bloomfilter_if_need(storage::ObSSTableMergeCtx& ctx)
 {
   int ret = OB_SUCCESS;
@@ -251,9 +263,9 @@ int ObMacroBlockBuilder::init_bloomfilter_if_need(storage::ObSSTableMergeCtx& ct
   if (OB_UNLIKELY(!ctx.is_valid())) {
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN, "Invalid argument to init bloomfilter write", K(ctx), K(ret));
-  } else if (!desc_.need_prebuild_bloomfilter_ || ctx.param_.is_major_merge()) {
+  } else if (ctx.param_.is_major_merge()) {
     ret = OB_ERR_UNEXPECTED;
-    STORAGE_LOG(WARN, "Major merge would not build bloomfilter for sstable, or prebuild_bloomfilter is off", K(ret));
+    STORAGE_LOG(WARN, "Major merge would not build bloomfilter for sstable", K(ret));
   } else if (ctx.table_schema_->get_tenant_id() < OB_MAX_RESERVED_TENANT_ID) {
     // only check user table
   } else if (OB_FAIL(bf_macro_writer_.init(desc_))) {
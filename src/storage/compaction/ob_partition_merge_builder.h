@@ -94,6 +94,7 @@ protected:
   int check_flat_row_columns(const storage::ObStoreRow& row);
   OB_INLINE int check_row_column(const storage::ObStoreRow& row, const int64_t idx);
   OB_INLINE int check_sparse_row_column(const common::ObObj& obj, const int64_t idx);
+  bool need_build_sstable_bloomfilter(storage::ObSSTableMergeCtx& ctx);
   int append_bloom_filter(const storage::ObStoreRow& row);
 
   enum CheckRowFlagStatus
@@ -81,10 +81,13 @@ int ObRow2ExprsProjector::init(
         Item &item = outputs_[item_idx];
         item.obj_idx_ = obj_idx;
         item.expr_idx_ = i;
-        item.datum_ = &e->locate_datum_for_write(eval_ctx);
+        item.datum_ = e->locate_batch_datums(eval_ctx);
         item.eval_info_ = &e->get_eval_info(eval_ctx);
-        item.data_ = item.datum_->ptr_;
+        item.data_ = eval_ctx.frames_[e->frame_idx_] + e->res_buf_off_;
+        item.batch_idx_mask_ = e->batch_idx_mask_;
+        item.res_buf_stride_ = e->res_buf_stride_;
       }
+      eval_ctx_ = &eval_ctx;
     }
   }
   return ret;
@@ -95,24 +98,27 @@ int ObRow2ExprsProjector::project(
 {
   // performance critical, no parameter validity check.
   int ret = OB_SUCCESS;
-  num_.project(outputs_.get_data(), cells, nop_pos, nop_cnt);
-  str_.project(outputs_.get_data(), cells, nop_pos, nop_cnt);
-  int_.project(outputs_.get_data(), cells, nop_pos, nop_cnt);
+  const int64_t batch_idx = eval_ctx_->get_batch_idx();
+  num_.project(outputs_.get_data(), cells, nop_pos, nop_cnt, batch_idx);
+  str_.project(outputs_.get_data(), cells, nop_pos, nop_cnt, batch_idx);
+  int_.project(outputs_.get_data(), cells, nop_pos, nop_cnt, batch_idx);
 
   for (int64_t i = other_idx_; OB_SUCC(ret) && i < outputs_.count(); i++) {
     const Item &item = outputs_.at(i);
     const ObObj *cell = NULL;
+    sql::ObDatum *datum = item.locate_datum(batch_idx);
     if (OB_UNLIKELY(item.obj_idx_ < 0 || (cell = &cells[item.obj_idx_])->is_nop_value()) || (cell->is_urowid())) {
       // need to calc urowid col every time. otherwise may get old value.
       nop_pos[nop_cnt++] = item.expr_idx_;
     } else if (OB_UNLIKELY(cell->is_null())) {
-      item.datum_->set_null();
+      datum->set_null();
       item.eval_info_->evaluated_ = true;
     } else {
-      if (OB_UNLIKELY(item.datum_->ptr_ != item.data_)) {
-        item.datum_->ptr_ = item.data_;
+      const char *data = item.locate_data(batch_idx);
+      if (OB_UNLIKELY(datum->ptr_ != data)) {
+        datum->ptr_ = data;
       }
-      if (OB_FAIL(item.datum_->from_obj(*cell, exprs.at(item.expr_idx_)->obj_datum_map_))) {
+      if (OB_FAIL(datum->from_obj(*cell, exprs.at(item.expr_idx_)->obj_datum_map_))) {
         LOG_WARN("convert obj to datum failed");
       } else {
         // the other items may contain virtual columns, set evaluated flag.
@@ -182,7 +188,7 @@ DEF_TO_STRING(ObRow2ExprsProjector::Item)
 {
   int64_t pos = 0;
   J_OBJ_START();
-  J_KV(K(obj_idx_), K(expr_idx_), K(datum_), K(eval_info_), K(data_));
+  J_KV(K(obj_idx_), K(expr_idx_), K(datum_), K(eval_info_), K(data_), K(batch_idx_mask_), K(res_buf_stride_));
   J_OBJ_END();
   return pos;
 }
@@ -51,6 +51,7 @@ public:
   explicit ObRow2ExprsProjector(common::ObIAllocator& alloc)
       : other_idx_(0),
         has_virtual_(false),
+        eval_ctx_(NULL),
         outputs_(common::OB_MALLOC_NORMAL_BLOCK_SIZE, common::ModulePageAllocator(alloc))
   {}
   ~ObRow2ExprsProjector()
@@ -75,11 +76,23 @@ private:
   struct Item {
     int32_t obj_idx_;
     int32_t expr_idx_;
+    // datum and reserved buffer of the first row in batch
     sql::ObDatum* datum_;
     sql::ObEvalInfo* eval_info_;
     const char* data_;
+    // see ObExpr::batch_idx_mask_ and ObExpr::res_buf_stride_
+    uint64_t batch_idx_mask_;
+    uint32_t res_buf_stride_;
 
     Item() = default;
+    OB_INLINE sql::ObDatum* locate_datum(const int64_t batch_idx) const
+    {
+      return datum_ + (batch_idx & batch_idx_mask_);
+    }
+    OB_INLINE const char* locate_data(const int64_t batch_idx) const
+    {
+      return data_ + (batch_idx & batch_idx_mask_) * res_buf_stride_;
+    }
     DECLARE_TO_STRING;
   };
 
@@ -92,23 +105,26 @@ private:
     MapConvert() : start_(0), end_(0)
     {}
 
-    OB_INLINE void project(const Item* items, const common::ObObj* cells, int16_t* nop_pos, int64_t& nop_cnt) const
+    OB_INLINE void project(const Item* items, const common::ObObj* cells, int16_t* nop_pos, int64_t& nop_cnt,
+        const int64_t batch_idx) const
     {
       // performance critical, no parameter validity check.
       for (int32_t i = start_; i < end_; i++) {
         const Item& item = items[i];
         const common::ObObj& cell = cells[item.obj_idx_];
+        sql::ObDatum* datum = item.locate_datum(batch_idx);
         if (OB_UNLIKELY(cell.is_nop_value())) {
           nop_pos[nop_cnt++] = item.expr_idx_;
         } else if (OB_UNLIKELY(cell.is_null())) {
-          item.datum_->set_null();
+          datum->set_null();
         } else {
           if (NEED_RESET_PTR) {
-            if (OB_UNLIKELY(item.datum_->ptr_ != item.data_)) {
-              item.datum_->ptr_ = item.data_;
+            const char* data = item.locate_data(batch_idx);
+            if (OB_UNLIKELY(datum->ptr_ != data)) {
+              datum->ptr_ = data;
             }
           }
-          item.datum_->obj2datum<OBJ_DATUM_MAP_TYPE>(cell);
+          datum->obj2datum<OBJ_DATUM_MAP_TYPE>(cell);
         }
       }
     }
@@ -119,6 +135,8 @@ private:
   MapConvert<common::OBJ_DATUM_8BYTE_DATA, true> int_;
   int32_t other_idx_;
   bool has_virtual_;  // has virtual column
+  // to get batch index of vectorized execution
+  sql::ObEvalCtx* eval_ctx_;
   common::ObSEArray<Item, 4> outputs_;
 };
 
@@ -71,6 +71,7 @@ class ObPGCreateSSTableParam;
 class ObAddPartitionToPGLogCb;
 class ObSchemaChangeClogCb;
 class ObPGCheckpointInfo;
+struct ObDirectLoadSSTableCtx;
 class ObFlashBackPartitionCb;
 enum ObPartitionState {
   INIT = 0,
@@ -429,6 +430,10 @@ public:
       const share::ObBuildIndexAppendLocalDataParam& param, common::ObNewRowIterator& iter) = 0;
   virtual int append_sstable(const common::ObPartitionKey& pkey, const share::ObBuildIndexAppendSSTableParam& param,
       common::ObNewRowIterator& iter) = 0;
+  virtual int prepare_direct_load_sstable(const common::ObPartitionKey& pkey, const int64_t table_schema_version,
+      const int64_t snapshot_version, common::ObNewRowIterator& iter, ObDirectLoadSSTableCtx& ctx) = 0;
+  virtual int create_direct_load_sstable(const common::ObPartitionKey& pkey, ObDirectLoadSSTableCtx& ctx) = 0;
+  virtual int get_direct_load_major_sstable(const common::ObPartitionKey& pkey, ObTableHandle& major_handle) = 0;
   virtual const ObPartitionSplitInfo& get_split_info() = 0;
   virtual int check_cur_partition_split(bool& is_split_partition) = 0;
   virtual int get_trans_split_info(transaction::ObTransSplitInfo& split_info) = 0;
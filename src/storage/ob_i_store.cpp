@@ -28,6 +28,7 @@
 #include "sql/ob_sql_mock_schema_utils.h"
 #include "sql/engine/ob_phy_operator.h"
 #include "sql/engine/ob_operator.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
 #include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase {
@@ -233,7 +234,8 @@ ObTableIterParam::ObTableIterParam()
       full_out_cols_(NULL),
       full_cols_id_map_(NULL),
       need_scn_(false),
-      iter_mode_(OIM_ITER_FULL)
+      iter_mode_(OIM_ITER_FULL),
+      pushdown_filters_(NULL)
 {}
 
 ObTableIterParam::~ObTableIterParam()
@@ -310,6 +312,7 @@ void ObTableIterParam::reset()
   full_cols_id_map_ = NULL;
   need_scn_ = false;
   iter_mode_ = OIM_ITER_FULL;
+  pushdown_filters_ = NULL;
 }
 
 bool ObTableIterParam::is_valid() const
@@ -504,6 +507,9 @@ int ObTableAccessParam::init(ObTableScanParam& scan_param, const bool is_mv)
     iter_param_.need_scn_ = scan_param.need_scn_;
     iter_param_.out_cols_param_ = &table_param.get_columns();
     iter_param_.full_out_cols_param_ = &table_param.get_full_columns();
+    if (sql::ObPushdownFilterUtils::is_pushdown_storage(scan_param.pd_storage_flag_)) {
+      iter_param_.pushdown_filters_ = scan_param.pd_storage_filters_;
+    }
 
     reserve_cell_cnt_ = scan_param.reserved_cell_count_;
     filters_ = 0 == scan_param.filters_.count() ? NULL : &scan_param.filters_;
@@ -639,6 +645,9 @@ int ObTableAccessParam::init_index_back(ObTableScanParam& scan_param)
     iter_param_.out_cols_ = &out_col_desc_param_.get_col_descs();
     iter_param_.out_cols_param_ = &table_param.get_index_columns();
     iter_param_.full_out_cols_param_ = &table_param.get_full_columns();
+    if (sql::ObPushdownFilterUtils::is_pushdown_storage_index_back(scan_param.pd_storage_flag_)) {
+      iter_param_.pushdown_filters_ = scan_param.pd_storage_index_back_filters_;
+    }
 
     reserve_cell_cnt_ = scan_param.reserved_cell_count_;
     index_back_project_ = &table_param.get_index_back_projector();
@@ -932,7 +941,8 @@ ObTableAccessContext::ObTableAccessContext()
       range_array_cursor_(0),
       merge_log_ts_(INT_MAX),
       read_out_type_(MAX_ROW_STORE),
-      lob_locator_helper_(nullptr)
+      lob_locator_helper_(nullptr),
+      enable_pushdown_filter_(false)
 {}
 
 ObTableAccessContext::~ObTableAccessContext()
@@ -1133,6 +1143,7 @@ void ObTableAccessContext::reset()
   range_array_pos_ = nullptr;
   range_array_cursor_ = 0;
   read_out_type_ = MAX_ROW_STORE;
+  enable_pushdown_filter_ = false;
 }
 
 void ObTableAccessContext::reuse()
@@ -1170,6 +1181,7 @@ void ObTableAccessContext::reuse()
   is_array_binding_ = false;
   range_array_pos_ = nullptr;
   range_array_cursor_ = 0;
+  enable_pushdown_filter_ = false;
 }
 
 void ObStoreRowLockState::reset()
@@ -1094,7 +1094,8 @@ public:
   bool enable_fuse_row_cache() const;
   TO_STRING_KV(K_(table_id), K_(schema_version), K_(rowkey_cnt), KP_(out_cols), KP_(cols_id_map), KP_(projector),
       KP_(full_projector), KP_(out_cols_project), KP_(out_cols_param), KP_(full_out_cols_param),
-      K_(is_multi_version_minor_merge), KP_(full_out_cols), KP_(full_cols_id_map), K_(need_scn), K_(iter_mode));
+      K_(is_multi_version_minor_merge), KP_(full_out_cols), KP_(full_cols_id_map), K_(need_scn), K_(iter_mode),
+      KP_(pushdown_filters));
 
 public:
   uint64_t table_id_;
@@ -1113,6 +1114,8 @@ public:
   const share::schema::ColumnMap* full_cols_id_map_;
   bool need_scn_;
   ObIterTransNodeMode iter_mode_;
+  // filters pushed down from sql, white filters are evaluated against micro block data
+  sql::ObPushdownFilterExecutor* pushdown_filters_;
 };
 
 class ObColDescArrayParam final {
@@ -1370,7 +1373,7 @@ struct ObTableAccessContext {
   TO_STRING_KV(K_(is_inited), K_(timeout), K_(pkey), K_(query_flag), K_(sql_mode), KP_(store_ctx), KP_(expr_ctx),
       KP_(limit_param), KP_(stmt_allocator), KP_(allocator), KP_(table_scan_stat),
       KP_(block_cache_ws), K_(out_cnt), K_(is_end), K_(trans_version_range), KP_(row_filter), K_(merge_log_ts),
-      K_(read_out_type), K_(lob_locator_helper));
+      K_(read_out_type), K_(lob_locator_helper), K_(enable_pushdown_filter));
 
 private:
   int build_lob_locator_helper(ObTableScanParam& scan_param, const common::ObVersionRange& trans_version_range);
@@ -1407,6 +1410,9 @@ public:
   int64_t merge_log_ts_;
   common::ObRowStoreType read_out_type_;
   ObLobLocatorHelper* lob_locator_helper_;
+  // rows of the major sstable are final and can be filtered before fuse,
+  // set by ObMultipleMerge when no other table has data to fuse
+  bool enable_pushdown_filter_;
 };
 
 struct ObRowsInfo final {
@@ -934,9 +934,34 @@ int ObMultipleMerge::prepare_read_tables()
       }
     }
   }
+  if (OB_SUCC(ret)) {
+    access_ctx_->enable_pushdown_filter_ = can_pushdown_filter();
+  }
   return ret;
 }
 
+bool ObMultipleMerge::can_pushdown_filter() const
+{
+  // rows filtered inside the major sstable never reach fuse, so it is only allowed
+  // when there is no incremental data of any rowkey to be fused with
+  bool can_pushdown = nullptr != access_param_->iter_param_.pushdown_filters_ && nullptr == row_filter_;
+  int64_t major_sstable_cnt = 0;
+  const ObIArray<ObITable*>& tables = tables_handle_.get_tables();
+  for (int64_t i = 0; can_pushdown && i < tables.count(); ++i) {
+    const ObITable* table = tables.at(i);
+    if (OB_ISNULL(table)) {
+      can_pushdown = false;
+    } else if (table->is_major_sstable()) {
+      ++major_sstable_cnt;
+    } else if (table->is_memtable()) {
+      can_pushdown = !static_cast<const memtable::ObMemtable*>(table)->not_empty();
+    } else {
+      can_pushdown = false;
+    }
+  }
+  return can_pushdown && 1 == major_sstable_cnt;
+}
+
 int ObMultipleMerge::refresh_table_on_demand()
 {
   int ret = OB_SUCCESS;
@@ -127,6 +127,7 @@ private:
   int project2output_exprs(ObStoreRow& unprojected_row, ObStoreRow& cur_row);
   // destruct all iterators and reuse iter array
   int prepare_read_tables();
+  bool can_pushdown_filter() const;
   int check_need_refresh_table(bool& need_refresh);
   int save_curr_rowkey();
   int reset_tables();
@@ -166,6 +166,8 @@ int ObMultipleScanMerge::construct_iters()
     if (OB_SUCC(ret)) {
       if (OB_FAIL(prepare_range_skip())) {
         STORAGE_LOG(WARN, "Fail to prepare range skip", K(ret));
+      } else if (OB_FAIL(prepare_upper_bounds())) {
+        STORAGE_LOG(WARN, "Fail to prepare upper bounds", K(ret));
       }
     }
   }
@@ -301,6 +301,45 @@ int ObMultipleScanMergeImpl::prepare_range_skip()
   return ret;
 }
 
+// The max rowkey of sstable is the endkey of its last macro block, which is kept in memory by rowkey helper.
+// Minor sstables of append-mostly tables cover disjoint rowkey ranges, the loser tree streams rows of
+// such sstable without compare once the upper bound is found less than the rows of other iterators.
+int ObMultipleScanMergeImpl::prepare_upper_bounds()
+{
+  int ret = OB_SUCCESS;
+  const ObIArray<ObITable*>& tables = tables_handle_.get_tables();
+  const int64_t table_cnt = tables.count();
+  if (access_ctx_->query_flag_.is_reverse_scan() || table_cnt <= 1) {
+    // upper bound only works for forward scan with multiple iterators
+  } else if (OB_UNLIKELY(iters_.count() != table_cnt)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "iter cnt is not equal to table cnt", K(ret), K(iters_.count()), K(table_cnt));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < table_cnt; ++i) {
+      ObITable* table = tables.at(table_cnt - i - 1);
+      ObSSTable* sstable = NULL;
+      if (OB_ISNULL(table)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "unexpected null table", K(ret), K(i));
+      } else if (!table->is_sstable()) {
+        // memtable has no cheap upper bound
+      } else if (FALSE_IT(sstable = static_cast<ObSSTable*>(table))) {
+      } else if (!sstable->is_rowkey_helper_valid() || sstable->get_rowkey_helper().get_endkeys().count() <= 0) {
+        // skip sstable without endkeys
+      } else {
+        ObIArray<ObStoreRowkey>& endkeys = sstable->get_rowkey_helper().get_endkeys();
+        const ObStoreRowkey& last_endkey = endkeys.at(endkeys.count() - 1);
+        if (last_endkey.get_obj_cnt() < access_param_->iter_param_.rowkey_cnt_) {
+          // skip sstable with shorter rowkey, e.g. before add rowkey column
+        } else if (OB_FAIL(loser_tree_.set_upper_bound(i, last_endkey))) {
+          STORAGE_LOG(WARN, "fail to set upper bound", K(ret), K(i), K(last_endkey));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObMultipleScanMergeImpl::inner_get_next_row(ObStoreRow& row)
 {
   int ret = OB_SUCCESS;
@@ -106,6 +106,7 @@ protected:
   int reset_range(int idx, int64_t range_idx, const ObStoreRowkey* rowkey, const bool include_gap_key);
   int supply_consume();
   int prepare_range_skip();
+  int prepare_upper_bounds();
   int inner_get_next_row(ObStoreRow& row, bool& need_retry);
   int prepare_loser_tree();
 
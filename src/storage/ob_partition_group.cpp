@@ -4333,6 +4333,34 @@ int ObPartitionGroup::append_sstable(
   return ret;
 }
 
+int ObPartitionGroup::prepare_direct_load_sstable(const ObPartitionKey& pkey, const int64_t table_schema_version,
+    const int64_t snapshot_version, common::ObNewRowIterator& iter, ObDirectLoadSSTableCtx& ctx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(pg_storage_.prepare_direct_load_sstable(pkey, table_schema_version, snapshot_version, iter, ctx))) {
+    STORAGE_LOG(WARN, "fail to prepare direct load sstable", K(ret), K(pkey), K(table_schema_version));
+  }
+  return ret;
+}
+
+int ObPartitionGroup::create_direct_load_sstable(const ObPartitionKey& pkey, ObDirectLoadSSTableCtx& ctx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(pg_storage_.create_direct_load_sstable(pkey, ctx))) {
+    STORAGE_LOG(WARN, "fail to create direct load sstable", K(ret), K(pkey));
+  }
+  return ret;
+}
+
+int ObPartitionGroup::get_direct_load_major_sstable(const ObPartitionKey& pkey, ObTableHandle& major_handle)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(pg_storage_.get_direct_load_major_sstable(pkey, major_handle))) {
+    STORAGE_LOG(WARN, "fail to get direct load major sstable", K(ret), K(pkey));
+  }
+  return ret;
+}
+
 int ObPartitionGroup::check_single_replica_major_sstable_exist(
     const ObPartitionKey& pkey, const uint64_t index_table_id)
 {
@@ -281,6 +281,10 @@ public:
       const share::ObBuildIndexAppendLocalDataParam& param, common::ObNewRowIterator& iter) override;
   virtual int append_sstable(const common::ObPartitionKey& pkey, const share::ObBuildIndexAppendSSTableParam& param,
       common::ObNewRowIterator& iter) override;
+  virtual int prepare_direct_load_sstable(const common::ObPartitionKey& pkey, const int64_t table_schema_version,
+      const int64_t snapshot_version, common::ObNewRowIterator& iter, ObDirectLoadSSTableCtx& ctx) override;
+  virtual int create_direct_load_sstable(const common::ObPartitionKey& pkey, ObDirectLoadSSTableCtx& ctx) override;
+  virtual int get_direct_load_major_sstable(const common::ObPartitionKey& pkey, ObTableHandle& major_handle) override;
   virtual const ObPartitionSplitInfo& get_split_info() override
   {
     return split_info_;
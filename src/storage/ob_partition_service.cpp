@@ -464,6 +464,8 @@ int ObPartitionService::init(const blocksstable::ObStorageEnv& env, const ObAddr
         std::min(final_clog_disk_buffer_cnt, CLOG_DISK_BUFFER_THRESHOLD);  // 2000 is the upper limit
 
     clog_config.le_config_.disk_log_buffer_size_ = CLOG_DISK_BUFFER_SIZE;
+    clog_config.le_config_.group_commit_max_item_cnt_ =
+        ObServerConfig::get_instance()._ob_clog_group_commit_max_item_cnt;
     clog_config.le_config_.ethernet_speed_ = env.ethernet_speed_;
 
     static const int64_t ALLOCATOR_TOTAL_LIMIT = 5L * 1024L * 1024L * 1024L;
@@ -11193,6 +11195,268 @@ int ObPartitionService::append_sstable(const common::ObPartitionKey& pkey,
   return ret;
 }
 
+int ObPartitionService::get_direct_load_partition_(
+    const common::ObPartitionKey& pkey, const bool need_leader, ObIPartitionGroupGuard& guard)
+{
+  int ret = OB_SUCCESS;
+  ObIPartitionGroup* partition = NULL;
+  ObRole role = INVALID_ROLE;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "ObPartitionService has not been inited", K(ret));
+  } else if (OB_UNLIKELY(!pkey.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(pkey));
+  } else if (OB_FAIL(get_partition(pkey, guard))) {
+    STORAGE_LOG(WARN, "fail to get partition", K(ret), K(pkey));
+  } else if (OB_ISNULL(partition = guard.get_partition_group())) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "error unexpected, partition must not be NULL", K(ret), K(pkey));
+  } else if (!need_leader) {
+  } else if (OB_FAIL(partition->get_role(role))) {
+    STORAGE_LOG(WARN, "fail to get role", K(ret), K(pkey));
+  } else if (!is_strong_leader(role)) {
+    ret = OB_NOT_MASTER;
+    STORAGE_LOG(WARN, "direct load should be done on leader", K(ret), K(pkey));
+  }
+  return ret;
+}
+
+// the sstable bypasses clog, followers get it by rebuilding from leader
+void ObPartitionService::rebuild_direct_load_followers_(
+    const common::ObPartitionKey& pkey, const ObMemberList& member_list)
+{
+  for (int64_t i = 0; i < member_list.get_member_number(); ++i) {
+    ObAddr server;
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = member_list.get_server_by_index(i, server))) {
+      STORAGE_LOG(WARN, "fail to get server", K(tmp_ret), K(pkey), K(i));
+    } else if (server == self_addr_) {
+      // skip leader
+    } else if (OB_SUCCESS != (tmp_ret = rs_cb_->report_rebuild_replica_async(pkey, server, OB_REBUILD_ON))) {
+      STORAGE_LOG(WARN, "report rebuild replica failed", K(tmp_ret), K(pkey), K(server));
+    }
+  }
+}
+
+// a fresh snapshot keeps the loaded rows away from reads with a snapshot taken before the load finishes
+int ObPartitionService::get_direct_load_snapshot(const uint64_t tenant_id, int64_t& snapshot_version)
+{
+  int ret = OB_SUCCESS;
+  snapshot_version = 0;
+  do {
+    if (OB_FAIL(OB_TS_MGR.get_gts(tenant_id, NULL, snapshot_version))) {
+      if (OB_EAGAIN != ret) {
+        STORAGE_LOG(WARN, "fail to get gts", K(ret), K(tenant_id));
+      } else if (OB_FAIL(THIS_WORKER.check_status())) {
+        STORAGE_LOG(WARN, "fail to check status", K(ret), K(tenant_id));
+      } else {
+        ret = OB_EAGAIN;
+        usleep(1000);
+      }
+    }
+  } while (OB_EAGAIN == ret);
+  return ret;
+}
+
+int ObPartitionService::prepare_direct_load_sstable(const common::ObPartitionKey& pkey,
+    const int64_t table_schema_version, const int64_t snapshot_version, common::ObNewRowIterator& iter,
+    ObDirectLoadSSTableCtx& ctx)
+{
+  int ret = OB_SUCCESS;
+  ObIPartitionGroupGuard guard;
+  if (OB_FAIL(get_direct_load_partition_(pkey, true /*need leader*/, guard))) {
+    STORAGE_LOG(WARN, "fail to get direct load partition", K(ret), K(pkey));
+  } else if (OB_FAIL(guard.get_partition_group()->prepare_direct_load_sstable(
+                 pkey, table_schema_version, snapshot_version, iter, ctx))) {
+    STORAGE_LOG(WARN, "fail to prepare direct load sstable", K(ret), K(pkey));
+  }
+  return ret;
+}
+
+// the loaded sstables of all partitions become visible at once or not at all
+int ObPartitionService::publish_direct_load_sstables(const common::ObIArray<common::ObPartitionKey>& pkeys,
+    const common::ObIArray<ObDirectLoadSSTableCtx*>& ctxs, common::ObIArray<common::ObMemberList>& member_lists)
+{
+  int ret = OB_SUCCESS;
+  ObIPartitionArrayGuard partitions;
+  partitions.set_pg_mgr(pg_mgr_);
+  member_lists.reset();
+  if (OB_UNLIKELY(pkeys.count() != ctxs.count()) || OB_UNLIKELY(pkeys.empty())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(pkeys), "ctx_count", ctxs.count());
+  } else if (OB_FAIL(partitions.reserve(pkeys.count()))) {
+    STORAGE_LOG(WARN, "fail to reserve partitions", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < pkeys.count(); ++i) {
+    const ObPartitionKey& pkey = pkeys.at(i);
+    ObIPartitionGroupGuard guard;
+    ObMemberList member_list;
+    if (OB_ISNULL(ctxs.at(i))) {
+      ret = OB_INVALID_ARGUMENT;
+      STORAGE_LOG(WARN, "direct load ctx is null", K(ret), K(pkey));
+    } else if (OB_FAIL(get_direct_load_partition_(pkey, true /*need leader*/, guard))) {
+      STORAGE_LOG(WARN, "fail to get direct load partition", K(ret), K(pkey));
+    } else if (OB_FAIL(guard.get_partition_group()->get_leader_curr_member_list(member_list))) {
+      STORAGE_LOG(WARN, "fail to get leader member list", K(ret), K(pkey));
+    } else if (OB_FAIL(member_lists.push_back(member_list))) {
+      STORAGE_LOG(WARN, "fail to push back member list", K(ret), K(pkey));
+    } else if (OB_FAIL(partitions.push_back(guard.get_partition_group()))) {
+      STORAGE_LOG(WARN, "fail to push back partition", K(ret), K(pkey));
+    } else if (ctxs.at(i)->sstable_handle_.is_valid()) {
+      // created by a former publish which failed to swap
+    } else if (OB_FAIL(guard.get_partition_group()->create_direct_load_sstable(pkey, *ctxs.at(i)))) {
+      STORAGE_LOG(WARN, "fail to create direct load sstable", K(ret), K(pkey));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(swap_direct_load_sstables_(partitions, pkeys, ctxs, false /*is rollback*/))) {
+    STORAGE_LOG(WARN, "fail to swap direct load sstables", K(ret), K(pkeys));
+  } else {
+    for (int64_t i = 0; i < pkeys.count(); ++i) {
+      rebuild_direct_load_followers_(pkeys.at(i), member_lists.at(i));
+      submit_pt_update_task_(pkeys.at(i));
+    }
+  }
+  return ret;
+}
+
+int ObPartitionService::rollback_direct_load_sstables(
+    const common::ObIArray<common::ObPartitionKey>& pkeys, const common::ObIArray<ObDirectLoadSSTableCtx*>& ctxs)
+{
+  int ret = OB_SUCCESS;
+  ObIPartitionArrayGuard partitions;
+  partitions.set_pg_mgr(pg_mgr_);
+  if (OB_UNLIKELY(pkeys.count() != ctxs.count()) || OB_UNLIKELY(pkeys.empty())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(pkeys), "ctx_count", ctxs.count());
+  } else if (OB_FAIL(partitions.reserve(pkeys.count()))) {
+    STORAGE_LOG(WARN, "fail to reserve partitions", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < pkeys.count(); ++i) {
+    ObIPartitionGroupGuard guard;
+    if (OB_ISNULL(ctxs.at(i))) {
+      ret = OB_INVALID_ARGUMENT;
+      STORAGE_LOG(WARN, "direct load ctx is null", K(ret), "pkey", pkeys.at(i));
+    } else if (OB_FAIL(get_direct_load_partition_(pkeys.at(i), false /*need leader*/, guard))) {
+      STORAGE_LOG(WARN, "fail to get direct load partition", K(ret), "pkey", pkeys.at(i));
+    } else if (OB_FAIL(partitions.push_back(guard.get_partition_group()))) {
+      STORAGE_LOG(WARN, "fail to push back partition", K(ret), "pkey", pkeys.at(i));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(swap_direct_load_sstables_(partitions, pkeys, ctxs, true /*is rollback*/))) {
+    STORAGE_LOG(WARN, "fail to swap direct load sstables", K(ret), K(pkeys));
+  } else {
+    for (int64_t i = 0; i < pkeys.count(); ++i) {
+      const ObPartitionKey& pkey = pkeys.at(i);
+      ObIPartitionGroup* partition = partitions.at(i);
+      ObMemberList member_list;
+      ObRole role = INVALID_ROLE;
+      int tmp_ret = OB_SUCCESS;
+      if (OB_SUCCESS != (tmp_ret = partition->get_role(role))) {
+        STORAGE_LOG(WARN, "fail to get role", K(tmp_ret), K(pkey));
+      } else if (is_strong_leader(role)) {
+        // followers may have rebuilt with the loaded sstable already
+        if (OB_SUCCESS != (tmp_ret = partition->get_leader_curr_member_list(member_list))) {
+          STORAGE_LOG(WARN, "fail to get leader member list", K(tmp_ret), K(pkey));
+        } else {
+          rebuild_direct_load_followers_(pkey, member_list);
+        }
+        submit_pt_update_task_(pkey);
+      } else if (OB_SUCCESS != (tmp_ret = rs_cb_->report_rebuild_replica_async(pkey, self_addr_, OB_REBUILD_ON))) {
+        // leader has changed, bring the local replica back in line with the new leader
+        STORAGE_LOG(WARN, "report rebuild replica failed", K(tmp_ret), K(pkey));
+      }
+    }
+  }
+  return ret;
+}
+
+// all pgs are locked in the order of pg key, the swaps of all partitions are written into one slog transaction
+// and enabled only after it commits
+int ObPartitionService::swap_direct_load_sstables_(ObIPartitionArrayGuard& partitions,
+    const common::ObIArray<common::ObPartitionKey>& pkeys, const common::ObIArray<ObDirectLoadSSTableCtx*>& ctxs,
+    const bool is_rollback)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  ObSEArray<ObIPartitionGroup*, 16> pgs;
+  int64_t locked_cnt = 0;
+  bool is_trans_begun = false;
+  bool is_committed = false;
+  int64_t lsn = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && i < partitions.count(); ++i) {
+    if (!has_exist_in_array(pgs, partitions.at(i)) && OB_FAIL(pgs.push_back(partitions.at(i)))) {
+      STORAGE_LOG(WARN, "fail to push back pg", K(ret));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    std::sort(pgs.begin(), pgs.end(), [](ObIPartitionGroup* l, ObIPartitionGroup* r) {
+      return l->get_partition_key() < r->get_partition_key();
+    });
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < pgs.count(); ++i) {
+    if (OB_FAIL(pgs.at(i)->get_pg_storage().lock_for_direct_load())) {
+      STORAGE_LOG(WARN, "fail to lock pg for direct load", K(ret), "pg_key", pgs.at(i)->get_partition_key());
+    } else {
+      ++locked_cnt;
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(SLOGGER.begin(OB_LOG_ADD_SSTABLE))) {
+    STORAGE_LOG(WARN, "fail to begin direct load swap log", K(ret));
+  } else {
+    is_trans_begun = true;
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < partitions.count(); ++i) {
+    if (OB_FAIL(partitions.at(i)->get_pg_storage().prepare_direct_load_swap(pkeys.at(i), is_rollback, *ctxs.at(i)))) {
+      STORAGE_LOG(WARN, "fail to prepare direct load swap", K(ret), "pkey", pkeys.at(i), K(is_rollback));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(SLOGGER.commit(lsn))) {
+    STORAGE_LOG(WARN, "fail to commit direct load swap log", K(ret));
+  } else {
+    is_committed = true;
+  }
+  if (is_trans_begun && !is_committed && OB_SUCCESS != (tmp_ret = SLOGGER.abort())) {
+    STORAGE_LOG(ERROR, "logger abort error", K(tmp_ret));
+  }
+
+  for (int64_t i = 0; i < partitions.count(); ++i) {
+    partitions.at(i)->get_pg_storage().finish_direct_load_swap(is_committed, *ctxs.at(i));
+  }
+  for (int64_t i = 0; i < locked_cnt; ++i) {
+    pgs.at(i)->get_pg_storage().unlock_for_direct_load();
+  }
+  FLOG_INFO("swap direct load sstables", K(ret), K(is_rollback), K(lsn), K(pkeys));
+  return ret;
+}
+
+int ObPartitionService::check_direct_load_sstable(const common::ObPartitionKey& pkey,
+    const ObITable::TableKey& table_key, const int64_t row_count, bool& is_synced)
+{
+  int ret = OB_SUCCESS;
+  ObIPartitionGroupGuard guard;
+  ObTableHandle major_handle;
+  ObSSTable* major_sstable = nullptr;
+  is_synced = false;
+  if (OB_FAIL(get_direct_load_partition_(pkey, false /*need leader*/, guard))) {
+    STORAGE_LOG(WARN, "fail to get direct load partition", K(ret), K(pkey));
+  } else if (OB_FAIL(guard.get_partition_group()->get_direct_load_major_sstable(pkey, major_handle))) {
+    STORAGE_LOG(WARN, "fail to get direct load major sstable", K(ret), K(pkey));
+  } else if (!major_handle.is_valid()) {
+    // replica is being rebuilt
+  } else if (OB_FAIL(major_handle.get_sstable(major_sstable))) {
+    STORAGE_LOG(WARN, "fail to get major sstable", K(ret), K(pkey));
+  } else {
+    is_synced = major_sstable->get_key() == table_key && major_sstable->get_total_row_count() == row_count;
+  }
+  return ret;
+}
+
 bool ObPartitionService::is_election_candidate(const common::ObPartitionKey& pkey)
 {
   bool is_candidate = true;
@@ -735,6 +735,21 @@ public:
       const share::ObBuildIndexAppendLocalDataParam& param, common::ObNewRowIterator& iter);
   VIRTUAL_FOR_UNITTEST int append_sstable(const common::ObPartitionKey& pkey,
       const share::ObBuildIndexAppendSSTableParam& param, common::ObNewRowIterator& iter);
+  // LOAD DATA direct load of leader partitions: prepare writes the sorted rows from iter with the snapshot of
+  // the load, publish makes the loaded sstables of all partitions replace their empty major sstables in one
+  // slog transaction and rebuilds the followers in member_lists, rollback puts the empty major sstables back
+  // in the same way
+  VIRTUAL_FOR_UNITTEST int get_direct_load_snapshot(const uint64_t tenant_id, int64_t& snapshot_version);
+  VIRTUAL_FOR_UNITTEST int prepare_direct_load_sstable(const common::ObPartitionKey& pkey,
+      const int64_t table_schema_version, const int64_t snapshot_version, common::ObNewRowIterator& iter,
+      ObDirectLoadSSTableCtx& ctx);
+  VIRTUAL_FOR_UNITTEST int publish_direct_load_sstables(const common::ObIArray<common::ObPartitionKey>& pkeys,
+      const common::ObIArray<ObDirectLoadSSTableCtx*>& ctxs, common::ObIArray<common::ObMemberList>& member_lists);
+  VIRTUAL_FOR_UNITTEST int rollback_direct_load_sstables(
+      const common::ObIArray<common::ObPartitionKey>& pkeys, const common::ObIArray<ObDirectLoadSSTableCtx*>& ctxs);
+  // whether the local major sstable is the one published by the leader
+  VIRTUAL_FOR_UNITTEST int check_direct_load_sstable(const common::ObPartitionKey& pkey,
+      const ObITable::TableKey& table_key, const int64_t row_count, bool& is_synced);
 
   VIRTUAL_FOR_UNITTEST bool is_election_candidate(const common::ObPartitionKey& pkey);
   // for splitting partition
@@ -1014,6 +1029,12 @@ private:
   int check_partition_state_(const common::ObIArray<obrpc::ObCreatePartitionArg>& batch_arg,
       common::ObIArray<obrpc::ObCreatePartitionArg>& target_batch_arg, common::ObIArray<int>& batch_res);
   void submit_pt_update_task_(const ObPartitionKey& pkey, const bool need_report_checksum = true);
+  int get_direct_load_partition_(
+      const common::ObPartitionKey& pkey, const bool need_leader, ObIPartitionGroupGuard& guard);
+  void rebuild_direct_load_followers_(const common::ObPartitionKey& pkey, const common::ObMemberList& member_list);
+  int swap_direct_load_sstables_(ObIPartitionArrayGuard& partitions,
+      const common::ObIArray<common::ObPartitionKey>& pkeys, const common::ObIArray<ObDirectLoadSSTableCtx*>& ctxs,
+      const bool is_rollback);
   int submit_pg_pt_update_task_(const ObPartitionKey& pkey);
   int try_inc_total_partition_cnt(const int64_t new_partition_cnt, const bool need_check);
   int physical_flashback();
@@ -431,6 +431,96 @@ int ObPartitionStore::add_sstable(storage::ObSSTable *table, const int64_t max_k
   return ret;
 }
 
+// used by direct load, the new major sstable has the same major version as the one it replaces.
+// The new table store is only logged here, the caller enables or frees it after its slog transaction ends.
+int ObPartitionStore::prepare_replace_major_sstable(storage::ObSSTable *table, storage::ObSSTable *replaced_table,
+    const ObMigrateStatus &migrate_status, const bool is_in_dest_split, ObPreparedTableStore &prepared)
+{
+  int ret = OB_SUCCESS;
+  AddTableParam param;
+  bool exist = false;
+  bool need_update = false;
+  ObMultiVersionTableStore *multi_version_store = NULL;
+  ObTableStore *new_table_store = NULL;
+
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not inited", K(ret));
+  } else if (OB_ISNULL(table) || OB_ISNULL(replaced_table) || OB_UNLIKELY(!table->is_major_sstable()) ||
+             OB_UNLIKELY(table->get_key().version_.major_ != replaced_table->get_key().version_.major_) ||
+             OB_UNLIKELY(prepared.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument to replace major sstable", K(ret), KPC(table), KPC(replaced_table), K(prepared));
+  } else if (is_removed_) {
+    ret = OB_PARTITION_IS_REMOVED;
+    LOG_WARN("partition is removed", K(ret), K(meta_));
+  } else if (!ObReplicaTypeCheck::is_replica_with_ssstore(meta_->replica_type_)) {
+    ret = OB_STATE_NOT_MATCH;
+    LOG_WARN("replica type is without sstable, cannot add it", K(ret), K(*meta_));
+  } else {
+    param.table_ = table;
+    param.max_kept_major_version_number_ = 1;
+    param.in_slog_trans_ = true;
+    param.need_prewarm_ = false;
+    param.is_daily_merge_ = false;
+    param.multi_version_start_ = meta_->multi_version_start_;
+    param.replaced_major_ = replaced_table;
+    if (OB_FAIL(get_kept_multi_version_start(is_in_dest_split, param.multi_version_start_))) {
+      LOG_WARN("failed to get_kept_multi_version_start", K(ret));
+    } else if (OB_FAIL(check_table_store_exist_with_lock(table->get_table_id(), exist, multi_version_store))) {
+      LOG_WARN("failed to check table store exist with lock", K(ret), K(param));
+    } else if (OB_UNLIKELY(!exist) || OB_ISNULL(multi_version_store)) {
+      ret = OB_ENTRY_NOT_EXIST;
+      LOG_WARN("table store not exists, cannot replace major sstable", K(ret), K(param));
+    } else if (OB_FAIL(multi_version_store->prepare_add_sstable(param, new_table_store, need_update))) {
+      LOG_WARN("failed to prepare add table", K(ret));
+    } else if (OB_UNLIKELY(!need_update)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("table store is not changed by replacing major sstable", K(ret), K(param));
+    } else if (pg_memtable_mgr_->get_memtable_count() > 0 &&
+               OB_FAIL(check_new_table_store(*new_table_store, migrate_status))) {
+      LOG_WARN("failed to check new table store", K(ret));
+    } else if (OB_FAIL(write_modify_table_store_log(*new_table_store, param.multi_version_start_))) {
+      LOG_WARN("failed to write_modify_table_store_log", K(ret), KP(new_table_store));
+    } else {
+      prepared.multi_version_store_ = multi_version_store;
+      prepared.table_store_ = new_table_store;
+      prepared.multi_version_start_ = param.multi_version_start_;
+      new_table_store = NULL;
+    }
+  }
+
+  if (NULL != multi_version_store && NULL != new_table_store) {
+    multi_version_store->free_table_store(new_table_store);
+  }
+  return ret;
+}
+
+// the slog transaction is committed, memory must follow it
+void ObPartitionStore::enable_prepared_table_store(ObPreparedTableStore &prepared)
+{
+  int ret = OB_SUCCESS;
+  if (prepared.is_valid()) {
+    TCWLockGuard guard(lock_);
+    if (OB_FAIL(prepared.multi_version_store_->enable_table_store(false /*need_prewarm*/, *prepared.table_store_))) {
+      ObTaskController::get().allow_next_syslog();
+      LOG_ERROR("failed to enable table store, abort now", K(ret), K(prepared));
+      ob_abort();
+    } else {
+      meta_->multi_version_start_ = prepared.multi_version_start_;
+      FLOG_INFO("enable prepared table store", K(prepared), "memtable_cnt", pg_memtable_mgr_->get_memtable_count());
+      prepared.table_store_ = NULL;
+    }
+  }
+}
+
+void ObPartitionStore::free_prepared_table_store(ObPreparedTableStore &prepared)
+{
+  if (prepared.is_valid()) {
+    prepared.multi_version_store_->free_table_store(prepared.table_store_);
+  }
+}
+
 int ObPartitionStore::do_add_sstable(
     AddTableParam &param, const ObMigrateStatus &migrate_status, const bool is_in_source_split)
 {
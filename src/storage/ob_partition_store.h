@@ -58,6 +58,21 @@ struct TableStoreStat {
   TO_STRING_KV(K_(index_id), K_(has_dropped_flag));
 };
 
+// a new table store written into the slog transaction of the caller, it is enabled after the transaction commits
+// or freed after the transaction aborts
+struct ObPreparedTableStore {
+  ObPreparedTableStore() : multi_version_store_(NULL), table_store_(NULL), multi_version_start_(0)
+  {}
+  bool is_valid() const
+  {
+    return NULL != multi_version_store_ && NULL != table_store_;
+  }
+  TO_STRING_KV(KP_(multi_version_store), KP_(table_store), K_(multi_version_start));
+  ObMultiVersionTableStore *multi_version_store_;
+  ObTableStore *table_store_;
+  int64_t multi_version_start_;
+};
+
 class ObPGStorage;
 class ObPartitionStorage;
 
@@ -246,6 +261,11 @@ private:
   int create_index_table_store(const uint64_t table_id, const int64_t schema_version);
   int add_sstable(storage::ObSSTable *table, const int64_t max_kept_major_version_number, const bool in_slog_trans,
       const ObMigrateStatus &migrate_status, const bool is_in_dest_split, const int64_t schema_version = 0);
+  // used by direct load to replace the major sstables of several partitions in one slog transaction
+  int prepare_replace_major_sstable(storage::ObSSTable *table, storage::ObSSTable *replaced_table,
+      const ObMigrateStatus &migrate_status, const bool is_in_dest_split, ObPreparedTableStore &prepared);
+  void enable_prepared_table_store(ObPreparedTableStore &prepared);
+  void free_prepared_table_store(ObPreparedTableStore &prepared);
   int add_sstable_for_merge(storage::ObSSTable *table, const int64_t max_kept_major_version_number,
       const ObMigrateStatus &migrate_status, const bool is_in_restore, const bool is_in_source_split,
       const bool is_in_dest_split, storage::ObSSTable *complement_minor_sstable);
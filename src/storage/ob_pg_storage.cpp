@@ -22,6 +22,7 @@
 #include "share/ob_index_checksum.h"
 #include "share/backup/ob_backup_info_mgr.h"
 #include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "storage/blocksstable/ob_macro_block_writer.h"
 #include "storage/ob_partition_storage.h"
 #include "storage/ob_partition_service_rpc.h"
 #include "storage/ob_partition_service.h"
@@ -2558,6 +2559,208 @@ int ObPGStorage::append_sstable(
   return ret;
 }
 
+int ObPGStorage::prepare_direct_load_sstable(const ObPartitionKey& pkey, const int64_t table_schema_version,
+    const int64_t snapshot_version, common::ObNewRowIterator& iter, ObDirectLoadSSTableCtx& ctx)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("pg is not inited", K(ret));
+  } else if (OB_UNLIKELY(!pkey.is_valid()) || OB_UNLIKELY(table_schema_version <= 0) ||
+             OB_UNLIKELY(snapshot_version <= 0) || OB_UNLIKELY(ctx.base_major_handle_.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(pkey), K(table_schema_version), K(snapshot_version), K(ctx));
+  } else {
+    ObPGPartition* pg_partition = NULL;
+    PG_PARTITION_GUARD(guard, pkey)
+    ObPartitionStorage* storage = nullptr;
+    ObSchemaGetterGuard schema_guard;
+    const ObTableSchema* table_schema = nullptr;
+    ObSSTable* major_sstable = nullptr;
+    if (OB_ISNULL(pg_partition = guard.get_pg_partition())) {
+      ret = OB_PARTITION_NOT_EXIST;
+      LOG_WARN("pg partition not exist", K(ret), K(pkey), K_(pkey));
+    } else if (OB_ISNULL(storage = static_cast<ObPartitionStorage*>(pg_partition->get_storage()))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("storage must not null", K(ret), K(pkey));
+    } else if (OB_FAIL(get_direct_load_table_schema_(pkey, table_schema_version, schema_guard, table_schema))) {
+      LOG_WARN("failed to get direct load table schema", K(ret), K(pkey));
+    } else if (OB_FAIL(check_direct_load_target_(*storage, pkey.get_table_id(), true, ctx.base_major_handle_))) {
+      LOG_WARN("partition can not be direct loaded", K(ret), K(pkey));
+    } else if (OB_FAIL(ctx.base_major_handle_.get_sstable(major_sstable))) {
+      LOG_WARN("failed to get major sstable", K(ret), K(ctx));
+    } else if (OB_UNLIKELY(snapshot_version <= major_sstable->get_snapshot_version())) {
+      ret = OB_INVALID_ARGUMENT;
+      LOG_WARN("snapshot version of direct load must be newer than the empty major",
+          K(ret), K(snapshot_version), K(ctx));
+    } else if (FALSE_IT(ctx.snapshot_version_ = snapshot_version)) {
+    } else if (OB_FAIL(write_direct_load_macro_blocks_(*table_schema, *major_sstable, iter, ctx))) {
+      LOG_WARN("failed to write direct load macro blocks", K(ret), K(pkey));
+    } else {
+      ctx.table_schema_version_ = table_schema_version;
+    }
+    if (OB_FAIL(ret)) {
+      ctx.reset();
+    }
+  }
+  FLOG_INFO("prepare direct load sstable", K(ret), K(pkey), K(table_schema_version), K(snapshot_version), K(ctx));
+  return ret;
+}
+
+// the sstable is not referenced by the table store until the swap is committed, a failed publish leaves it
+// to be recycled like any other unreferenced sstable
+int ObPGStorage::create_direct_load_sstable(const ObPartitionKey& pkey, ObDirectLoadSSTableCtx& ctx)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("pg is not inited", K(ret));
+  } else if (OB_UNLIKELY(!pkey.is_valid()) || OB_UNLIKELY(!ctx.is_prepared()) || OB_UNLIKELY(ctx.is_published()) ||
+             OB_UNLIKELY(ctx.sstable_handle_.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(pkey), K(ctx));
+  } else {
+    ObSchemaGetterGuard schema_guard;
+    const ObTableSchema* table_schema = nullptr;
+    ObTableHandle sstable_handle;
+    ObSSTable* major_sstable = nullptr;
+    if (OB_FAIL(get_direct_load_table_schema_(pkey, ctx.table_schema_version_, schema_guard, table_schema))) {
+      LOG_WARN("failed to get direct load table schema", K(ret), K(pkey));
+    } else if (OB_FAIL(ctx.base_major_handle_.get_sstable(major_sstable))) {
+      LOG_WARN("failed to get major sstable", K(ret), K(ctx));
+    } else if (OB_FAIL(create_direct_load_sstable_(*table_schema, *major_sstable, ctx, sstable_handle))) {
+      LOG_WARN("failed to create direct load sstable", K(ret), K(pkey));
+    } else if (OB_FAIL(ctx.sstable_handle_.assign(sstable_handle))) {
+      LOG_WARN("failed to keep direct load sstable", K(ret), K(pkey));
+    }
+  }
+  FLOG_INFO("create direct load sstable", K(ret), K(pkey), K(ctx));
+  return ret;
+}
+
+int ObPGStorage::lock_for_direct_load()
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("pg is not inited", K(ret));
+  } else if (OB_FAIL(bucket_lock_.wrlock_all())) {
+    LOG_WARN("failed to lock all buckets", K(ret), K_(pkey));
+  }
+  return ret;
+}
+
+void ObPGStorage::unlock_for_direct_load()
+{
+  int tmp_ret = OB_SUCCESS;
+  if (OB_SUCCESS != (tmp_ret = bucket_lock_.unlock_all())) {
+    LOG_ERROR("failed to unlock all buckets", K(tmp_ret), K_(pkey));
+  }
+}
+
+// publish puts the loaded sstable in place of the empty major sstable, rollback puts the empty one back.
+// Nothing may have been written into the partition since the load started.
+int ObPGStorage::prepare_direct_load_swap(
+    const ObPartitionKey& pkey, const bool is_rollback, ObDirectLoadSSTableCtx& ctx)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("pg is not inited", K(ret));
+  } else if (OB_UNLIKELY(!pkey.is_valid()) || OB_UNLIKELY(!ctx.sstable_handle_.is_valid()) ||
+             OB_UNLIKELY(is_rollback != ctx.is_published()) || OB_UNLIKELY(nullptr != ctx.swap_store_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(pkey), K(is_rollback), K(ctx));
+  } else {
+    ObPGPartition* pg_partition = NULL;
+    PG_PARTITION_GUARD(guard, pkey)
+    ObPartitionStorage* storage = nullptr;
+    ObTableHandle cur_major_handle;
+    ObSSTable* major_sstable = nullptr;
+    ObSSTable* sstable = nullptr;
+    ObSSTable* cur_major = nullptr;
+    ObSSTable* new_major = nullptr;
+    const bool is_in_dest_split = is_dest_split(static_cast<ObPartitionSplitStateEnum>(meta_->saved_split_state_));
+    if (OB_UNLIKELY(is_removed_)) {
+      ret = OB_PG_IS_REMOVED;
+      LOG_WARN("pg is removed", K(ret), K_(pkey));
+    } else if (OB_ISNULL(pg_partition = guard.get_pg_partition())) {
+      ret = OB_PARTITION_NOT_EXIST;
+      LOG_WARN("pg partition not exist", K(ret), K(pkey), K_(pkey));
+    } else if (OB_ISNULL(storage = static_cast<ObPartitionStorage*>(pg_partition->get_storage()))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("storage must not null", K(ret), K(pkey));
+    } else if (OB_FAIL(ctx.base_major_handle_.get_sstable(major_sstable))) {
+      LOG_WARN("failed to get major sstable", K(ret), K(ctx));
+    } else if (OB_FAIL(ctx.sstable_handle_.get_sstable(sstable))) {
+      LOG_WARN("failed to get sstable", K(ret), K(ctx));
+    } else if (FALSE_IT(cur_major = is_rollback ? sstable : major_sstable)) {
+    } else if (FALSE_IT(new_major = is_rollback ? major_sstable : sstable)) {
+    } else if (OB_FAIL(check_direct_load_target_(*storage, pkey.get_table_id(), !is_rollback, cur_major_handle))) {
+      LOG_WARN("partition changed during direct load", K(ret), K(pkey));
+    } else if (OB_UNLIKELY(cur_major_handle.get_table() != cur_major)) {
+      ret = OB_EAGAIN;
+      LOG_WARN("major sstable changed during direct load", K(ret), K(pkey), K(cur_major_handle), KP(cur_major));
+    } else if (OB_FAIL(storage->get_partition_store().prepare_replace_major_sstable(
+                   new_major, cur_major, meta_->migrate_status_, is_in_dest_split, ctx.swap_table_store_))) {
+      LOG_WARN("failed to prepare replace major sstable", K(ret), K(pkey));
+    } else {
+      ctx.swap_store_ = &storage->get_partition_store();
+    }
+  }
+  return ret;
+}
+
+// the pg is still locked, so the partition store of the swap is alive
+void ObPGStorage::finish_direct_load_swap(const bool is_committed, ObDirectLoadSSTableCtx& ctx)
+{
+  if (nullptr != ctx.swap_store_) {
+    if (is_committed) {
+      ctx.swap_store_->enable_prepared_table_store(ctx.swap_table_store_);
+      ctx.is_published_ = !ctx.is_published_;
+    } else {
+      ctx.swap_store_->free_prepared_table_store(ctx.swap_table_store_);
+    }
+    ctx.swap_store_ = nullptr;
+    ctx.swap_table_store_ = ObPreparedTableStore();
+  }
+}
+
+int ObPGStorage::get_direct_load_major_sstable(const ObPartitionKey& pkey, ObTableHandle& major_handle)
+{
+  int ret = OB_SUCCESS;
+  major_handle.reset();
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("pg is not inited", K(ret));
+  } else if (OB_UNLIKELY(!pkey.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(pkey));
+  } else {
+    ObPGPartition* pg_partition = NULL;
+    PG_PARTITION_GUARD(guard, pkey)
+    ObPartitionStorage* storage = nullptr;
+    ObTablesHandle tables_handle;
+    bool is_ready_for_read = false;
+    if (OB_ISNULL(pg_partition = guard.get_pg_partition())) {
+      ret = OB_PARTITION_NOT_EXIST;
+      LOG_WARN("pg partition not exist", K(ret), K(pkey), K_(pkey));
+    } else if (OB_ISNULL(storage = static_cast<ObPartitionStorage*>(pg_partition->get_storage()))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("storage must not null", K(ret), K(pkey));
+    } else if (OB_FAIL(storage->get_partition_store().get_effective_tables(
+                   pkey.get_table_id(), tables_handle, is_ready_for_read))) {
+      LOG_WARN("failed to get effective tables", K(ret), K(pkey));
+    } else if (!is_ready_for_read || tables_handle.empty() || OB_ISNULL(tables_handle.get_table(0)) ||
+               !tables_handle.get_table(0)->is_major_sstable()) {
+      // replica is not ready, e.g. being rebuilt
+    } else if (OB_FAIL(major_handle.set_table(tables_handle.get_table(0)))) {
+      LOG_WARN("failed to set major sstable", K(ret), K(pkey));
+    }
+  }
+  return ret;
+}
+
 int ObPGStorage::check_single_replica_major_sstable_exist(const ObPartitionKey& pkey, const uint64_t index_table_id)
 {
   int ret = OB_SUCCESS;
@@ -6413,6 +6616,186 @@ int ObPGStorage::append_sstable(
   return ret;
 }
 
+int ObPGStorage::get_direct_load_table_schema_(const ObPartitionKey& pkey, const int64_t table_schema_version,
+    ObSchemaGetterGuard& schema_guard, const ObTableSchema*& table_schema)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t table_id = pkey.get_table_id();
+  table_schema = nullptr;
+  if (OB_FAIL(schema_service_->get_tenant_full_schema_guard(pkey.get_tenant_id(), schema_guard))) {
+    LOG_WARN("failed to get_tenant_full_schema_guard", K(ret), K(pkey));
+  } else if (OB_FAIL(schema_guard.get_table_schema(table_id, table_schema))) {
+    LOG_WARN("failed to get table schema", K(ret), K(table_id));
+  } else if (OB_ISNULL(table_schema)) {
+    ret = OB_TABLE_NOT_EXIST;
+    LOG_WARN("table not exist", K(ret), K(table_id));
+  } else if (table_schema->get_schema_version() != table_schema_version) {
+    ret = OB_SCHEMA_EAGAIN;
+    LOG_WARN("table schema changed during direct load",
+        K(ret),
+        K(table_schema_version),
+        "local_schema_version",
+        table_schema->get_schema_version());
+  }
+  return ret;
+}
+
+// direct load only goes into a table which is never written, that is one empty major sstable
+// and nothing in the memtables. A rolled back load expects its own sstable instead of the empty one.
+int ObPGStorage::check_direct_load_target_(
+    ObPartitionStorage& storage, const uint64_t table_id, const bool need_empty_major, ObTableHandle& major_handle)
+{
+  int ret = OB_SUCCESS;
+  ObTablesHandle tables_handle;
+  ObTableHandle memtable_handle;
+  ObMemtable* memtable = nullptr;
+  ObSSTable* major_sstable = nullptr;
+  bool is_ready_for_read = false;
+  major_handle.reset();
+  if (OB_FAIL(storage.get_partition_store().get_effective_tables(table_id, tables_handle, is_ready_for_read))) {
+    LOG_WARN("failed to get effective tables", K(ret), K(table_id));
+  } else if (OB_UNLIKELY(!is_ready_for_read) || 1 != tables_handle.get_count() ||
+             OB_ISNULL(tables_handle.get_table(0)) || !tables_handle.get_table(0)->is_major_sstable()) {
+    ret = OB_OP_NOT_ALLOW;
+    LOG_WARN("direct load needs a partition with only one major sstable",
+        K(ret), K(table_id), K(is_ready_for_read), K(tables_handle));
+  } else if (OB_FAIL(major_handle.set_table(tables_handle.get_table(0)))) {
+    LOG_WARN("failed to set major sstable", K(ret), K(table_id));
+  } else if (OB_FAIL(major_handle.get_sstable(major_sstable))) {
+    LOG_WARN("failed to get major sstable", K(ret), K(major_handle));
+  } else if (need_empty_major && 0 != major_sstable->get_total_row_count()) {
+    ret = OB_OP_NOT_ALLOW;
+    LOG_WARN("direct load needs an empty partition", K(ret), K(table_id), K(major_handle));
+  } else if (0 == pg_memtable_mgr_.get_memtable_count()) {
+    // no memtable
+  } else if (pg_memtable_mgr_.get_memtable_count() > 1) {
+    ret = OB_OP_NOT_ALLOW;
+    LOG_WARN("direct load needs a partition without frozen memtable", K(ret), K(table_id));
+  } else if (OB_FAIL(pg_memtable_mgr_.get_active_memtable(memtable_handle))) {
+    if (OB_ENTRY_NOT_EXIST == ret) {
+      ret = OB_OP_NOT_ALLOW;
+    }
+    LOG_WARN("failed to get active memtable", K(ret), K(table_id));
+  } else if (OB_FAIL(memtable_handle.get_memtable(memtable))) {
+    LOG_WARN("failed to get memtable", K(ret), K(memtable_handle));
+  } else if (memtable->not_empty()) {
+    ret = OB_OP_NOT_ALLOW;
+    LOG_WARN("direct load needs an empty memtable", K(ret), K(table_id), K(memtable_handle));
+  }
+  return ret;
+}
+
+// rows from iter are sorted by rowkey and in the column order of the table store, the macro blocks are
+// kept in ctx until the sstable is created before publish
+int ObPGStorage::write_direct_load_macro_blocks_(const ObTableSchema& table_schema, const ObSSTable& base_major,
+    common::ObNewRowIterator& iter, ObDirectLoadSSTableCtx& ctx)
+{
+  int ret = OB_SUCCESS;
+  const ObSSTableMeta& base_meta = base_major.get_meta();
+  const ObITable::TableKey& table_key = base_major.get_key();
+  ObDataStoreDesc data_desc;
+  int64_t row_count = 0;
+  SMART_VAR(ObMacroBlockWriter, writer)
+  {
+    if (OB_FAIL(data_desc.init(table_schema,
+            table_key.version_.major_,
+            nullptr,
+            table_key.pkey_.get_partition_id(),
+            storage::MAJOR_MERGE,
+            blocksstable::CCM_VALUE_ONLY == base_meta.checksum_method_ /*calc column checksum*/,
+            true /*store column checksum in micro block*/,
+            pkey_,
+            file_handle_,
+            ctx.snapshot_version_))) {
+      LOG_WARN("failed to init data store desc", K(ret), K(table_key), K(ctx));
+    } else if (FALSE_IT(data_desc.is_unique_index_ = true)) {
+      // duplicated rowkey is a user error here
+    } else if (OB_FAIL(writer.open(data_desc, ObMacroDataSeq(0)))) {
+      LOG_WARN("failed to open macro block writer", K(ret), K(table_key));
+    } else {
+      ObStoreRow row;
+      ObNewRow* row_val = nullptr;
+      row.flag_ = ObActionFlag::OP_ROW_EXIST;
+      while (OB_SUCC(ret)) {
+        if (OB_FAIL(THIS_WORKER.check_status())) {
+          LOG_WARN("failed to check status", K(ret));
+        } else if (OB_FAIL(iter.get_next_row(row_val))) {
+          if (OB_ITER_END != ret) {
+            LOG_WARN("failed to get next row", K(ret));
+          } else {
+            ret = OB_SUCCESS;
+            break;
+          }
+        } else if (OB_ISNULL(row_val) || OB_UNLIKELY(row_val->get_count() != data_desc.row_column_count_)) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("row not match table", K(ret), KPC(row_val), K(data_desc.row_column_count_));
+        } else {
+          row.row_val_ = *row_val;
+          if (OB_FAIL(writer.append_row(row))) {
+            if (OB_ERR_PRIMARY_KEY_DUPLICATE != ret) {
+              LOG_WARN("failed to append row", K(ret), K(row));
+            }
+          } else {
+            ++row_count;
+          }
+        }
+      }
+      if (OB_SUCC(ret) && OB_FAIL(writer.close())) {
+        LOG_WARN("failed to close macro block writer", K(ret));
+      }
+    }
+
+    if (OB_SUCC(ret)) {
+      if (OB_FAIL(ctx.data_blocks_.set(writer.get_macro_block_write_ctx()))) {
+        LOG_WARN("failed to keep macro blocks", K(ret), K(table_key));
+      } else {
+        ctx.row_count_ = row_count;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObPGStorage::create_direct_load_sstable_(const ObTableSchema& table_schema, const ObSSTable& base_major,
+    ObDirectLoadSSTableCtx& ctx, ObTableHandle& sstable_handle)
+{
+  int ret = OB_SUCCESS;
+  const int64_t snapshot_version = ctx.snapshot_version_;
+  const ObSSTableMeta& base_meta = base_major.get_meta();
+  ObITable::TableKey table_key = base_major.get_key();
+  ObCreateSSTableParamWithTable sstable_param;
+  ObPGCreateSSTableParam pg_create_sstable_param;
+  sstable_handle.reset();
+  if (OB_UNLIKELY(snapshot_version <= table_key.trans_version_range_.snapshot_version_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("snapshot version of direct load must be newer than the empty major",
+        K(ret), K(snapshot_version), K(table_key));
+  } else {
+    // keep the major version, bump the minor version to tell the sstables apart
+    table_key.version_.minor_ = static_cast<int16_t>(table_key.version_.minor_ + 1);
+    table_key.trans_version_range_.multi_version_start_ = snapshot_version;
+    table_key.trans_version_range_.snapshot_version_ = snapshot_version;
+    sstable_param.table_key_ = table_key;
+    sstable_param.schema_ = &table_schema;
+    sstable_param.schema_version_ = table_schema.get_schema_version();
+    sstable_param.progressive_merge_start_version_ = base_meta.progressive_merge_start_version_;
+    sstable_param.progressive_merge_end_version_ = base_meta.progressive_merge_end_version_;
+    sstable_param.create_snapshot_version_ = base_meta.create_snapshot_version_;
+    sstable_param.create_index_base_version_ = base_meta.create_index_base_version_;
+    sstable_param.checksum_method_ = base_meta.checksum_method_;
+    sstable_param.progressive_merge_round_ = base_meta.progressive_merge_round_;
+    sstable_param.progressive_merge_step_ = base_meta.progressive_merge_step_;
+    sstable_param.logical_data_version_ = std::max(base_meta.logical_data_version_, table_key.version_.version_);
+    pg_create_sstable_param.with_table_param_ = &sstable_param;
+    if (OB_FAIL(pg_create_sstable_param.data_blocks_.push_back(&ctx.data_blocks_))) {
+      LOG_WARN("failed to push back data block ctx", K(ret));
+    } else if (OB_FAIL(create_sstable(pg_create_sstable_param, false /*in slog trans*/, sstable_handle))) {
+      LOG_WARN("failed to create sstable", K(ret), K(table_key));
+    }
+  }
+  return ret;
+}
+
 int ObPGStorage::check_update_split_state_()
 {
   int ret = OB_SUCCESS;
@@ -79,6 +79,51 @@ public:
   bool in_slog_trans_;
 };
 
+// LOAD DATA direct load into one partition: the macro blocks are written on prepare with the snapshot of the load,
+// the sstable is created from them and takes the place of the empty major sstable on publish
+struct ObDirectLoadSSTableCtx final {
+public:
+  ObDirectLoadSSTableCtx()
+      : table_schema_version_(0), snapshot_version_(0), row_count_(0), is_published_(false), swap_store_(nullptr)
+  {}
+  ~ObDirectLoadSSTableCtx() = default;
+  void reset()
+  {
+    table_schema_version_ = 0;
+    snapshot_version_ = 0;
+    row_count_ = 0;
+    base_major_handle_.reset();
+    data_blocks_.reset();
+    sstable_handle_.reset();
+    is_published_ = false;
+    swap_store_ = nullptr;
+    swap_table_store_ = ObPreparedTableStore();
+  }
+  bool is_prepared() const
+  {
+    return base_major_handle_.is_valid();
+  }
+  bool is_published() const
+  {
+    return is_published_;
+  }
+  TO_STRING_KV(K_(table_schema_version), K_(snapshot_version), K_(row_count), K_(base_major_handle), K_(data_blocks),
+      K_(sstable_handle), K_(is_published), KP_(swap_store), K_(swap_table_store));
+  int64_t table_schema_version_;
+  int64_t snapshot_version_;  // of the macro blocks and the sstable
+  int64_t row_count_;
+  ObTableHandle base_major_handle_;  // the empty major sstable
+  blocksstable::ObMacroBlocksWriteCtx data_blocks_;
+  ObTableHandle sstable_handle_;  // the loaded major sstable
+  bool is_published_;
+  // the swap of major sstable logged in the slog transaction of publish or rollback, not enabled yet
+  ObPartitionStore* swap_store_;
+  ObPreparedTableStore swap_table_store_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObDirectLoadSSTableCtx);
+};
+
 class ObPGStorage {
   friend class ObPGPartitionArrayGuard;
 
@@ -207,6 +252,18 @@ public:
   int append_sstable(
       const ObPartitionKey& pkey, const share::ObBuildIndexAppendSSTableParam& param, common::ObNewRowIterator& iter);
   int check_single_replica_major_sstable_exist(const ObPartitionKey& pkey, const uint64_t index_table_id);
+  // direct load
+  int prepare_direct_load_sstable(const ObPartitionKey& pkey, const int64_t table_schema_version,
+      const int64_t snapshot_version, common::ObNewRowIterator& iter, ObDirectLoadSSTableCtx& ctx);
+  int create_direct_load_sstable(const ObPartitionKey& pkey, ObDirectLoadSSTableCtx& ctx);
+  // publish and rollback swap the major sstables of all partitions of a load in one slog transaction of the caller:
+  // the pg stays locked while the swap of each partition is logged by prepare_direct_load_swap(), and enabled or
+  // dropped by finish_direct_load_swap() once the transaction ends
+  int lock_for_direct_load();
+  void unlock_for_direct_load();
+  int prepare_direct_load_swap(const ObPartitionKey& pkey, const bool is_rollback, ObDirectLoadSSTableCtx& ctx);
+  void finish_direct_load_swap(const bool is_committed, ObDirectLoadSSTableCtx& ctx);
+  int get_direct_load_major_sstable(const ObPartitionKey& pkey, ObTableHandle& major_handle);
   int get_table_stat(const common::ObPartitionKey& pkey, ObTableStat& stat);
   int get_all_table_ids(const ObPartitionKey& pkey, ObIArray<uint64_t>& index_tables);
 
@@ -607,6 +664,14 @@ private:
   int set_replay_sstables(const bool is_replay_old, ObPartitionStore& store);
   int append_sstable(const share::ObBuildIndexAppendSSTableParam& param, common::ObNewRowIterator& iter,
       ObTableHandle& sstable_handle);
+  int get_direct_load_table_schema_(const ObPartitionKey& pkey, const int64_t table_schema_version,
+      share::schema::ObSchemaGetterGuard& schema_guard, const share::schema::ObTableSchema*& table_schema);
+  int check_direct_load_target_(ObPartitionStorage& storage, const uint64_t table_id, const bool need_empty_major,
+      ObTableHandle& major_handle);
+  int write_direct_load_macro_blocks_(const share::schema::ObTableSchema& table_schema, const ObSSTable& base_major,
+      common::ObNewRowIterator& iter, ObDirectLoadSSTableCtx& ctx);
+  int create_direct_load_sstable_(const share::schema::ObTableSchema& table_schema, const ObSSTable& base_major,
+      ObDirectLoadSSTableCtx& ctx, ObTableHandle& sstable_handle);
   int get_min_sstable_version_(int64_t& min_sstable_snapshot_version);
   int check_update_split_state_();
   int remove_old_table_(const ObPartitionKey& pkey, const int64_t frozen_version);
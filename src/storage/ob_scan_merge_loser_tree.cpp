@@ -22,6 +22,7 @@ void ObScanMergeLoserTreeCmp::reset()
   rowkey_size_ = 0;
   error_ = OB_SUCCESS;
   reverse_ = false;
+  is_int_rowkey_ = false;
   is_inited_ = false;
 }
 
@@ -68,9 +69,14 @@ int ObScanMergeLoserTreeCmp::init(const int64_t rowkey_size, const ObColDescIArr
     } else if (!is_oracle_mode && use_cmp_nullsafe) {
       ret = make_rowkey_cmp_funcs<ObRowkeyObjComparerNullsafeMysql>(rowkey_size, col_descs, allocator);
     } else {
-      make_rowkey_cmp_funcs<ObRowkeyObjComparer>(rowkey_size, col_descs, allocator);
+      ret = make_rowkey_cmp_funcs<ObRowkeyObjComparer>(rowkey_size, col_descs, allocator);
     }
     if (OB_SUCC(ret)) {
+      is_int_rowkey_ = true;
+      for (int64_t i = 0; is_int_rowkey_ && i < rowkey_size; i++) {
+        const ObObjTypeClass tc = col_descs.at(i).col_type_.get_type_class();
+        is_int_rowkey_ = (ObIntTC == tc || ObUIntTC == tc);
+      }
       rowkey_size_ = rowkey_size;
       reverse_ = reverse;
       is_inited_ = true;
@@ -94,6 +100,27 @@ int ObScanMergeLoserTreeCmp::compare_rowkey(const ObStoreRow& l_row, const ObSto
   return ret;
 }
 
+OB_INLINE int ObScanMergeLoserTreeCmp::compare_rowkey_objs(
+    const ObObj* l_objs, const ObObj* r_objs, int32_t& cmp_result)
+{
+  int ret = OB_SUCCESS;
+  cmp_result = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && 0 == cmp_result && i < rowkey_size_; i++) {
+    const ObObj& l_obj = l_objs[i];
+    const ObObj& r_obj = r_objs[i];
+    // null, min and max objs of int columns are still compared by the cmp funcs
+    if (is_int_rowkey_ && ObIntTC == l_obj.get_type_class() && ObIntTC == r_obj.get_type_class()) {
+      cmp_result = l_obj.get_int() < r_obj.get_int() ? -1 : (l_obj.get_int() > r_obj.get_int() ? 1 : 0);
+    } else if (is_int_rowkey_ && ObUIntTC == l_obj.get_type_class() && ObUIntTC == r_obj.get_type_class()) {
+      cmp_result = l_obj.get_uint64() < r_obj.get_uint64() ? -1 : (l_obj.get_uint64() > r_obj.get_uint64() ? 1 : 0);
+    } else if (OB_UNLIKELY(ObObjCmpFuncs::CR_OB_ERROR == (cmp_result = cmp_funcs_.at(i)->compare(l_obj, r_obj)))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("failed to compare rowkey obj", K(ret), K(i), K(l_obj), K(r_obj));
+    }
+  }
+  return ret;
+}
+
 int64_t ObScanMergeLoserTreeCmp::operator()(const ObScanMergeLoserTreeItem& l, const ObScanMergeLoserTreeItem& r)
 {
   int32_t cmp_result = 0;
@@ -107,7 +134,8 @@ int64_t ObScanMergeLoserTreeCmp::operator()(const ObScanMergeLoserTreeItem& l, c
   } else {
     cmp_result = static_cast<int32_t>(l.row_->scan_index_ - r.row_->scan_index_);
     if (0 == cmp_result) {
-      if (OB_SUCCESS != (error_ = compare_rowkey(*l.row_, *r.row_, rowkey_size_, cmp_funcs_, cmp_result))) {
+      if (OB_SUCCESS !=
+          (error_ = compare_rowkey_objs(l.row_->row_val_.cells_, r.row_->row_val_.cells_, cmp_result))) {
         LOG_WARN("compare rowkey error", K(error_));
       } else if (reverse_) {
         cmp_result = -cmp_result;
@@ -117,6 +145,28 @@ int64_t ObScanMergeLoserTreeCmp::operator()(const ObScanMergeLoserTreeItem& l, c
   return cmp_result;
 }
 
+int64_t ObScanMergeLoserTreeCmp::compare_upper_bound(
+    const ObStoreRowkey& bound, const int64_t scan_index, const ObScanMergeLoserTreeItem& r)
+{
+  int32_t cmp_result = 0;
+  error_ = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    error_ = OB_NOT_INIT;
+    LOG_WARN("not init", K(error_));
+  } else if (reverse_ || bound.get_obj_cnt() < rowkey_size_ || nullptr == r.row_ || r.row_->scan_index_ < 0) {
+    error_ = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(error_), K_(reverse), K(bound), KP(r.row_), K_(rowkey_size));
+  } else {
+    cmp_result = static_cast<int32_t>(scan_index - r.row_->scan_index_);
+    if (0 == cmp_result) {
+      if (OB_SUCCESS != (error_ = compare_rowkey_objs(bound.get_obj_ptr(), r.row_->row_val_.cells_, cmp_result))) {
+        LOG_WARN("compare upper bound error", K(error_), K(bound));
+      }
+    }
+  }
+  return cmp_result;
+}
+
 int ObScanMergeLoserTree::init(const int64_t total_player_cnt, ObIAllocator& allocator)
 {
   int ret = OB_SUCCESS;
@@ -129,6 +179,7 @@ int ObScanMergeLoserTree::init(const int64_t total_player_cnt, ObIAllocator& all
     } else {
       has_king_ = false;
       is_king_eq_champion_ = false;
+      reset_stream();
     }
   }
   return ret;
@@ -138,9 +189,29 @@ void ObScanMergeLoserTree::reset()
 {
   has_king_ = false;
   is_king_eq_champion_ = false;
+  MEMSET(upper_bounds_, 0, sizeof(upper_bounds_));
+  reset_stream();
   ObScanMergeLoserTreeBase::reset();
 }
 
+int ObScanMergeLoserTree::set_upper_bound(const int64_t iter_idx, const ObStoreRowkey& bound)
+{
+  int ret = OB_SUCCESS;
+  if (!IS_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (iter_idx < 0 || iter_idx >= player_cnt_ || !bound.is_valid() ||
+             bound.get_obj_cnt() < cmp_.get_rowkey_size()) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(iter_idx), K(player_cnt_), K(bound));
+  } else if (cmp_.is_reverse()) {
+    // the upper bound is useless in reverse scan
+  } else {
+    upper_bounds_[iter_idx] = &bound;
+  }
+  return ret;
+}
+
 int ObScanMergeLoserTree::top(const ObScanMergeLoserTreeItem*& player)
 {
   int ret = OB_SUCCESS;
@@ -165,10 +236,13 @@ int ObScanMergeLoserTree::pop()
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("new players has been push, please rebuild", K(ret));
   } else if (has_king_) {
+    // keep the stream state, the champion is not changed
     has_king_ = false;
     is_king_eq_champion_ = false;
   } else if (OB_FAIL(ObScanMergeLoserTreeBase::pop())) {
     LOG_WARN("pop base tree fail", K(ret));
+  } else {
+    reset_stream();
   }
   return ret;
 }
@@ -184,6 +258,8 @@ int ObScanMergeLoserTree::push(const ObScanMergeLoserTreeItem& player)
     LOG_WARN("player is full", K(ret), K(player_cnt_), K(cur_free_cnt_), K(has_king_));
   } else if (OB_FAIL(ObScanMergeLoserTreeBase::push(player))) {
     LOG_WARN("push base tree fail", K(ret));
+  } else {
+    reset_stream();
   }
   return ret;
 }
@@ -211,6 +287,8 @@ int ObScanMergeLoserTree::rebuild()
     }
     if (OB_SUCC(ret) && OB_FAIL(ObScanMergeLoserTreeBase::rebuild())) {
       LOG_WARN("build base tree fail", K(ret), K(has_king_), K(is_king_eq_champion_));
+    } else {
+      reset_stream();
     }
   }
   return ret;
@@ -231,7 +309,8 @@ int ObScanMergeLoserTree::push_top(const ObScanMergeLoserTreeItem& player)
   } else if (need_rebuild_) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("tree need rebuild", K(ret), K(need_rebuild_));
-  } else if (0 == ObScanMergeLoserTreeBase::count()) {
+  } else if (0 == ObScanMergeLoserTreeBase::count() ||
+             (player.iter_idx_ == stream_iter_idx_ && player.row_->scan_index_ == stream_scan_index_)) {
     king_ = player;
     has_king_ = true;
     is_king_eq_champion_ = false;
@@ -243,11 +322,20 @@ int ObScanMergeLoserTree::push_top(const ObScanMergeLoserTreeItem& player)
     } else if (player.iter_idx_ == players_[champion].iter_idx_) {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("rows from same iterator", K(ret), K(player.iter_idx_), K(players_[champion].iter_idx_));
+    } else if (!is_stream_checked_ && nullptr != upper_bounds_[player.iter_idx_]) {
+      bool is_streaming = false;
+      if (OB_FAIL(try_stream(player, champion, is_streaming))) {
+        LOG_WARN("try stream fail", K(ret), K(player.iter_idx_));
+      } else if (is_streaming) {
+        king_ = player;
+        has_king_ = true;
+        is_king_eq_champion_ = false;
+      }
     }
 
     // if left only one player, we can compare them by rebuild directly without trying
     // thus can save one time compare
-    if (OB_SUCC(ret) && ObScanMergeLoserTreeBase::count() > 1) {
+    if (OB_SUCC(ret) && !has_king_ && ObScanMergeLoserTreeBase::count() > 1) {
       const int64_t king_cmp = cmp_(players_[champion], player);
       if (OB_FAIL(cmp_.get_error_code())) {
         LOG_WARN("compare champion fail",
@@ -277,12 +365,36 @@ int ObScanMergeLoserTree::push_top(const ObScanMergeLoserTreeItem& player)
       } else {
         has_king_ = false;
         is_king_eq_champion_ = false;
+        reset_stream();
       }
     }
   }
   return ret;
 }
 
+int ObScanMergeLoserTree::try_stream(
+    const ObScanMergeLoserTreeItem& player, const int64_t champion, bool& is_streaming)
+{
+  int ret = OB_SUCCESS;
+  is_streaming = false;
+  const ObStoreRowkey* bound = upper_bounds_[player.iter_idx_];
+  // rows of the player in the same range are not greater than its upper bound,
+  // so all of them can be king if the upper bound is less than the champion
+  const int64_t bound_cmp = cmp_.compare_upper_bound(*bound, player.row_->scan_index_, players_[champion]);
+  if (OB_FAIL(cmp_.get_error_code())) {
+    LOG_WARN("compare upper bound fail", K(ret), K(player.iter_idx_), K(*bound), K(*players_[champion].row_));
+  } else {
+    // the result only changes with the champion, no need to check again before that
+    is_stream_checked_ = true;
+    if (bound_cmp < 0) {
+      is_streaming = true;
+      stream_iter_idx_ = player.iter_idx_;
+      stream_scan_index_ = player.row_->scan_index_;
+    }
+  }
+  return ret;
+}
+
 int ObScanMergeLoserTree::duel(ObScanMergeLoserTreeItem& offender, ObScanMergeLoserTreeItem& defender,
     const int64_t match_idx, bool& is_offender_win)
 {
@@ -39,28 +39,48 @@ class ObScanMergeLoserTreeCmp {
 public:
   typedef common::ObFixedArray<ObRowkeyObjComparer*, common::ObIAllocator> RowkeyCmpFuncArray;
   ObScanMergeLoserTreeCmp()
-      : cmp_funcs_(), rowkey_size_(0), error_(common::OB_SUCCESS), reverse_(false), is_inited_(false)
+      : cmp_funcs_(),
+        rowkey_size_(0),
+        error_(common::OB_SUCCESS),
+        reverse_(false),
+        is_int_rowkey_(false),
+        is_inited_(false)
   {}
   ~ObScanMergeLoserTreeCmp() = default;
   void reset();
   int init(const int64_t rowkey_size, const ObColDescIArray& col_descs, const bool reverse, const bool is_oracle_mode,
       const bool use_cmp_nullsafe, ObIAllocator& allocator);
   int64_t operator()(const ObScanMergeLoserTreeItem& l, const ObScanMergeLoserTreeItem& r);
+  // compare the upper bound rowkey of an iterator in range %scan_index with the row of %r,
+  // only the first rowkey_size_ objs of %bound are compared
+  int64_t compare_upper_bound(
+      const common::ObStoreRowkey& bound, const int64_t scan_index, const ObScanMergeLoserTreeItem& r);
   OB_INLINE int get_error_code() const
   {
     return error_;
   }
+  OB_INLINE bool is_reverse() const
+  {
+    return reverse_;
+  }
+  OB_INLINE int64_t get_rowkey_size() const
+  {
+    return rowkey_size_;
+  }
   static int compare_rowkey(const ObStoreRow& l_row, const ObStoreRow& r_row, const int64_t& rowkey_size,
       RowkeyCmpFuncArray& cmp_funcs, int32_t& cmp_result);
 
 private:
   template <typename T>
   int make_rowkey_cmp_funcs(const int64_t rowkey_size, const ObColDescIArray& col_descs, ObIAllocator& allocator);
+  OB_INLINE int compare_rowkey_objs(const common::ObObj* l_objs, const common::ObObj* r_objs, int32_t& cmp_result);
 
   RowkeyCmpFuncArray cmp_funcs_;
   int64_t rowkey_size_;
   int error_;
   bool reverse_;
+  // all rowkey columns are integers, compare int values inline instead of calling cmp funcs
+  bool is_int_rowkey_;
   bool is_inited_;
 };
 
@@ -69,8 +89,16 @@ typedef common::ObLoserTree<ObScanMergeLoserTreeItem, ObScanMergeLoserTreeCmp, c
 class ObScanMergeLoserTree : public ObScanMergeLoserTreeBase {
 public:
   ObScanMergeLoserTree(ObScanMergeLoserTreeCmp& cmp)
-      : ObScanMergeLoserTreeBase(cmp), has_king_(false), is_king_eq_champion_(false), king_()
-  {}
+      : ObScanMergeLoserTreeBase(cmp),
+        has_king_(false),
+        is_king_eq_champion_(false),
+        king_(),
+        stream_iter_idx_(-1),
+        stream_scan_index_(0),
+        is_stream_checked_(false)
+  {
+    MEMSET(upper_bounds_, 0, sizeof(upper_bounds_));
+  }
   virtual ~ObScanMergeLoserTree() = default;
 
   virtual int init(const int64_t total_player_cnt, common::ObIAllocator& allocator) override;
@@ -86,6 +114,11 @@ public:
   // for performance and simplicity, caller should ensure there's no old king here
   virtual int push_top(const ObScanMergeLoserTreeItem& player);
 
+  // set the max rowkey the iterator may output, only used in forward scan.
+  // when the upper bound is less than the champion, rows of the iterator can be streamed
+  // as king one after another without any compare until the champion changes.
+  int set_upper_bound(const int64_t iter_idx, const common::ObStoreRowkey& bound);
+
   virtual OB_INLINE int count() const override
   {
     const int64_t tree_cnt = ObScanMergeLoserTreeBase::count();
@@ -105,11 +138,24 @@ protected:
       bool& is_offender_win) override;
 
 private:
+  OB_INLINE void reset_stream()
+  {
+    stream_iter_idx_ = -1;
+    is_stream_checked_ = false;
+  }
+  int try_stream(const ObScanMergeLoserTreeItem& player, const int64_t champion, bool& is_streaming);
+
   // optimization for only the top item get pop. Usually, the next row from same iter will still be
   // the max/min row. So it can be cached in king_ without rebuilding the whole tree
   bool has_king_;
   bool is_king_eq_champion_;
   ObScanMergeLoserTreeItem king_;
+  const common::ObStoreRowkey* upper_bounds_[common::MAX_TABLE_CNT_IN_STORAGE];
+  // iterator whose rows are all less than the champion, and the scan_index_ of the rows
+  int64_t stream_iter_idx_;
+  int64_t stream_scan_index_;
+  // upper bound of the king has been compared with the current champion
+  bool is_stream_checked_;
 };
 }  // namespace storage
 }  // namespace oceanbase
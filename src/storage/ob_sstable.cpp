@@ -2566,6 +2566,7 @@ int ObSSTable::exist(ObRowsInfo& rows_info, bool& is_exist, bool& all_rows_found
 {
   int ret = OB_SUCCESS;
   ObFullMacroBlockMeta full_meta;
+  bool may_contain = true;
   is_exist = false;
 
   if (!rows_info.is_valid() || rows_info.table_id_ != meta_.index_id_) {
@@ -2591,6 +2592,9 @@ int ObSSTable::exist(ObRowsInfo& rows_info, bool& is_exist, bool& all_rows_found
     } else if (rows_info.ext_rowkeys_.count() == 0) {  // skip
       STORAGE_LOG(INFO, "Skip unexpected empty ext_rowkeys", K(rows_info), K(ret));
       all_rows_found = true;
+    } else if (OB_FAIL(bf_may_contain_rowkeys(rows_info, may_contain))) {
+      STORAGE_LOG(WARN, "Failed to check rowkeys with bloomfilter", K(rows_info), K(ret));
+    } else if (!may_contain) {  // skip
     } else {
       ObStoreRowIterator* iter = NULL;
       const ObStoreRow* store_row = NULL;
@@ -2948,6 +2952,42 @@ int ObSSTable::build_exist_iterator(const ObTableIterParam& iter_param, ObTableA
   return ret;
 }
 
+int ObSSTable::bf_may_contain_rowkeys(ObRowsInfo& rows_info, bool& may_contain)
+{
+  int ret = OB_SUCCESS;
+  ObTableAccessContext& access_ctx = rows_info.exist_helper_.table_access_context_;
+  may_contain = true;
+  if (!has_bloom_filter_macro_block() || !access_ctx.enable_sstable_bf_cache()) {
+  } else {
+    may_contain = false;
+    for (int64_t i = 0; OB_SUCC(ret) && !may_contain && i < rows_info.ext_rowkeys_.count(); ++i) {
+      const ObStoreRowkey& rowkey = rows_info.ext_rowkeys_.at(i).get_store_rowkey();
+      bool is_contain = true;
+      if (rowkey.is_max()) {
+        // found rowkey
+      } else if (get_rowkey_column_count() != rowkey.get_obj_cnt()) {
+        may_contain = true;
+      } else if (OB_FAIL(bf_may_contain_rowkey(rowkey, is_contain))) {
+        if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != ret)) {
+          STORAGE_LOG(WARN, "fail to check if rowkey may contain in sstable bloomfilter", K(ret), K(rowkey));
+        }
+        // bloomfilter is not loaded yet
+        ret = OB_SUCCESS;
+        may_contain = true;
+      } else {
+        may_contain = is_contain;
+        ++access_ctx.access_stat_.sstable_bf_access_cnt_;
+        ++access_ctx.access_stat_.bf_access_cnt_;
+        if (!is_contain) {
+          ++access_ctx.access_stat_.sstable_bf_filter_cnt_;
+          ++access_ctx.access_stat_.bf_filter_cnt_;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObSSTable::build_multi_exist_iterator(ObRowsInfo& rows_info, ObStoreRowIterator*& iter)
 {
   int ret = OB_SUCCESS;
@@ -376,6 +376,8 @@ private:
   int build_exist_iterator(const ObTableIterParam& iter_param, ObTableAccessContext& access_context,
       const ObExtStoreRowkey& ext_rowkey, ObStoreRowIterator*& iter);
   int build_multi_exist_iterator(ObRowsInfo& rows_info, ObStoreRowIterator*& iter);
+  // may_contain is false only if all rowkeys are filtered by the sstable bloom filter
+  int bf_may_contain_rowkeys(ObRowsInfo& rows_info, bool& may_contain);
   int check_logical_data_version(const common::ObIArray<blocksstable::ObFullMacroBlockMeta>& block_metas);
   int build_block_meta_map();
   int build_logic_block_id_map();
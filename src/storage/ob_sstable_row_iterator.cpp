@@ -15,6 +15,8 @@
 #include "share/config/ob_server_config.h"
 #include "lib/stat/ob_diagnose_info.h"
 #include "blocksstable/ob_lob_data_reader.h"
+#include "blocksstable/ob_block_cache_working_set.h"
+#include "blocksstable/ob_micro_block_zone_map.h"
 #include "storage/ob_file_system_util.h"
 
 using namespace oceanbase::common;
@@ -158,6 +160,10 @@ int ObSSTableMicroBlockInfoIterator::open(ObSSTableRowIterator* iter, ObSSTableR
       if (OB_BEYOND_THE_RANGE != ret) {
         STORAGE_LOG(WARN, "Fail to search blocks, ", K(ret), K(read_handle));
       }
+    } else if (NULL != iter->get_pushdown_filter() && OB_FAIL(filter_micro_blocks(*iter, read_handle, *handle))) {
+      if (OB_BEYOND_THE_RANGE != ret) {
+        STORAGE_LOG(WARN, "Fail to filter micro blocks, ", K(ret), K(read_handle));
+      }
     }
   }
 
@@ -180,6 +186,54 @@ int ObSSTableMicroBlockInfoIterator::open(ObSSTableRowIterator* iter, ObSSTableR
   return ret;
 }
 
+int ObSSTableMicroBlockInfoIterator::filter_micro_blocks(
+    ObSSTableRowIterator& iter, ObSSTableReadHandle& read_handle, ObMicroBlockIndexHandle& index_handle)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockIndexMgr* index_mgr = NULL;
+  const ObMacroBlockSchemaInfo* schema = read_handle.full_meta_.schema_;
+  sql::ObPushdownFilterExecutor* filter = iter.get_pushdown_filter();
+  ObMicroBlockZoneMapReader zone_map_reader;
+  bool can_skip = false;
+  if (OB_ISNULL(filter) || OB_ISNULL(schema) || OB_ISNULL(schema->column_id_array_)) {
+    // nothing to do
+  } else if (OB_SUCCESS != index_handle.get_block_index_mgr(index_mgr) || OB_ISNULL(index_mgr) ||
+             index_mgr->get_zone_map_size() <= 0) {
+    // macro block without zone map
+  } else if (OB_FAIL(zone_map_reader.init(index_mgr->get_zone_map(), index_mgr->get_zone_map_size()))) {
+    STORAGE_LOG(WARN, "Fail to init zone map reader", K(ret));
+  } else if (OB_FAIL(ObMicroBlockZoneMapReader::init_filter_params(*filter))) {
+    STORAGE_LOG(WARN, "Fail to init filter params", K(ret));
+  } else if (OB_FAIL(zone_map_reader.can_skip(*filter,
+                 schema->column_id_array_,
+                 schema->column_number_,
+                 zone_map_reader.get_macro_entry_idx(),
+                 can_skip))) {
+    STORAGE_LOG(WARN, "Fail to check macro block zone map", K(ret));
+  } else if (can_skip) {
+    micro_block_infos_.reuse();
+    ret = OB_BEYOND_THE_RANGE;
+  } else {
+    int64_t count = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < micro_block_infos_.count(); ++i) {
+      const ObMicroBlockInfo& micro_info = micro_block_infos_.at(i);
+      if (OB_FAIL(zone_map_reader.can_skip(
+              *filter, schema->column_id_array_, schema->column_number_, micro_info.index_, can_skip))) {
+        STORAGE_LOG(WARN, "Fail to check micro block zone map", K(ret), K(micro_info));
+      } else if (!can_skip) {
+        micro_block_infos_.at(count++) = micro_info;
+      }
+    }
+    while (OB_SUCC(ret) && micro_block_infos_.count() > count) {
+      micro_block_infos_.pop_back();
+    }
+    if (OB_SUCC(ret) && 0 == count) {
+      ret = OB_BEYOND_THE_RANGE;
+    }
+  }
+  return ret;
+}
+
 int ObSSTableMicroBlockInfoIterator::get_next_micro(ObSSTableMicroBlockInfo& sstable_micro)
 {
   int ret = OB_SUCCESS;
@@ -428,7 +482,11 @@ ObSSTableRowIterator::ObSSTableRowIterator()
       io_micro_infos_(),
       micro_info_iter_(),
       prefetch_handle_depth_(DEFAULT_PREFETCH_HANDLE_DEPTH),
-      prefetch_micro_depth_(DEFAULT_PREFETCH_MICRO_DEPTH)
+      prefetch_micro_depth_(DEFAULT_PREFETCH_MICRO_DEPTH),
+      prefetch_micro_limit_(0),
+      is_io_waited_(false),
+      prefetch_micro_size_(0),
+      prefetch_micro_cnt_(0)
 {}
 
 ObSSTableRowIterator::~ObSSTableRowIterator()
@@ -489,6 +547,7 @@ int ObSSTableRowIterator::inner_open(
     micro_info_iter_.set_reverse(access_ctx_->query_flag_.is_reverse_scan());
     table_store_stat_.pkey_ = access_ctx_->pkey_;
     block_cache_ = &(ObStorageCacheSuite::get_instance().get_block_cache());
+    prefetch_micro_limit_ = get_init_prefetch_micro_limit();
     if (OB_FAIL(ret)) {
     } else if (OB_ISNULL(storage_file_ = sstable_->get_storage_file_handle().get_storage_file())) {
       ret = OB_ERR_UNEXPECTED;
@@ -638,6 +697,10 @@ void ObSSTableRowIterator::reset()
   storage_file_ = nullptr;
   prefetch_handle_depth_ = DEFAULT_PREFETCH_HANDLE_DEPTH;
   prefetch_micro_depth_ = DEFAULT_PREFETCH_MICRO_DEPTH;
+  prefetch_micro_limit_ = 0;
+  is_io_waited_ = false;
+  prefetch_micro_size_ = 0;
+  prefetch_micro_cnt_ = 0;
 }
 
 void ObSSTableRowIterator::reuse()
@@ -671,6 +734,10 @@ void ObSSTableRowIterator::reuse()
   storage_file_ = nullptr;
   prefetch_handle_depth_ = DEFAULT_PREFETCH_HANDLE_DEPTH;
   prefetch_micro_depth_ = DEFAULT_PREFETCH_MICRO_DEPTH;
+  prefetch_micro_limit_ = 0;
+  is_io_waited_ = false;
+  prefetch_micro_size_ = 0;
+  prefetch_micro_cnt_ = 0;
 }
 
 int ObSSTableRowIterator::get_read_handle(const ObExtStoreRowkey& ext_rowkey, ObSSTableReadHandle& read_handle)
@@ -816,6 +883,9 @@ int ObSSTableRowIterator::prefetch()
   int64_t prefetching_micro_handle_cnt = cur_fetch_handle_pos_ - cur_read_handle_pos_;
 
   if (!prefetch_block_end_) {
+    if (is_io_waited_) {
+      extend_prefetch_micro_limit();
+    }
     if (!prefetch_handle_end_) {
       // prefetch read handle
       if (prefetching_handle_cnt <= read_handle_cnt_ / 2 && prefetching_handle_cnt <= prefetch_handle_depth_ / 4) {
@@ -831,8 +901,8 @@ int ObSSTableRowIterator::prefetch()
       if ((prefetching_micro_cnt <= micro_handle_cnt_ / 2 && prefetching_micro_cnt <= prefetch_micro_depth_ / 4) ||
           0 == prefetching_micro_handle_cnt || 0 == prefetching_micro_cnt) {
         // prefetching micro count is less than free micro count and prefetch micro depth
-        prefetch_micro_cnt = std::min(micro_handle_cnt_ - prefetching_micro_cnt, prefetch_micro_depth_);
-        prefetch_micro_depth_ = min(micro_handle_cnt_, prefetch_micro_depth_ * 2);
+        prefetch_micro_cnt = std::min(prefetch_micro_limit_ - prefetching_micro_cnt, prefetch_micro_depth_);
+        prefetch_micro_depth_ = min(prefetch_micro_limit_, prefetch_micro_depth_ * 2);
       }
     }
     STORAGE_LOG(DEBUG,
@@ -840,6 +910,7 @@ int ObSSTableRowIterator::prefetch()
         K(prefetching_micro_handle_cnt),
         K(prefetching_micro_cnt),
         K(prefetch_micro_depth_),
+        K(prefetch_micro_limit_),
         K(prefetch_micro_cnt),
         K(prefetch_handle_depth_),
         K(prefetch_handle_cnt),
@@ -850,7 +921,7 @@ int ObSSTableRowIterator::prefetch()
       if (OB_FAIL(micro_info_iter_.get_next_micro(sstable_micro_infos_[sstable_micro_cnt]))) {
         if (OB_ITER_END == ret) {
           ret = OB_SUCCESS;
-          if ((micro_handle_cnt_ >= LIMIT_PREFETCH_BLOCK_CACHE_THRESHOLD &&
+          if ((read_handle_cnt_ >= LIMIT_PREFETCH_BLOCK_CACHE_THRESHOLD &&
                   cur_fetch_handle_pos_ > (cur_prefetch_handle_pos_ + cur_read_handle_pos_) / 2)) {
             break;
           } else if (cur_fetch_handle_pos_ >= cur_prefetch_handle_pos_) {
@@ -873,6 +944,8 @@ int ObSSTableRowIterator::prefetch()
           STORAGE_LOG(WARN, "Fail to get next sstable micro info, ", K(ret));
         }
       } else {
+        prefetch_micro_size_ += sstable_micro_infos_[sstable_micro_cnt].micro_info_.size_;
+        ++prefetch_micro_cnt_;
         sorted_sstable_micro_infos_[sstable_micro_cnt] = sstable_micro_infos_[sstable_micro_cnt];
         sstable_micro_cnt += sstable_micro_infos_[sstable_micro_cnt].is_skip_ ? 0 : 1;
         total_sstable_micro_cnt++;
@@ -898,6 +971,28 @@ int ObSSTableRowIterator::prefetch()
   return ret;
 }
 
+// Double the prefetch window when the scan waits for io with a full window, the prefetched
+// micro blocks should not exceed half of the block cache working set.
+void ObSSTableRowIterator::extend_prefetch_micro_limit()
+{
+  is_io_waited_ = false;
+  if (prefetch_micro_depth_ >= prefetch_micro_limit_ && prefetch_micro_limit_ < micro_handle_cnt_) {
+    int64_t max_limit = micro_handle_cnt_;
+    if (NULL != access_ctx_->block_cache_ws_ && access_ctx_->block_cache_ws_->inited() && prefetch_micro_cnt_ > 0) {
+      const int64_t avg_micro_size = max(1L, prefetch_micro_size_ / prefetch_micro_cnt_);
+      const int64_t ws_micro_cnt = access_ctx_->block_cache_ws_->get_limit() / 2 / avg_micro_size;
+      max_limit = min(max_limit, max(prefetch_micro_limit_, ws_micro_cnt));
+    }
+    prefetch_micro_limit_ = min(max_limit, prefetch_micro_limit_ * 2);
+    STORAGE_LOG(DEBUG,
+        "extend prefetch micro limit",
+        K_(prefetch_micro_limit),
+        K_(prefetch_micro_depth),
+        K_(prefetch_micro_size),
+        K_(prefetch_micro_cnt));
+  }
+}
+
 int ObSSTableRowIterator::prefetch_handle(const int64_t prefetch_handle_cnt)
 {
   int ret = OB_SUCCESS;
@@ -1177,11 +1272,18 @@ int ObSSTableRowIterator::get_block_data(const int64_t micro_block_idx, ObMicroB
         K(ret),
         K(micro_block_idx),
         K_(cur_prefetch_micro_pos));
-  } else if (OB_FAIL(micro_handles_[micro_block_idx % micro_handle_cnt_].get_block_data(
-                 block_reader_, storage_file_, block_data))) {
-    STORAGE_LOG(WARN, "Fail to get block data, ", K(ret), K(micro_block_idx));
   } else {
-    cur_read_micro_pos_ = micro_block_idx;
+    ObMicroBlockDataHandle& micro_handle = micro_handles_[micro_block_idx % micro_handle_cnt_];
+    const bool is_in_io = ObSSTableMicroBlockState::IN_BLOCK_IO == micro_handle.block_state_;
+    const int64_t begin_time = is_in_io ? ObTimeUtility::current_time() : 0;
+    if (OB_FAIL(micro_handle.get_block_data(block_reader_, storage_file_, block_data))) {
+      STORAGE_LOG(WARN, "Fail to get block data, ", K(ret), K(micro_block_idx));
+    } else {
+      cur_read_micro_pos_ = micro_block_idx;
+      if (is_in_io && ObTimeUtility::current_time() - begin_time > PREFETCH_IO_WAIT_THRESHOLD_US) {
+        is_io_waited_ = true;
+      }
+    }
   }
   return ret;
 }
@@ -135,6 +135,9 @@ public:
   }
 
 private:
+  // remove micro blocks that no row can pass the pushed down filter by zone map
+  int filter_micro_blocks(ObSSTableRowIterator& iter, ObSSTableReadHandle& read_handle,
+      ObMicroBlockIndexHandle& index_handle);
   OB_INLINE int64_t get_micro_block_info_count()
   {
     return !is_get_ ? micro_block_infos_.count() : (micro_info_.is_valid() ? 1 : 0);
@@ -327,6 +330,13 @@ public:
   virtual int get_gap_end(int64_t& range_idx, const common::ObStoreRowkey*& gap_key, int64_t& gap_size) override;
   virtual int report_stat() override;
   virtual const common::ObIArray<ObRowkeyObjComparer*>* get_rowkey_cmp_funcs();
+  // filter pushed down to storage, NULL if rows of this iterator are not filtered in storage
+  OB_INLINE sql::ObPushdownFilterExecutor* get_pushdown_filter()
+  {
+    return (nullptr != access_ctx_ && access_ctx_->enable_pushdown_filter_ && nullptr != iter_param_)
+               ? iter_param_->pushdown_filters_
+               : nullptr;
+  }
   int get_cur_micro_row_count(int64_t& row_count);
   int get_cur_read_handle(ObSSTableReadHandle*& read_handle);
   int get_cur_micro_idx_in_macro(int64_t& micro_idx);
@@ -344,6 +354,11 @@ protected:
   virtual int prefetch_read_handle(ObSSTableReadHandle& read_handle) = 0;
   virtual int fetch_row(ObSSTableReadHandle& read_handle, const ObStoreRow*& store_row) = 0;
   virtual int get_range_count(const void* query_range, int64_t& range_count) const = 0;
+  // initial upper bound of prefetch micro depth, it is raised up to micro_handle_cnt_ when reads wait for io
+  virtual int64_t get_init_prefetch_micro_limit() const
+  {
+    return micro_handle_cnt_;
+  }
   int get_read_handle(const common::ObExtStoreRowkey& ext_rowkey, ObSSTableReadHandle& read_handle);
   int get_row(ObSSTableReadHandle& read_handle, const ObStoreRow*& store_row);
   int exist_row(ObSSTableReadHandle& read_handle, ObStoreRow& store_row);
@@ -359,6 +374,7 @@ private:
   int prefetch();
   int prefetch_handle(const int64_t prefetch_handle_cnt);
   int prefetch_block(const int64_t sstable_micro_cnt);
+  void extend_prefetch_micro_limit();
   int submit_block_io(blocksstable::ObMultiBlockIOParam& io_param, MicroInfoArray& sstable_micro_infos,
       const int64_t start_sstable_micro_idx, const int64_t end_sstable_micro_idx);
   int alloc_micro_getter();
@@ -375,6 +391,7 @@ protected:
   static const int64_t LIMIT_PREFETCH_BLOCK_CACHE_THRESHOLD = 100;
   static const int64_t DEFAULT_PREFETCH_HANDLE_DEPTH = 4;
   static const int64_t DEFAULT_PREFETCH_MICRO_DEPTH = 4;
+  static const int64_t PREFETCH_IO_WAIT_THRESHOLD_US = 200;
   const ObTableIterParam* iter_param_;
   ObTableAccessContext* access_ctx_;
   ObSSTable* sstable_;
@@ -423,6 +440,10 @@ private:
   ObSSTableMicroBlockInfoIterator micro_info_iter_;
   int64_t prefetch_handle_depth_;
   int64_t prefetch_micro_depth_;
+  int64_t prefetch_micro_limit_;  // upper bound of prefetch_micro_depth_
+  bool is_io_waited_;             // read waited for prefetch io since the limit is raised
+  int64_t prefetch_micro_size_;   // total size of prefetched micro blocks
+  int64_t prefetch_micro_cnt_;    // count of prefetched micro blocks
 };
 
 }  // namespace storage
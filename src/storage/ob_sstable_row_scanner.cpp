@@ -11,6 +11,7 @@
  */
 
 #include "ob_sstable_row_scanner.h"
+#include "share/config/ob_server_config.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::blocksstable;
@@ -72,7 +73,8 @@ int ObSSTableRowScanner::get_handle_cnt(const void* query_range, int64_t& read_h
     STORAGE_LOG(WARN, "Invalid argument, ", K(ret));
   } else {
     read_handle_cnt = SCAN_READ_HANDLE_CNT;
-    micro_handle_cnt = SCAN_MICRO_HANDLE_CNT;
+    // micro handles are allocated at open, a new value takes effect on the scans opened later
+    micro_handle_cnt = GCONF._sstable_scan_max_prefetch_micro_cnt;
   }
   return ret;
 }
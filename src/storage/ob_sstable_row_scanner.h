@@ -44,6 +44,10 @@ protected:
   int prefetch_block_index(const uint64_t table_id, const blocksstable::ObMacroBlockCtx& block_ctx,
       ObMicroBlockIndexHandle& block_index_handle);
   virtual int get_range_count(const void* query_range, int64_t& range_count) const override;
+  virtual int64_t get_init_prefetch_micro_limit() const override
+  {
+    return micro_handle_cnt_ < SCAN_PREFETCH_MICRO_LIMIT ? micro_handle_cnt_ : SCAN_PREFETCH_MICRO_LIMIT;
+  }
 
 private:
   int skip_batch_rows(
@@ -51,7 +55,11 @@ private:
 
 protected:
   static const int64_t SCAN_READ_HANDLE_CNT = 4;
-  static const int64_t SCAN_MICRO_HANDLE_CNT = 32;
+  // The ring of micro handles has _sstable_scan_max_prefetch_micro_cnt slots, each of them
+  // costs a micro handle and two micro infos (about 370 bytes), 47K for the default 128 and
+  // 12K for 32. The window starts from SCAN_PREFETCH_MICRO_LIMIT and grows only when reads
+  // wait for io, so the blocks pinned by a cached scan stay the same as a ring of 32.
+  static const int64_t SCAN_PREFETCH_MICRO_LIMIT = 32;
   static const int64_t SCAN_DEFAULT_MACRO_BLOCK_CNT = 2;
   bool has_find_macro_;
   int64_t prefetch_macro_idx_;
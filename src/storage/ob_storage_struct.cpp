@@ -396,7 +396,8 @@ AddTableParam::AddTableParam()
       need_prewarm_(false),
       is_daily_merge_(false),
       complement_minor_sstable_(nullptr),
-      schema_version_(0)
+      schema_version_(0),
+      replaced_major_(nullptr)
 {}
 
 bool AddTableParam::is_valid() const
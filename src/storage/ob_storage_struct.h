@@ -342,7 +342,7 @@ struct AddTableParam {
   bool is_valid() const;
   TO_STRING_KV(KP_(table), K_(max_kept_major_version_number), K_(multi_version_start),
       K_(in_slog_trans), K_(need_prewarm), K_(is_daily_merge),
-      KP_(complement_minor_sstable), K_(schema_version));
+      KP_(complement_minor_sstable), K_(schema_version), KP_(replaced_major));
 
   storage::ObSSTable* table_;
   int64_t max_kept_major_version_number_;
@@ -352,6 +352,7 @@ struct AddTableParam {
   bool is_daily_merge_;
   storage::ObSSTable* complement_minor_sstable_;
   int64_t schema_version_;
+  storage::ObSSTable* replaced_major_;  // direct load: table_ takes the place of this major sstable
 };
 
 struct ObPartitionReadableInfo {
@@ -511,7 +511,7 @@ int ObTableStore::build_new_merge_store(const AddTableParam &param, ObTablesHand
         LOG_WARN("failed to replace_memtable_with_minor_sstable", K(ret), K(param), K(old_handle));
       }
     } else if (param.table_->is_major_sstable()) {
-      if (OB_FAIL(add_major_sstable(param.table_, major_tables))) {
+      if (OB_FAIL(add_major_sstable(param.table_, major_tables, param.replaced_major_))) {
         LOG_WARN("failed to build major merge store", K(ret));
       }
     } else {
@@ -619,7 +619,8 @@ int ObTableStore::add_trans_sstable(ObSSTable *new_table, ObIArray<ObITable *> &
   return ret;
 }
 
-int ObTableStore::add_major_sstable(ObSSTable *new_table, ObArray<ObITable *> &major_tables)
+int ObTableStore::add_major_sstable(
+    ObSSTable *new_table, ObArray<ObITable *> &major_tables, const ObSSTable *replaced_major)
 {
   int ret = OB_SUCCESS;
   bool need_add = true;
@@ -636,7 +637,14 @@ int ObTableStore::add_major_sstable(ObSSTable *new_table, ObArray<ObITable *> &m
     } else if (table->get_key().pkey_ == new_table->get_key().pkey_ &&
                table->get_key().version_.major_ == new_table->get_key().version_.major_) {
       LOG_DEBUG("add major sstables", K(table->get_key()), K(new_table->get_key()));
-      if (table->get_key() != new_table->get_key()) {
+      if (table->get_key() == new_table->get_key()) {
+        // already added
+      } else if (nullptr != replaced_major && table == replaced_major) {
+        // direct load sstable takes the place of the empty major sstable it was built on, or the other way
+        // round when the load is rolled back
+        FLOG_INFO("replace major sstable", "old_key", table->get_key(), "new_key", new_table->get_key());
+        major_tables.at(i) = new_table;
+      } else {
         ret = OB_ERR_SYS;
         LOG_ERROR("major version same but table key not match", K(ret), KPC(table), KPC(new_table));
       }
@@ -168,7 +168,8 @@ private:
   int classify_tables(const ObTablesHandle &old_handle, common::ObArray<ObITable *> &major_tables,
       common::ObArray<ObITable *> &inc_tables);
   int add_trans_sstable(ObSSTable *new_table, common::ObIArray<ObITable *> &trans_tables);
-  int add_major_sstable(ObSSTable *new_table, common::ObArray<ObITable *> &major_tables);
+  int add_major_sstable(
+      ObSSTable *new_table, common::ObArray<ObITable *> &major_tables, const ObSSTable *replaced_major = nullptr);
   int add_minor_sstable(
       const bool need_safe_check, common::ObIArray<ObITable *> &inc_tables, storage::ObSSTable *new_table);
   bool check_include_by_log_ts_range(ObITable &a, ObITable &b);
@@ -283,16 +283,30 @@ int ObPartitionTransCtxMgr::get_trans_ctx(const ObTransID& trans_id, const bool
     const bool wait_init /*true*/)
 {
   int ret = OB_SUCCESS;
-  RLockGuard guard(rwlock_);
 
-  if (OB_FAIL(get_trans_ctx_(trans_id,
-          for_replay,
-          is_readonly,
-          is_bounded_staleness_read,
-          need_completed_dirty_txn,
-          alloc,
-          ctx,
-          wait_init))) {
+  if (!alloc) {
+    // pure lookup reads no partition state and the ctx map is lock free, so it
+    // does not need rwlock_, the same as acquire_ctx_ref
+    ret = get_trans_ctx_(trans_id,
+        for_replay,
+        is_readonly,
+        is_bounded_staleness_read,
+        need_completed_dirty_txn,
+        alloc,
+        ctx,
+        wait_init);
+  } else {
+    RLockGuard guard(rwlock_);
+    ret = get_trans_ctx_(trans_id,
+        for_replay,
+        is_readonly,
+        is_bounded_staleness_read,
+        need_completed_dirty_txn,
+        alloc,
+        ctx,
+        wait_init);
+  }
+  if (OB_FAIL(ret)) {
     TRANS_LOG(DEBUG, "get transaction context error", K(trans_id), K(for_replay), K(is_readonly), K(alloc));
   } else {
     // do nothing
@@ -3647,6 +3661,85 @@ int ObPartTransCtxMgr::get_trans_ctx(const ObPartitionKey& partition, const ObTr
   return ret;
 }
 
+int ObPartTransCtxMgr::get_trans_ctxs(const ObPartitionArray& partitions, const ObTransID& trans_id,
+    ObIArray<ObTransCtx*>& ctxs, ObIArray<int>& rets)
+{
+  int ret = OB_SUCCESS;
+  const bool for_replay = false;
+  const bool is_readonly = false;
+  const bool is_bounded_staleness_read = false;
+  const bool need_completed_dirty_txn = false;
+
+  DRWLock::RDLockGuard guard(rwlock_);
+
+  ctxs.reuse();
+  rets.reuse();
+  if (IS_NOT_INIT) {
+    TRANS_LOG(WARN, "ObPartTransCtxMgr not inited");
+    ret = OB_NOT_INIT;
+  } else if (OB_UNLIKELY(partitions.count() <= 0 || !trans_id.is_valid())) {
+    TRANS_LOG(WARN, "invalid argument", K(partitions), K(trans_id));
+    ret = OB_INVALID_ARGUMENT;
+  } else if (OB_UNLIKELY(!is_running_)) {
+    TRANS_LOG(WARN, "ObPartTransCtxMgr is not running");
+    ret = OB_NOT_RUNNING;
+  } else if (OB_FAIL(ctxs.reserve(partitions.count()))) {
+    TRANS_LOG(WARN, "reserve transaction context array error", KR(ret), K(partitions));
+  } else if (OB_FAIL(rets.reserve(partitions.count()))) {
+    TRANS_LOG(WARN, "reserve return code array error", KR(ret), K(partitions));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < partitions.count(); ++i) {
+      const ObPartitionKey& partition = partitions.at(i);
+      ObPartitionTransCtxMgr* ctx_mgr = NULL;
+      ObTransCtx* ctx = NULL;
+      bool alloc = false;
+      // failure of one partition goes to its own entry, the same as looking up one by one
+      int part_ret = OB_SUCCESS;
+      if (OB_ISNULL(ctx_mgr = get_partition_trans_ctx_mgr(partition))) {
+        TRANS_LOG(DEBUG, "partition transaction context manager not exist", K(partition));
+        part_ret = OB_PARTITION_NOT_EXIST;
+      } else if (OB_SUCCESS != (part_ret = ctx_mgr->get_trans_ctx(trans_id,
+                                    for_replay,
+                                    is_readonly,
+                                    is_bounded_staleness_read,
+                                    need_completed_dirty_txn,
+                                    alloc,
+                                    ctx))) {
+        if (OB_TRANS_CTX_NOT_EXIST != part_ret) {
+          TRANS_LOG(WARN, "get transaction context error", K(part_ret), K(partition), K(trans_id));
+        }
+        ctx = NULL;
+      } else if (OB_ISNULL(ctx)) {
+        TRANS_LOG(WARN, "transaction context is null", K(partition), K(trans_id));
+        part_ret = OB_ERR_UNEXPECTED;
+      } else {
+        // do nothing
+      }
+      if (OB_FAIL(ctxs.push_back(ctx))) {
+        TRANS_LOG(WARN, "push back transaction context error", KR(ret), K(partition), K(trans_id));
+        if (NULL != ctx) {
+          (void)ctx_mgr->revert_trans_ctx(ctx);
+        }
+      } else if (OB_FAIL(rets.push_back(part_ret))) {
+        // ctx is reverted with the others below
+        TRANS_LOG(WARN, "push back return code error", KR(ret), K(partition), K(trans_id));
+      }
+    }
+    if (OB_FAIL(ret)) {
+      // rwlock_ is held, revert by partition mgr directly
+      for (int64_t i = 0; i < ctxs.count(); ++i) {
+        if (NULL != ctxs.at(i)) {
+          (void)ctxs.at(i)->get_partition_mgr()->revert_trans_ctx(ctxs.at(i));
+        }
+      }
+      ctxs.reuse();
+      rets.reuse();
+    }
+  }
+
+  return ret;
+}
+
 int ObPartTransCtxMgr::get_cached_pg_guard(const ObPartitionKey& partition, storage::ObIPartitionGroupGuard*& pg_guard)
 {
   int ret = OB_SUCCESS;
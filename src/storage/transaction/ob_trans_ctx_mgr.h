@@ -900,6 +900,13 @@ public:
   int get_trans_ctx(const common::ObPartitionKey& partition, const ObTransID& trans_id, const bool for_replay,
       const bool is_readonly, const bool is_bounded_staleness_read, const bool need_completed_dirty_txn, bool& alloc,
       ObTransCtx*& ctx);
+  // look up contexts of %trans_id on %partitions with rwlock_ held once, used by
+  // messages batched for partitions of the same leader. rets.at(i) is the lookup
+  // result of partitions.at(i) and ctxs.at(i) is NULL unless it is OB_SUCCESS,
+  // caller reverts the others. Returns error only if the batch itself fails, in
+  // which case both arrays are empty.
+  int get_trans_ctxs(const common::ObPartitionArray& partitions, const ObTransID& trans_id,
+      common::ObIArray<ObTransCtx*>& ctxs, common::ObIArray<int>& rets);
 
   int add_partition(const common::ObPartitionKey& partition);
   int block_partition(const common::ObPartitionKey& partition, bool& is_all_trans_clear);
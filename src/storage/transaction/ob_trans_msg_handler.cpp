@@ -367,6 +367,41 @@ int ObTransMsgHandler::part_ctx_handle_request_helper_(
   return ret;
 }
 
+int ObTransMsgHandler::part_ctx_handle_batch_request_(ObTrxMsgBase& msg, const int64_t msg_type)
+{
+  int ret = OB_SUCCESS;
+  int batch_ret = OB_SUCCESS;
+  const ObPartitionArray& batch_partitions = msg.batch_same_leader_partitions_;
+  ObSEArray<ObTransCtx*, 16> ctxs;
+  ObSEArray<int, 16> rets;
+
+  if (OB_SUCCESS != (batch_ret = part_trans_ctx_mgr_->get_trans_ctxs(batch_partitions, msg.trans_id_, ctxs, rets))) {
+    // every partition is handled as an orphan below, the same as a failed lookup of one partition
+    TRANS_LOG(WARN, "get transaction contexts error", K(batch_ret), K(msg));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < batch_partitions.count(); i++) {
+    ObTransCtx* ctx = (i < ctxs.count() ? ctxs.at(i) : NULL);
+    msg.receiver_ = batch_partitions.at(i);
+    if (OB_FAIL(txs_->check_partition_status(msg.receiver_))) {
+      TRANS_LOG(WARN, "check partition status failed", K(ret), K(msg));
+    } else if (NULL == ctx) {
+      TRANS_LOG(DEBUG, "get transaction context error", "ctx_ret", (i < rets.count() ? rets.at(i) : batch_ret), K(msg));
+      if (OB_FAIL(orphan_msg_helper_(msg, msg_type))) {
+        TRANS_LOG(WARN, "orphan msg helper failed", K(ret), K(msg));
+      }
+    } else if (OB_FAIL(part_ctx_handle_request_helper_(static_cast<ObPartTransCtx*>(ctx), msg, msg_type))) {
+      TRANS_LOG(WARN, "handle 2pc request failed", K(ret), K(msg));
+    }
+  }
+  for (int64_t i = 0; i < ctxs.count(); i++) {
+    if (NULL != ctxs.at(i)) {
+      (void)part_trans_ctx_mgr_->revert_trans_ctx(ctxs.at(i));
+    }
+  }
+
+  return ret;
+}
+
 int ObTransMsgHandler::part_ctx_handle_request(ObTrxMsgBase& msg, const int64_t msg_type)
 {
   int ret = OB_SUCCESS;
@@ -385,38 +420,44 @@ int ObTransMsgHandler::part_ctx_handle_request(ObTrxMsgBase& msg, const int64_t
     alloc = true;
   }
 
-  for (int i = 0; OB_SUCC(ret) && i <= batch_partitions.count(); i++) {
-    if (batch_partitions.count() > 0) {
-      if (i < batch_partitions.count()) {
-        msg.receiver_ = batch_partitions.at(i);
-      } else {
-        break;
-      }
+  if (!alloc && batch_partitions.count() > 0) {
+    if (OB_FAIL(part_ctx_handle_batch_request_(msg, msg_type))) {
+      TRANS_LOG(WARN, "handle batch request failed", K(ret), K(msg));
     }
-    if (OB_FAIL(txs_->check_partition_status(msg.receiver_))) {
-      TRANS_LOG(WARN, "check partition status failed", K(ret), K(msg));
-    } else if (OB_FAIL(part_trans_ctx_mgr_->get_trans_ctx(msg.receiver_,
-                   trans_id,
-                   for_replay,
-                   is_readonly,
-                   is_bounded_staleness_read,
-                   need_completed_dirty_txn,
-                   alloc,
-                   ctx))) {
-      TRANS_LOG(DEBUG, "get transaction context error", K(ret), K(msg));
-      // rewrite ret
-      ret = OB_SUCCESS;
-      if (OB_FAIL(orphan_msg_helper_(msg, msg_type))) {
-        TRANS_LOG(WARN, "orphan msg helper failed", K(ret), K(msg));
+  } else {
+    for (int i = 0; OB_SUCC(ret) && i <= batch_partitions.count(); i++) {
+      if (batch_partitions.count() > 0) {
+        if (i < batch_partitions.count()) {
+          msg.receiver_ = batch_partitions.at(i);
+        } else {
+          break;
+        }
       }
-    } else {
-      part_ctx = static_cast<ObPartTransCtx*>(ctx);
-      if (alloc && OB_FAIL(part_ctx->construct_listener_context(msg))) {
-        TRANS_LOG(WARN, "construct listener context failed", KR(ret));
-      } else if (OB_FAIL(part_ctx_handle_request_helper_(part_ctx, msg, msg_type))) {
-        TRANS_LOG(WARN, "handle 2pc request failed", K(ret), K(msg));
+      if (OB_FAIL(txs_->check_partition_status(msg.receiver_))) {
+        TRANS_LOG(WARN, "check partition status failed", K(ret), K(msg));
+      } else if (OB_FAIL(part_trans_ctx_mgr_->get_trans_ctx(msg.receiver_,
+                     trans_id,
+                     for_replay,
+                     is_readonly,
+                     is_bounded_staleness_read,
+                     need_completed_dirty_txn,
+                     alloc,
+                     ctx))) {
+        TRANS_LOG(DEBUG, "get transaction context error", K(ret), K(msg));
+        // rewrite ret
+        ret = OB_SUCCESS;
+        if (OB_FAIL(orphan_msg_helper_(msg, msg_type))) {
+          TRANS_LOG(WARN, "orphan msg helper failed", K(ret), K(msg));
+        }
+      } else {
+        part_ctx = static_cast<ObPartTransCtx*>(ctx);
+        if (alloc && OB_FAIL(part_ctx->construct_listener_context(msg))) {
+          TRANS_LOG(WARN, "construct listener context failed", KR(ret));
+        } else if (OB_FAIL(part_ctx_handle_request_helper_(part_ctx, msg, msg_type))) {
+          TRANS_LOG(WARN, "handle 2pc request failed", K(ret), K(msg));
+        }
+        (void)part_trans_ctx_mgr_->revert_trans_ctx(ctx);
       }
-      (void)part_trans_ctx_mgr_->revert_trans_ctx(ctx);
     }
   }
 
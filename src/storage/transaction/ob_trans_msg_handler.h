@@ -60,6 +60,8 @@ private:
       const uint64_t tenant_id, const ObTrxMsgBase& msg, const int64_t msg_type, const common::ObAddr& recv_addr);
   int orphan_msg_helper_(const ObTrxMsgBase& msg, const int64_t msg_type);
   int part_ctx_handle_request_helper_(ObPartTransCtx* part_ctx, const ObTrxMsgBase& msg, const int64_t msg_type);
+  // handle request batched for partitions of the same leader, which only looks up contexts
+  int part_ctx_handle_batch_request_(ObTrxMsgBase& msg, const int64_t msg_type);
   int coord_ctx_handle_response_helper_(
       ObCoordTransCtx* coord_ctx, const bool alloc, const ObTrxMsgBase& msg, const int64_t msg_type);
 
@@ -496,6 +496,16 @@ public:
   // 2. When configured on, the timestamp field is synchronized to integer
   T_DEF_BOOL(enable_convert_timestamp_to_unix_timestamp, OB_CLUSTER_PARAMETER, 0, "0:disabled, 1:enabled");
 
+  // Whether to output column values of numeric/temporal/bit/enum/set types in typed binary format
+  // 1. off by default, column values are converted to text
+  // 2. When configured on, values are output in host byte order without text conversion, see ObObj2strHelper,
+  //    and the encoding of such columns in table meta is ObObj2strHelper::BINARY_VALUE_ENCODING
+  // 3. timestamp values are raw UTC microseconds since epoch, not rendered in tenant time zone, and this takes
+  //    precedence over enable_convert_timestamp_to_unix_timestamp; datetime values are microseconds of the
+  //    wall clock time since epoch, without any time zone
+  // 4. T column of hbase table is still converted to text in hbase mode
+  T_DEF_BOOL(enable_output_binary_column_value, OB_CLUSTER_PARAMETER, 0, "0:disabled, 1:enabled");
+
   // Whether to output invisible columns externally
   // 1. DRC link is off by default; if valid, output hidden primary key
   // 2. Backup is on by default
@@ -754,10 +754,18 @@ int ObLogMetaManager::set_column_meta_(IColMeta *col_meta,
     uint16_t type_flag = 0;
     ObScale decimals = 0; // FIXME: does liboblog need this?
     EMySQLFieldType mysql_type = MYSQL_TYPE_NOT_DEFINED;
+    bool is_binary_output = false;
 
     if (OB_FAIL(ObSMUtils::get_mysql_type(column_schema.get_data_type(),
         mysql_type, type_flag, decimals))) {
       LOG_ERROR("get_mysql_type fail", KR(ret), "ob_type", column_schema.get_data_type());
+    } else if (OB_ISNULL(obj2str_helper_)) {
+      LOG_ERROR("obj2str_helper_ is null", K(obj2str_helper_));
+      ret = OB_ERR_UNEXPECTED;
+    } else if (OB_FAIL(obj2str_helper_->is_binary_output_column(table_schema.get_table_id(),
+        column_schema.get_column_id(), column_schema.get_data_type(), is_binary_output))) {
+      LOG_ERROR("is_binary_output_column fail", KR(ret), "table_id", table_schema.get_table_id(),
+          "column_id", column_schema.get_column_id());
     } else {
       //mysql treat it as MYSQL_TYPE_STRING, it is not suitable for liboblog
       if (ObEnumType == column_schema.get_data_type()) {
@@ -773,6 +781,10 @@ int ObLogMetaManager::set_column_meta_(IColMeta *col_meta,
       col_meta->setIsPK(column_schema.is_original_rowkey_column());
       col_meta->setNotNull(! column_schema.is_nullable());
       SET_ENCODING(col_meta, column_schema.get_charset_type());
+      // mark columns whose values are output in typed binary format
+      if (is_binary_output) {
+        col_meta->setEncoding(ObObj2strHelper::BINARY_VALUE_ENCODING);
+      }
 
       if (column_schema.is_heap_alter_rowkey_column()) {
         col_meta->setHiddenRowKey();
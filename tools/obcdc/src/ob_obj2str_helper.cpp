@@ -28,6 +28,7 @@ namespace oceanbase
 namespace liboblog
 {
 const char* ObObj2strHelper::EMPTY_STRING = "";
+const char* ObObj2strHelper::BINARY_VALUE_ENCODING = "ob_binary_value";
 
 ObObj2strHelper::ObObj2strHelper() : inited_(false),
                                      timezone_info_getter_(NULL),
@@ -35,6 +36,7 @@ ObObj2strHelper::ObObj2strHelper() : inited_(false),
                                      enable_hbase_mode_(false),
                                      enable_convert_timestamp_to_unix_timestamp_(false),
                                      enable_backup_mode_(false),
+                                     enable_binary_output_(false),
                                      tenant_mgr_(NULL)
 {
 }
@@ -49,6 +51,7 @@ int ObObj2strHelper::init(IObLogTimeZoneInfoGetter &timezone_info_getter,
     const bool enable_hbase_mode,
     const bool enable_convert_timestamp_to_unix_timestamp,
     const bool enable_backup_mode,
+    const bool enable_binary_output,
     IObLogTenantMgr &tenant_mgr)
 {
   int ret = OB_SUCCESS;
@@ -63,6 +66,7 @@ int ObObj2strHelper::init(IObLogTimeZoneInfoGetter &timezone_info_getter,
     enable_hbase_mode_ = enable_hbase_mode;
     enable_convert_timestamp_to_unix_timestamp_ = enable_convert_timestamp_to_unix_timestamp;
     enable_backup_mode_ = enable_backup_mode;
+    enable_binary_output_ = enable_binary_output;
     tenant_mgr_ = &tenant_mgr;
     inited_ = true;
   }
@@ -99,6 +103,7 @@ void ObObj2strHelper::destroy()
   enable_hbase_mode_ = false;
   enable_convert_timestamp_to_unix_timestamp_ = false;
   enable_backup_mode_ = false;
+  enable_binary_output_ = false;
   tenant_mgr_ = NULL;
 }
 
@@ -119,9 +124,17 @@ int ObObj2strHelper::obj2str(const uint64_t tenant_id,
   ObObjType obj_type = obj.get_type();
   common::ObObjTypeClass obj_tc = common::ob_obj_type_class(obj_type);
   ObWorker::CompatMode compat_mode = THIS_WORKER.get_compatibility_mode();
-
+  bool is_binary_output = false;
+
+  if (enable_binary_output_
+      && OB_FAIL(is_binary_output_column(table_id, column_id, obj_type, is_binary_output))) {
+    OBLOG_LOG(ERROR, "is_binary_output_column fail", KR(ret), K(table_id), K(column_id), K(obj_type));
+  } else if (is_binary_output) {
+    if (OB_FAIL(convert_obj_to_binary_(obj, str, allocator, string_deep_copy))) {
+      OBLOG_LOG(ERROR, "convert_obj_to_binary_ fail", KR(ret), K(table_id), K(column_id), K(obj), K(obj_type));
+    }
   // Configure allowed conversions: mysql timestamp column -> UTC integer time
-  if (ObTimestampType == obj_type && enable_convert_timestamp_to_unix_timestamp_) {
+  } else if (ObTimestampType == obj_type && enable_convert_timestamp_to_unix_timestamp_) {
     if (OB_FAIL(convert_mysql_timestamp_to_utc_(obj, str, allocator))) {
       OBLOG_LOG(ERROR, "convert_mysql_timestamp_to_utc_ fail", KR(ret), K(table_id), K(column_id), K(obj), K(obj_type),
           K(str));
@@ -424,6 +437,115 @@ int ObObj2strHelper::convert_mysql_timestamp_to_utc_(const common::ObObj &obj,
   return ret;
 }
 
+int ObObj2strHelper::is_binary_output_column(const uint64_t table_id,
+    const uint64_t column_id,
+    const common::ObObjType obj_type,
+    bool &is_binary) const
+{
+  int ret = OB_SUCCESS;
+  is_binary = false;
+
+  if (! enable_binary_output_) {
+    // do nothing
+  } else {
+    switch (common::ob_obj_type_class(obj_type)) {
+      case common::ObIntTC:
+        // hbase table T column is converted to positive in text, other int columns are not
+        if (enable_hbase_mode_ && ! enable_backup_mode_) {
+          bool is_hbase_table_T_column = false;
+
+          if (OB_ISNULL(hbase_util_)) {
+            OBLOG_LOG(ERROR, "hbase_util_ is null", K(hbase_util_));
+            ret = OB_ERR_UNEXPECTED;
+          } else if (OB_FAIL(hbase_util_->judge_hbase_T_column(table_id, column_id, is_hbase_table_T_column))) {
+            OBLOG_LOG(ERROR, "hbase_util_ judge_hbase_T_column fail", KR(ret), K(table_id), K(column_id));
+          } else {
+            is_binary = ! is_hbase_table_T_column;
+          }
+        } else {
+          is_binary = true;
+        }
+        break;
+      case common::ObUIntTC:
+      case common::ObFloatTC:
+      case common::ObDoubleTC:
+      case common::ObNumberTC:
+      case common::ObDateTimeTC:
+      case common::ObDateTC:
+      case common::ObTimeTC:
+      case common::ObYearTC:
+      case common::ObBitTC:
+      case common::ObEnumSetTC:
+        is_binary = true;
+        break;
+      default:
+        is_binary = false;
+        break;
+    }
+  }
+
+  return ret;
+}
+
+int ObObj2strHelper::convert_obj_to_binary_(const common::ObObj &obj,
+    common::ObString &str,
+    common::ObIAllocator &allocator,
+    const bool deep_copy)
+{
+  int ret = OB_SUCCESS;
+  const common::ObObjTypeClass obj_tc = obj.get_type_class();
+
+  if (common::ObNumberTC == obj_tc) {
+    const uint32_t desc = obj.get_number_desc().desc_;
+    const int64_t digits_len = obj.get_number_byte_length();
+    const int64_t len = static_cast<int64_t>(sizeof(desc)) + digits_len;
+    char *ptr = NULL;
+
+    if (OB_ISNULL(ptr = static_cast<char *>(allocator.alloc(len)))) {
+      OBLOG_LOG(ERROR, "allocate memory fail", "size", len);
+      ret = common::OB_ALLOCATE_MEMORY_FAILED;
+    } else {
+      MEMCPY(ptr, &desc, sizeof(desc));
+      if (digits_len > 0) {
+        MEMCPY(ptr + sizeof(desc), obj.get_data_ptr(), digits_len);
+      }
+      str.assign_ptr(ptr, static_cast<ObString::obstr_size_t>(len));
+    }
+  } else {
+    int64_t len = 0;
+    switch (obj_tc) {
+      case common::ObFloatTC:
+        len = sizeof(float);
+        break;
+      case common::ObDateTC:
+        len = sizeof(int32_t);
+        break;
+      case common::ObYearTC:
+        len = sizeof(uint8_t);
+        break;
+      default:
+        // int/uint/double/datetime/time/bit/enum/set are all stored as 8 bytes
+        len = sizeof(int64_t);
+        break;
+    }
+
+    if (! deep_copy) {
+      str.assign_ptr(static_cast<const char *>(obj.get_data_ptr()), static_cast<ObString::obstr_size_t>(len));
+    } else {
+      char *ptr = NULL;
+      if (OB_ISNULL(ptr = static_cast<char *>(allocator.alloc(len)))) {
+        OBLOG_LOG(ERROR, "allocate memory fail", "size", len);
+        ret = common::OB_ALLOCATE_MEMORY_FAILED;
+      } else {
+        MEMCPY(ptr, obj.get_data_ptr(), len);
+        str.assign_ptr(ptr, static_cast<ObString::obstr_size_t>(len));
+      }
+    }
+  }
+
+  return ret;
+}
+
 bool ObObj2strHelper::need_padding_(const ObWorker::CompatMode &compat_mode,
     const common::ObObj &obj) const
 {
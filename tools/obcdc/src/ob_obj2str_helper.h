@@ -47,6 +47,8 @@ public:
   //  2) string_deep_copy == true
   //    deep copy of the string
   // 2. otherwise use allocator to allocate memory and print the object into memory
+  // 3. If binary output is enabled, objects of binary output columns are output as typed binary value
+  //  instead, refer to is_binary_output_column and convert_obj_to_binary_
    int obj2str(const uint64_t tenant_id,
        const uint64_t table_id,
        const uint64_t column_id,
@@ -64,11 +66,21 @@ public:
       const bool enable_hbase_mode,
       const bool enable_convert_timestamp_to_unix_timestamp,
       const bool enable_backup_mode,
+      const bool enable_binary_output,
       IObLogTenantMgr &tenant_mgr);
   void destroy();
 
+  // Whether values of the column are output in typed binary format, which are numeric, temporal, bit
+  // and enum/set columns when binary output is enabled, except the T column of hbase table
+  int is_binary_output_column(const uint64_t table_id,
+      const uint64_t column_id,
+      const common::ObObjType obj_type,
+      bool &is_binary) const;
+
 public:
   static const char *EMPTY_STRING;
+  // encoding of column meta of binary output columns
+  static const char *BINARY_VALUE_ENCODING;
 
 private:
   // initialize ObCharsetUtils (refer to ob_sql_init.h #init_sql_expr_static_var())
@@ -104,6 +116,16 @@ private:
   // TODO MySQL schema: char/binary supports padding based on specific requirments
   bool need_padding_(const ObWorker::CompatMode &compat_mode,
       const common::ObObj &obj) const;
+
+  // Binary output, value is in host byte order and interpreted by column type of table meta:
+  // 1. int/uint/bit/enum/set/datetime/timestamp/time: 8 bytes
+  // 2. date: 4 bytes, year: 1 byte, float/double: 4/8 bytes
+  // 3. number: 4 bytes desc followed by digits, 4 bytes each
+  // Without deep copy, fixed length value points to the value of the original object
+  int convert_obj_to_binary_(const common::ObObj &obj,
+      common::ObString &str,
+      common::ObIAllocator &allocator,
+      const bool deep_copy);
   int convert_char_obj_to_padding_obj_(const ObWorker::CompatMode &compat_mode,
       const common::ObObj &obj,
       const common::ObAccuracy &accuracy,
@@ -118,6 +140,7 @@ private:
   bool                          enable_hbase_mode_;
   bool                          enable_convert_timestamp_to_unix_timestamp_;
   bool                          enable_backup_mode_;
+  bool                          enable_binary_output_;
   IObLogTenantMgr               *tenant_mgr_;
 
 private:
@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "ob_micro_bench.h"
+#include "lib/allocator/page_arena.h"
+#include "sql/engine/cmd/ob_load_data_impl.h"
+
+namespace oceanbase {
+namespace benchmark {
+using namespace common;
+using namespace sql;
+
+static const int64_t CSV_FIELD_CNT = 8;
+static const int64_t CSV_BUF_SIZE = 2L << 20;
+
+/*
+ * Fill a file buffer with complete lines of CSV_FIELD_CNT fields,
+ * the length of a field is random in [1, 2 * avg_field_len].
+ */
+static int init_csv_buffer(const int64_t avg_field_len, const bool is_enclosed, const uint64_t seed,
+    ObArenaAllocator& allocator, ObLoadFileBuffer*& buffer, int64_t& line_cnt)
+{
+  int ret = OB_SUCCESS;
+  ObBenchRandom random(seed);
+  void* buf = allocator.alloc(sizeof(ObLoadFileBuffer) + CSV_BUF_SIZE);
+  line_cnt = 0;
+  if (OB_ISNULL(buf)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc buffer failed", K(ret));
+  } else {
+    buffer = new (buf) ObLoadFileBuffer(CSV_BUF_SIZE);
+    const int64_t max_line_len = CSV_FIELD_CNT * (2 * avg_field_len + 3);
+    while (buffer->get_remain_len() >= max_line_len) {
+      char* pos = buffer->current_ptr();
+      for (int64_t i = 0; i < CSV_FIELD_CNT; ++i) {
+        const int64_t len = random.rand(1, 2 * avg_field_len);
+        if (is_enclosed) {
+          *pos++ = '"';
+        }
+        random.fill(pos, len);
+        pos += len;
+        if (is_enclosed) {
+          *pos++ = '"';
+        }
+        *pos++ = (CSV_FIELD_CNT - 1 == i) ? '\n' : '\t';
+      }
+      buffer->update_pos(pos - buffer->current_ptr());
+      ++line_cnt;
+    }
+  }
+  return ret;
+}
+
+static int init_csv_parser(const bool is_enclosed, ObCSVParser& parser)
+{
+  int ret = OB_SUCCESS;
+  ObDataInFileStruct file_formats;
+  ObCSVFormats formats;
+  ObBitSet<> string_type_column;
+  if (is_enclosed) {
+    file_formats.field_enclosed_char_ = '"';
+  }
+  formats.init(file_formats);
+  for (int64_t i = 0; OB_SUCC(ret) && i < CSV_FIELD_CNT; ++i) {
+    if (OB_FAIL(string_type_column.add_member(i))) {
+      LOG_WARN("add member failed", K(ret), K(i));
+    }
+  }
+  if (OB_SUCC(ret) && OB_FAIL(parser.init(CSV_FIELD_CNT, formats, string_type_column))) {
+    LOG_WARN("init parser failed", K(ret));
+  }
+  return ret;
+}
+
+static void bench_csv_scan(ObBenchState& state, const bool use_simd)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator allocator(ObModIds::TEST);
+  ObLoadFileBuffer* buffer = NULL;
+  ObCSVSpecialCharScanner scanner;
+  int64_t line_cnt = 0;
+  int64_t special_cnt = 0;
+  if (OB_FAIL(init_csv_buffer(state.arg(), false, state.get_seed(), allocator, buffer, line_cnt))) {
+    LOG_WARN("init buffer failed", K(ret));
+  } else if (OB_FAIL(scanner.add_char('\t'))) {
+    LOG_WARN("add field term failed", K(ret));
+  } else if (OB_FAIL(scanner.add_char('\n'))) {
+    LOG_WARN("add line term failed", K(ret));
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    const char* end = buffer->current_ptr();
+    for (const char* pos = buffer->begin_ptr(); pos < end; ++pos) {
+      pos = use_simd ? scanner.find(pos, end) : ObCSVSpecialCharScanner::scan_scalar(scanner, pos, end);
+      if (pos < end) {
+        ++special_cnt;
+      }
+    }
+  }
+  if (OB_SUCC(ret) && special_cnt != state.iterations() * line_cnt * CSV_FIELD_CNT) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("special char count mismatch", K(ret), K(special_cnt), K(line_cnt));
+  }
+  state.set_error(ret);
+  state.set_items_processed(OB_ISNULL(buffer) ? 0 : state.iterations() * buffer->get_data_len());
+}
+
+static void bench_csv_scan_scalar(ObBenchState& state)
+{
+  bench_csv_scan(state, false);
+}
+OB_MICRO_BENCH(csv_scan_scalar, bench_csv_scan_scalar)->arg(4)->arg(16)->arg(64);
+
+static void bench_csv_scan_simd(ObBenchState& state)
+{
+  bench_csv_scan(state, true);
+}
+OB_MICRO_BENCH(csv_scan_simd, bench_csv_scan_simd)->arg(4)->arg(16)->arg(64);
+
+// counting lines for splitting the file, which is done by the main thread of load data
+static void bench_csv_fast_parse_lines(ObBenchState& state)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator allocator(ObModIds::TEST);
+  ObLoadFileBuffer* buffer = NULL;
+  ObCSVParser parser;
+  int64_t line_cnt = 0;
+  if (OB_FAIL(init_csv_buffer(state.arg(), false, state.get_seed(), allocator, buffer, line_cnt))) {
+    LOG_WARN("init buffer failed", K(ret));
+  } else if (OB_FAIL(init_csv_parser(false, parser))) {
+    LOG_WARN("init parser failed", K(ret));
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    int64_t valid_len = 0;
+    int64_t parsed_cnt = INT64_MAX;
+    if (OB_FAIL(ObCSVParser::fast_parse_lines(*buffer, parser, false, valid_len, parsed_cnt))) {
+      LOG_WARN("fast parse lines failed", K(ret));
+    } else if (OB_UNLIKELY(parsed_cnt != line_cnt)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("line count mismatch", K(ret), K(parsed_cnt), K(line_cnt));
+    }
+  }
+  state.set_error(ret);
+  state.set_items_processed(state.iterations() * line_cnt);
+}
+OB_MICRO_BENCH(csv_fast_parse_lines, bench_csv_fast_parse_lines)->arg(4)->arg(16)->arg(64);
+
+// splitting lines into fields, which is done by shuffle tasks
+static void bench_csv_next_line(ObBenchState& state, const bool is_enclosed)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator allocator(ObModIds::TEST);
+  ObLoadFileBuffer* buffer = NULL;
+  char* data = NULL;
+  ObCSVParser parser;
+  int64_t line_cnt = 0;
+  if (OB_FAIL(init_csv_buffer(state.arg(), is_enclosed, state.get_seed(), allocator, buffer, line_cnt))) {
+    LOG_WARN("init buffer failed", K(ret));
+  } else if (OB_FAIL(init_csv_parser(is_enclosed, parser))) {
+    LOG_WARN("init parser failed", K(ret));
+  } else if (OB_ISNULL(data = static_cast<char*>(allocator.alloc(buffer->get_data_len())))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc data failed", K(ret));
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    // fields are unescaped in place, parse a copy
+    state.pause_timing();
+    MEMCPY(data, buffer->begin_ptr(), buffer->get_data_len());
+    state.resume_timing();
+    int64_t parsed_cnt = 0;
+    bool yield = true;
+    parser.reuse();
+    parser.next_buf(data, buffer->get_data_len(), true);
+    while (OB_SUCC(ret) && yield) {
+      if (OB_FAIL(parser.next_line(yield))) {
+        LOG_WARN("parse line failed", K(ret), K(parsed_cnt));
+      } else if (yield) {
+        ++parsed_cnt;
+      }
+    }
+    if (OB_SUCC(ret) && OB_UNLIKELY(parsed_cnt != line_cnt)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("line count mismatch", K(ret), K(parsed_cnt), K(line_cnt));
+    }
+  }
+  state.set_error(ret);
+  state.set_items_processed(state.iterations() * line_cnt);
+}
+
+static void bench_csv_next_line_plain(ObBenchState& state)
+{
+  bench_csv_next_line(state, false);
+}
+OB_MICRO_BENCH(csv_next_line_plain, bench_csv_next_line_plain)->arg(4)->arg(16)->arg(64);
+
+static void bench_csv_next_line_enclosed(ObBenchState& state)
+{
+  bench_csv_next_line(state, true);
+}
+OB_MICRO_BENCH(csv_next_line_enclosed, bench_csv_next_line_enclosed)->arg(4)->arg(16)->arg(64);
+
+}  // namespace benchmark
+}  // namespace oceanbase
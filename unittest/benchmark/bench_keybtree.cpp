@@ -0,0 +1,199 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_micro_bench.h"
+#include "common/object/ob_object.h"
+#include "common/rowkey/ob_store_rowkey.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/allocator/page_arena.h"
+#include "storage/memtable/mvcc/ob_keybtree.h"
+#include "storage/memtable/mvcc/ob_keybtree_deps.h"
+#include "storage/memtable/ob_memtable_key.h"
+
+namespace oceanbase {
+namespace benchmark {
+using namespace common;
+using namespace keybtree;
+using namespace memtable;
+
+class ObBenchBtreeAllocator : public ObIAllocator {
+public:
+  void* alloc(const int64_t size) override
+  {
+    return ob_malloc(size, ObModIds::TEST);
+  }
+  void* alloc(const int64_t size, const ObMemAttr& attr) override
+  {
+    UNUSED(attr);
+    return alloc(size);
+  }
+  void free(void* ptr) override
+  {
+    ob_free(ptr);
+  }
+};
+
+/*
+ * (int, varchar(16)) rowkeys like a memtable of a two column primary key table,
+ * the varchar column is a shared prefix plus the random suffix so the comparison
+ * goes beyond the first column for every fourth key.
+ */
+class ObBenchBtreeKeys {
+public:
+  static const int64_t ROWKEY_CNT = 2;
+  static const int64_t VARCHAR_LEN = 16;
+
+  ObBenchBtreeKeys() : allocator_(ObModIds::TEST), key_cnt_(0), keys_(NULL)
+  {}
+  int init(const int64_t key_cnt, const bool is_random, const uint64_t seed)
+  {
+    int ret = OB_SUCCESS;
+    ObBenchRandom random(seed);
+    key_cnt_ = key_cnt;
+    ObObj* objs = static_cast<ObObj*>(allocator_.alloc(sizeof(ObObj) * ROWKEY_CNT * (key_cnt + 2)));
+    ObStoreRowkey* rowkeys = static_cast<ObStoreRowkey*>(allocator_.alloc(sizeof(ObStoreRowkey) * (key_cnt + 2)));
+    char* strs = static_cast<char*>(allocator_.alloc(VARCHAR_LEN * key_cnt));
+    keys_ = static_cast<BtreeKey*>(allocator_.alloc(sizeof(BtreeKey) * (key_cnt + 2)));
+    if (OB_ISNULL(objs) || OB_ISNULL(rowkeys) || OB_ISNULL(strs) || OB_ISNULL(keys_)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc keys failed", K(ret), K(key_cnt));
+    } else {
+      MEMSET(strs, 'k', VARCHAR_LEN * key_cnt);
+      for (int64_t i = 0; i < key_cnt; ++i) {
+        ObObj* cells = objs + i * ROWKEY_CNT;
+        char* str = strs + i * VARCHAR_LEN;
+        random.fill(str + VARCHAR_LEN / 2, VARCHAR_LEN / 2);
+        cells[0].set_int(is_random ? random.rand(0, key_cnt / 4) : i / 4);
+        cells[1].set_varchar(str, static_cast<int32_t>(VARCHAR_LEN));
+        cells[1].set_collation_type(CS_TYPE_UTF8MB4_BIN);
+        new (rowkeys + i) ObStoreRowkey(cells, ROWKEY_CNT);
+        new (keys_ + i) BtreeKey(rowkeys + i);
+      }
+      // scan range [min, max]
+      ObObj* min_cells = objs + key_cnt * ROWKEY_CNT;
+      ObObj* max_cells = objs + (key_cnt + 1) * ROWKEY_CNT;
+      for (int64_t i = 0; i < ROWKEY_CNT; ++i) {
+        min_cells[i].set_min_value();
+        max_cells[i].set_max_value();
+      }
+      new (rowkeys + key_cnt) ObStoreRowkey(min_cells, ROWKEY_CNT);
+      new (rowkeys + key_cnt + 1) ObStoreRowkey(max_cells, ROWKEY_CNT);
+      new (keys_ + key_cnt) BtreeKey(rowkeys + key_cnt);
+      new (keys_ + key_cnt + 1) BtreeKey(rowkeys + key_cnt + 1);
+    }
+    return ret;
+  }
+  // duplicated random keys are skipped by the btree
+  int insert_all(ObKeyBtree& btree)
+  {
+    int ret = OB_SUCCESS;
+    for (int64_t i = 0; OB_SUCC(ret) && i < key_cnt_; ++i) {
+      if (OB_FAIL(btree.insert(keys_[i], reinterpret_cast<BtreeVal>((i + 1) << 3)))) {
+        if (OB_ENTRY_EXIST == ret) {
+          ret = OB_SUCCESS;
+        } else {
+          LOG_WARN("insert key failed", K(ret), K(i));
+        }
+      }
+    }
+    return ret;
+  }
+  const BtreeKey& get_min_key() const
+  {
+    return keys_[key_cnt_];
+  }
+  const BtreeKey& get_max_key() const
+  {
+    return keys_[key_cnt_ + 1];
+  }
+
+private:
+  ObArenaAllocator allocator_;
+  int64_t key_cnt_;
+  BtreeKey* keys_;
+};
+
+static void bench_keybtree_insert(ObBenchState& state, const bool is_random)
+{
+  int ret = OB_SUCCESS;
+  ObBenchBtreeAllocator allocator;
+  BtreeNodeAllocator node_allocator(allocator);
+  ObBenchBtreeKeys keys;
+  if (OB_FAIL(keys.init(state.arg(), is_random, state.get_seed()))) {
+    LOG_WARN("init keys failed", K(ret));
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    ObKeyBtree btree(node_allocator);
+    if (OB_FAIL(btree.init())) {
+      LOG_WARN("init btree failed", K(ret));
+    } else if (OB_FAIL(keys.insert_all(btree))) {
+      LOG_WARN("insert keys failed", K(ret));
+    }
+    state.pause_timing();
+    btree.destroy();
+    state.resume_timing();
+  }
+  state.set_error(ret);
+  state.set_items_processed(state.iterations() * state.arg());
+}
+
+static void bench_keybtree_seq_insert(ObBenchState& state)
+{
+  bench_keybtree_insert(state, false);
+}
+OB_MICRO_BENCH(keybtree_seq_insert, bench_keybtree_seq_insert)->arg(1 << 10)->arg(1 << 16)->arg(1 << 20);
+
+static void bench_keybtree_random_insert(ObBenchState& state)
+{
+  bench_keybtree_insert(state, true);
+}
+OB_MICRO_BENCH(keybtree_random_insert, bench_keybtree_random_insert)->arg(1 << 10)->arg(1 << 16)->arg(1 << 20);
+
+static void bench_keybtree_scan(ObBenchState& state)
+{
+  int ret = OB_SUCCESS;
+  ObBenchBtreeAllocator allocator;
+  BtreeNodeAllocator node_allocator(allocator);
+  ObKeyBtree btree(node_allocator);
+  ObBenchBtreeKeys keys;
+  int64_t scan_cnt = 0;
+  if (OB_FAIL(keys.init(state.arg(), true, state.get_seed()))) {
+    LOG_WARN("init keys failed", K(ret));
+  } else if (OB_FAIL(btree.init())) {
+    LOG_WARN("init btree failed", K(ret));
+  } else if (OB_FAIL(keys.insert_all(btree))) {
+    LOG_WARN("insert keys failed", K(ret));
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    TScanHandle iter;
+    BtreeKey key;
+    BtreeVal val = NULL;
+    if (OB_FAIL(btree.set_key_range(iter, keys.get_min_key(), false, keys.get_max_key(), false, INT64_MAX))) {
+      LOG_WARN("set key range failed", K(ret));
+    }
+    while (OB_SUCC(ret) && OB_SUCC(iter.get_next(key, val))) {
+      ++scan_cnt;
+    }
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+    }
+  }
+  btree.destroy();
+  state.set_error(ret);
+  state.set_items_processed(scan_cnt);
+}
+OB_MICRO_BENCH(keybtree_scan, bench_keybtree_scan)->arg(1 << 10)->arg(1 << 16)->arg(1 << 20);
+
+}  // namespace benchmark
+}  // namespace oceanbase
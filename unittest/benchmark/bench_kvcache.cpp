@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX COMMON
+
+#include "ob_micro_bench.h"
+#include "lib/allocator/page_arena.h"
+#include "share/cache/ob_kv_storecache.h"
+
+namespace oceanbase {
+namespace benchmark {
+using namespace common;
+
+struct ObBenchCacheKey : public ObIKVCacheKey {
+  ObBenchCacheKey() : v_(0), tenant_id_(0)
+  {
+    MEMSET(buf_, 0, sizeof(buf_));
+  }
+  virtual bool operator==(const ObIKVCacheKey& other) const override
+  {
+    const ObBenchCacheKey& other_key = static_cast<const ObBenchCacheKey&>(other);
+    return v_ == other_key.v_ && tenant_id_ == other_key.tenant_id_;
+  }
+  virtual uint64_t get_tenant_id() const override
+  {
+    return tenant_id_;
+  }
+  virtual uint64_t hash() const override
+  {
+    return v_;
+  }
+  virtual int64_t size() const override
+  {
+    return sizeof(*this);
+  }
+  virtual int deep_copy(char* buf, const int64_t buf_len, ObIKVCacheKey*& key) const override
+  {
+    int ret = OB_SUCCESS;
+    if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len < size())) {
+      ret = OB_INVALID_ARGUMENT;
+    } else {
+      key = new (buf) ObBenchCacheKey(*this);
+    }
+    return ret;
+  }
+  uint64_t v_;
+  uint64_t tenant_id_;
+  // row cache sized key
+  char buf_[16];
+};
+
+struct ObBenchCacheValue : public ObIKVCacheValue {
+  ObBenchCacheValue() : v_(0)
+  {
+    MEMSET(buf_, 0, sizeof(buf_));
+  }
+  virtual int64_t size() const override
+  {
+    return sizeof(*this);
+  }
+  virtual int deep_copy(char* buf, const int64_t buf_len, ObIKVCacheValue*& value) const override
+  {
+    int ret = OB_SUCCESS;
+    if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len < size())) {
+      ret = OB_INVALID_ARGUMENT;
+    } else {
+      value = new (buf) ObBenchCacheValue(*this);
+    }
+    return ret;
+  }
+  uint64_t v_;
+  // row cache sized value
+  char buf_[248];
+};
+
+typedef ObKVCache<ObBenchCacheKey, ObBenchCacheValue> ObBenchCache;
+
+// caches are registered in the global cache by name, so each case keeps one for the whole run
+static int get_bench_cache(const char* name, ObBenchCache*& cache)
+{
+  int ret = OB_SUCCESS;
+  static const int64_t MAX_BENCH_CACHE_CNT = 4;
+  static ObBenchCache caches[MAX_BENCH_CACHE_CNT];
+  static const char* names[MAX_BENCH_CACHE_CNT] = {NULL};
+  cache = NULL;
+  for (int64_t i = 0; OB_SUCC(ret) && NULL == cache && i < MAX_BENCH_CACHE_CNT; ++i) {
+    if (NULL == names[i]) {
+      if (OB_FAIL(caches[i].init(name))) {
+        LOG_WARN("init cache failed", K(ret), K(name));
+      } else {
+        names[i] = name;
+        cache = &caches[i];
+      }
+    } else if (0 == STRCMP(names[i], name)) {
+      cache = &caches[i];
+    }
+  }
+  if (OB_SUCC(ret) && NULL == cache) {
+    ret = OB_SIZE_OVERFLOW;
+    LOG_WARN("too many bench caches", K(ret), K(name));
+  }
+  return ret;
+}
+
+static int init_cache_keys(const int64_t key_cnt, const uint64_t seed, ObArenaAllocator& allocator,
+    ObBenchCacheKey*& keys)
+{
+  int ret = OB_SUCCESS;
+  ObBenchRandom random(seed);
+  if (OB_ISNULL(keys = static_cast<ObBenchCacheKey*>(allocator.alloc(sizeof(ObBenchCacheKey) * key_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc keys failed", K(ret), K(key_cnt));
+  } else {
+    for (int64_t i = 0; i < key_cnt; ++i) {
+      ObBenchCacheKey* key = new (keys + i) ObBenchCacheKey();
+      key->v_ = random.next();
+      key->tenant_id_ = OB_SYS_TENANT_ID;
+    }
+  }
+  return ret;
+}
+
+static void bench_kvcache_put(ObBenchState& state)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator allocator(ObModIds::TEST);
+  ObBenchCache* cache = NULL;
+  ObBenchCacheKey* keys = NULL;
+  ObBenchCacheValue value;
+  const int64_t key_cnt = state.arg();
+  if (OB_FAIL(get_bench_cache("bench_put", cache))) {
+    LOG_WARN("get cache failed", K(ret));
+  } else if (OB_FAIL(init_cache_keys(key_cnt, state.get_seed(), allocator, keys))) {
+    LOG_WARN("init keys failed", K(ret));
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    for (int64_t i = 0; OB_SUCC(ret) && i < key_cnt; ++i) {
+      value.v_ = i;
+      if (OB_FAIL(cache->put(keys[i], value))) {
+        LOG_WARN("put failed", K(ret), K(i));
+      }
+    }
+  }
+  state.set_error(ret);
+  state.set_items_processed(state.iterations() * key_cnt);
+}
+OB_MICRO_BENCH(kvcache_put, bench_kvcache_put)->arg(1 << 10)->arg(1 << 16);
+
+static void bench_kvcache_get(ObBenchState& state, const bool is_hit)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator allocator(ObModIds::TEST);
+  ObBenchCache* cache = NULL;
+  ObBenchCacheKey* keys = NULL;
+  ObBenchCacheValue value;
+  const ObBenchCacheValue* pvalue = NULL;
+  const int64_t key_cnt = state.arg();
+  int64_t hit_cnt = 0;
+  if (OB_FAIL(get_bench_cache(is_hit ? "bench_get_hit" : "bench_get_miss", cache))) {
+    LOG_WARN("get cache failed", K(ret));
+  } else if (OB_FAIL(init_cache_keys(key_cnt, state.get_seed(), allocator, keys))) {
+    LOG_WARN("init keys failed", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && is_hit && i < key_cnt; ++i) {
+    value.v_ = i;
+    if (OB_FAIL(cache->put(keys[i], value))) {
+      LOG_WARN("put failed", K(ret), K(i));
+    }
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    for (int64_t i = 0; OB_SUCC(ret) && i < key_cnt; ++i) {
+      ObKVCacheHandle handle;
+      if (OB_FAIL(cache->get(keys[i], pvalue, handle))) {
+        if (OB_ENTRY_NOT_EXIST == ret) {
+          ret = OB_SUCCESS;
+        } else {
+          LOG_WARN("get failed", K(ret), K(i));
+        }
+      } else {
+        ++hit_cnt;
+      }
+    }
+  }
+  if (OB_SUCC(ret) && is_hit && hit_cnt < state.iterations() * key_cnt) {
+    LOG_INFO("part of keys are washed", K(hit_cnt), K(key_cnt));
+  }
+  state.set_error(ret);
+  state.set_items_processed(state.iterations() * key_cnt);
+}
+
+static void bench_kvcache_get_hit(ObBenchState& state)
+{
+  bench_kvcache_get(state, true);
+}
+OB_MICRO_BENCH(kvcache_get_hit, bench_kvcache_get_hit)->arg(1 << 10)->arg(1 << 16);
+
+static void bench_kvcache_get_miss(ObBenchState& state)
+{
+  bench_kvcache_get(state, false);
+}
+OB_MICRO_BENCH(kvcache_get_miss, bench_kvcache_get_miss)->arg(1 << 10)->arg(1 << 16);
+
+}  // namespace benchmark
+}  // namespace oceanbase
@@ -0,0 +1,436 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "ob_micro_bench.h"
+#include "ob_bench_sql_env.h"
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_se_array.h"
+#include "sql/engine/aggregate/ob_aggregate_processor.h"
+#include "sql/engine/basic/ob_chunk_datum_store.h"
+#include "sql/engine/ob_sql_mem_mgr_processor.h"
+#include "sql/engine/ob_tenant_sql_memory_manager.h"
+#include "sql/engine/sort/ob_sort_op_impl.h"
+// hash table of hash join is private, the build and probe loops below mirror the operator
+#define private public
+#include "sql/engine/join/ob_hash_join_op.h"
+#undef private
+
+namespace oceanbase {
+namespace benchmark {
+using namespace common;
+using namespace sql;
+
+/*
+ * Input of a (c1 int, c2 varchar(16), c3 int) child operator, state.arg() is the row count.
+ * c1 has arg / 16 distinct values, so it is the group by key and the join key.
+ */
+class ObBenchSqlRows {
+public:
+  static const int64_t COL_CNT = 3;
+  static const int64_t VARCHAR_LEN = 16;
+  static const int64_t NDV_RATIO = 16;
+
+  ObBenchSqlRows() : allocator_(ObModIds::TEST), row_cnt_(0), keys_(NULL), values_(NULL), strs_(NULL), lens_(NULL)
+  {}
+  int init(const int64_t row_cnt, const uint64_t seed)
+  {
+    int ret = OB_SUCCESS;
+    ObBenchRandom random(seed);
+    const ObObjType types[COL_CNT] = {ObIntType, ObVarcharType, ObIntType};
+    row_cnt_ = row_cnt;
+    keys_ = static_cast<int64_t*>(allocator_.alloc(sizeof(int64_t) * row_cnt));
+    values_ = static_cast<int64_t*>(allocator_.alloc(sizeof(int64_t) * row_cnt));
+    strs_ = static_cast<char*>(allocator_.alloc(VARCHAR_LEN * row_cnt));
+    lens_ = static_cast<int32_t*>(allocator_.alloc(sizeof(int32_t) * row_cnt));
+    if (row_cnt <= 0) {
+      ret = OB_INVALID_ARGUMENT;
+      LOG_WARN("invalid row count", K(ret), K(row_cnt));
+    } else if (OB_ISNULL(keys_) || OB_ISNULL(values_) || OB_ISNULL(strs_) || OB_ISNULL(lens_)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc rows failed", K(ret), K(row_cnt));
+    } else if (OB_FAIL(env_.init())) {
+      LOG_WARN("init expr env failed", K(ret));
+    } else if (OB_FAIL(env_.add_exprs(types, COL_CNT, exprs_))) {
+      LOG_WARN("add input exprs failed", K(ret));
+    } else if (OB_FAIL(env_.add_exprs(types, COL_CNT, out_exprs_))) {
+      LOG_WARN("add output exprs failed", K(ret));
+    } else {
+      const int64_t ndv = std::max(row_cnt / NDV_RATIO, 1L);
+      random.fill(strs_, VARCHAR_LEN * row_cnt);
+      for (int64_t i = 0; i < row_cnt; ++i) {
+        keys_[i] = random.rand(0, ndv - 1);
+        values_[i] = random.rand(INT32_MIN, INT32_MAX);
+        lens_[i] = static_cast<int32_t>(random.rand(1, VARCHAR_LEN));
+      }
+    }
+    return ret;
+  }
+  // child operator returns row %idx
+  void fill_row(const int64_t idx)
+  {
+    env_.set_int(*exprs_.at(0), keys_[idx]);
+    env_.set_string(*exprs_.at(1), strs_ + idx * VARCHAR_LEN, lens_[idx]);
+    env_.set_int(*exprs_.at(2), values_[idx]);
+  }
+  int64_t get_row_cnt() const
+  {
+    return row_cnt_;
+  }
+  ObBenchExprEnv& get_env()
+  {
+    return env_;
+  }
+  ObIArray<ObExpr*>& get_exprs()
+  {
+    return exprs_;
+  }
+  ObIArray<ObExpr*>& get_out_exprs()
+  {
+    return out_exprs_;
+  }
+
+private:
+  ObArenaAllocator allocator_;
+  ObBenchExprEnv env_;
+  int64_t row_cnt_;
+  int64_t* keys_;
+  int64_t* values_;
+  char* strs_;
+  int32_t* lens_;
+  ObSEArray<ObExpr*, COL_CNT> exprs_;
+  ObSEArray<ObExpr*, COL_CNT> out_exprs_;
+};
+
+static int add_all_rows(ObBenchSqlRows& rows, ObChunkDatumStore& store)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < rows.get_row_cnt(); ++i) {
+    rows.fill_row(i);
+    if (OB_FAIL(store.add_row(rows.get_exprs(), &rows.get_env().get_eval_ctx()))) {
+      LOG_WARN("add row failed", K(ret), K(i));
+    }
+  }
+  return ret;
+}
+
+static void bench_chunk_datum_store_add(ObBenchState& state)
+{
+  int ret = OB_SUCCESS;
+  ObBenchSqlRows rows;
+  if (OB_FAIL(rows.init(state.arg(), state.get_seed()))) {
+    LOG_WARN("init rows failed", K(ret));
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    ObChunkDatumStore store;
+    if (OB_FAIL(store.init(0, OB_SYS_TENANT_ID, ObCtxIds::WORK_AREA, ObModIds::OB_SQL_CHUNK_ROW_STORE, false))) {
+      LOG_WARN("init datum store failed", K(ret));
+    } else if (OB_FAIL(add_all_rows(rows, store))) {
+      LOG_WARN("add rows failed", K(ret));
+    }
+    state.pause_timing();
+    store.reset();
+    state.resume_timing();
+  }
+  state.set_error(ret);
+  state.set_items_processed(state.iterations() * state.arg());
+}
+OB_MICRO_BENCH(chunk_datum_store_add, bench_chunk_datum_store_add)->arg(1 << 10)->arg(1 << 16)->arg(1 << 20);
+
+static void bench_chunk_datum_store_iterate(ObBenchState& state)
+{
+  int ret = OB_SUCCESS;
+  ObBenchSqlRows rows;
+  ObChunkDatumStore store;
+  if (OB_FAIL(rows.init(state.arg(), state.get_seed()))) {
+    LOG_WARN("init rows failed", K(ret));
+  } else if (OB_FAIL(store.init(0, OB_SYS_TENANT_ID, ObCtxIds::WORK_AREA, ObModIds::OB_SQL_CHUNK_ROW_STORE, false))) {
+    LOG_WARN("init datum store failed", K(ret));
+  } else if (OB_FAIL(add_all_rows(rows, store))) {
+    LOG_WARN("add rows failed", K(ret));
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    ObChunkDatumStore::Iterator it;
+    if (OB_FAIL(store.begin(it))) {
+      LOG_WARN("begin iterator failed", K(ret));
+    }
+    while (OB_SUCC(ret) && OB_SUCC(it.get_next_row(rows.get_out_exprs(), rows.get_env().get_eval_ctx()))) {}
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+    }
+  }
+  state.set_error(ret);
+  state.set_items_processed(state.iterations() * state.arg());
+}
+OB_MICRO_BENCH(chunk_datum_store_iterate, bench_chunk_datum_store_iterate)->arg(1 << 10)->arg(1 << 16)->arg(1 << 20);
+
+// order by c1, c2
+static void bench_sort_op_impl(ObBenchState& state)
+{
+  int ret = OB_SUCCESS;
+  ObBenchSqlRows rows;
+  ObSEArray<ObSortFieldCollation, 2> collations;
+  ObSEArray<ObSortCmpFunc, 2> cmp_funcs;
+  ObSEArray<ObExpr*, 2> sort_exprs;
+  if (OB_FAIL(rows.init(state.arg(), state.get_seed()))) {
+    LOG_WARN("init rows failed", K(ret));
+  } else if (OB_FAIL(collations.push_back(ObSortFieldCollation(0, CS_TYPE_BINARY, true, NULL_FIRST)))) {
+    LOG_WARN("push back collation failed", K(ret));
+  } else if (OB_FAIL(collations.push_back(ObSortFieldCollation(1, CS_TYPE_UTF8MB4_BIN, true, NULL_FIRST)))) {
+    LOG_WARN("push back collation failed", K(ret));
+  } else if (OB_FAIL(sort_exprs.push_back(rows.get_exprs().at(0)))) {
+    LOG_WARN("push back expr failed", K(ret));
+  } else if (OB_FAIL(sort_exprs.push_back(rows.get_exprs().at(1)))) {
+    LOG_WARN("push back expr failed", K(ret));
+  } else if (OB_FAIL(rows.get_env().init_cmp_funcs(sort_exprs, cmp_funcs))) {
+    LOG_WARN("init cmp funcs failed", K(ret));
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    ObSortOpImpl sort_impl;
+    if (OB_FAIL(sort_impl.init(OB_SYS_TENANT_ID, &collations, &cmp_funcs, &rows.get_env().get_eval_ctx()))) {
+      LOG_WARN("init sort impl failed", K(ret));
+    } else if (OB_FAIL(sort_impl.init_norm_key(rows.get_exprs()))) {
+      LOG_WARN("init normalized key failed", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < rows.get_row_cnt(); ++i) {
+      rows.fill_row(i);
+      if (OB_FAIL(sort_impl.add_row(rows.get_exprs()))) {
+        LOG_WARN("add row failed", K(ret), K(i));
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(sort_impl.sort())) {
+      LOG_WARN("sort failed", K(ret));
+    }
+    while (OB_SUCC(ret) && OB_SUCC(sort_impl.get_next_row(rows.get_out_exprs()))) {}
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+    }
+    state.pause_timing();
+    sort_impl.reset();
+    state.resume_timing();
+  }
+  state.set_error(ret);
+  state.set_items_processed(state.iterations() * state.arg());
+}
+OB_MICRO_BENCH(sort_op_impl, bench_sort_op_impl)->arg(1 << 10)->arg(1 << 16)->arg(1 << 20);
+
+/*
+ * Inner loop of ObHashGroupByOp::load_data() for group by c1: hash the group by exprs,
+ * probe the group row hash table, and add a new group row on miss. Aggregation itself
+ * is not included.
+ */
+static void bench_hash_groupby(ObBenchState& state)
+{
+  int ret = OB_SUCCESS;
+  ObBenchSqlRows rows;
+  ObArenaAllocator allocator(ObModIds::TEST);
+  ExprFixedArray group_exprs(allocator);
+  ObSEArray<ObCmpFunc, 1> cmp_funcs;
+  lib::ObMemAttr mem_attr(OB_SYS_TENANT_ID, ObModIds::OB_HASH_NODE_GROUP_ROWS, ObCtxIds::WORK_AREA);
+  ObSqlWorkAreaProfile profile(ObSqlWorkAreaType::HASH_WORK_AREA);
+  ObSqlMemMgrProcessor sql_mem_processor(profile);
+  int64_t group_cnt = 0;
+  if (OB_FAIL(rows.init(state.arg(), state.get_seed()))) {
+    LOG_WARN("init rows failed", K(ret));
+  } else if (OB_FAIL(group_exprs.init(1))) {
+    LOG_WARN("init group exprs failed", K(ret));
+  } else if (OB_FAIL(group_exprs.push_back(rows.get_exprs().at(0)))) {
+    LOG_WARN("push back group expr failed", K(ret));
+  } else if (OB_FAIL(rows.get_env().init_cmp_funcs(group_exprs, cmp_funcs))) {
+    LOG_WARN("init cmp funcs failed", K(ret));
+  } else if (OB_FAIL(sql_mem_processor.init(
+                 &allocator, OB_SYS_TENANT_ID, 0, PHY_HASH_GROUP_BY, 0, &rows.get_env().get_exec_ctx()))) {
+    LOG_WARN("init sql mem processor failed", K(ret));
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    ObArenaAllocator group_allocator(ObModIds::TEST);
+    ObChunkDatumStore group_store;
+    ObGroupRowHashTable group_rows;
+    ObGroupRowItem curr_item;
+    curr_item.group_exprs_ = &group_exprs;
+    ObEvalCtx& eval_ctx = rows.get_env().get_eval_ctx();
+    if (OB_FAIL(group_store.init(0, OB_SYS_TENANT_ID, ObCtxIds::WORK_AREA, ObModIds::OB_HASH_NODE_GROUP_ROWS, false))) {
+      LOG_WARN("init group store failed", K(ret));
+    } else if (OB_FAIL(group_rows.init(&group_allocator, mem_attr, &eval_ctx, &cmp_funcs, &sql_mem_processor))) {
+      LOG_WARN("init group row hash table failed", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < rows.get_row_cnt(); ++i) {
+      ObDatum* datum = NULL;
+      rows.fill_row(i);
+      curr_item.groupby_datums_hash_ = 99194853094755497L;
+      for (int64_t j = 0; OB_SUCC(ret) && j < group_exprs.count(); ++j) {
+        if (OB_FAIL(group_exprs.at(j)->eval(eval_ctx, datum))) {
+          LOG_WARN("eval failed", K(ret));
+        } else {
+          curr_item.groupby_datums_hash_ =
+              group_exprs.at(j)->basic_funcs_->murmur_hash_(*datum, curr_item.groupby_datums_hash_);
+        }
+      }
+      if (OB_FAIL(ret) || NULL != group_rows.get(curr_item)) {
+        // aggregate into existing group
+      } else {
+        ObChunkDatumStore::StoredRow* stored_row = NULL;
+        void* item_buf = group_allocator.alloc(sizeof(ObGroupRowItem));
+        void* row_buf = group_allocator.alloc(sizeof(ObAggregateProcessor::GroupRow));
+        if (OB_ISNULL(item_buf) || OB_ISNULL(row_buf)) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("alloc group row failed", K(ret));
+        } else if (OB_FAIL(group_store.add_row(group_exprs, &eval_ctx, &stored_row))) {
+          LOG_WARN("add group row failed", K(ret));
+        } else {
+          ObGroupRowItem* item = new (item_buf) ObGroupRowItem();
+          item->group_id_ = group_rows.size();
+          item->group_row_ = new (row_buf) ObAggregateProcessor::GroupRow();
+          item->group_row_->groupby_store_row_ = stored_row;
+          item->groupby_datums_hash_ = curr_item.groupby_datums_hash_;
+          if (OB_FAIL(group_rows.set(*item))) {
+            LOG_WARN("hash table set failed", K(ret));
+          }
+        }
+      }
+    }
+    group_cnt = group_rows.size();
+    state.pause_timing();
+    group_rows.destroy();
+    group_store.reset();
+    state.resume_timing();
+  }
+  LOG_INFO("hash group by", K(group_cnt), "row_cnt", state.arg());
+  state.set_error(ret);
+  state.set_items_processed(state.iterations() * state.arg());
+}
+OB_MICRO_BENCH(hash_groupby, bench_hash_groupby)->arg(1 << 10)->arg(1 << 16)->arg(1 << 20);
+
+/*
+ * Build and probe loops of ObHashJoinOp for in memory inner join on c1, the input
+ * rows are joined with themselves. Build rows are kept in a datum store with hash
+ * value in the extra payload, chained in PartHashJoinTable buckets.
+ */
+static void bench_hash_join(ObBenchState& state)
+{
+  int ret = OB_SUCCESS;
+  typedef ObHashJoinOp::HashTableCell HashTableCell;
+  ObBenchSqlRows rows;
+  ObArenaAllocator allocator(ObModIds::TEST);
+  ObSEArray<ObExpr*, 1> join_keys;
+  ObSEArray<ObHashFunc, 1> hash_funcs;
+  ObSEArray<ObCmpFunc, 1> cmp_funcs;
+  ObChunkDatumStore build_store;
+  const int64_t row_cnt = state.arg();
+  int64_t match_cnt = 0;
+  if (OB_FAIL(rows.init(row_cnt, state.get_seed()))) {
+    LOG_WARN("init rows failed", K(ret));
+  } else if (OB_FAIL(join_keys.push_back(rows.get_exprs().at(0)))) {
+    LOG_WARN("push back join key failed", K(ret));
+  } else if (OB_FAIL(rows.get_env().init_hash_funcs(join_keys, hash_funcs))) {
+    LOG_WARN("init hash funcs failed", K(ret));
+  } else if (OB_FAIL(rows.get_env().init_cmp_funcs(join_keys, cmp_funcs))) {
+    LOG_WARN("init cmp funcs failed", K(ret));
+  } else if (OB_FAIL(build_store.init(0,
+                 OB_SYS_TENANT_ID,
+                 ObCtxIds::WORK_AREA,
+                 ObModIds::OB_ARENA_HASH_JOIN,
+                 false,
+                 sizeof(ObHashJoinStoredJoinRow::ExtraInfo)))) {
+    LOG_WARN("init build store failed", K(ret));
+  }
+  ObEvalCtx& eval_ctx = rows.get_env().get_eval_ctx();
+  // hash value of row i, computed like ObHashJoinOp::calc_hash_value()
+  auto calc_hash = [&](uint64_t& hash_value) -> int {
+    int tmp_ret = OB_SUCCESS;
+    ObDatum* datum = NULL;
+    hash_value = ObHashJoinOp::HASH_SEED;
+    for (int64_t k = 0; OB_SUCCESS == tmp_ret && k < join_keys.count(); ++k) {
+      if (OB_SUCCESS == (tmp_ret = join_keys.at(k)->eval(eval_ctx, datum))) {
+        hash_value = hash_funcs.at(k).hash_func_(*datum, hash_value);
+      }
+    }
+    hash_value &= ObHashJoinStoredJoinRow::HASH_VAL_MASK;
+    return tmp_ret;
+  };
+  for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt; ++i) {
+    ObChunkDatumStore::StoredRow* stored_row = NULL;
+    uint64_t hash_value = 0;
+    rows.fill_row(i);
+    if (OB_FAIL(calc_hash(hash_value))) {
+      LOG_WARN("calc hash value failed", K(ret));
+    } else if (OB_FAIL(build_store.add_row(rows.get_exprs(), &eval_ctx, &stored_row))) {
+      LOG_WARN("add row failed", K(ret));
+    } else {
+      static_cast<ObHashJoinStoredJoinRow*>(stored_row)->set_hash_value(hash_value);
+    }
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    ObHashJoinOp::PartHashJoinTable hash_table;
+    ObChunkDatumStore::Iterator it;
+    const ObChunkDatumStore::StoredRow* sr = NULL;
+    int64_t cell_idx = 0;
+    hash_table.nbuckets_ = next_pow2(row_cnt * 2);
+    hash_table.row_count_ = row_cnt;
+    // build
+    if (OB_FAIL(hash_table.init(allocator))) {
+      LOG_WARN("init hash table failed", K(ret));
+    } else if (OB_FAIL(hash_table.buckets_->init(hash_table.nbuckets_))) {
+      LOG_WARN("init buckets failed", K(ret));
+    } else if (OB_FAIL(hash_table.collision_cnts_->init(hash_table.nbuckets_))) {
+      LOG_WARN("init collision counts failed", K(ret));
+    } else if (OB_FAIL(hash_table.all_cells_->init(hash_table.row_count_))) {
+      LOG_WARN("init cells failed", K(ret));
+    } else if (OB_FAIL(build_store.begin(it))) {
+      LOG_WARN("begin iterator failed", K(ret));
+    }
+    while (OB_SUCC(ret) && OB_SUCC(it.get_next_row(sr))) {
+      ObHashJoinStoredJoinRow* stored_row = const_cast<ObHashJoinStoredJoinRow*>(
+          static_cast<const ObHashJoinStoredJoinRow*>(sr));
+      const int64_t bucket_id = stored_row->get_hash_value() & (hash_table.nbuckets_ - 1);
+      HashTableCell* tuple = &(hash_table.all_cells_->at(cell_idx++));
+      tuple->stored_row_ = stored_row;
+      tuple->next_tuple_ = hash_table.buckets_->at(bucket_id);
+      hash_table.buckets_->at(bucket_id) = tuple;
+      hash_table.inc_collision(bucket_id);
+    }
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+    }
+    // probe
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt; ++i) {
+      uint64_t hash_value = 0;
+      ObDatum* probe_datum = NULL;
+      rows.fill_row(i);
+      if (OB_FAIL(calc_hash(hash_value))) {
+        LOG_WARN("calc hash value failed", K(ret));
+      } else if (OB_FAIL(join_keys.at(0)->eval(eval_ctx, probe_datum))) {
+        LOG_WARN("eval failed", K(ret));
+      } else {
+        HashTableCell* tuple = hash_table.buckets_->at(hash_value & (hash_table.nbuckets_ - 1));
+        for (; NULL != tuple; tuple = tuple->next_tuple_) {
+          if (hash_value == tuple->stored_row_->get_hash_value() &&
+              0 == cmp_funcs.at(0).cmp_func_(tuple->stored_row_->cells()[0], *probe_datum)) {
+            ++match_cnt;
+          }
+        }
+      }
+    }
+    state.pause_timing();
+    hash_table.free(&allocator);
+    state.resume_timing();
+  }
+  LOG_INFO("hash join", K(match_cnt), K(row_cnt));
+  state.set_error(ret);
+  // build and probe rows
+  state.set_items_processed(state.iterations() * row_cnt * 2);
+}
+OB_MICRO_BENCH(hash_join, bench_hash_join)->arg(1 << 10)->arg(1 << 16)->arg(1 << 20);
+
+}  // namespace benchmark
+}  // namespace oceanbase
@@ -0,0 +1,301 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_micro_bench.h"
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_se_array.h"
+#include "share/schema/ob_table_param.h"
+#include "storage/blocksstable/ob_column_map.h"
+#include "storage/blocksstable/ob_micro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_writer.h"
+#include "storage/blocksstable/ob_row_reader.h"
+#include "storage/blocksstable/ob_row_writer.h"
+#include "storage/blocksstable/ob_sparse_micro_block_reader.h"
+#include "storage/ob_i_store.h"
+
+namespace oceanbase {
+namespace benchmark {
+using namespace common;
+using namespace blocksstable;
+using namespace storage;
+using namespace share::schema;
+
+/*
+ * Rows of an (int, varchar(16), int, varchar(16), ...) table with two rowkey columns,
+ * state.arg() is the column count. Rowkeys are ascending so the rows can be put into
+ * a micro block directly. Sparse rows keep the rowkey and every other normal column.
+ */
+class ObBenchStoreRows {
+public:
+  static const int64_t ROWKEY_CNT = 2;
+  static const int64_t VARCHAR_LEN = 16;
+  static const int64_t MACRO_BLOCK_SIZE = 2L << 20;
+
+  ObBenchStoreRows() : allocator_(ObModIds::TEST), col_cnt_(0), row_cnt_(0), rows_(NULL)
+  {}
+  int init(const int64_t col_cnt, const int64_t row_cnt, const bool is_sparse, const uint64_t seed)
+  {
+    int ret = OB_SUCCESS;
+    ObBenchRandom random(seed);
+    col_cnt_ = col_cnt;
+    row_cnt_ = row_cnt;
+    const int64_t sparse_col_cnt = ROWKEY_CNT + (col_cnt - ROWKEY_CNT + 1) / 2;
+    if (col_cnt <= ROWKEY_CNT || col_cnt > OB_ROW_MAX_COLUMNS_COUNT || row_cnt <= 0) {
+      ret = OB_INVALID_ARGUMENT;
+      LOG_WARN("invalid argument", K(ret), K(col_cnt), K(row_cnt));
+    } else if (OB_ISNULL(rows_ = static_cast<ObStoreRow*>(allocator_.alloc(sizeof(ObStoreRow) * row_cnt)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc rows failed", K(ret), K(row_cnt));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < col_cnt; ++i) {
+      ObColDesc col_desc;
+      col_desc.col_id_ = OB_APP_MIN_COLUMN_ID + i;
+      if (0 == i % 2) {
+        col_desc.col_type_.set_int();
+      } else {
+        col_desc.col_type_.set_varchar();
+        col_desc.col_type_.set_collation_type(CS_TYPE_UTF8MB4_BIN);
+      }
+      if (OB_FAIL(cols_.push_back(col_desc))) {
+        LOG_WARN("push back column failed", K(ret));
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt; ++i) {
+      ObStoreRow& row = *new (rows_ + i) ObStoreRow();
+      ObObj* cells = static_cast<ObObj*>(allocator_.alloc(sizeof(ObObj) * col_cnt));
+      uint16_t* col_ids = static_cast<uint16_t*>(allocator_.alloc(sizeof(uint16_t) * col_cnt));
+      char* strs = static_cast<char*>(allocator_.alloc(VARCHAR_LEN * col_cnt));
+      if (OB_ISNULL(cells) || OB_ISNULL(col_ids) || OB_ISNULL(strs)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc row failed", K(ret));
+      } else {
+        random.fill(strs, VARCHAR_LEN * col_cnt);
+        int64_t cell_cnt = 0;
+        for (int64_t j = 0; j < col_cnt; ++j) {
+          if (is_sparse && j >= ROWKEY_CNT && 1 == (j - ROWKEY_CNT) % 2) {
+            continue;
+          }
+          ObObj& cell = cells[cell_cnt];
+          if (0 == j) {
+            cell.set_int(i);
+          } else if (0 == j % 2) {
+            cell.set_int(random.rand(INT32_MIN, INT32_MAX));
+          } else {
+            cell.set_varchar(strs + j * VARCHAR_LEN, static_cast<int32_t>(random.rand(1, VARCHAR_LEN)));
+            cell.set_collation_type(CS_TYPE_UTF8MB4_BIN);
+          }
+          col_ids[cell_cnt] = static_cast<uint16_t>(cols_.at(j).col_id_);
+          ++cell_cnt;
+        }
+        row.flag_ = ObActionFlag::OP_ROW_EXIST;
+        row.row_val_.cells_ = cells;
+        row.row_val_.count_ = is_sparse ? sparse_col_cnt : col_cnt;
+        row.capacity_ = col_cnt;
+        if (is_sparse) {
+          row.is_sparse_row_ = true;
+          row.column_ids_ = col_ids;
+        }
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(column_map_.init(allocator_, 0, ROWKEY_CNT, col_cnt, cols_))) {
+      LOG_WARN("init column map failed", K(ret));
+    }
+    return ret;
+  }
+  // output row with enough cells for a row of this table
+  int init_out_row(ObStoreRow& row)
+  {
+    int ret = OB_SUCCESS;
+    ObObj* cells = static_cast<ObObj*>(allocator_.alloc(sizeof(ObObj) * col_cnt_));
+    uint16_t* col_ids = static_cast<uint16_t*>(allocator_.alloc(sizeof(uint16_t) * col_cnt_));
+    if (OB_ISNULL(cells) || OB_ISNULL(col_ids)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc out row failed", K(ret));
+    } else {
+      row.row_val_.cells_ = cells;
+      row.row_val_.count_ = col_cnt_;
+      row.capacity_ = col_cnt_;
+      row.column_ids_ = col_ids;
+    }
+    return ret;
+  }
+  // build one micro block from the head rows, at most MACRO_BLOCK_SIZE
+  int build_micro_block(const bool is_sparse, ObMicroBlockWriter& writer, ObMicroBlockData& block)
+  {
+    int ret = OB_SUCCESS;
+    char* buf = NULL;
+    int64_t size = 0;
+    if (OB_FAIL(writer.init(MACRO_BLOCK_SIZE, ROWKEY_CNT, is_sparse ? 0 : col_cnt_,
+            is_sparse ? SPARSE_ROW_STORE : FLAT_ROW_STORE))) {
+      LOG_WARN("init micro block writer failed", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt_; ++i) {
+      if (OB_FAIL(writer.append_row(rows_[i]))) {
+        LOG_WARN("append row failed", K(ret), K(i));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      if (OB_FAIL(writer.build_block(buf, size))) {
+        LOG_WARN("build micro block failed", K(ret));
+      } else {
+        block.buf_ = buf;
+        block.size_ = size;
+      }
+    }
+    return ret;
+  }
+  int64_t get_row_cnt() const
+  {
+    return row_cnt_;
+  }
+  const ObStoreRow& get_row(const int64_t idx) const
+  {
+    return rows_[idx];
+  }
+  const ObColumnMap& get_column_map() const
+  {
+    return column_map_;
+  }
+
+private:
+  ObArenaAllocator allocator_;
+  int64_t col_cnt_;
+  int64_t row_cnt_;
+  ObStoreRow* rows_;
+  ObSEArray<ObColDesc, 64> cols_;
+  ObColumnMap column_map_;
+};
+
+static const int64_t BENCH_ROW_CNT = 1024;
+
+static void bench_row_writer(ObBenchState& state)
+{
+  int ret = OB_SUCCESS;
+  ObBenchStoreRows rows;
+  ObRowWriter writer;
+  const int64_t buf_size = ObBenchStoreRows::MACRO_BLOCK_SIZE;
+  ObArenaAllocator allocator(ObModIds::TEST);
+  char* buf = static_cast<char*>(allocator.alloc(buf_size));
+  if (OB_ISNULL(buf)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else if (OB_FAIL(rows.init(state.arg(), BENCH_ROW_CNT, false, state.get_seed()))) {
+    LOG_WARN("init rows failed", K(ret));
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    int64_t pos = 0;
+    int64_t rowkey_start = 0;
+    int64_t rowkey_end = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < BENCH_ROW_CNT; ++i) {
+      if (OB_FAIL(writer.write(
+              ObBenchStoreRows::ROWKEY_CNT, rows.get_row(i), buf, buf_size, pos, rowkey_start, rowkey_end))) {
+        LOG_WARN("write row failed", K(ret), K(i));
+      }
+    }
+  }
+  state.set_error(ret);
+  state.set_items_processed(state.iterations() * BENCH_ROW_CNT);
+}
+OB_MICRO_BENCH(row_writer, bench_row_writer)->arg(8)->arg(32)->arg(128);
+
+static void bench_row_reader(ObBenchState& state)
+{
+  int ret = OB_SUCCESS;
+  ObBenchStoreRows rows;
+  ObRowWriter writer;
+  ObFlatRowReader reader;
+  ObStoreRow out_row;
+  const int64_t buf_size = ObBenchStoreRows::MACRO_BLOCK_SIZE;
+  ObArenaAllocator allocator(ObModIds::TEST);
+  ObArenaAllocator read_allocator(ObModIds::TEST);
+  char* buf = static_cast<char*>(allocator.alloc(buf_size));
+  int64_t row_pos[BENCH_ROW_CNT + 1];
+  if (OB_ISNULL(buf)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else if (OB_FAIL(rows.init(state.arg(), BENCH_ROW_CNT, false, state.get_seed()))) {
+    LOG_WARN("init rows failed", K(ret));
+  } else if (OB_FAIL(rows.init_out_row(out_row))) {
+    LOG_WARN("init out row failed", K(ret));
+  } else {
+    int64_t pos = 0;
+    int64_t rowkey_start = 0;
+    int64_t rowkey_end = 0;
+    row_pos[0] = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < BENCH_ROW_CNT; ++i) {
+      if (OB_FAIL(writer.write(
+              ObBenchStoreRows::ROWKEY_CNT, rows.get_row(i), buf, buf_size, pos, rowkey_start, rowkey_end))) {
+        LOG_WARN("write row failed", K(ret), K(i));
+      } else {
+        row_pos[i + 1] = pos;
+      }
+    }
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    for (int64_t i = 0; OB_SUCC(ret) && i < BENCH_ROW_CNT; ++i) {
+      if (OB_FAIL(reader.read_row(buf, row_pos[i + 1], row_pos[i], rows.get_column_map(), read_allocator, out_row))) {
+        LOG_WARN("read row failed", K(ret), K(i));
+      }
+    }
+    read_allocator.reuse();
+  }
+  state.set_error(ret);
+  state.set_items_processed(state.iterations() * BENCH_ROW_CNT);
+}
+OB_MICRO_BENCH(row_reader, bench_row_reader)->arg(8)->arg(32)->arg(128);
+
+template <typename Reader>
+static void bench_micro_block_reader(ObBenchState& state, const bool is_sparse)
+{
+  int ret = OB_SUCCESS;
+  ObBenchStoreRows rows;
+  ObMicroBlockWriter writer;
+  ObMicroBlockData block;
+  ObStoreRow out_row;
+  Reader reader;
+  // sparse reader decodes the whole row without column map
+  const ObColumnMap* column_map = is_sparse ? NULL : &rows.get_column_map();
+  if (OB_FAIL(rows.init(state.arg(), BENCH_ROW_CNT, is_sparse, state.get_seed()))) {
+    LOG_WARN("init rows failed", K(ret));
+  } else if (OB_FAIL(rows.init_out_row(out_row))) {
+    LOG_WARN("init out row failed", K(ret));
+  } else if (OB_FAIL(rows.build_micro_block(is_sparse, writer, block))) {
+    LOG_WARN("build micro block failed", K(ret));
+  } else if (OB_FAIL(reader.init(block, column_map))) {
+    LOG_WARN("init micro block reader failed", K(ret));
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    for (int64_t i = 0; OB_SUCC(ret) && i < BENCH_ROW_CNT; ++i) {
+      out_row.row_val_.count_ = out_row.capacity_;
+      if (OB_FAIL(reader.get_row(i, out_row))) {
+        LOG_WARN("get row failed", K(ret), K(i));
+      }
+    }
+  }
+  state.set_error(ret);
+  state.set_items_processed(state.iterations() * BENCH_ROW_CNT);
+}
+
+static void bench_flat_micro_block_reader(ObBenchState& state)
+{
+  bench_micro_block_reader<ObMicroBlockReader>(state, false);
+}
+OB_MICRO_BENCH(micro_block_reader, bench_flat_micro_block_reader)->arg(8)->arg(32)->arg(128);
+
+static void bench_sparse_micro_block_reader(ObBenchState& state)
+{
+  bench_micro_block_reader<ObSparseMicroBlockReader>(state, true);
+}
+OB_MICRO_BENCH(sparse_micro_block_reader, bench_sparse_micro_block_reader)->arg(8)->arg(32)->arg(128);
+
+}  // namespace benchmark
+}  // namespace oceanbase
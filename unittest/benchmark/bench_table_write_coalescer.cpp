@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SERVER
+
+#include <thread>
+#include "ob_micro_bench.h"
+#include "share/ob_errno.h"
+#include "observer/table/ob_table_write_coalescer.h"
+
+namespace oceanbase {
+namespace benchmark {
+using namespace common;
+using namespace observer;
+
+static const int64_t WRITE_CNT_PER_THREAD = 64;
+static const uint64_t TABLE_ID = 1099511677777;
+static const int64_t TIMEOUT_US = 10 * 1000 * 1000;
+// the clog sync of a commit, paid once by a group
+static const int64_t COMMIT_US = 100;
+// waiting for the lock holder, paid by the request meeting the conflict
+static const int64_t LOCK_WAIT_US = 200;
+
+struct ObBenchWriteTask : public ObTableCoalesceTask {
+  explicit ObBenchWriteTask(const bool is_conflict) : is_conflict_(is_conflict)
+  {}
+  const bool is_conflict_;
+};
+
+/*
+ * Single row writes of arg() threads to one partition, the execution of a write is
+ * free and every transaction pays COMMIT_US. A write conflicts with another transaction
+ * with the probability 1 / conflict_ratio, the leader hands it back to its requester the
+ * way ObTableApiExecuteP does, and it is executed alone after waiting for the lock.
+ */
+class ObWriteCoalesceBench {
+public:
+  ObWriteCoalesceBench(const int64_t window_us, const int64_t conflict_ratio)
+      : window_us_(window_us), conflict_ratio_(conflict_ratio), ret_(OB_SUCCESS)
+  {}
+  int init()
+  {
+    return coalescer_.init();
+  }
+  void destroy()
+  {
+    coalescer_.destroy();
+  }
+  int run(const int64_t thread_cnt, const uint64_t seed);
+
+private:
+  static void execute_alone(const bool is_conflict)
+  {
+    if (is_conflict) {
+      ::usleep(LOCK_WAIT_US);
+    }
+    ::usleep(COMMIT_US);
+  }
+  int write(const bool is_conflict);
+  void execute_group(ObTableCoalesceTask& leader);
+
+private:
+  ObTableWriteCoalescer coalescer_;
+  const int64_t window_us_;
+  const int64_t conflict_ratio_;
+  int ret_;
+};
+
+int ObWriteCoalesceBench::run(const int64_t thread_cnt, const uint64_t seed)
+{
+  std::thread* threads = new std::thread[thread_cnt];
+  for (int64_t i = 0; i < thread_cnt; ++i) {
+    threads[i] = std::thread([this, i, seed]() {
+      int ret = OB_SUCCESS;
+      ObBenchRandom random(seed + i);
+      for (int64_t j = 0; OB_SUCC(ret) && j < WRITE_CNT_PER_THREAD; ++j) {
+        const bool is_conflict = conflict_ratio_ > 0 && 0 == random.rand(0, conflict_ratio_ - 1);
+        if (OB_FAIL(write(is_conflict))) {
+          LOG_WARN("write failed", K(ret), K(j));
+          ATOMIC_STORE(&ret_, ret);
+        }
+      }
+    });
+  }
+  for (int64_t i = 0; i < thread_cnt; ++i) {
+    threads[i].join();
+  }
+  delete[] threads;
+  return ATOMIC_LOAD(&ret_);
+}
+
+int ObWriteCoalesceBench::write(const bool is_conflict)
+{
+  int ret = OB_SUCCESS;
+  ObBenchWriteTask task(is_conflict);
+  task.table_id_ = TABLE_ID;
+  task.partition_id_ = 1;
+  task.timeout_ts_ = ObTimeUtility::current_time() + TIMEOUT_US;
+  if (window_us_ <= 0) {
+    execute_alone(is_conflict);
+  } else {
+    switch (coalescer_.join(task)) {
+      case ObTableWriteCoalescer::LEADER:
+        execute_group(task);
+        if (OB_TRY_LOCK_ROW_CONFLICT == task.ret_) {
+          // retried alone by the leader request
+          execute_alone(is_conflict);
+        }
+        break;
+      case ObTableWriteCoalescer::FOLLOWER:
+        if (OB_FAIL(coalescer_.wait(task))) {
+          LOG_WARN("wait failed", K(ret), K(task));
+        } else if (task.is_handed_back_) {
+          execute_alone(is_conflict);
+        }
+        break;
+      default:
+        execute_alone(is_conflict);
+        break;
+    }
+  }
+  return ret;
+}
+
+void ObWriteCoalesceBench::execute_group(ObTableCoalesceTask& leader)
+{
+  ObTableCoalesceTask* head = coalescer_.close_group(leader, window_us_);
+  if (static_cast<ObBenchWriteTask&>(leader).is_conflict_) {
+    // nothing is executed after a conflict of the leader
+    leader.ret_ = OB_TRY_LOCK_ROW_CONFLICT;
+    for (ObTableCoalesceTask* task = leader.next_; NULL != task; task = task->next_) {
+      task->is_handed_back_ = true;
+    }
+  } else {
+    for (ObTableCoalesceTask* task = head->next_; NULL != task; task = task->next_) {
+      task->is_handed_back_ = static_cast<ObBenchWriteTask*>(task)->is_conflict_;
+    }
+    ::usleep(COMMIT_US);
+  }
+  coalescer_.finish_group(leader);
+}
+
+static void bench_write_coalesce(ObBenchState& state, const int64_t window_us, const int64_t conflict_ratio)
+{
+  int ret = OB_SUCCESS;
+  ObWriteCoalesceBench bench(window_us, conflict_ratio);
+  if (OB_FAIL(bench.init())) {
+    LOG_WARN("init coalescer failed", K(ret));
+  }
+  while (OB_SUCC(ret) && state.keep_running()) {
+    if (OB_FAIL(bench.run(state.arg(), state.get_seed() + state.iterations()))) {
+      LOG_WARN("run failed", K(ret));
+    }
+  }
+  bench.destroy();
+  state.set_error(ret);
+  state.set_items_processed(state.iterations() * state.arg() * WRITE_CNT_PER_THREAD);
+}
+
+static void bench_write_coalesce_off(ObBenchState& state)
+{
+  bench_write_coalesce(state, 0, 0);
+}
+OB_MICRO_BENCH(write_coalesce_off, bench_write_coalesce_off)->arg(1)->arg(8)->arg(32);
+
+static void bench_write_coalesce_on(ObBenchState& state)
+{
+  bench_write_coalesce(state, 200, 0);
+}
+OB_MICRO_BENCH(write_coalesce_on, bench_write_coalesce_on)->arg(1)->arg(8)->arg(32);
+
+// one of 8 writes meets a lock conflict
+static void bench_write_coalesce_off_conflict(ObBenchState& state)
+{
+  bench_write_coalesce(state, 0, 8);
+}
+OB_MICRO_BENCH(write_coalesce_off_conflict, bench_write_coalesce_off_conflict)->arg(1)->arg(8)->arg(32);
+
+static void bench_write_coalesce_on_conflict(ObBenchState& state)
+{
+  bench_write_coalesce(state, 200, 8);
+}
+OB_MICRO_BENCH(write_coalesce_on_conflict, bench_write_coalesce_on_conflict)->arg(1)->arg(8)->arg(32);
+
+}  // namespace benchmark
+}  // namespace oceanbase
@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_UNITTEST_BENCHMARK_OB_BENCH_SQL_ENV_H_
+#define OCEANBASE_UNITTEST_BENCHMARK_OB_BENCH_SQL_ENV_H_
+
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_iarray.h"
+#include "share/datum/ob_datum_funcs.h"
+#include "sql/engine/expr/ob_expr.h"
+#include "sql/engine/ob_exec_context.h"
+
+namespace oceanbase {
+namespace benchmark {
+
+/*
+ * Column reference exprs living in one frame, which is what operators see as
+ * child output. Values are filled by set_int()/set_string() and are always
+ * evaluated, so no eval function is involved.
+ */
+class ObBenchExprEnv {
+public:
+  static const int64_t FRAME_SIZE = 64L << 10;
+  // datum, eval info and 8 bytes for fixed length value
+  static const int64_t EXPR_FRAME_SIZE = sizeof(common::ObDatum) + sizeof(sql::ObEvalInfo) + sizeof(int64_t);
+
+  ObBenchExprEnv()
+      : alloc_(common::ObModIds::TEST),
+        eval_res_(common::ObModIds::TEST),
+        eval_tmp_(common::ObModIds::TEST),
+        eval_ctx_(exec_ctx_, eval_res_, eval_tmp_),
+        frame_pos_(0)
+  {}
+  int init()
+  {
+    int ret = common::OB_SUCCESS;
+    if (OB_ISNULL(eval_ctx_.frames_ = static_cast<char**>(alloc_.alloc(sizeof(char*))))) {
+      ret = common::OB_ALLOCATE_MEMORY_FAILED;
+    } else if (OB_ISNULL(eval_ctx_.frames_[0] = static_cast<char*>(alloc_.alloc(FRAME_SIZE)))) {
+      ret = common::OB_ALLOCATE_MEMORY_FAILED;
+    } else {
+      MEMSET(eval_ctx_.frames_[0], 0, FRAME_SIZE);
+    }
+    return ret;
+  }
+  int add_exprs(const common::ObObjType* types, const int64_t cnt, common::ObIArray<sql::ObExpr*>& exprs)
+  {
+    int ret = common::OB_SUCCESS;
+    for (int64_t i = 0; OB_SUCC(ret) && i < cnt; ++i) {
+      void* buf = alloc_.alloc(sizeof(sql::ObExpr));
+      if (OB_ISNULL(buf) || frame_pos_ + EXPR_FRAME_SIZE > FRAME_SIZE) {
+        ret = common::OB_ALLOCATE_MEMORY_FAILED;
+      } else {
+        sql::ObExpr* expr = new (buf) sql::ObExpr();
+        expr->frame_idx_ = 0;
+        expr->datum_off_ = static_cast<uint32_t>(frame_pos_);
+        expr->eval_info_off_ = static_cast<uint32_t>(frame_pos_ + sizeof(common::ObDatum));
+        expr->datum_meta_.type_ = types[i];
+        expr->datum_meta_.cs_type_ = common::ObVarcharType == types[i] ? common::CS_TYPE_UTF8MB4_BIN
+                                                                     : common::CS_TYPE_BINARY;
+        expr->obj_meta_.set_type(types[i]);
+        expr->basic_funcs_ = common::ObDatumFuncs::get_basic_func(types[i], expr->datum_meta_.cs_type_);
+        frame_pos_ += EXPR_FRAME_SIZE;
+        new (&expr->locate_expr_datum(eval_ctx_)) common::ObDatum();
+        expr->get_eval_info(eval_ctx_).evaluated_ = true;
+        if (OB_FAIL(exprs.push_back(expr))) {
+          SQL_ENG_LOG(WARN, "push back expr failed", K(ret));
+        }
+      }
+    }
+    return ret;
+  }
+  // datum may point to stored row after read, point it back to reserved buffer
+  void set_int(const sql::ObExpr& expr, const int64_t v)
+  {
+    common::ObDatum& datum = expr.locate_expr_datum(eval_ctx_);
+    datum.ptr_ = eval_ctx_.frames_[0] + expr.datum_off_ + sizeof(common::ObDatum) + sizeof(sql::ObEvalInfo);
+    datum.set_int(v);
+  }
+  void set_string(const sql::ObExpr& expr, const char* ptr, const int32_t len)
+  {
+    expr.locate_expr_datum(eval_ctx_).set_string(ptr, len);
+  }
+  int init_cmp_funcs(const common::ObIArray<sql::ObExpr*>& exprs, common::ObIArray<common::ObCmpFunc>& funcs)
+  {
+    int ret = common::OB_SUCCESS;
+    for (int64_t i = 0; OB_SUCC(ret) && i < exprs.count(); ++i) {
+      const sql::ObDatumMeta& meta = exprs.at(i)->datum_meta_;
+      common::ObCmpFunc func;
+      func.cmp_func_ =
+          common::ObDatumFuncs::get_nullsafe_cmp_func(meta.type_, meta.type_, common::NULL_FIRST, meta.cs_type_, false);
+      if (OB_FAIL(funcs.push_back(func))) {
+        SQL_ENG_LOG(WARN, "push back cmp func failed", K(ret));
+      }
+    }
+    return ret;
+  }
+  int init_hash_funcs(const common::ObIArray<sql::ObExpr*>& exprs, common::ObIArray<common::ObHashFunc>& funcs)
+  {
+    int ret = common::OB_SUCCESS;
+    for (int64_t i = 0; OB_SUCC(ret) && i < exprs.count(); ++i) {
+      common::ObHashFunc func;
+      func.hash_func_ = exprs.at(i)->basic_funcs_->murmur_hash_;
+      if (OB_FAIL(funcs.push_back(func))) {
+        SQL_ENG_LOG(WARN, "push back hash func failed", K(ret));
+      }
+    }
+    return ret;
+  }
+  sql::ObEvalCtx& get_eval_ctx()
+  {
+    return eval_ctx_;
+  }
+  sql::ObExecContext& get_exec_ctx()
+  {
+    return exec_ctx_;
+  }
+  common::ObIAllocator& get_allocator()
+  {
+    return alloc_;
+  }
+
+private:
+  common::ObArenaAllocator alloc_;
+  sql::ObExecContext exec_ctx_;
+  common::ObArenaAllocator eval_res_;
+  common::ObArenaAllocator eval_tmp_;
+  sql::ObEvalCtx eval_ctx_;
+  int64_t frame_pos_;
+};
+
+}  // namespace benchmark
+}  // namespace oceanbase
+
+#endif  // OCEANBASE_UNITTEST_BENCHMARK_OB_BENCH_SQL_ENV_H_
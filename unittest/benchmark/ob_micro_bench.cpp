@@ -0,0 +1,358 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX COMMON
+
+#include "ob_micro_bench.h"
+#include <algorithm>
+#include <getopt.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/utsname.h>
+#include "lib/alloc/ob_malloc_allocator.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/utility/ob_macro_utils.h"
+#include "common/ob_clock_generator.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
+#include "share/config/ob_server_config.h"
+#include "share/ob_tenant_mgr.h"
+#include "storage/blocksstable/ob_data_file_prepare.h"
+#include "storage/blocksstable/ob_tmp_file.h"
+
+namespace oceanbase {
+namespace benchmark {
+using namespace common;
+
+ObBenchState::ObBenchState(const int64_t arg, const int64_t max_iterations, const uint64_t seed)
+    : arg_(arg),
+      max_iterations_(max_iterations),
+      iterations_(0),
+      start_us_(0),
+      elapsed_us_(0),
+      items_processed_(0),
+      seed_(seed),
+      err_(OB_SUCCESS)
+{}
+
+ObBenchCase::ObBenchCase(const char* name, ObBenchFunc func) : name_(name), func_(func), arg_cnt_(0)
+{}
+
+ObBenchCase* ObBenchCase::arg(const int64_t arg)
+{
+  if (arg_cnt_ < MAX_ARG_CNT) {
+    args_[arg_cnt_++] = arg;
+  } else {
+    fprintf(stderr, "too many args for bench %s, ignore %ld\n", name_, arg);
+  }
+  return this;
+}
+
+ObBenchRegistry& ObBenchRegistry::get_instance()
+{
+  static ObBenchRegistry instance;
+  return instance;
+}
+
+ObBenchCase* ObBenchRegistry::add(const char* name, ObBenchFunc func)
+{
+  ObBenchCase* bench_case = new ObBenchCase(name, func);
+  if (case_cnt_ < MAX_CASE_CNT) {
+    cases_[case_cnt_++] = bench_case;
+  } else {
+    fprintf(stderr, "too many bench cases, ignore %s\n", name);
+  }
+  return bench_case;
+}
+
+struct ObBenchOptions {
+  ObBenchOptions() : filter_(NULL), json_file_(NULL), min_time_ms_(500), repetitions_(3), seed_(20210601)
+  {}
+  const char* filter_;
+  const char* json_file_;
+  int64_t min_time_ms_;
+  int64_t repetitions_;
+  uint64_t seed_;
+};
+
+struct ObBenchResult {
+  char name_[128];
+  int64_t arg_;
+  int64_t iterations_;
+  int64_t repetitions_;
+  double min_ns_per_item_;
+  double median_ns_per_item_;
+  double mean_ns_per_item_;
+  double items_per_second_;
+  int err_;
+};
+
+static void print_usage(const char* prog)
+{
+  fprintf(stderr,
+      "Usage: %s [options]\n"
+      "  -f, --filter=SUBSTR      only run cases whose name contains SUBSTR\n"
+      "  -j, --json=FILE          write results to FILE in JSON\n"
+      "  -t, --min_time_ms=MS     minimum time of one repetition, default 500\n"
+      "  -r, --repetitions=N      repetitions of each case, default 3\n"
+      "  -s, --seed=N             seed of synthetic data, default 20210601\n",
+      prog);
+}
+
+static int parse_options(int argc, char** argv, ObBenchOptions& opts)
+{
+  int ret = OB_SUCCESS;
+  static struct option long_opts[] = {{"filter", required_argument, NULL, 'f'},
+      {"json", required_argument, NULL, 'j'},
+      {"min_time_ms", required_argument, NULL, 't'},
+      {"repetitions", required_argument, NULL, 'r'},
+      {"seed", required_argument, NULL, 's'},
+      {"help", no_argument, NULL, 'h'},
+      {NULL, 0, NULL, 0}};
+  int c = 0;
+  while (OB_SUCC(ret) && -1 != (c = getopt_long(argc, argv, "f:j:t:r:s:h", long_opts, NULL))) {
+    switch (c) {
+      case 'f':
+        opts.filter_ = optarg;
+        break;
+      case 'j':
+        opts.json_file_ = optarg;
+        break;
+      case 't':
+        opts.min_time_ms_ = strtoll(optarg, NULL, 10);
+        break;
+      case 'r':
+        opts.repetitions_ = strtoll(optarg, NULL, 10);
+        break;
+      case 's':
+        opts.seed_ = strtoull(optarg, NULL, 10);
+        break;
+      default:
+        ret = OB_INVALID_ARGUMENT;
+        break;
+    }
+  }
+  if (OB_SUCC(ret) && (opts.min_time_ms_ <= 0 || opts.repetitions_ <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+  }
+  return ret;
+}
+
+static int run_once(ObBenchCase& bench_case, const int64_t arg, const int64_t iterations, const uint64_t seed,
+    int64_t& elapsed_us, double& ns_per_item)
+{
+  ObBenchState state(arg, iterations, seed);
+  bench_case.get_func()(state);
+  const int64_t items = state.get_items_processed() > 0 ? state.get_items_processed() : state.iterations();
+  elapsed_us = state.get_elapsed_us();
+  ns_per_item = items > 0 ? static_cast<double>(elapsed_us) * 1000 / static_cast<double>(items) : 0;
+  return state.get_error();
+}
+
+static int run_case(ObBenchCase& bench_case, const int64_t arg, const ObBenchOptions& opts, ObBenchResult& result)
+{
+  int ret = OB_SUCCESS;
+  static const int64_t MAX_ITERATIONS = 1L << 30;
+  static const int64_t MAX_REPETITIONS = 64;
+  const int64_t min_time_us = opts.min_time_ms_ * 1000;
+  int64_t iterations = 1;
+  int64_t elapsed_us = 0;
+  double ns_per_item = 0;
+  // find the iteration count which runs long enough, like google benchmark does
+  while (OB_SUCC(ret) && iterations < MAX_ITERATIONS) {
+    if (OB_FAIL(run_once(bench_case, arg, iterations, opts.seed_, elapsed_us, ns_per_item))) {
+      // reported below
+    } else if (elapsed_us >= min_time_us) {
+      break;
+    } else {
+      const int64_t multiplier = elapsed_us <= min_time_us / 10 ? 10 : (min_time_us * 14 / 10 / elapsed_us) + 1;
+      iterations = std::min(MAX_ITERATIONS, iterations * multiplier);
+    }
+  }
+
+  double samples[MAX_REPETITIONS];
+  const int64_t repetitions = std::min(opts.repetitions_, MAX_REPETITIONS);
+  int64_t sample_cnt = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && i < repetitions; ++i) {
+    if (OB_SUCC(run_once(bench_case, arg, iterations, opts.seed_, elapsed_us, ns_per_item))) {
+      samples[sample_cnt++] = ns_per_item;
+    }
+  }
+
+  snprintf(result.name_, sizeof(result.name_), "%s/%ld", bench_case.get_name(), arg);
+  result.arg_ = arg;
+  result.iterations_ = iterations;
+  result.repetitions_ = sample_cnt;
+  result.err_ = ret;
+  result.min_ns_per_item_ = 0;
+  result.median_ns_per_item_ = 0;
+  result.mean_ns_per_item_ = 0;
+  result.items_per_second_ = 0;
+  if (sample_cnt > 0) {
+    std::sort(samples, samples + sample_cnt);
+    double sum = 0;
+    for (int64_t i = 0; i < sample_cnt; ++i) {
+      sum += samples[i];
+    }
+    result.min_ns_per_item_ = samples[0];
+    result.median_ns_per_item_ = samples[sample_cnt / 2];
+    result.mean_ns_per_item_ = sum / static_cast<double>(sample_cnt);
+    result.items_per_second_ = result.median_ns_per_item_ > 0 ? 1e9 / result.median_ns_per_item_ : 0;
+  }
+  return ret;
+}
+
+static void print_json(FILE* file, const ObBenchOptions& opts, const ObBenchResult* results, const int64_t cnt)
+{
+  struct utsname uts;
+  char date[64] = "";
+  const time_t now = time(NULL);
+  struct tm tm_now;
+  if (NULL != localtime_r(&now, &tm_now)) {
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", &tm_now);
+  }
+  if (0 != uname(&uts)) {
+    snprintf(uts.nodename, sizeof(uts.nodename), "unknown");
+    snprintf(uts.release, sizeof(uts.release), "unknown");
+  }
+  fprintf(file, "{\n  \"context\": {\n");
+  fprintf(file, "    \"date\": \"%s\",\n", date);
+  fprintf(file, "    \"host_name\": \"%s\",\n", uts.nodename);
+  fprintf(file, "    \"kernel\": \"%s\",\n", uts.release);
+  fprintf(file, "    \"num_cpus\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+  fprintf(file, "    \"seed\": %lu,\n", opts.seed_);
+  fprintf(file, "    \"min_time_ms\": %ld,\n", opts.min_time_ms_);
+  fprintf(file, "    \"repetitions\": %ld\n", opts.repetitions_);
+  fprintf(file, "  },\n  \"benchmarks\": [");
+  for (int64_t i = 0; i < cnt; ++i) {
+    const ObBenchResult& r = results[i];
+    fprintf(file,
+        "%s\n    {\"name\": \"%s\", \"arg\": %ld, \"iterations\": %ld, \"repetitions\": %ld, "
+        "\"min_ns_per_item\": %.3f, \"median_ns_per_item\": %.3f, \"mean_ns_per_item\": %.3f, "
+        "\"items_per_second\": %.1f, \"error_code\": %d}",
+        0 == i ? "" : ",",
+        r.name_,
+        r.arg_,
+        r.iterations_,
+        r.repetitions_,
+        r.min_ns_per_item_,
+        r.median_ns_per_item_,
+        r.mean_ns_per_item_,
+        r.items_per_second_,
+        r.err_);
+  }
+  fprintf(file, "\n  ]\n}\n");
+}
+
+// Tenants, tenant config, kv cache, store file and tmp file used by storage and sql structures under benchmark,
+// the same environment as storage and sql engine unittests.
+static int init_env()
+{
+  int ret = OB_SUCCESS;
+  static blocksstable::TestDataFilePrepareUtil data_file_util;
+  const int64_t mem_limit = 4L << 30;
+  ObTenantManager& tenant_mgr = ObTenantManager::get_instance();
+  lib::ObMallocAllocator* malloc_allocator = lib::ObMallocAllocator::get_instance();
+  GCONF.enable_sql_operator_dump.set_value("False");
+  if (OB_FAIL(ObClockGenerator::init())) {
+    LOG_WARN("init clock generator failed", K(ret));
+  } else if (OB_FAIL(tenant_mgr.init(100000))) {
+    LOG_WARN("init tenant manager failed", K(ret));
+  } else if (OB_FAIL(tenant_mgr.add_tenant(OB_SYS_TENANT_ID))) {
+    LOG_WARN("add sys tenant failed", K(ret));
+  } else if (OB_FAIL(tenant_mgr.add_tenant(OB_SERVER_TENANT_ID))) {
+    LOG_WARN("add server tenant failed", K(ret));
+  } else if (OB_FAIL(omt::ObTenantConfigMgr::get_instance().add_tenant_config(OB_SYS_TENANT_ID))) {
+    LOG_WARN("add sys tenant config failed", K(ret));
+  } else if (OB_FAIL(tenant_mgr.set_tenant_mem_limit(OB_SYS_TENANT_ID, mem_limit, mem_limit))) {
+    LOG_WARN("set sys tenant memory limit failed", K(ret));
+  } else if (OB_FAIL(tenant_mgr.set_tenant_mem_limit(OB_SERVER_TENANT_ID, mem_limit, mem_limit))) {
+    LOG_WARN("set server tenant memory limit failed", K(ret));
+  } else if (OB_FAIL(malloc_allocator->create_tenant_ctx_allocator(OB_SYS_TENANT_ID, ObCtxIds::WORK_AREA))) {
+    LOG_WARN("create work area allocator failed", K(ret));
+  } else if (OB_FAIL(malloc_allocator->create_tenant_ctx_allocator(OB_SERVER_TENANT_ID, ObCtxIds::WORK_AREA))) {
+    LOG_WARN("create work area allocator failed", K(ret));
+  } else if (OB_FAIL(data_file_util.init("ob_micro_bench", 2L << 20, 1000))) {
+    LOG_WARN("init data file failed", K(ret));
+  } else if (OB_FAIL(data_file_util.open())) {
+    LOG_WARN("open data file failed", K(ret));
+  } else if (OB_FAIL(blocksstable::ObTmpFileManager::get_instance().init())) {
+    LOG_WARN("init tmp file manager failed", K(ret));
+  }
+  return ret;
+}
+
+}  // namespace benchmark
+}  // namespace oceanbase
+
+using namespace oceanbase::common;
+using namespace oceanbase::benchmark;
+
+int main(int argc, char** argv)
+{
+  int ret = OB_SUCCESS;
+  ObBenchOptions opts;
+  system("rm -f ob_micro_bench.log*");
+  OB_LOGGER.set_file_name("ob_micro_bench.log", true, false);
+  OB_LOGGER.set_log_level("WARN");
+  if (OB_FAIL(parse_options(argc, argv, opts))) {
+    print_usage(argv[0]);
+  } else if (OB_FAIL(init_env())) {
+    fprintf(stderr, "init bench env failed, ret=%d\n", ret);
+  } else {
+    ObBenchRegistry& registry = ObBenchRegistry::get_instance();
+    const int64_t max_result_cnt = ObBenchRegistry::MAX_CASE_CNT * ObBenchCase::MAX_ARG_CNT;
+    ObBenchResult* results = new ObBenchResult[max_result_cnt];
+    int64_t result_cnt = 0;
+    int failed_ret = OB_SUCCESS;
+    fprintf(stdout, "%-48s %12s %14s %14s %16s\n", "case", "iterations", "median ns/row", "min ns/row", "rows/s");
+    for (int64_t i = 0; i < registry.get_case_cnt(); ++i) {
+      ObBenchCase& bench_case = *registry.get_case(i);
+      if (NULL != opts.filter_ && NULL == strstr(bench_case.get_name(), opts.filter_)) {
+        continue;
+      }
+      // case without arg runs once with arg 0
+      const int64_t arg_cnt = std::max(bench_case.get_arg_cnt(), 1L);
+      for (int64_t j = 0; j < arg_cnt; ++j) {
+        ObBenchResult& result = results[result_cnt++];
+        const int64_t arg = bench_case.get_arg_cnt() > 0 ? bench_case.get_arg(j) : 0;
+        if (OB_SUCCESS != run_case(bench_case, arg, opts, result)) {
+          failed_ret = result.err_;
+          fprintf(stdout, "%-48s failed, ret=%d\n", result.name_, result.err_);
+        } else {
+          fprintf(stdout,
+              "%-48s %12ld %14.2f %14.2f %16.0f\n",
+              result.name_,
+              result.iterations_,
+              result.median_ns_per_item_,
+              result.min_ns_per_item_,
+              result.items_per_second_);
+        }
+        fflush(stdout);
+      }
+    }
+    if (NULL != opts.json_file_) {
+      FILE* file = fopen(opts.json_file_, "w");
+      if (NULL == file) {
+        ret = OB_IO_ERROR;
+        fprintf(stderr, "open %s failed, errno=%d\n", opts.json_file_, errno);
+      } else {
+        print_json(file, opts, results, result_cnt);
+        fclose(file);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      ret = failed_ret;
+    }
+    delete[] results;
+  }
+  return OB_SUCCESS == ret ? 0 : 1;
+}
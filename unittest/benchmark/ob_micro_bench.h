@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_UNITTEST_BENCHMARK_OB_MICRO_BENCH_H_
+#define OCEANBASE_UNITTEST_BENCHMARK_OB_MICRO_BENCH_H_
+
+#include "lib/ob_define.h"
+#include "lib/ob_errno.h"
+#include "lib/time/ob_time_utility.h"
+
+/*
+ * Minimal micro benchmark harness for row level hot paths.
+ *
+ * A case is a function taking ObBenchState, it prepares its data first and then
+ * runs the measured body in `while (state.keep_running()) { ... }`. One iteration
+ * usually processes a batch of rows, the case reports the batch size by
+ * set_items_processed() so that the result is comparable as ns per row.
+ *
+ *   static void bench_foo(ObBenchState& state)
+ *   {
+ *     prepare(state.arg());
+ *     while (state.keep_running()) {
+ *       do_foo();
+ *     }
+ *     state.set_items_processed(state.iterations() * state.arg());
+ *   }
+ *   OB_MICRO_BENCH(foo, bench_foo)->arg(1024)->arg(65536);
+ *
+ * The runner increases iterations until one run takes at least --min_time_ms, then
+ * repeats the run --repetitions times. Synthetic data is generated by ObBenchRandom
+ * seeded with --seed, so two runs of the same binary see the same data.
+ * Results are printed as a table, and written as JSON if --json=<file> is given.
+ */
+
+namespace oceanbase {
+namespace benchmark {
+
+// splitmix64, independent of libc so that data is the same on every platform
+class ObBenchRandom {
+public:
+  explicit ObBenchRandom(const uint64_t seed) : state_(seed)
+  {}
+  uint64_t next()
+  {
+    uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+  // [min, max]
+  int64_t rand(const int64_t min, const int64_t max)
+  {
+    return min + static_cast<int64_t>(next() % static_cast<uint64_t>(max - min + 1));
+  }
+  // printable characters
+  void fill(char* buf, const int64_t len)
+  {
+    for (int64_t i = 0; i < len; ++i) {
+      buf[i] = static_cast<char>('a' + next() % 26);
+    }
+  }
+
+private:
+  uint64_t state_;
+};
+
+class ObBenchState {
+public:
+  ObBenchState(const int64_t arg, const int64_t max_iterations, const uint64_t seed);
+  bool keep_running()
+  {
+    bool keep = true;
+    if (OB_UNLIKELY(0 == iterations_)) {
+      resume_timing();
+    }
+    if (OB_UNLIKELY(iterations_ >= max_iterations_) || OB_UNLIKELY(common::OB_SUCCESS != err_)) {
+      pause_timing();
+      keep = false;
+    } else {
+      ++iterations_;
+    }
+    return keep;
+  }
+  // exclude per iteration preparation from the measured time
+  void pause_timing()
+  {
+    if (start_us_ > 0) {
+      elapsed_us_ += common::ObTimeUtility::current_monotonic_raw_time() - start_us_;
+      start_us_ = 0;
+    }
+  }
+  void resume_timing()
+  {
+    start_us_ = common::ObTimeUtility::current_monotonic_raw_time();
+  }
+  void set_items_processed(const int64_t items)
+  {
+    items_processed_ = items;
+  }
+  // abort the case, the error is reported in the result
+  void set_error(const int err)
+  {
+    err_ = err;
+  }
+  int64_t arg() const
+  {
+    return arg_;
+  }
+  int64_t iterations() const
+  {
+    return iterations_;
+  }
+  int64_t get_elapsed_us() const
+  {
+    return elapsed_us_;
+  }
+  int64_t get_items_processed() const
+  {
+    return items_processed_;
+  }
+  int get_error() const
+  {
+    return err_;
+  }
+  uint64_t get_seed() const
+  {
+    return seed_;
+  }
+
+private:
+  int64_t arg_;
+  int64_t max_iterations_;
+  int64_t iterations_;
+  int64_t start_us_;
+  int64_t elapsed_us_;
+  int64_t items_processed_;
+  uint64_t seed_;
+  int err_;
+};
+
+typedef void (*ObBenchFunc)(ObBenchState& state);
+
+class ObBenchCase {
+public:
+  static const int64_t MAX_ARG_CNT = 8;
+  ObBenchCase(const char* name, ObBenchFunc func);
+  ObBenchCase* arg(const int64_t arg);
+  const char* get_name() const
+  {
+    return name_;
+  }
+  ObBenchFunc get_func() const
+  {
+    return func_;
+  }
+  int64_t get_arg_cnt() const
+  {
+    return arg_cnt_;
+  }
+  int64_t get_arg(const int64_t idx) const
+  {
+    return args_[idx];
+  }
+
+private:
+  const char* name_;
+  ObBenchFunc func_;
+  int64_t args_[MAX_ARG_CNT];
+  int64_t arg_cnt_;
+};
+
+class ObBenchRegistry {
+public:
+  static const int64_t MAX_CASE_CNT = 128;
+  static ObBenchRegistry& get_instance();
+  ObBenchCase* add(const char* name, ObBenchFunc func);
+  int64_t get_case_cnt() const
+  {
+    return case_cnt_;
+  }
+  ObBenchCase* get_case(const int64_t idx)
+  {
+    return cases_[idx];
+  }
+
+private:
+  ObBenchRegistry() : case_cnt_(0)
+  {}
+  ObBenchCase* cases_[MAX_CASE_CNT];
+  int64_t case_cnt_;
+};
+
+}  // namespace benchmark
+}  // namespace oceanbase
+
+#define OB_BENCH_CONCAT_(a, b) a##b
+#define OB_BENCH_CONCAT(a, b) OB_BENCH_CONCAT_(a, b)
+#define OB_MICRO_BENCH(name, func)                                        \
+  static ::oceanbase::benchmark::ObBenchCase* OB_BENCH_CONCAT(            \
+      ob_bench_case_, __LINE__) __attribute__((unused)) =                 \
+      ::oceanbase::benchmark::ObBenchRegistry::get_instance().add(#name, func)
+
+#endif  // OCEANBASE_UNITTEST_BENCHMARK_OB_MICRO_BENCH_H_
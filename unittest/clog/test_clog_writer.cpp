@@ -10,6 +10,7 @@
  * See the Mulan PubL v2 for more details.
  */
 
+#define private public
 #include "clog/ob_clog_writer.h"
 #include "clog/ob_log_file_trailer.h"
 #include "clog/ob_info_block_handler.h"
@@ -18,6 +19,7 @@
 #include "clog/ob_log_cache.h"
 #include "clog/ob_log_engine.h"
 #include "clog/ob_clog_file_writer.h"
+#include "clog/ob_batch_buffer.h"
 #include "clog/ob_log_block.h"
 #include "lib/utility/ob_tracepoint.h"
 #include "lib/resource/achunk_mgr.h"
@@ -27,6 +29,7 @@
 #include "share/ob_tenant_mgr.h"
 #include "observer/ob_server_struct.h"
 #include "share/redolog/ob_log_file_reader.h"
+#undef private
 
 #include <libaio.h>
 #include <gtest/gtest.h>
@@ -40,7 +43,7 @@ namespace oceanbase {
 namespace unittest {
 class MyMetaInfoGenerator : public ObIInfoBlockHandler {
 public:
-  MyMetaInfoGenerator()
+  MyMetaInfoGenerator() : entry_cnt_(1)
   {}
   virtual ~MyMetaInfoGenerator()
   {}
@@ -48,6 +51,7 @@ public:
   virtual int resolve_info_block(const char* buf, const int64_t buf_len, int64_t& pos);
   virtual int update_info(const int64_t max_submit_timestamp);
   virtual int64_t get_entry_cnt() const;
+  int64_t entry_cnt_;
 };
 
 // Mock a info block whose content is all 'Z' character, and its length variant from 2M to 512
@@ -75,12 +79,13 @@ int MyMetaInfoGenerator::update_info(const int64_t max_submit_timestamp)
 
 int64_t MyMetaInfoGenerator::get_entry_cnt() const
 {
-  return 1;
+  return entry_cnt_;
 }
 
 class MyCLogItem : public ObICLogItem {
 public:
-  MyCLogItem() : buf_(NULL), data_len_(0), is_flushed_(false), file_id_(0), offset_(0), err_code_(0)
+  MyCLogItem()
+      : buf_(NULL), data_len_(0), entry_cnt_(1), is_flushed_(false), file_id_(0), offset_(0), err_code_(0)
   {
     cond_.init(1);
   }
@@ -102,12 +107,17 @@ public:
   {
     return data_len_;
   }
+  virtual int64_t get_entry_cnt() const
+  {
+    return entry_cnt_;
+  }
   virtual int after_flushed(
       const file_id_t file_id, const offset_t offset, const int error_code, const ObLogWritePoolType type);
   void wait();
   TO_STRING_KV(KP_(buf), K_(data_len));
   char* buf_;
   int64_t data_len_;
+  int64_t entry_cnt_;
   bool is_flushed_;
   file_id_t file_id_;
   offset_t offset_;
@@ -436,6 +446,91 @@ TEST_F(TestCLogWriter, errsim_aio_timeout)
   usleep(100 * 1000);
 #endif
 }
+
+TEST_F(TestCLogWriter, group_commit)
+{
+  int ret = OB_SUCCESS;
+  file_id_t file_id = 1;
+  offset_t offset = 0;
+  const int64_t ITEM_CNT = 16;
+  const int64_t ITEM_BUF_SIZE = 64 * 1024;
+  MyCLogItem log_items[ITEM_CNT];
+  ObLogBlockMetaV2 block;
+  const int64_t block_meta_size = block.get_serialize_size();
+
+  ObCLogWriterCfg group_cfg = clog_cfg_;
+  group_cfg.base_cfg_.group_commit_max_item_cnt_ = 8;
+  clog_writer_.destroy();
+  ret = clog_writer_.init(group_cfg);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ret = clog_writer_.start(file_id, offset);
+  ASSERT_EQ(OB_SUCCESS, ret);
+
+  for (int64_t i = 0; i < ITEM_CNT; ++i) {
+    log_items[i].buf_ = log_buf_ + i * ITEM_BUF_SIZE + block_meta_size;
+    log_items[i].data_len_ = ObRandom::rand(1, ITEM_BUF_SIZE - block_meta_size);
+    memset(log_items[i].buf_, (uint8_t)ObRandom::rand(100, 132), log_items[i].data_len_);
+    ret = clog_writer_.append_log(log_items[i]);
+    ASSERT_EQ(OB_SUCCESS, ret);
+  }
+
+  // items flushed in the same group share one IO, but still lay back to back in file
+  for (int64_t i = 0; i < ITEM_CNT; ++i) {
+    log_items[i].wait();
+    ASSERT_EQ(OB_SUCCESS, log_items[i].err_code_);
+    ASSERT_EQ(file_id, log_items[i].file_id_);
+    ASSERT_EQ(offset + static_cast<offset_t>(block_meta_size), log_items[i].offset_);
+    offset += static_cast<offset_t>(log_items[i].data_len_ + block_meta_size);
+  }
+
+  clog_writer_.destroy();
+  log_file_writer_.reset();
+}
+
+// the info block entries of the buffers already in the group are reserved by their real count
+TEST_F(TestCLogWriter, group_entry_cnt)
+{
+  int ret = OB_SUCCESS;
+  file_id_t file_id = 1;
+  offset_t offset = 0;
+  const int64_t ITEM_CNT = 16;
+  const int64_t ITEM_BUF_SIZE = 4 * 1024;
+  const int64_t FULL_ENTRY_CNT = ObBatchBuffer::IncPos::MAX_ENTRY_CNT;
+  MyCLogItem log_items[ITEM_CNT];
+  ObIBaseLogItem* items[ITEM_CNT];
+  ObLogBlockMetaV2 block;
+  const int64_t block_meta_size = block.get_serialize_size();
+
+  ret = clog_writer_.start(file_id, offset);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  for (int64_t i = 0; i < ITEM_CNT; ++i) {
+    log_items[i].buf_ = log_buf_ + i * ITEM_BUF_SIZE + block_meta_size;
+    log_items[i].data_len_ = ITEM_BUF_SIZE - block_meta_size;
+    items[i] = &log_items[i];
+  }
+
+  // lightly loaded buffers are flushed in one group
+  ASSERT_EQ(ITEM_CNT, clog_writer_.calc_group_cnt(items, ITEM_CNT, block_meta_size));
+
+  // the group is cut once the entries in the group would overflow the info block
+  info_getter_.entry_cnt_ = ObCLogWriter::CLOG_MAX_SWITCH_FILE_LIMIT - 10;
+  for (int64_t i = 0; i < ITEM_CNT; ++i) {
+    log_items[i].entry_cnt_ = 4;
+  }
+  ASSERT_EQ(3, clog_writer_.calc_group_cnt(items, ITEM_CNT, block_meta_size));
+
+  // worst case, every buffer is full of entries, the limit holds 8 of them besides the one being written
+  info_getter_.entry_cnt_ = 1;
+  for (int64_t i = 0; i < ITEM_CNT; ++i) {
+    log_items[i].entry_cnt_ = FULL_ENTRY_CNT;
+  }
+  ASSERT_EQ(ObCLogWriter::CLOG_MAX_SWITCH_FILE_LIMIT / FULL_ENTRY_CNT + 1,
+      clog_writer_.calc_group_cnt(items, ITEM_CNT, block_meta_size));
+
+  info_getter_.entry_cnt_ = 1;
+  clog_writer_.destroy();
+  log_file_writer_.reset();
+}
 } // end namespace unittest
 } // end namespace oceanbase
 
@@ -0,0 +1,252 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#include "ob_obj2str_helper.h"      // ObObj2strHelper
+#include "ob_log_hbase_mode.h"      // ObLogHbaseUtil
+#undef private
+#include "lib/allocator/page_arena.h"   // ObArenaAllocator
+
+using namespace oceanbase::common;
+namespace oceanbase
+{
+namespace liboblog
+{
+static const uint64_t TENANT_ID = 1001;
+static const uint64_t HBASE_TABLE_ID = 1100611139453777;
+static const uint64_t T_COLUMN_ID = 18;
+
+class TestObj2strHelper : public ::testing::Test
+{
+public:
+  TestObj2strHelper() : allocator_(ObModIds::TEST) {}
+  ~TestObj2strHelper() {}
+
+  virtual void SetUp()
+  {
+    // binary output does not need time zone info or tenant manager
+    helper_.hbase_util_ = &hbase_util_;
+    helper_.enable_binary_output_ = true;
+    helper_.inited_ = true;
+    ASSERT_EQ(OB_SUCCESS, hbase_util_.init());
+    ASSERT_EQ(OB_SUCCESS, hbase_util_.table_id_set_.set_refactored(HBASE_TABLE_ID));
+    ASSERT_EQ(OB_SUCCESS, hbase_util_.column_id_map_.insert(ObLogHbaseUtil::TableID(HBASE_TABLE_ID), T_COLUMN_ID));
+  }
+  virtual void TearDown()
+  {
+    helper_.inited_ = false;
+    helper_.hbase_util_ = NULL;
+    hbase_util_.destroy();
+  }
+
+  // convert obj of a plain column, check it is output in binary of the expected length
+  void to_binary(const ObObj &obj, const bool deep_copy, const int64_t expect_len, ObString &str)
+  {
+    ObArray<ObString> extended_type_info;
+    ObAccuracy accuracy;
+    ASSERT_EQ(OB_SUCCESS, helper_.obj2str(TENANT_ID, 1, 16, obj, str, allocator_, deep_copy,
+        extended_type_info, accuracy, CS_TYPE_BINARY));
+    ASSERT_EQ(expect_len, str.length());
+  }
+  // fixed length value is a copy of the value in the obj, which is pointed to without deep copy
+  void check_fixed_len(const ObObj &obj, const int64_t expect_len)
+  {
+    ObString str;
+    bool is_binary = false;
+    ASSERT_EQ(OB_SUCCESS, helper_.is_binary_output_column(1, 16, obj.get_type(), is_binary));
+    ASSERT_TRUE(is_binary);
+
+    to_binary(obj, false, expect_len, str);
+    ASSERT_FALSE(HasFatalFailure());
+    ASSERT_EQ(obj.get_data_ptr(), static_cast<const void *>(str.ptr()));
+
+    to_binary(obj, true, expect_len, str);
+    ASSERT_FALSE(HasFatalFailure());
+    ASSERT_NE(obj.get_data_ptr(), static_cast<const void *>(str.ptr()));
+    ASSERT_EQ(0, MEMCMP(obj.get_data_ptr(), str.ptr(), expect_len));
+  }
+
+  ObArenaAllocator allocator_;
+  ObLogHbaseUtil hbase_util_;
+  ObObj2strHelper helper_;
+};
+
+TEST_F(TestObj2strHelper, fixed_len_types)
+{
+  ObObj obj;
+  int64_t int_val = 0;
+  double double_val = 0;
+  float float_val = 0;
+  int32_t date_val = 0;
+  ObString str;
+
+  // int/uint/bit/enum/set/datetime/timestamp/time: 8 bytes
+  obj.set_int(-5);
+  check_fixed_len(obj, 8);
+  ASSERT_FALSE(HasFatalFailure());
+  to_binary(obj, true, 8, str);
+  ASSERT_FALSE(HasFatalFailure());
+  MEMCPY(&int_val, str.ptr(), sizeof(int_val));
+  ASSERT_EQ(-5, int_val);
+
+  obj.set_uint64(UINT64_MAX);
+  check_fixed_len(obj, 8);
+  ASSERT_FALSE(HasFatalFailure());
+  obj.set_bit(0x5a);
+  check_fixed_len(obj, 8);
+  ASSERT_FALSE(HasFatalFailure());
+  obj.set_enum(3);
+  check_fixed_len(obj, 8);
+  ASSERT_FALSE(HasFatalFailure());
+  obj.set_set(6);
+  check_fixed_len(obj, 8);
+  ASSERT_FALSE(HasFatalFailure());
+  obj.set_time(3600 * 1000000L);
+  check_fixed_len(obj, 8);
+  ASSERT_FALSE(HasFatalFailure());
+  obj.set_datetime(1609459200000000L);
+  check_fixed_len(obj, 8);
+  ASSERT_FALSE(HasFatalFailure());
+
+  // timestamp is raw UTC microseconds, no matter enable_convert_timestamp_to_unix_timestamp
+  helper_.enable_convert_timestamp_to_unix_timestamp_ = true;
+  obj.set_timestamp(1609459200123456L);
+  check_fixed_len(obj, 8);
+  ASSERT_FALSE(HasFatalFailure());
+  to_binary(obj, true, 8, str);
+  ASSERT_FALSE(HasFatalFailure());
+  MEMCPY(&int_val, str.ptr(), sizeof(int_val));
+  ASSERT_EQ(1609459200123456L, int_val);
+
+  // float/double: native width
+  obj.set_float(1.5f);
+  check_fixed_len(obj, 4);
+  ASSERT_FALSE(HasFatalFailure());
+  to_binary(obj, true, 4, str);
+  ASSERT_FALSE(HasFatalFailure());
+  MEMCPY(&float_val, str.ptr(), sizeof(float_val));
+  ASSERT_EQ(1.5f, float_val);
+
+  obj.set_double(-2.25);
+  check_fixed_len(obj, 8);
+  ASSERT_FALSE(HasFatalFailure());
+  to_binary(obj, true, 8, str);
+  ASSERT_FALSE(HasFatalFailure());
+  MEMCPY(&double_val, str.ptr(), sizeof(double_val));
+  ASSERT_EQ(-2.25, double_val);
+
+  // date: 4 bytes, year: 1 byte
+  obj.set_date(18628);
+  check_fixed_len(obj, 4);
+  ASSERT_FALSE(HasFatalFailure());
+  to_binary(obj, true, 4, str);
+  ASSERT_FALSE(HasFatalFailure());
+  MEMCPY(&date_val, str.ptr(), sizeof(date_val));
+  ASSERT_EQ(18628, date_val);
+
+  obj.set_year(121);
+  check_fixed_len(obj, 1);
+  ASSERT_FALSE(HasFatalFailure());
+  to_binary(obj, true, 1, str);
+  ASSERT_FALSE(HasFatalFailure());
+  ASSERT_EQ(121, static_cast<uint8_t>(str.ptr()[0]));
+}
+
+TEST_F(TestObj2strHelper, number)
+{
+  const char *nums[] = {"0", "123.45", "-98765432109876543210.0123456789", "0.000001"};
+  for (int64_t i = 0; i < static_cast<int64_t>(sizeof(nums) / sizeof(nums[0])); ++i) {
+    number::ObNumber nmb;
+    ObObj obj;
+    ObString str;
+    bool is_binary = false;
+    ASSERT_EQ(OB_SUCCESS, nmb.from(nums[i], allocator_));
+    obj.set_number(nmb);
+    ASSERT_EQ(OB_SUCCESS, helper_.is_binary_output_column(1, 16, obj.get_type(), is_binary));
+    ASSERT_TRUE(is_binary);
+
+    // 4 bytes desc followed by digits, always copied
+    const int64_t digits_len = obj.get_number_byte_length();
+    for (int64_t deep_copy = 0; deep_copy < 2; ++deep_copy) {
+      to_binary(obj, deep_copy, static_cast<int64_t>(sizeof(uint32_t)) + digits_len, str);
+      ASSERT_FALSE(HasFatalFailure());
+      uint32_t desc = 0;
+      MEMCPY(&desc, str.ptr(), sizeof(desc));
+      ASSERT_EQ(obj.get_number_desc().desc_, desc);
+      ASSERT_EQ(0, MEMCMP(obj.get_data_ptr(), str.ptr() + sizeof(desc), digits_len));
+      ASSERT_NE(obj.get_data_ptr(), static_cast<const void *>(str.ptr() + sizeof(desc)));
+    }
+  }
+}
+
+TEST_F(TestObj2strHelper, text_types)
+{
+  ObObj obj;
+  ObString str;
+  bool is_binary = true;
+  ObObjType text_types[] = {ObNullType, ObVarcharType, ObCharType, ObRawType, ObHexStringType,
+      ObTimestampTZType, ObTimestampNanoType, ObIntervalYMType, ObIntervalDSType, ObLongTextType, ObJsonType};
+  for (int64_t i = 0; i < static_cast<int64_t>(sizeof(text_types) / sizeof(text_types[0])); ++i) {
+    ASSERT_EQ(OB_SUCCESS, helper_.is_binary_output_column(1, 16, text_types[i], is_binary));
+    ASSERT_FALSE(is_binary) << ob_obj_type_str(text_types[i]);
+  }
+
+  // strings are still passed through as bytes
+  ObArray<ObString> extended_type_info;
+  ObAccuracy accuracy;
+  obj.set_varchar("abc");
+  ASSERT_EQ(OB_SUCCESS, helper_.obj2str(TENANT_ID, 1, 16, obj, str, allocator_, false,
+      extended_type_info, accuracy, CS_TYPE_BINARY));
+  ASSERT_EQ(obj.get_string_ptr(), str.ptr());
+  obj.set_null();
+  ASSERT_EQ(OB_SUCCESS, helper_.obj2str(TENANT_ID, 1, 16, obj, str, allocator_, false,
+      extended_type_info, accuracy, CS_TYPE_BINARY));
+  ASSERT_TRUE(NULL == str.ptr());
+
+  // nothing is binary if disabled
+  helper_.enable_binary_output_ = false;
+  ASSERT_EQ(OB_SUCCESS, helper_.is_binary_output_column(1, 16, ObIntType, is_binary));
+  ASSERT_FALSE(is_binary);
+}
+
+TEST_F(TestObj2strHelper, hbase_T_column)
+{
+  bool is_binary = false;
+  helper_.enable_hbase_mode_ = true;
+
+  // only T column of hbase table is converted to text
+  ASSERT_EQ(OB_SUCCESS, helper_.is_binary_output_column(HBASE_TABLE_ID, T_COLUMN_ID, ObIntType, is_binary));
+  ASSERT_FALSE(is_binary);
+  ASSERT_EQ(OB_SUCCESS, helper_.is_binary_output_column(HBASE_TABLE_ID, T_COLUMN_ID - 1, ObIntType, is_binary));
+  ASSERT_TRUE(is_binary);
+  ASSERT_EQ(OB_SUCCESS, helper_.is_binary_output_column(HBASE_TABLE_ID + 1, T_COLUMN_ID, ObIntType, is_binary));
+  ASSERT_TRUE(is_binary);
+  ASSERT_EQ(OB_SUCCESS, helper_.is_binary_output_column(HBASE_TABLE_ID, T_COLUMN_ID, ObUInt64Type, is_binary));
+  ASSERT_TRUE(is_binary);
+
+  // T column is not converted in backup mode
+  helper_.enable_backup_mode_ = true;
+  ASSERT_EQ(OB_SUCCESS, helper_.is_binary_output_column(HBASE_TABLE_ID, T_COLUMN_ID, ObIntType, is_binary));
+  ASSERT_TRUE(is_binary);
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  OB_LOGGER.set_file_name("test_ob_obj2str_helper.log", true);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,299 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#include "observer/table/ob_htable_filter_parser.h"
+#include "observer/table/ob_htable_filters.h"
+#include "observer/table/ob_table_service.h"
+
+namespace oceanbase {
+namespace observer {
+using namespace common;
+using namespace table;
+
+// K, Q, T
+static const int64_t HTABLE_ROWKEY_CNT = 3;
+static const uint64_t TEST_TABLE_ID = 1099511677777;
+
+class TestHFilterScanRange : public ::testing::Test {
+public:
+  virtual void SetUp()
+  {
+    ASSERT_EQ(OB_SUCCESS, parser_.init(&allocator_));
+  }
+  virtual void TearDown()
+  {
+    parser_.destroy();
+  }
+  void parse_bound(const char *filter_cstr, hfilter::RowKeyBound &bound, const bool reversed = false)
+  {
+    hfilter::Filter *filter = NULL;
+    ASSERT_EQ(OB_SUCCESS, parser_.parse_filter(ObString::make_string(filter_cstr), filter));
+    ASSERT_TRUE(NULL != filter);
+    filter->set_reversed(reversed);
+    ASSERT_EQ(OB_SUCCESS, filter->narrow_row_key_bound(allocator_, bound));
+  }
+  // [start, end] on K, NULL for unlimited
+  void make_range(const char *start, const bool inclusive_start, const char *end, const bool inclusive_end,
+      ObNewRange &range)
+  {
+    range.table_id_ = TEST_TABLE_ID;
+    make_key(start, true, range.start_key_);
+    make_key(end, false, range.end_key_);
+    if (inclusive_start) {
+      range.border_flag_.set_inclusive_start();
+    } else {
+      range.border_flag_.unset_inclusive_start();
+    }
+    if (inclusive_end) {
+      range.border_flag_.set_inclusive_end();
+    } else {
+      range.border_flag_.unset_inclusive_end();
+    }
+  }
+  void make_key(const char *k, const bool is_start, ObRowkey &key)
+  {
+    if (NULL == k) {
+      if (is_start) {
+        key.set_min_row();
+      } else {
+        key.set_max_row();
+      }
+    } else {
+      ObObj *objs = static_cast<ObObj *>(allocator_.alloc(sizeof(ObObj) * HTABLE_ROWKEY_CNT));
+      ASSERT_TRUE(NULL != objs);
+      objs[0].set_varbinary(ObString::make_string(k));
+      for (int64_t i = 1; i < HTABLE_ROWKEY_CNT; ++i) {
+        objs[i] = is_start ? ObObj::make_min_obj() : ObObj::make_max_obj();
+      }
+      key.assign(objs, HTABLE_ROWKEY_CNT);
+    }
+  }
+  // K of %key is %k and the rest is MIN (before all cells of K) or MAX (after them)
+  static void check_key(const ObRowkey &key, const char *k, const bool is_min)
+  {
+    ASSERT_EQ(HTABLE_ROWKEY_CNT, key.get_obj_cnt());
+    ASSERT_EQ(ObString::make_string(k), key.get_obj_ptr()[0].get_varbinary());
+    for (int64_t i = 1; i < HTABLE_ROWKEY_CNT; ++i) {
+      ASSERT_EQ(is_min, key.get_obj_ptr()[i].is_min_value());
+      ASSERT_EQ(!is_min, key.get_obj_ptr()[i].is_max_value());
+    }
+  }
+  int narrow(const hfilter::RowKeyBound &bound, ObIArray<ObNewRange> &ranges)
+  {
+    return ObTableService::narrow_scan_ranges(allocator_, HTABLE_ROWKEY_CNT, bound, ranges);
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObHTableFilterParser parser_;
+};
+
+TEST_F(TestHFilterScanRange, inclusive_and_exclusive_bounds)
+{
+  // [b, d)
+  {
+    hfilter::RowKeyBound bound;
+    ObSEArray<ObNewRange, 4> ranges;
+    ObNewRange range;
+    parse_bound("RowFilter(>=, 'binary:b') AND RowFilter(<, 'binary:d')", bound);
+    ASSERT_TRUE(bound.is_bounded());
+    make_range(NULL, false, NULL, false, range);
+    ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+    ASSERT_EQ(OB_SUCCESS, narrow(bound, ranges));
+    ASSERT_EQ(1, ranges.count());
+    check_key(ranges.at(0).start_key_, "b", true);
+    check_key(ranges.at(0).end_key_, "d", true);
+    ASSERT_TRUE(ranges.at(0).border_flag_.inclusive_start());
+    ASSERT_TRUE(ranges.at(0).border_flag_.inclusive_end());
+  }
+  // (b, d]
+  {
+    hfilter::RowKeyBound bound;
+    ObSEArray<ObNewRange, 4> ranges;
+    ObNewRange range;
+    parse_bound("RowFilter(>, 'binary:b') AND RowFilter(<=, 'binary:d')", bound);
+    make_range(NULL, false, NULL, false, range);
+    ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+    ASSERT_EQ(OB_SUCCESS, narrow(bound, ranges));
+    ASSERT_EQ(1, ranges.count());
+    check_key(ranges.at(0).start_key_, "b", false);
+    check_key(ranges.at(0).end_key_, "d", false);
+  }
+  // [c, c], all cells of row c
+  {
+    hfilter::RowKeyBound bound;
+    ObSEArray<ObNewRange, 4> ranges;
+    ObNewRange range;
+    parse_bound("RowFilter(=, 'binary:c')", bound);
+    make_range("a", true, "z", true, range);
+    ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+    ASSERT_EQ(OB_SUCCESS, narrow(bound, ranges));
+    ASSERT_EQ(1, ranges.count());
+    check_key(ranges.at(0).start_key_, "c", true);
+    check_key(ranges.at(0).end_key_, "c", false);
+  }
+  // the tighter side of the range is kept with its border
+  {
+    hfilter::RowKeyBound bound;
+    ObSEArray<ObNewRange, 4> ranges;
+    ObNewRange range;
+    parse_bound("RowFilter(>=, 'binary:b') AND RowFilter(<, 'binary:y')", bound);
+    make_range("c", false, "x", false, range);
+    ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+    ASSERT_EQ(OB_SUCCESS, narrow(bound, ranges));
+    ASSERT_EQ(1, ranges.count());
+    ASSERT_EQ(0, ranges.at(0).start_key_.compare(range.start_key_));
+    ASSERT_EQ(0, ranges.at(0).end_key_.compare(range.end_key_));
+    ASSERT_FALSE(ranges.at(0).border_flag_.inclusive_start());
+    ASSERT_FALSE(ranges.at(0).border_flag_.inclusive_end());
+  }
+  // PrefixFilter is [prefix, successor of prefix)
+  {
+    hfilter::RowKeyBound bound;
+    ObSEArray<ObNewRange, 4> ranges;
+    ObNewRange range;
+    parse_bound("PrefixFilter('abc')", bound);
+    make_range(NULL, false, NULL, false, range);
+    ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+    ASSERT_EQ(OB_SUCCESS, narrow(bound, ranges));
+    ASSERT_EQ(1, ranges.count());
+    check_key(ranges.at(0).start_key_, "abc", true);
+    check_key(ranges.at(0).end_key_, "abd", true);
+  }
+}
+
+TEST_F(TestHFilterScanRange, not_bounded)
+{
+  const char *filters[] = {"RowFilter(>=, 'binary:b') OR RowFilter(<, 'binary:a')",
+      "Skip RowFilter(>=, 'binary:b')",
+      "While RowFilter(>=, 'binary:b')",
+      "RowFilter(>=, 'binary:b') AND (While RowFilter(<, 'binary:d'))",
+      "RowFilter(!=, 'binary:b')",
+      "ValueFilter(=, 'binary:b')",
+      "PageFilter(10)"};
+  for (int64_t i = 0; i < ARRAYSIZEOF(filters); ++i) {
+    hfilter::RowKeyBound bound;
+    parse_bound(filters[i], bound);
+    ASSERT_FALSE(bound.is_bounded()) << filters[i];
+  }
+}
+
+// storage orders the ranges by itself, so a reverse scan narrows its ranges the same way
+TEST_F(TestHFilterScanRange, reverse_scan)
+{
+  hfilter::RowKeyBound bound;
+  hfilter::RowKeyBound reversed_bound;
+  parse_bound("RowFilter(>=, 'binary:b') AND RowFilter(<, 'binary:n')", bound);
+  parse_bound("RowFilter(>=, 'binary:b') AND RowFilter(<, 'binary:n')", reversed_bound, true);
+  ASSERT_EQ(bound.lower_, reversed_bound.lower_);
+  ASSERT_EQ(bound.lower_inclusive_, reversed_bound.lower_inclusive_);
+  ASSERT_EQ(bound.upper_, reversed_bound.upper_);
+  ASSERT_EQ(bound.upper_inclusive_, reversed_bound.upper_inclusive_);
+
+  ObSEArray<ObNewRange, 4> ranges;
+  ObNewRange range;
+  make_range("m", true, "z", true, range);
+  ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+  make_range("c", true, "d", true, range);
+  ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+  make_range(NULL, false, "a", true, range);
+  ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+  ASSERT_EQ(OB_SUCCESS, narrow(reversed_bound, ranges));
+  ASSERT_EQ(2, ranges.count());
+  check_key(ranges.at(0).start_key_, "m", true);
+  check_key(ranges.at(0).end_key_, "n", true);
+  check_key(ranges.at(1).start_key_, "c", true);
+  check_key(ranges.at(1).end_key_, "d", false);
+}
+
+TEST_F(TestHFilterScanRange, no_overlap)
+{
+  ObSEArray<ObNewRange, 4> ranges;
+  ObNewRange range;
+  make_range("x", true, "y", true, range);
+  ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+  make_range(NULL, false, "a", false, range);
+  ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+
+  // no range passes, a false range which storage skips replaces them, an empty array is a whole scan
+  hfilter::RowKeyBound bound;
+  parse_bound("PrefixFilter('abc')", bound);
+  ASSERT_EQ(OB_SUCCESS, narrow(bound, ranges));
+  ASSERT_EQ(1, ranges.count());
+  ASSERT_TRUE(ranges.at(0).is_false_range());
+  ASSERT_EQ(TEST_TABLE_ID, ranges.at(0).table_id_);
+
+  // contradicting filters
+  hfilter::RowKeyBound empty_bound;
+  ranges.reuse();
+  make_range(NULL, false, NULL, false, range);
+  ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+  parse_bound("RowFilter(>, 'binary:d') AND RowFilter(<, 'binary:b')", empty_bound);
+  ASSERT_EQ(OB_SUCCESS, narrow(empty_bound, ranges));
+  ASSERT_EQ(1, ranges.count());
+  ASSERT_TRUE(ranges.at(0).is_false_range());
+
+  // exclusive bounds on the same row key
+  hfilter::RowKeyBound exclusive_bound;
+  ranges.reuse();
+  ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+  parse_bound("RowFilter(>, 'binary:b') AND RowFilter(<, 'binary:b')", exclusive_bound);
+  ASSERT_EQ(OB_SUCCESS, narrow(exclusive_bound, ranges));
+  ASSERT_EQ(1, ranges.count());
+  ASSERT_TRUE(ranges.at(0).is_false_range());
+}
+
+TEST_F(TestHFilterScanRange, page_filter)
+{
+  const int64_t PAGE_SIZE = 3;
+  hfilter::PageFilter filter(PAGE_SIZE);
+  ASSERT_TRUE(filter.has_filter_row());
+  for (int64_t i = 0; i < PAGE_SIZE; ++i) {
+    ASSERT_FALSE(filter.filter_all_remaining());
+    filter.reset();
+    ASSERT_FALSE(filter.filter_row());
+  }
+  // the page is full, rows after it are filtered and the scan terminates
+  ASSERT_TRUE(filter.filter_all_remaining());
+  ASSERT_TRUE(filter.filter_row());
+
+  hfilter::PageFilter empty_page(0);
+  ASSERT_TRUE(empty_page.filter_all_remaining());
+
+  // filter_row of the page filter is called inside a filter list
+  hfilter::Filter *list = NULL;
+  ASSERT_EQ(OB_SUCCESS, parser_.parse_filter(ObString::make_string("PrefixFilter('a') AND PageFilter(2)"), list));
+  ASSERT_TRUE(list->has_filter_row());
+  ASSERT_FALSE(list->filter_all_remaining());
+  ASSERT_FALSE(list->filter_row());
+  list->reset();
+  ASSERT_FALSE(list->filter_row());
+  list->reset();
+  ASSERT_TRUE(list->filter_all_remaining());
+  ASSERT_EQ(OB_SUCCESS, parser_.parse_filter(ObString::make_string("PrefixFilter('a') OR PageFilter(2)"), list));
+  ASSERT_TRUE(list->has_filter_row());
+  ASSERT_EQ(OB_SUCCESS, parser_.parse_filter(ObString::make_string("PrefixFilter('a')"), list));
+  ASSERT_FALSE(list->has_filter_row());
+}
+
+}  // namespace observer
+}  // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  OB_LOGGER.set_file_name("test_hfilter_scan_range.log", true);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,244 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#define private public
+#include "observer/table/ob_table_write_coalescer.h"
+#include "lib/time/ob_time_utility.h"
+#include "share/ob_errno.h"
+
+namespace oceanbase {
+namespace observer {
+using namespace common;
+
+static const int64_t TEST_TABLE_ID = 1099511677777;
+static const int64_t TEST_TIMEOUT_US = 10 * 1000 * 1000;
+static const int64_t TEST_WINDOW_US = 200 * 1000;
+
+class TestTableWriteCoalescer : public ::testing::Test {
+public:
+  virtual void SetUp()
+  {
+    ASSERT_EQ(OB_SUCCESS, coalescer_.init());
+  }
+  virtual void TearDown()
+  {
+    coalescer_.destroy();
+  }
+  static void init_task(const uint64_t partition_id, const int64_t timeout_us, ObTableCoalesceTask &task)
+  {
+    task.table_id_ = TEST_TABLE_ID;
+    task.partition_id_ = partition_id;
+    task.timeout_ts_ = ObTimeUtility::current_time() + timeout_us;
+  }
+  // another partition which falls into the same bucket as %partition_id
+  uint64_t get_conflict_partition(const uint64_t partition_id)
+  {
+    ObTableWriteCoalescer::Bucket *bucket = &coalescer_.get_bucket(TEST_TABLE_ID, partition_id);
+    uint64_t other = partition_id + 1;
+    while (&coalescer_.get_bucket(TEST_TABLE_ID, other) != bucket) {
+      ++other;
+    }
+    return other;
+  }
+  static int64_t group_size(ObTableCoalesceTask *head)
+  {
+    int64_t count = 0;
+    for (ObTableCoalesceTask *task = head; NULL != task; task = task->next_) {
+      ++count;
+    }
+    return count;
+  }
+
+protected:
+  ObTableWriteCoalescer coalescer_;
+};
+
+TEST_F(TestTableWriteCoalescer, lone_leader_closes_at_once)
+{
+  ObTableCoalesceTask leader;
+  init_task(1, TEST_TIMEOUT_US, leader);
+  ASSERT_EQ(ObTableWriteCoalescer::LEADER, coalescer_.join(leader));
+  const int64_t begin_ts = ObTimeUtility::current_time();
+  ObTableCoalesceTask *head = coalescer_.close_group(leader, TEST_WINDOW_US);
+  ASSERT_LT(ObTimeUtility::current_time() - begin_ts, TEST_WINDOW_US);
+  ASSERT_EQ(&leader, head);
+  ASSERT_EQ(1, group_size(head));
+  coalescer_.finish_group(leader);
+  ASSERT_EQ(0, coalescer_.get_bucket(TEST_TABLE_ID, 1).running_group_count_);
+}
+
+TEST_F(TestTableWriteCoalescer, group)
+{
+  const int64_t FOLLOWER_CNT = 3;
+  ObTableCoalesceTask leader;
+  ObTableCoalesceTask followers[FOLLOWER_CNT];
+  ObTableCoalesceTask other;
+  init_task(1, TEST_TIMEOUT_US, leader);
+  init_task(get_conflict_partition(1), TEST_TIMEOUT_US, other);
+  ASSERT_EQ(ObTableWriteCoalescer::LEADER, coalescer_.join(leader));
+  // the bucket is taken by the group of another partition
+  ASSERT_EQ(ObTableWriteCoalescer::ALONE, coalescer_.join(other));
+
+  int rets[FOLLOWER_CNT];
+  std::thread threads[FOLLOWER_CNT];
+  for (int64_t i = 0; i < FOLLOWER_CNT; ++i) {
+    init_task(1, TEST_TIMEOUT_US, followers[i]);
+    ASSERT_EQ(ObTableWriteCoalescer::FOLLOWER, coalescer_.join(followers[i]));
+    threads[i] = std::thread([&, i]() { rets[i] = coalescer_.wait(followers[i]); });
+  }
+  // followers have joined, the leader waits the window for more
+  const int64_t begin_ts = ObTimeUtility::current_time();
+  ObTableCoalesceTask *head = coalescer_.close_group(leader, TEST_WINDOW_US);
+  ASSERT_GE(ObTimeUtility::current_time() - begin_ts, TEST_WINDOW_US);
+  ASSERT_EQ(&leader, head);
+  ASSERT_EQ(FOLLOWER_CNT + 1, group_size(head));
+
+  // the bucket is free for the next group once closed
+  ObTableCoalesceTask next_leader;
+  init_task(1, TEST_TIMEOUT_US, next_leader);
+  ASSERT_EQ(ObTableWriteCoalescer::LEADER, coalescer_.join(next_leader));
+
+  // failure of one task goes to its own requester only
+  followers[1].ret_ = OB_ERR_PRIMARY_KEY_DUPLICATE;
+  coalescer_.finish_group(leader);
+  for (int64_t i = 0; i < FOLLOWER_CNT; ++i) {
+    threads[i].join();
+    ASSERT_TRUE(followers[i].is_done_);
+  }
+  ASSERT_EQ(OB_SUCCESS, rets[0]);
+  ASSERT_EQ(OB_ERR_PRIMARY_KEY_DUPLICATE, rets[1]);
+  ASSERT_EQ(OB_SUCCESS, rets[2]);
+
+  (void)coalescer_.close_group(next_leader, TEST_WINDOW_US);
+  coalescer_.finish_group(next_leader);
+}
+
+TEST_F(TestTableWriteCoalescer, full_group)
+{
+  ObTableCoalesceTask leader;
+  ObTableCoalesceTask followers[ObTableWriteCoalescer::MAX_GROUP_SIZE];
+  init_task(1, TEST_TIMEOUT_US, leader);
+  ASSERT_EQ(ObTableWriteCoalescer::LEADER, coalescer_.join(leader));
+  for (int64_t i = 0; i < ObTableWriteCoalescer::MAX_GROUP_SIZE - 1; ++i) {
+    init_task(1, TEST_TIMEOUT_US, followers[i]);
+    ASSERT_EQ(ObTableWriteCoalescer::FOLLOWER, coalescer_.join(followers[i]));
+  }
+  ObTableCoalesceTask &extra = followers[ObTableWriteCoalescer::MAX_GROUP_SIZE - 1];
+  init_task(1, TEST_TIMEOUT_US, extra);
+  ASSERT_EQ(ObTableWriteCoalescer::ALONE, coalescer_.join(extra));
+  // a full group is closed without waiting the window
+  const int64_t begin_ts = ObTimeUtility::current_time();
+  ObTableCoalesceTask *head = coalescer_.close_group(leader, TEST_TIMEOUT_US);
+  ASSERT_LT(ObTimeUtility::current_time() - begin_ts, TEST_TIMEOUT_US);
+  ASSERT_EQ(ObTableWriteCoalescer::MAX_GROUP_SIZE, group_size(head));
+  coalescer_.finish_group(leader);
+}
+
+TEST_F(TestTableWriteCoalescer, follower_timeout)
+{
+  const int64_t FOLLOWER_TIMEOUT_US = 50 * 1000;
+  ObTableCoalesceTask leader;
+  ObTableCoalesceTask first;
+  ObTableCoalesceTask timeout_task;
+  ObTableCoalesceTask last;
+  init_task(1, TEST_TIMEOUT_US, leader);
+  init_task(1, TEST_TIMEOUT_US, first);
+  init_task(1, FOLLOWER_TIMEOUT_US, timeout_task);
+  init_task(1, TEST_TIMEOUT_US, last);
+  ASSERT_EQ(ObTableWriteCoalescer::LEADER, coalescer_.join(leader));
+  ASSERT_EQ(ObTableWriteCoalescer::FOLLOWER, coalescer_.join(first));
+  ASSERT_EQ(ObTableWriteCoalescer::FOLLOWER, coalescer_.join(timeout_task));
+  ASSERT_EQ(ObTableWriteCoalescer::FOLLOWER, coalescer_.join(last));
+
+  // the group is not closed, the follower leaves it on its own timeout
+  const int64_t begin_ts = ObTimeUtility::current_time();
+  ASSERT_EQ(OB_TIMEOUT, coalescer_.wait(timeout_task));
+  ASSERT_GE(ObTimeUtility::current_time() - begin_ts, FOLLOWER_TIMEOUT_US / 2);
+  ASSERT_FALSE(timeout_task.is_done_);
+
+  ObTableCoalesceTask *head = coalescer_.close_group(leader, 0);
+  ASSERT_EQ(3, group_size(head));
+  ASSERT_EQ(&first, leader.next_);
+  ASSERT_EQ(&last, first.next_);
+  coalescer_.finish_group(leader);
+  ASSERT_EQ(OB_SUCCESS, coalescer_.wait(first));
+  ASSERT_EQ(OB_SUCCESS, coalescer_.wait(last));
+
+  // the tail leaves the group
+  init_task(1, TEST_TIMEOUT_US, leader);
+  init_task(1, 0, timeout_task);
+  ASSERT_EQ(ObTableWriteCoalescer::LEADER, coalescer_.join(leader));
+  ASSERT_EQ(ObTableWriteCoalescer::FOLLOWER, coalescer_.join(timeout_task));
+  ASSERT_EQ(OB_TIMEOUT, coalescer_.wait(timeout_task));
+  init_task(1, TEST_TIMEOUT_US, last);
+  ASSERT_EQ(ObTableWriteCoalescer::FOLLOWER, coalescer_.join(last));
+  head = coalescer_.close_group(leader, 0);
+  ASSERT_EQ(2, group_size(head));
+  ASSERT_EQ(&last, leader.next_);
+  coalescer_.finish_group(leader);
+  ASSERT_EQ(OB_SUCCESS, coalescer_.wait(last));
+}
+
+// a follower of a closed group waits the leader even if it is timeout, the leader uses its timeout
+TEST_F(TestTableWriteCoalescer, follower_timeout_after_close)
+{
+  ObTableCoalesceTask leader;
+  ObTableCoalesceTask follower;
+  int follower_ret = OB_SUCCESS;
+  init_task(1, TEST_TIMEOUT_US, leader);
+  init_task(1, 0, follower);
+  ASSERT_EQ(ObTableWriteCoalescer::LEADER, coalescer_.join(leader));
+  ASSERT_EQ(ObTableWriteCoalescer::FOLLOWER, coalescer_.join(follower));
+  ObTableCoalesceTask *head = coalescer_.close_group(leader, 0);
+  ASSERT_EQ(2, group_size(head));
+  std::thread thread([&]() { follower_ret = coalescer_.wait(follower); });
+  ::usleep(100 * 1000);
+  ASSERT_FALSE(follower.is_done_);
+  // failure of the group transaction goes to every task
+  follower.ret_ = OB_TRANS_TIMEOUT;
+  coalescer_.finish_group(leader);
+  thread.join();
+  ASSERT_EQ(OB_TRANS_TIMEOUT, follower_ret);
+}
+
+// a task handed back because of a lock conflict is not failed by the group
+TEST_F(TestTableWriteCoalescer, hand_back)
+{
+  ObTableCoalesceTask leader;
+  ObTableCoalesceTask follower;
+  init_task(1, TEST_TIMEOUT_US, leader);
+  init_task(1, TEST_TIMEOUT_US, follower);
+  follower.is_handed_back_ = true;
+  ASSERT_EQ(ObTableWriteCoalescer::LEADER, coalescer_.join(leader));
+  ASSERT_EQ(ObTableWriteCoalescer::FOLLOWER, coalescer_.join(follower));
+  // join starts from a task not handed back
+  ASSERT_FALSE(follower.is_handed_back_);
+  ObTableCoalesceTask *head = coalescer_.close_group(leader, 0);
+  ASSERT_EQ(2, group_size(head));
+  follower.is_handed_back_ = true;
+  coalescer_.finish_group(leader);
+  ASSERT_EQ(OB_SUCCESS, coalescer_.wait(follower));
+  ASSERT_TRUE(follower.is_handed_back_);
+  ASSERT_TRUE(follower.is_done_);
+}
+
+}  // namespace observer
+}  // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,422 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFEX SHARE
+#include <gtest/gtest.h>
+#include <thread>
+#include "share/ob_define.h"
+#include "lib/hash_func/murmur_hash.h"
+#define private public
+#include "share/cache/ob_kv_storecache.h"
+#undef private
+#include "share/cache/ob_kvcache_struct.h"
+#include "share/cache/ob_kvcache_inst_map.h"
+#include "share/ob_tenant_mgr.h"
+
+namespace oceanbase {
+using namespace common;
+namespace share {
+static uint64_t key_hash(const int64_t key)
+{
+  return murmurhash(&key, sizeof(key), 0);
+}
+
+TEST(TestKVCacheFreqSketch, record_and_estimate)
+{
+  ObKVCacheFreqSketch sketch;
+  ASSERT_FALSE(sketch.is_inited());
+  ASSERT_EQ(0, sketch.estimate(key_hash(1)));
+  // recording without table is ignored
+  sketch.record(key_hash(1));
+  ASSERT_EQ(OB_SUCCESS, sketch.init(OB_SYS_TENANT_ID));
+  ASSERT_EQ(OB_INIT_TWICE, sketch.init(OB_SYS_TENANT_ID));
+
+  ASSERT_EQ(0, sketch.estimate(key_hash(1)));
+  for (int64_t i = 0; i < 5; ++i) {
+    sketch.record(key_hash(1));
+  }
+  ASSERT_EQ(5, sketch.estimate(key_hash(1)));
+  for (int64_t i = 0; i < 100; ++i) {
+    sketch.record(key_hash(1));
+  }
+  ASSERT_EQ(ObKVCacheFreqSketch::MAX_FREQ, sketch.estimate(key_hash(1)));
+
+  // keys seen once by a scan are hardly estimated as hot
+  const int64_t scan_cnt = ObKVCacheFreqSketch::MIN_COUNTER_CNT / ObKVCacheFreqSketch::COUNTER_PER_KV;
+  for (int64_t i = 100; i < 100 + scan_cnt; ++i) {
+    sketch.record(key_hash(i));
+  }
+  int64_t hot_cnt = 0;
+  for (int64_t i = 100; i < 100 + scan_cnt; ++i) {
+    hot_cnt += sketch.estimate(key_hash(i)) > 1 ? 1 : 0;
+  }
+  ASSERT_LT(hot_cnt, scan_cnt / 100);
+  // never seen keys
+  int64_t seen_cnt = 0;
+  for (int64_t i = 20000; i < 30000; ++i) {
+    seen_cnt += sketch.estimate(key_hash(i)) >= ObKVCacheInst::MIN_ADMIT_FREQ ? 1 : 0;
+  }
+  ASSERT_LT(seen_cnt, 100);
+  sketch.destroy();
+  ASSERT_FALSE(sketch.is_inited());
+}
+
+TEST(TestKVCacheFreqSketch, age)
+{
+  ObKVCacheFreqSketch sketch;
+  ASSERT_EQ(OB_SUCCESS, sketch.init(OB_SYS_TENANT_ID));
+  for (int64_t i = 0; i < 12; ++i) {
+    sketch.record(key_hash(1));
+  }
+  ASSERT_EQ(12, sketch.estimate(key_hash(1)));
+  int64_t key = 2;
+  while (0 == sketch.get_age_cnt()) {
+    sketch.record(key_hash(key++));
+  }
+  ASSERT_EQ(6, sketch.estimate(key_hash(1)));
+}
+
+TEST(TestKVCacheFreqSketch, expand)
+{
+  ObKVCacheFreqSketch sketch;
+  ASSERT_EQ(OB_NOT_INIT, sketch.try_expand(100));
+  ASSERT_EQ(OB_SUCCESS, sketch.init(OB_SYS_TENANT_ID));
+  ASSERT_EQ(ObKVCacheFreqSketch::MIN_COUNTER_CNT, sketch.get_counter_cnt());
+  for (int64_t i = 0; i < 100; ++i) {
+    for (int64_t j = 0; j <= i % 10; ++j) {
+      sketch.record(key_hash(i));
+    }
+  }
+  ASSERT_EQ(OB_SUCCESS, sketch.try_expand(100));
+  ASSERT_EQ(ObKVCacheFreqSketch::MIN_COUNTER_CNT, sketch.get_counter_cnt());
+  ASSERT_EQ(OB_SUCCESS, sketch.try_expand(ObKVCacheFreqSketch::MIN_COUNTER_CNT));
+  ASSERT_EQ(ObKVCacheFreqSketch::MIN_COUNTER_CNT * ObKVCacheFreqSketch::COUNTER_PER_KV, sketch.get_counter_cnt());
+  // counters are kept after expanding
+  for (int64_t i = 0; i < 100; ++i) {
+    ASSERT_LE(static_cast<uint64_t>(i % 10 + 1), sketch.estimate(key_hash(i)));
+  }
+  ASSERT_EQ(OB_SUCCESS, sketch.try_expand(INT32_MAX));
+  ASSERT_EQ(ObKVCacheFreqSketch::MAX_COUNTER_CNT, sketch.get_counter_cnt());
+  sketch.destroy();
+  // free the tables retired by expansion
+  ObKVCacheFreqSketch::purge_tables();
+}
+
+TEST(TestKVCacheFreqSketch, admit)
+{
+  ObKVCacheInst inst;
+  ASSERT_EQ(OB_SUCCESS, inst.freq_sketch_.init(OB_SYS_TENANT_ID));
+  // admit everything if the cache has memory
+  ASSERT_TRUE(inst.admit(key_hash(1)));
+  ASSERT_TRUE(inst.admit(key_hash(2)));
+  inst.reject_permille_ = ObKVCacheInst::PERMILLE;
+  // the whole cache has to be washed, the first sight is rejected and the second one is admitted
+  ASSERT_FALSE(inst.admit(key_hash(3)));
+  ASSERT_TRUE(inst.admit(key_hash(3)));
+  ASSERT_TRUE(inst.admit(key_hash(1)));
+  ASSERT_EQ(4, inst.status_.total_admit_cnt_.value());
+  ASSERT_EQ(1, inst.status_.total_reject_cnt_.value());
+  inst.reset();
+  ASSERT_FALSE(inst.freq_sketch_.is_inited());
+  ASSERT_EQ(0, inst.reject_permille_);
+}
+
+TEST(TestKVCacheFreqSketch, admit_ratio)
+{
+  const int64_t key_cnt = 2000;
+  int64_t admit_cnt = 0;
+  ObKVCacheInst inst;
+  ASSERT_EQ(OB_SUCCESS, inst.freq_sketch_.init(OB_SYS_TENANT_ID));
+  // a small wash size only rejects a small share of new keys, plain integer hashes included
+  inst.reject_permille_ = 100;
+  for (int64_t i = 0; i < key_cnt; ++i) {
+    admit_cnt += inst.admit(i) ? 1 : 0;
+  }
+  ASSERT_GT(admit_cnt, key_cnt * 85 / 100);
+  ASSERT_LT(admit_cnt, key_cnt * 95 / 100);
+  // keys seen before are always admitted
+  for (int64_t i = 0; i < key_cnt; ++i) {
+    ASSERT_TRUE(inst.admit(i));
+  }
+  ASSERT_EQ(inst.status_.total_admit_cnt_.value() + inst.status_.total_reject_cnt_.value(), 2 * key_cnt);
+  inst.reset();
+
+  ObKVCacheInst half_inst;
+  ASSERT_EQ(OB_SUCCESS, half_inst.freq_sketch_.init(OB_SYS_TENANT_ID));
+  half_inst.reject_permille_ = 500;
+  admit_cnt = 0;
+  for (int64_t i = 0; i < key_cnt; ++i) {
+    admit_cnt += half_inst.admit(key_hash(i)) ? 1 : 0;
+  }
+  ASSERT_GT(admit_cnt, key_cnt * 45 / 100);
+  ASSERT_LT(admit_cnt, key_cnt * 55 / 100);
+  half_inst.reset();
+}
+
+TEST(TestKVCacheFreqSketch, concurrent_expand)
+{
+  static const int64_t THREAD_CNT = 4;
+  static const int64_t KEY_CNT = 10000;
+  ObKVCacheFreqSketch sketch;
+  ASSERT_EQ(OB_SUCCESS, sketch.init(OB_SYS_TENANT_ID));
+  bool stop = false;
+  int64_t pass_cnts[THREAD_CNT] = {0};
+  std::thread threads[THREAD_CNT];
+  for (int64_t t = 0; t < THREAD_CNT; ++t) {
+    threads[t] = std::thread([&sketch, &stop, &pass_cnts, t]() {
+      while (!ATOMIC_LOAD(&stop)) {
+        for (int64_t i = t * KEY_CNT; i < (t + 1) * KEY_CNT; ++i) {
+          QClockGuard guard(get_kvcache_qclock());
+          sketch.record(key_hash(i));
+          (void)sketch.estimate(key_hash(i));
+        }
+        ATOMIC_INC(&pass_cnts[t]);
+      }
+    });
+  }
+  // the wash thread grows the table and retires the old one while readers are in it
+  for (int64_t kv_cnt = 1024; kv_cnt <= ObKVCacheFreqSketch::MAX_COUNTER_CNT; kv_cnt *= 2) {
+    EXPECT_EQ(OB_SUCCESS, sketch.try_expand(kv_cnt));
+    usleep(1000);
+  }
+  // let every thread record all of its keys in the last table
+  for (int64_t t = 0; t < THREAD_CNT; ++t) {
+    const int64_t pass_cnt = ATOMIC_LOAD(&pass_cnts[t]);
+    while (ATOMIC_LOAD(&pass_cnts[t]) < pass_cnt + 2) {
+      usleep(1000);
+    }
+  }
+  ATOMIC_STORE(&stop, true);
+  for (int64_t t = 0; t < THREAD_CNT; ++t) {
+    threads[t].join();
+  }
+  ASSERT_EQ(ObKVCacheFreqSketch::MAX_COUNTER_CNT, sketch.get_counter_cnt());
+  for (int64_t i = 0; i < THREAD_CNT * KEY_CNT; ++i) {
+    ASSERT_LE(ObKVCacheInst::MIN_ADMIT_FREQ, sketch.estimate(key_hash(i)));
+  }
+  sketch.destroy();
+  ObKVCacheFreqSketch::purge_tables();
+}
+
+struct TestAdmitKey : public ObIKVCacheKey {
+  TestAdmitKey() : v_(0), tenant_id_(0)
+  {}
+  TestAdmitKey(const uint64_t v, const uint64_t tenant_id) : v_(v), tenant_id_(tenant_id)
+  {}
+  virtual bool operator==(const ObIKVCacheKey& other) const
+  {
+    const TestAdmitKey& other_key = reinterpret_cast<const TestAdmitKey&>(other);
+    return v_ == other_key.v_ && tenant_id_ == other_key.tenant_id_;
+  }
+  virtual uint64_t get_tenant_id() const
+  {
+    return tenant_id_;
+  }
+  virtual uint64_t hash() const
+  {
+    return v_;
+  }
+  virtual int64_t size() const
+  {
+    return sizeof(*this);
+  }
+  virtual int deep_copy(char* buf, const int64_t buf_len, ObIKVCacheKey*& key) const
+  {
+    int ret = OB_SUCCESS;
+    if (NULL == buf || buf_len < size()) {
+      ret = OB_INVALID_ARGUMENT;
+    } else {
+      key = new (buf) TestAdmitKey(v_, tenant_id_);
+    }
+    return ret;
+  }
+  uint64_t v_;
+  uint64_t tenant_id_;
+};
+
+struct TestAdmitValue : public ObIKVCacheValue {
+  TestAdmitValue() : v_(0)
+  {}
+  explicit TestAdmitValue(const uint64_t v) : v_(v)
+  {}
+  virtual int64_t size() const
+  {
+    return sizeof(*this);
+  }
+  virtual int deep_copy(char* buf, const int64_t buf_len, ObIKVCacheValue*& value) const
+  {
+    int ret = OB_SUCCESS;
+    if (NULL == buf || buf_len < size()) {
+      ret = OB_INVALID_ARGUMENT;
+    } else {
+      value = new (buf) TestAdmitValue(v_);
+    }
+    return ret;
+  }
+  uint64_t v_;
+};
+
+class TestKVCacheAdmission : public ::testing::Test {
+public:
+  typedef ObKVCache<TestAdmitKey, TestAdmitValue> TestCache;
+  static const uint64_t TENANT_ID = 1234;
+  TestKVCacheAdmission()
+  {}
+  virtual void SetUp()
+  {
+    ASSERT_EQ(OB_SUCCESS, ObTenantManager::get_instance().init(100000));
+    ASSERT_EQ(OB_SUCCESS, ObTenantManager::get_instance().add_tenant(TENANT_ID));
+    ASSERT_EQ(
+        OB_SUCCESS, ObTenantManager::get_instance().set_tenant_mem_limit(TENANT_ID, 64L << 20, 128L << 20));
+    // keep the wash thread away, the tests set the reject ratio and expand the sketch by themselves
+    ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().init(1024, 1L << 30, lib::ACHUNK_SIZE, 3600L * 1000 * 1000));
+    CHUNK_MGR.set_limit(5L * 1024L * 1024L * 1024L);
+    ASSERT_EQ(OB_SUCCESS, cache_.init("test_admit"));
+  }
+  virtual void TearDown()
+  {
+    inst_handle_.reset();
+    cache_.destroy();
+    ObKVGlobalCache::get_instance().destroy();
+    ObTenantManager::get_instance().destroy();
+  }
+
+protected:
+  void get_inst()
+  {
+    // the instance is created by the first put of the tenant
+    ASSERT_EQ(OB_SUCCESS, cache_.put(TestAdmitKey(UINT64_MAX, TENANT_ID), TestAdmitValue(0)));
+    ObKVCacheInstKey inst_key(cache_.cache_id_, TENANT_ID);
+    ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().insts_.get_cache_inst(inst_key, inst_handle_));
+    ASSERT_TRUE(NULL != inst_handle_.get_inst());
+  }
+  int check(const uint64_t v, bool& exist)
+  {
+    int ret = OB_SUCCESS;
+    const TestAdmitValue* pvalue = NULL;
+    ObKVCacheHandle handle;
+    exist = false;
+    if (OB_FAIL(cache_.get(TestAdmitKey(v, TENANT_ID), pvalue, handle))) {
+      if (OB_ENTRY_NOT_EXIST == ret) {
+        ret = OB_SUCCESS;
+      }
+    } else if (pvalue->v_ != v) {
+      ret = OB_ERR_UNEXPECTED;
+    } else {
+      exist = true;
+    }
+    return ret;
+  }
+
+  TestCache cache_;
+  ObKVCacheInstHandle inst_handle_;
+};
+
+TEST_F(TestKVCacheAdmission, put_and_get)
+{
+  get_inst();
+  ASSERT_FALSE(HasFatalFailure());
+  ObKVCacheInst& inst = *inst_handle_.get_inst();
+  bool exist = false;
+
+  // no wash pressure
+  ASSERT_EQ(OB_SUCCESS, cache_.put(TestAdmitKey(1, TENANT_ID), TestAdmitValue(1)));
+  ASSERT_EQ(OB_SUCCESS, check(1, exist));
+  ASSERT_TRUE(exist);
+
+  // the whole cache has to be washed, a new key gets in on its second put
+  ATOMIC_STORE(&inst.reject_permille_, ObKVCacheInst::PERMILLE);
+  ASSERT_EQ(OB_SUCCESS, cache_.put(TestAdmitKey(2, TENANT_ID), TestAdmitValue(2)));
+  ASSERT_EQ(OB_SUCCESS, check(2, exist));
+  ASSERT_FALSE(exist);
+  ASSERT_EQ(OB_SUCCESS, cache_.put(TestAdmitKey(2, TENANT_ID), TestAdmitValue(2)));
+  ASSERT_EQ(OB_SUCCESS, check(2, exist));
+  ASSERT_TRUE(exist);
+  // keys in the map are overwritten without admission
+  ASSERT_EQ(OB_SUCCESS, cache_.put(TestAdmitKey(1, TENANT_ID), TestAdmitValue(1)));
+  ASSERT_EQ(OB_SUCCESS, check(1, exist));
+  ASSERT_TRUE(exist);
+
+  // only a share of new keys is rejected when a small part of the cache has to be washed
+  ATOMIC_STORE(&inst.reject_permille_, 100L);
+  int64_t exist_cnt = 0;
+  for (uint64_t v = 100; v < 1100; ++v) {
+    ASSERT_EQ(OB_SUCCESS, cache_.put(TestAdmitKey(v, TENANT_ID), TestAdmitValue(v)));
+    ASSERT_EQ(OB_SUCCESS, check(v, exist));
+    exist_cnt += exist ? 1 : 0;
+  }
+  ASSERT_GT(exist_cnt, 850);
+  ASSERT_LT(exist_cnt, 950);
+}
+
+TEST_F(TestKVCacheAdmission, concurrent_put_and_get)
+{
+  static const int64_t THREAD_CNT = 4;
+  static const uint64_t KEY_CNT = 5000;
+  get_inst();
+  ASSERT_FALSE(HasFatalFailure());
+  ObKVCacheInst& inst = *inst_handle_.get_inst();
+  ATOMIC_STORE(&inst.reject_permille_, 500L);
+
+  bool stop = false;
+  int64_t fail_cnt = 0;
+  int64_t missing_cnt = 0;
+  std::thread threads[THREAD_CNT];
+  for (int64_t t = 0; t < THREAD_CNT; ++t) {
+    threads[t] = std::thread([&, t]() {
+      bool exist = false;
+      // writers put their own keys until they are admitted and read the keys of others
+      for (uint64_t v = t * KEY_CNT; v < (t + 1) * KEY_CNT; ++v) {
+        exist = false;
+        for (int64_t i = 0; i < 10 && !exist; ++i) {
+          if (OB_SUCCESS != cache_.put(TestAdmitKey(v, TENANT_ID), TestAdmitValue(v)) ||
+              OB_SUCCESS != check(v, exist)) {
+            ATOMIC_INC(&fail_cnt);
+          }
+        }
+        if (!exist) {
+          ATOMIC_INC(&missing_cnt);
+        }
+        if (OB_SUCCESS != check((v + KEY_CNT) % (THREAD_CNT * KEY_CNT), exist)) {
+          ATOMIC_INC(&fail_cnt);
+        }
+      }
+    });
+  }
+  // the sketch is grown and the old tables are retired while the writers admit keys
+  for (int64_t kv_cnt = 1024; !ATOMIC_LOAD(&stop); kv_cnt *= 2) {
+    EXPECT_EQ(OB_SUCCESS, inst.freq_sketch_.try_expand(kv_cnt));
+    stop = kv_cnt >= THREAD_CNT * static_cast<int64_t>(KEY_CNT);
+    usleep(1000);
+  }
+  for (int64_t t = 0; t < THREAD_CNT; ++t) {
+    threads[t].join();
+  }
+  ASSERT_EQ(0, fail_cnt);
+  ASSERT_EQ(0, missing_cnt);
+  ASSERT_LT(0, inst.status_.total_reject_cnt_.value());
+  bool exist = false;
+  for (uint64_t v = 0; v < THREAD_CNT * KEY_CNT; ++v) {
+    ASSERT_EQ(OB_SUCCESS, check(v, exist));
+    ASSERT_TRUE(exist);
+  }
+}
+
+}  // end namespace share
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,355 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_se_array.h"
+#include "share/ob_errno.h"
+#define private public
+#include "sql/dtl/ob_dtl_vectors.h"
+#include "sql/dtl/ob_dtl_basic_channel.h"
+#include "sql/dtl/ob_dtl_linked_buffer.h"
+#include "sql/engine/px/ob_px_row_store.h"
+#include "sql/engine/expr/ob_expr.h"
+#include "sql/engine/ob_exec_context.h"
+
+namespace oceanbase {
+using namespace common;
+namespace sql {
+using namespace dtl;
+
+/*
+ * Columns of test rows, %id is the row id:
+ *   0: int id
+ *   1: always null
+ *   2: string of id % 7 bytes, empty string included
+ *   3: null for odd id, int id * 10 otherwise
+ *   4: always empty string
+ */
+class TestDtlVectors : public ::testing::Test {
+public:
+  static const int64_t COL_CNT = 5;
+  static const int64_t MAX_ROWS = ObDtlVectorsBuilder::MAX_BATCH_ROWS;
+  static const int64_t MAX_BUFFER_CNT = 128;
+
+  TestDtlVectors() : eval_ctx_(exec_ctx_, eval_res_, eval_tmp_)
+  {}
+  virtual void SetUp()
+  {
+    MEMSET(str_buf_, 'a', sizeof(str_buf_));
+    const int64_t expr_size = MAX_ROWS * sizeof(ObDatum) + sizeof(ObEvalInfo) + sizeof(int64_t);
+    eval_ctx_.frames_ = static_cast<char**>(alloc_.alloc(sizeof(char*)));
+    ASSERT_TRUE(NULL != eval_ctx_.frames_);
+    eval_ctx_.frames_[0] = static_cast<char*>(alloc_.alloc(2 * COL_CNT * expr_size));
+    ASSERT_TRUE(NULL != eval_ctx_.frames_[0]);
+    MEMSET(eval_ctx_.frames_[0], 0, 2 * COL_CNT * expr_size);
+    int64_t pos = 0;
+    for (int64_t i = 0; i < 2 * COL_CNT; ++i) {
+      ObExpr* expr = new (alloc_.alloc(sizeof(ObExpr))) ObExpr();
+      expr->frame_idx_ = 0;
+      expr->datum_off_ = static_cast<uint32_t>(pos);
+      expr->eval_info_off_ = static_cast<uint32_t>(pos + MAX_ROWS * sizeof(ObDatum));
+      expr->res_buf_off_ = static_cast<uint32_t>(expr->eval_info_off_ + sizeof(ObEvalInfo));
+      pos += expr_size;
+      if (i < COL_CNT) {
+        ASSERT_EQ(OB_SUCCESS, exprs_.push_back(expr));
+      } else {
+        // read in batch
+        expr->batch_idx_mask_ = UINT64_MAX;
+        ASSERT_EQ(OB_SUCCESS, batch_exprs_.push_back(expr));
+      }
+    }
+  }
+  virtual void TearDown()
+  {
+    alloc_.reset();
+  }
+  void gen_row(const int64_t id)
+  {
+    for (int64_t i = 0; i < COL_CNT; ++i) {
+      ObExpr* expr = exprs_.at(i);
+      ObDatum& datum = expr->locate_expr_datum(eval_ctx_);
+      datum.ptr_ = eval_ctx_.frames_[0] + expr->res_buf_off_;
+      expr->get_eval_info(eval_ctx_).evaluated_ = true;
+    }
+    exprs_.at(0)->locate_expr_datum(eval_ctx_).set_int(id);
+    exprs_.at(1)->locate_expr_datum(eval_ctx_).set_null();
+    exprs_.at(2)->locate_expr_datum(eval_ctx_).set_string(str_buf_, static_cast<int32_t>(id % 7));
+    if (id % 2) {
+      exprs_.at(3)->locate_expr_datum(eval_ctx_).set_null();
+    } else {
+      exprs_.at(3)->locate_expr_datum(eval_ctx_).set_int(id * 10);
+    }
+    exprs_.at(4)->locate_expr_datum(eval_ctx_).set_string(str_buf_, 0);
+  }
+  void verify_row(const int64_t batch_idx, const int64_t id)
+  {
+    const ObDatum& c0 = batch_exprs_.at(0)->locate_expr_datum(eval_ctx_, batch_idx);
+    const ObDatum& c1 = batch_exprs_.at(1)->locate_expr_datum(eval_ctx_, batch_idx);
+    const ObDatum& c2 = batch_exprs_.at(2)->locate_expr_datum(eval_ctx_, batch_idx);
+    const ObDatum& c3 = batch_exprs_.at(3)->locate_expr_datum(eval_ctx_, batch_idx);
+    const ObDatum& c4 = batch_exprs_.at(4)->locate_expr_datum(eval_ctx_, batch_idx);
+    ASSERT_FALSE(c0.is_null());
+    ASSERT_EQ(id, c0.get_int());
+    ASSERT_TRUE(c1.is_null());
+    ASSERT_FALSE(c2.is_null());
+    ASSERT_EQ(id % 7, static_cast<int64_t>(c2.len_));
+    ASSERT_EQ(0, MEMCMP(str_buf_, c2.ptr_, c2.len_));
+    if (id % 2) {
+      ASSERT_TRUE(c3.is_null());
+    } else {
+      ASSERT_FALSE(c3.is_null());
+      ASSERT_EQ(id * 10, c3.get_int());
+    }
+    ASSERT_FALSE(c4.is_null());
+    ASSERT_EQ(0, static_cast<int64_t>(c4.len_));
+  }
+  // write a row or eof (%id < 0) as the channel does, switch to next buffer if needed
+  void write(const int64_t id, ObDtlVectorsMsgWriter& writer, ObDtlLinkedBuffer* buffers, int64_t& buffer_cnt)
+  {
+    ObPxNewRow row_msg(exprs_);
+    ObPxNewRow eof_msg;
+    const ObPxNewRow& msg = id < 0 ? eof_msg : row_msg;
+    const bool is_eof = id < 0;
+    int ret = OB_SUCCESS;
+    if (!is_eof) {
+      gen_row(id);
+    }
+    for (int64_t i = 0; i < 2; ++i) {
+      int64_t need_size = 0;
+      bool need_new = false;
+      ASSERT_EQ(OB_SUCCESS, writer.need_new_buffer(msg, &eval_ctx_, need_size, need_new));
+      if (need_new) {
+        ASSERT_LT(buffer_cnt, MAX_BUFFER_CNT);
+        ASSERT_LE(need_size, buffers[buffer_cnt].size());
+        ASSERT_EQ(OB_SUCCESS, writer.init(&buffers[buffer_cnt++], OB_SERVER_TENANT_ID));
+      }
+      ret = writer.write(msg, &eval_ctx_, is_eof);
+      if (OB_BUF_NOT_ENOUGH != ret) {
+        break;
+      }
+    }
+    ASSERT_EQ(OB_SUCCESS, ret);
+  }
+  void init_buffers(const int64_t size, ObDtlLinkedBuffer* buffers)
+  {
+    for (int64_t i = 0; i < MAX_BUFFER_CNT; ++i) {
+      new (&buffers[i]) ObDtlLinkedBuffer(static_cast<char*>(alloc_.alloc(size)), size);
+    }
+  }
+
+protected:
+  char str_buf_[16];
+  ObSEArray<ObExpr*, COL_CNT> exprs_;
+  ObSEArray<ObExpr*, COL_CNT> batch_exprs_;
+  ObArenaAllocator alloc_;
+  ObExecContext exec_ctx_;
+  ObArenaAllocator eval_res_;
+  ObArenaAllocator eval_tmp_;
+  ObEvalCtx eval_ctx_;
+};
+const int64_t TestDtlVectors::COL_CNT;
+const int64_t TestDtlVectors::MAX_ROWS;
+const int64_t TestDtlVectors::MAX_BUFFER_CNT;
+
+TEST_F(TestDtlVectors, encode_decode)
+{
+  const int64_t row_cnt = 100;
+  const int64_t buf_size = 64L << 10;
+  char* buf = static_cast<char*>(alloc_.alloc(buf_size));
+  ObDtlVectorsBuilder builder;
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, builder.encode(buf, buf_size, pos));
+  ASSERT_EQ(0, pos);
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    gen_row(i);
+    ASSERT_EQ(OB_SUCCESS, builder.add_row(exprs_, eval_ctx_, buf_size));
+  }
+  ASSERT_EQ(row_cnt, builder.get_row_cnt());
+  const int64_t encoded_size = builder.encoded_size();
+  ASSERT_EQ(OB_SUCCESS, builder.encode(buf, buf_size, pos));
+  ASSERT_LE(pos, encoded_size);
+  ASSERT_EQ(0, pos % ObDtlVectors::ALIGN_SIZE);
+  ASSERT_TRUE(builder.is_empty());
+
+  const ObDtlVectors* vectors = reinterpret_cast<const ObDtlVectors*>(buf);
+  ASSERT_EQ(pos, vectors->size_);
+  ASSERT_EQ(row_cnt, vectors->row_cnt_);
+  ASSERT_EQ(COL_CNT, vectors->col_cnt_);
+  ASSERT_EQ(static_cast<int32_t>(sizeof(int64_t)), vectors->columns()[0].fixed_len_);
+  // null values do not count
+  ASSERT_EQ(0, vectors->columns()[1].fixed_len_);
+  ASSERT_EQ(static_cast<int32_t>(ObDtlVectors::VAR_LEN), vectors->columns()[2].fixed_len_);
+  ASSERT_EQ(static_cast<int32_t>(sizeof(int64_t)), vectors->columns()[3].fixed_len_);
+  ASSERT_EQ(0, vectors->columns()[4].fixed_len_);
+
+  for (int64_t i = 0; i < COL_CNT; ++i) {
+    vectors->get_datums(i, batch_exprs_.at(i)->locate_batch_datums(eval_ctx_));
+  }
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    ASSERT_NO_FATAL_FAILURE(verify_row(i, i));
+  }
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    for (int64_t j = 0; j < COL_CNT; ++j) {
+      vectors->get_datum(j, i, batch_exprs_.at(j)->locate_expr_datum(eval_ctx_, 0));
+    }
+    ASSERT_NO_FATAL_FAILURE(verify_row(0, i));
+  }
+
+  // buffer of encode is not enough
+  gen_row(0);
+  ASSERT_EQ(OB_SUCCESS, builder.add_row(exprs_, eval_ctx_, buf_size));
+  pos = 0;
+  ASSERT_EQ(OB_BUF_NOT_ENOUGH, builder.encode(buf, builder.encoded_size() - 1, pos));
+  ASSERT_EQ(0, pos);
+  ASSERT_EQ(1, builder.get_row_cnt());
+}
+
+TEST_F(TestDtlVectors, add_row_buf_not_enough)
+{
+  const int64_t buf_size = 64L << 10;
+  char* buf = static_cast<char*>(alloc_.alloc(buf_size));
+  ObDtlVectorsBuilder builder;
+  int64_t pos = 0;
+  int64_t row_size = 0;
+  gen_row(6);
+  ASSERT_EQ(OB_SUCCESS, ObDtlVectorsBuilder::row_encoded_size(exprs_, eval_ctx_, row_size));
+  ASSERT_EQ(OB_BUF_NOT_ENOUGH, builder.add_row(exprs_, eval_ctx_, row_size - 1));
+  ASSERT_TRUE(builder.is_empty());
+  ASSERT_EQ(OB_SUCCESS, builder.add_row(exprs_, eval_ctx_, row_size));
+  ASSERT_EQ(row_size, builder.encoded_size());
+
+  // the rejected row leaves the staged rows unchanged
+  gen_row(5);
+  ASSERT_EQ(OB_BUF_NOT_ENOUGH, builder.add_row(exprs_, eval_ctx_, builder.encoded_size()));
+  ASSERT_EQ(1, builder.get_row_cnt());
+  ASSERT_EQ(row_size, builder.encoded_size());
+  ASSERT_EQ(OB_SUCCESS, builder.encode(buf, buf_size, pos));
+  const ObDtlVectors* vectors = reinterpret_cast<const ObDtlVectors*>(buf);
+  ASSERT_EQ(1, vectors->row_cnt_);
+  for (int64_t i = 0; i < COL_CNT; ++i) {
+    vectors->get_datums(i, batch_exprs_.at(i)->locate_batch_datums(eval_ctx_));
+  }
+  ASSERT_NO_FATAL_FAILURE(verify_row(0, 6));
+
+  // batch is full
+  for (int64_t i = 0; i < MAX_ROWS; ++i) {
+    gen_row(i);
+    ASSERT_EQ(OB_SUCCESS, builder.add_row(exprs_, eval_ctx_, buf_size));
+  }
+  ASSERT_TRUE(builder.is_full());
+  ASSERT_EQ(OB_ERR_UNEXPECTED, builder.add_row(exprs_, eval_ctx_, buf_size));
+}
+
+TEST_F(TestDtlVectors, iterate)
+{
+  const int64_t row_cnt = 2 * MAX_ROWS + 88;
+  ObDtlLinkedBuffer* buffers =
+      static_cast<ObDtlLinkedBuffer*>(alloc_.alloc(sizeof(ObDtlLinkedBuffer) * MAX_BUFFER_CNT));
+  int64_t buffer_cnt = 0;
+  ObDtlVectorsMsgWriter writer;
+  init_buffers(1L << 20, buffers);
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    ASSERT_NO_FATAL_FAILURE(write(i, writer, buffers, buffer_cnt));
+  }
+  ASSERT_NO_FATAL_FAILURE(write(-1, writer, buffers, buffer_cnt));
+  ASSERT_EQ(1, buffer_cnt);
+  ASSERT_TRUE(buffers[0].is_eof());
+  const ObDtlVectorsBlock* block = reinterpret_cast<const ObDtlVectorsBlock*>(buffers[0].buf());
+  ASSERT_EQ(row_cnt, block->row_cnt_);
+  ASSERT_EQ(3, block->batch_cnt_);
+
+  ObPxVectorsIterator iter;
+  int64_t read_rows = 0;
+  int64_t id = 0;
+  ASSERT_EQ(OB_SUCCESS, iter.load_buffer(buffers[0]));
+  // row by row cross the first batch
+  for (; id < MAX_ROWS + 44; ++id) {
+    ASSERT_EQ(OB_SUCCESS, iter.get_next_row(batch_exprs_, eval_ctx_));
+    ASSERT_NO_FATAL_FAILURE(verify_row(0, id));
+  }
+  // rest of the second batch is read row by row
+  ASSERT_EQ(OB_SUCCESS, iter.get_next_batch(batch_exprs_, eval_ctx_, 10, read_rows));
+  ASSERT_EQ(10, read_rows);
+  for (int64_t i = 0; i < read_rows; ++i, ++id) {
+    ASSERT_NO_FATAL_FAILURE(verify_row(i, id));
+  }
+  ASSERT_EQ(OB_SUCCESS, iter.get_next_batch(batch_exprs_, eval_ctx_, row_cnt, read_rows));
+  ASSERT_EQ(MAX_ROWS - 54, read_rows);
+  for (int64_t i = 0; i < read_rows; ++i, ++id) {
+    ASSERT_NO_FATAL_FAILURE(verify_row(i, id));
+  }
+  // the last batch is assigned column by column
+  ASSERT_EQ(OB_SUCCESS, iter.get_next_batch(batch_exprs_, eval_ctx_, row_cnt, read_rows));
+  ASSERT_EQ(88, read_rows);
+  for (int64_t i = 0; i < read_rows; ++i, ++id) {
+    ASSERT_NO_FATAL_FAILURE(verify_row(i, id));
+  }
+  ASSERT_EQ(row_cnt, id);
+  ASSERT_EQ(OB_ITER_END, iter.get_next_batch(batch_exprs_, eval_ctx_, row_cnt, read_rows));
+  ASSERT_EQ(0, read_rows);
+
+  // buffer with eof only
+  ObDtlVectorsMsgWriter eof_writer;
+  buffer_cnt = 1;
+  ASSERT_NO_FATAL_FAILURE(write(-1, eof_writer, buffers, buffer_cnt));
+  ASSERT_EQ(2, buffer_cnt);
+  ASSERT_EQ(OB_SUCCESS, iter.load_buffer(buffers[1]));
+  ASSERT_FALSE(iter.has_next());
+  ASSERT_EQ(OB_ITER_END, iter.get_next_row(batch_exprs_, eval_ctx_));
+}
+
+// rows rejected by a full buffer go to the next one
+TEST_F(TestDtlVectors, split_buffer)
+{
+  const int64_t row_cnt = 1000;
+  ObDtlLinkedBuffer* buffers =
+      static_cast<ObDtlLinkedBuffer*>(alloc_.alloc(sizeof(ObDtlLinkedBuffer) * MAX_BUFFER_CNT));
+  int64_t buffer_cnt = 0;
+  ObDtlVectorsMsgWriter writer;
+  init_buffers(4L << 10, buffers);
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    ASSERT_NO_FATAL_FAILURE(write(i, writer, buffers, buffer_cnt));
+  }
+  ASSERT_NO_FATAL_FAILURE(write(-1, writer, buffers, buffer_cnt));
+  ASSERT_GT(buffer_cnt, 1);
+
+  ObPxVectorsIterator iter;
+  int64_t id = 0;
+  for (int64_t i = 0; i < buffer_cnt; ++i) {
+    const ObDtlVectorsBlock* block = reinterpret_cast<const ObDtlVectorsBlock*>(buffers[i].buf());
+    ASSERT_EQ(i == buffer_cnt - 1, buffers[i].is_eof());
+    ASSERT_LE(buffers[i].pos(), buffers[i].size());
+    ASSERT_GT(block->row_cnt_, 0);
+    ASSERT_EQ(OB_SUCCESS, iter.load_buffer(buffers[i]));
+    int64_t read_rows = 0;
+    int ret = OB_SUCCESS;
+    while (OB_SUCC(iter.get_next_batch(batch_exprs_, eval_ctx_, MAX_ROWS, read_rows))) {
+      for (int64_t j = 0; j < read_rows; ++j, ++id) {
+        ASSERT_NO_FATAL_FAILURE(verify_row(j, id));
+      }
+    }
+    // iterator of a buffer without eof expects more buffers
+    ASSERT_EQ(buffers[i].is_eof() ? OB_ITER_END : OB_ERR_UNEXPECTED, ret);
+  }
+  ASSERT_EQ(row_cnt, id);
+}
+
+}  // namespace sql
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,342 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include <gtest/gtest.h>
+#include <map>
+#include <vector>
+
+#define private public
+#define protected public
+
+#include "sql/ob_sql_init.h"
+#include "sql/engine/aggregate/ob_hash_groupby_op.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/ob_physical_plan_ctx.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "share/config/ob_server_config.h"
+#include "share/datum/ob_datum_funcs.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
+
+namespace oceanbase {
+using namespace omt;
+namespace sql {
+using namespace common;
+
+class TestEnv : public ::testing::Environment {
+public:
+  virtual void SetUp() override
+  {
+    // the normal aggregation which results are compared with never dumps
+    GCONF.enable_sql_operator_dump.set_value("False");
+    lib::ObMallocAllocator* malloc_allocator = lib::ObMallocAllocator::get_instance();
+    ASSERT_EQ(OB_SUCCESS, malloc_allocator->create_tenant_ctx_allocator(OB_SYS_TENANT_ID));
+    ASSERT_EQ(OB_SUCCESS, malloc_allocator->create_tenant_ctx_allocator(OB_SYS_TENANT_ID, ObCtxIds::WORK_AREA));
+    ASSERT_EQ(OB_SUCCESS, ObTenantConfigMgr::get_instance().add_tenant_config(OB_SYS_TENANT_ID));
+  }
+
+  virtual void TearDown() override
+  {}
+};
+
+#define CALL(func, ...) \
+  func(__VA_ARGS__);    \
+  ASSERT_FALSE(HasFatalFailure());
+
+// Produces (key, row index) rows of %keys_.
+class TestInputOp : public ObOperator {
+public:
+  TestInputOp(ObExecContext& exec_ctx, const ObOpSpec& spec, const std::vector<int64_t>& keys)
+      : ObOperator(exec_ctx, spec, NULL), keys_(keys), idx_(0)
+  {}
+  virtual int inner_open() override
+  {
+    idx_ = 0;
+    return OB_SUCCESS;
+  }
+  virtual int inner_get_next_row() override
+  {
+    int ret = OB_SUCCESS;
+    if (idx_ >= static_cast<int64_t>(keys_.size())) {
+      ret = OB_ITER_END;
+    } else {
+      spec_.output_.at(0)->locate_datum_for_write(eval_ctx_).set_int(keys_.at(idx_));
+      spec_.output_.at(1)->locate_datum_for_write(eval_ctx_).set_int(idx_);
+      ++idx_;
+    }
+    return ret;
+  }
+  virtual void destroy() override
+  {
+    ObOperator::destroy();
+  }
+
+private:
+  const std::vector<int64_t>& keys_;
+  int64_t idx_;
+};
+
+// select key, count(*), max(val) from t group by key
+class TestHashGroupByBypass : public ::testing::Test {
+public:
+  // key -> (count(*), max(val))
+  typedef std::map<int64_t, std::pair<int64_t, int64_t>> GroupMap;
+
+  struct RunResult {
+    RunResult() : output_cnt_(0), bypassed_(false), input_remain_(false)
+    {}
+    GroupMap groups_;
+    int64_t output_cnt_;
+    // operator state after the first output row
+    bool bypassed_;
+    bool input_remain_;
+  };
+
+  enum { KEY_EXPR = 0, VAL_EXPR, COUNT_EXPR, MAX_EXPR, EXPR_CNT };
+  static const int64_t EXPR_FRAME_SIZE = 128;
+  static const int64_t EVAL_INFO_OFF = 32;
+  static const int64_t RES_BUF_OFF = 64;
+  static const int64_t DEFAULT_HASH_AREA_SIZE = 128L << 20;
+  static const int64_t SMALL_HASH_AREA_SIZE = 4L << 20;
+
+  virtual void SetUp() override
+  {
+    static_assert(sizeof(ObDatum) <= EVAL_INFO_OFF, "datum overlaps eval info");
+    static_assert(EVAL_INFO_OFF + sizeof(ObEvalInfo) <= RES_BUF_OFF, "eval info overlaps result buffer");
+    init_expr(exprs_[KEY_EXPR], KEY_EXPR, T_REF_COLUMN);
+    init_expr(exprs_[VAL_EXPR], VAL_EXPR, T_REF_COLUMN);
+    init_expr(exprs_[COUNT_EXPR], COUNT_EXPR, T_FUN_COUNT);
+    init_expr(exprs_[MAX_EXPR], MAX_EXPR, T_FUN_MAX);
+  }
+
+  void init_expr(ObExpr& expr, const int64_t idx, const ObExprOperatorType type)
+  {
+    expr.reset();
+    expr.type_ = type;
+    expr.datum_meta_.type_ = ObIntType;
+    expr.datum_meta_.cs_type_ = CS_TYPE_BINARY;
+    expr.obj_meta_.set_int();
+    expr.obj_datum_map_ = OBJ_DATUM_8BYTE_DATA;
+    expr.frame_idx_ = 0;
+    expr.datum_off_ = static_cast<uint32_t>(idx * EXPR_FRAME_SIZE);
+    expr.eval_info_off_ = static_cast<uint32_t>(expr.datum_off_ + EVAL_INFO_OFF);
+    expr.res_buf_off_ = static_cast<uint32_t>(expr.datum_off_ + RES_BUF_OFF);
+    expr.res_buf_len_ = sizeof(int64_t);
+    expr.basic_funcs_ = ObDatumFuncs::get_basic_func(ObIntType, CS_TYPE_BINARY);
+  }
+
+  void set_hash_area_size(const int64_t size)
+  {
+    ObTenantConfigGuard tenant_config(TENANT_CONF(OB_SYS_TENANT_ID));
+    ASSERT_TRUE(tenant_config.is_valid());
+    tenant_config->_hash_area_size = size;
+  }
+
+  void build_spec(ObHashGroupBySpec& spec, const bool bypass_enabled, const int64_t est_group_cnt)
+  {
+    ObCmpFunc cmp_func;
+    cmp_func.cmp_func_ =
+        ObDatumFuncs::get_nullsafe_cmp_func(ObIntType, ObIntType, NULL_FIRST, CS_TYPE_BINARY, false /* oracle */);
+    spec.id_ = 1;
+    spec.width_ = 3 * sizeof(int64_t);
+    ASSERT_EQ(OB_SUCCESS, spec.group_exprs_.init(1));
+    ASSERT_EQ(OB_SUCCESS, spec.add_group_expr(&exprs_[KEY_EXPR]));
+    ASSERT_EQ(OB_SUCCESS, spec.cmp_funcs_.init(1));
+    ASSERT_EQ(OB_SUCCESS, spec.cmp_funcs_.push_back(cmp_func));
+    ASSERT_EQ(OB_SUCCESS, spec.aggr_infos_.prepare_allocate(2));
+    ObAggrInfo& count_info = spec.aggr_infos_.at(0);
+    count_info.set_allocator(&alloc_);
+    count_info.expr_ = &exprs_[COUNT_EXPR];
+    ObAggrInfo& max_info = spec.aggr_infos_.at(1);
+    max_info.set_allocator(&alloc_);
+    max_info.expr_ = &exprs_[MAX_EXPR];
+    ASSERT_EQ(OB_SUCCESS, max_info.param_exprs_.init(1));
+    ASSERT_EQ(OB_SUCCESS, max_info.param_exprs_.push_back(&exprs_[VAL_EXPR]));
+    spec.set_est_group_cnt(est_group_cnt);
+    spec.set_bypass_enabled(bypass_enabled);
+  }
+
+  void run(const std::vector<int64_t>& keys, const bool bypass_enabled, const int64_t hash_area_size,
+      const int64_t est_group_cnt, RunResult& result)
+  {
+    ObSQLSessionInfo session;
+    ObExecContext ctx;
+    char* frames[1] = {frame_};
+    memset(frame_, 0, sizeof(frame_));
+    CALL(set_hash_area_size, hash_area_size);
+    ASSERT_EQ(OB_SUCCESS, session.test_init(0, 0, 0, NULL));
+    ASSERT_EQ(OB_SUCCESS, share::ObPreProcessSysVars::init_sys_var());
+    ASSERT_EQ(OB_SUCCESS, session.load_default_sys_variable(false, true));
+    ASSERT_EQ(OB_SUCCESS, session.init_tenant("sys", OB_SYS_TENANT_ID));
+    ctx.set_my_session(&session);
+    ASSERT_EQ(OB_SUCCESS, ctx.create_physical_plan_ctx());
+    ctx.get_physical_plan_ctx()->set_timeout_timestamp(ObTimeUtility::current_time() + 600L * 1000 * 1000);
+    ctx.set_frames(frames);
+    ctx.set_frame_cnt(1);
+    ASSERT_EQ(OB_SUCCESS, ctx.init_eval_ctx());
+
+    ObOpSpec input_spec(alloc_, PHY_FAKE_TABLE);
+    input_spec.id_ = 0;
+    input_spec.rows_ = static_cast<int64_t>(keys.size());
+    input_spec.width_ = 2 * sizeof(int64_t);
+    ASSERT_EQ(OB_SUCCESS, input_spec.output_.init(2));
+    ASSERT_EQ(OB_SUCCESS, input_spec.output_.push_back(&exprs_[KEY_EXPR]));
+    ASSERT_EQ(OB_SUCCESS, input_spec.output_.push_back(&exprs_[VAL_EXPR]));
+    ObHashGroupBySpec spec(alloc_, PHY_HASH_GROUP_BY);
+    ObOpSpec* child_specs[1] = {&input_spec};
+    ASSERT_EQ(OB_SUCCESS, spec.set_children_pointer(child_specs, 1));
+    CALL(build_spec, spec, bypass_enabled, est_group_cnt);
+
+    // operators are released by destroy(), as the executor does
+    void* input_buf = alloc_.alloc(sizeof(TestInputOp));
+    void* op_buf = alloc_.alloc(sizeof(ObHashGroupByOp));
+    ASSERT_TRUE(NULL != input_buf && NULL != op_buf);
+    TestInputOp* input = new (input_buf) TestInputOp(ctx, input_spec, keys);
+    ObHashGroupByOp* op = new (op_buf) ObHashGroupByOp(ctx, spec, NULL);
+    ObOperator* children[1] = {input};
+    ASSERT_EQ(OB_SUCCESS, op->set_children_pointer(children, 1));
+    input->parent_ = op;
+
+    ObEvalCtx& eval_ctx = *ctx.get_eval_ctx();
+    int ret = OB_SUCCESS;
+    ASSERT_EQ(OB_SUCCESS, op->open());
+    while (OB_SUCC(op->get_next_row())) {
+      if (0 == result.output_cnt_) {
+        result.bypassed_ = op->bypass_;
+        result.input_remain_ = op->input_remain_;
+      }
+      ++result.output_cnt_;
+      // merge the partial groups as the parent group by does
+      const int64_t key = exprs_[KEY_EXPR].locate_expr_datum(eval_ctx).get_int();
+      const int64_t cnt = exprs_[COUNT_EXPR].locate_expr_datum(eval_ctx).get_int();
+      const int64_t max_val = exprs_[MAX_EXPR].locate_expr_datum(eval_ctx).get_int();
+      GroupMap::iterator iter = result.groups_.find(key);
+      if (result.groups_.end() == iter) {
+        result.groups_[key] = std::make_pair(cnt, max_val);
+      } else {
+        iter->second.first += cnt;
+        iter->second.second = std::max(iter->second.second, max_val);
+      }
+    }
+    ASSERT_EQ(OB_ITER_END, ret);
+    ASSERT_EQ(OB_SUCCESS, op->close());
+    op->destroy();
+    input->destroy();
+  }
+
+  static void calc_expected(const std::vector<int64_t>& keys, GroupMap& groups)
+  {
+    for (int64_t i = 0; i < static_cast<int64_t>(keys.size()); ++i) {
+      std::pair<int64_t, int64_t>& group = groups[keys.at(i)];
+      group.first += 1;
+      group.second = i;
+    }
+  }
+
+protected:
+  ObArenaAllocator alloc_;
+  ObExpr exprs_[EXPR_CNT];
+  char frame_[EXPR_CNT * EXPR_FRAME_SIZE];
+};
+
+TEST_F(TestHashGroupByBypass, low_ndv_no_bypass)
+{
+  const int64_t ROW_CNT = 50000;
+  const int64_t GROUP_CNT = 100;
+  std::vector<int64_t> keys;
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    keys.push_back(i % GROUP_CNT);
+  }
+  GroupMap expected;
+  calc_expected(keys, expected);
+
+  RunResult result;
+  CALL(run, keys, true /* bypass enabled */, DEFAULT_HASH_AREA_SIZE, GROUP_CNT, result);
+  ASSERT_FALSE(result.bypassed_);
+  ASSERT_FALSE(result.input_remain_);
+  ASSERT_EQ(GROUP_CNT, result.output_cnt_);
+  ASSERT_TRUE(expected == result.groups_);
+}
+
+TEST_F(TestHashGroupByBypass, bypass_merge)
+{
+  const int64_t ROW_CNT = 80000;
+  const int64_t GROUP_CNT = 40000;
+  std::vector<int64_t> keys;
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    keys.push_back(i % GROUP_CNT);
+  }
+  GroupMap expected;
+  calc_expected(keys, expected);
+
+  RunResult normal;
+  CALL(run, keys, false /* bypass enabled */, DEFAULT_HASH_AREA_SIZE, GROUP_CNT, normal);
+  ASSERT_FALSE(normal.bypassed_);
+  ASSERT_EQ(GROUP_CNT, normal.output_cnt_);
+  ASSERT_TRUE(expected == normal.groups_);
+
+  // the first check rows are all new groups, they are emitted by load_data(), then every other
+  // row is passed through by load_bypass_data() as a group of its own.
+  RunResult bypass;
+  CALL(run, keys, true /* bypass enabled */, DEFAULT_HASH_AREA_SIZE, GROUP_CNT, bypass);
+  ASSERT_TRUE(bypass.bypassed_);
+  ASSERT_TRUE(bypass.input_remain_);
+  ASSERT_EQ(ROW_CNT, bypass.output_cnt_);
+  ASSERT_TRUE(normal.groups_ == bypass.groups_);
+}
+
+TEST_F(TestHashGroupByBypass, emit_in_memory_groups_merge)
+{
+  // every key shows up twice in a row and again in the second half, half of the rows are new
+  // groups which is below the bypass percent.
+  const int64_t ROW_CNT = 400000;
+  const int64_t GROUP_CNT = 100000;
+  std::vector<int64_t> keys;
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    keys.push_back((i / 2) % GROUP_CNT);
+  }
+  GroupMap expected;
+  calc_expected(keys, expected);
+
+  RunResult normal;
+  CALL(run, keys, false /* bypass enabled */, SMALL_HASH_AREA_SIZE, GROUP_CNT, normal);
+  ASSERT_FALSE(normal.input_remain_);
+  ASSERT_EQ(GROUP_CNT, normal.output_cnt_);
+  ASSERT_TRUE(expected == normal.groups_);
+
+  // groups in memory are emitted when the hash area is used up, load_remain_data() continues
+  // with the normal aggregation on an empty hash table.
+  RunResult bypass;
+  CALL(run, keys, true /* bypass enabled */, SMALL_HASH_AREA_SIZE, GROUP_CNT, bypass);
+  ASSERT_FALSE(bypass.bypassed_);
+  ASSERT_TRUE(bypass.input_remain_);
+  ASSERT_GT(bypass.output_cnt_, GROUP_CNT);
+  ASSERT_LT(bypass.output_cnt_, ROW_CNT);
+  ASSERT_TRUE(normal.groups_ == bypass.groups_);
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::sql::init_sql_factories();
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  oceanbase::common::ObClockGenerator::init();
+  testing::InitGoogleTest(&argc, argv);
+  auto* env = new (oceanbase::sql::TestEnv);
+  testing::AddGlobalTestEnvironment(env);
+  int ret = RUN_ALL_TESTS();
+  OB_LOGGER.disable();
+  return ret;
+}
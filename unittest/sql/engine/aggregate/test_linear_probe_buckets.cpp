@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "sql/engine/aggregate/ob_exec_hash_struct.h"
+
+namespace oceanbase {
+namespace sql {
+using namespace common;
+
+struct TestItem {
+  int64_t key_;
+};
+
+class TestLinearProbeBuckets : public ::testing::Test {
+public:
+  static const int64_t ITEM_CNT = 100000;
+  TestLinearProbeBuckets() : allocator_(ObModIds::TEST)
+  {}
+  virtual void SetUp()
+  {
+    for (int64_t i = 0; i < ITEM_CNT; ++i) {
+      items_[i].key_ = i;
+    }
+  }
+  // every 8 keys have the same hash value when clustered, to test long probing
+  static uint64_t hash(const int64_t key, const bool clustered)
+  {
+    const int64_t hash_key = clustered ? key / 8 : key;
+    return murmurhash(&hash_key, sizeof(hash_key), 0);
+  }
+  void insert_and_check(ObLinearProbeBuckets<TestItem>& buckets, const bool clustered);
+
+protected:
+  ModulePageAllocator allocator_;
+  TestItem items_[ITEM_CNT];
+};
+const int64_t TestLinearProbeBuckets::ITEM_CNT;
+
+void TestLinearProbeBuckets::insert_and_check(ObLinearProbeBuckets<TestItem>& buckets, const bool clustered)
+{
+  for (int64_t i = 0; i < ITEM_CNT; ++i) {
+    if (i * 2 >= buckets.count()) {
+      ASSERT_EQ(OB_SUCCESS, buckets.extend(buckets.count() * 2));
+    }
+    ASSERT_EQ(OB_SUCCESS, buckets.insert(hash(i, clustered), items_[i]));
+    // items inserted before are found during extending
+    const int64_t key = i / 2;
+    auto eq = [key](const TestItem& item) { return item.key_ == key; };
+    ASSERT_EQ(&items_[key], buckets.get(hash(key, clustered), eq));
+  }
+  for (int64_t i = 0; i < ITEM_CNT; ++i) {
+    auto eq = [i](const TestItem& item) { return item.key_ == i; };
+    ASSERT_EQ(&items_[i], buckets.get(hash(i, clustered), eq));
+  }
+  const int64_t absent_key = ITEM_CNT;
+  auto eq = [absent_key](const TestItem& item) { return item.key_ == absent_key; };
+  ASSERT_TRUE(NULL == buckets.get(hash(absent_key, clustered), eq));
+
+  int64_t cnt = 0;
+  int64_t key_sum = 0;
+  auto cb = [&](TestItem& item) {
+    ++cnt;
+    key_sum += item.key_;
+    return OB_SUCCESS;
+  };
+  ASSERT_EQ(OB_SUCCESS, buckets.foreach(cb));
+  ASSERT_EQ(ITEM_CNT, cnt);
+  ASSERT_EQ(ITEM_CNT * (ITEM_CNT - 1) / 2, key_sum);
+}
+
+TEST_F(TestLinearProbeBuckets, basic)
+{
+  ObLinearProbeBuckets<TestItem> buckets;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, buckets.init(allocator_, 100));
+  ASSERT_EQ(OB_SUCCESS, buckets.init(allocator_, 16));
+  ASSERT_EQ(OB_INIT_TWICE, buckets.init(allocator_, 16));
+  insert_and_check(buckets, false);
+
+  const int64_t bucket_num = buckets.count();
+  buckets.reuse();
+  ASSERT_EQ(bucket_num, buckets.count());
+  auto eq = [](const TestItem& item) { return item.key_ == 0; };
+  ASSERT_TRUE(NULL == buckets.get(hash(0, false), eq));
+  buckets.destroy();
+  ASSERT_FALSE(buckets.is_inited());
+}
+
+TEST_F(TestLinearProbeBuckets, clustered)
+{
+  ObLinearProbeBuckets<TestItem> buckets;
+  ASSERT_EQ(OB_SUCCESS, buckets.init(allocator_, 16));
+  insert_and_check(buckets, true);
+}
+
+TEST_F(TestLinearProbeBuckets, full)
+{
+  ObLinearProbeBuckets<TestItem> buckets;
+  ASSERT_EQ(OB_SUCCESS, buckets.init(allocator_, 16));
+  for (int64_t i = 0; i < 15; ++i) {
+    ASSERT_EQ(OB_SUCCESS, buckets.insert(hash(i, false), items_[i]));
+  }
+  // one empty bucket is kept to end probing
+  ASSERT_EQ(OB_SIZE_OVERFLOW, buckets.insert(hash(15, false), items_[15]));
+  ASSERT_EQ(OB_SUCCESS, buckets.extend(32));
+  ASSERT_EQ(OB_SUCCESS, buckets.insert(hash(15, false), items_[15]));
+  for (int64_t i = 0; i < 16; ++i) {
+    auto eq = [i](const TestItem& item) { return item.key_ == i; };
+    ASSERT_EQ(&items_[i], buckets.get(hash(i, false), eq));
+  }
+}
+
+}  // namespace sql
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "sql/engine/px/datahub/components/ob_dh_join_filter.h"
+#include "lib/hash_func/murmur_hash.h"
+
+namespace oceanbase {
+namespace sql {
+using namespace common;
+
+static uint64_t key_hash(const int64_t key)
+{
+  return murmurhash(&key, sizeof(key), ObPxBloomFilter::HASH_SEED) & ObPxBloomFilter::HASH_VAL_MASK;
+}
+
+TEST(TestPxBloomFilter, calc_bit_count)
+{
+  ASSERT_EQ(ObPxBloomFilter::MIN_BIT_COUNT, ObPxBloomFilter::calc_bit_count(0));
+  ASSERT_EQ(ObPxBloomFilter::MIN_BIT_COUNT, ObPxBloomFilter::calc_bit_count(10));
+  ASSERT_EQ(1L << 15, ObPxBloomFilter::calc_bit_count(2000));
+  ASSERT_EQ(ObPxBloomFilter::MAX_BIT_COUNT, ObPxBloomFilter::calc_bit_count(ObPxBloomFilter::MAX_BIT_COUNT / 4));
+  ASSERT_EQ(0, ObPxBloomFilter::calc_bit_count(ObPxBloomFilter::MAX_BIT_COUNT / 4 + 1));
+}
+
+TEST(TestPxBloomFilter, set_and_merge)
+{
+  const int64_t row_cnt = 1000;
+  const int64_t bit_cnt = ObPxBloomFilter::calc_bit_count(row_cnt);
+  ObPxBloomFilter f1;
+  ObPxBloomFilter f2;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, f1.init(bit_cnt + 1));
+  ASSERT_EQ(OB_SUCCESS, f1.init(bit_cnt));
+  ASSERT_EQ(OB_SUCCESS, f2.init(bit_cnt));
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    if (0 == i % 2) {
+      f1.set(key_hash(i));
+    } else {
+      f2.set(key_hash(i));
+    }
+  }
+  ASSERT_EQ(OB_SUCCESS, f1.merge(f2));
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    ASSERT_TRUE(f1.might_contain(key_hash(i))) << "i: " << i;
+  }
+  int64_t false_positive = 0;
+  for (int64_t i = row_cnt; i < 11 * row_cnt; ++i) {
+    false_positive += f1.might_contain(key_hash(i)) ? 1 : 0;
+  }
+  // 16 bits per row with two probes, far below 5%
+  ASSERT_LT(false_positive, row_cnt / 2);
+  ASSERT_LE(f1.get_fill_ratio(), ObJoinFilterPieceMsgCtx::MAX_FILL_RATIO);
+
+  ObPxBloomFilter f3;
+  ASSERT_EQ(OB_SUCCESS, f3.init(bit_cnt * 2));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, f1.merge(f3));
+}
+
+TEST(TestPxBloomFilter, serialize)
+{
+  ObPxBloomFilter filter;
+  ASSERT_EQ(OB_SUCCESS, filter.init(ObPxBloomFilter::MIN_BIT_COUNT));
+  for (int64_t i = 0; i < 100; ++i) {
+    filter.set(key_hash(i));
+  }
+  ObJoinFilterWholeMsg whole;
+  whole.op_id_ = 3;
+  whole.is_valid_ = true;
+  ASSERT_EQ(OB_SUCCESS, whole.filter_.assign(filter));
+
+  const int64_t buf_len = whole.get_serialize_size();
+  char* buf = new char[buf_len];
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, whole.serialize(buf, buf_len, pos));
+  ASSERT_EQ(buf_len, pos);
+
+  ObJoinFilterWholeMsg result;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, result.deserialize(buf, buf_len, pos));
+  ASSERT_EQ(buf_len, pos);
+  ASSERT_EQ(3, result.op_id_);
+  ASSERT_TRUE(result.is_valid_);
+  ASSERT_EQ(filter.get_bit_count(), result.filter_.get_bit_count());
+  for (int64_t i = 0; i < 100; ++i) {
+    ASSERT_TRUE(result.filter_.might_contain(key_hash(i)));
+  }
+  ASSERT_EQ(filter.get_fill_ratio(), result.filter_.get_fill_ratio());
+
+  // truncated buffer
+  pos = 0;
+  ASSERT_NE(OB_SUCCESS, result.deserialize(buf, buf_len - 1, pos));
+  delete[] buf;
+}
+
+}  // namespace sql
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
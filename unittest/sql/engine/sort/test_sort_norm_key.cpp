@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "sql/engine/sort/ob_sort_op_impl.h"
+
+using namespace oceanbase;
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+
+class TestSortNormKey : public ::testing::Test {
+public:
+  uint64_t int_key(const int64_t v, const ObSortFieldCollation& coll)
+  {
+    ObDatum d;
+    d.set_int(v);
+    return ObSortNormKey::encode(d, ObIntTC, coll);
+  }
+  uint64_t double_key(const double v, const ObSortFieldCollation& coll)
+  {
+    ObDatum d;
+    d.set_double(v);
+    return ObSortNormKey::encode(d, ObDoubleTC, coll);
+  }
+  uint64_t null_key(const ObSortFieldCollation& coll)
+  {
+    ObDatum d;
+    d.set_null();
+    return ObSortNormKey::encode(d, ObIntTC, coll);
+  }
+};
+
+TEST_F(TestSortNormKey, supported_type)
+{
+  ASSERT_TRUE(ObSortNormKey::is_supported(ObIntType));
+  ASSERT_TRUE(ObSortNormKey::is_supported(ObUInt64Type));
+  ASSERT_TRUE(ObSortNormKey::is_supported(ObDoubleType));
+  ASSERT_TRUE(ObSortNormKey::is_supported(ObDateTimeType));
+  ASSERT_TRUE(ObSortNormKey::is_supported(ObDateType));
+  ASSERT_FALSE(ObSortNormKey::is_supported(ObVarcharType));
+  ASSERT_FALSE(ObSortNormKey::is_supported(ObNumberType));
+  ASSERT_FALSE(ObSortNormKey::is_supported(ObMaxType));
+}
+
+TEST_F(TestSortNormKey, encode_order)
+{
+  ObSortFieldCollation asc(0, CS_TYPE_BINARY, true, NULL_FIRST);
+  ObSortFieldCollation desc(0, CS_TYPE_BINARY, false, NULL_FIRST);
+  ObSortFieldCollation asc_null_last(0, CS_TYPE_BINARY, true, NULL_LAST);
+
+  const int64_t ints[] = {INT64_MIN + 1, -100, -1, 0, 1, 100, INT64_MAX};
+  for (int64_t i = 1; i < ARRAYSIZEOF(ints); i++) {
+    ASSERT_LT(int_key(ints[i - 1], asc), int_key(ints[i], asc));
+    ASSERT_GT(int_key(ints[i - 1], desc), int_key(ints[i], desc));
+    ASSERT_LT(null_key(asc), int_key(ints[i], asc));
+    ASSERT_GT(null_key(desc), int_key(ints[i], desc));
+    ASSERT_GT(null_key(asc_null_last), int_key(ints[i], asc_null_last));
+  }
+  // NULL and INT64_MIN share the key, tie is resolved by full comparison
+  ASSERT_EQ(null_key(asc), int_key(INT64_MIN, asc));
+
+  const double doubles[] = {-1e300, -2.5, -1e-300, 0.0, 1e-300, 2.5, 1e300};
+  for (int64_t i = 1; i < ARRAYSIZEOF(doubles); i++) {
+    ASSERT_LT(double_key(doubles[i - 1], asc), double_key(doubles[i], asc));
+    ASSERT_GT(double_key(doubles[i - 1], desc), double_key(doubles[i], desc));
+  }
+  ASSERT_EQ(double_key(-0.0, asc), double_key(0.0, asc));
+}
+
+TEST_F(TestSortNormKey, radix_sort)
+{
+  const int64_t cnts[] = {0, 1, 10, 64, 65, 1000, 100000};
+  // key ranges: all equal, few distinct, shared high bytes, full range
+  const uint64_t masks[] = {0, 0x7, 0xFFFF, UINT64_MAX};
+  for (int64_t i = 0; i < ARRAYSIZEOF(cnts); i++) {
+    for (int64_t j = 0; j < ARRAYSIZEOF(masks); j++) {
+      std::vector<ObSortNormKey::Item> items(cnts[i] + 1);
+      std::vector<uint64_t> keys;
+      for (int64_t k = 0; k < cnts[i]; k++) {
+        items[k].key_ = ((static_cast<uint64_t>(rand()) << 32) ^ rand()) & masks[j];
+        items[k].row_ = reinterpret_cast<ObChunkDatumStore::StoredRow*>(k + 1);
+        keys.push_back(items[k].key_);
+      }
+      ObSortNormKey::radix_sort(&items[0], cnts[i]);
+      std::sort(keys.begin(), keys.end());
+      for (int64_t k = 0; k < cnts[i]; k++) {
+        ASSERT_EQ(keys[k], items[k].key_) << "cnt: " << cnts[i] << " mask: " << masks[j] << " idx: " << k;
+      }
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  system("rm -f test_sort_norm_key.log*");
+  OB_LOGGER.set_file_name("test_sort_norm_key.log", true, true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
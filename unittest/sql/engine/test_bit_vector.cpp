@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "sql/engine/ob_bit_vector.h"
+
+namespace oceanbase {
+namespace sql {
+
+TEST(TestBitVector, basic)
+{
+  const int64_t size = 130;
+  char mem[ObBitVector::memory_size(size)];
+  ASSERT_EQ(24, ObBitVector::memory_size(size));
+  ObBitVector* bv = to_bit_vector(mem);
+  bv->reset(size);
+  ASSERT_TRUE(bv->is_all_false(size));
+  bv->set(0);
+  bv->set(63);
+  bv->set(64);
+  bv->set(129);
+  ASSERT_TRUE(bv->at(0));
+  ASSERT_TRUE(bv->at(63));
+  ASSERT_TRUE(bv->at(64));
+  ASSERT_TRUE(bv->at(129));
+  ASSERT_FALSE(bv->at(1));
+  ASSERT_FALSE(bv->at(128));
+  ASSERT_EQ(4, bv->accumulate_bit_cnt(size));
+  ASSERT_EQ(2, bv->accumulate_bit_cnt(64));
+  ASSERT_EQ(3, bv->accumulate_bit_cnt(65));
+  bv->unset(63);
+  ASSERT_FALSE(bv->at(63));
+  ASSERT_EQ(3, bv->accumulate_bit_cnt(size));
+}
+
+TEST(TestBitVector, set_all)
+{
+  const int64_t size = 100;
+  char mem[ObBitVector::memory_size(size)];
+  ObBitVector* bv = to_bit_vector(mem);
+  bv->reset(size);
+  bv->set_all(70);
+  ASSERT_EQ(70, bv->accumulate_bit_cnt(size));
+  ASSERT_TRUE(bv->is_all_true(70));
+  ASSERT_FALSE(bv->is_all_true(71));
+  ASSERT_FALSE(bv->at(70));
+
+  char other_mem[ObBitVector::memory_size(size)];
+  ObBitVector* other = to_bit_vector(other_mem);
+  other->reset(size);
+  other->set(99);
+  bv->bit_or(*other, size);
+  ASSERT_TRUE(bv->at(99));
+  ASSERT_EQ(71, bv->accumulate_bit_cnt(size));
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
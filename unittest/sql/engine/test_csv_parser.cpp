@@ -0,0 +1,347 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#define private public
+#include "sql/engine/cmd/ob_load_data_impl.h"
+#undef private
+
+namespace oceanbase {
+using namespace common;
+namespace sql {
+
+typedef ObCSVSpecialCharScanner::ScanFunc ScanFunc;
+typedef std::vector<std::string> Line;
+
+static const int64_t FIELD_CNT = 4;
+// longer than two avx2 strides, so that every char can be at the edge of a block
+static const int64_t MAX_FIELD_LEN = 80;
+
+class TestCSVParser : public ::testing::Test {
+public:
+  TestCSVParser() : seed_(20211018), origin_func_(NULL)
+  {}
+  virtual void SetUp()
+  {
+    origin_func_ = ObCSVSpecialCharScanner::scan_func_;
+    scan_funcs_.clear();
+    func_names_.clear();
+    scan_funcs_.push_back(&ObCSVSpecialCharScanner::scan_scalar);
+    func_names_.push_back("scalar");
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("sse4.2")) {
+      scan_funcs_.push_back(&ObCSVSpecialCharScanner::scan_sse42);
+      func_names_.push_back("sse4.2");
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      scan_funcs_.push_back(&ObCSVSpecialCharScanner::scan_avx2);
+      func_names_.push_back("avx2");
+    }
+#endif
+  }
+  virtual void TearDown()
+  {
+    ObCSVSpecialCharScanner::scan_func_ = origin_func_;
+  }
+
+protected:
+  int64_t rand_int(const int64_t max)
+  {
+    return rand_r(&seed_) % max;
+  }
+  void check_scan(const ObCSVSpecialCharScanner& scanner, const std::string& data);
+  static void init_parser(const bool is_enclosed, ObCSVParser& parser);
+  static void encode_field(const std::string& field, const bool enclose, const bool is_last, std::string& text);
+  static std::string encode_line(const Line& line, const bool is_enclosed);
+  Line rand_line(const bool is_enclosed, std::string& text);
+  void parse_lines(const bool is_enclosed, const std::string& text, std::vector<Line>& lines);
+  void split_lines(const bool is_enclosed, const std::string& text, const int64_t chunk_len, std::string& complete,
+      int64_t& line_cnt);
+  void check_lines(const bool is_enclosed, const std::string& text, const std::vector<Line>& expect);
+
+protected:
+  unsigned int seed_;
+  ScanFunc origin_func_;
+  std::vector<ScanFunc> scan_funcs_;
+  std::vector<const char*> func_names_;
+};
+
+// every scanner must return the first special char of each [begin, end) window, as scan_scalar does
+void TestCSVParser::check_scan(const ObCSVSpecialCharScanner& scanner, const std::string& data)
+{
+  const char* buf = data.data();
+  const int64_t len = data.length();
+  for (int64_t begin = 0; begin <= len; ++begin) {
+    for (int64_t end = begin; end <= len; ++end) {
+      const char* expect = ObCSVSpecialCharScanner::scan_scalar(scanner, buf + begin, buf + end);
+      for (int64_t i = 0; i < scan_funcs_.size(); ++i) {
+        ASSERT_EQ(expect, scan_funcs_[i](scanner, buf + begin, buf + end))
+            << func_names_[i] << " begin " << begin << " end " << end;
+      }
+      ASSERT_EQ(expect, scanner.find(buf + begin, buf + end)) << "begin " << begin << " end " << end;
+    }
+  }
+}
+
+void TestCSVParser::init_parser(const bool is_enclosed, ObCSVParser& parser)
+{
+  ObDataInFileStruct file_formats;
+  ObCSVFormats formats;
+  ObBitSet<> string_type_column;
+  if (is_enclosed) {
+    file_formats.field_enclosed_char_ = '"';
+  }
+  formats.init(file_formats);
+  for (int64_t i = 0; i < FIELD_CNT; ++i) {
+    ASSERT_EQ(OB_SUCCESS, string_type_column.add_member(i));
+  }
+  ASSERT_EQ(OB_SUCCESS, parser.init(FIELD_CNT, formats, string_type_column));
+}
+
+/*
+ * the escape char and the terms are escaped in a plain field,
+ * an enclosed field doubles the enclose char and keeps the terms as they are
+ */
+void TestCSVParser::encode_field(const std::string& field, const bool enclose, const bool is_last, std::string& text)
+{
+  if (enclose) {
+    text.push_back('"');
+  }
+  for (int64_t i = 0; i < field.length(); ++i) {
+    const char c = field[i];
+    if ('\\' == c || (!enclose && ('\t' == c || '\n' == c || '"' == c))) {
+      text.push_back('\\');
+    } else if (enclose && '"' == c) {
+      text.push_back('"');
+    }
+    text.push_back(c);
+  }
+  if (enclose) {
+    text.push_back('"');
+  }
+  text.push_back(is_last ? '\n' : '\t');
+}
+
+// all fields are enclosed in the enclosed format
+std::string TestCSVParser::encode_line(const Line& line, const bool is_enclosed)
+{
+  std::string text;
+  for (int64_t i = 0; i < line.size(); ++i) {
+    encode_field(line[i], is_enclosed, FIELD_CNT - 1 == i, text);
+  }
+  return text;
+}
+
+// no 'U' or 'L' in the chars, so that a field never turns into NULL
+Line TestCSVParser::rand_line(const bool is_enclosed, std::string& text)
+{
+  static const char CHARS[] = {'a', 'b', 'N', ' ', '\xe4', '\t', '\n', '\\', '"'};
+  Line line;
+  for (int64_t i = 0; i < FIELD_CNT; ++i) {
+    std::string field;
+    // mostly plain chars, so that there are long runs for the simd scanning
+    const int64_t special_ratio = 1 + rand_int(16);
+    const int64_t len = rand_int(MAX_FIELD_LEN);
+    for (int64_t j = 0; j < len; ++j) {
+      field.push_back(0 == rand_int(special_ratio) ? CHARS[5 + rand_int(4)] : CHARS[rand_int(5)]);
+    }
+    const bool is_last = FIELD_CNT - 1 == i;
+    bool enclose = is_enclosed && 0 == rand_int(2);
+    // an empty plain field at the end makes the line irregular
+    if (is_last && field.empty()) {
+      if (is_enclosed) {
+        enclose = true;
+      } else {
+        field.push_back('a');
+      }
+    }
+    encode_field(field, enclose, is_last, text);
+    line.push_back(field);
+  }
+  return line;
+}
+
+// split the whole text into fields, as the shuffle task does
+void TestCSVParser::parse_lines(const bool is_enclosed, const std::string& text, std::vector<Line>& lines)
+{
+  ObCSVParser parser;
+  init_parser(is_enclosed, parser);
+  ASSERT_FALSE(HasFatalFailure());
+  // fields are unescaped in place
+  std::string data(text);
+  bool yield = true;
+  lines.clear();
+  parser.next_buf(&data[0], data.length(), true);
+  while (yield) {
+    ASSERT_EQ(OB_SUCCESS, parser.next_line(yield));
+    if (yield) {
+      Line line;
+      for (int64_t i = 0; i < FIELD_CNT; ++i) {
+        const ObString& field = parser.get_line_store().at(i);
+        line.push_back(std::string(field.ptr(), field.length()));
+      }
+      lines.push_back(line);
+    }
+  }
+}
+
+/*
+ * count the complete lines chunk by chunk, as the main thread does when reading the file,
+ * the incomplete tail is carried over to the next chunk
+ */
+void TestCSVParser::split_lines(const bool is_enclosed, const std::string& text, const int64_t chunk_len,
+    std::string& complete, int64_t& line_cnt)
+{
+  ObCSVParser parser;
+  init_parser(is_enclosed, parser);
+  ASSERT_FALSE(HasFatalFailure());
+  parser.set_fast_parse();
+  const int64_t buf_size = text.length() + 1;
+  std::vector<char> buf(sizeof(ObLoadFileBuffer) + buf_size);
+  ObLoadFileBuffer* buffer = new (&buf[0]) ObLoadFileBuffer(buf_size);
+  complete.clear();
+  line_cnt = 0;
+  for (int64_t pos = 0; pos < text.length();) {
+    const int64_t len = std::min(chunk_len, static_cast<int64_t>(text.length()) - pos);
+    MEMCPY(buffer->current_ptr(), text.data() + pos, len);
+    buffer->update_pos(len);
+    pos += len;
+    const bool is_last_buf = pos == text.length();
+    int64_t valid_len = 0;
+    int64_t cnt = INT64_MAX;
+    ASSERT_EQ(OB_SUCCESS, ObCSVParser::fast_parse_lines(*buffer, parser, is_last_buf, valid_len, cnt));
+    ASSERT_LE(valid_len, buffer->get_data_len());
+    complete.append(buffer->begin_ptr(), valid_len);
+    line_cnt += cnt;
+    const int64_t remain_len = buffer->get_data_len() - valid_len;
+    MEMMOVE(buffer->begin_ptr(), buffer->begin_ptr() + valid_len, remain_len);
+    buffer->reset();
+    buffer->update_pos(remain_len);
+  }
+  ASSERT_EQ(0, buffer->get_data_len());
+}
+
+void TestCSVParser::check_lines(const bool is_enclosed, const std::string& text, const std::vector<Line>& expect)
+{
+  static const int64_t CHUNK_LENS[] = {1, 7, 16, 31, 32, 33, 100, 4096};
+  for (int64_t i = 0; i < scan_funcs_.size(); ++i) {
+    SCOPED_TRACE(func_names_[i]);
+    ObCSVSpecialCharScanner::scan_func_ = scan_funcs_[i];
+    std::vector<Line> lines;
+    parse_lines(is_enclosed, text, lines);
+    ASSERT_FALSE(HasFatalFailure());
+    ASSERT_EQ(expect.size(), lines.size());
+    for (int64_t j = 0; j < expect.size(); ++j) {
+      for (int64_t k = 0; k < FIELD_CNT; ++k) {
+        ASSERT_EQ(expect[j][k], lines[j][k]) << "line " << j << " field " << k;
+      }
+    }
+    for (int64_t j = 0; j < ARRAYSIZEOF(CHUNK_LENS); ++j) {
+      std::string complete;
+      int64_t line_cnt = 0;
+      split_lines(is_enclosed, text, CHUNK_LENS[j], complete, line_cnt);
+      ASSERT_FALSE(HasFatalFailure());
+      ASSERT_EQ(static_cast<int64_t>(expect.size()), line_cnt) << "chunk " << CHUNK_LENS[j];
+      ASSERT_TRUE(text == complete) << "chunk " << CHUNK_LENS[j];
+    }
+  }
+}
+
+TEST_F(TestCSVParser, scan)
+{
+  // the last ones are out of the range of char and never matched
+  static const int64_t CHARS[][ObCSVSpecialCharScanner::MAX_SPECIAL_CHAR_NUM] = {{'\n', INT64_MAX, INT64_MAX, 0xff},
+      {'\t', '\n', INT64_MAX, INT64_MAX},
+      {'"', '\\', '\t', '\n'},
+      {static_cast<char>(0xe4), static_cast<char>(0x80), ',', '\0'}};
+  for (int64_t i = 0; i < ARRAYSIZEOF(CHARS); ++i) {
+    ObCSVSpecialCharScanner scanner;
+    for (int64_t j = 0; j < ObCSVSpecialCharScanner::MAX_SPECIAL_CHAR_NUM; ++j) {
+      ASSERT_EQ(OB_SUCCESS, scanner.add_char(CHARS[i][j]));
+    }
+    // at most one special char, at every position of the blocks
+    std::string plain(100, 'a');
+    check_scan(scanner, plain);
+    ASSERT_FALSE(HasFatalFailure());
+    for (int64_t pos = 0; pos < plain.length(); pos += 3) {
+      std::string data(plain);
+      data[pos] = scanner.chars_[pos % scanner.char_cnt_];
+      check_scan(scanner, data);
+      ASSERT_FALSE(HasFatalFailure());
+    }
+    // random bytes, including the ones with the sign bit
+    for (int64_t round = 0; round < 8; ++round) {
+      std::string data(130, '\0');
+      for (int64_t j = 0; j < data.length(); ++j) {
+        data[j] = static_cast<char>(rand_int(256));
+      }
+      check_scan(scanner, data);
+      ASSERT_FALSE(HasFatalFailure());
+    }
+  }
+}
+
+TEST_F(TestCSVParser, plain_lines)
+{
+  std::string text;
+  std::vector<Line> expect;
+  for (int64_t i = 0; i < 200; ++i) {
+    expect.push_back(rand_line(false, text));
+  }
+  check_lines(false, text, expect);
+  ASSERT_FALSE(HasFatalFailure());
+}
+
+TEST_F(TestCSVParser, enclosed_lines)
+{
+  std::string text;
+  std::vector<Line> expect;
+  for (int64_t i = 0; i < 200; ++i) {
+    expect.push_back(rand_line(true, text));
+  }
+  check_lines(true, text, expect);
+  ASSERT_FALSE(HasFatalFailure());
+}
+
+// an escape or a pair of enclose chars at every offset around the edges of 16 and 32 bytes blocks
+TEST_F(TestCSVParser, escape_at_block_edge)
+{
+  for (int64_t is_enclosed = 0; is_enclosed < 2; ++is_enclosed) {
+    for (int64_t offset = 0; offset < 70; ++offset) {
+      Line line;
+      line.push_back(std::string(offset, 'a'));
+      line.push_back("\\\t\n");
+      line.push_back(std::string(offset, 'b') + "\"\t\"\n");
+      line.push_back("N");
+      std::string text = encode_line(line, is_enclosed);
+      std::vector<Line> expect(3, line);
+      text += text + text;
+      check_lines(is_enclosed, text, expect);
+      ASSERT_FALSE(HasFatalFailure()) << "offset " << offset;
+    }
+  }
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
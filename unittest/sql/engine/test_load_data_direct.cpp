@@ -0,0 +1,260 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "sql/engine/cmd/ob_load_data_rpc.h"
+#define private public
+#include "sql/engine/cmd/ob_load_data_direct.h"
+#undef private
+#include "storage/ob_store_row_comparer.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace storage;
+namespace sql {
+
+class TestLoadDataDirect : public ::testing::Test {
+public:
+  static void make_key(ObLoadDataDirectKey& key)
+  {
+    key.coordinator_.set_ip_addr("127.0.0.1", 2882);
+    key.load_id_ = 1001;
+    key.pkey_ = ObPartitionKey(combine_id(1001, 50001), 3, 8);
+  }
+  static void make_finish_arg(const int64_t part_cnt, ObLoadDataDirectFinishArg& arg)
+  {
+    arg.coordinator_.set_ip_addr("127.0.0.1", 2882);
+    arg.load_id_ = 1001;
+    arg.tenant_id_ = 1001;
+    for (int64_t i = 0; i < part_cnt; ++i) {
+      ASSERT_EQ(OB_SUCCESS, arg.pkeys_.push_back(ObPartitionKey(combine_id(1001, 50001), i, part_cnt)));
+    }
+  }
+  // a ctx as created by the first insert task of the partition, without the rows
+  static void add_ctx(ObLoadDataDirectMgr& mgr, const ObLoadDataDirectFinishArg& arg, const int64_t idx,
+      ObLoadDataDirectCtx*& ctx)
+  {
+    ctx = OB_NEW(ObLoadDataDirectCtx, ObModIds::OB_SQL_LOAD_DATA);
+    ASSERT_TRUE(NULL != ctx);
+    arg.get_key(idx, ctx->key_);
+    ctx->inc_ref();
+    ASSERT_EQ(OB_SUCCESS, mgr.ctx_map_.set_refactored(ctx->key_, ctx));
+  }
+};
+
+TEST_F(TestLoadDataDirect, finish_arg_serialize)
+{
+  const int64_t PART_CNT = 4;
+  char buf[1024];
+  for (int64_t phase = ObLoadDataDirectFinishArg::PREPARE; phase < ObLoadDataDirectFinishArg::MAX_PHASE; ++phase) {
+    ObLoadDataDirectFinishArg arg;
+    ObLoadDataDirectFinishArg des_arg;
+    int64_t pos = 0;
+    make_finish_arg(PART_CNT, arg);
+    ASSERT_FALSE(HasFatalFailure());
+    arg.phase_ = phase;
+    ASSERT_TRUE(arg.is_valid());
+    ASSERT_EQ(OB_SUCCESS, arg.serialize(buf, sizeof(buf), pos));
+    ASSERT_EQ(arg.get_serialize_size(), pos);
+    pos = 0;
+    ASSERT_EQ(OB_SUCCESS, des_arg.deserialize(buf, arg.get_serialize_size(), pos));
+    ASSERT_EQ(arg.coordinator_, des_arg.coordinator_);
+    ASSERT_EQ(arg.load_id_, des_arg.load_id_);
+    ASSERT_EQ(PART_CNT, des_arg.pkeys_.count());
+    for (int64_t i = 0; i < PART_CNT; ++i) {
+      ObLoadDataDirectKey key;
+      ObLoadDataDirectKey des_key;
+      arg.get_key(i, key);
+      des_arg.get_key(i, des_key);
+      ASSERT_TRUE(key == des_key);
+    }
+    ASSERT_EQ(arg.tenant_id_, des_arg.tenant_id_);
+    ASSERT_EQ(phase, des_arg.phase_);
+  }
+
+  ObLoadDataDirectFinishArg arg;
+  make_finish_arg(PART_CNT, arg);
+  ASSERT_FALSE(HasFatalFailure());
+  ASSERT_FALSE(arg.is_valid());  // phase must be given
+  arg.phase_ = ObLoadDataDirectFinishArg::ABORT;
+  ASSERT_TRUE(arg.is_valid());
+  arg.pkeys_.reset();
+  ASSERT_FALSE(arg.is_valid());  // so must the partitions
+}
+
+// the load fails before anything is published: publish keeps the ctxs, abort releases all of them
+// and may be repeated
+TEST_F(TestLoadDataDirect, abort_unpublished)
+{
+  const int64_t PART_CNT = 3;
+  ObLoadDataDirectMgr mgr;
+  ObLoadDataDirectFinishArg arg;
+  ObLoadDataDirectCtx* ctx = NULL;
+  int64_t row_count = 0;
+  ASSERT_EQ(OB_SUCCESS, mgr.init());
+  make_finish_arg(PART_CNT, arg);
+  ASSERT_FALSE(HasFatalFailure());
+  for (int64_t i = 0; i < PART_CNT; ++i) {
+    add_ctx(mgr, arg, i, ctx);
+    ASSERT_FALSE(HasFatalFailure());
+  }
+
+  arg.phase_ = ObLoadDataDirectFinishArg::PUBLISH;
+  ASSERT_EQ(OB_NOT_INIT, mgr.finish(arg, row_count));
+  ASSERT_EQ(PART_CNT, mgr.ctx_map_.size());
+  for (int64_t i = 0; i < PART_CNT; ++i) {
+    ObLoadDataDirectKey key;
+    arg.get_key(i, key);
+    ASSERT_EQ(OB_SUCCESS, mgr.get_ctx(key, ctx));
+    ASSERT_FALSE(ctx->is_published());
+    mgr.revert_ctx(ctx);
+  }
+
+  arg.phase_ = ObLoadDataDirectFinishArg::ABORT;
+  ASSERT_EQ(OB_SUCCESS, mgr.finish(arg, row_count));
+  ASSERT_EQ(0, mgr.ctx_map_.size());
+  ASSERT_EQ(OB_SUCCESS, mgr.finish(arg, row_count));
+
+  arg.phase_ = ObLoadDataDirectFinishArg::COMMIT;
+  ASSERT_EQ(OB_HASH_NOT_EXIST, mgr.finish(arg, row_count));
+}
+
+// the ctx of a partition may be gone already, e.g. expired, abort releases the others
+TEST_F(TestLoadDataDirect, abort_partial)
+{
+  const int64_t PART_CNT = 4;
+  ObLoadDataDirectMgr mgr;
+  ObLoadDataDirectFinishArg arg;
+  ObLoadDataDirectCtx* ctx = NULL;
+  int64_t row_count = 0;
+  ASSERT_EQ(OB_SUCCESS, mgr.init());
+  make_finish_arg(PART_CNT, arg);
+  ASSERT_FALSE(HasFatalFailure());
+  for (int64_t i = 0; i < PART_CNT; i += 2) {
+    add_ctx(mgr, arg, i, ctx);
+    ASSERT_FALSE(HasFatalFailure());
+  }
+  arg.phase_ = ObLoadDataDirectFinishArg::PREPARE;
+  ASSERT_EQ(OB_HASH_NOT_EXIST, mgr.finish(arg, row_count));
+  ASSERT_EQ(0, row_count);
+  ASSERT_EQ(PART_CNT / 2, mgr.ctx_map_.size());
+  arg.phase_ = ObLoadDataDirectFinishArg::ABORT;
+  ASSERT_EQ(OB_SUCCESS, mgr.finish(arg, row_count));
+  ASSERT_EQ(0, mgr.ctx_map_.size());
+}
+
+// a failed rollback of published partitions goes back to the coordinator, the ctxs are released anyway
+// and the partitions keep the loaded rows
+TEST_F(TestLoadDataDirect, abort_published)
+{
+  const int64_t PART_CNT = 2;
+  ObLoadDataDirectMgr mgr;
+  ObLoadDataDirectFinishArg arg;
+  ObLoadDataDirectCtx* ctx = NULL;
+  int64_t row_count = 0;
+  ASSERT_EQ(OB_SUCCESS, mgr.init());
+  make_finish_arg(PART_CNT, arg);
+  ASSERT_FALSE(HasFatalFailure());
+  for (int64_t i = 0; i < PART_CNT; ++i) {
+    add_ctx(mgr, arg, i, ctx);
+    ASSERT_FALSE(HasFatalFailure());
+    ctx->is_inited_ = true;
+    ctx->sstable_ctx_.is_published_ = true;
+  }
+  ASSERT_TRUE(NULL == GCTX.par_ser_);  // no storage in this test, rollback must fail
+
+  arg.phase_ = ObLoadDataDirectFinishArg::ABORT;
+  ASSERT_EQ(OB_ERR_UNEXPECTED, mgr.finish(arg, row_count));
+  ASSERT_EQ(0, mgr.ctx_map_.size());
+  ASSERT_EQ(OB_SUCCESS, mgr.finish(arg, row_count));
+}
+
+TEST_F(TestLoadDataDirect, check_arg_serialize)
+{
+  char buf[1024];
+  int64_t pos = 0;
+  ObLoadDataDirectCheckArg arg;
+  ObLoadDataDirectCheckArg des_arg;
+  ASSERT_FALSE(arg.is_valid());
+  arg.tenant_id_ = 1001;
+  arg.table_key_.table_type_ = ObITable::MAJOR_SSTABLE;
+  arg.table_key_.pkey_ = ObPartitionKey(combine_id(1001, 50001), 3, 8);
+  arg.table_key_.table_id_ = combine_id(1001, 50001);
+  arg.table_key_.version_ = ObVersion(2, 1);
+  arg.table_key_.trans_version_range_.multi_version_start_ = 100;
+  arg.table_key_.trans_version_range_.snapshot_version_ = 100;
+  arg.row_count_ = 10000;
+  ASSERT_TRUE(arg.is_valid());
+  ASSERT_EQ(OB_SUCCESS, arg.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(arg.get_serialize_size(), pos);
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, des_arg.deserialize(buf, arg.get_serialize_size(), pos));
+  ASSERT_EQ(arg.tenant_id_, des_arg.tenant_id_);
+  ASSERT_TRUE(arg.table_key_ == des_arg.table_key_);
+  ASSERT_EQ(arg.row_count_, des_arg.row_count_);
+
+  ObLoadDataDirectCheckResult result;
+  ObLoadDataDirectCheckResult des_result;
+  result.is_synced_ = true;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, result.serialize(buf, sizeof(buf), pos));
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, des_result.deserialize(buf, result.get_serialize_size(), pos));
+  ASSERT_TRUE(des_result.is_synced_);
+}
+
+// rows are sorted by rowkey only, rows with the same rowkey end up adjacent so that the macro block writer
+// reports them as duplicated
+TEST_F(TestLoadDataDirect, sort_by_rowkey)
+{
+  const int64_t ROW_CNT = 6;
+  const int64_t COL_CNT = 2;
+  const int64_t keys[ROW_CNT] = {5, 1, 3, 1, 4, 2};
+  ObObj cells[ROW_CNT][COL_CNT];
+  ObStoreRow rows[ROW_CNT];
+  ObStoreRow* sort_rows[ROW_CNT];
+  ObSEArray<int64_t, 1> sort_column_indexes;
+  int comp_ret = OB_SUCCESS;
+  ObStoreRowComparer comparer(comp_ret, sort_column_indexes);
+  ASSERT_EQ(OB_SUCCESS, sort_column_indexes.push_back(0));
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    cells[i][0].set_int(keys[i]);
+    cells[i][1].set_int(ROW_CNT - i);
+    rows[i].row_val_.cells_ = cells[i];
+    rows[i].row_val_.count_ = COL_CNT;
+    sort_rows[i] = &rows[i];
+  }
+  std::sort(sort_rows, sort_rows + ROW_CNT, comparer);
+  ASSERT_EQ(OB_SUCCESS, comp_ret);
+  int64_t dup_cnt = 0;
+  for (int64_t i = 1; i < ROW_CNT; ++i) {
+    const int cmp = sort_rows[i - 1]->row_val_.cells_[0].compare(sort_rows[i]->row_val_.cells_[0]);
+    ASSERT_LE(cmp, 0);
+    if (0 == cmp) {
+      ++dup_cnt;
+    }
+  }
+  ASSERT_EQ(1, dup_cnt);
+}
+
+}  // namespace sql
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  int ret = RUN_ALL_TESTS();
+  return ret;
+}
@@ -0,0 +1,685 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#define private public
+#define protected public
+
+#include "sql/ob_sql_init.h"
+#include "sql/engine/table/ob_table_scan_op.h"
+#include "sql/engine/aggregate/ob_hash_groupby_op.h"
+#include "sql/engine/aggregate/ob_scalar_aggregate_op.h"
+#include "sql/engine/join/ob_hash_join_op.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/ob_physical_plan_ctx.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "share/config/ob_server_config.h"
+#include "share/datum/ob_datum_funcs.h"
+#include "storage/blocksstable/ob_tmp_file.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
+
+namespace oceanbase {
+using namespace omt;
+namespace sql {
+using namespace common;
+
+class TestEnv : public ::testing::Environment {
+public:
+  virtual void SetUp() override
+  {
+    GCONF.enable_sql_operator_dump.set_value("False");
+    lib::ObMallocAllocator* malloc_allocator = lib::ObMallocAllocator::get_instance();
+    ASSERT_EQ(OB_SUCCESS, malloc_allocator->create_tenant_ctx_allocator(OB_SYS_TENANT_ID));
+    ASSERT_EQ(OB_SUCCESS, malloc_allocator->create_tenant_ctx_allocator(OB_SYS_TENANT_ID, ObCtxIds::WORK_AREA));
+    ASSERT_EQ(OB_SUCCESS, ObTenantConfigMgr::get_instance().add_tenant_config(OB_SYS_TENANT_ID));
+    // scalar aggregation allocates a temp file directory when opened, nothing is dumped here.
+    FILE_MANAGER_INSTANCE_V2.is_inited_ = true;
+  }
+
+  virtual void TearDown() override
+  {
+    FILE_MANAGER_INSTANCE_V2.is_inited_ = false;
+  }
+};
+
+#define CALL(func, ...) \
+  func(__VA_ARGS__);    \
+  ASSERT_FALSE(HasFatalFailure());
+
+struct TestRow {
+  TestRow(const int64_t key, const bool key_null, const int64_t val) : key_(key), key_null_(key_null), val_(val)
+  {}
+  int64_t key_;
+  bool key_null_;
+  int64_t val_;
+};
+
+// Projects (key, val, prefix + val) rows to storage output exprs. Datums point to buffers which
+// are overwritten by the next row, as the storage rows do.
+class TestRowIter : public ObNewRowIterator {
+public:
+  TestRowIter(ObEvalCtx& eval_ctx, const ObIArray<ObExpr*>& exprs, const std::vector<TestRow>& rows, const char* prefix)
+      : eval_ctx_(eval_ctx), exprs_(exprs), rows_(rows), prefix_(prefix), idx_(0), key_buf_(0), val_buf_(0)
+  {
+    str_buf_[0] = '\0';
+  }
+  virtual int get_next_row(ObNewRow*& row) override
+  {
+    UNUSED(row);
+    return OB_NOT_IMPLEMENT;
+  }
+  virtual int get_next_row() override
+  {
+    int ret = OB_SUCCESS;
+    if (idx_ >= static_cast<int64_t>(rows_.size())) {
+      ret = OB_ITER_END;
+    } else {
+      const TestRow& row = rows_.at(idx_++);
+      key_buf_ = row.key_;
+      val_buf_ = row.val_;
+      const int64_t len = snprintf(str_buf_, sizeof(str_buf_), "%s%ld", prefix_, row.val_);
+      ObDatum& key = exprs_.at(0)->locate_expr_datum(eval_ctx_);
+      if (row.key_null_) {
+        key.set_null();
+      } else {
+        key.set_string(reinterpret_cast<const char*>(&key_buf_), sizeof(key_buf_));
+      }
+      exprs_.at(1)->locate_expr_datum(eval_ctx_).set_string(reinterpret_cast<const char*>(&val_buf_), sizeof(val_buf_));
+      exprs_.at(2)->locate_expr_datum(eval_ctx_).set_string(str_buf_, len);
+    }
+    return ret;
+  }
+  virtual void reset() override
+  {
+    idx_ = 0;
+  }
+
+private:
+  ObEvalCtx& eval_ctx_;
+  const ObIArray<ObExpr*>& exprs_;
+  const std::vector<TestRow>& rows_;
+  const char* prefix_;
+  int64_t idx_;
+  int64_t key_buf_;
+  int64_t val_buf_;
+  char str_buf_[32];
+};
+
+// Table scan reads rows from TestRowIter instead of storage.
+class TestScanOp : public ObTableScanOp {
+public:
+  TestScanOp(ObExecContext& exec_ctx, const ObOpSpec& spec, const std::vector<TestRow>& rows, const char* prefix)
+      : ObTableScanOp(exec_ctx, spec, NULL),
+        iter_(eval_ctx_, static_cast<const ObTableScanSpec&>(spec).storage_output_, rows, prefix)
+  {}
+  virtual int inner_open() override
+  {
+    iter_.reset();
+    result_ = &iter_;
+    iter_end_ = false;
+    return OB_SUCCESS;
+  }
+  virtual int inner_close() override
+  {
+    result_ = NULL;
+    return OB_SUCCESS;
+  }
+
+private:
+  TestRowIter iter_;
+};
+
+static int eval_not_multiple_of_three(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& res)
+{
+  int ret = OB_SUCCESS;
+  ObDatum* val = NULL;
+  if (OB_FAIL(expr.args_[0]->eval(ctx, val))) {
+    LOG_WARN("expr evaluate failed", K(ret));
+  } else if (val->is_null()) {
+    res.set_null();
+  } else {
+    res.set_int(0 != val->get_int() % 3);
+  }
+  return ret;
+}
+
+static int eval_int_equal(const ObExpr& expr, ObEvalCtx& ctx, ObDatum& res)
+{
+  int ret = OB_SUCCESS;
+  ObDatum* left = NULL;
+  ObDatum* right = NULL;
+  if (OB_FAIL(expr.args_[0]->eval(ctx, left)) || OB_FAIL(expr.args_[1]->eval(ctx, right))) {
+    LOG_WARN("expr evaluate failed", K(ret));
+  } else if (left->is_null() || right->is_null()) {
+    res.set_null();
+  } else {
+    res.set_int(left->get_int() == right->get_int());
+  }
+  return ret;
+}
+
+// Compares the results of the row path with the batch path for each vectorized operator.
+class TestVectorizedExec : public ::testing::Test {
+public:
+  typedef std::vector<std::string> Rows;
+
+  enum {
+    KEY_EXPR = 0,
+    VAL_EXPR,
+    STR_EXPR,
+    FILTER_EXPR,
+    COUNT_EXPR,
+    MAX_EXPR,
+    R_KEY_EXPR,
+    R_VAL_EXPR,
+    R_STR_EXPR,
+    EQ_EXPR,
+    EXPR_CNT
+  };
+  static const int64_t MAX_BATCH_SIZE = 7;
+  static const int64_t EXPR_FRAME_SIZE = 256;
+  static const int64_t EVAL_INFO_OFF = 128;
+  static const int64_t RES_BUF_OFF = 160;
+
+  virtual void SetUp() override
+  {
+    static_assert(MAX_BATCH_SIZE * sizeof(ObDatum) <= EVAL_INFO_OFF, "datums overlap eval info");
+    static_assert(EVAL_INFO_OFF + sizeof(ObEvalInfo) <= RES_BUF_OFF, "eval info overlaps result buffer");
+    static_assert(RES_BUF_OFF + MAX_BATCH_SIZE * sizeof(int64_t) <= EXPR_FRAME_SIZE, "result buffer overflow");
+    init_expr(exprs_[KEY_EXPR], KEY_EXPR, T_REF_COLUMN, ObIntType);
+    init_expr(exprs_[VAL_EXPR], VAL_EXPR, T_REF_COLUMN, ObIntType);
+    init_expr(exprs_[STR_EXPR], STR_EXPR, T_REF_COLUMN, ObVarcharType);
+    init_expr(exprs_[FILTER_EXPR], FILTER_EXPR, T_OP_NE, ObIntType);
+    init_expr(exprs_[COUNT_EXPR], COUNT_EXPR, T_FUN_COUNT, ObIntType);
+    init_expr(exprs_[MAX_EXPR], MAX_EXPR, T_FUN_MAX, ObIntType);
+    init_expr(exprs_[R_KEY_EXPR], R_KEY_EXPR, T_REF_COLUMN, ObIntType);
+    init_expr(exprs_[R_VAL_EXPR], R_VAL_EXPR, T_REF_COLUMN, ObIntType);
+    init_expr(exprs_[R_STR_EXPR], R_STR_EXPR, T_REF_COLUMN, ObVarcharType);
+    init_expr(exprs_[EQ_EXPR], EQ_EXPR, T_OP_EQ, ObIntType);
+    filter_args_[0] = &exprs_[VAL_EXPR];
+    exprs_[FILTER_EXPR].args_ = filter_args_;
+    exprs_[FILTER_EXPR].arg_cnt_ = 1;
+    exprs_[FILTER_EXPR].eval_func_ = eval_not_multiple_of_three;
+    eq_args_[0] = &exprs_[KEY_EXPR];
+    eq_args_[1] = &exprs_[R_KEY_EXPR];
+    exprs_[EQ_EXPR].args_ = eq_args_;
+    exprs_[EQ_EXPR].arg_cnt_ = 2;
+    exprs_[EQ_EXPR].eval_func_ = eval_int_equal;
+  }
+
+  void init_expr(ObExpr& expr, const int64_t idx, const ObExprOperatorType type, const ObObjType obj_type)
+  {
+    expr.reset();
+    expr.type_ = type;
+    expr.datum_meta_.type_ = obj_type;
+    expr.frame_idx_ = 0;
+    expr.datum_off_ = static_cast<uint32_t>(idx * EXPR_FRAME_SIZE);
+    expr.eval_info_off_ = static_cast<uint32_t>(expr.datum_off_ + EVAL_INFO_OFF);
+    expr.res_buf_off_ = static_cast<uint32_t>(expr.datum_off_ + RES_BUF_OFF);
+    if (ObIntType == obj_type) {
+      expr.datum_meta_.cs_type_ = CS_TYPE_BINARY;
+      expr.obj_meta_.set_int();
+      expr.obj_datum_map_ = OBJ_DATUM_8BYTE_DATA;
+      expr.res_buf_len_ = sizeof(int64_t);
+    } else {
+      // string datums always point to memory outside the frame
+      expr.datum_meta_.cs_type_ = CS_TYPE_UTF8MB4_BIN;
+      expr.obj_meta_.set_varchar();
+      expr.obj_meta_.set_collation_type(CS_TYPE_UTF8MB4_BIN);
+      expr.obj_datum_map_ = OBJ_DATUM_STRING;
+      expr.res_buf_len_ = 0;
+    }
+    expr.basic_funcs_ = ObDatumFuncs::get_basic_func(obj_type, expr.datum_meta_.cs_type_);
+  }
+
+  // Expressions of batch plan locate datums by batch index, as generated by CG.
+  void set_batch_size(const int64_t batch_size)
+  {
+    for (int64_t i = 0; i < EXPR_CNT; i++) {
+      exprs_[i].batch_idx_mask_ = batch_size > 0 ? UINT64_MAX : 0;
+      exprs_[i].res_buf_stride_ = batch_size > 0 ? exprs_[i].res_buf_len_ : 0;
+    }
+  }
+
+  void init_exec_ctx(ObSQLSessionInfo& session, ObExecContext& ctx)
+  {
+    memset(frame_, 0, sizeof(frame_));
+    frames_[0] = frame_;
+    ASSERT_EQ(OB_SUCCESS, session.test_init(0, 0, 0, NULL));
+    ASSERT_EQ(OB_SUCCESS, share::ObPreProcessSysVars::init_sys_var());
+    ASSERT_EQ(OB_SUCCESS, session.load_default_sys_variable(false, true));
+    ASSERT_EQ(OB_SUCCESS, session.init_tenant("sys", OB_SYS_TENANT_ID));
+    ctx.set_my_session(&session);
+    ASSERT_EQ(OB_SUCCESS, ctx.create_physical_plan_ctx());
+    ctx.get_physical_plan_ctx()->set_timeout_timestamp(ObTimeUtility::current_time() + 600L * 1000 * 1000);
+    ctx.set_frames(frames_);
+    ctx.set_frame_cnt(1);
+    ASSERT_EQ(OB_SUCCESS, ctx.init_eval_ctx());
+  }
+
+  void init_exprs(ExprFixedArray& array, const std::vector<ObExpr*>& exprs)
+  {
+    ASSERT_EQ(OB_SUCCESS, array.init(exprs.size()));
+    for (int64_t i = 0; i < static_cast<int64_t>(exprs.size()); i++) {
+      ASSERT_EQ(OB_SUCCESS, array.push_back(exprs.at(i)));
+    }
+  }
+
+  // select key, val, str from t [where val % 3 != 0]
+  void build_scan_spec(ObTableScanSpec& spec, const int64_t id, ObExpr* columns[3], const bool with_filter,
+      const int64_t rows, const int64_t batch_size)
+  {
+    std::vector<ObExpr*> outputs(columns, columns + 3);
+    spec.id_ = id;
+    spec.rows_ = rows;
+    spec.width_ = 2 * sizeof(int64_t) + 16;
+    spec.max_batch_size_ = batch_size;
+    CALL(init_exprs, spec.output_, outputs);
+    CALL(init_exprs, spec.storage_output_, outputs);
+    if (with_filter) {
+      std::vector<ObExpr*> filters(1, &exprs_[FILTER_EXPR]);
+      CALL(init_exprs, spec.filters_, filters);
+      CALL(init_exprs, spec.calc_exprs_, filters);
+    }
+  }
+
+  // count(*), max(val)
+  void build_aggr_infos(ObGroupBySpec& spec)
+  {
+    ASSERT_EQ(OB_SUCCESS, spec.aggr_infos_.prepare_allocate(2));
+    ObAggrInfo& count_info = spec.aggr_infos_.at(0);
+    count_info.set_allocator(&alloc_);
+    count_info.expr_ = &exprs_[COUNT_EXPR];
+    ObAggrInfo& max_info = spec.aggr_infos_.at(1);
+    max_info.set_allocator(&alloc_);
+    max_info.expr_ = &exprs_[MAX_EXPR];
+    ASSERT_EQ(OB_SUCCESS, max_info.param_exprs_.init(1));
+    ASSERT_EQ(OB_SUCCESS, max_info.param_exprs_.push_back(&exprs_[VAL_EXPR]));
+  }
+
+  static void format_row(ObEvalCtx& eval_ctx, const std::vector<ObExpr*>& exprs, Rows& rows)
+  {
+    std::string row;
+    for (int64_t i = 0; i < static_cast<int64_t>(exprs.size()); i++) {
+      const ObExpr* expr = exprs.at(i);
+      const ObDatum& datum = expr->locate_expr_datum(eval_ctx);
+      if (i > 0) {
+        row.append("|");
+      }
+      if (datum.is_null()) {
+        row.append("NULL");
+      } else if (ObIntType == expr->datum_meta_.type_) {
+        row.append(std::to_string(datum.get_int()));
+      } else {
+        row.append(datum.ptr_, datum.len_);
+      }
+    }
+    rows.push_back(row);
+  }
+
+  // Collect the output rows by get_next_batch() in batch mode, by get_next_row() in row mode.
+  void collect(ObOperator& op, const std::vector<ObExpr*>& exprs, Rows& rows)
+  {
+    ObEvalCtx& eval_ctx = op.eval_ctx_;
+    int ret = OB_SUCCESS;
+    ASSERT_EQ(OB_SUCCESS, op.open());
+    if (!op.get_spec().is_vectorized()) {
+      while (OB_SUCC(op.get_next_row())) {
+        format_row(eval_ctx, exprs, rows);
+      }
+      ASSERT_EQ(OB_ITER_END, ret);
+    } else {
+      const int64_t batch_size = op.get_spec().max_batch_size_;
+      const ObBatchRows* brs = NULL;
+      int64_t batch_cnt = 0;
+      do {
+        ASSERT_EQ(OB_SUCCESS, op.get_next_batch(batch_size, brs));
+        ASSERT_LE(brs->size_, batch_size);
+        ++batch_cnt;
+        ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx);
+        batch_info_guard.set_batch_size(brs->size_);
+        for (int64_t i = 0; i < brs->size_; i++) {
+          if (!brs->skip_->at(i)) {
+            batch_info_guard.set_batch_idx(i);
+            format_row(eval_ctx, exprs, rows);
+          }
+        }
+      } while (!brs->end_);
+      ASSERT_LE(static_cast<int64_t>(rows.size()), batch_cnt * batch_size);
+    }
+    ASSERT_EQ(OB_SUCCESS, op.close());
+  }
+
+  void run_scan(const std::vector<TestRow>& rows, const int64_t batch_size, Rows& result)
+  {
+    ObSQLSessionInfo session;
+    ObExecContext ctx;
+    CALL(set_batch_size, batch_size);
+    CALL(init_exec_ctx, session, ctx);
+    ObExpr* columns[3] = {&exprs_[KEY_EXPR], &exprs_[VAL_EXPR], &exprs_[STR_EXPR]};
+    ObTableScanSpec spec(alloc_, PHY_TABLE_SCAN);
+    CALL(build_scan_spec, spec, 0, columns, true, rows.size(), batch_size);
+    void* buf = alloc_.alloc(sizeof(TestScanOp));
+    ASSERT_TRUE(NULL != buf);
+    TestScanOp* op = new (buf) TestScanOp(ctx, spec, rows, "s");
+    CALL(collect, *op, std::vector<ObExpr*>(columns, columns + 3), result);
+    op->destroy();
+  }
+
+  // select key, count(*), max(val) from t where val % 3 != 0 group by key
+  void run_hash_group_by(const std::vector<TestRow>& rows, const int64_t batch_size, Rows& result)
+  {
+    ObSQLSessionInfo session;
+    ObExecContext ctx;
+    CALL(set_batch_size, batch_size);
+    CALL(init_exec_ctx, session, ctx);
+    ObExpr* columns[3] = {&exprs_[KEY_EXPR], &exprs_[VAL_EXPR], &exprs_[STR_EXPR]};
+    ObTableScanSpec scan_spec(alloc_, PHY_TABLE_SCAN);
+    CALL(build_scan_spec, scan_spec, 0, columns, true, rows.size(), batch_size);
+
+    ObCmpFunc cmp_func;
+    cmp_func.cmp_func_ =
+        ObDatumFuncs::get_nullsafe_cmp_func(ObIntType, ObIntType, NULL_FIRST, CS_TYPE_BINARY, false /* oracle */);
+    ObHashGroupBySpec spec(alloc_, PHY_HASH_GROUP_BY);
+    ObOpSpec* child_specs[1] = {&scan_spec};
+    ASSERT_EQ(OB_SUCCESS, spec.set_children_pointer(child_specs, 1));
+    spec.id_ = 1;
+    spec.width_ = 3 * sizeof(int64_t);
+    spec.max_batch_size_ = batch_size;
+    ASSERT_EQ(OB_SUCCESS, spec.group_exprs_.init(1));
+    ASSERT_EQ(OB_SUCCESS, spec.add_group_expr(&exprs_[KEY_EXPR]));
+    ASSERT_EQ(OB_SUCCESS, spec.cmp_funcs_.init(1));
+    ASSERT_EQ(OB_SUCCESS, spec.cmp_funcs_.push_back(cmp_func));
+    CALL(build_aggr_infos, spec);
+    spec.set_est_group_cnt(rows.size());
+    std::vector<ObExpr*> outputs;
+    outputs.push_back(&exprs_[KEY_EXPR]);
+    outputs.push_back(&exprs_[COUNT_EXPR]);
+    outputs.push_back(&exprs_[MAX_EXPR]);
+    CALL(init_exprs, spec.output_, outputs);
+
+    void* scan_buf = alloc_.alloc(sizeof(TestScanOp));
+    void* op_buf = alloc_.alloc(sizeof(ObHashGroupByOp));
+    ASSERT_TRUE(NULL != scan_buf && NULL != op_buf);
+    TestScanOp* scan = new (scan_buf) TestScanOp(ctx, scan_spec, rows, "s");
+    ObHashGroupByOp* op = new (op_buf) ObHashGroupByOp(ctx, spec, NULL);
+    ObOperator* children[1] = {scan};
+    ASSERT_EQ(OB_SUCCESS, op->set_children_pointer(children, 1));
+    scan->parent_ = op;
+    CALL(collect, *op, outputs, result);
+    op->destroy();
+    scan->destroy();
+  }
+
+  // select count(*), max(val) from t where val % 3 != 0
+  void run_scalar_aggregate(const std::vector<TestRow>& rows, const int64_t batch_size, Rows& result)
+  {
+    ObSQLSessionInfo session;
+    ObExecContext ctx;
+    CALL(set_batch_size, batch_size);
+    CALL(init_exec_ctx, session, ctx);
+    ObExpr* columns[3] = {&exprs_[KEY_EXPR], &exprs_[VAL_EXPR], &exprs_[STR_EXPR]};
+    ObTableScanSpec scan_spec(alloc_, PHY_TABLE_SCAN);
+    CALL(build_scan_spec, scan_spec, 0, columns, true, rows.size(), batch_size);
+
+    ObScalarAggregateSpec spec(alloc_, PHY_SCALAR_AGGREGATE);
+    ObOpSpec* child_specs[1] = {&scan_spec};
+    ASSERT_EQ(OB_SUCCESS, spec.set_children_pointer(child_specs, 1));
+    spec.id_ = 1;
+    spec.width_ = 2 * sizeof(int64_t);
+    spec.max_batch_size_ = batch_size;
+    CALL(build_aggr_infos, spec);
+    std::vector<ObExpr*> outputs;
+    outputs.push_back(&exprs_[COUNT_EXPR]);
+    outputs.push_back(&exprs_[MAX_EXPR]);
+    CALL(init_exprs, spec.output_, outputs);
+
+    void* scan_buf = alloc_.alloc(sizeof(TestScanOp));
+    void* op_buf = alloc_.alloc(sizeof(ObScalarAggregateOp));
+    ASSERT_TRUE(NULL != scan_buf && NULL != op_buf);
+    TestScanOp* scan = new (scan_buf) TestScanOp(ctx, scan_spec, rows, "s");
+    ObScalarAggregateOp* op = new (op_buf) ObScalarAggregateOp(ctx, spec, NULL);
+    ObOperator* children[1] = {scan};
+    ASSERT_EQ(OB_SUCCESS, op->set_children_pointer(children, 1));
+    scan->parent_ = op;
+    CALL(collect, *op, outputs, result);
+    op->destroy();
+    scan->destroy();
+  }
+
+  // select l.key, l.str, r.key, r.str from l [left] join r on l.key = r.key
+  // The children are executed row by row below hash join, see
+  // ObStaticEngineCG::disable_batch_below_hash_join().
+  void run_hash_join(const std::vector<TestRow>& left_rows, const std::vector<TestRow>& right_rows,
+      const ObJoinType join_type, const int64_t batch_size, Rows& result)
+  {
+    ObSQLSessionInfo session;
+    ObExecContext ctx;
+    CALL(set_batch_size, batch_size);
+    CALL(init_exec_ctx, session, ctx);
+    ObExpr* left_columns[3] = {&exprs_[KEY_EXPR], &exprs_[VAL_EXPR], &exprs_[STR_EXPR]};
+    ObExpr* right_columns[3] = {&exprs_[R_KEY_EXPR], &exprs_[R_VAL_EXPR], &exprs_[R_STR_EXPR]};
+    ObTableScanSpec left_spec(alloc_, PHY_TABLE_SCAN);
+    ObTableScanSpec right_spec(alloc_, PHY_TABLE_SCAN);
+    CALL(build_scan_spec, left_spec, 1, left_columns, false, left_rows.size(), 0);
+    CALL(build_scan_spec, right_spec, 2, right_columns, false, right_rows.size(), 0);
+
+    ObHashFunc hash_func;
+    hash_func.hash_func_ = exprs_[KEY_EXPR].basic_funcs_->murmur_hash_;
+    ObHashJoinSpec spec(alloc_, PHY_HASH_JOIN);
+    ObOpSpec* child_specs[2] = {&left_spec, &right_spec};
+    ASSERT_EQ(OB_SUCCESS, spec.set_children_pointer(child_specs, 2));
+    spec.id_ = 0;
+    spec.width_ = 2 * sizeof(int64_t) + 32;
+    spec.max_batch_size_ = batch_size;
+    spec.join_type_ = join_type;
+    std::vector<ObExpr*> conds(1, &exprs_[EQ_EXPR]);
+    CALL(init_exprs, spec.equal_join_conds_, conds);
+    CALL(init_exprs, spec.calc_exprs_, conds);
+    std::vector<ObExpr*> keys;
+    keys.push_back(&exprs_[KEY_EXPR]);
+    keys.push_back(&exprs_[R_KEY_EXPR]);
+    CALL(init_exprs, spec.all_join_keys_, keys);
+    ASSERT_EQ(OB_SUCCESS, spec.all_hash_funcs_.init(2));
+    ASSERT_EQ(OB_SUCCESS, spec.all_hash_funcs_.push_back(hash_func));
+    ASSERT_EQ(OB_SUCCESS, spec.all_hash_funcs_.push_back(hash_func));
+    std::vector<ObExpr*> outputs;
+    outputs.push_back(&exprs_[KEY_EXPR]);
+    outputs.push_back(&exprs_[STR_EXPR]);
+    outputs.push_back(&exprs_[R_KEY_EXPR]);
+    outputs.push_back(&exprs_[R_STR_EXPR]);
+    CALL(init_exprs, spec.output_, outputs);
+
+    void* left_buf = alloc_.alloc(sizeof(TestScanOp));
+    void* right_buf = alloc_.alloc(sizeof(TestScanOp));
+    void* op_buf = alloc_.alloc(sizeof(ObHashJoinOp));
+    ASSERT_TRUE(NULL != left_buf && NULL != right_buf && NULL != op_buf);
+    TestScanOp* left = new (left_buf) TestScanOp(ctx, left_spec, left_rows, "l");
+    TestScanOp* right = new (right_buf) TestScanOp(ctx, right_spec, right_rows, "r");
+    ObHashJoinOp* op = new (op_buf) ObHashJoinOp(ctx, spec, NULL);
+    ObOperator* children[2] = {left, right};
+    ASSERT_EQ(OB_SUCCESS, op->set_children_pointer(children, 2));
+    left->parent_ = op;
+    right->parent_ = op;
+    CALL(collect, *op, outputs, result);
+    op->destroy();
+    left->destroy();
+    right->destroy();
+  }
+
+  static std::string key_str(const TestRow& row)
+  {
+    return row.key_null_ ? std::string("NULL") : std::to_string(row.key_);
+  }
+
+protected:
+  ObArenaAllocator alloc_;
+  ObExpr exprs_[EXPR_CNT];
+  ObExpr* filter_args_[1];
+  ObExpr* eq_args_[2];
+  char* frames_[1];
+  char frame_[EXPR_CNT * EXPR_FRAME_SIZE];
+};
+
+static void gen_rows(const int64_t cnt, const int64_t key_ndv, const int64_t key_offset, const int64_t null_step,
+    std::vector<TestRow>& rows)
+{
+  for (int64_t i = 0; i < cnt; i++) {
+    rows.push_back(TestRow(i % key_ndv + key_offset, 0 == i % null_step, i));
+  }
+}
+
+TEST_F(TestVectorizedExec, table_scan)
+{
+  std::vector<TestRow> rows;
+  gen_rows(1000, 13, 0, 17, rows);
+  Rows expected;
+  for (int64_t i = 0; i < static_cast<int64_t>(rows.size()); i++) {
+    const TestRow& row = rows.at(i);
+    if (0 != row.val_ % 3) {
+      expected.push_back(key_str(row) + "|" + std::to_string(row.val_) + "|s" + std::to_string(row.val_));
+    }
+  }
+
+  Rows row_result;
+  CALL(run_scan, rows, 0, row_result);
+  ASSERT_TRUE(expected == row_result);
+  // storage datums are overwritten by the next row, batch rows must be deep copied.
+  for (int64_t batch_size = 1; batch_size <= MAX_BATCH_SIZE; batch_size += MAX_BATCH_SIZE - 1) {
+    Rows batch_result;
+    CALL(run_scan, rows, batch_size, batch_result);
+    ASSERT_TRUE(row_result == batch_result);
+  }
+}
+
+TEST_F(TestVectorizedExec, hash_group_by)
+{
+  std::vector<TestRow> rows;
+  gen_rows(1000, 13, 0, 17, rows);
+  // key -> (count(*), max(val))
+  std::map<std::string, std::pair<int64_t, int64_t>> groups;
+  for (int64_t i = 0; i < static_cast<int64_t>(rows.size()); i++) {
+    const TestRow& row = rows.at(i);
+    if (0 != row.val_ % 3) {
+      std::pair<int64_t, int64_t>& group = groups[key_str(row)];
+      group.first += 1;
+      group.second = row.val_;
+    }
+  }
+  Rows expected;
+  for (auto iter = groups.begin(); iter != groups.end(); ++iter) {
+    expected.push_back(
+        iter->first + "|" + std::to_string(iter->second.first) + "|" + std::to_string(iter->second.second));
+  }
+
+  Rows row_result;
+  CALL(run_hash_group_by, rows, 0, row_result);
+  std::sort(row_result.begin(), row_result.end());
+  ASSERT_TRUE(expected == row_result);
+  for (int64_t batch_size = 1; batch_size <= MAX_BATCH_SIZE; batch_size += MAX_BATCH_SIZE - 1) {
+    Rows batch_result;
+    CALL(run_hash_group_by, rows, batch_size, batch_result);
+    std::sort(batch_result.begin(), batch_result.end());
+    ASSERT_TRUE(row_result == batch_result);
+  }
+}
+
+TEST_F(TestVectorizedExec, scalar_aggregate)
+{
+  std::vector<TestRow> rows;
+  gen_rows(1000, 13, 0, 17, rows);
+  Rows row_result;
+  CALL(run_scalar_aggregate, rows, 0, row_result);
+  ASSERT_EQ(1, static_cast<int64_t>(row_result.size()));
+  ASSERT_EQ("666|998", row_result.at(0));
+  for (int64_t batch_size = 1; batch_size <= MAX_BATCH_SIZE; batch_size += MAX_BATCH_SIZE - 1) {
+    Rows batch_result;
+    CALL(run_scalar_aggregate, rows, batch_size, batch_result);
+    ASSERT_TRUE(row_result == batch_result);
+  }
+
+  // empty set, all rows are filtered
+  std::vector<TestRow> filtered_rows;
+  filtered_rows.push_back(TestRow(0, false, 3));
+  filtered_rows.push_back(TestRow(1, false, 6));
+  Rows empty_row_result;
+  CALL(run_scalar_aggregate, filtered_rows, 0, empty_row_result);
+  ASSERT_EQ(1, static_cast<int64_t>(empty_row_result.size()));
+  ASSERT_EQ("0|NULL", empty_row_result.at(0));
+  Rows empty_batch_result;
+  CALL(run_scalar_aggregate, filtered_rows, MAX_BATCH_SIZE, empty_batch_result);
+  ASSERT_TRUE(empty_row_result == empty_batch_result);
+}
+
+TEST_F(TestVectorizedExec, hash_join)
+{
+  // every left key has 12 rows, the matched rows of one probe row span batches.
+  std::vector<TestRow> left_rows;
+  std::vector<TestRow> right_rows;
+  gen_rows(600, 50, 0, 37, left_rows);
+  gen_rows(200, 70, 10, 23, right_rows);
+
+  const ObJoinType join_types[] = {INNER_JOIN, LEFT_OUTER_JOIN};
+  for (int64_t t = 0; t < ARRAYSIZEOF(join_types); t++) {
+    Rows expected;
+    for (int64_t i = 0; i < static_cast<int64_t>(left_rows.size()); i++) {
+      const TestRow& l = left_rows.at(i);
+      const std::string left_str = key_str(l) + "|l" + std::to_string(l.val_) + "|";
+      bool matched = false;
+      for (int64_t j = 0; j < static_cast<int64_t>(right_rows.size()); j++) {
+        const TestRow& r = right_rows.at(j);
+        if (!l.key_null_ && !r.key_null_ && l.key_ == r.key_) {
+          matched = true;
+          expected.push_back(left_str + key_str(r) + "|r" + std::to_string(r.val_));
+        }
+      }
+      if (!matched && LEFT_OUTER_JOIN == join_types[t]) {
+        expected.push_back(left_str + "NULL|NULL");
+      }
+    }
+    std::sort(expected.begin(), expected.end());
+
+    Rows row_result;
+    CALL(run_hash_join, left_rows, right_rows, join_types[t], 0, row_result);
+    std::sort(row_result.begin(), row_result.end());
+    ASSERT_TRUE(expected == row_result);
+    for (int64_t batch_size = 1; batch_size <= MAX_BATCH_SIZE; batch_size += MAX_BATCH_SIZE - 1) {
+      Rows batch_result;
+      CALL(run_hash_join, left_rows, right_rows, join_types[t], batch_size, batch_result);
+      std::sort(batch_result.begin(), batch_result.end());
+      ASSERT_TRUE(row_result == batch_result);
+    }
+  }
+}
+
+}  // end namespace sql
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::sql::init_sql_factories();
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  oceanbase::common::ObClockGenerator::init();
+  testing::InitGoogleTest(&argc, argv);
+  auto* env = new (oceanbase::sql::TestEnv);
+  testing::AddGlobalTestEnvironment(env);
+  int ret = RUN_ALL_TESTS();
+  OB_LOGGER.disable();
+  return ret;
+}
@@ -0,0 +1,161 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_PC
+#include <gtest/gtest.h>
+#define private public
+#include "sql/plan_cache/ob_plan_cache.h"
+#include "sql/plan_cache/ob_plan_cache_callback.h"
+#include "sql/plan_cache/ob_ps_pcv_set_cache.h"
+#undef private
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+namespace test {
+
+class TestPsPCVSetCache : public ::testing::Test {
+public:
+  TestPsPCVSetCache() : plan_cache_(NULL)
+  {}
+  virtual void SetUp()
+  {
+    plan_cache_ = new ObPlanCache();
+    ASSERT_EQ(OB_SUCCESS, plan_cache_->init(1024, ObAddr(), NULL, OB_SYS_TENANT_ID));
+  }
+  virtual void TearDown()
+  {
+    delete plan_cache_;
+    plan_cache_ = NULL;
+  }
+
+protected:
+  // insert a pcv set into plan cache the way add_cache_obj does, without any plan
+  void add_pcv_set(const ObPlanCacheKey& key, ObPCVSet*& pcv_set);
+
+  ObPlanCache* plan_cache_;
+};
+
+void TestPsPCVSetCache::add_pcv_set(const ObPlanCacheKey& key, ObPCVSet*& pcv_set)
+{
+  void* ptr = plan_cache_->get_pc_allocator_ref().alloc(sizeof(ObPCVSet));
+  ASSERT_TRUE(NULL != ptr);
+  pcv_set = new (ptr) ObPCVSet(plan_cache_);
+  pcv_set->set_id(ATOMIC_AAF(&plan_cache_->pcv_set_id_, 1));
+  pcv_set->pc_key_ = key;
+  pcv_set->inc_ref_count(PCV_SET_HANDLE);
+  plan_cache_->add_pcv_set_id(*pcv_set);
+  ASSERT_EQ(OB_SUCCESS, plan_cache_->sql_pcvs_map_.set_refactored(key, pcv_set));
+}
+
+TEST_F(TestPsPCVSetCache, put_get_remove)
+{
+  ObPsPCVSetCache cache;
+  const ObPlanCache* other = reinterpret_cast<const ObPlanCache*>(&cache);
+  ASSERT_EQ(0, cache.count());
+  ASSERT_EQ(OB_INVALID_ID, cache.get(1, plan_cache_));
+
+  cache.put(1, plan_cache_, 100);
+  cache.put(2, plan_cache_, 200);
+  ASSERT_EQ(2, cache.count());
+  ASSERT_EQ(100UL, cache.get(1, plan_cache_));
+  ASSERT_EQ(200UL, cache.get(2, plan_cache_));
+  // entries are bound to the plan cache they are added for
+  ASSERT_EQ(OB_INVALID_ID, cache.get(1, other));
+
+  // invalid arguments are ignored
+  cache.put(3, plan_cache_, OB_INVALID_ID);
+  cache.put(3, NULL, 300);
+  ASSERT_EQ(2, cache.count());
+  ASSERT_EQ(OB_INVALID_ID, cache.get(3, plan_cache_));
+
+  // overwrite the same stmt
+  cache.put(1, plan_cache_, 101);
+  ASSERT_EQ(2, cache.count());
+  ASSERT_EQ(101UL, cache.get(1, plan_cache_));
+
+  // a stmt mapped to the same slot evicts the old one
+  const ObPsStmtId conflict_id = 1 + ObPsPCVSetCache::MAX_ENTRY_COUNT;
+  cache.put(conflict_id, plan_cache_, 102);
+  ASSERT_EQ(2, cache.count());
+  ASSERT_EQ(OB_INVALID_ID, cache.get(1, plan_cache_));
+  ASSERT_EQ(102UL, cache.get(conflict_id, plan_cache_));
+
+  // removing a stmt not in its slot keeps the slot
+  cache.remove(1);
+  ASSERT_EQ(102UL, cache.get(conflict_id, plan_cache_));
+  cache.remove(conflict_id);
+  ASSERT_EQ(OB_INVALID_ID, cache.get(conflict_id, plan_cache_));
+  ASSERT_EQ(1, cache.count());
+
+  cache.reset();
+  ASSERT_EQ(0, cache.count());
+  ASSERT_EQ(OB_INVALID_ID, cache.get(2, plan_cache_));
+}
+
+TEST_F(TestPsPCVSetCache, invalidate_by_id)
+{
+  ObPlanCacheKey key1(ObString::make_string("select ?"), 1, 1, 0, true, ObString(), NS_CRSR);
+  ObPlanCacheKey key2(ObString::make_string("select ?, ?"), 2, 1, 0, true, ObString(), NS_CRSR);
+  ObPCVSet* pcv_set1 = NULL;
+  ObPCVSet* pcv_set2 = NULL;
+  add_pcv_set(key1, pcv_set1);
+  ASSERT_FALSE(HasFatalFailure());
+  add_pcv_set(key2, pcv_set2);
+  ASSERT_FALSE(HasFatalFailure());
+  const uint64_t id1 = pcv_set1->get_id();
+  const uint64_t id2 = pcv_set2->get_id();
+  ASSERT_NE(id1, id2);
+
+  // lookup by id takes a reference and the read lock
+  ObPCVSet* pcv_set = NULL;
+  {
+    ObPlanCacheRlockAndRef r_ref_lock(PS_PCV_SET_HANDLE);
+    ASSERT_EQ(OB_SUCCESS, plan_cache_->get_value_by_id(id1, pcv_set, r_ref_lock));
+    ASSERT_EQ(pcv_set1, pcv_set);
+    ASSERT_EQ(2, pcv_set->get_ref_count());
+    pcv_set->unlock();
+    pcv_set->dec_ref_count(PS_PCV_SET_HANDLE);
+  }
+
+  // removing one pcv set only invalidates its own id, and the pcv set is freed at once
+  ASSERT_EQ(1, pcv_set1->get_ref_count());
+  ASSERT_EQ(OB_SUCCESS, plan_cache_->remove_pcv_set(key1));
+  {
+    ObPlanCacheRlockAndRef r_ref_lock(PS_PCV_SET_HANDLE);
+    ASSERT_EQ(OB_SUCCESS, plan_cache_->get_value_by_id(id1, pcv_set, r_ref_lock));
+    ASSERT_TRUE(NULL == pcv_set);
+  }
+  {
+    ObPlanCacheRlockAndRef r_ref_lock(PS_PCV_SET_HANDLE);
+    ASSERT_EQ(OB_SUCCESS, plan_cache_->get_value_by_id(id2, pcv_set, r_ref_lock));
+    ASSERT_EQ(pcv_set2, pcv_set);
+    pcv_set->unlock();
+    pcv_set->dec_ref_count(PS_PCV_SET_HANDLE);
+  }
+
+  // a new pcv set under the same key never reuses the id
+  add_pcv_set(key1, pcv_set1);
+  ASSERT_FALSE(HasFatalFailure());
+  ASSERT_LT(id2, pcv_set1->get_id());
+  ASSERT_EQ(OB_SUCCESS, plan_cache_->remove_pcv_set(key1));
+  ASSERT_EQ(OB_SUCCESS, plan_cache_->remove_pcv_set(key2));
+  ASSERT_EQ(0, plan_cache_->pcv_set_id_map_.size());
+}
+
+}  // namespace test
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,237 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+#include "storage/blocksstable/ob_micro_block_encoder.h"
+#include "storage/blocksstable/ob_micro_block_decoder.h"
+#include "storage/blocksstable/ob_micro_block_writer.h"
+#include "storage/blocksstable/ob_column_map.h"
+#include "storage/ob_i_store.h"
+#include "common/rowkey/ob_rowkey.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace blocksstable;
+using namespace storage;
+using namespace share::schema;
+
+namespace unittest {
+class TestMicroBlockEncoder : public ::testing::Test {
+public:
+  static const int64_t rowkey_column_count = 2;
+  static const int64_t column_num = 6;
+  static const int64_t test_row_num = 300;
+  static const int64_t micro_block_size_limit = 2L * 1024 * 1024L;
+
+public:
+  TestMicroBlockEncoder() : allocator_(ObModIds::TEST)
+  {}
+  void SetUp();
+  virtual void TearDown()
+  {}
+  void gen_row(const int64_t seed, ObStoreRow& row);
+  void reset_row()
+  {
+    row_.row_val_.cells_ = reinterpret_cast<ObObj*>(obj_buf_);
+    row_.row_val_.count_ = OB_ROW_MAX_COLUMNS_COUNT;
+    row_.capacity_ = OB_ROW_MAX_COLUMNS_COUNT;
+  }
+
+protected:
+  ObObjMeta types_[column_num];
+  ObColumnMap column_map_;
+  ObArenaAllocator allocator_;
+  ObStoreRow row_;
+  char obj_buf_[common::OB_ROW_MAX_COLUMNS_COUNT * sizeof(ObObj)];
+  char str_buf_[test_row_num][2][64];
+};
+
+void TestMicroBlockEncoder::SetUp()
+{
+  ObArray<ObColDesc> columns;
+  ObColDesc col_desc;
+  for (int64_t i = 0; i < column_num; ++i) {
+    if (1 == i || 4 == i) {
+      types_[i].set_varchar();
+      types_[i].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+    } else if (5 == i) {
+      types_[i].set_datetime();
+    } else {
+      types_[i].set_int();
+    }
+    col_desc.col_id_ = i + OB_APP_MIN_COLUMN_ID;
+    col_desc.col_type_ = types_[i];
+    col_desc.col_order_ = ObOrderType::ASC;
+    ASSERT_EQ(OB_SUCCESS, columns.push_back(col_desc));
+    ASSERT_TRUE(ObMicroBlockEncoder::is_column_type_supported(types_[i]));
+  }
+  ASSERT_EQ(OB_SUCCESS, column_map_.init(allocator_, 1, rowkey_column_count, column_num, columns));
+}
+
+// c0: increasing int rowkey, c1: varchar rowkey with long common prefix, c2: constant,
+// c3: low cardinality, c4: nullable varchar, c5: datetime with small deltas
+void TestMicroBlockEncoder::gen_row(const int64_t seed, ObStoreRow& row)
+{
+  row.flag_ = ObActionFlag::OP_ROW_EXIST;
+  row.set_dml(T_DML_INSERT);
+  row.row_val_.count_ = column_num;
+  ObObj* cells = row.row_val_.cells_;
+  snprintf(str_buf_[seed][0], 64, "rowkey_prefix_%08ld", seed);
+  snprintf(str_buf_[seed][1], 64, "value_%ld", seed % 7);
+  cells[0].set_int(seed * 3);
+  cells[1].set_varchar(str_buf_[seed][0]);
+  cells[1].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  cells[2].set_int(7);
+  cells[3].set_int(seed / 50);
+  if (0 == seed % 5) {
+    cells[4].set_null();
+  } else {
+    cells[4].set_varchar(str_buf_[seed][1]);
+    cells[4].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  }
+  cells[5].set_datetime(1600000000000000L + seed * 1000);
+}
+
+TEST_F(TestMicroBlockEncoder, encode_and_decode)
+{
+  ObObj objs[column_num];
+  ObStoreRow row;
+  row.row_val_.cells_ = objs;
+  ObMicroBlockEncoder encoder;
+  ObMicroBlockWriter flat_writer;
+  ASSERT_EQ(OB_SUCCESS, encoder.init(micro_block_size_limit, rowkey_column_count, column_num));
+  ASSERT_EQ(OB_SUCCESS, flat_writer.init(micro_block_size_limit, rowkey_column_count, column_num));
+  for (int64_t i = 0; i < test_row_num; ++i) {
+    gen_row(i, row);
+    ASSERT_EQ(OB_SUCCESS, encoder.append_row(row));
+    ASSERT_EQ(OB_SUCCESS, flat_writer.append_row(row));
+  }
+  ASSERT_EQ(test_row_num, encoder.get_row_count());
+  char* buf = NULL;
+  int64_t size = 0;
+  char* flat_buf = NULL;
+  int64_t flat_size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder.build_block(buf, size));
+  ASSERT_EQ(OB_SUCCESS, flat_writer.build_block(flat_buf, flat_size));
+  ASSERT_LE(size, encoder.get_block_size());
+  ASSERT_LT(size, flat_size);
+  STORAGE_LOG(INFO, "encoded micro block", K(size), K(flat_size));
+
+  ObMicroBlockDecoder decoder;
+  ObMicroBlockData block(buf, size);
+  ASSERT_EQ(OB_SUCCESS, decoder.init(block, &column_map_));
+  ASSERT_EQ(0, decoder.begin());
+  ASSERT_EQ(test_row_num, decoder.end());
+  for (int64_t i = 0; i < test_row_num; ++i) {
+    reset_row();
+    gen_row(i, row);
+    ASSERT_EQ(OB_SUCCESS, decoder.get_row(i, row_));
+    ASSERT_EQ(column_num, row_.row_val_.count_);
+    ASSERT_EQ(ObActionFlag::OP_ROW_EXIST, row_.flag_);
+    for (int64_t j = 0; j < column_num; ++j) {
+      ASSERT_TRUE(row.row_val_.cells_[j] == row_.row_val_.cells_[j])
+          << "\n i: " << i << " j: " << j << "\n writer:  " << to_cstring(row.row_val_.cells_[j])
+          << "\n decoder:  " << to_cstring(row_.row_val_.cells_[j]);
+    }
+  }
+
+  // decode backward to exercise the random access path
+  ObObj cell;
+  for (int64_t i = test_row_num - 1; i >= 0; --i) {
+    gen_row(i, row);
+    ASSERT_EQ(OB_SUCCESS, decoder.get_row_cell(i, 1, types_[1], cell));
+    ASSERT_TRUE(row.row_val_.cells_[1] == cell) << "i: " << i;
+    ASSERT_EQ(OB_SUCCESS, decoder.get_row_cell(i, 4, types_[4], cell));
+    ASSERT_TRUE(row.row_val_.cells_[4] == cell) << "i: " << i;
+  }
+
+  // locate rowkey
+  int64_t row_idx = ObIMicroBlockReader::INVALID_ROW_INDEX;
+  gen_row(123, row);
+  ObStoreRowkey rowkey(objs, rowkey_column_count);
+  ASSERT_EQ(OB_SUCCESS, decoder.locate_rowkey(rowkey, row_idx));
+  ASSERT_EQ(123, row_idx);
+  objs[0].set_int(123 * 3 + 1);
+  ASSERT_EQ(OB_BEYOND_THE_RANGE, decoder.locate_rowkey(rowkey, row_idx));
+  bool equal = false;
+  ASSERT_EQ(OB_SUCCESS, decoder.find_bound(rowkey, true, decoder.begin(), decoder.end(), row_idx, equal));
+  ASSERT_EQ(124, row_idx);
+  ASSERT_FALSE(equal);
+}
+
+TEST_F(TestMicroBlockEncoder, exceed_limit)
+{
+  ObObj objs[column_num];
+  ObStoreRow row;
+  row.row_val_.cells_ = objs;
+  ObMicroBlockEncoder encoder;
+  ASSERT_EQ(OB_SUCCESS, encoder.init(1024, rowkey_column_count, column_num));
+  int ret = OB_SUCCESS;
+  int64_t i = 0;
+  for (; OB_SUCC(ret) && i < test_row_num; ++i) {
+    gen_row(i, row);
+    ret = encoder.append_row(row);
+  }
+  ASSERT_EQ(OB_BUF_NOT_ENOUGH, ret);
+  const int64_t row_count = encoder.get_row_count();
+  ASSERT_EQ(i - 1, row_count);
+  char* buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder.build_block(buf, size));
+  ASSERT_LE(size, 1024);
+
+  ObMicroBlockDecoder decoder;
+  ObMicroBlockData block(buf, size);
+  ASSERT_EQ(OB_SUCCESS, decoder.init(block, &column_map_));
+  reset_row();
+  ASSERT_EQ(OB_SUCCESS, decoder.get_row(row_count - 1, row_));
+  gen_row(row_count - 1, row);
+  for (int64_t j = 0; j < column_num; ++j) {
+    ASSERT_TRUE(row.row_val_.cells_[j] == row_.row_val_.cells_[j]) << "j: " << j;
+  }
+  ASSERT_EQ(0, MEMCMP(encoder.get_last_rowkey().ptr(), encoder.last_rowkey_buf_, encoder.get_last_rowkey().length()));
+
+  encoder.reuse();
+  ASSERT_EQ(0, encoder.get_row_count());
+  gen_row(0, row);
+  ASSERT_EQ(OB_SUCCESS, encoder.append_row(row));
+}
+
+TEST_F(TestMicroBlockEncoder, not_init)
+{
+  ObMicroBlockDecoder decoder;
+  ObStoreRowkey rowkey;
+  rowkey.set_min();
+  int64_t iter = ObIMicroBlockReader::INVALID_ROW_INDEX;
+  bool equal = false;
+  ASSERT_EQ(OB_NOT_INIT, decoder.find_bound(rowkey, true, decoder.begin(), decoder.end(), iter, equal));
+  reset_row();
+  ASSERT_EQ(OB_NOT_INIT, decoder.get_row(0, row_));
+
+  ObMicroBlockEncoder encoder;
+  char* buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_NOT_INIT, encoder.build_block(buf, size));
+}
+
+}  // end namespace unittest
+}  // end namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,599 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/allocator/page_arena.h"
+#include "share/ob_errno.h"
+#include "storage/blocksstable/ob_data_buffer.h"
+#define protected public
+#define private public
+#include "storage/blocksstable/ob_micro_block_zone_map.h"
+#include "storage/blocksstable/ob_macro_block_common_header.h"
+#include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+#include "share/schema/ob_table_schema.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace sql;
+using namespace share::schema;
+namespace blocksstable {
+
+static const int64_t COLUMN_CNT = 3;
+static const uint16_t COLUMN_IDS[COLUMN_CNT] = {16, 17, 18};
+
+class TestMicroBlockZoneMap : public ::testing::Test {
+public:
+  TestMicroBlockZoneMap() : allocator_(ObModIds::TEST)
+  {}
+  virtual void SetUp()
+  {
+    // int, bit and varchar, the bit column has no zone
+    column_types_[0].set_int();
+    column_types_[1].set_bit();
+    column_types_[2].set_varchar();
+    column_types_[2].set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  }
+  virtual void TearDown()
+  {
+    allocator_.reset();
+  }
+  static void make_string(const char* str, ObObj& obj)
+  {
+    obj.set_varchar(str);
+    obj.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  }
+  // rows of (i, bit, "k%02ld") for i in [begin, end)
+  void fill_zone_map(const int64_t begin, const int64_t end, ObMicroBlockZoneMap& zone_map);
+  void build(const ObMicroBlockZoneMapWriter& writer, ObSelfBufferWriter& buffer, ObMicroBlockZoneMapReader& reader);
+  void check_int_zone(const ObMicroBlockZoneMapReader& reader, const int64_t entry_idx, const int64_t min,
+      const int64_t max, const int64_t null_count);
+  ObWhiteFilterExecutor* make_white(
+      const ObWhiteFilterOperatorType op_type, const uint64_t column_id, const ObObj* params, const int64_t count);
+  ObWhiteFilterExecutor* make_white(const ObWhiteFilterOperatorType op_type, const int64_t value)
+  {
+    ObObj param;
+    param.set_int(value);
+    return make_white(op_type, COLUMN_IDS[0], &param, 1);
+  }
+  ObPushdownFilterExecutor* make_logic(
+      const bool is_and, ObPushdownFilterExecutor* left, ObPushdownFilterExecutor* right);
+  ObPushdownFilterExecutor* make_black();
+  bool can_skip(const ObMicroBlockZoneMapReader& reader, ObPushdownFilterExecutor* filter, const int64_t entry_idx)
+  {
+    bool skip = false;
+    EXPECT_EQ(OB_SUCCESS, reader.can_skip(*filter, COLUMN_IDS, COLUMN_CNT, entry_idx, skip));
+    return skip;
+  }
+
+protected:
+  ObObjMeta column_types_[COLUMN_CNT];
+  ObArenaAllocator allocator_;
+};
+
+void TestMicroBlockZoneMap::fill_zone_map(const int64_t begin, const int64_t end, ObMicroBlockZoneMap& zone_map)
+{
+  ObObj cells[COLUMN_CNT];
+  ObNewRow row(cells, COLUMN_CNT);
+  char buf[16];
+  ASSERT_EQ(OB_SUCCESS, zone_map.init(column_types_, COLUMN_CNT));
+  for (int64_t i = begin; i < end; ++i) {
+    snprintf(buf, sizeof(buf), "k%02ld", i);
+    cells[0].set_int(i);
+    cells[1].set_bit(i);
+    make_string(buf, cells[2]);
+    ASSERT_EQ(OB_SUCCESS, zone_map.update(row));
+  }
+}
+
+void TestMicroBlockZoneMap::build(
+    const ObMicroBlockZoneMapWriter& writer, ObSelfBufferWriter& buffer, ObMicroBlockZoneMapReader& reader)
+{
+  ASSERT_EQ(OB_SUCCESS, writer.build(buffer));
+  ASSERT_EQ(writer.get_block_size(), buffer.length());
+  ASSERT_LE(writer.get_block_size(), writer.get_reserve_size());
+  ASSERT_EQ(OB_SUCCESS, reader.init(buffer.data(), buffer.length()));
+}
+
+void TestMicroBlockZoneMap::check_int_zone(const ObMicroBlockZoneMapReader& reader, const int64_t entry_idx,
+    const int64_t min, const int64_t max, const int64_t null_count)
+{
+  ObColumnZone zone;
+  bool found = false;
+  ASSERT_EQ(OB_SUCCESS, reader.get_column_zone(entry_idx, 0, zone, found));
+  ASSERT_TRUE(found);
+  ASSERT_TRUE(zone.is_valid());
+  ASSERT_TRUE(zone.has_value());
+  ASSERT_EQ(min, zone.get_min().get_int());
+  ASSERT_EQ(max, zone.get_max().get_int());
+  ASSERT_EQ(null_count, zone.get_null_count());
+}
+
+ObWhiteFilterExecutor* TestMicroBlockZoneMap::make_white(
+    const ObWhiteFilterOperatorType op_type, const uint64_t column_id, const ObObj* params, const int64_t count)
+{
+  ObPushdownWhiteFilterNode* node = new (allocator_.alloc(sizeof(ObPushdownWhiteFilterNode)))
+      ObPushdownWhiteFilterNode(allocator_);
+  node->set_type(WHITE_FILTER);
+  node->op_type_ = op_type;
+  EXPECT_EQ(OB_SUCCESS, node->col_ids_.init(1));
+  EXPECT_EQ(OB_SUCCESS, node->col_ids_.push_back(column_id));
+  ObWhiteFilterExecutor* filter =
+      new (allocator_.alloc(sizeof(ObWhiteFilterExecutor))) ObWhiteFilterExecutor(allocator_, *node);
+  filter->set_type(WHITE_FILTER_EXECUTOR);
+  EXPECT_EQ(OB_SUCCESS, filter->params_.init(count));
+  for (int64_t i = 0; i < count; ++i) {
+    EXPECT_EQ(OB_SUCCESS, filter->params_.push_back(params[i]));
+  }
+  return filter;
+}
+
+ObPushdownFilterExecutor* TestMicroBlockZoneMap::make_logic(
+    const bool is_and, ObPushdownFilterExecutor* left, ObPushdownFilterExecutor* right)
+{
+  ObPushdownFilterExecutor* filter = NULL;
+  ObPushdownFilterExecutor** childs =
+      static_cast<ObPushdownFilterExecutor**>(allocator_.alloc(2 * sizeof(ObPushdownFilterExecutor*)));
+  childs[0] = left;
+  childs[1] = right;
+  if (is_and) {
+    ObPushdownAndFilterNode* node =
+        new (allocator_.alloc(sizeof(ObPushdownAndFilterNode))) ObPushdownAndFilterNode(allocator_);
+    filter = new (allocator_.alloc(sizeof(ObAndFilterExecutor))) ObAndFilterExecutor(allocator_, *node);
+    filter->set_type(AND_FILTER_EXECUTOR);
+  } else {
+    ObPushdownOrFilterNode* node =
+        new (allocator_.alloc(sizeof(ObPushdownOrFilterNode))) ObPushdownOrFilterNode(allocator_);
+    filter = new (allocator_.alloc(sizeof(ObOrFilterExecutor))) ObOrFilterExecutor(allocator_, *node);
+    filter->set_type(OR_FILTER_EXECUTOR);
+  }
+  filter->set_childs(2, childs);
+  return filter;
+}
+
+ObPushdownFilterExecutor* TestMicroBlockZoneMap::make_black()
+{
+  ObPushdownBlackFilterNode* node =
+      new (allocator_.alloc(sizeof(ObPushdownBlackFilterNode))) ObPushdownBlackFilterNode(allocator_);
+  ObBlackFilterExecutor* filter =
+      new (allocator_.alloc(sizeof(ObBlackFilterExecutor))) ObBlackFilterExecutor(allocator_, *node);
+  filter->set_type(BLACK_FILTER_EXECUTOR);
+  return filter;
+}
+
+TEST_F(TestMicroBlockZoneMap, column_zone)
+{
+  ObColumnZone zone;
+  ObObj cell;
+  cell.set_int(5);
+  ASSERT_EQ(OB_SUCCESS, zone.update(cell));
+  cell.set_null();
+  ASSERT_EQ(OB_SUCCESS, zone.update(cell));
+  cell.set_int(-3);
+  ASSERT_EQ(OB_SUCCESS, zone.update(cell));
+  cell.set_int(9);
+  ASSERT_EQ(OB_SUCCESS, zone.update(cell));
+  ASSERT_TRUE(zone.is_valid());
+  ASSERT_TRUE(zone.has_value());
+  ASSERT_EQ(-3, zone.get_min().get_int());
+  ASSERT_EQ(9, zone.get_max().get_int());
+  ASSERT_EQ(1, zone.get_null_count());
+
+  char buf[ObColumnZone::MAX_SERIALIZE_SIZE];
+  int64_t pos = 0;
+  ObColumnZone des_zone;
+  ASSERT_EQ(OB_SUCCESS, zone.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(zone.get_serialize_size(), pos);
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, des_zone.deserialize(buf, zone.get_serialize_size(), pos));
+  ASSERT_TRUE(des_zone.is_valid());
+  ASSERT_EQ(-3, des_zone.get_min().get_int());
+  ASSERT_EQ(9, des_zone.get_max().get_int());
+  ASSERT_EQ(1, des_zone.get_null_count());
+
+  // merge keeps the widest range and adds up null count
+  ObColumnZone other;
+  cell.set_int(20);
+  ASSERT_EQ(OB_SUCCESS, other.update(cell));
+  cell.set_null();
+  ASSERT_EQ(OB_SUCCESS, other.update(cell));
+  ASSERT_EQ(OB_SUCCESS, zone.merge(other));
+  ASSERT_EQ(-3, zone.get_min().get_int());
+  ASSERT_EQ(20, zone.get_max().get_int());
+  ASSERT_EQ(2, zone.get_null_count());
+
+  // merge with an invalid zone
+  other.set_invalid();
+  ASSERT_EQ(OB_SUCCESS, zone.merge(other));
+  ASSERT_FALSE(zone.is_valid());
+  cell.set_int(1);
+  ASSERT_EQ(OB_SUCCESS, zone.update(cell));
+  ASSERT_FALSE(zone.is_valid());
+}
+
+TEST_F(TestMicroBlockZoneMap, invalid_zone)
+{
+  char str[ObColumnZone::MAX_VALUE_LENGTH + 2];
+  ObObj cell;
+  ObColumnZone zone;
+
+  // the longest value kept
+  MEMSET(str, 'a', sizeof(str));
+  str[ObColumnZone::MAX_VALUE_LENGTH] = '\0';
+  make_string(str, cell);
+  ASSERT_EQ(OB_SUCCESS, zone.update(cell));
+  ASSERT_TRUE(zone.is_valid());
+  ASSERT_EQ(0, zone.get_max().compare(cell, CS_TYPE_UTF8MB4_GENERAL_CI));
+
+  // value over 48 bytes
+  str[ObColumnZone::MAX_VALUE_LENGTH] = 'a';
+  str[ObColumnZone::MAX_VALUE_LENGTH + 1] = '\0';
+  make_string(str, cell);
+  ASSERT_EQ(OB_SUCCESS, zone.update(cell));
+  ASSERT_FALSE(zone.is_valid());
+  ASSERT_FALSE(zone.has_value());
+
+  // unsupported type
+  zone.reset();
+  cell.set_int(1);
+  ASSERT_EQ(OB_SUCCESS, zone.update(cell));
+  cell.set_bit(1);
+  ASSERT_FALSE(ObColumnZone::is_zone_type(cell.get_type()));
+  ASSERT_EQ(OB_SUCCESS, zone.update(cell));
+  ASSERT_FALSE(zone.is_valid());
+
+  // invalid zone is serialized as a flag
+  char buf[ObColumnZone::MAX_SERIALIZE_SIZE];
+  int64_t pos = 0;
+  ObColumnZone des_zone;
+  ASSERT_EQ(OB_SUCCESS, zone.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(static_cast<int64_t>(sizeof(int8_t)), pos);
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, des_zone.deserialize(buf, sizeof(int8_t), pos));
+  ASSERT_FALSE(des_zone.is_valid());
+
+  // columns of unsupported type have no zone
+  ObMicroBlockZoneMap zone_map;
+  ASSERT_EQ(OB_SUCCESS, zone_map.init(column_types_, COLUMN_CNT));
+  ASSERT_EQ(2, zone_map.get_column_count());
+  ASSERT_EQ(0, zone_map.get_column_idx(0));
+  ASSERT_EQ(2, zone_map.get_column_idx(1));
+  ASSERT_EQ(1, ObMicroBlockZoneMap::get_zone_column_count(column_types_, 2));
+
+  ObMicroBlockZoneMapWriter writer;
+  ASSERT_EQ(OB_SUCCESS, writer.init(column_types_ + 1, 1));
+  ASSERT_TRUE(writer.is_empty());
+  ASSERT_EQ(0, writer.get_block_size());
+  ASSERT_EQ(0, ObMicroBlockZoneMapWriter::get_max_reserve_size(column_types_ + 1, 1));
+}
+
+TEST_F(TestMicroBlockZoneMap, write_and_read)
+{
+  ObMicroBlockZoneMap zone_map;
+  ObMicroBlockZoneMapWriter writer;
+  ObMicroBlockZoneMapReader reader;
+  ObSelfBufferWriter buffer(0, ObModIds::TEST);
+  ASSERT_EQ(OB_SUCCESS, writer.init(column_types_, COLUMN_CNT));
+  fill_zone_map(0, 10, zone_map);
+  ASSERT_EQ(writer.get_entry_size(&zone_map), zone_map.get_serialize_size() + static_cast<int64_t>(sizeof(int32_t)));
+  ASSERT_EQ(OB_SUCCESS, writer.add_entry(&zone_map));
+  fill_zone_map(20, 30, zone_map);
+  ASSERT_EQ(OB_SUCCESS, writer.add_entry(&zone_map));
+  build(writer, buffer, reader);
+
+  ASSERT_EQ(2, reader.get_micro_block_count());
+  check_int_zone(reader, 0, 0, 9, 0);
+  check_int_zone(reader, 1, 20, 29, 0);
+  check_int_zone(reader, reader.get_macro_entry_idx(), 0, 29, 0);
+
+  ObColumnZone zone;
+  ObObj value;
+  bool found = false;
+  ASSERT_EQ(OB_SUCCESS, reader.get_column_zone(1, 2, zone, found));
+  ASSERT_TRUE(found);
+  make_string("k20", value);
+  ASSERT_EQ(0, zone.get_min().compare(value, CS_TYPE_UTF8MB4_GENERAL_CI));
+  make_string("k29", value);
+  ASSERT_EQ(0, zone.get_max().compare(value, CS_TYPE_UTF8MB4_GENERAL_CI));
+  // column without zone
+  ASSERT_EQ(OB_SUCCESS, reader.get_column_zone(0, 1, zone, found));
+  ASSERT_FALSE(found);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, reader.get_column_zone(3, 0, zone, found));
+
+  // reused micro block makes the macro entry invalid
+  ASSERT_EQ(writer.get_entry_size(NULL), zone_map.get_invalid_serialize_size() + static_cast<int64_t>(sizeof(int32_t)));
+  ASSERT_EQ(OB_SUCCESS, writer.add_entry(NULL));
+  buffer.reuse();
+  build(writer, buffer, reader);
+  ASSERT_EQ(3, reader.get_micro_block_count());
+  check_int_zone(reader, 1, 20, 29, 0);
+  ASSERT_EQ(OB_SUCCESS, reader.get_column_zone(2, 0, zone, found));
+  ASSERT_TRUE(found);
+  ASSERT_FALSE(zone.is_valid());
+  ASSERT_EQ(OB_SUCCESS, reader.get_column_zone(reader.get_macro_entry_idx(), 2, zone, found));
+  ASSERT_TRUE(found);
+  ASSERT_FALSE(zone.is_valid());
+  ObWhiteFilterExecutor* filter = make_white(WHITE_OP_EQ, 100);
+  ASSERT_TRUE(can_skip(reader, filter, 0));
+  ASSERT_FALSE(can_skip(reader, filter, 2));
+  ASSERT_FALSE(can_skip(reader, filter, reader.get_macro_entry_idx()));
+
+  // truncated section
+  ASSERT_EQ(OB_INVALID_DATA, reader.init(buffer.data(), buffer.length() - 1));
+}
+
+TEST_F(TestMicroBlockZoneMap, merge_writer)
+{
+  ObMicroBlockZoneMap zone_map;
+  ObMicroBlockZoneMapWriter writer;
+  ObMicroBlockZoneMapWriter other;
+  ObMicroBlockZoneMapReader reader;
+  ObSelfBufferWriter buffer(0, ObModIds::TEST);
+  ASSERT_EQ(OB_SUCCESS, writer.init(column_types_, COLUMN_CNT));
+  ASSERT_EQ(OB_SUCCESS, other.init(column_types_, COLUMN_CNT));
+  fill_zone_map(10, 20, zone_map);
+  ASSERT_EQ(OB_SUCCESS, writer.add_entry(&zone_map));
+  fill_zone_map(30, 40, zone_map);
+  ASSERT_EQ(OB_SUCCESS, other.add_entry(&zone_map));
+  fill_zone_map(5, 8, zone_map);
+  ASSERT_EQ(OB_SUCCESS, other.add_entry(&zone_map));
+  const int64_t entries_size = writer.get_entries_size() + other.get_entries_size();
+
+  ASSERT_EQ(OB_SUCCESS, writer.merge(other));
+  ASSERT_EQ(entries_size, writer.get_entries_size());
+  build(writer, buffer, reader);
+  ASSERT_EQ(3, reader.get_micro_block_count());
+  check_int_zone(reader, 0, 10, 19, 0);
+  check_int_zone(reader, 1, 30, 39, 0);
+  check_int_zone(reader, 2, 5, 7, 0);
+  check_int_zone(reader, reader.get_macro_entry_idx(), 5, 39, 0);
+
+  ObMicroBlockZoneMapWriter empty;
+  ASSERT_EQ(OB_NOT_INIT, writer.merge(empty));
+}
+
+TEST_F(TestMicroBlockZoneMap, null_zone)
+{
+  ObObj cells[COLUMN_CNT];
+  ObNewRow row(cells, COLUMN_CNT);
+  ObMicroBlockZoneMap zone_map;
+  ObMicroBlockZoneMapWriter writer;
+  ObMicroBlockZoneMapReader reader;
+  ObSelfBufferWriter buffer(0, ObModIds::TEST);
+  ASSERT_EQ(OB_SUCCESS, writer.init(column_types_, COLUMN_CNT));
+  ASSERT_EQ(OB_SUCCESS, zone_map.init(column_types_, COLUMN_CNT));
+  for (int64_t i = 0; i < 4; ++i) {
+    cells[0].set_null();
+    cells[1].set_null();
+    cells[2].set_null();
+    ASSERT_EQ(OB_SUCCESS, zone_map.update(row));
+  }
+  ASSERT_EQ(OB_SUCCESS, writer.add_entry(&zone_map));
+  fill_zone_map(0, 10, zone_map);
+  ASSERT_EQ(OB_SUCCESS, writer.add_entry(&zone_map));
+  build(writer, buffer, reader);
+
+  ObColumnZone zone;
+  bool found = false;
+  ASSERT_EQ(OB_SUCCESS, reader.get_column_zone(0, 0, zone, found));
+  ASSERT_TRUE(found);
+  ASSERT_TRUE(zone.is_valid());
+  ASSERT_FALSE(zone.has_value());
+  ASSERT_EQ(4, zone.get_null_count());
+  check_int_zone(reader, reader.get_macro_entry_idx(), 0, 9, 4);
+
+  // no comparison is true on null
+  ObObj params[2];
+  params[0].set_int(0);
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_EQ, 0), 0));
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_NE, 0), 0));
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_GE, INT64_MIN), 0));
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_IN, COLUMN_IDS[0], params, 1), 0));
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_EQ, 0), 1));
+  // filter without params is kept
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_EQ, COLUMN_IDS[0], params, 0), 0));
+}
+
+TEST_F(TestMicroBlockZoneMap, white_op)
+{
+  ObMicroBlockZoneMap zone_map;
+  ObMicroBlockZoneMapWriter writer;
+  ObMicroBlockZoneMapReader reader;
+  ObSelfBufferWriter buffer(0, ObModIds::TEST);
+  ASSERT_EQ(OB_SUCCESS, writer.init(column_types_, COLUMN_CNT));
+  // entry 0 is [10, 20], entry 1 is [7, 7]
+  fill_zone_map(10, 21, zone_map);
+  ASSERT_EQ(OB_SUCCESS, writer.add_entry(&zone_map));
+  fill_zone_map(7, 8, zone_map);
+  ASSERT_EQ(OB_SUCCESS, writer.add_entry(&zone_map));
+  build(writer, buffer, reader);
+
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_EQ, 5), 0));
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_EQ, 10), 0));
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_EQ, 20), 0));
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_EQ, 21), 0));
+
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_LE, 9), 0));
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_LE, 10), 0));
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_LT, 10), 0));
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_LT, 11), 0));
+
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_GE, 21), 0));
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_GE, 20), 0));
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_GT, 20), 0));
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_GT, 19), 0));
+
+  // ne skips a zone of the single value only
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_NE, 15), 0));
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_NE, 10), 0));
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_NE, 7), 1));
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_NE, 8), 1));
+
+  ObObj params[3];
+  params[0].set_int(1);
+  params[1].set_int(25);
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_IN, COLUMN_IDS[0], params, 2), 0));
+  params[1].set_int(15);
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_IN, COLUMN_IDS[0], params, 2), 0));
+
+  // null params
+  ObObj null_param;
+  null_param.set_null();
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_EQ, COLUMN_IDS[0], &null_param, 1), 0));
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_NE, COLUMN_IDS[0], &null_param, 1), 0));
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_IN, COLUMN_IDS[0], &null_param, 1), 0));
+  params[0].set_null();
+  params[1].set_int(15);
+  params[2].set_int(30);
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_IN, COLUMN_IDS[0], params, 3), 0));
+  params[1].set_int(1);
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_IN, COLUMN_IDS[0], params, 3), 0));
+
+  // params not of the column type are never used to skip
+  ObObj uint_param;
+  uint_param.set_uint64(100);
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_EQ, COLUMN_IDS[0], &uint_param, 1), 0));
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_IN, COLUMN_IDS[0], &uint_param, 1), 0));
+
+  // string column
+  ObObj str_param;
+  make_string("k30", str_param);
+  ASSERT_TRUE(can_skip(reader, make_white(WHITE_OP_GE, COLUMN_IDS[2], &str_param, 1), 0));
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_LE, COLUMN_IDS[2], &str_param, 1), 0));
+  str_param.set_collation_type(CS_TYPE_BINARY);
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_GE, COLUMN_IDS[2], &str_param, 1), 0));
+
+  // column without zone and column not in macro block
+  params[0].set_bit(100);
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_EQ, COLUMN_IDS[1], params, 1), 0));
+  params[0].set_int(100);
+  ASSERT_FALSE(can_skip(reader, make_white(WHITE_OP_EQ, 100, params, 1), 0));
+}
+
+TEST_F(TestMicroBlockZoneMap, logic_op)
+{
+  ObMicroBlockZoneMap zone_map;
+  ObMicroBlockZoneMapWriter writer;
+  ObMicroBlockZoneMapReader reader;
+  ObSelfBufferWriter buffer(0, ObModIds::TEST);
+  ASSERT_EQ(OB_SUCCESS, writer.init(column_types_, COLUMN_CNT));
+  fill_zone_map(10, 21, zone_map);
+  ASSERT_EQ(OB_SUCCESS, writer.add_entry(&zone_map));
+  build(writer, buffer, reader);
+
+  // and skips if any child skips
+  ASSERT_TRUE(can_skip(reader, make_logic(true, make_white(WHITE_OP_EQ, 5), make_white(WHITE_OP_GE, 0)), 0));
+  ASSERT_TRUE(can_skip(reader, make_logic(true, make_white(WHITE_OP_GE, 0), make_white(WHITE_OP_EQ, 5)), 0));
+  ASSERT_FALSE(can_skip(reader, make_logic(true, make_white(WHITE_OP_GE, 0), make_white(WHITE_OP_LE, 30)), 0));
+  ASSERT_TRUE(can_skip(reader, make_logic(true, make_black(), make_white(WHITE_OP_EQ, 5)), 0));
+
+  // or skips if all children skip
+  ASSERT_FALSE(can_skip(reader, make_logic(false, make_white(WHITE_OP_EQ, 5), make_white(WHITE_OP_GE, 0)), 0));
+  ASSERT_TRUE(can_skip(reader, make_logic(false, make_white(WHITE_OP_EQ, 5), make_white(WHITE_OP_EQ, 25)), 0));
+  ASSERT_FALSE(can_skip(reader, make_logic(false, make_white(WHITE_OP_EQ, 5), make_black()), 0));
+
+  // nested
+  ObPushdownFilterExecutor* out_of_zone =
+      make_logic(false, make_white(WHITE_OP_LT, 10), make_white(WHITE_OP_GT, 20));
+  ASSERT_TRUE(can_skip(reader, out_of_zone, 0));
+  ASSERT_FALSE(can_skip(reader, make_logic(false, out_of_zone, make_white(WHITE_OP_NE, 15)), 0));
+  ASSERT_TRUE(can_skip(reader, make_logic(true, make_white(WHITE_OP_NE, 15), out_of_zone), 0));
+
+  // black filter alone is never skipped
+  ASSERT_FALSE(can_skip(reader, make_black(), 0));
+}
+
+// metas written before zone map have no micro_block_zone_map_offset_
+TEST_F(TestMicroBlockZoneMap, old_macro_meta)
+{
+  const int64_t column_cnt = 2;
+  int64_t column_checksum[column_cnt] = {1, 2};
+  ObObj endkey[column_cnt];
+  ObObj des_endkey[column_cnt];
+  ObMacroBlockMetaV2 meta;
+  ObMacroBlockMetaV2 des_meta;
+  char buf[4096];
+  int64_t pos = 0;
+  endkey[0].set_int(100);
+  endkey[1].set_int(200);
+  meta.attr_ = ObMacroBlockCommonHeader::SSTableData;
+  meta.column_number_ = column_cnt;
+  meta.rowkey_column_number_ = 1;
+  meta.row_count_ = 10;
+  meta.occupy_size_ = 4000;
+  meta.micro_block_count_ = 2;
+  meta.micro_block_data_offset_ = 100;
+  meta.micro_block_index_offset_ = 2000;
+  meta.micro_block_endkey_offset_ = 2100;
+  meta.column_checksum_ = column_checksum;
+  meta.endkey_ = endkey;
+  meta.max_merged_trans_version_ = 10;
+  meta.micro_block_zone_map_offset_ = 3000;
+  ASSERT_TRUE(meta.is_valid());
+  ASSERT_EQ(1000, meta.get_micro_block_zone_map_size());
+  ASSERT_EQ(900, meta.get_endkey_size());
+
+  ASSERT_EQ(OB_SUCCESS, meta.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(meta.get_serialize_size(), pos);
+  des_meta.endkey_ = des_endkey;
+  int64_t des_pos = 0;
+  ASSERT_EQ(OB_SUCCESS, des_meta.deserialize(buf, pos, des_pos));
+  ASSERT_EQ(pos, des_pos);
+  ASSERT_EQ(3000, des_meta.micro_block_zone_map_offset_);
+
+  // drop the last field as the old format
+  const int32_t old_size = static_cast<int32_t>(pos - sizeof(int32_t));
+  MEMCPY(buf, &old_size, sizeof(old_size));
+  des_meta.micro_block_zone_map_offset_ = 3000;
+  des_pos = 0;
+  ASSERT_EQ(OB_SUCCESS, des_meta.deserialize(buf, old_size, des_pos));
+  ASSERT_EQ(old_size, des_pos);
+  ASSERT_EQ(0, des_meta.micro_block_zone_map_offset_);
+  ASSERT_EQ(0, des_meta.get_micro_block_zone_map_size());
+  ASSERT_EQ(1900, des_meta.get_endkey_size());
+  ASSERT_EQ(10, des_meta.max_merged_trans_version_);
+  ASSERT_EQ(100, des_meta.endkey_[0].get_int());
+}
+
+// zone map is turned on by a table mode bit, which must not disturb the existing flags
+TEST_F(TestMicroBlockZoneMap, table_mode)
+{
+  ObTableSchema table_schema;
+  ObTableMode table_mode;
+  ASSERT_FALSE(table_schema.is_zone_map_enabled());
+  table_mode.pk_mode_ = TPKM_NEW_NO_PK;
+  table_mode.zone_map_ = 1;
+  ASSERT_TRUE(table_mode.is_valid());
+  ASSERT_EQ(TPKM_NEW_NO_PK, ObTableMode::get_table_pk_mode(table_mode.mode_));
+  ASSERT_EQ(TABLE_MODE_NORMAL, ObTableMode::get_table_mode_flag(table_mode.mode_));
+  table_schema.set_table_mode(table_mode.mode_);
+  ASSERT_TRUE(table_schema.is_zone_map_enabled());
+  ASSERT_TRUE(table_schema.is_new_no_pk_table());
+
+  table_mode.pk_mode_ = TPKM_OLD_NO_PK;
+  table_schema.set_table_mode_struct(table_mode);
+  ASSERT_TRUE(table_schema.is_zone_map_enabled());
+  ASSERT_FALSE(table_schema.is_new_no_pk_table());
+  table_mode.zone_map_ = 0;
+  table_schema.set_table_mode_struct(table_mode);
+  ASSERT_FALSE(table_schema.is_zone_map_enabled());
+}
+
+}  // namespace blocksstable
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
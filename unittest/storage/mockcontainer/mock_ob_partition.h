@@ -222,6 +222,11 @@ public:
           common::ObNewRowIterator& iter));
   MOCK_METHOD3(append_sstable, int(const common::ObPartitionKey& pkey,
                                    const share::ObBuildIndexAppendSSTableParam& param, common::ObNewRowIterator& iter));
+  MOCK_METHOD5(prepare_direct_load_sstable, int(const common::ObPartitionKey& pkey, const int64_t table_schema_version,
+                                                const int64_t snapshot_version, common::ObNewRowIterator& iter,
+                                                ObDirectLoadSSTableCtx& ctx));
+  MOCK_METHOD2(create_direct_load_sstable, int(const common::ObPartitionKey& pkey, ObDirectLoadSSTableCtx& ctx));
+  MOCK_METHOD2(get_direct_load_major_sstable, int(const common::ObPartitionKey& pkey, ObTableHandle& major_handle));
   MOCK_METHOD3(get_latest_schema_version, int(share::schema::ObMultiVersionSchemaService* schema_service,
                                               const common::ObPartitionKey& pkey, int64_t& latest_schema_version));
   MOCK_METHOD3(freeze, int(const bool emergency, const bool force, int64_t& freeze_snapshot));
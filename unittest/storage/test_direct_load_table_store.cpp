@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+#include <gtest/gtest.h>
+#define private public
+#include "storage/ob_i_table.h"
+#include "storage/ob_sstable.h"
+#include "storage/ob_table_store.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace storage;
+
+namespace unittest {
+
+class TestDirectLoadTableStore : public ::testing::Test {
+public:
+  void fake_major_sstable(
+      const int64_t major_version, const int64_t minor_version, const int64_t snapshot_version, ObSSTable& table);
+};
+
+void TestDirectLoadTableStore::fake_major_sstable(
+    const int64_t major_version, const int64_t minor_version, const int64_t snapshot_version, ObSSTable& table)
+{
+  ObITable::TableKey key;
+  key.table_type_ = ObITable::MAJOR_SSTABLE;
+  key.pkey_ = ObPartitionKey(combine_id(1, 3001), 0, 0);
+  key.table_id_ = combine_id(1, 3001);
+  key.version_ = ObVersion(major_version, minor_version);
+  key.trans_version_range_.base_version_ = 0;
+  key.trans_version_range_.multi_version_start_ = snapshot_version;
+  key.trans_version_range_.snapshot_version_ = snapshot_version;
+  ASSERT_EQ(OB_SUCCESS, table.init(key));
+}
+
+// the direct load sstable has the same major version as the empty major sstable and a newer snapshot
+TEST_F(TestDirectLoadTableStore, publish_and_rollback)
+{
+  ObTableStore table_store;
+  ObSSTable old_major;
+  ObSSTable empty_major;
+  ObSSTable load_major;
+  ObArray<ObITable*> major_tables;
+  fake_major_sstable(1, 0, 10, old_major);
+  fake_major_sstable(2, 0, 20, empty_major);
+  fake_major_sstable(2, 1, 30, load_major);
+  ASSERT_EQ(OB_SUCCESS, major_tables.push_back(&old_major));
+  ASSERT_EQ(OB_SUCCESS, major_tables.push_back(&empty_major));
+
+  // publish
+  ASSERT_EQ(OB_SUCCESS, table_store.add_major_sstable(&load_major, major_tables, &empty_major));
+  ASSERT_EQ(2, major_tables.count());
+  ASSERT_EQ(&old_major, major_tables.at(0));
+  ASSERT_EQ(&load_major, major_tables.at(1));
+
+  // publish again is a no-op
+  ASSERT_EQ(OB_SUCCESS, table_store.add_major_sstable(&load_major, major_tables, &empty_major));
+  ASSERT_EQ(2, major_tables.count());
+  ASSERT_EQ(&load_major, major_tables.at(1));
+
+  // rollback
+  ASSERT_EQ(OB_SUCCESS, table_store.add_major_sstable(&empty_major, major_tables, &load_major));
+  ASSERT_EQ(2, major_tables.count());
+  ASSERT_EQ(&old_major, major_tables.at(0));
+  ASSERT_EQ(&empty_major, major_tables.at(1));
+}
+
+TEST_F(TestDirectLoadTableStore, replaced_major_not_match)
+{
+  ObTableStore table_store;
+  ObSSTable empty_major;
+  ObSSTable load_major;
+  ObSSTable other_load_major;
+  ObArray<ObITable*> major_tables;
+  fake_major_sstable(2, 0, 20, empty_major);
+  fake_major_sstable(2, 1, 30, load_major);
+  fake_major_sstable(2, 1, 40, other_load_major);
+  ASSERT_EQ(OB_SUCCESS, major_tables.push_back(&empty_major));
+
+  // same major version is never replaced without being asked to
+  ASSERT_EQ(OB_ERR_SYS, table_store.add_major_sstable(&load_major, major_tables));
+  ASSERT_EQ(&empty_major, major_tables.at(0));
+
+  // the major sstable has changed since the load started
+  ASSERT_EQ(OB_ERR_SYS, table_store.add_major_sstable(&load_major, major_tables, &other_load_major));
+  ASSERT_EQ(&empty_major, major_tables.at(0));
+
+  // rollback of a load which is replaced by another one
+  ASSERT_EQ(OB_SUCCESS, table_store.add_major_sstable(&other_load_major, major_tables, &empty_major));
+  ASSERT_EQ(OB_ERR_SYS, table_store.add_major_sstable(&empty_major, major_tables, &load_major));
+  ASSERT_EQ(&other_load_major, major_tables.at(0));
+}
+
+TEST_F(TestDirectLoadTableStore, new_major_version)
+{
+  ObTableStore table_store;
+  ObSSTable major_v1;
+  ObSSTable major_v2;
+  ObArray<ObITable*> major_tables;
+  fake_major_sstable(1, 0, 10, major_v1);
+  fake_major_sstable(2, 0, 20, major_v2);
+  ASSERT_EQ(OB_SUCCESS, major_tables.push_back(&major_v1));
+
+  // replaced major is ignored when there is no major sstable of the same version
+  ASSERT_EQ(OB_SUCCESS, table_store.add_major_sstable(&major_v2, major_tables, &major_v1));
+  ASSERT_EQ(2, major_tables.count());
+  ASSERT_EQ(&major_v1, major_tables.at(0));
+  ASSERT_EQ(&major_v2, major_tables.at(1));
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -13,6 +13,9 @@
 #include <gtest/gtest.h>
 #include "ob_multi_version_sstable_test.h"
 #include "storage/blocksstable/ob_micro_block_row_scanner.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+#include "sql/engine/expr/ob_expr.h"
+#include "sql/engine/ob_exec_context.h"
 #include "ob_uncommitted_trans_test.h"
 
 namespace oceanbase {
@@ -20,12 +23,16 @@ using namespace common;
 using namespace blocksstable;
 using namespace storage;
 using namespace share::schema;
+using namespace sql;
 
 namespace unittest {
 
 class TestMicroBlockRowScanner : public ObMultiVersionSSTableTest {
 public:
-  TestMicroBlockRowScanner() : ObMultiVersionSSTableTest("testmicroblockrowscanner")
+  TestMicroBlockRowScanner()
+      : ObMultiVersionSSTableTest("testmicroblockrowscanner"),
+        eval_ctx_(exec_ctx_, eval_res_, eval_tmp_),
+        frame_cnt_(0)
   {}
   virtual ~TestMicroBlockRowScanner()
   {}
@@ -34,6 +41,8 @@ public:
   {
     ObMultiVersionSSTableTest::SetUp();
     store_ctx_.trans_table_guard_ = new transaction::ObTransStateTableGuard();
+    frame_cnt_ = 0;
+    eval_ctx_.frames_ = frames_;
   }
   virtual void TearDown()
   {
@@ -51,6 +60,25 @@ public:
   int build_macro_and_scan(const int64_t micro_cnt, const char** micro_data,
       ObMultiVersionMicroBlockMinorMergeRowScanner& m_scanner, ObMockIterator& scanner_iter);
 
+  // pushdown filters are only evaluated by the major sstable scanner
+  void prepare_filter_param(ObPushdownFilterExecutor* filter, const bool is_reverse_scan);
+  ObExpr* make_param_expr(const ObObj& param);
+  ObPushdownFilterExecutor* make_white(
+      const ObWhiteFilterOperatorType op_type, const uint64_t column_id, const ObObj* params, const int64_t count);
+  ObPushdownFilterExecutor* make_white(
+      const ObWhiteFilterOperatorType op_type, const uint64_t column_id, const int64_t value)
+  {
+    ObObj param;
+    param.set_int(value);
+    return make_white(op_type, column_id, &param, 1);
+  }
+  ObPushdownFilterExecutor* make_logic(
+      const bool is_and, ObPushdownFilterExecutor* left, ObPushdownFilterExecutor* right);
+  ObPushdownFilterExecutor* make_black();
+  // scan row by row and in batch, the first column of the output rows must be %keys
+  void check_filtered_scan(const ObMicroBlockData& payload_data, const ObStoreRange& range, const int64_t* keys,
+      const int64_t key_cnt);
+
   ObArray<ObColDesc> columns_;
   ObTableIterParam param_;
   ObTableAccessContext context_;
@@ -58,6 +86,13 @@ public:
   ObArray<int32_t> projector_;
   ObStoreCtx store_ctx_;
   TestUncommittedMinorMergeScan test_trans_part_ctx_;
+  static const int64_t MAX_PARAM_EXPR_CNT = 16;
+  ObExecContext exec_ctx_;
+  ObArenaAllocator eval_res_;
+  ObArenaAllocator eval_tmp_;
+  ObEvalCtx eval_ctx_;
+  char* frames_[MAX_PARAM_EXPR_CNT];
+  int64_t frame_cnt_;
 };
 
 void TestMicroBlockRowScanner::prepare_query_param(
@@ -168,6 +203,139 @@ int TestMicroBlockRowScanner::build_macro_and_scan(const int64_t micro_cnt, cons
   return ret;
 }
 
+void TestMicroBlockRowScanner::prepare_filter_param(ObPushdownFilterExecutor* filter, const bool is_reverse_scan)
+{
+  ObVersionRange trans_version_range;
+  trans_version_range.base_version_ = 0;
+  trans_version_range.snapshot_version_ = 100;
+  trans_version_range.multi_version_start_ = 0;
+  prepare_query_param(trans_version_range, false, is_reverse_scan);
+  // without projector the column map is rebuilt from the macro meta by column id
+  param_.projector_ = NULL;
+  ColumnMap* cols_id_map = new (allocator_.alloc(sizeof(ColumnMap))) ColumnMap(allocator_);
+  OK(cols_id_map->init(columns_));
+  param_.cols_id_map_ = cols_id_map;
+  param_.pushdown_filters_ = filter;
+  context_.enable_pushdown_filter_ = true;
+}
+
+ObExpr* TestMicroBlockRowScanner::make_param_expr(const ObObj& param)
+{
+  // const expr in its own frame, evaluated to %param without eval func
+  const int64_t frame_size = sizeof(ObDatum) + sizeof(ObEvalInfo) + sizeof(int64_t);
+  ObExpr* expr = new (allocator_.alloc(sizeof(ObExpr))) ObExpr();
+  char* frame = static_cast<char*>(allocator_.alloc(frame_size));
+  EXPECT_LT(frame_cnt_, static_cast<int64_t>(MAX_PARAM_EXPR_CNT));
+  MEMSET(frame, 0, frame_size);
+  expr->frame_idx_ = static_cast<uint32_t>(frame_cnt_);
+  expr->datum_off_ = 0;
+  expr->eval_info_off_ = sizeof(ObDatum);
+  expr->res_buf_off_ = sizeof(ObDatum) + sizeof(ObEvalInfo);
+  expr->obj_meta_ = param.get_meta();
+  frames_[frame_cnt_++] = frame;
+  ObDatum& datum = *reinterpret_cast<ObDatum*>(frame);
+  datum.ptr_ = frame + expr->res_buf_off_;
+  if (param.is_null()) {
+    datum.set_null();
+  } else {
+    datum.set_int(param.get_int());
+  }
+  return expr;
+}
+
+ObPushdownFilterExecutor* TestMicroBlockRowScanner::make_white(
+    const ObWhiteFilterOperatorType op_type, const uint64_t column_id, const ObObj* params, const int64_t count)
+{
+  ObPushdownWhiteFilterNode* node = new (allocator_.alloc(sizeof(ObPushdownWhiteFilterNode)))
+      ObPushdownWhiteFilterNode(allocator_);
+  node->set_type(WHITE_FILTER);
+  node->op_type_ = op_type;
+  EXPECT_EQ(OB_SUCCESS, node->col_ids_.init(1));
+  EXPECT_EQ(OB_SUCCESS, node->col_ids_.push_back(column_id));
+  EXPECT_EQ(OB_SUCCESS, node->param_exprs_.init(count));
+  for (int64_t i = 0; i < count; ++i) {
+    EXPECT_EQ(OB_SUCCESS, node->param_exprs_.push_back(make_param_expr(params[i])));
+  }
+  ObWhiteFilterExecutor* filter =
+      new (allocator_.alloc(sizeof(ObWhiteFilterExecutor))) ObWhiteFilterExecutor(allocator_, *node);
+  filter->set_type(WHITE_FILTER_EXECUTOR);
+  ObSEArray<ObExpr*, 1> calc_exprs;
+  EXPECT_EQ(OB_SUCCESS, filter->init_evaluated_datums(allocator_, calc_exprs, &eval_ctx_));
+  return filter;
+}
+
+ObPushdownFilterExecutor* TestMicroBlockRowScanner::make_logic(
+    const bool is_and, ObPushdownFilterExecutor* left, ObPushdownFilterExecutor* right)
+{
+  ObPushdownFilterExecutor* filter = NULL;
+  ObPushdownFilterExecutor** childs =
+      static_cast<ObPushdownFilterExecutor**>(allocator_.alloc(2 * sizeof(ObPushdownFilterExecutor*)));
+  childs[0] = left;
+  childs[1] = right;
+  if (is_and) {
+    ObPushdownAndFilterNode* node =
+        new (allocator_.alloc(sizeof(ObPushdownAndFilterNode))) ObPushdownAndFilterNode(allocator_);
+    filter = new (allocator_.alloc(sizeof(ObAndFilterExecutor))) ObAndFilterExecutor(allocator_, *node);
+    filter->set_type(AND_FILTER_EXECUTOR);
+  } else {
+    ObPushdownOrFilterNode* node =
+        new (allocator_.alloc(sizeof(ObPushdownOrFilterNode))) ObPushdownOrFilterNode(allocator_);
+    filter = new (allocator_.alloc(sizeof(ObOrFilterExecutor))) ObOrFilterExecutor(allocator_, *node);
+    filter->set_type(OR_FILTER_EXECUTOR);
+  }
+  filter->set_childs(2, childs);
+  return filter;
+}
+
+ObPushdownFilterExecutor* TestMicroBlockRowScanner::make_black()
+{
+  ObPushdownBlackFilterNode* node =
+      new (allocator_.alloc(sizeof(ObPushdownBlackFilterNode))) ObPushdownBlackFilterNode(allocator_);
+  ObBlackFilterExecutor* filter =
+      new (allocator_.alloc(sizeof(ObBlackFilterExecutor))) ObBlackFilterExecutor(allocator_, *node);
+  filter->set_type(BLACK_FILTER_EXECUTOR);
+  return filter;
+}
+
+void TestMicroBlockRowScanner::check_filtered_scan(
+    const ObMicroBlockData& payload_data, const ObStoreRange& range, const int64_t* keys, const int64_t key_cnt)
+{
+  int ret = OB_SUCCESS;
+  MacroBlockId macro_id(0, 0, 1, ObStoreFileSystem::RESERVED_MACRO_BLOCK_INDEX);
+  ObFullMacroBlockMeta full_meta;
+  ObMicroBlockRowScanner scanner;
+  ObMicroBlockRowScanner batch_scanner;
+  const ObStoreRow* row = NULL;
+  const ObStoreRow* rows = NULL;
+  int64_t count = 0;
+  int64_t idx = 0;
+  OK(sstable_.get_meta(macro_id, full_meta));
+
+  OK(scanner.init(param_, context_, &sstable_));
+  OK(scanner.set_range(range));
+  OK(scanner.open(macro_id, full_meta, payload_data, true, true));
+  while (OB_SUCC(scanner.get_next_row(row))) {
+    ASSERT_LT(idx, key_cnt);
+    ASSERT_EQ(keys[idx++], row->row_val_.cells_[0].get_int());
+  }
+  ASSERT_EQ(OB_ITER_END, ret);
+  ASSERT_EQ(key_cnt, idx);
+
+  idx = 0;
+  OK(batch_scanner.init(param_, context_, &sstable_));
+  OK(batch_scanner.set_range(range));
+  OK(batch_scanner.open(macro_id, full_meta, payload_data, true, true));
+  while (OB_SUCC(batch_scanner.get_next_rows(rows, count))) {
+    ASSERT_LT(0, count);
+    for (int64_t i = 0; i < count; ++i) {
+      ASSERT_LT(idx, key_cnt);
+      ASSERT_EQ(keys[idx++], rows[i].row_val_.cells_[0].get_int());
+    }
+  }
+  ASSERT_EQ(OB_ITER_END, ret);
+  ASSERT_EQ(key_cnt, idx);
+}
+
 TEST_F(TestMicroBlockRowScanner, test_minor_merge_sparse)
 {
   GCONF._enable_sparse_row = true;
@@ -1018,6 +1186,226 @@ TEST_F(TestMicroBlockRowScanner, minor_for_migration)
   scanner_iter.reset();
 }
 
+// value column is key * 10 except NULL for key 4 and 7
+static const char* filter_micro_data[1] = {
+    "bigint   bigint  bigint  bigint  flag    multi_version_row_flag\n"
+    "0        -8      0       0       EXIST   CLF\n"
+    "1        -8      0       10      EXIST   CLF\n"
+    "2        -8      0       20      EXIST   CLF\n"
+    "3        -8      0       30      EXIST   CLF\n"
+    "4        -8      0       NULL    EXIST   CLF\n"
+    "5        -8      0       50      EXIST   CLF\n"
+    "6        -8      0       60      EXIST   CLF\n"
+    "7        -8      0       NULL    EXIST   CLF\n"
+    "8        -8      0       80      EXIST   CLF\n"
+    "9        -8      0       90      EXIST   CLF\n"};
+static const uint64_t FILTER_KEY_COLUMN_ID = OB_APP_MIN_COLUMN_ID;
+static const uint64_t FILTER_VALUE_COLUMN_ID = OB_APP_MIN_COLUMN_ID + 3;
+
+TEST_F(TestMicroBlockRowScanner, pushdown_filter_scan_order)
+{
+  GCONF._enable_sparse_row = false;
+  prepare_data(filter_micro_data, 1, 3, 9, "none", FLAT_ROW_STORE, 0);
+  ObMockIterator micro_iter;
+  ObStoreRowkey end_key;
+  ObMicroBlockData block_data;
+  ObMicroBlockData payload_data;
+  ObStoreRange range;
+  OK(micro_iter.from(filter_micro_data[0]));
+  build_micro_block_data(micro_iter, block_data, payload_data, end_key);
+  range.set_whole_range();
+
+  // disabled by the access context
+  const int64_t all_keys[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  prepare_filter_param(make_white(WHITE_OP_GT, FILTER_VALUE_COLUMN_ID, 25), false);
+  context_.enable_pushdown_filter_ = false;
+  check_filtered_scan(payload_data, range, all_keys, ARRAYSIZEOF(all_keys));
+
+  // NULL values never pass a comparison
+  const int64_t gt_keys[] = {3, 5, 6, 8, 9};
+  const int64_t reverse_gt_keys[] = {9, 8, 6, 5, 3};
+  prepare_filter_param(make_white(WHITE_OP_GT, FILTER_VALUE_COLUMN_ID, 25), false);
+  check_filtered_scan(payload_data, range, gt_keys, ARRAYSIZEOF(gt_keys));
+  prepare_filter_param(make_white(WHITE_OP_GT, FILTER_VALUE_COLUMN_ID, 25), true);
+  check_filtered_scan(payload_data, range, reverse_gt_keys, ARRAYSIZEOF(reverse_gt_keys));
+
+  // the filter result starts from the first row of the range in both scan orders
+  ObObj start_obj;
+  ObObj end_obj;
+  start_obj.set_int(2);
+  end_obj.set_int(7);
+  range.set_table_id(combine_id(TENANT_ID, TABLE_ID));
+  range.get_start_key().assign(&start_obj, 1);
+  range.get_end_key().assign(&end_obj, 1);
+  range.get_border_flag().set_inclusive_start();
+  range.get_border_flag().set_inclusive_end();
+  const int64_t range_keys[] = {2, 3, 5, 6};
+  const int64_t reverse_range_keys[] = {6, 5, 3, 2};
+  for (int64_t i = 0; i < 2; ++i) {
+    const bool is_reverse_scan = 1 == i;
+    MacroBlockId macro_id(0, 0, 1, ObStoreFileSystem::RESERVED_MACRO_BLOCK_INDEX);
+    ObFullMacroBlockMeta full_meta;
+    ObMicroBlockRowScanner scanner;
+    prepare_filter_param(make_white(WHITE_OP_GE, FILTER_VALUE_COLUMN_ID, 20), is_reverse_scan);
+    OK(sstable_.get_meta(macro_id, full_meta));
+    OK(scanner.init(param_, context_, &sstable_));
+    OK(scanner.set_range(range));
+    OK(scanner.open(macro_id, full_meta, payload_data, true, true));
+    ASSERT_EQ(2, scanner.filter_begin_);
+    ASSERT_EQ(is_reverse_scan ? 7 : 2, scanner.current_);
+    ASSERT_FALSE(scanner.is_row_filtered(2));
+    ASSERT_TRUE(scanner.is_row_filtered(4));
+    ASSERT_TRUE(scanner.is_row_filtered(7));
+    if (is_reverse_scan) {
+      check_filtered_scan(payload_data, range, reverse_range_keys, ARRAYSIZEOF(reverse_range_keys));
+    } else {
+      check_filtered_scan(payload_data, range, range_keys, ARRAYSIZEOF(range_keys));
+    }
+  }
+}
+
+TEST_F(TestMicroBlockRowScanner, pushdown_filter_logic)
+{
+  GCONF._enable_sparse_row = false;
+  prepare_data(filter_micro_data, 1, 3, 9, "none", FLAT_ROW_STORE, 0);
+  ObMockIterator micro_iter;
+  ObStoreRowkey end_key;
+  ObMicroBlockData block_data;
+  ObMicroBlockData payload_data;
+  ObStoreRange range;
+  OK(micro_iter.from(filter_micro_data[0]));
+  build_micro_block_data(micro_iter, block_data, payload_data, end_key);
+  range.set_whole_range();
+
+  // value > 15 and key < 6
+  const int64_t and_keys[] = {2, 3, 5};
+  prepare_filter_param(make_logic(true,
+                           make_white(WHITE_OP_GT, FILTER_VALUE_COLUMN_ID, 15),
+                           make_white(WHITE_OP_LT, FILTER_KEY_COLUMN_ID, 6)),
+      false);
+  check_filtered_scan(payload_data, range, and_keys, ARRAYSIZEOF(and_keys));
+
+  // value < 15 or key = 7, the NULL value of key 7 does not matter
+  const int64_t or_keys[] = {0, 1, 7};
+  prepare_filter_param(make_logic(false,
+                           make_white(WHITE_OP_LT, FILTER_VALUE_COLUMN_ID, 15),
+                           make_white(WHITE_OP_EQ, FILTER_KEY_COLUMN_ID, 7)),
+      false);
+  check_filtered_scan(payload_data, range, or_keys, ARRAYSIZEOF(or_keys));
+
+  // (value <= 10 or value >= 80) and key != 9
+  const int64_t nested_keys[] = {8, 1, 0};
+  prepare_filter_param(make_logic(true,
+                           make_logic(false,
+                               make_white(WHITE_OP_LE, FILTER_VALUE_COLUMN_ID, 10),
+                               make_white(WHITE_OP_GE, FILTER_VALUE_COLUMN_ID, 80)),
+                           make_white(WHITE_OP_NE, FILTER_KEY_COLUMN_ID, 9)),
+      true);
+  check_filtered_scan(payload_data, range, nested_keys, ARRAYSIZEOF(nested_keys));
+
+  // black filters are left to sql, nothing is filtered by storage under OR
+  const int64_t all_keys[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  prepare_filter_param(make_logic(false, make_white(WHITE_OP_EQ, FILTER_VALUE_COLUMN_ID, 50), make_black()), false);
+  check_filtered_scan(payload_data, range, all_keys, ARRAYSIZEOF(all_keys));
+
+  // while the white sibling still filters under AND
+  const int64_t black_and_keys[] = {5};
+  prepare_filter_param(make_logic(true, make_black(), make_white(WHITE_OP_EQ, FILTER_VALUE_COLUMN_ID, 50)), false);
+  check_filtered_scan(payload_data, range, black_and_keys, ARRAYSIZEOF(black_and_keys));
+}
+
+TEST_F(TestMicroBlockRowScanner, pushdown_filter_null_and_all_false)
+{
+  GCONF._enable_sparse_row = false;
+  prepare_data(filter_micro_data, 1, 3, 9, "none", FLAT_ROW_STORE, 0);
+  ObMockIterator micro_iter;
+  ObStoreRowkey end_key;
+  ObMicroBlockData block_data;
+  ObMicroBlockData payload_data;
+  ObStoreRange range;
+  OK(micro_iter.from(filter_micro_data[0]));
+  build_micro_block_data(micro_iter, block_data, payload_data, end_key);
+  range.set_whole_range();
+
+  // NULL params of IN are skipped
+  ObObj in_params[3];
+  in_params[0].set_int(20);
+  in_params[1].set_null();
+  in_params[2].set_int(60);
+  const int64_t in_keys[] = {2, 6};
+  prepare_filter_param(make_white(WHITE_OP_IN, FILTER_VALUE_COLUMN_ID, in_params, 3), false);
+  check_filtered_scan(payload_data, range, in_keys, ARRAYSIZEOF(in_keys));
+
+  // compare with NULL filters every row, even the NULL values
+  ObObj null_param;
+  null_param.set_null();
+  prepare_filter_param(make_white(WHITE_OP_EQ, FILTER_VALUE_COLUMN_ID, &null_param, 1), false);
+  check_filtered_scan(payload_data, range, NULL, 0);
+
+  // all false block is skipped on open, the second child of AND is never evaluated
+  MacroBlockId macro_id(0, 0, 1, ObStoreFileSystem::RESERVED_MACRO_BLOCK_INDEX);
+  ObFullMacroBlockMeta full_meta;
+  ObMicroBlockRowScanner scanner;
+  const ObStoreRow* row = NULL;
+  const ObStoreRow* rows = NULL;
+  int64_t count = 0;
+  ObPushdownFilterExecutor* skipped = make_white(WHITE_OP_LT, FILTER_VALUE_COLUMN_ID, 50);
+  ObPushdownFilterExecutor* filter =
+      make_logic(true, make_white(WHITE_OP_GT, FILTER_VALUE_COLUMN_ID, 1000), skipped);
+  prepare_filter_param(filter, false);
+  OK(sstable_.get_meta(macro_id, full_meta));
+  OK(scanner.init(param_, context_, &sstable_));
+  OK(scanner.set_range(range));
+  OK(scanner.open(macro_id, full_meta, payload_data, true, true));
+  ASSERT_TRUE(NULL != filter->get_result());
+  ASSERT_TRUE(filter->get_result()->is_all_false());
+  ASSERT_TRUE(NULL == skipped->get_result());
+  ASSERT_EQ(static_cast<int64_t>(ObIMicroBlockReader::INVALID_ROW_INDEX), scanner.current_);
+  ASSERT_EQ(OB_ITER_END, scanner.get_next_row(row));
+  ASSERT_EQ(OB_ITER_END, scanner.get_next_rows(rows, count));
+  ASSERT_EQ(0, count);
+}
+
+TEST_F(TestMicroBlockRowScanner, white_filter_cell)
+{
+  ObObj cell;
+  bool filtered = false;
+  ObObj in_params[2];
+  in_params[0].set_null();
+  in_params[1].set_int(3);
+  ObObj null_param;
+  null_param.set_null();
+  ObWhiteFilterExecutor* in_filter =
+      static_cast<ObWhiteFilterExecutor*>(make_white(WHITE_OP_IN, FILTER_VALUE_COLUMN_ID, in_params, 2));
+  ObWhiteFilterExecutor* null_filter =
+      static_cast<ObWhiteFilterExecutor*>(make_white(WHITE_OP_NE, FILTER_VALUE_COLUMN_ID, &null_param, 1));
+  ObWhiteFilterExecutor* le_filter =
+      static_cast<ObWhiteFilterExecutor*>(make_white(WHITE_OP_LE, FILTER_VALUE_COLUMN_ID, 3));
+  // params are not evaluated yet
+  cell.set_int(3);
+  ASSERT_EQ(OB_ERR_UNEXPECTED, le_filter->filter(cell, filtered));
+  OK(in_filter->init_params());
+  OK(null_filter->init_params());
+  OK(le_filter->init_params());
+
+  ASSERT_EQ(OB_SUCCESS, in_filter->filter(cell, filtered));
+  ASSERT_FALSE(filtered);
+  ASSERT_EQ(OB_SUCCESS, le_filter->filter(cell, filtered));
+  ASSERT_FALSE(filtered);
+  ASSERT_EQ(OB_SUCCESS, null_filter->filter(cell, filtered));
+  ASSERT_TRUE(filtered);
+  cell.set_int(4);
+  ASSERT_EQ(OB_SUCCESS, in_filter->filter(cell, filtered));
+  ASSERT_TRUE(filtered);
+  ASSERT_EQ(OB_SUCCESS, le_filter->filter(cell, filtered));
+  ASSERT_TRUE(filtered);
+  cell.set_null();
+  ASSERT_EQ(OB_SUCCESS, in_filter->filter(cell, filtered));
+  ASSERT_TRUE(filtered);
+  ASSERT_EQ(OB_SUCCESS, le_filter->filter(cell, filtered));
+  ASSERT_TRUE(filtered);
+}
+
 }  // namespace unittest
 }  // namespace oceanbase
 
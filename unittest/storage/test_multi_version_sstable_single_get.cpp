@@ -618,6 +618,98 @@ TEST_F(TestMultiVersionSSTableSingleGet, empty_get)
 // ASSERT_EQ(1, meta->empty_read_cnt_[2]);
 //}
 
+TEST_F(TestMultiVersionSSTableSingleGet, sstable_bloom_filter)
+{
+  const int64_t rowkey_cnt = 4;
+  const int64_t schema_rowkey_cnt = rowkey_cnt - 2;
+  const char* micro_data[1];
+  micro_data[0] = "bigint   var   bigint bigint  bigint   flag    multi_version_row_flag\n"
+                  "1        var1   -8      0      2        EXIST   CL\n"
+                  "2        var2   -7      0      4        EXIST   CL\n"
+                  "3        var3   -6      0      7        EXIST   CL\n";
+  prepare_data_start(micro_data, rowkey_cnt, 10, "none", FLAT_ROW_STORE, 0);
+  prepare_one_macro(micro_data, 1);
+  prepare_data_end();
+
+  const char* rowkeys = "bigint   var   flag\n"
+                        "1        var1  EXIST\n"
+                        "2        var2  EXIST\n"
+                        "3        var3  EXIST\n"
+                        "4        var4  EXIST\n";
+  ObMockIterator rowkey_iter;
+  OK(rowkey_iter.from(rowkeys));
+  ObStoreRow* row = NULL;
+  ObStoreRowkey rowkey;
+
+  // rowkey 3 exists in the sstable but is left out of the bloom filter, so it can only be
+  // reported as not exist if the lookup stops at the filter without reading the macro block
+  const int64_t bf_rowkey_cnt = 2;
+  const int64_t expect_values[bf_rowkey_cnt] = {2, 4};
+  const uint64_t table_id = combine_id(TENANT_ID, TABLE_ID);
+  const MacroBlockId bf_block_id(1024);
+  ObBloomFilterCacheValue bf_value;
+  OK(bf_value.init(schema_rowkey_cnt, 1000 /*row_cnt*/));
+  for (int64_t i = 0; i < bf_rowkey_cnt; ++i) {
+    OK(rowkey_iter.get_row(i, row));
+    ASSERT_TRUE(NULL != row);
+    rowkey.assign(row->row_val_.cells_, schema_rowkey_cnt);
+    OK(bf_value.insert(rowkey));
+  }
+  const int64_t file_id = sstable_.get_storage_file_handle().get_storage_file()->get_file_id();
+  OK(ObStorageCacheSuite::get_instance().get_bf_cache().put_bloom_filter(table_id, bf_block_id, file_id, bf_value));
+  // minor sstables keep the schema rowkey count in meta, which is what the filter is built on
+  sstable_.meta_.rowkey_column_count_ = schema_rowkey_cnt;
+  sstable_.meta_.bloom_filter_block_id_ = bf_block_id;
+
+  ObVersionRange version_range;
+  version_range.snapshot_version_ = 20;
+  version_range.base_version_ = 0;
+  version_range.multi_version_start_ = 0;
+  prepare_query_param(version_range);
+
+  ObStoreRowIterator* getter = NULL;
+  const ObStoreRow* result = NULL;
+  ObExtStoreRowkey ext_rowkey;
+  for (int64_t i = 0; i < rowkey_iter.count(); ++i) {
+    OK(rowkey_iter.get_row(i, row));
+    ASSERT_TRUE(NULL != row);
+    ext_rowkey.reset();
+    ObSSTableTest::convert_rowkey(ObStoreRowkey(row->row_val_.cells_, schema_rowkey_cnt), ext_rowkey, allocator_);
+    const int64_t filter_cnt = context_.access_stat_.sstable_bf_filter_cnt_;
+    OK(sstable_.get(param_, context_, ext_rowkey, getter));
+    OK(getter->get_next_row(result));
+    if (i < bf_rowkey_cnt) {
+      ASSERT_TRUE(ObActionFlag::OP_ROW_EXIST == result->flag_);
+      ASSERT_EQ(row->row_val_.cells_[0].get_int(), result->row_val_.cells_[0].get_int());
+      ASSERT_EQ(expect_values[i], result->row_val_.cells_[2].get_int());
+      ASSERT_EQ(filter_cnt, context_.access_stat_.sstable_bf_filter_cnt_);
+    } else {
+      ASSERT_TRUE(ObActionFlag::OP_ROW_DOES_NOT_EXIST == result->flag_);
+      ASSERT_EQ(filter_cnt + 1, context_.access_stat_.sstable_bf_filter_cnt_);
+    }
+    ASSERT_EQ(OB_ITER_END, getter->get_next_row(result));
+    getter->~ObStoreRowIterator();
+  }
+  ASSERT_EQ(rowkey_iter.count(), context_.access_stat_.sstable_bf_access_cnt_);
+
+  ObStoreCtx store_ctx;
+  bool is_exist = false;
+  bool is_found = false;
+  for (int64_t i = 0; i < rowkey_iter.count(); ++i) {
+    OK(rowkey_iter.get_row(i, row));
+    ASSERT_TRUE(NULL != row);
+    rowkey.assign(row->row_val_.cells_, schema_rowkey_cnt);
+    is_exist = (i >= bf_rowkey_cnt);
+    is_found = (i >= bf_rowkey_cnt);
+    OK(sstable_.exist(store_ctx, table_id, rowkey, *param_.out_cols_, is_exist, is_found));
+    ASSERT_EQ(i < bf_rowkey_cnt, is_exist);
+    ASSERT_EQ(i < bf_rowkey_cnt, is_found);
+  }
+
+  // the filter macro block is not real, do not release it with the sstable
+  sstable_.meta_.bloom_filter_block_id_.reset();
+}
+
 TEST_F(TestMultiVersionSSTableSingleGet, across_micro_uncommit)
 {
   int ret = OB_SUCCESS;
@@ -12,9 +12,15 @@
 
 #include <gtest/gtest.h>
 #define private public
+#define protected public
 #include "storage/ob_multiple_merge.h"
+#include "storage/ob_multiple_scan_merge.h"
 #include "storage/ob_sstable.h"
+#include "storage/ob_store_row_filter.h"
+#include "storage/memtable/ob_memtable.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
 #undef private
+#undef protected
 
 namespace oceanbase {
 using namespace common;
@@ -90,6 +96,71 @@ TEST_F(ObMultipleMergeTest, test_sort_sstables_overlap)
   ASSERT_EQ(OB_SUCCESS, ret);
 }
 
+TEST_F(ObMultipleMergeTest, test_can_pushdown_filter)
+{
+  ObArenaAllocator allocator;
+  sql::ObPushdownBlackFilterNode filter_node(allocator);
+  sql::ObBlackFilterExecutor filter(allocator, filter_node);
+  ObTableAccessParam access_param;
+  ObStoreRowFilter row_filter;
+  ObMultipleScanMerge merge;
+  ObSSTable major_sstable;
+  ObSSTable other_major_sstable;
+  ObSSTable minor_sstable;
+  memtable::ObMemtable memtable;
+  ObITable::TableKey table_key;
+  int64_t table_id = combine_id(1, 3001);
+  table_key.table_type_ = ObITable::MAJOR_SSTABLE;
+  table_key.pkey_ = ObPartitionKey(table_id, 0, 0);
+  table_key.table_id_ = table_id;
+  table_key.version_ = ObVersion(1, 0);
+  table_key.trans_version_range_.multi_version_start_ = 0;
+  table_key.trans_version_range_.base_version_ = 0;
+  table_key.trans_version_range_.snapshot_version_ = 10;
+  ASSERT_EQ(OB_SUCCESS, major_sstable.init(table_key));
+  ASSERT_EQ(OB_SUCCESS, other_major_sstable.init(table_key));
+  ASSERT_EQ(OB_SUCCESS, minor_sstable.init(table_key));
+  minor_sstable.key_.table_type_ = ObITable::MINI_MINOR_SSTABLE;
+  memtable.key_.table_type_ = ObITable::MEMTABLE;
+  merge.access_param_ = &access_param;
+
+  // no filter
+  ASSERT_EQ(OB_SUCCESS, merge.tables_handle_.add_table(&major_sstable));
+  ASSERT_FALSE(merge.can_pushdown_filter());
+  access_param.iter_param_.pushdown_filters_ = &filter;
+  ASSERT_TRUE(merge.can_pushdown_filter());
+  // rows filtered by partition filter are checked after fuse
+  merge.row_filter_ = &row_filter;
+  ASSERT_FALSE(merge.can_pushdown_filter());
+  merge.row_filter_ = NULL;
+
+  // an empty memtable has nothing to fuse
+  ASSERT_EQ(OB_SUCCESS, merge.tables_handle_.add_table(&memtable));
+  ASSERT_TRUE(merge.can_pushdown_filter());
+  memtable.local_allocator_.set_clock(1);
+  ASSERT_TRUE(memtable.not_empty());
+  ASSERT_FALSE(merge.can_pushdown_filter());
+  memtable.local_allocator_.set_clock(INT64_MAX);
+  ASSERT_TRUE(merge.can_pushdown_filter());
+
+  // incremental data in minor sstable
+  ASSERT_EQ(OB_SUCCESS, merge.tables_handle_.add_table(&minor_sstable));
+  ASSERT_FALSE(merge.can_pushdown_filter());
+
+  // memtable only
+  merge.tables_handle_.reset();
+  ASSERT_EQ(OB_SUCCESS, merge.tables_handle_.add_table(&memtable));
+  ASSERT_FALSE(merge.can_pushdown_filter());
+
+  // exactly one major sstable
+  merge.tables_handle_.reset();
+  ASSERT_EQ(OB_SUCCESS, merge.tables_handle_.add_table(&major_sstable));
+  ASSERT_EQ(OB_SUCCESS, merge.tables_handle_.add_table(&other_major_sstable));
+  ASSERT_FALSE(merge.can_pushdown_filter());
+  merge.tables_handle_.reset();
+  merge.access_param_ = NULL;
+}
+
 }  // end namespace unittest
 }  // end namespace oceanbase
 
@@ -0,0 +1,403 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#define private public
+#define protected public
+#include "storage/ob_scan_merge_loser_tree.h"
+#undef private
+#undef protected
+
+namespace oceanbase {
+using namespace common;
+using namespace storage;
+using namespace share::schema;
+
+namespace unittest {
+
+#define CALL(func, ...) \
+  func(__VA_ARGS__);    \
+  ASSERT_FALSE(HasFatalFailure());
+
+// compare rows as ObScanMergeLoserTreeCmp did before the specialized rowkey compare,
+// every rowkey is compared by ObSSTableRowkeyHelper with the cmp funcs of %cmp
+class TestOldCmp {
+public:
+  explicit TestOldCmp(ObScanMergeLoserTreeCmp& cmp) : cmp_(cmp), error_(OB_SUCCESS)
+  {}
+  int get_error_code()
+  {
+    return error_;
+  }
+  int64_t operator()(const ObScanMergeLoserTreeItem& l, const ObScanMergeLoserTreeItem& r)
+  {
+    int32_t cmp_result = static_cast<int32_t>(l.row_->scan_index_ - r.row_->scan_index_);
+    error_ = OB_SUCCESS;
+    if (0 == cmp_result) {
+      if (OB_SUCCESS != (error_ = ObScanMergeLoserTreeCmp::compare_rowkey(
+                             *l.row_, *r.row_, cmp_.rowkey_size_, cmp_.cmp_funcs_, cmp_result))) {
+        STORAGE_LOG(WARN, "compare rowkey error", K(error_));
+      } else if (cmp_.reverse_) {
+        cmp_result = -cmp_result;
+      }
+    }
+    return cmp_result;
+  }
+
+private:
+  ObScanMergeLoserTreeCmp& cmp_;
+  int error_;
+};
+
+// loser tree without king and stream, rows of the same rowkey are ordered by iter_idx_
+class TestOldLoserTree : public ObLoserTree<ObScanMergeLoserTreeItem, TestOldCmp, MAX_TABLE_CNT_IN_STORAGE> {
+public:
+  explicit TestOldLoserTree(TestOldCmp& cmp)
+      : ObLoserTree<ObScanMergeLoserTreeItem, TestOldCmp, MAX_TABLE_CNT_IN_STORAGE>(cmp)
+  {}
+
+protected:
+  virtual int duel(ObScanMergeLoserTreeItem& offender, ObScanMergeLoserTreeItem& defender, const int64_t match_idx,
+      bool& is_offender_win) override
+  {
+    int ret = OB_SUCCESS;
+    int64_t cmp_ret = cmp_(offender, defender);
+    if (OB_FAIL(cmp_.get_error_code())) {
+      STORAGE_LOG(WARN, "compare fail", K(ret));
+    } else {
+      matches_[match_idx].is_draw_ = (0 == cmp_ret);
+      if (0 == cmp_ret) {
+        cmp_ret = (offender.iter_idx_ > defender.iter_idx_) ? 1 : -1;
+      }
+      is_offender_win = cmp_ret < 0;
+    }
+    return ret;
+  }
+};
+
+class TestScanMergeLoserTree : public ::testing::Test {
+public:
+  struct TestIter {
+    TestIter() : rows_(), pos_(0), upper_bound_(), bound_k1_(-1), bound_k2_(-1)
+    {}
+    std::vector<const ObStoreRow*> rows_;
+    int64_t pos_;
+    ObStoreRowkey upper_bound_;
+    int64_t bound_k1_;
+    int64_t bound_k2_;
+  };
+  struct MergedRow {
+    MergedRow(const int64_t iter_idx, const ObStoreRow* row, const bool is_first)
+        : iter_idx_(iter_idx), row_(row), is_first_(is_first)
+    {}
+    bool operator==(const MergedRow& other) const
+    {
+      return iter_idx_ == other.iter_idx_ && row_ == other.row_ && is_first_ == other.is_first_;
+    }
+    int64_t iter_idx_;
+    const ObStoreRow* row_;
+    // first row of the rows with the same rowkey
+    bool is_first_;
+  };
+  static const int64_t ROWKEY_CNT = 2;
+
+  TestScanMergeLoserTree() : allocator_(ObModIds::TEST), iters_(), stream_cnt_(0)
+  {}
+  virtual void TearDown() override
+  {
+    iters_.clear();
+    allocator_.reset();
+  }
+
+  // rowkey (k1, k2), k2 is a varchar column if %is_str
+  void init_cmp(ObScanMergeLoserTreeCmp& cmp, const bool is_str)
+  {
+    ObColDescArray col_descs;
+    ObColDesc desc;
+    desc.col_id_ = OB_APP_MIN_COLUMN_ID;
+    desc.col_type_.set_int();
+    ASSERT_EQ(OB_SUCCESS, col_descs.push_back(desc));
+    desc.col_id_ = OB_APP_MIN_COLUMN_ID + 1;
+    if (is_str) {
+      desc.col_type_.set_varchar();
+      desc.col_type_.set_collation_type(CS_TYPE_UTF8MB4_BIN);
+    } else {
+      desc.col_type_.set_int();
+    }
+    ASSERT_EQ(OB_SUCCESS, col_descs.push_back(desc));
+    ASSERT_EQ(OB_SUCCESS, cmp.init(ROWKEY_CNT, col_descs, false, false, true, allocator_));
+    ASSERT_EQ(!is_str, cmp.is_int_rowkey_);
+  }
+
+  void fill_rowkey(ObObj* cells, const int64_t k1, const int64_t k2, const bool is_str)
+  {
+    cells[0].set_int(k1);
+    if (is_str) {
+      char* buf = static_cast<char*>(allocator_.alloc(16));
+      ASSERT_TRUE(NULL != buf);
+      const int64_t len = snprintf(buf, 16, "%08ld", k2);
+      cells[1].set_varchar(buf, static_cast<int32_t>(len));
+      cells[1].set_collation_type(CS_TYPE_UTF8MB4_BIN);
+    } else {
+      cells[1].set_int(k2);
+    }
+  }
+
+  // rows of one iterator must be in (scan_index, k1, k2) order
+  void add_row(TestIter& iter, const int64_t scan_index, const int64_t k1, const int64_t k2, const bool is_str)
+  {
+    ObObj* cells = static_cast<ObObj*>(allocator_.alloc(sizeof(ObObj) * ROWKEY_CNT));
+    ObStoreRow* row = static_cast<ObStoreRow*>(allocator_.alloc(sizeof(ObStoreRow)));
+    ASSERT_TRUE(NULL != cells && NULL != row);
+    new (cells) ObObj[ROWKEY_CNT];
+    row = new (row) ObStoreRow();
+    CALL(fill_rowkey, cells, k1, k2, is_str);
+    row->flag_ = ObActionFlag::OP_ROW_EXIST;
+    row->row_val_.cells_ = cells;
+    row->row_val_.count_ = ROWKEY_CNT;
+    row->scan_index_ = scan_index;
+    iter.rows_.push_back(row);
+    // rows of later ranges may have smaller rowkeys, keep the max one as upper bound
+    if (k1 > iter.bound_k1_ || (k1 == iter.bound_k1_ && k2 > iter.bound_k2_)) {
+      iter.bound_k1_ = k1;
+      iter.bound_k2_ = k2;
+      iter.upper_bound_ = ObStoreRowkey(cells, ROWKEY_CNT);
+    }
+  }
+
+  void push_item(ObScanMergeLoserTree& tree, const ObScanMergeLoserTreeItem& item, const bool try_push_top)
+  {
+    if (try_push_top) {
+      ASSERT_EQ(OB_SUCCESS, tree.push_top(item));
+      if (tree.has_king_ && item.iter_idx_ == tree.stream_iter_idx_) {
+        ++stream_cnt_;
+      }
+    } else {
+      ASSERT_EQ(OB_SUCCESS, tree.push(item));
+    }
+  }
+
+  void push_item(TestOldLoserTree& tree, const ObScanMergeLoserTreeItem& item, const bool try_push_top)
+  {
+    UNUSED(try_push_top);
+    ASSERT_EQ(OB_SUCCESS, tree.push(item));
+  }
+
+  // consume the tree as ObMultipleScanMergeImpl does: pop all rows of the min rowkey, refill
+  // the consumed iterators and push_top when only the top row was consumed.
+  template <typename Tree>
+  void merge(Tree& tree, std::vector<MergedRow>& output)
+  {
+    std::vector<int64_t> consumers;
+    bool try_push_top = false;
+    for (int64_t i = 0; i < static_cast<int64_t>(iters_.size()); ++i) {
+      iters_.at(i).pos_ = 0;
+      consumers.push_back(i);
+    }
+    output.clear();
+    while (true) {
+      ObScanMergeLoserTreeItem item;
+      for (int64_t i = 0; i < static_cast<int64_t>(consumers.size()); ++i) {
+        TestIter& iter = iters_.at(consumers.at(i));
+        if (iter.pos_ < static_cast<int64_t>(iter.rows_.size())) {
+          item.iter_idx_ = consumers.at(i);
+          item.row_ = iter.rows_.at(iter.pos_++);
+          push_item(tree, item, try_push_top);
+          ASSERT_FALSE(HasFatalFailure());
+        }
+      }
+      ASSERT_EQ(OB_SUCCESS, tree.rebuild());
+      consumers.clear();
+      try_push_top = false;
+      if (tree.empty()) {
+        break;
+      }
+      bool first_row = true;
+      bool has_same_rowkey = false;
+      while (!tree.empty() && (has_same_rowkey || first_row)) {
+        const ObScanMergeLoserTreeItem* top_item = NULL;
+        has_same_rowkey = !tree.is_unique_champion();
+        ASSERT_EQ(OB_SUCCESS, tree.top(top_item));
+        ASSERT_TRUE(NULL != top_item);
+        output.push_back(MergedRow(top_item->iter_idx_, top_item->row_, first_row));
+        consumers.push_back(top_item->iter_idx_);
+        if (first_row && !has_same_rowkey) {
+          try_push_top = true;
+          break;
+        }
+        first_row = false;
+        if (has_same_rowkey) {
+          ASSERT_EQ(OB_SUCCESS, tree.pop());
+        }
+      }
+      ASSERT_EQ(OB_SUCCESS, tree.pop());
+    }
+  }
+
+  // merge %iters_ by the scan merge loser tree and the old one, the output must be the same
+  void check_merge(const bool is_str, const bool set_upper_bound)
+  {
+    const int64_t iter_cnt = static_cast<int64_t>(iters_.size());
+    int64_t row_cnt = 0;
+    ObScanMergeLoserTreeCmp cmp;
+    CALL(init_cmp, cmp, is_str);
+    ObScanMergeLoserTree tree(cmp);
+    ASSERT_EQ(OB_SUCCESS, tree.init(iter_cnt, allocator_));
+    for (int64_t i = 0; i < iter_cnt; ++i) {
+      row_cnt += static_cast<int64_t>(iters_.at(i).rows_.size());
+      if (set_upper_bound && iters_.at(i).upper_bound_.is_valid()) {
+        ASSERT_EQ(OB_SUCCESS, tree.set_upper_bound(i, iters_.at(i).upper_bound_));
+      }
+    }
+    std::vector<MergedRow> output;
+    CALL(merge, tree, output);
+
+    TestOldCmp old_cmp(cmp);
+    TestOldLoserTree old_tree(old_cmp);
+    ASSERT_EQ(OB_SUCCESS, old_tree.init(iter_cnt, allocator_));
+    std::vector<MergedRow> old_output;
+    CALL(merge, old_tree, old_output);
+
+    ASSERT_EQ(row_cnt, static_cast<int64_t>(output.size()));
+    ASSERT_EQ(old_output.size(), output.size());
+    for (int64_t i = 0; i < static_cast<int64_t>(output.size()); ++i) {
+      ASSERT_TRUE(old_output.at(i) == output.at(i)) << "i=" << i << " iter_idx=" << output.at(i).iter_idx_
+                                                    << " old_iter_idx=" << old_output.at(i).iter_idx_;
+    }
+  }
+
+  // each iterator gets random rows of [0, key_range) in every range, some of them are empty
+  void gen_random_iters(
+      const int64_t iter_cnt, const int64_t range_cnt, const int64_t key_range, const bool is_str, std::mt19937& rand)
+  {
+    iters_.resize(iter_cnt);
+    for (int64_t i = 0; i < iter_cnt; ++i) {
+      const int64_t percent = rand() % 4 * 30;
+      for (int64_t scan_index = 0; scan_index < range_cnt; ++scan_index) {
+        for (int64_t key = 0; key < key_range; ++key) {
+          if (rand() % 100 < percent) {
+            CALL(add_row, iters_.at(i), scan_index, key / 10, key % 10, is_str);
+          }
+        }
+      }
+    }
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  std::vector<TestIter> iters_;
+  // rows which become king by streaming
+  int64_t stream_cnt_;
+};
+
+TEST_F(TestScanMergeLoserTree, duplicate_keys)
+{
+  const int64_t ITER_CNT = 4;
+  iters_.resize(ITER_CNT);
+  for (int64_t i = 0; i < ITER_CNT; ++i) {
+    for (int64_t key = 0; key < 1000; ++key) {
+      // every rowkey of the last iterator shows up in all the others, half of them in iter 0
+      if (0 != i || 0 == key % 2) {
+        CALL(add_row, iters_.at(i), 0, key, key, false);
+      }
+    }
+  }
+  CALL(check_merge, false, true);
+}
+
+TEST_F(TestScanMergeLoserTree, exhausted_children)
+{
+  const int64_t ITER_CNT = 5;
+  iters_.resize(ITER_CNT);
+  // iter 1 is empty, iter 2 has only one row, iter 3 ends early
+  CALL(add_row, iters_.at(2), 0, 50, 0, false);
+  for (int64_t key = 0; key < 10; ++key) {
+    CALL(add_row, iters_.at(3), 0, key, 0, false);
+  }
+  for (int64_t key = 0; key < 100; key += 3) {
+    CALL(add_row, iters_.at(0), 0, key, 0, false);
+  }
+  for (int64_t key = 0; key < 100; key += 2) {
+    CALL(add_row, iters_.at(4), 0, key, 0, false);
+  }
+  CALL(check_merge, false, true);
+}
+
+TEST_F(TestScanMergeLoserTree, single_child)
+{
+  iters_.resize(1);
+  for (int64_t scan_index = 0; scan_index < 3; ++scan_index) {
+    for (int64_t key = 0; key < 100; ++key) {
+      CALL(add_row, iters_.at(0), scan_index, key, 0, false);
+    }
+  }
+  CALL(check_merge, false, true);
+  CALL(check_merge, false, false);
+}
+
+TEST_F(TestScanMergeLoserTree, random_overlap)
+{
+  std::mt19937 rand(2021);
+  for (int64_t round = 0; round < 10; ++round) {
+    iters_.clear();
+    CALL(gen_random_iters, 1 + round % 8, 3, 300, false, rand);
+    CALL(check_merge, false, true);
+    CALL(check_merge, false, false);
+  }
+}
+
+TEST_F(TestScanMergeLoserTree, random_overlap_str)
+{
+  std::mt19937 rand(2022);
+  for (int64_t round = 0; round < 10; ++round) {
+    iters_.clear();
+    CALL(gen_random_iters, 1 + round % 8, 3, 300, true, rand);
+    CALL(check_merge, true, true);
+  }
+}
+
+TEST_F(TestScanMergeLoserTree, disjoint_stream)
+{
+  const int64_t SSTABLE_CNT = 5;
+  const int64_t ROW_CNT = 1000;
+  iters_.resize(SSTABLE_CNT + 1);
+  // minor sstables of an append-mostly table, with a memtable updating a few rows of them
+  for (int64_t scan_index = 0; scan_index < 2; ++scan_index) {
+    for (int64_t i = 1; i <= SSTABLE_CNT; ++i) {
+      for (int64_t key = (i - 1) * ROW_CNT; key < i * ROW_CNT; ++key) {
+        CALL(add_row, iters_.at(i), scan_index, key, 0, false);
+      }
+    }
+    for (int64_t key = 500; key < SSTABLE_CNT * ROW_CNT; key += 1000) {
+      CALL(add_row, iters_.at(0), scan_index, key, 0, false);
+    }
+  }
+  CALL(check_merge, false, true);
+  // rows of an sstable after the last memtable row in it are streamed
+  ASSERT_GT(stream_cnt_, SSTABLE_CNT * ROW_CNT / 2);
+
+  stream_cnt_ = 0;
+  CALL(check_merge, false, false);
+  ASSERT_EQ(0, stream_cnt_);
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char** argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -11,7 +11,10 @@
  */
 
 #include <gtest/gtest.h>
+#define private public
+#define protected public
 #include "ob_sstable_test.h"
+#include "storage/ob_sstable_row_scanner.h"
 
 namespace oceanbase {
 using namespace blocksstable;
@@ -753,6 +756,58 @@ TEST_F(TestSSTableSingleScanner, test_multi_block_read_discrete_io_limit_reverse
   test_multi_block_read_discrete_io(true, 1);
 }
 
+TEST_F(TestSSTableSingleScanner, test_prefetch_micro_limit)
+{
+  int ret = OB_SUCCESS;
+  ObStoreRange range;
+  ObExtStoreRange ext_range;
+  ObStoreRowIterator* iter = NULL;
+  const ObStoreRow* prow = NULL;
+  ObStoreRow row;
+  ObObj cells[TEST_COLUMN_CNT];
+  row.row_val_.assign(cells, TEST_COLUMN_CNT);
+  const int64_t max_prefetch_micro_cnt = GCONF._sstable_scan_max_prefetch_micro_cnt;
+  const int64_t init_limit = ObSSTableRowScanner::SCAN_PREFETCH_MICRO_LIMIT;
+
+  ret = prepare_query_param(false, -1);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  GCONF._sstable_scan_max_prefetch_micro_cnt = 2 * init_limit;
+  destroy_all_cache();
+  generate_range(0, row_cnt_ - 1, range);
+  convert_range(range, ext_range, allocator_);
+  ret = sstable_.scan(param_, context_, ext_range, iter);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ObSSTableRowScanner* scanner = static_cast<ObSSTableRowScanner*>(iter);
+  // the ring follows the config, the window starts from the old limit
+  ASSERT_EQ(2 * init_limit, scanner->micro_handle_cnt_);
+  ASSERT_EQ(init_limit, scanner->prefetch_micro_limit_);
+
+  for (int64_t i = 0; i < row_cnt_; ++i) {
+    if (row_cnt_ / 3 == i) {
+      // a read waited for io with a full window, the window grows up to the ring
+      scanner->is_io_waited_ = true;
+      scanner->prefetch_micro_depth_ = scanner->prefetch_micro_limit_;
+      scanner->extend_prefetch_micro_limit();
+      ASSERT_FALSE(scanner->is_io_waited_);
+      ASSERT_EQ(2 * init_limit, scanner->prefetch_micro_limit_);
+      scanner->prefetch_micro_depth_ = scanner->prefetch_micro_limit_;
+      scanner->extend_prefetch_micro_limit();
+      ASSERT_EQ(2 * init_limit, scanner->prefetch_micro_limit_);
+    }
+    // rows stay in order while the wider window prefetches
+    ret = row_generate_.get_next_row(i, row);
+    ASSERT_EQ(OB_SUCCESS, ret);
+    ret = scanner->get_next_row(prow);
+    ASSERT_EQ(OB_SUCCESS, ret) << "i: " << i;
+    ASSERT_TRUE(row.row_val_ == prow->row_val_);
+  }
+  ret = scanner->get_next_row(prow);
+  ASSERT_EQ(OB_ITER_END, ret);
+  scanner->~ObSSTableRowScanner();
+  GCONF._sstable_scan_max_prefetch_micro_cnt = max_prefetch_micro_cnt;
+  destroy_query_param();
+}
+
 }  // end namespace unittest
 }  // end namespace oceanbase
 
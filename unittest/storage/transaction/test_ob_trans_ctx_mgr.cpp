@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#include "storage/transaction/ob_trans_ctx_mgr.h"
+#include "share/ob_errno.h"
+#include "lib/oblog/ob_log.h"
+#include "common/ob_partition_key.h"
+#include "storage/ob_partition_service.h"
+#include "../mockcontainer/mock_ob_trans_service.h"
+#include "../mockcontainer/mock_ob_partition_service.h"
+
+namespace oceanbase {
+using namespace common;
+using namespace transaction;
+using namespace storage;
+namespace unittest {
+
+class TestObTransCtxMgr : public ::testing::Test {
+public:
+  virtual void SetUp()
+  {}
+  virtual void TearDown()
+  {}
+
+public:
+  static const uint64_t TENANT_ID = 1001;
+  static const int32_t PARTITION_COUNT = 100;
+  static const char* LOCAL_IP;
+  static const int32_t PORT = 8080;
+};
+const char* TestObTransCtxMgr::LOCAL_IP = "127.0.0.1";
+MockObIPartitionService partition_service;
+
+// a batch with found, missing and erroring partitions reports each of them in its own entry
+TEST_F(TestObTransCtxMgr, get_trans_ctxs_mixed_batch)
+{
+  TRANS_LOG(INFO, "called", "func", test_info_->name());
+  ObPartTransCtxMgr part_ctx_mgr;
+  ObLtsSource lts_source;
+  MockObTsMgr ts_mgr(lts_source);
+  // scheduler contexts are created without leader takeover and gts
+  ASSERT_EQ(OB_SUCCESS, part_ctx_mgr.init(ObTransCtxType::SCHEDULER, &ts_mgr, &partition_service));
+  ASSERT_EQ(OB_SUCCESS, part_ctx_mgr.start());
+
+  const uint64_t table_id = combine_id(TENANT_ID, 50001);
+  const ObPartitionKey found_pkey(table_id, 1, PARTITION_COUNT);
+  const ObPartitionKey no_ctx_pkey(table_id, 2, PARTITION_COUNT);
+  const ObPartitionKey error_pkey(table_id, 3, PARTITION_COUNT);
+  const ObPartitionKey no_partition_pkey(table_id, 4, PARTITION_COUNT);
+  ASSERT_EQ(OB_SUCCESS, part_ctx_mgr.add_partition(found_pkey));
+  ASSERT_EQ(OB_SUCCESS, part_ctx_mgr.add_partition(no_ctx_pkey));
+  ASSERT_EQ(OB_SUCCESS, part_ctx_mgr.add_partition(error_pkey));
+
+  ObAddr observer(ObAddr::IPV4, LOCAL_IP, PORT);
+  ObTransID trans_id(observer);
+  bool alloc = true;
+  ObTransCtx* found_ctx = NULL;
+  ASSERT_EQ(OB_SUCCESS,
+      part_ctx_mgr.get_trans_ctx(found_pkey, trans_id, false, false, false, false, alloc, found_ctx));
+  ASSERT_TRUE(alloc);
+  ASSERT_TRUE(NULL != found_ctx);
+  ObTransCtx* error_ctx = NULL;
+  alloc = true;
+  ASSERT_EQ(OB_SUCCESS,
+      part_ctx_mgr.get_trans_ctx(error_pkey, trans_id, false, false, false, false, alloc, error_ctx));
+  ASSERT_TRUE(NULL != error_ctx);
+  // lookup on this partition fails with an error other than OB_TRANS_CTX_NOT_EXIST
+  ObPartitionTransCtxMgr* error_mgr = part_ctx_mgr.get_partition_trans_ctx_mgr(error_pkey);
+  ASSERT_TRUE(NULL != error_mgr);
+  error_mgr->ts_mgr_ = NULL;
+
+  ObPartitionArray partitions;
+  ASSERT_EQ(OB_SUCCESS, partitions.push_back(found_pkey));
+  ASSERT_EQ(OB_SUCCESS, partitions.push_back(no_ctx_pkey));
+  ASSERT_EQ(OB_SUCCESS, partitions.push_back(error_pkey));
+  ASSERT_EQ(OB_SUCCESS, partitions.push_back(no_partition_pkey));
+  ObSEArray<ObTransCtx*, 4> ctxs;
+  ObSEArray<int, 4> rets;
+  ASSERT_EQ(OB_SUCCESS, part_ctx_mgr.get_trans_ctxs(partitions, trans_id, ctxs, rets));
+  ASSERT_EQ(partitions.count(), ctxs.count());
+  ASSERT_EQ(partitions.count(), rets.count());
+  ASSERT_EQ(OB_SUCCESS, rets.at(0));
+  ASSERT_EQ(found_ctx, ctxs.at(0));
+  ASSERT_EQ(OB_TRANS_CTX_NOT_EXIST, rets.at(1));
+  ASSERT_TRUE(NULL == ctxs.at(1));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, rets.at(2));
+  ASSERT_TRUE(NULL == ctxs.at(2));
+  ASSERT_EQ(OB_PARTITION_NOT_EXIST, rets.at(3));
+  ASSERT_TRUE(NULL == ctxs.at(3));
+  ASSERT_EQ(OB_SUCCESS, part_ctx_mgr.revert_trans_ctx(ctxs.at(0)));
+
+  // failure of the batch itself leaves nothing to revert
+  part_ctx_mgr.is_running_ = false;
+  ASSERT_EQ(OB_NOT_RUNNING, part_ctx_mgr.get_trans_ctxs(partitions, trans_id, ctxs, rets));
+  ASSERT_EQ(0, ctxs.count());
+  ASSERT_EQ(0, rets.count());
+  part_ctx_mgr.is_running_ = true;
+
+  error_mgr->ts_mgr_ = &ts_mgr;
+  ASSERT_EQ(OB_SUCCESS, part_ctx_mgr.revert_trans_ctx(found_ctx));
+  ASSERT_EQ(OB_SUCCESS, part_ctx_mgr.revert_trans_ctx(error_ctx));
+  ASSERT_EQ(OB_SUCCESS, part_ctx_mgr.get_partition_trans_ctx_mgr(found_pkey)->erase_trans_ctx(trans_id));
+  ASSERT_EQ(OB_SUCCESS, error_mgr->erase_trans_ctx(trans_id));
+  part_ctx_mgr.is_running_ = false;
+  part_ctx_mgr.destroy();
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+
+int main(int argc, char** argv)
+{
+  int ret = 1;
+  ObLogger& logger = ObLogger::get_logger();
+  logger.set_file_name("test_ob_trans_ctx_mgr.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  if (OB_SUCCESS != ObClockGenerator::init()) {
+    TRANS_LOG(WARN, "init ObClockGenerator error!");
+  } else {
+    testing::InitGoogleTest(&argc, argv);
+    ret = RUN_ALL_TESTS();
+  }
+  return ret;
+}